@@ -60,6 +60,8 @@ hg_test_usage(const char *execname)
     printf("    -m, --memory        Use shared-memory with local targets\n");
     printf("    -t, --threads       Number of server threads\n");
     printf("    -B, --bidirectional Bidirectional communication\n");
+    printf("    -G, --coalesce      Max number of coalesced requests\n");
+    printf("    -A, --addr-cache    Cache looked up addresses\n");
 }
 
 /*---------------------------------------------------------------------------*/
@@ -102,6 +104,13 @@ hg_test_parse_options(int argc, char *argv[], struct hg_test_info *hg_test_info)
             case 'B': /* bidirectional */
                 hg_test_info->bidirectional = HG_TRUE;
                 break;
+            case 'G': /* number of coalesced requests */
+                hg_test_info->coalesce_count =
+                    (unsigned int) atoi(na_test_opt_arg_g);
+                break;
+            case 'A': /* addr cache */
+                hg_test_info->addr_cache = HG_TRUE;
+                break;
             default:
                 break;
         }
@@ -224,6 +233,15 @@ HG_Test_init(int argc, char *argv[], struct hg_test_info *hg_test_info)
         /* Multi-recv */
         hg_init_info.no_multi_recv = hg_test_info->na_test_info.no_multi_recv;
 
+        /* Request coalescing */
+        hg_init_info.coalesce_count = hg_test_info->coalesce_count;
+
+        /* Addr cache */
+        hg_init_info.addr_cache = hg_test_info->addr_cache;
+
+        /* Bulk buffer slab */
+        hg_init_info.bulk_buf_slab_size = HG_TEST_BULK_BUF_SLAB_SIZE;
+
         /* Init HG with init options */
         hg_test_info->hg_classes[i] =
             HG_Init_opt(NULL, hg_test_info->na_test_info.listen, &hg_init_info);
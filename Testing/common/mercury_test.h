@@ -30,17 +30,23 @@ struct hg_test_info {
     drc_info_handle_t credential_info;
     uint32_t cookie;
 #endif
-    unsigned int handle_max;   /* Max number of handles in-flight */
-    unsigned int thread_count; /* Max number of threads */
+    unsigned int handle_max;     /* Max number of handles in-flight */
+    unsigned int thread_count;   /* Max number of threads */
+    unsigned int coalesce_count; /* Max number of coalesced requests */
     hg_bool_t auth;
     hg_bool_t auto_sm;       /* Use shared-memory */
     hg_bool_t bidirectional; /* Bidirectional tests */
+    hg_bool_t addr_cache;    /* Cache looked up addresses */
 };
 
 /*****************/
 /* Public Macros */
 /*****************/
 
+/* Size of the slab that bulk buffers are allocated from (kept below the
+ * usual huge page size so that tests do not attempt huge page mappings) */
+#define HG_TEST_BULK_BUF_SLAB_SIZE (3 << 19)
+
 /* Default error macro */
 #include "mercury_log.h"
 
@@ -14,7 +14,8 @@
 
 int na_test_opt_ind_g = 1;            /* token pointer */
 const char *na_test_opt_arg_g = NULL; /* flag argument (or value) */
-const char *na_test_short_opt_g = "hc:d:p:H:P:LsSk:l:bC:X:VaZ:y:z:w:x:mt:BRvMU";
+const char *na_test_short_opt_g =
+    "hc:d:p:H:P:LsSk:l:bC:X:VaZ:y:z:w:x:mt:BRvMUG:A";
 /* clang-format off */
 const struct na_test_opt na_test_opt_g[] = {
     {"help", no_arg, 'h'},
@@ -45,6 +46,8 @@ const struct na_test_opt na_test_opt_g[] = {
     {"verify", no_arg, 'v'},
     {"millionbps", no_arg, 'M'},
     {"no-multi-recv", no_arg, 'U'},
+    {"coalesce", require_arg, 'G'},
+    {"addr-cache", no_arg, 'A'},
     {NULL, 0, '\0'} /* Must add this at the end */
 };
 /* clang-format on */
@@ -0,0 +1,78 @@
+#!/bin/bash
+#
+# Run hg_rate against hg_perf_server without and with request coalescing and
+# report the rate of each message size for both runs.
+#
+# Usage: hg_rate_coalesce.sh [-G count] [options]
+#
+# Options other than -G are passed to both hg_perf_server and hg_rate, e.g.:
+#   hg_rate_coalesce.sh -G 8 -p na+sm -x 32 -l 20000 -y 0 -z 8
+
+BIN_DIR=$(cd "$(dirname "$0")" && pwd)
+COALESCE=8
+ARGS=()
+
+while [ $# -gt 0 ]; do
+  case "$1" in
+    -G|--coalesce)
+      COALESCE=$2
+      shift 2
+      ;;
+    *)
+      ARGS+=("$1")
+      shift
+      ;;
+  esac
+done
+
+if [ "$COALESCE" -le 1 ]; then
+  echo "Error: coalesce count must be greater than 1"
+  exit 1
+fi
+
+WORK_DIR=$(mktemp -d)
+trap 'rm -rf "$WORK_DIR"' EXIT
+
+# run_rate <output file> [hg_rate options]
+run_rate() {
+  local out=$1
+  local server i
+  shift
+
+  (cd "$WORK_DIR" && exec "$BIN_DIR/hg_perf_server" "${ARGS[@]}") \
+    > "$WORK_DIR/server.log" 2>&1 &
+  server=$!
+
+  # Wait for server to be ready
+  for i in $(seq 1 100); do
+    grep -q "# Waiting for client" "$WORK_DIR/server.log" && break
+    if ! kill -0 $server 2>/dev/null; then
+      cat "$WORK_DIR/server.log"
+      return 1
+    fi
+    sleep 0.1
+  done
+
+  if ! (cd "$WORK_DIR" && "$BIN_DIR/hg_rate" "${ARGS[@]}" "$@") > "$out" 2>&1;
+  then
+    cat "$out"
+    kill $server 2>/dev/null
+    wait $server 2>/dev/null
+    return 1
+  fi
+  wait $server
+}
+
+run_rate "$WORK_DIR/base.log" || exit 1
+run_rate "$WORK_DIR/coalesce.log" -G "$COALESCE" || exit 1
+
+grep "^# Loop" "$WORK_DIR/base.log"
+printf "%-10s%20s%20s%12s\n" "# Size" "Rate (RPC/s)" "Rate -G $COALESCE" \
+  "Change"
+awk '
+  NR == FNR { if ($0 !~ /^#/ && NF == 3) base[$1] = $3; next }
+  $0 !~ /^#/ && NF == 3 && ($1 in base) {
+    printf "%-10s%20s%20s%+11.1f%%\n", $1, base[$1], $3,
+      (base[$1] > 0) ? ($3 - base[$1]) * 100.0 / base[$1] : 0
+  }
+' "$WORK_DIR/base.log" "$WORK_DIR/coalesce.log"
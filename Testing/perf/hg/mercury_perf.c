@@ -650,6 +650,9 @@ hg_perf_print_header_lat(const struct hg_test_info *hg_test_info,
                "targets\n");
     if (info->verify)
         printf("# WARNING verifying data, output will be slower\n");
+    if (hg_test_info->coalesce_count > 1)
+        printf("# Coalescing up to %u requests per message\n",
+            hg_test_info->coalesce_count);
     printf("%-*s%*s%*s\n", 10, "# Size", NWIDTH, "Avg time (us)", NWIDTH,
         "Avg rate (RPC/s)");
     fflush(stdout);
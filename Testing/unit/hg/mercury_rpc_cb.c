@@ -313,6 +313,7 @@ HG_TEST_RPC_CB(hg_test_bulk_write, handle)
     struct hg_test_bulk_args *bulk_args = NULL;
     bulk_write_in_t in_struct;
     hg_return_t ret = HG_SUCCESS;
+    hg_uint32_t digest;
     int fildes;
     hg_op_id_t hg_bulk_op_id;
 
@@ -358,6 +359,13 @@ HG_TEST_RPC_CB(hg_test_bulk_write, handle)
     HG_TEST_CHECK_HG_ERROR(
         error, ret, "HG_Bulk_create() failed (%s)", HG_Error_to_string(ret));
 
+    /* Verify data if origin attached a digest */
+    if (HG_Bulk_get_digest(origin_bulk_handle, &digest) == HG_SUCCESS) {
+        ret = HG_Bulk_set_checksum(local_bulk_handle, HG_TRUE);
+        HG_TEST_CHECK_HG_ERROR(error, ret, "HG_Bulk_set_checksum() failed (%s)",
+            HG_Error_to_string(ret));
+    }
+
     /* Pull bulk data */
     HG_TEST_LOG_DEBUG("Requesting transfer_size=%" PRIu64
                       ", origin_offset=%" PRIu64 ", "
@@ -586,6 +594,11 @@ hg_test_bulk_transfer_cb(const struct hg_cb_info *hg_cb_info)
         /* Fill output structure */
         out_struct.ret = 0;
         goto done;
+    } else if (hg_cb_info->ret == HG_CHECKSUM_ERROR) {
+        HG_TEST_LOG_DEBUG("HG_Bulk_transfer() data does not match digest\n");
+        /* Fill output structure */
+        out_struct.ret = 0;
+        goto done;
     } else
         HG_TEST_CHECK_ERROR_NORET(hg_cb_info->ret != HG_SUCCESS, done,
             "Error in HG callback (%s)", HG_Error_to_string(hg_cb_info->ret));
@@ -28,6 +28,11 @@ struct forward_cb_args {
 static hg_return_t
 hg_test_bulk_forward_cb(const struct hg_cb_info *callback_info);
 
+static hg_return_t
+hg_test_bulk_buf_forward(hg_class_t *hg_class, hg_context_t *context,
+    hg_request_class_t *request_class, hg_addr_t target_addr, char *buf,
+    hg_size_t size);
+
 /*******************/
 /* Local Variables */
 /*******************/
@@ -391,6 +396,112 @@ done:
     return ret;
 }
 
+/*---------------------------------------------------------------------------*/
+static hg_return_t
+hg_test_bulk_digest(hg_class_t *hg_class, hg_context_t *context,
+    hg_request_class_t *request_class, hg_addr_t target_addr,
+    hg_size_t bulk_size, hg_size_t transfer_size,
+    hg_uint32_t origin_segment_count, hg_bool_t valid, size_t expected_bytes)
+{
+    hg_request_t *request = NULL;
+    hg_handle_t handle = HG_HANDLE_NULL;
+    hg_bulk_t bulk_handle = HG_BULK_NULL;
+    hg_return_t ret = HG_SUCCESS, cleanup_ret;
+    struct forward_cb_args forward_cb_args;
+    bulk_write_in_t bulk_write_in_struct;
+    void **buf_ptrs = NULL;
+    hg_size_t *buf_sizes = NULL;
+    hg_uint32_t digest;
+    size_t i;
+
+    /* Prepare bulk_buf */
+    buf_ptrs = (void **) calloc(origin_segment_count, sizeof(void *));
+    HG_TEST_CHECK_ERROR(buf_ptrs == NULL, done, ret, HG_NOMEM_ERROR,
+        "Could not allocate buf_ptrs");
+
+    buf_sizes = (hg_size_t *) malloc(origin_segment_count * sizeof(hg_size_t));
+    HG_TEST_CHECK_ERROR(buf_sizes == NULL, done, ret, HG_NOMEM_ERROR,
+        "Could not allocate buf_sizes");
+
+    for (i = 0; i < origin_segment_count; i++) {
+        hg_size_t j;
+
+        buf_sizes[i] = bulk_size / origin_segment_count;
+        buf_ptrs[i] = malloc(buf_sizes[i]);
+        HG_TEST_CHECK_ERROR(buf_ptrs[i] == NULL, done, ret, HG_NOMEM_ERROR,
+            "Could not allocate bulk_buf");
+
+        for (j = 0; j < buf_sizes[i]; j++)
+            ((char **) buf_ptrs)[i][j] = (char) (i * buf_sizes[i] + j);
+    }
+
+    request = hg_request_create(request_class);
+
+    ret = HG_Create(context, target_addr, hg_test_bulk_write_id_g, &handle);
+    HG_TEST_CHECK_HG_ERROR(
+        done, ret, "HG_Create() failed (%s)", HG_Error_to_string(ret));
+
+    /* Register memory */
+    ret = HG_Bulk_create(hg_class, origin_segment_count, buf_ptrs, buf_sizes,
+        HG_BULK_READ_ONLY, &bulk_handle);
+    HG_TEST_CHECK_HG_ERROR(
+        done, ret, "HG_Bulk_create() failed (%s)", HG_Error_to_string(ret));
+
+    /* Attach digest, corrupt it if requested */
+    ret = HG_Bulk_compute_digest(bulk_handle, &digest);
+    HG_TEST_CHECK_HG_ERROR(done, ret, "HG_Bulk_compute_digest() failed (%s)",
+        HG_Error_to_string(ret));
+
+    ret = HG_Bulk_set_digest(bulk_handle, valid ? digest : ~digest);
+    HG_TEST_CHECK_HG_ERROR(
+        done, ret, "HG_Bulk_set_digest() failed (%s)", HG_Error_to_string(ret));
+
+    /* Fill input structure */
+    bulk_write_in_struct.fildes = 0;
+    bulk_write_in_struct.transfer_size = transfer_size;
+    bulk_write_in_struct.origin_offset = 0;
+    bulk_write_in_struct.target_offset = 0;
+    bulk_write_in_struct.bulk_handle = bulk_handle;
+
+    /* Forward call to remote addr and get a new request */
+    HG_TEST_LOG_DEBUG(
+        "Forwarding call with op id: %" PRIu64 "...", hg_test_bulk_write_id_g);
+    forward_cb_args.request = request;
+    forward_cb_args.expected_bytes = expected_bytes;
+    forward_cb_args.ret = HG_SUCCESS;
+    ret = HG_Forward(handle, hg_test_bulk_forward_cb, &forward_cb_args,
+        &bulk_write_in_struct);
+    HG_TEST_CHECK_HG_ERROR(
+        done, ret, "HG_Forward() failed (%s)", HG_Error_to_string(ret));
+
+    hg_request_wait(request, HG_MAX_IDLE_TIME, NULL);
+
+    /* Assign ret from CB */
+    ret = forward_cb_args.ret;
+
+done:
+    /* Free memory handle */
+    cleanup_ret = HG_Bulk_free(bulk_handle);
+    HG_TEST_CHECK_ERROR_DONE(cleanup_ret != HG_SUCCESS,
+        "HG_Bulk_free() failed (%s)", HG_Error_to_string(cleanup_ret));
+
+    cleanup_ret = HG_Destroy(handle);
+    HG_TEST_CHECK_ERROR_DONE(cleanup_ret != HG_SUCCESS,
+        "HG_Destroy() failed (%s)", HG_Error_to_string(cleanup_ret));
+
+    hg_request_destroy(request);
+
+    /* Free bulk data */
+    if (buf_ptrs) {
+        for (i = 0; i < origin_segment_count; i++)
+            free(buf_ptrs[i]);
+        free(buf_ptrs);
+    }
+    free(buf_sizes);
+
+    return ret;
+}
+
 /*---------------------------------------------------------------------------*/
 static hg_return_t
 hg_test_bulk_small(hg_class_t *hg_class, hg_context_t *context,
@@ -470,6 +581,139 @@ done:
     return ret;
 }
 
+/*---------------------------------------------------------------------------*/
+static hg_return_t
+hg_test_bulk_buf_forward(hg_class_t *hg_class, hg_context_t *context,
+    hg_request_class_t *request_class, hg_addr_t target_addr, char *buf,
+    hg_size_t size)
+{
+    hg_request_t *request = NULL;
+    hg_handle_t handle = HG_HANDLE_NULL;
+    hg_bulk_t bulk_handle = HG_BULK_NULL;
+    hg_return_t ret = HG_SUCCESS, cleanup_ret;
+    struct forward_cb_args forward_cb_args;
+    bulk_write_in_t bulk_write_in_struct;
+    void *buf_ptr = buf;
+    hg_size_t i;
+
+    for (i = 0; i < size; i++)
+        buf[i] = (char) i;
+
+    request = hg_request_create(request_class);
+
+    /* Create single-segment handle over buffer */
+    ret = HG_Bulk_create(
+        hg_class, 1, &buf_ptr, &size, HG_BULK_READ_ONLY, &bulk_handle);
+    HG_TEST_CHECK_HG_ERROR(
+        done, ret, "HG_Bulk_create() failed (%s)", HG_Error_to_string(ret));
+
+    ret = HG_Create(context, target_addr, hg_test_bulk_write_id_g, &handle);
+    HG_TEST_CHECK_HG_ERROR(
+        done, ret, "HG_Create() failed (%s)", HG_Error_to_string(ret));
+
+    /* Fill input structure */
+    bulk_write_in_struct.fildes = 0;
+    bulk_write_in_struct.transfer_size = size;
+    bulk_write_in_struct.origin_offset = 0;
+    bulk_write_in_struct.target_offset = 0;
+    bulk_write_in_struct.bulk_handle = bulk_handle;
+
+    forward_cb_args.request = request;
+    forward_cb_args.expected_bytes = size;
+    forward_cb_args.ret = HG_SUCCESS;
+    ret = HG_Forward(handle, hg_test_bulk_forward_cb, &forward_cb_args,
+        &bulk_write_in_struct);
+    HG_TEST_CHECK_HG_ERROR(
+        done, ret, "HG_Forward() failed (%s)", HG_Error_to_string(ret));
+
+    hg_request_wait(request, HG_MAX_IDLE_TIME, NULL);
+
+    /* Assign ret from CB */
+    ret = forward_cb_args.ret;
+
+done:
+    cleanup_ret = HG_Bulk_free(bulk_handle);
+    HG_TEST_CHECK_ERROR_DONE(cleanup_ret != HG_SUCCESS,
+        "HG_Bulk_free() failed (%s)", HG_Error_to_string(cleanup_ret));
+
+    cleanup_ret = HG_Destroy(handle);
+    HG_TEST_CHECK_ERROR_DONE(cleanup_ret != HG_SUCCESS,
+        "HG_Destroy() failed (%s)", HG_Error_to_string(cleanup_ret));
+
+    hg_request_destroy(request);
+
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static hg_return_t
+hg_test_bulk_buf(hg_class_t *hg_class, hg_context_t *context,
+    hg_request_class_t *request_class, hg_addr_t target_addr,
+    hg_size_t bulk_size)
+{
+    char **bufs = NULL;
+    char *buf = NULL, *small_buf = NULL;
+    size_t buf_count = HG_TEST_BULK_BUF_SLAB_SIZE / bulk_size + 1, i;
+    hg_return_t ret = HG_SUCCESS;
+
+    /* Freed buffers are reused for same size */
+    buf = HG_Bulk_buf_alloc(hg_class, bulk_size);
+    HG_TEST_CHECK_ERROR(
+        buf == NULL, done, ret, HG_NOMEM, "HG_Bulk_buf_alloc() failed");
+    HG_Bulk_buf_free(hg_class, buf);
+    small_buf = HG_Bulk_buf_alloc(hg_class, bulk_size);
+    HG_TEST_CHECK_ERROR(
+        small_buf == NULL, done, ret, HG_NOMEM, "HG_Bulk_buf_alloc() failed");
+    HG_TEST_CHECK_ERROR(small_buf != buf, done, ret, HG_FAULT,
+        "Freed buffer was not reused (%p != %p)", (void *) small_buf,
+        (void *) buf);
+    small_buf = NULL;
+
+    /* Smaller buffers come from another size class */
+    small_buf = HG_Bulk_buf_alloc(hg_class, bulk_size / 2);
+    HG_TEST_CHECK_ERROR(
+        small_buf == NULL, done, ret, HG_NOMEM, "HG_Bulk_buf_alloc() failed");
+    HG_TEST_CHECK_ERROR(small_buf == buf, done, ret, HG_FAULT,
+        "Buffer in use was returned twice");
+
+    /* Transfer from slab buffer, then from part of it */
+    ret = hg_test_bulk_buf_forward(
+        hg_class, context, request_class, target_addr, buf, bulk_size);
+    HG_TEST_CHECK_HG_ERROR(done, ret, "hg_test_bulk_buf_forward() failed (%s)",
+        HG_Error_to_string(ret));
+
+    ret = hg_test_bulk_buf_forward(hg_class, context, request_class,
+        target_addr, buf + bulk_size / 2, bulk_size / 2);
+    HG_TEST_CHECK_HG_ERROR(done, ret, "hg_test_bulk_buf_forward() failed (%s)",
+        HG_Error_to_string(ret));
+
+    /* Exhaust slab, remaining buffers fall back to regular memory */
+    bufs = (char **) calloc(buf_count, sizeof(*bufs));
+    HG_TEST_CHECK_ERROR(
+        bufs == NULL, done, ret, HG_NOMEM, "Could not allocate buffer array");
+    for (i = 0; i < buf_count; i++) {
+        bufs[i] = HG_Bulk_buf_alloc(hg_class, bulk_size);
+        HG_TEST_CHECK_ERROR(bufs[i] == NULL, done, ret, HG_NOMEM,
+            "HG_Bulk_buf_alloc() failed (%zu/%zu)", i, buf_count);
+    }
+
+    ret = hg_test_bulk_buf_forward(hg_class, context, request_class,
+        target_addr, bufs[buf_count - 1], bulk_size);
+    HG_TEST_CHECK_HG_ERROR(done, ret, "hg_test_bulk_buf_forward() failed (%s)",
+        HG_Error_to_string(ret));
+
+done:
+    if (bufs) {
+        for (i = 0; i < buf_count; i++)
+            HG_Bulk_buf_free(hg_class, bufs[i]);
+        free(bufs);
+    }
+    HG_Bulk_buf_free(hg_class, small_buf);
+    HG_Bulk_buf_free(hg_class, buf);
+
+    return ret;
+}
+
 /*---------------------------------------------------------------------------*/
 int
 main(int argc, char *argv[])
@@ -526,6 +770,17 @@ main(int argc, char *argv[])
         "contiguous RPC bulk failed");
     HG_PASSED();
 
+    /* Bulk buffers test */
+    HG_TEST("bulk buffers RPC bulk");
+    hg_ret = hg_test_bulk_buf(info.hg_class, info.context, info.request_class,
+        info.target_addr,
+        (buf_size > HG_TEST_BULK_BUF_SLAB_SIZE / 2)
+            ? HG_TEST_BULK_BUF_SLAB_SIZE / 2
+            : buf_size);
+    HG_TEST_CHECK_ERROR(hg_ret != HG_SUCCESS, done, ret, EXIT_FAILURE,
+        "bulk buffers RPC bulk failed");
+    HG_PASSED();
+
     /* small bulk test */
     HG_TEST("small segmented RPC bulk (size 8, offsets 0, 0)");
     hg_ret = hg_test_bulk_small(info.hg_class, info.context, info.request_class,
@@ -597,6 +852,32 @@ main(int argc, char *argv[])
     HG_PASSED();
 #endif
 
+    /* Digest RPC bulk tests, server pulls with checksums enabled */
+    HG_TEST("digest segmented RPC bulk (size BUFSIZE, valid digest)");
+    hg_ret = hg_test_bulk_digest(info.hg_class, info.context,
+        info.request_class, info.target_addr, buf_size, buf_size, 16, HG_TRUE,
+        buf_size);
+    HG_TEST_CHECK_ERROR(hg_ret != HG_SUCCESS, done, ret, EXIT_FAILURE,
+        "digest segmented RPC bulk failed");
+    HG_PASSED();
+
+    HG_TEST("digest segmented RPC bulk (size BUFSIZE, digest mismatch)");
+    hg_ret = hg_test_bulk_digest(info.hg_class, info.context,
+        info.request_class, info.target_addr, buf_size, buf_size, 16, HG_FALSE,
+        0);
+    HG_TEST_CHECK_ERROR(hg_ret != HG_SUCCESS, done, ret, EXIT_FAILURE,
+        "digest segmented RPC bulk failed");
+    HG_PASSED();
+
+    /* Partial pulls are not verified against origin digest */
+    HG_TEST("digest segmented RPC bulk (size BUFSIZE/2, digest mismatch)");
+    hg_ret = hg_test_bulk_digest(info.hg_class, info.context,
+        info.request_class, info.target_addr, buf_size, buf_size / 2, 16,
+        HG_FALSE, buf_size / 2);
+    HG_TEST_CHECK_ERROR(hg_ret != HG_SUCCESS, done, ret, EXIT_FAILURE,
+        "digest segmented RPC bulk failed");
+    HG_PASSED();
+
     if (strcmp(HG_Class_get_name(info.hg_class), "ofi") == 0 ||
         strcmp(HG_Class_get_name(info.hg_class), "na") == 0 ||
         strcmp(HG_Class_get_name(info.hg_class), "ucx") == 0) {
@@ -7,10 +7,27 @@
 
 #include "mercury_unit.h"
 
+#ifdef NA_HAS_SM
+#    include "na_sm.h"
+#endif
+
 /****************/
 /* Local Macros */
 /****************/
 
+/* Number of times each target name appears in a batched lookup */
+#define HG_TEST_LOOKUP_DUP (4)
+
+/* Number of entries in serialized address tables */
+#define HG_TEST_ADDR_TABLE_COUNT (8)
+
+/* Address table layout: magic, version and flags, count, then first section
+ * starting with its stride */
+#define HG_TEST_ADDR_TABLE_VERSION_OFFSET (sizeof(hg_uint32_t))
+#define HG_TEST_ADDR_TABLE_COUNT_OFFSET (2 * sizeof(hg_uint32_t))
+#define HG_TEST_ADDR_TABLE_HEADER_SIZE                                         \
+    (2 * sizeof(hg_uint32_t) + sizeof(hg_uint64_t))
+
 /************************************/
 /* Local Type and Struct Definition */
 /************************************/
@@ -22,6 +39,11 @@ struct hg_test_thread_args {
     unsigned int n_threads;
 };
 
+struct hg_test_null_args {
+    hg_request_t *request;
+    hg_return_t ret;
+};
+
 /********************/
 /* Local Prototypes */
 /********************/
@@ -29,10 +51,47 @@ struct hg_test_thread_args {
 static hg_return_t
 hg_test_rpc_lookup(hg_class_t *hg_class, const char *target_name);
 
+static hg_return_t
+hg_test_null_rpc(struct hg_unit_info *info, hg_addr_t addr);
+
+static hg_return_t
+hg_test_lookup_cached(struct hg_unit_info *info);
+
+static hg_return_t
+hg_test_lookup_multi(struct hg_unit_info *info);
+
+static hg_return_t
+hg_test_lookup_set_remove(struct hg_unit_info *info);
+
+static hg_return_t
+hg_test_addr_table_create(hg_addr_t *addrs, size_t count, unsigned long flags,
+    void **buf_p, hg_size_t *buf_size_p);
+
+static hg_return_t
+hg_test_addr_table_check(struct hg_unit_info *info, const void *buf,
+    hg_size_t buf_size, size_t count, hg_addr_t target_addr);
+
+static hg_return_t
+hg_test_addr_table_truncate(
+    struct hg_unit_info *info, const void *buf, hg_size_t buf_size);
+
+static hg_return_t
+hg_test_addr_table_fixed(struct hg_unit_info *info);
+
+static hg_return_t
+hg_test_addr_table_var(struct hg_unit_info *info);
+
+#ifdef NA_HAS_SM
+static hg_return_t
+hg_test_addr_table_sm_remote(struct hg_unit_info *info);
+#endif
+
 /*******************/
 /* Local Variables */
 /*******************/
 
+extern hg_id_t hg_test_rpc_null_id_g;
+
 /*---------------------------------------------------------------------------*/
 static HG_THREAD_RETURN_TYPE
 hg_test_lookup_thread(void *arg)
@@ -96,6 +155,560 @@ error:
     return ret;
 }
 
+/*---------------------------------------------------------------------------*/
+static hg_return_t
+hg_test_null_cb(const struct hg_cb_info *callback_info)
+{
+    struct hg_test_null_args *args =
+        (struct hg_test_null_args *) callback_info->arg;
+
+    args->ret = callback_info->ret;
+    hg_request_complete(args->request);
+
+    return HG_SUCCESS;
+}
+
+/*---------------------------------------------------------------------------*/
+static hg_return_t
+hg_test_null_rpc(struct hg_unit_info *info, hg_addr_t addr)
+{
+    struct hg_test_null_args args = {.request = NULL, .ret = HG_SUCCESS};
+    hg_handle_t handle = HG_HANDLE_NULL;
+    hg_return_t ret, cleanup_ret;
+
+    args.request = hg_request_create(info->request_class);
+
+    ret = HG_Create(info->context, addr, hg_test_rpc_null_id_g, &handle);
+    HG_TEST_CHECK_HG_ERROR(
+        done, ret, "HG_Create() failed (%s)", HG_Error_to_string(ret));
+
+    ret = HG_Forward(handle, hg_test_null_cb, &args, NULL);
+    HG_TEST_CHECK_HG_ERROR(
+        done, ret, "HG_Forward() failed (%s)", HG_Error_to_string(ret));
+
+    hg_request_wait(args.request, HG_MAX_IDLE_TIME, NULL);
+
+    ret = args.ret;
+    HG_TEST_CHECK_HG_ERROR(
+        done, ret, "Error in HG callback (%s)", HG_Error_to_string(ret));
+
+done:
+    cleanup_ret = HG_Destroy(handle);
+    HG_TEST_CHECK_ERROR_DONE(cleanup_ret != HG_SUCCESS,
+        "HG_Destroy() failed (%s)", HG_Error_to_string(cleanup_ret));
+
+    hg_request_destroy(args.request);
+
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static hg_return_t
+hg_test_lookup_cached(struct hg_unit_info *info)
+{
+    const char *target_name = info->hg_test_info.na_test_info.target_name;
+    hg_addr_t addrs[2] = {HG_ADDR_NULL, HG_ADDR_NULL};
+    hg_return_t ret;
+    int i;
+
+    for (i = 0; i < 2; i++) {
+        ret = HG_Addr_lookup2(info->hg_class, target_name, &addrs[i]);
+        HG_TEST_CHECK_HG_ERROR(done, ret, "HG_Addr_lookup2() failed (%s)",
+            HG_Error_to_string(ret));
+    }
+
+    /* Second lookup is a cache hit and returns the same addr */
+    HG_TEST_CHECK_ERROR(!HG_Addr_cmp(info->hg_class, addrs[0], addrs[1]), done,
+        ret, HG_FAULT, "Addresses of %s do not match", target_name);
+    HG_TEST_CHECK_ERROR(info->hg_test_info.addr_cache && addrs[0] != addrs[1],
+        done, ret, HG_FAULT, "Lookup of %s was not served from cache",
+        target_name);
+
+    ret = hg_test_null_rpc(info, addrs[1]);
+    HG_TEST_CHECK_HG_ERROR(done, ret, "hg_test_null_rpc() failed (%s)",
+        HG_Error_to_string(ret));
+
+done:
+    for (i = 0; i < 2; i++)
+        (void) HG_Addr_free(info->hg_class, addrs[i]);
+
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static hg_return_t
+hg_test_lookup_multi(struct hg_unit_info *info)
+{
+    const struct na_test_info *na_test_info = &info->hg_test_info.na_test_info;
+    size_t count = (size_t) na_test_info->max_targets * HG_TEST_LOOKUP_DUP;
+    const char **names = NULL;
+    hg_addr_t *addrs = NULL;
+    hg_addr_t cached_addr = HG_ADDR_NULL;
+    hg_return_t ret;
+    size_t i;
+
+    names = (const char **) malloc(count * sizeof(*names));
+    addrs = (hg_addr_t *) calloc(count, sizeof(*addrs));
+    HG_TEST_CHECK_ERROR(names == NULL || addrs == NULL, done, ret, HG_NOMEM,
+        "Could not allocate lookup arrays");
+
+    /* Same names appear several times within the batch */
+    for (i = 0; i < count; i++)
+        names[i] = na_test_info->target_names[i % na_test_info->max_targets];
+
+    /* Entry for first name is already cached when the batch is issued */
+    ret = HG_Addr_lookup2(info->hg_class, names[0], &cached_addr);
+    HG_TEST_CHECK_HG_ERROR(
+        done, ret, "HG_Addr_lookup2() failed (%s)", HG_Error_to_string(ret));
+
+    /* SM and TCP do not implement addr_lookup_multi, NA falls back to
+     * individual lookups */
+    ret = HG_Addr_lookup_multi(info->hg_class, names, count, addrs);
+    HG_TEST_CHECK_HG_ERROR(done, ret, "HG_Addr_lookup_multi() failed (%s)",
+        HG_Error_to_string(ret));
+
+    for (i = 0; i < count; i++) {
+        hg_addr_t first_addr = addrs[i % na_test_info->max_targets];
+
+        HG_TEST_CHECK_ERROR(addrs[i] == HG_ADDR_NULL, done, ret, HG_FAULT,
+            "NULL addr returned for %s", names[i]);
+        HG_TEST_CHECK_ERROR(!HG_Addr_cmp(info->hg_class, addrs[i], first_addr),
+            done, ret, HG_FAULT, "Addresses of %s do not match", names[i]);
+
+        /* Duplicate names map to a single cache entry */
+        HG_TEST_CHECK_ERROR(
+            info->hg_test_info.addr_cache && addrs[i] != first_addr, done, ret,
+            HG_FAULT, "Duplicates of %s were not merged", names[i]);
+    }
+    HG_TEST_CHECK_ERROR(info->hg_test_info.addr_cache &&
+                            addrs[0] != cached_addr,
+        done, ret, HG_FAULT, "Lookup of %s was not served from cache",
+        names[0]);
+
+    for (i = 0; i < na_test_info->max_targets; i++) {
+        ret = hg_test_null_rpc(info, addrs[i]);
+        HG_TEST_CHECK_HG_ERROR(done, ret, "hg_test_null_rpc() failed (%s)",
+            HG_Error_to_string(ret));
+    }
+
+done:
+    if (addrs != NULL) {
+        for (i = 0; i < count; i++)
+            (void) HG_Addr_free(info->hg_class, addrs[i]);
+    }
+    (void) HG_Addr_free(info->hg_class, cached_addr);
+    free(names);
+    free(addrs);
+
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static hg_return_t
+hg_test_lookup_set_remove(struct hg_unit_info *info)
+{
+    const char *target_name = info->hg_test_info.na_test_info.target_name;
+    hg_addr_t removed_addr = HG_ADDR_NULL, addr = HG_ADDR_NULL;
+    hg_return_t ret;
+
+    ret = HG_Addr_lookup2(info->hg_class, target_name, &removed_addr);
+    HG_TEST_CHECK_HG_ERROR(
+        done, ret, "HG_Addr_lookup2() failed (%s)", HG_Error_to_string(ret));
+
+    /* Removal evicts the cache entry, addr stays valid until freed */
+    ret = HG_Addr_set_remove(info->hg_class, removed_addr);
+    HG_TEST_CHECK_HG_ERROR(done, ret, "HG_Addr_set_remove() failed (%s)",
+        HG_Error_to_string(ret));
+
+    ret = HG_Addr_lookup2(info->hg_class, target_name, &addr);
+    HG_TEST_CHECK_HG_ERROR(
+        done, ret, "HG_Addr_lookup2() failed (%s)", HG_Error_to_string(ret));
+    HG_TEST_CHECK_ERROR(addr == removed_addr, done, ret, HG_FAULT,
+        "Removed addr of %s was returned from cache", target_name);
+
+    ret = hg_test_null_rpc(info, addr);
+    HG_TEST_CHECK_HG_ERROR(done, ret, "hg_test_null_rpc() failed (%s)",
+        HG_Error_to_string(ret));
+
+done:
+    (void) HG_Addr_free(info->hg_class, removed_addr);
+    (void) HG_Addr_free(info->hg_class, addr);
+
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static hg_return_t
+hg_test_addr_table_create(hg_addr_t *addrs, size_t count, unsigned long flags,
+    void **buf_p, hg_size_t *buf_size_p)
+{
+    hg_size_t buf_size;
+    void *buf = NULL;
+    hg_return_t ret;
+
+    buf_size = HG_Core_addr_table_get_serialize_size(
+        (const hg_core_addr_t *) addrs, (hg_size_t) count, flags);
+    HG_TEST_CHECK_ERROR(buf_size == 0, error, ret, HG_FAULT,
+        "HG_Core_addr_table_get_serialize_size() failed");
+
+    buf = malloc(buf_size);
+    HG_TEST_CHECK_ERROR(
+        buf == NULL, error, ret, HG_NOMEM, "Could not allocate table");
+
+    ret = HG_Core_addr_table_serialize(buf, buf_size, flags,
+        (const hg_core_addr_t *) addrs, (hg_size_t) count);
+    HG_TEST_CHECK_HG_ERROR(error, ret,
+        "HG_Core_addr_table_serialize() failed (%s)", HG_Error_to_string(ret));
+
+    *buf_p = buf;
+    *buf_size_p = buf_size;
+
+    return HG_SUCCESS;
+
+error:
+    free(buf);
+
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static hg_return_t
+hg_test_addr_table_check(struct hg_unit_info *info, const void *buf,
+    hg_size_t buf_size, size_t count, hg_addr_t target_addr)
+{
+    hg_addr_t addrs[HG_TEST_ADDR_TABLE_COUNT];
+    hg_size_t table_count = 0;
+    hg_return_t ret;
+    size_t i;
+
+    ret = HG_Core_addr_table_get_count(buf, buf_size, &table_count);
+    HG_TEST_CHECK_HG_ERROR(done, ret,
+        "HG_Core_addr_table_get_count() failed (%s)", HG_Error_to_string(ret));
+    HG_TEST_CHECK_ERROR(table_count != (hg_size_t) count, done, ret, HG_FAULT,
+        "Table count %" PRIu64 " does not match %zu", table_count, count);
+
+    /* Table is rejected if count does not match */
+    HG_Test_log_disable(); // Expected to produce errors
+    ret = HG_Core_addr_table_deserialize(info->hg_class->core_class,
+        (hg_core_addr_t *) addrs, (hg_size_t) count - 1, buf, buf_size);
+    HG_Test_log_enable();
+    HG_TEST_CHECK_ERROR(ret != HG_INVALID_ARG, done, ret, HG_FAULT,
+        "Deserialize with count mismatch returned %s",
+        HG_Error_to_string(ret));
+
+    ret = HG_Core_addr_table_deserialize(info->hg_class->core_class,
+        (hg_core_addr_t *) addrs, (hg_size_t) count, buf, buf_size);
+    HG_TEST_CHECK_HG_ERROR(done, ret,
+        "HG_Core_addr_table_deserialize() failed (%s)",
+        HG_Error_to_string(ret));
+
+    for (i = 0; i < count; i++) {
+        HG_TEST_CHECK_ERROR(
+            !HG_Addr_cmp(info->hg_class, addrs[i], target_addr), free, ret,
+            HG_FAULT, "Deserialized addr %zu does not match target", i);
+#ifdef NA_HAS_SM
+        /* SM entries are not restored without local SM class */
+        HG_TEST_CHECK_ERROR(
+            HG_Core_addr_get_na_sm((hg_core_addr_t) addrs[i]) != NULL &&
+                info->hg_class->core_class->na_sm_class == NULL,
+            free, ret, HG_FAULT, "Unexpected SM addr %zu", i);
+#endif
+    }
+
+    /* Deserialized addresses are usable */
+    ret = hg_test_null_rpc(info, addrs[count - 1]);
+    HG_TEST_CHECK_HG_ERROR(free, ret, "hg_test_null_rpc() failed (%s)",
+        HG_Error_to_string(ret));
+
+free:
+    for (i = 0; i < count; i++)
+        (void) HG_Addr_free(info->hg_class, addrs[i]);
+
+done:
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static hg_return_t
+hg_test_addr_table_truncate(
+    struct hg_unit_info *info, const void *buf, hg_size_t buf_size)
+{
+    hg_addr_t addrs[HG_TEST_ADDR_TABLE_COUNT];
+    hg_size_t count = 0, len;
+    hg_return_t ret;
+
+    ret = HG_Core_addr_table_get_count(buf, buf_size, &count);
+    HG_TEST_CHECK_HG_ERROR(done, ret,
+        "HG_Core_addr_table_get_count() failed (%s)", HG_Error_to_string(ret));
+
+    /* Every truncation must be detected, no partial table is returned */
+    HG_Test_log_disable(); // Expected to produce errors
+    for (len = 1; len < buf_size; len++) {
+        ret = HG_Core_addr_table_deserialize(info->hg_class->core_class,
+            (hg_core_addr_t *) addrs, count, buf, len);
+        if (ret == HG_SUCCESS) {
+            hg_size_t i;
+
+            for (i = 0; i < count; i++)
+                (void) HG_Addr_free(info->hg_class, addrs[i]);
+            break;
+        }
+    }
+    HG_Test_log_enable();
+    HG_TEST_CHECK_ERROR(len < buf_size, done, ret, HG_FAULT,
+        "Table truncated to %" PRIu64 "/%" PRIu64 " bytes was accepted", len,
+        buf_size);
+
+    ret = HG_SUCCESS;
+
+done:
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static hg_return_t
+hg_test_addr_table_fixed(struct hg_unit_info *info)
+{
+    hg_addr_t addrs[HG_TEST_ADDR_TABLE_COUNT];
+    hg_addr_t target_addr = HG_ADDR_NULL;
+    void *buf = NULL;
+    hg_size_t buf_size = 0;
+    hg_uint64_t stride;
+    hg_return_t ret;
+    size_t i;
+
+    ret = HG_Addr_lookup2(info->hg_class,
+        info->hg_test_info.na_test_info.target_name, &target_addr);
+    HG_TEST_CHECK_HG_ERROR(
+        done, ret, "HG_Addr_lookup2() failed (%s)", HG_Error_to_string(ret));
+
+    /* All entries have the same size and are packed */
+    for (i = 0; i < HG_TEST_ADDR_TABLE_COUNT; i++)
+        addrs[i] = target_addr;
+
+    ret = hg_test_addr_table_create(
+        addrs, HG_TEST_ADDR_TABLE_COUNT, 0, &buf, &buf_size);
+    HG_TEST_CHECK_HG_ERROR(done, ret, "hg_test_addr_table_create() failed (%s)",
+        HG_Error_to_string(ret));
+
+    memcpy(&stride, (const char *) buf + HG_TEST_ADDR_TABLE_HEADER_SIZE,
+        sizeof(stride));
+    HG_TEST_CHECK_ERROR(stride == 0, done, ret, HG_FAULT,
+        "Table entries were not packed at a fixed stride");
+
+    /* SM and TCP have no addr_deserialize_multi, NA falls back to individual
+     * deserialization */
+    ret = hg_test_addr_table_check(
+        info, buf, buf_size, HG_TEST_ADDR_TABLE_COUNT, target_addr);
+    HG_TEST_CHECK_HG_ERROR(done, ret, "hg_test_addr_table_check() failed (%s)",
+        HG_Error_to_string(ret));
+
+    ret = hg_test_addr_table_truncate(info, buf, buf_size);
+    HG_TEST_CHECK_HG_ERROR(done, ret,
+        "hg_test_addr_table_truncate() failed (%s)", HG_Error_to_string(ret));
+
+    /* Stride that does not fit the buffer */
+    stride = (hg_uint64_t) buf_size;
+    memcpy((char *) buf + HG_TEST_ADDR_TABLE_HEADER_SIZE, &stride,
+        sizeof(stride));
+    HG_Test_log_disable(); // Expected to produce errors
+    ret = HG_Core_addr_table_deserialize(info->hg_class->core_class,
+        (hg_core_addr_t *) addrs, HG_TEST_ADDR_TABLE_COUNT, buf, buf_size);
+    HG_Test_log_enable();
+    if (ret == HG_SUCCESS) {
+        for (i = 0; i < HG_TEST_ADDR_TABLE_COUNT; i++)
+            (void) HG_Addr_free(info->hg_class, addrs[i]);
+    }
+    HG_TEST_CHECK_ERROR(ret == HG_SUCCESS, done, ret, HG_FAULT,
+        "Table with invalid stride was accepted");
+
+    ret = HG_SUCCESS;
+
+done:
+    free(buf);
+    (void) HG_Addr_free(info->hg_class, target_addr);
+
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static hg_return_t
+hg_test_addr_table_var(struct hg_unit_info *info)
+{
+    hg_addr_t addrs[3] = {HG_ADDR_NULL, HG_ADDR_NULL, HG_ADDR_NULL};
+    hg_addr_t target_addr = HG_ADDR_NULL;
+    void *entry_buf = NULL, *re_buf = NULL;
+    char *buf = NULL, *buf_ptr;
+    hg_size_t entry_buf_size = 0, re_buf_size = 0, buf_size;
+    hg_uint64_t count = 3, stride;
+    hg_uint32_t size32;
+    hg_return_t ret;
+    size_t i;
+
+    ret = HG_Addr_lookup2(info->hg_class,
+        info->hg_test_info.na_test_info.target_name, &target_addr);
+    HG_TEST_CHECK_HG_ERROR(
+        done, ret, "HG_Addr_lookup2() failed (%s)", HG_Error_to_string(ret));
+
+    /* Single entry table gives header and serialized target addr */
+    ret = hg_test_addr_table_create(
+        &target_addr, 1, 0, &entry_buf, &entry_buf_size);
+    HG_TEST_CHECK_HG_ERROR(done, ret, "hg_test_addr_table_create() failed (%s)",
+        HG_Error_to_string(ret));
+    memcpy(&stride, (const char *) entry_buf + HG_TEST_ADDR_TABLE_HEADER_SIZE,
+        sizeof(stride));
+    size32 = (hg_uint32_t) stride;
+
+    /* Build {target, empty, target} with each entry prefixed by its size */
+    buf_size = HG_TEST_ADDR_TABLE_HEADER_SIZE + sizeof(hg_uint64_t) +
+               3 * sizeof(hg_uint32_t) + 2 * (hg_size_t) stride;
+    buf = (char *) calloc(1, buf_size);
+    HG_TEST_CHECK_ERROR(
+        buf == NULL, done, ret, HG_NOMEM, "Could not allocate table");
+    memcpy(buf, entry_buf, HG_TEST_ADDR_TABLE_COUNT_OFFSET);
+    memcpy(buf + HG_TEST_ADDR_TABLE_COUNT_OFFSET, &count, sizeof(count));
+    buf_ptr = buf + HG_TEST_ADDR_TABLE_HEADER_SIZE + sizeof(hg_uint64_t);
+    for (i = 0; i < 3; i++) {
+        hg_uint32_t entry_size = (i == 1) ? 0 : size32;
+
+        memcpy(buf_ptr, &entry_size, sizeof(entry_size));
+        buf_ptr += sizeof(entry_size);
+        memcpy(buf_ptr,
+            (const char *) entry_buf + HG_TEST_ADDR_TABLE_HEADER_SIZE +
+                sizeof(hg_uint64_t),
+            entry_size);
+        buf_ptr += entry_size;
+    }
+
+    ret = HG_Core_addr_table_deserialize(info->hg_class->core_class,
+        (hg_core_addr_t *) addrs, 3, buf, buf_size);
+    HG_TEST_CHECK_HG_ERROR(done, ret,
+        "HG_Core_addr_table_deserialize() failed (%s)",
+        HG_Error_to_string(ret));
+    HG_TEST_CHECK_ERROR(HG_Core_addr_get_na((hg_core_addr_t) addrs[1]) != NULL,
+        done, ret, HG_FAULT, "Empty entry was given an address");
+    HG_TEST_CHECK_ERROR(!HG_Addr_cmp(info->hg_class, addrs[0], target_addr) ||
+                            !HG_Addr_cmp(info->hg_class, addrs[2], target_addr),
+        done, ret, HG_FAULT, "Deserialized addr does not match target");
+
+    ret = hg_test_null_rpc(info, addrs[2]);
+    HG_TEST_CHECK_HG_ERROR(done, ret, "hg_test_null_rpc() failed (%s)",
+        HG_Error_to_string(ret));
+
+    /* Serializing again gives the same variable stride table */
+    ret = hg_test_addr_table_create(addrs, 3, 0, &re_buf, &re_buf_size);
+    HG_TEST_CHECK_HG_ERROR(done, ret, "hg_test_addr_table_create() failed (%s)",
+        HG_Error_to_string(ret));
+    HG_TEST_CHECK_ERROR(re_buf_size != buf_size ||
+                            memcmp(re_buf, buf, (size_t) buf_size) != 0,
+        done, ret, HG_FAULT, "Serialized table does not match original");
+
+    ret = hg_test_addr_table_truncate(info, buf, buf_size);
+    HG_TEST_CHECK_HG_ERROR(done, ret,
+        "hg_test_addr_table_truncate() failed (%s)", HG_Error_to_string(ret));
+
+done:
+    for (i = 0; i < 3; i++)
+        (void) HG_Addr_free(info->hg_class, addrs[i]);
+    (void) HG_Addr_free(info->hg_class, target_addr);
+    free(entry_buf);
+    free(re_buf);
+    free(buf);
+
+    return ret;
+}
+
+#ifdef NA_HAS_SM
+/*---------------------------------------------------------------------------*/
+static hg_return_t
+hg_test_addr_table_sm_remote(struct hg_unit_info *info)
+{
+    hg_addr_t addrs[HG_TEST_ADDR_TABLE_COUNT];
+    hg_addr_t target_addr = HG_ADDR_NULL;
+    void *na_buf = NULL;
+    char *buf = NULL, *buf_ptr;
+    hg_size_t na_buf_size = 0, buf_size;
+    hg_uint32_t version, entry_size = sizeof(hg_uint32_t);
+    hg_uint64_t stride = 0;
+    na_sm_id_t host_id;
+    na_return_t na_ret;
+    hg_return_t ret;
+    size_t i;
+
+    ret = HG_Addr_lookup2(info->hg_class,
+        info->hg_test_info.na_test_info.target_name, &target_addr);
+    HG_TEST_CHECK_HG_ERROR(
+        done, ret, "HG_Addr_lookup2() failed (%s)", HG_Error_to_string(ret));
+
+    for (i = 0; i < HG_TEST_ADDR_TABLE_COUNT; i++)
+        addrs[i] = target_addr;
+    ret = hg_test_addr_table_create(
+        addrs, HG_TEST_ADDR_TABLE_COUNT, 0, &na_buf, &na_buf_size);
+    HG_TEST_CHECK_HG_ERROR(done, ret, "hg_test_addr_table_create() failed (%s)",
+        HG_Error_to_string(ret));
+
+    /* Append an SM section of another host, its entries are not valid SM
+     * addresses and must not be decoded */
+    buf_size = na_buf_size + sizeof(na_sm_id_t) + sizeof(stride) +
+               HG_TEST_ADDR_TABLE_COUNT * 2 * sizeof(hg_uint32_t);
+    buf = (char *) malloc(buf_size);
+    HG_TEST_CHECK_ERROR(
+        buf == NULL, done, ret, HG_NOMEM, "Could not allocate table");
+    memcpy(buf, na_buf, na_buf_size);
+
+    memcpy(&version, buf + HG_TEST_ADDR_TABLE_VERSION_OFFSET, sizeof(version));
+    version |= (hg_uint32_t) HG_CORE_SM << 16;
+    memcpy(buf + HG_TEST_ADDR_TABLE_VERSION_OFFSET, &version, sizeof(version));
+
+    na_ret = NA_SM_Host_id_get(&host_id);
+    HG_TEST_CHECK_ERROR(na_ret != NA_SUCCESS, done, ret, (hg_return_t) na_ret,
+        "NA_SM_Host_id_get() failed (%s)", NA_Error_to_string(na_ret));
+    ((unsigned char *) &host_id)[0] ^= 0xff;
+
+    buf_ptr = buf + na_buf_size;
+    memcpy(buf_ptr, &host_id, sizeof(host_id));
+    buf_ptr += sizeof(host_id);
+    memcpy(buf_ptr, &stride, sizeof(stride));
+    buf_ptr += sizeof(stride);
+    for (i = 0; i < HG_TEST_ADDR_TABLE_COUNT; i++) {
+        memcpy(buf_ptr, &entry_size, sizeof(entry_size));
+        buf_ptr += sizeof(entry_size);
+        memset(buf_ptr, 0xff, entry_size);
+        buf_ptr += entry_size;
+    }
+
+    ret = hg_test_addr_table_check(
+        info, buf, buf_size, HG_TEST_ADDR_TABLE_COUNT, target_addr);
+    HG_TEST_CHECK_HG_ERROR(done, ret, "hg_test_addr_table_check() failed (%s)",
+        HG_Error_to_string(ret));
+
+    /* Same section claimed by the local host is decoded and rejected */
+    if (info->hg_class->core_class->na_sm_class != NULL) {
+        ((unsigned char *) &host_id)[0] ^= 0xff;
+        memcpy(buf + na_buf_size, &host_id, sizeof(host_id));
+
+        HG_Test_log_disable(); // Expected to produce errors
+        ret = HG_Core_addr_table_deserialize(info->hg_class->core_class,
+            (hg_core_addr_t *) addrs, HG_TEST_ADDR_TABLE_COUNT, buf, buf_size);
+        HG_Test_log_enable();
+        if (ret == HG_SUCCESS) {
+            for (i = 0; i < HG_TEST_ADDR_TABLE_COUNT; i++)
+                (void) HG_Addr_free(info->hg_class, addrs[i]);
+        }
+        HG_TEST_CHECK_ERROR(ret == HG_SUCCESS, done, ret, HG_FAULT,
+            "Invalid local SM section was accepted");
+        ret = HG_SUCCESS;
+    }
+
+done:
+    (void) HG_Addr_free(info->hg_class, target_addr);
+    free(na_buf);
+    free(buf);
+
+    return ret;
+}
+#endif
+
 /*---------------------------------------------------------------------------*/
 int
 main(int argc, char *argv[])
@@ -132,6 +745,45 @@ main(int argc, char *argv[])
 
     HG_PASSED();
 
+    HG_TEST("repeated lookup");
+    hg_ret = hg_test_lookup_cached(&info);
+    HG_TEST_CHECK_ERROR(hg_ret != HG_SUCCESS, done, ret, EXIT_FAILURE,
+        "repeated lookup test failed");
+    HG_PASSED();
+
+    HG_TEST("multi lookup");
+    hg_ret = hg_test_lookup_multi(&info);
+    HG_TEST_CHECK_ERROR(hg_ret != HG_SUCCESS, done, ret, EXIT_FAILURE,
+        "multi lookup test failed");
+    HG_PASSED();
+
+    HG_TEST("lookup after set remove");
+    hg_ret = hg_test_lookup_set_remove(&info);
+    HG_TEST_CHECK_ERROR(hg_ret != HG_SUCCESS, done, ret, EXIT_FAILURE,
+        "lookup after set remove test failed");
+    HG_PASSED();
+
+    HG_TEST("fixed stride address table");
+    hg_ret = hg_test_addr_table_fixed(&info);
+    HG_TEST_CHECK_ERROR(hg_ret != HG_SUCCESS, done, ret, EXIT_FAILURE,
+        "fixed stride address table test failed");
+    HG_PASSED();
+
+    HG_TEST("variable stride address table");
+    hg_ret = hg_test_addr_table_var(&info);
+    HG_TEST_CHECK_ERROR(hg_ret != HG_SUCCESS, done, ret, EXIT_FAILURE,
+        "variable stride address table test failed");
+    HG_PASSED();
+
+#ifdef NA_HAS_SM
+    HG_TEST("address table from remote host");
+    hg_ret = hg_test_addr_table_sm_remote(&info);
+    HG_TEST_CHECK_ERROR(hg_ret != HG_SUCCESS, done, ret, EXIT_FAILURE,
+        "address table from remote host test failed");
+    HG_PASSED();
+#endif
+
+    /* Target addr is left in the addr cache (if enabled) when finalizing */
     hg_ret = HG_Addr_lookup2(info.hg_class,
         info.hg_test_info.na_test_info.target_name, &info.target_addr);
     HG_TEST_CHECK_ERROR(hg_ret != HG_SUCCESS, done, ret, EXIT_FAILURE,
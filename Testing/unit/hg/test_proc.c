@@ -226,6 +226,34 @@ done:
     return ret;
 }
 
+#ifdef HG_HAS_CHECKSUMS
+/*---------------------------------------------------------------------------*/
+static hg_return_t
+hg_test_proc_hash(void)
+{
+    hg_proc_hash_t hashes[] = {HG_CRC16, HG_CRC64};
+    hg_return_t ret = HG_SUCCESS;
+    size_t i;
+
+    /* Only CRC32 is supported, other methods must be rejected */
+    for (i = 0; i < sizeof(hashes) / sizeof(hashes[0]); i++) {
+        hg_proc_t proc = HG_PROC_NULL;
+        hg_return_t hg_ret =
+            hg_proc_create((hg_class_t *) 1, hashes[i], &proc);
+
+        if (hg_ret == HG_SUCCESS)
+            hg_proc_free(proc);
+        HG_TEST_CHECK_ERROR(hg_ret != HG_PROTONOSUPPORT, done, ret,
+            HG_PROTOCOL_ERROR,
+            "hg_proc_create() returned %s instead of HG_PROTONOSUPPORT",
+            HG_Error_to_string(hg_ret));
+    }
+
+done:
+    return ret;
+}
+#endif
+
 /*---------------------------------------------------------------------------*/
 int
 main(void)
@@ -247,6 +275,15 @@ main(void)
         "string proc test failed");
     HG_PASSED();
 
+#ifdef HG_HAS_CHECKSUMS
+    /* unsupported hash test */
+    HG_TEST("unsupported proc hash");
+    hg_ret = hg_test_proc_hash();
+    HG_TEST_CHECK_ERROR(hg_ret != HG_SUCCESS, done, ret, EXIT_FAILURE,
+        "unsupported proc hash test failed");
+    HG_PASSED();
+#endif
+
 done:
     if (ret != EXIT_SUCCESS)
         HG_FAILED();
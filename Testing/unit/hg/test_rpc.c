@@ -14,6 +14,21 @@
 /* Do not use HG_TEST_MAX_HANDLES for that and keep it fixed */
 #define NINFLIGHT (16)
 
+/* Time given to prioritized RPCs to complete before triggering them (ms) */
+#define PRIORITY_WAIT_TIME (200)
+
+/* Number of RPCs forwarded at once to stress unexpected message handling */
+#define BURST_COUNT (10000)
+
+/* Max time between two completions of a burst before it counts as a stall */
+#define BURST_MAX_GAP (1.0)
+
+/* Number of forwards made with the same persistent handle */
+#define PERSISTENT_NFORWARDS (16)
+
+/* Encoded size from which RPCs are compressed in the compression test */
+#define COMPRESS_THRESHOLD (64)
+
 /************************************/
 /* Local Type and Struct Definition */
 /************************************/
@@ -23,6 +38,34 @@ struct forward_cb_args {
     rpc_handle_t *rpc_handle;
 };
 
+struct forward_multi_cb_args {
+    hg_request_t *request;
+    rpc_handle_t *rpc_handle;
+    hg_atomic_int32_t count;     /* Number of callbacks triggered */
+    hg_atomic_int32_t completed; /* Number of successful responses */
+    int32_t expected;
+};
+
+struct forward_burst_cb_args {
+    hg_request_t *request;       /* Request completed once all are done */
+    hg_atomic_int32_t count;     /* Number of callbacks triggered */
+    hg_atomic_int32_t completed; /* Number of successful responses */
+    int32_t expected;            /* Number of RPCs forwarded */
+    hg_time_t last;              /* Time of last completion */
+    double max_gap;              /* Max time between two completions (s) */
+};
+
+struct forward_timeout_cb_args {
+    hg_request_t *request;
+    hg_return_t ret;
+};
+
+struct forward_priority_cb_args {
+    hg_priority_t *order;   /* Priority classes in trigger order */
+    unsigned int *count;    /* Number of callbacks triggered */
+    hg_priority_t priority; /* Priority class of RPC */
+};
+
 /********************/
 /* Local Prototypes */
 /********************/
@@ -32,9 +75,15 @@ hg_test_rpc_null_cb(const struct hg_cb_info *callback_info);
 static hg_return_t
 hg_test_rpc_forward_cb(const struct hg_cb_info *callback_info);
 static hg_return_t
+hg_test_rpc_forward_multi_cb(const struct hg_cb_info *callback_info);
+static hg_return_t
 hg_test_rpc_forward_no_resp_cb(const struct hg_cb_info *callback_info);
 static hg_return_t
 hg_test_rpc_forward_reset_cb(const struct hg_cb_info *callback_info);
+static hg_return_t
+hg_test_rpc_forward_priority_cb(const struct hg_cb_info *callback_info);
+static hg_return_t
+hg_test_rpc_forward_burst_cb(const struct hg_cb_info *callback_info);
 #ifndef HG_HAS_XDR
 static hg_return_t
 hg_test_rpc_forward_overflow_cb(const struct hg_cb_info *callback_info);
@@ -44,6 +93,14 @@ static hg_return_t
 hg_test_rpc(hg_context_t *context, hg_request_class_t *request_class,
     hg_addr_t addr, hg_id_t rpc_id, hg_cb_t callback);
 static hg_return_t
+hg_test_rpc_large(hg_context_t *context, hg_request_class_t *request_class,
+    hg_addr_t addr, hg_id_t rpc_id, hg_cb_t callback, size_t path_size);
+#ifndef HG_HAS_XDR
+static hg_return_t
+hg_test_rpc_compress(hg_context_t *context, hg_request_class_t *request_class,
+    hg_addr_t addr, hg_id_t rpc_id, size_t eager_size);
+#endif
+static hg_return_t
 hg_test_rpc_lookup(hg_context_t *context, hg_request_class_t *request_class,
     const char *target_name, hg_id_t rpc_id, hg_cb_t callback);
 static hg_return_t
@@ -53,8 +110,29 @@ static hg_return_t
 hg_test_rpc_mask(hg_context_t *context, hg_request_class_t *request_class,
     hg_addr_t addr, hg_id_t rpc_id, hg_cb_t callback);
 static hg_return_t
+hg_test_rpc_persistent(hg_context_t *context, hg_request_class_t *request_class,
+    hg_addr_t addr, hg_id_t rpc_id, hg_cb_t callback, hg_uint8_t target_count,
+    size_t large_path_size, hg_bool_t check_busy);
+static hg_return_t
 hg_test_rpc_multiple(hg_context_t *context, hg_request_class_t *request_class,
     hg_addr_t addr, hg_uint8_t target_id, hg_id_t rpc_id, hg_cb_t callback);
+
+static hg_return_t
+hg_test_rpc_burst(
+    hg_context_t *context, hg_request_class_t *request_class, hg_addr_t addr);
+
+static hg_return_t
+hg_test_rpc_priority(hg_context_t *context, hg_addr_t addr, hg_id_t high_id,
+    hg_id_t default_id);
+
+static hg_return_t
+hg_test_rpc_forward_multi(hg_context_t *context,
+    hg_request_class_t *request_class, hg_addr_t addr, hg_id_t rpc_id,
+    hg_cb_t callback);
+
+static hg_return_t
+hg_test_rpc_payload(hg_context_t *context, hg_request_class_t *request_class,
+    hg_addr_t addr, hg_id_t rpc_id, hg_cb_t callback);
 #ifndef HG_HAS_XDR
 static hg_return_t
 hg_test_overflow(hg_context_t *context, hg_request_class_t *request_class,
@@ -63,6 +141,12 @@ hg_test_overflow(hg_context_t *context, hg_request_class_t *request_class,
 static hg_return_t
 hg_test_cancel_rpc(hg_context_t *context, hg_request_class_t *request_class,
     hg_addr_t addr, hg_id_t rpc_id, hg_cb_t callback);
+static hg_return_t
+hg_test_timeout_rpc(hg_context_t *context, hg_request_class_t *request_class,
+    hg_addr_t addr, hg_id_t rpc_id, unsigned int timeout_ms);
+static hg_return_t
+hg_test_cancel_coalesced_rpc(hg_context_t *context,
+    hg_request_class_t *request_class, hg_addr_t addr, hg_id_t rpc_id);
 
 /*******************/
 /* Local Variables */
@@ -132,6 +216,43 @@ done:
     return ret;
 }
 
+/*---------------------------------------------------------------------------*/
+static hg_return_t
+hg_test_rpc_forward_multi_cb(const struct hg_cb_info *callback_info)
+{
+    hg_handle_t handle = callback_info->info.forward.handle;
+    struct forward_multi_cb_args *args =
+        (struct forward_multi_cb_args *) callback_info->arg;
+    rpc_open_out_t rpc_open_out_struct;
+    hg_return_t ret = HG_SUCCESS;
+
+    HG_TEST_CHECK_ERROR_NORET(callback_info->ret != HG_SUCCESS, done,
+        "Error in HG callback (%s)", HG_Error_to_string(callback_info->ret));
+
+    /* Get output */
+    ret = HG_Get_output(handle, &rpc_open_out_struct);
+    HG_TEST_CHECK_HG_ERROR(
+        done, ret, "HG_Get_output() failed (%s)", HG_Error_to_string(ret));
+
+    HG_TEST_CHECK_ERROR(
+        rpc_open_out_struct.event_id != (int) args->rpc_handle->cookie, free,
+        ret, HG_FAULT, "Cookie did not match RPC response");
+
+    /* Only count successful responses */
+    hg_atomic_incr32(&args->completed);
+
+free:
+    ret = HG_Free_output(handle, &rpc_open_out_struct);
+    HG_TEST_CHECK_HG_ERROR(
+        done, ret, "HG_Free_output() failed (%s)", HG_Error_to_string(ret));
+
+done:
+    if (hg_atomic_incr32(&args->count) == args->expected)
+        hg_request_complete(args->request);
+
+    return ret;
+}
+
 /*---------------------------------------------------------------------------*/
 static hg_return_t
 hg_test_rpc_forward_no_resp_cb(const struct hg_cb_info *callback_info)
@@ -168,6 +289,60 @@ done:
     return ret;
 }
 
+/*---------------------------------------------------------------------------*/
+static hg_return_t
+hg_test_rpc_forward_priority_cb(const struct hg_cb_info *callback_info)
+{
+    struct forward_priority_cb_args *args =
+        (struct forward_priority_cb_args *) callback_info->arg;
+    hg_priority_t priority = args->priority;
+
+    HG_TEST_CHECK_ERROR_NORET(callback_info->ret != HG_SUCCESS, error,
+        "Error in HG callback (%s)", HG_Error_to_string(callback_info->ret));
+
+    args->order[(*args->count)++] = priority;
+
+    return HG_SUCCESS;
+
+error:
+    /* Invalid class makes ordering check fail */
+    args->order[(*args->count)++] = HG_PRIORITY_MAX;
+
+    return HG_SUCCESS;
+}
+
+/*---------------------------------------------------------------------------*/
+static hg_return_t
+hg_test_rpc_forward_burst_cb(const struct hg_cb_info *callback_info)
+{
+    struct forward_burst_cb_args *args =
+        (struct forward_burst_cb_args *) callback_info->arg;
+    hg_return_t ret = HG_SUCCESS;
+    hg_time_t now;
+
+    HG_TEST_CHECK_ERROR_NORET(callback_info->ret != HG_SUCCESS, done,
+        "Error in HG callback (%s)", HG_Error_to_string(callback_info->ret));
+
+    /* Only count successful responses */
+    hg_atomic_incr32(&args->completed);
+
+done:
+    /* Keep track of the longest time spent without any completion */
+    hg_time_get_current(&now);
+    if (hg_atomic_get32(&args->count) > 0) {
+        double gap = hg_time_diff(now, args->last);
+
+        if (gap > args->max_gap)
+            args->max_gap = gap;
+    }
+    args->last = now;
+
+    if (hg_atomic_incr32(&args->count) == args->expected)
+        hg_request_complete(args->request);
+
+    return ret;
+}
+
 /*---------------------------------------------------------------------------*/
 #ifndef HG_HAS_XDR
 static hg_return_t
@@ -227,6 +402,19 @@ done:
     return ret;
 }
 
+/*---------------------------------------------------------------------------*/
+static hg_return_t
+hg_test_rpc_forward_timeout_cb(const struct hg_cb_info *callback_info)
+{
+    struct forward_timeout_cb_args *args =
+        (struct forward_timeout_cb_args *) callback_info->arg;
+
+    args->ret = callback_info->ret;
+    hg_request_complete(args->request);
+
+    return HG_SUCCESS;
+}
+
 /*---------------------------------------------------------------------------*/
 static hg_return_t
 hg_test_rpc_null(
@@ -322,6 +510,157 @@ done:
     return ret;
 }
 
+/*---------------------------------------------------------------------------*/
+static hg_return_t
+hg_test_rpc_large(hg_context_t *context, hg_request_class_t *request_class,
+    hg_addr_t addr, hg_id_t rpc_id, hg_cb_t callback, size_t path_size)
+{
+    hg_request_t *request = NULL;
+    hg_handle_t handle = HG_HANDLE_NULL;
+    hg_return_t ret = HG_SUCCESS, cleanup_ret;
+    struct forward_cb_args forward_cb_args;
+    char *rpc_open_path = NULL;
+    rpc_handle_t rpc_open_handle;
+    rpc_open_in_t rpc_open_in_struct;
+
+    /* Path fills most of the input buffer */
+    rpc_open_path = (char *) malloc(path_size);
+    HG_TEST_CHECK_ERROR(rpc_open_path == NULL, done, ret, HG_NOMEM,
+        "Could not allocate path");
+    memset(rpc_open_path, 'p', path_size - 1);
+    rpc_open_path[path_size - 1] = '\0';
+
+    request = hg_request_create(request_class);
+
+    /* Create RPC request */
+    ret = HG_Create(context, addr, rpc_id, &handle);
+    HG_TEST_CHECK_HG_ERROR(
+        done, ret, "HG_Create() failed (%s)", HG_Error_to_string(ret));
+
+    /* Fill input structure, cookie is encoded after path and echoed back */
+    rpc_open_handle.cookie = 100;
+    rpc_open_in_struct.path = rpc_open_path;
+    rpc_open_in_struct.handle = rpc_open_handle;
+
+    /* Forward call to remote addr and get a new request */
+    HG_TEST_LOG_DEBUG("Forwarding rpc_open with %zu bytes path, op id: %" PRIu64
+                      "...",
+        path_size, rpc_id);
+    forward_cb_args.request = request;
+    forward_cb_args.rpc_handle = &rpc_open_handle;
+    ret = HG_Forward(handle, callback, &forward_cb_args, &rpc_open_in_struct);
+    HG_TEST_CHECK_HG_ERROR(
+        done, ret, "HG_Forward() failed (%s)", HG_Error_to_string(ret));
+
+    hg_request_wait(request, HG_MAX_IDLE_TIME, NULL);
+
+done:
+    cleanup_ret = HG_Destroy(handle);
+    HG_TEST_CHECK_ERROR_DONE(cleanup_ret != HG_SUCCESS,
+        "HG_Destroy() failed (%s)", HG_Error_to_string(cleanup_ret));
+
+    hg_request_destroy(request);
+    free(rpc_open_path);
+
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+#ifndef HG_HAS_XDR
+static hg_return_t
+hg_test_rpc_compress(hg_context_t *context, hg_request_class_t *request_class,
+    hg_addr_t addr, hg_id_t rpc_id, size_t eager_size)
+{
+    /* Eager payload, overflow payload that compresses into the eager buffer
+     * and overflow payload that remains larger than the eager buffer */
+    const struct {
+        size_t path_size;
+        size_t random_len; /* random chars at the start of each 64 bytes */
+    } paths[] = {{eager_size / 2, 0}, {eager_size * 4, 0},
+        {eager_size * 16, 32}};
+    hg_class_t *hg_class = HG_Context_get_class(context);
+    hg_request_t *request = NULL;
+    hg_handle_t handle = HG_HANDLE_NULL;
+    hg_return_t ret, cleanup_ret;
+    struct forward_multi_cb_args forward_multi_cb_args;
+    char *rpc_open_path = NULL;
+    rpc_handle_t rpc_open_handle;
+    rpc_open_in_t rpc_open_in_struct;
+    hg_size_t threshold;
+    size_t i, j;
+
+    ret = HG_Registered_set_compression(hg_class, rpc_id, COMPRESS_THRESHOLD);
+    HG_TEST_CHECK_HG_ERROR(done, ret,
+        "HG_Registered_set_compression() failed (%s)", HG_Error_to_string(ret));
+
+    ret = HG_Registered_get_compression(hg_class, rpc_id, &threshold);
+    HG_TEST_CHECK_HG_ERROR(done, ret,
+        "HG_Registered_get_compression() failed (%s)", HG_Error_to_string(ret));
+    HG_TEST_CHECK_ERROR(threshold != COMPRESS_THRESHOLD, done, ret, HG_FAULT,
+        "Compression threshold does not match (%" PRIu64 ")", threshold);
+
+    request = hg_request_create(request_class);
+
+    ret = HG_Create(context, addr, rpc_id, &handle);
+    HG_TEST_CHECK_HG_ERROR(
+        done, ret, "HG_Create() failed (%s)", HG_Error_to_string(ret));
+
+    for (i = 0; i < sizeof(paths) / sizeof(paths[0]); i++) {
+        size_t path_size = paths[i].path_size;
+
+        free(rpc_open_path);
+        rpc_open_path = (char *) malloc(path_size);
+        HG_TEST_CHECK_ERROR(rpc_open_path == NULL, done, ret, HG_NOMEM,
+            "Could not allocate path");
+        for (j = 0; j < path_size - 1; j++)
+            rpc_open_path[j] = (j % 64 < paths[i].random_len)
+                                   ? (char) ('a' + rand() % 26)
+                                   : 'p';
+        rpc_open_path[path_size - 1] = '\0';
+
+        /* Cookie is encoded after path and echoed back */
+        rpc_open_handle.cookie = 200 + i;
+        rpc_open_in_struct.path = rpc_open_path;
+        rpc_open_in_struct.handle = rpc_open_handle;
+
+        HG_TEST_LOG_DEBUG("Forwarding rpc_open with %zu bytes path, op id: "
+                          "%" PRIu64 "...",
+            path_size, rpc_id);
+        forward_multi_cb_args.request = request;
+        forward_multi_cb_args.rpc_handle = &rpc_open_handle;
+        hg_atomic_init32(&forward_multi_cb_args.count, 0);
+        hg_atomic_init32(&forward_multi_cb_args.completed, 0);
+        forward_multi_cb_args.expected = 1;
+        hg_request_reset(request);
+        ret = HG_Forward(handle, hg_test_rpc_forward_multi_cb,
+            &forward_multi_cb_args, &rpc_open_in_struct);
+        HG_TEST_CHECK_HG_ERROR(
+            done, ret, "HG_Forward() failed (%s)", HG_Error_to_string(ret));
+
+        /* Target must decode path and cookie from the compressed payload */
+        hg_request_wait(request, HG_MAX_IDLE_TIME, NULL);
+        HG_TEST_CHECK_ERROR(
+            hg_atomic_get32(&forward_multi_cb_args.completed) != 1, done, ret,
+            HG_FAULT, "No valid response for %zu bytes path", path_size);
+    }
+
+done:
+    cleanup_ret = HG_Destroy(handle);
+    HG_TEST_CHECK_ERROR_DONE(cleanup_ret != HG_SUCCESS,
+        "HG_Destroy() failed (%s)", HG_Error_to_string(cleanup_ret));
+
+    cleanup_ret = HG_Registered_set_compression(hg_class, rpc_id, 0);
+    HG_TEST_CHECK_ERROR_DONE(cleanup_ret != HG_SUCCESS,
+        "HG_Registered_set_compression() failed (%s)",
+        HG_Error_to_string(cleanup_ret));
+
+    hg_request_destroy(request);
+    free(rpc_open_path);
+
+    return ret;
+}
+#endif
+
 /*---------------------------------------------------------------------------*/
 static hg_return_t
 hg_test_rpc_lookup(hg_context_t *context, hg_request_class_t *request_class,
@@ -489,6 +828,102 @@ done:
     return ret;
 }
 
+/*---------------------------------------------------------------------------*/
+static hg_return_t
+hg_test_rpc_persistent(hg_context_t *context, hg_request_class_t *request_class,
+    hg_addr_t addr, hg_id_t rpc_id, hg_cb_t callback, hg_uint8_t target_count,
+    size_t large_path_size, hg_bool_t check_busy)
+{
+    hg_request_t *request = NULL;
+    hg_handle_t handle = HG_HANDLE_NULL;
+    hg_return_t ret = HG_SUCCESS, cleanup_ret;
+    struct forward_cb_args forward_cb_args;
+    hg_const_string_t rpc_open_path = HG_TEST_TEMP_DIRECTORY "/test.h5";
+    char *large_path = NULL;
+    rpc_handle_t rpc_open_handle;
+    rpc_open_in_t rpc_open_in_struct;
+    unsigned int i;
+
+    /* Path that does not fit in the eager buffer (sets HG_CORE_MORE_DATA) */
+    large_path = (char *) malloc(large_path_size);
+    HG_TEST_CHECK_ERROR(
+        large_path == NULL, done, ret, HG_NOMEM, "Could not allocate path");
+    memset(large_path, 'p', large_path_size - 1);
+    large_path[large_path_size - 1] = '\0';
+
+    request = hg_request_create(request_class);
+
+    ret = HG_Create(context, addr, rpc_id, &handle);
+    HG_TEST_CHECK_HG_ERROR(
+        done, ret, "HG_Create() failed (%s)", HG_Error_to_string(ret));
+
+    ret = HG_Set_persistent(handle, HG_TRUE);
+    HG_TEST_CHECK_HG_ERROR(
+        done, ret, "HG_Set_persistent() failed (%s)", HG_Error_to_string(ret));
+
+    forward_cb_args.request = request;
+    forward_cb_args.rpc_handle = &rpc_open_handle;
+
+    for (i = 0; i < PERSISTENT_NFORWARDS; i++) {
+        hg_request_reset(request);
+
+        /* Reset drops persistent mode, it must be set again */
+        if (i == PERSISTENT_NFORWARDS / 2) {
+            ret = HG_Reset(handle, addr, rpc_id);
+            HG_TEST_CHECK_HG_ERROR(
+                done, ret, "HG_Reset() failed (%s)", HG_Error_to_string(ret));
+
+            ret = HG_Set_persistent(handle, HG_TRUE);
+            HG_TEST_CHECK_HG_ERROR(done, ret, "HG_Set_persistent() failed (%s)",
+                HG_Error_to_string(ret));
+        }
+
+        /* Cycle through target contexts so that the header cookie changes */
+        if (target_count > 1) {
+            ret = HG_Set_target_id(handle, (hg_uint8_t) (i % target_count));
+            HG_TEST_CHECK_HG_ERROR(done, ret, "HG_Set_target_id() failed (%s)",
+                HG_Error_to_string(ret));
+        }
+
+        /* Every other pair of forwards overflows, toggling the header flags */
+        rpc_open_handle.cookie = (hg_uint64_t) i;
+        rpc_open_in_struct.path = ((i / 2) % 2) ? large_path : rpc_open_path;
+        rpc_open_in_struct.handle = rpc_open_handle;
+
+        HG_TEST_LOG_DEBUG("Forwarding persistent rpc_open (%u), op id: %" PRIu64
+                          "...",
+            i, rpc_id);
+        ret = HG_Forward(
+            handle, callback, &forward_cb_args, &rpc_open_in_struct);
+        HG_TEST_CHECK_HG_ERROR(
+            done, ret, "HG_Forward() failed (%s)", HG_Error_to_string(ret));
+
+        /* Persistent mode cannot change while the handle is in use (self
+         * forwards may already be completed at this point) */
+        if (i == 0 && check_busy) {
+            HG_Test_log_disable(); // Expected to produce errors
+            ret = HG_Set_persistent(handle, HG_FALSE);
+            HG_Test_log_enable();
+            HG_TEST_CHECK_ERROR(ret != HG_BUSY, done, ret, HG_FAULT,
+                "HG_Set_persistent() on busy handle returned %s",
+                HG_Error_to_string(ret));
+            ret = HG_SUCCESS;
+        }
+
+        hg_request_wait(request, HG_MAX_IDLE_TIME, NULL);
+    }
+
+done:
+    cleanup_ret = HG_Destroy(handle);
+    HG_TEST_CHECK_ERROR_DONE(cleanup_ret != HG_SUCCESS,
+        "HG_Destroy() failed (%s)", HG_Error_to_string(cleanup_ret));
+
+    hg_request_destroy(request);
+    free(large_path);
+
+    return ret;
+}
+
 /*---------------------------------------------------------------------------*/
 static hg_return_t
 hg_test_rpc_multiple(hg_context_t *context, hg_request_class_t *request_class,
@@ -619,6 +1054,295 @@ done:
     return ret;
 }
 
+/*---------------------------------------------------------------------------*/
+static hg_return_t
+hg_test_rpc_burst(
+    hg_context_t *context, hg_request_class_t *request_class, hg_addr_t addr)
+{
+    struct forward_burst_cb_args args;
+    hg_handle_t *handles = NULL;
+    unsigned int i, n = 0, completed = 0;
+    hg_return_t ret = HG_SUCCESS, cleanup_ret;
+
+    args.request = hg_request_create(request_class);
+    hg_atomic_init32(&args.count, 0);
+    hg_atomic_init32(&args.completed, 0);
+    args.expected = BURST_COUNT;
+    args.last = hg_time_from_ms(0);
+    args.max_gap = 0.0;
+
+    handles = (hg_handle_t *) malloc(BURST_COUNT * sizeof(*handles));
+    HG_TEST_CHECK_ERROR(handles == NULL, done, ret, HG_NOMEM,
+        "Could not allocate array of handles");
+
+    for (n = 0; n < BURST_COUNT; n++) {
+        ret = HG_Create(context, addr, hg_test_rpc_null_id_g, &handles[n]);
+        HG_TEST_CHECK_HG_ERROR(
+            done, ret, "HG_Create() failed (%s)", HG_Error_to_string(ret));
+    }
+
+    /* Forward all RPCs without waiting so that the target receives a burst
+     * of unexpected messages */
+    HG_TEST_LOG_DEBUG("Forwarding %u null RPCs...", BURST_COUNT);
+    for (i = 0; i < BURST_COUNT; i++) {
+        do {
+            ret = HG_Forward(handles[i], hg_test_rpc_forward_burst_cb, &args,
+                NULL);
+            if (ret == HG_AGAIN)
+                hg_request_wait(args.request, 0, NULL);
+        } while (ret == HG_AGAIN);
+        HG_TEST_CHECK_HG_ERROR(
+            done, ret, "HG_Forward() failed (%s)", HG_Error_to_string(ret));
+    }
+
+    hg_request_wait(args.request, HG_MAX_IDLE_TIME * 10, &completed);
+    HG_TEST_CHECK_ERROR(completed == 0, done, ret, HG_TIMEOUT,
+        "Only %d/%d RPCs completed", hg_atomic_get32(&args.count),
+        BURST_COUNT);
+    HG_TEST_CHECK_ERROR(hg_atomic_get32(&args.completed) != BURST_COUNT, done,
+        ret, HG_FAULT, "Only %d/%d RPCs completed successfully",
+        hg_atomic_get32(&args.completed), BURST_COUNT);
+
+    /* Completions must keep flowing while the target drains the burst */
+    HG_TEST_LOG_DEBUG("Max time between two completions: %f s", args.max_gap);
+    HG_TEST_CHECK_ERROR(args.max_gap > BURST_MAX_GAP, done, ret, HG_FAULT,
+        "Completions stalled for %f s (max %f s)", args.max_gap,
+        BURST_MAX_GAP);
+
+done:
+    for (i = 0; i < n; i++) {
+        cleanup_ret = HG_Destroy(handles[i]);
+        HG_TEST_CHECK_ERROR_DONE(cleanup_ret != HG_SUCCESS,
+            "HG_Destroy() failed (%s)", HG_Error_to_string(cleanup_ret));
+    }
+    free(handles);
+    hg_request_destroy(args.request);
+
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static hg_return_t
+hg_test_rpc_priority(hg_context_t *context, hg_addr_t addr, hg_id_t high_id,
+    hg_id_t default_id)
+{
+    hg_handle_t handle_m[NINFLIGHT];
+    struct forward_priority_cb_args args_m[NINFLIGHT];
+    hg_priority_t order[NINFLIGHT];
+    unsigned int count = 0, i;
+    hg_return_t ret = HG_SUCCESS;
+    rpc_open_in_t rpc_open_in_struct;
+    hg_const_string_t rpc_open_path = HG_TEST_TEMP_DIRECTORY "/test.h5";
+    rpc_handle_t rpc_open_handle;
+    hg_time_t now, deadline;
+
+    for (i = 0; i < NINFLIGHT; i++)
+        handle_m[i] = HG_HANDLE_NULL;
+
+    rpc_open_handle.cookie = 1;
+    rpc_open_in_struct.path = rpc_open_path;
+    rpc_open_in_struct.handle = rpc_open_handle;
+
+    /* Forward default priority RPCs first so that they complete first */
+    for (i = 0; i < NINFLIGHT; i++) {
+        bool high = (i >= NINFLIGHT / 2);
+
+        ret = HG_Create(
+            context, addr, high ? high_id : default_id, handle_m + i);
+        HG_TEST_CHECK_HG_ERROR(
+            done, ret, "HG_Create() failed (%s)", HG_Error_to_string(ret));
+
+        args_m[i].order = order;
+        args_m[i].count = &count;
+        args_m[i].priority = high ? HG_PRIORITY_HIGH : HG_PRIORITY_DEFAULT;
+        ret = HG_Forward(handle_m[i], hg_test_rpc_forward_priority_cb,
+            &args_m[i], high ? &rpc_open_in_struct : NULL);
+        HG_TEST_CHECK_HG_ERROR(
+            done, ret, "HG_Forward() failed (%s)", HG_Error_to_string(ret));
+    }
+
+    /* Let RPCs complete without triggering their callbacks */
+    hg_time_get_current_ms(&now);
+    deadline = hg_time_add(now, hg_time_from_ms(PRIORITY_WAIT_TIME));
+    while (hg_time_less(now, deadline)) {
+        ret = HG_Progress(context, 10);
+        HG_TEST_CHECK_ERROR(ret != HG_SUCCESS && ret != HG_TIMEOUT, done, ret,
+            ret, "HG_Progress() failed (%s)", HG_Error_to_string(ret));
+        hg_time_get_current_ms(&now);
+    }
+
+    /* Trigger callbacks one by one */
+    deadline = hg_time_add(now, hg_time_from_ms(HG_MAX_IDLE_TIME));
+    while (count < NINFLIGHT && hg_time_less(now, deadline)) {
+        unsigned int actual_count = 0;
+
+        ret = HG_Trigger(context, 0, 1, &actual_count);
+        if (ret == HG_TIMEOUT)
+            ret = HG_Progress(context, 10);
+        HG_TEST_CHECK_ERROR(ret != HG_SUCCESS && ret != HG_TIMEOUT, done, ret,
+            ret, "Could not make progress (%s)", HG_Error_to_string(ret));
+        hg_time_get_current_ms(&now);
+    }
+    HG_TEST_CHECK_ERROR(count < NINFLIGHT, done, ret, HG_TIMEOUT,
+        "Only %u RPCs completed", count);
+
+    /* All high priority completions must have been triggered first */
+    for (i = 0; i < NINFLIGHT; i++) {
+        hg_priority_t expected =
+            (i < NINFLIGHT / 2) ? HG_PRIORITY_HIGH : HG_PRIORITY_DEFAULT;
+
+        HG_TEST_CHECK_ERROR(order[i] != expected, done, ret, HG_FAULT,
+            "Completion %u has priority class %d instead of %d", i,
+            (int) order[i], (int) expected);
+    }
+    ret = HG_SUCCESS;
+
+done:
+    for (i = 0; i < NINFLIGHT; i++) {
+        hg_return_t cleanup_ret = HG_Destroy(handle_m[i]);
+        HG_TEST_CHECK_ERROR_DONE(cleanup_ret != HG_SUCCESS,
+            "HG_Destroy() failed (%s)", HG_Error_to_string(cleanup_ret));
+    }
+
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static hg_return_t
+hg_test_rpc_forward_multi(hg_context_t *context,
+    hg_request_class_t *request_class, hg_addr_t addr, hg_id_t rpc_id,
+    hg_cb_t callback)
+{
+    hg_request_t *request = NULL;
+    hg_handle_t handle_m[NINFLIGHT];
+    struct forward_multi_cb_args forward_multi_cb_args;
+    hg_return_t ret = HG_SUCCESS;
+    rpc_open_in_t rpc_open_in_struct;
+    hg_const_string_t rpc_open_path = HG_TEST_TEMP_DIRECTORY "/test.h5";
+    rpc_handle_t rpc_open_handle;
+    unsigned int i;
+
+    request = hg_request_create(request_class);
+
+    HG_TEST_LOG_DEBUG("Creating %u handles...", NINFLIGHT);
+    for (i = 0; i < NINFLIGHT; i++) {
+        ret = HG_Create(context, addr, rpc_id, handle_m + i);
+        HG_TEST_CHECK_HG_ERROR(
+            done, ret, "HG_Create() failed (%s)", HG_Error_to_string(ret));
+    }
+
+    /* Fill input structure, input is shared by all handles */
+    rpc_open_handle.cookie = 12345;
+    rpc_open_in_struct.path = rpc_open_path;
+    rpc_open_in_struct.handle = rpc_open_handle;
+
+    /* Forward call to all handles at once */
+    HG_TEST_LOG_DEBUG(
+        "Forwarding rpc_open to %u handles, op id: %" PRIu64 "...", NINFLIGHT,
+        rpc_id);
+    forward_multi_cb_args.request = request;
+    forward_multi_cb_args.rpc_handle = &rpc_open_handle;
+    hg_atomic_init32(&forward_multi_cb_args.count, 0);
+    hg_atomic_init32(&forward_multi_cb_args.completed, 0);
+    forward_multi_cb_args.expected = NINFLIGHT;
+    ret = HG_Forward_multi(handle_m, NINFLIGHT, callback,
+        &forward_multi_cb_args, &rpc_open_in_struct);
+    HG_TEST_CHECK_HG_ERROR(done, ret, "HG_Forward_multi() failed (%s)",
+        HG_Error_to_string(ret));
+
+    hg_request_wait(request, HG_MAX_IDLE_TIME, NULL);
+    HG_TEST_CHECK_ERROR(
+        hg_atomic_get32(&forward_multi_cb_args.completed) != NINFLIGHT, done,
+        ret, HG_FAULT, "Not all handles completed (%d)",
+        hg_atomic_get32(&forward_multi_cb_args.completed));
+
+    /* Complete */
+    for (i = 0; i < NINFLIGHT; i++) {
+        ret = HG_Destroy(handle_m[i]);
+        HG_TEST_CHECK_HG_ERROR(
+            done, ret, "HG_Destroy() failed (%s)", HG_Error_to_string(ret));
+    }
+    HG_TEST_LOG_DEBUG("Done");
+
+done:
+    hg_request_destroy(request);
+
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static hg_return_t
+hg_test_rpc_payload(hg_context_t *context, hg_request_class_t *request_class,
+    hg_addr_t addr, hg_id_t rpc_id, hg_cb_t callback)
+{
+    hg_request_t *request = NULL;
+    hg_handle_t handle_m[NINFLIGHT];
+    hg_payload_t payload = NULL;
+    struct forward_multi_cb_args forward_multi_cb_args;
+    hg_return_t ret = HG_SUCCESS;
+    rpc_open_in_t rpc_open_in_struct;
+    hg_const_string_t rpc_open_path = HG_TEST_TEMP_DIRECTORY "/test.h5";
+    rpc_handle_t rpc_open_handle;
+    unsigned int i;
+
+    request = hg_request_create(request_class);
+
+    /* Encode input once */
+    rpc_open_handle.cookie = 54321;
+    rpc_open_in_struct.path = rpc_open_path;
+    rpc_open_in_struct.handle = rpc_open_handle;
+    ret = HG_Payload_create(HG_Context_get_class(context), rpc_id,
+        &rpc_open_in_struct, &payload);
+    HG_TEST_CHECK_HG_ERROR(done, ret, "HG_Payload_create() failed (%s)",
+        HG_Error_to_string(ret));
+
+    forward_multi_cb_args.request = request;
+    forward_multi_cb_args.rpc_handle = &rpc_open_handle;
+    hg_atomic_init32(&forward_multi_cb_args.count, 0);
+    hg_atomic_init32(&forward_multi_cb_args.completed, 0);
+    forward_multi_cb_args.expected = NINFLIGHT;
+
+    HG_TEST_LOG_DEBUG("Forwarding payload to %u handles, op id: %" PRIu64
+                      "...",
+        NINFLIGHT, rpc_id);
+    for (i = 0; i < NINFLIGHT; i++) {
+        ret = HG_Create(context, addr, rpc_id, handle_m + i);
+        HG_TEST_CHECK_HG_ERROR(
+            done, ret, "HG_Create() failed (%s)", HG_Error_to_string(ret));
+
+        ret = HG_Forward_payload(
+            handle_m[i], callback, &forward_multi_cb_args, payload);
+        HG_TEST_CHECK_HG_ERROR(done, ret, "HG_Forward_payload() failed (%s)",
+            HG_Error_to_string(ret));
+    }
+
+    /* Payload remains valid until all handles have completed */
+    ret = HG_Payload_destroy(payload);
+    payload = NULL;
+    HG_TEST_CHECK_HG_ERROR(done, ret, "HG_Payload_destroy() failed (%s)",
+        HG_Error_to_string(ret));
+
+    hg_request_wait(request, HG_MAX_IDLE_TIME, NULL);
+    HG_TEST_CHECK_ERROR(
+        hg_atomic_get32(&forward_multi_cb_args.completed) != NINFLIGHT, done,
+        ret, HG_FAULT, "Not all handles completed (%d)",
+        hg_atomic_get32(&forward_multi_cb_args.completed));
+
+    /* Complete */
+    for (i = 0; i < NINFLIGHT; i++) {
+        ret = HG_Destroy(handle_m[i]);
+        HG_TEST_CHECK_HG_ERROR(
+            done, ret, "HG_Destroy() failed (%s)", HG_Error_to_string(ret));
+    }
+    HG_TEST_LOG_DEBUG("Done");
+
+done:
+    (void) HG_Payload_destroy(payload);
+    hg_request_destroy(request);
+
+    return ret;
+}
+
 /*---------------------------------------------------------------------------*/
 #ifndef HG_HAS_XDR
 static hg_return_t
@@ -695,6 +1419,102 @@ done:
     return ret;
 }
 
+/*---------------------------------------------------------------------------*/
+static hg_return_t
+hg_test_timeout_rpc(hg_context_t *context, hg_request_class_t *request_class,
+    hg_addr_t addr, hg_id_t rpc_id, unsigned int timeout_ms)
+{
+    struct forward_timeout_cb_args args = {.request = NULL, .ret = HG_SUCCESS};
+    hg_handle_t handle = HG_HANDLE_NULL;
+    unsigned int completed = 0;
+    hg_return_t ret = HG_SUCCESS, cleanup_ret;
+
+    args.request = hg_request_create(request_class);
+
+    /* Create RPC request */
+    ret = HG_Create(context, addr, rpc_id, &handle);
+    HG_TEST_CHECK_HG_ERROR(
+        done, ret, "HG_Create() failed (%s)", HG_Error_to_string(ret));
+
+    /* Target never responds to that RPC so it must time out */
+    HG_TEST_LOG_DEBUG("Forwarding RPC, op id: %" PRIu64 "...", rpc_id);
+    ret = HG_Forward_timed(
+        handle, hg_test_rpc_forward_timeout_cb, &args, NULL, timeout_ms);
+    HG_TEST_CHECK_HG_ERROR(
+        done, ret, "HG_Forward_timed() failed (%s)", HG_Error_to_string(ret));
+
+    hg_request_wait(args.request, HG_MAX_IDLE_TIME, &completed);
+    HG_TEST_CHECK_ERROR(completed == 0, done, ret, HG_TIMEOUT,
+        "RPC did not complete after %u ms", HG_MAX_IDLE_TIME);
+    HG_TEST_CHECK_ERROR(args.ret != HG_TIMEOUT, done, ret, HG_FAULT,
+        "RPC completed with %s instead of HG_TIMEOUT",
+        HG_Error_to_string(args.ret));
+
+done:
+    cleanup_ret = HG_Destroy(handle);
+    HG_TEST_CHECK_ERROR_DONE(cleanup_ret != HG_SUCCESS,
+        "HG_Destroy() failed (%s)", HG_Error_to_string(cleanup_ret));
+
+    hg_request_destroy(args.request);
+
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static hg_return_t
+hg_test_cancel_coalesced_rpc(hg_context_t *context,
+    hg_request_class_t *request_class, hg_addr_t addr, hg_id_t rpc_id)
+{
+    struct forward_timeout_cb_args args = {.request = NULL, .ret = HG_SUCCESS};
+    hg_const_string_t rpc_open_path = HG_TEST_TEMP_DIRECTORY "/test.h5";
+    rpc_handle_t rpc_open_handle;
+    rpc_open_in_t rpc_open_in_struct;
+    hg_handle_t handle = HG_HANDLE_NULL;
+    unsigned int completed = 0;
+    hg_return_t ret = HG_SUCCESS, cleanup_ret;
+
+    args.request = hg_request_create(request_class);
+
+    /* Create RPC request */
+    ret = HG_Create(context, addr, rpc_id, &handle);
+    HG_TEST_CHECK_HG_ERROR(
+        done, ret, "HG_Create() failed (%s)", HG_Error_to_string(ret));
+
+    /* Fill input structure */
+    rpc_open_handle.cookie = 100;
+    rpc_open_in_struct.path = rpc_open_path;
+    rpc_open_in_struct.handle = rpc_open_handle;
+
+    /* Request is coalesced and its batch is only sent on progress */
+    HG_TEST_LOG_DEBUG("Forwarding rpc_open, op id: %" PRIu64 "...", rpc_id);
+    ret = HG_Forward(
+        handle, hg_test_rpc_forward_timeout_cb, &args, &rpc_open_in_struct);
+    HG_TEST_CHECK_HG_ERROR(
+        done, ret, "HG_Forward() failed (%s)", HG_Error_to_string(ret));
+
+    /* No response is expected, request can only complete as canceled if it is
+     * removed from its batch before being sent */
+    ret = HG_Cancel(handle);
+    HG_TEST_CHECK_HG_ERROR(
+        done, ret, "HG_Cancel() failed (%s)", HG_Error_to_string(ret));
+
+    hg_request_wait(args.request, HG_MAX_IDLE_TIME, &completed);
+    HG_TEST_CHECK_ERROR(completed == 0, done, ret, HG_TIMEOUT,
+        "RPC did not complete after %u ms", HG_MAX_IDLE_TIME);
+    HG_TEST_CHECK_ERROR(args.ret != HG_CANCELED, done, ret, HG_FAULT,
+        "RPC completed with %s instead of HG_CANCELED",
+        HG_Error_to_string(args.ret));
+
+done:
+    cleanup_ret = HG_Destroy(handle);
+    HG_TEST_CHECK_ERROR_DONE(cleanup_ret != HG_SUCCESS,
+        "HG_Destroy() failed (%s)", HG_Error_to_string(cleanup_ret));
+
+    hg_request_destroy(args.request);
+
+    return ret;
+}
+
 /*---------------------------------------------------------------------------*/
 int
 main(int argc, char *argv[])
@@ -725,6 +1545,26 @@ main(int argc, char *argv[])
         "simple RPC test failed");
     HG_PASSED();
 
+    /* Large RPC test (input size follows max msg size, see -Z option) */
+    HG_TEST("large RPC");
+    hg_ret = hg_test_rpc_large(info.context, info.request_class,
+        info.target_addr, hg_test_rpc_open_id_g, hg_test_rpc_forward_cb,
+        (size_t) HG_Class_get_input_eager_size(info.hg_class) / 2);
+    HG_TEST_CHECK_ERROR(hg_ret != HG_SUCCESS, done, ret, EXIT_FAILURE,
+        "large RPC test failed");
+    HG_PASSED();
+
+#ifndef HG_HAS_XDR
+    /* Compressed RPC test (eager and overflow payloads) */
+    HG_TEST("compressed RPC");
+    hg_ret = hg_test_rpc_compress(info.context, info.request_class,
+        info.target_addr, hg_test_rpc_open_id_g,
+        (size_t) HG_Class_get_input_eager_size(info.hg_class));
+    HG_TEST_CHECK_ERROR(hg_ret != HG_SUCCESS, done, ret, EXIT_FAILURE,
+        "compressed RPC test failed");
+    HG_PASSED();
+#endif
+
     /* RPC test with lookup/free */
     if (!info.hg_test_info.na_test_info.self_send &&
         strcmp(HG_Class_get_name(info.hg_class), "mpi")) {
@@ -755,6 +1595,17 @@ main(int argc, char *argv[])
         hg_ret != HG_SUCCESS, done, ret, EXIT_FAILURE, "reset RPC test failed");
     HG_PASSED();
 
+    /* RPC test reusing a persistent handle */
+    HG_TEST("persistent RPC");
+    hg_ret = hg_test_rpc_persistent(info.context, info.request_class,
+        info.target_addr, hg_test_rpc_open_id_g, hg_test_rpc_forward_cb,
+        info.hg_test_info.na_test_info.max_contexts,
+        (size_t) HG_Class_get_input_eager_size(info.hg_class) * 2,
+        !info.hg_test_info.na_test_info.self_send);
+    HG_TEST_CHECK_ERROR(hg_ret != HG_SUCCESS, done, ret, EXIT_FAILURE,
+        "persistent RPC test failed");
+    HG_PASSED();
+
     /* RPC test with tag mask */
     HG_TEST("tagged RPC");
     hg_ret = hg_test_rpc_mask(info.context, info.request_class,
@@ -818,6 +1669,74 @@ main(int argc, char *argv[])
         "concurrent RPC test failed");
     HG_PASSED();
 
+    /* Burst of RPCs larger than any receive pre-posted by the target */
+    HG_TEST("burst of RPCs");
+    hg_ret =
+        hg_test_rpc_burst(info.context, info.request_class, info.target_addr);
+    HG_TEST_CHECK_ERROR(hg_ret != HG_SUCCESS, done, ret, EXIT_FAILURE,
+        "burst of RPCs test failed");
+    HG_PASSED();
+
+    /* RPC test with input shared by multiple handles */
+    HG_TEST("multi forward RPCs");
+    hg_ret = hg_test_rpc_forward_multi(info.context, info.request_class,
+        info.target_addr, hg_test_rpc_open_id_g, hg_test_rpc_forward_multi_cb);
+    HG_TEST_CHECK_ERROR(hg_ret != HG_SUCCESS, done, ret, EXIT_FAILURE,
+        "multi forward RPC test failed");
+    HG_PASSED();
+
+    /* RPC test with pre-encoded payload (encoded for remote targets) */
+    if (!info.hg_test_info.na_test_info.self_send &&
+        !info.hg_test_info.auto_sm) {
+        HG_TEST("pre-encoded payload RPCs");
+        hg_ret = hg_test_rpc_payload(info.context, info.request_class,
+            info.target_addr, hg_test_rpc_open_id_g,
+            hg_test_rpc_forward_multi_cb);
+        HG_TEST_CHECK_ERROR(hg_ret != HG_SUCCESS, done, ret, EXIT_FAILURE,
+            "pre-encoded payload RPC test failed");
+        HG_PASSED();
+    }
+
+    /* RPC test with multiple handle in flight and high priority */
+    HG_TEST("high priority RPCs");
+    {
+        hg_priority_t priority;
+
+        hg_ret = HG_Registered_set_priority(
+            info.hg_class, hg_test_rpc_open_id_g, HG_PRIORITY_HIGH);
+        HG_TEST_CHECK_ERROR(hg_ret != HG_SUCCESS, done, ret, EXIT_FAILURE,
+            "HG_Registered_set_priority() failed (%s)",
+            HG_Error_to_string(hg_ret));
+
+        hg_ret = HG_Registered_get_priority(
+            info.hg_class, hg_test_rpc_open_id_g, &priority);
+        HG_TEST_CHECK_ERROR(hg_ret != HG_SUCCESS, done, ret, EXIT_FAILURE,
+            "HG_Registered_get_priority() failed (%s)",
+            HG_Error_to_string(hg_ret));
+        HG_TEST_CHECK_ERROR(priority != HG_PRIORITY_HIGH, done, ret,
+            EXIT_FAILURE, "Priority class does not match (%d)", (int) priority);
+
+        hg_ret = hg_test_rpc_multiple(info.context, info.request_class,
+            info.target_addr, 0, hg_test_rpc_open_id_g, hg_test_rpc_forward_cb);
+        HG_TEST_CHECK_ERROR(hg_ret != HG_SUCCESS, done, ret, EXIT_FAILURE,
+            "high priority RPC test failed");
+
+        /* Server RPCs would also be triggered from this context */
+        if (!info.hg_test_info.na_test_info.self_send) {
+            hg_ret = hg_test_rpc_priority(info.context, info.target_addr,
+                hg_test_rpc_open_id_g, hg_test_rpc_null_id_g);
+            HG_TEST_CHECK_ERROR(hg_ret != HG_SUCCESS, done, ret, EXIT_FAILURE,
+                "high priority RPC ordering test failed");
+        }
+
+        hg_ret = HG_Registered_set_priority(
+            info.hg_class, hg_test_rpc_open_id_g, HG_PRIORITY_DEFAULT);
+        HG_TEST_CHECK_ERROR(hg_ret != HG_SUCCESS, done, ret, EXIT_FAILURE,
+            "HG_Registered_set_priority() failed (%s)",
+            HG_Error_to_string(hg_ret));
+    }
+    HG_PASSED();
+
     /* RPC test with multiple handle to multiple target contexts */
     if (info.hg_test_info.na_test_info.max_contexts) {
         hg_uint8_t i,
@@ -854,6 +1773,23 @@ main(int argc, char *argv[])
         HG_TEST_CHECK_ERROR(hg_ret != HG_SUCCESS, done, ret, EXIT_FAILURE,
             "cancel RPC test failed");
         HG_PASSED();
+
+        HG_TEST("timeout RPC");
+        hg_ret = hg_test_timeout_rpc(info.context, info.request_class,
+            info.target_addr, hg_test_cancel_rpc_id_g, 100);
+        HG_TEST_CHECK_ERROR(hg_ret != HG_SUCCESS, done, ret, EXIT_FAILURE,
+            "timeout RPC test failed");
+        HG_PASSED();
+
+        if (info.hg_test_info.coalesce_count > 1) {
+            HG_TEST("cancel coalesced RPC");
+            hg_ret = hg_test_cancel_coalesced_rpc(info.context,
+                info.request_class, info.target_addr,
+                hg_test_rpc_open_id_no_resp_g);
+            HG_TEST_CHECK_ERROR(hg_ret != HG_SUCCESS, done, ret, EXIT_FAILURE,
+                "cancel coalesced RPC test failed");
+            HG_PASSED();
+        }
     }
 
 done:
@@ -0,0 +1,420 @@
+/**
+ * Copyright (c) 2013-2022 UChicago Argonne, LLC and The HDF Group.
+ * Copyright (c) 2022 Intel Corporation.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "na_test.h"
+
+#include "mercury_time.h"
+
+#include <string.h>
+
+/****************/
+/* Local Macros */
+/****************/
+
+/* Listening classes looked up by every client */
+#define NUM_PEERS (8)
+
+/* More clients than a peer sock queues by default (net.unix.max_dgram_qlen) */
+#define NUM_CLIENTS (16)
+
+/* Time given to a blocked client to be woken up once peers drained */
+#define CONNECT_TIMEOUT (2000)
+
+/* Time given to all messages to complete */
+#define MSG_TIMEOUT (10000)
+
+/************************************/
+/* Local Type and Struct Definition */
+/************************************/
+
+struct na_test_connect_class {
+    na_class_t *na_class;
+    na_context_t *context;
+};
+
+struct na_test_connect_op {
+    struct na_test_connect_class *test_class;
+    void *buf;
+    void *plugin_data;
+    na_op_id_t *op_id;
+    unsigned int *completed;
+    unsigned int peer;
+    bool (*seen)[NUM_CLIENTS];
+};
+
+struct na_test_connect_msg {
+    unsigned int client;
+    unsigned int peer;
+};
+
+/********************/
+/* Local Prototypes */
+/********************/
+
+static na_return_t
+na_test_connect(const char *info_string);
+
+static na_return_t
+na_test_connect_class_init(const char *info_string, bool listen,
+    struct na_test_connect_class *test_class);
+
+static void
+na_test_connect_class_finalize(struct na_test_connect_class *test_class);
+
+static na_return_t
+na_test_connect_progress(
+    struct na_test_connect_class *test_class, bool *progressed);
+
+static na_return_t
+na_test_connect_msg(struct na_test_connect_class *peers,
+    struct na_test_connect_class *clients,
+    na_addr_t *addrs[NUM_CLIENTS][NUM_PEERS]);
+
+static void
+na_test_connect_send_cb(const struct na_cb_info *callback_info);
+
+static void
+na_test_connect_recv_cb(const struct na_cb_info *callback_info);
+
+/*---------------------------------------------------------------------------*/
+static na_return_t
+na_test_connect_class_init(const char *info_string, bool listen,
+    struct na_test_connect_class *test_class)
+{
+    na_return_t ret = NA_SUCCESS;
+
+    test_class->na_class = NA_Initialize(info_string, listen);
+    NA_TEST_CHECK_ERROR(test_class->na_class == NULL, done, ret,
+        NA_PROTONOSUPPORT, "NA_Initialize(%s) failed", info_string);
+
+    test_class->context = NA_Context_create(test_class->na_class);
+    NA_TEST_CHECK_ERROR(test_class->context == NULL, done, ret, NA_NOMEM,
+        "NA_Context_create() failed");
+
+done:
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static void
+na_test_connect_class_finalize(struct na_test_connect_class *test_class)
+{
+    if (test_class->context != NULL)
+        (void) NA_Context_destroy(test_class->na_class, test_class->context);
+    if (test_class->na_class != NULL)
+        (void) NA_Finalize(test_class->na_class);
+}
+
+/*---------------------------------------------------------------------------*/
+static na_return_t
+na_test_connect_progress(
+    struct na_test_connect_class *test_class, bool *progressed)
+{
+    unsigned int actual_count = 0;
+    na_return_t ret;
+
+    ret = NA_Progress(test_class->na_class, test_class->context, 0);
+    NA_TEST_CHECK_ERROR(ret != NA_SUCCESS && ret != NA_TIMEOUT, done, ret, ret,
+        "NA_Progress() failed (%s)", NA_Error_to_string(ret));
+    *progressed = (ret == NA_SUCCESS);
+
+    ret = NA_Trigger(test_class->context, NUM_CLIENTS, &actual_count);
+    NA_TEST_CHECK_NA_ERROR(
+        done, ret, "NA_Trigger() failed (%s)", NA_Error_to_string(ret));
+    *progressed |= (actual_count > 0);
+
+done:
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static void
+na_test_connect_send_cb(const struct na_cb_info *callback_info)
+{
+    struct na_test_connect_op *op =
+        (struct na_test_connect_op *) callback_info->arg;
+
+    if (callback_info->ret != NA_SUCCESS) {
+        NA_TEST_LOG_ERROR("Send to peer %u failed (%s)", op->peer,
+            NA_Error_to_string(callback_info->ret));
+        return;
+    }
+
+    (*op->completed)++;
+}
+
+/*---------------------------------------------------------------------------*/
+static void
+na_test_connect_recv_cb(const struct na_cb_info *callback_info)
+{
+    struct na_test_connect_op *op =
+        (struct na_test_connect_op *) callback_info->arg;
+    const struct na_cb_info_recv_unexpected *info =
+        &callback_info->info.recv_unexpected;
+    struct na_test_connect_msg msg;
+    size_t header_size =
+        NA_Msg_get_unexpected_header_size(op->test_class->na_class);
+
+    if (callback_info->ret != NA_SUCCESS) {
+        NA_TEST_LOG_ERROR("Receive on peer %u failed (%s)", op->peer,
+            NA_Error_to_string(callback_info->ret));
+        return;
+    }
+
+    memcpy(&msg, (const char *) op->buf + header_size, sizeof(msg));
+    if (info->actual_buf_size != header_size + sizeof(msg) ||
+        msg.peer != op->peer || msg.client >= NUM_CLIENTS ||
+        op->seen[op->peer][msg.client]) {
+        NA_TEST_LOG_ERROR("Peer %u received unexpected message", op->peer);
+    } else {
+        op->seen[op->peer][msg.client] = true;
+        (*op->completed)++;
+    }
+
+    NA_Addr_free(op->test_class->na_class, info->source);
+}
+
+/*---------------------------------------------------------------------------*/
+static na_return_t
+na_test_connect_msg(struct na_test_connect_class *peers,
+    struct na_test_connect_class *clients,
+    na_addr_t *addrs[NUM_CLIENTS][NUM_PEERS])
+{
+    struct na_test_connect_op sends[NUM_CLIENTS][NUM_PEERS],
+        recvs[NUM_PEERS][NUM_CLIENTS];
+    bool seen[NUM_PEERS][NUM_CLIENTS];
+    unsigned int completed = 0, i, j;
+    size_t buf_size;
+    hg_time_t deadline, now;
+    na_return_t ret = NA_SUCCESS;
+
+    memset(sends, 0, sizeof(sends));
+    memset(recvs, 0, sizeof(recvs));
+    memset(seen, 0, sizeof(seen));
+    buf_size = NA_Msg_get_unexpected_header_size(peers[0].na_class) +
+               sizeof(struct na_test_connect_msg);
+
+    /* Every peer expects one message from every client */
+    for (i = 0; i < NUM_PEERS; i++) {
+        for (j = 0; j < NUM_CLIENTS; j++) {
+            struct na_test_connect_op *op = &recvs[i][j];
+
+            *op = (struct na_test_connect_op){.test_class = &peers[i],
+                .completed = &completed,
+                .peer = i,
+                .seen = seen};
+            op->buf = NA_Msg_buf_alloc(
+                peers[i].na_class, buf_size, NA_RECV, &op->plugin_data);
+            NA_TEST_CHECK_ERROR(op->buf == NULL, done, ret, NA_NOMEM,
+                "NA_Msg_buf_alloc() failed");
+            op->op_id = NA_Op_create(peers[i].na_class, NA_OP_SINGLE);
+            NA_TEST_CHECK_ERROR(op->op_id == NULL, done, ret, NA_NOMEM,
+                "NA_Op_create() failed");
+
+            ret = NA_Msg_recv_unexpected(peers[i].na_class, peers[i].context,
+                na_test_connect_recv_cb, op, op->buf, buf_size,
+                op->plugin_data, op->op_id);
+            NA_TEST_CHECK_NA_ERROR(done, ret,
+                "NA_Msg_recv_unexpected() failed (%s)",
+                NA_Error_to_string(ret));
+        }
+    }
+
+    for (i = 0; i < NUM_CLIENTS; i++) {
+        for (j = 0; j < NUM_PEERS; j++) {
+            struct na_test_connect_op *op = &sends[i][j];
+            struct na_test_connect_msg msg = {.client = i, .peer = j};
+
+            *op = (struct na_test_connect_op){.test_class = &clients[i],
+                .completed = &completed,
+                .peer = j};
+            op->buf = NA_Msg_buf_alloc(
+                clients[i].na_class, buf_size, NA_SEND, &op->plugin_data);
+            NA_TEST_CHECK_ERROR(op->buf == NULL, done, ret, NA_NOMEM,
+                "NA_Msg_buf_alloc() failed");
+            ret = NA_Msg_init_unexpected(
+                clients[i].na_class, op->buf, buf_size);
+            NA_TEST_CHECK_NA_ERROR(done, ret,
+                "NA_Msg_init_unexpected() failed (%s)",
+                NA_Error_to_string(ret));
+            memcpy((char *) op->buf +
+                       NA_Msg_get_unexpected_header_size(clients[i].na_class),
+                &msg, sizeof(msg));
+            op->op_id = NA_Op_create(clients[i].na_class, NA_OP_SINGLE);
+            NA_TEST_CHECK_ERROR(op->op_id == NULL, done, ret, NA_NOMEM,
+                "NA_Op_create() failed");
+
+            ret = NA_Msg_send_unexpected(clients[i].na_class,
+                clients[i].context, na_test_connect_send_cb, op, op->buf,
+                buf_size, op->plugin_data, addrs[i][j], 0, 0, op->op_id);
+            NA_TEST_CHECK_NA_ERROR(done, ret,
+                "NA_Msg_send_unexpected() failed (%s)",
+                NA_Error_to_string(ret));
+        }
+    }
+
+    hg_time_get_current_ms(&now);
+    deadline = hg_time_add(now, hg_time_from_ms(MSG_TIMEOUT));
+    while (completed < 2 * NUM_PEERS * NUM_CLIENTS) {
+        bool progressed = false;
+
+        for (i = 0; i < NUM_PEERS + NUM_CLIENTS; i++) {
+            bool progressed_class = false;
+
+            ret = na_test_connect_progress(
+                (i < NUM_PEERS) ? &peers[i] : &clients[i - NUM_PEERS],
+                &progressed_class);
+            NA_TEST_CHECK_NA_ERROR(done, ret, "Could not make progress");
+            progressed |= progressed_class;
+        }
+
+        hg_time_get_current_ms(&now);
+        NA_TEST_CHECK_ERROR(!progressed && !hg_time_less(now, deadline), done,
+            ret, NA_TIMEOUT, "Only %u of %u messages completed", completed,
+            2 * NUM_PEERS * NUM_CLIENTS);
+    }
+
+done:
+    for (i = 0; i < NUM_PEERS; i++) {
+        for (j = 0; j < NUM_CLIENTS; j++) {
+            if (recvs[i][j].op_id != NULL)
+                (void) NA_Op_destroy(peers[i].na_class, recvs[i][j].op_id);
+            if (recvs[i][j].buf != NULL)
+                NA_Msg_buf_free(peers[i].na_class, recvs[i][j].buf,
+                    recvs[i][j].plugin_data);
+        }
+    }
+    for (i = 0; i < NUM_CLIENTS; i++) {
+        for (j = 0; j < NUM_PEERS; j++) {
+            if (sends[i][j].op_id != NULL)
+                (void) NA_Op_destroy(clients[i].na_class, sends[i][j].op_id);
+            if (sends[i][j].buf != NULL)
+                NA_Msg_buf_free(clients[i].na_class, sends[i][j].buf,
+                    sends[i][j].plugin_data);
+        }
+    }
+
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static na_return_t
+na_test_connect(const char *info_string)
+{
+    struct na_test_connect_class peers[NUM_PEERS], clients[NUM_CLIENTS],
+        *last = &clients[NUM_CLIENTS - 1];
+    na_addr_t *addrs[NUM_CLIENTS][NUM_PEERS];
+    char names[NUM_PEERS][NA_TEST_MAX_ADDR_NAME];
+    hg_time_t t1, t2;
+    double elapsed;
+    unsigned int i, j;
+    na_return_t ret = NA_SUCCESS;
+
+    memset(peers, 0, sizeof(peers));
+    memset(clients, 0, sizeof(clients));
+    memset(addrs, 0, sizeof(addrs));
+
+    for (i = 0; i < NUM_PEERS; i++) {
+        na_addr_t *self_addr = NULL;
+        size_t name_size = NA_TEST_MAX_ADDR_NAME;
+
+        ret = na_test_connect_class_init(info_string, true, &peers[i]);
+        NA_TEST_CHECK_NA_ERROR(done, ret, "Could not initialize peer %u", i);
+
+        ret = NA_Addr_self(peers[i].na_class, &self_addr);
+        NA_TEST_CHECK_NA_ERROR(
+            done, ret, "NA_Addr_self() failed (%s)", NA_Error_to_string(ret));
+        ret = NA_Addr_to_string(
+            peers[i].na_class, names[i], &name_size, self_addr);
+        NA_Addr_free(peers[i].na_class, self_addr);
+        NA_TEST_CHECK_NA_ERROR(done, ret, "NA_Addr_to_string() failed (%s)",
+            NA_Error_to_string(ret));
+    }
+
+    /* Every client looks up every peer while peers do not make progress, so
+     * that handshakes of the last clients find the peer socks full */
+    for (i = 0; i < NUM_CLIENTS; i++) {
+        ret = na_test_connect_class_init(info_string, false, &clients[i]);
+        NA_TEST_CHECK_NA_ERROR(done, ret, "Could not initialize client %u", i);
+
+        for (j = 0; j < NUM_PEERS; j++) {
+            ret = NA_Addr_lookup(clients[i].na_class, names[j], &addrs[i][j]);
+            NA_TEST_CHECK_NA_ERROR(done, ret, "NA_Addr_lookup(%s) failed (%s)",
+                names[j], NA_Error_to_string(ret));
+        }
+    }
+
+    /* Pending handshakes must not prevent clients from blocking */
+    for (i = 0; i < NUM_CLIENTS; i++)
+        NA_TEST_CHECK_ERROR(
+            !NA_Poll_try_wait(clients[i].na_class, clients[i].context), done,
+            ret, NA_FAULT, "Client %u cannot block", i);
+
+    /* Drain peer socks */
+    for (i = 0; i < NUM_PEERS; i++) {
+        bool progressed;
+
+        do {
+            ret = na_test_connect_progress(&peers[i], &progressed);
+            NA_TEST_CHECK_NA_ERROR(done, ret, "Could not progress peer %u", i);
+        } while (progressed);
+    }
+
+    /* The last client is woken up by its peers draining their socks. If the
+     * socks had room for all clients, nothing is pending and it times out. */
+    hg_time_get_current(&t1);
+    ret = NA_Progress(last->na_class, last->context, CONNECT_TIMEOUT);
+    hg_time_get_current(&t2);
+    elapsed = hg_time_to_double(hg_time_subtract(t2, t1));
+    NA_TEST_CHECK_ERROR(ret != NA_SUCCESS && ret != NA_TIMEOUT, done, ret, ret,
+        "NA_Progress() failed (%s)", NA_Error_to_string(ret));
+    NA_TEST_CHECK_ERROR(ret == NA_SUCCESS &&
+                            elapsed * 1000.0 >= CONNECT_TIMEOUT / 2,
+        done, ret, NA_TIMEOUT,
+        "Blocked client was not woken up (%f s elapsed)", elapsed);
+
+    /* Every client reaches every peer */
+    ret = na_test_connect_msg(peers, clients, addrs);
+    NA_TEST_CHECK_NA_ERROR(done, ret, "Could not exchange messages (%s)",
+        NA_Error_to_string(ret));
+
+done:
+    for (i = 0; i < NUM_CLIENTS; i++) {
+        for (j = 0; j < NUM_PEERS; j++)
+            if (addrs[i][j] != NULL)
+                NA_Addr_free(clients[i].na_class, addrs[i][j]);
+        na_test_connect_class_finalize(&clients[i]);
+    }
+    for (i = 0; i < NUM_PEERS; i++)
+        na_test_connect_class_finalize(&peers[i]);
+
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+int
+main(int argc, char *argv[])
+{
+    na_return_t na_ret;
+    int ret = EXIT_SUCCESS;
+
+    if (argc < 2) {
+        fprintf(stderr, "Usage: %s <info string>\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    NA_TEST("connect to many peers");
+    na_ret = na_test_connect(argv[1]);
+    NA_TEST_CHECK_ERROR(na_ret != NA_SUCCESS, done, ret, EXIT_FAILURE,
+        "connect test failed");
+    NA_PASSED();
+
+done:
+    if (ret != EXIT_SUCCESS)
+        NA_FAILED();
+    return ret;
+}
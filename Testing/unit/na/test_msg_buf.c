@@ -0,0 +1,154 @@
+/**
+ * Copyright (c) 2013-2022 UChicago Argonne, LLC and The HDF Group.
+ * Copyright (c) 2022 Intel Corporation.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "na_test.h"
+
+#include "mercury_mem.h"
+
+#include <string.h>
+
+/****************/
+/* Local Macros */
+/****************/
+
+/* Number of buffers held at once, more than a single pool block provides */
+#define MSG_BUF_COUNT (600)
+
+/********************/
+/* Local Prototypes */
+/********************/
+
+static na_return_t
+na_test_msg_buf(const char *info_string, bool huge_pages);
+
+static na_return_t
+na_test_msg_buf_check(na_class_t *na_class, size_t buf_size);
+
+/*---------------------------------------------------------------------------*/
+static na_return_t
+na_test_msg_buf_check(na_class_t *na_class, size_t buf_size)
+{
+    void **bufs = NULL, **plugin_data = NULL;
+    size_t i, j;
+    na_return_t ret = NA_SUCCESS;
+
+    bufs = (void **) calloc(MSG_BUF_COUNT, sizeof(*bufs));
+    plugin_data = (void **) calloc(MSG_BUF_COUNT, sizeof(*plugin_data));
+    NA_TEST_CHECK_ERROR(bufs == NULL || plugin_data == NULL, done, ret,
+        NA_NOMEM, "Could not allocate buffer arrays");
+
+    for (i = 0; i < MSG_BUF_COUNT; i++) {
+        bufs[i] =
+            NA_Msg_buf_alloc(na_class, buf_size, NA_SEND, &plugin_data[i]);
+        NA_TEST_CHECK_ERROR(bufs[i] == NULL, done, ret, NA_NOMEM,
+            "NA_Msg_buf_alloc() failed for buffer %zu", i);
+
+        /* Buffers are returned zeroed, also when reused */
+        for (j = 0; j < buf_size; j++)
+            NA_TEST_CHECK_ERROR(((unsigned char *) bufs[i])[j] != 0, done, ret,
+                NA_FAULT, "Buffer %zu is not zeroed", i);
+        memset(bufs[i], (int) (i % 255) + 1, buf_size);
+    }
+
+    /* A buffer given out twice would have been overwritten */
+    for (i = 0; i < MSG_BUF_COUNT; i++)
+        for (j = 0; j < buf_size; j++)
+            NA_TEST_CHECK_ERROR(
+                ((unsigned char *) bufs[i])[j] != (i % 255) + 1, done, ret,
+                NA_FAULT, "Buffer %zu overlaps another buffer", i);
+
+done:
+    if (bufs != NULL) {
+        for (i = 0; i < MSG_BUF_COUNT; i++)
+            NA_Msg_buf_free(na_class, bufs[i], plugin_data[i]);
+    }
+    free(bufs);
+    free(plugin_data);
+
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static na_return_t
+na_test_msg_buf(const char *info_string, bool huge_pages)
+{
+    struct na_init_info na_init_info = NA_INIT_INFO_INITIALIZER;
+    na_class_t *na_class = NULL;
+    size_t buf_size;
+    void *buf = NULL, *plugin_data = NULL;
+    na_return_t ret;
+
+    na_init_info.msg_buf_huge_pages = huge_pages;
+    na_class = NA_Initialize_opt(info_string, false, &na_init_info);
+    NA_TEST_CHECK_ERROR(na_class == NULL, done, ret, NA_PROTONOSUPPORT,
+        "NA_Initialize_opt(%s) failed", info_string);
+
+    buf_size = NA_Msg_get_max_unexpected_size(na_class);
+    if (NA_Msg_get_max_expected_size(na_class) > buf_size)
+        buf_size = NA_Msg_get_max_expected_size(na_class);
+
+    /* Largest and smallest message sizes, twice so that freed buffers are
+     * reused */
+    ret = na_test_msg_buf_check(na_class, buf_size);
+    NA_TEST_CHECK_NA_ERROR(done, ret, "Could not check %zu bytes buffers (%s)",
+        buf_size, NA_Error_to_string(ret));
+    ret = na_test_msg_buf_check(na_class, 1);
+    NA_TEST_CHECK_NA_ERROR(done, ret, "Could not check 1 byte buffers (%s)",
+        NA_Error_to_string(ret));
+    ret = na_test_msg_buf_check(na_class, buf_size);
+    NA_TEST_CHECK_NA_ERROR(done, ret, "Could not check %zu bytes buffers (%s)",
+        buf_size, NA_Error_to_string(ret));
+
+    /* Buffers larger than the max message size are still page aligned */
+    buf = NA_Msg_buf_alloc(na_class, buf_size * 2 + 1, NA_RECV, &plugin_data);
+    NA_TEST_CHECK_ERROR(buf == NULL, done, ret, NA_NOMEM,
+        "NA_Msg_buf_alloc() failed for %zu bytes", buf_size * 2 + 1);
+    NA_TEST_CHECK_ERROR((size_t) buf % (size_t) hg_mem_get_page_size() != 0,
+        done, ret, NA_FAULT, "Oversized buffer is not page aligned");
+    memset(buf, 1, buf_size * 2 + 1);
+
+done:
+    if (buf != NULL)
+        NA_Msg_buf_free(na_class, buf, plugin_data);
+    if (na_class != NULL)
+        (void) NA_Finalize(na_class);
+
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+int
+main(int argc, char *argv[])
+{
+    na_return_t na_ret;
+    int ret = EXIT_SUCCESS;
+
+    if (argc < 2) {
+        fprintf(stderr, "Usage: %s <info string>\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    /* Each buffer is allocated separately */
+    NA_TEST("message buffers");
+    na_ret = na_test_msg_buf(argv[1], false);
+    NA_TEST_CHECK_ERROR(na_ret != NA_SUCCESS, done, ret, EXIT_FAILURE,
+        "message buffer test failed");
+    NA_PASSED();
+
+    /* Buffers come from a pool that falls back to regular pages if no huge
+     * pages are reserved */
+    NA_TEST("message buffers with huge pages");
+    na_ret = na_test_msg_buf(argv[1], true);
+    NA_TEST_CHECK_ERROR(na_ret != NA_SUCCESS, done, ret, EXIT_FAILURE,
+        "huge pages message buffer test failed");
+    NA_PASSED();
+
+done:
+    if (ret != EXIT_SUCCESS)
+        NA_FAILED();
+    return ret;
+}
@@ -0,0 +1,135 @@
+/**
+ * Copyright (c) 2013-2022 UChicago Argonne, LLC and The HDF Group.
+ * Copyright (c) 2022 Intel Corporation.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "mercury_checksum.h"
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#define BUF_SIZE (256)
+
+static uint32_t
+crc32c_ref(uint32_t crc, const unsigned char *buf, size_t len)
+{
+    size_t i;
+    int k;
+
+    for (i = 0; i < len; i++) {
+        crc ^= buf[i];
+        for (k = 0; k < 8; k++)
+            crc = (crc >> 1) ^ (0x82f63b78U & (0U - (crc & 1)));
+    }
+
+    return crc;
+}
+
+static int
+check_hash(const char *name, const void *buf, size_t len, uint32_t expected)
+{
+    uint32_t hash = hg_checksum_crc32c_final(
+        hg_checksum_crc32c_buf(HG_CHECKSUM_CRC32C_INIT, buf, len));
+
+    if (hash != expected) {
+        fprintf(stderr,
+            "Error: %s hash is 0x%08" PRIx32 " (expected 0x%08" PRIx32 ")\n",
+            name, hash, expected);
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
+
+/*---------------------------------------------------------------------------*/
+
+int
+main(void)
+{
+    unsigned char buf[BUF_SIZE + 8];
+    size_t i, offset, len;
+    uint32_t crc;
+    int ret = EXIT_SUCCESS;
+
+    /* Known answers (check value and RFC 3720 B.4 vectors) */
+    if (check_hash("check", "123456789", 9, 0xe3069283U) != EXIT_SUCCESS)
+        ret = EXIT_FAILURE;
+
+    memset(buf, 0, 32);
+    if (check_hash("zeros", buf, 32, 0x8a9136aaU) != EXIT_SUCCESS)
+        ret = EXIT_FAILURE;
+
+    memset(buf, 0xff, 32);
+    if (check_hash("ones", buf, 32, 0x62a8ab43U) != EXIT_SUCCESS)
+        ret = EXIT_FAILURE;
+
+    for (i = 0; i < 32; i++)
+        buf[i] = (unsigned char) i;
+    if (check_hash("incrementing", buf, 32, 0x46dd794eU) != EXIT_SUCCESS)
+        ret = EXIT_FAILURE;
+
+    for (i = 0; i < 32; i++)
+        buf[i] = (unsigned char) (31 - i);
+    if (check_hash("decrementing", buf, 32, 0x113fdb5cU) != EXIT_SUCCESS)
+        ret = EXIT_FAILURE;
+
+    if (ret != EXIT_SUCCESS)
+        goto done;
+
+    /* Compare against bitwise reference for all alignments and lengths */
+    srand(42);
+    for (i = 0; i < sizeof(buf); i++)
+        buf[i] = (unsigned char) rand();
+
+    for (offset = 0; offset < 8; offset++) {
+        for (len = 0; len <= BUF_SIZE; len++) {
+            uint32_t expected =
+                crc32c_ref(HG_CHECKSUM_CRC32C_INIT, buf + offset, len);
+
+            crc = hg_checksum_crc32c_buf(
+                HG_CHECKSUM_CRC32C_INIT, buf + offset, len);
+            if (crc != expected) {
+                fprintf(stderr,
+                    "Error: buf CRC mismatch at offset %zu, len %zu\n", offset,
+                    len);
+                ret = EXIT_FAILURE;
+                goto done;
+            }
+        }
+    }
+
+    /* Combined hashes must match hash of concatenated data */
+    for (offset = 0; offset <= BUF_SIZE; offset += 7) {
+        uint32_t crc1 = hg_checksum_crc32c_final(
+            hg_checksum_crc32c_buf(HG_CHECKSUM_CRC32C_INIT, buf, offset));
+        uint32_t crc2 = hg_checksum_crc32c_final(hg_checksum_crc32c_buf(
+            HG_CHECKSUM_CRC32C_INIT, buf + offset, BUF_SIZE - offset));
+
+        crc = hg_checksum_crc32c_combine(crc1, crc2, BUF_SIZE - offset);
+        if (crc != hg_checksum_crc32c_final(crc32c_ref(
+                       HG_CHECKSUM_CRC32C_INIT, buf, BUF_SIZE))) {
+            fprintf(stderr, "Error: combined CRC mismatch at offset %zu\n",
+                offset);
+            ret = EXIT_FAILURE;
+            goto done;
+        }
+    }
+
+    /* Inlined fixed-size updates must match buffer updates */
+    for (len = 1; len <= sizeof(uint64_t); len <<= 1) {
+        crc = HG_CHECKSUM_CRC32C_INIT;
+        for (offset = 0; offset + len <= BUF_SIZE; offset += len)
+            crc = hg_checksum_crc32c_update(crc, buf + offset, len);
+        if (crc != crc32c_ref(HG_CHECKSUM_CRC32C_INIT, buf, offset)) {
+            fprintf(stderr, "Error: update CRC mismatch for size %zu\n", len);
+            ret = EXIT_FAILURE;
+            goto done;
+        }
+    }
+
+done:
+    return ret;
+}
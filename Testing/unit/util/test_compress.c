@@ -0,0 +1,171 @@
+/**
+ * Copyright (c) 2013-2022 UChicago Argonne, LLC and The HDF Group.
+ * Copyright (c) 2022 Intel Corporation.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "mercury_compress.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define BUF_SIZE (70000) /* larger than the 64 KiB match window */
+
+/* Worst-case size of compressed data */
+#define COMP_BOUND(size) ((size) + (size) / 255 + 16)
+
+struct malformed {
+    const char *name;
+    unsigned char data[8];
+    size_t size;
+    size_t dst_size;
+};
+
+static const size_t sizes[] = {
+    1, 3, 4, 5, 15, 16, 19, 20, 270, 4096, 65536, 65540, BUF_SIZE};
+
+static const struct malformed malformed[] = {
+    /* token, literals, offset (LE), extended lengths */
+    {"zero offset", {0x10, 'a', 0x00, 0x00, 0x00}, 5, 5},
+    {"offset before start", {0x10, 'a', 0x02, 0x00, 0x00}, 5, 5},
+    {"literals past input", {0xf0, 0x0a, 'a', 'b'}, 4, 32},
+    {"literals past output", {0x30, 'a', 'b', 'c'}, 4, 2},
+    {"match past output", {0x1f, 'a', 0x01, 0x00, 0xc8, 0x00}, 6, 16},
+    {"unterminated length", {0xf0, 0xff, 0xff}, 3, 32},
+    {"missing offset", {0x10, 'a', 0x01}, 3, 5},
+    {"missing last literals", {0x14, 'a', 0x01, 0x00}, 4, 9},
+};
+
+static int
+check_round_trip(
+    const char *name, const unsigned char *src, size_t size, size_t max_comp)
+{
+    static unsigned char comp[COMP_BOUND(BUF_SIZE)], out[BUF_SIZE + 1];
+    size_t comp_size, len;
+
+    comp_size = hg_compress_lz(src, size, comp, sizeof(comp));
+    if (comp_size == 0 || comp_size > max_comp) {
+        fprintf(stderr, "Error: %s of size %zu compressed to %zu bytes\n",
+            name, size, comp_size);
+        return EXIT_FAILURE;
+    }
+
+    memset(out, 0, sizeof(out));
+    if (hg_decompress_lz(comp, comp_size, out, size) != size ||
+        memcmp(src, out, size) != 0) {
+        fprintf(stderr, "Error: %s of size %zu did not round-trip\n", name,
+            size);
+        return EXIT_FAILURE;
+    }
+
+    /* Source may be larger than the compressed data */
+    if (hg_decompress_lz(comp, sizeof(comp), out, size) != size) {
+        fprintf(stderr, "Error: %s of size %zu failed with larger source\n",
+            name, size);
+        return EXIT_FAILURE;
+    }
+
+    /* Output size must match exactly */
+    if (hg_decompress_lz(comp, comp_size, out, size - 1) != 0 ||
+        hg_decompress_lz(comp, comp_size, out, size + 1) != 0) {
+        fprintf(stderr, "Error: %s of size %zu decompressed to wrong size\n",
+            name, size);
+        return EXIT_FAILURE;
+    }
+
+    /* Every byte of the compressed data is needed */
+    for (len = 0; len < comp_size; len++) {
+        if (hg_decompress_lz(comp, len, out, size) != 0) {
+            fprintf(stderr,
+                "Error: %s of size %zu decompressed from %zu/%zu bytes\n",
+                name, size, len, comp_size);
+            return EXIT_FAILURE;
+        }
+        /* Only check the tail of large buffers */
+        if (comp_size > 64 && len == 32)
+            len = comp_size - 32;
+    }
+
+    return EXIT_SUCCESS;
+}
+
+/*---------------------------------------------------------------------------*/
+
+int
+main(void)
+{
+    static unsigned char buf[BUF_SIZE], comp[COMP_BOUND(BUF_SIZE)];
+    static const unsigned char overlap[] = {0x14, 'a', 0x01, 0x00, 0x00};
+    unsigned char out[32];
+    size_t i, j;
+    int ret = EXIT_SUCCESS;
+
+    for (i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++) {
+        size_t size = sizes[i];
+
+        /* Zeros compress to a single long match */
+        memset(buf, 0, size);
+        if (check_round_trip("zeros", buf, size, COMP_BOUND(size) / 4 + 16) !=
+            EXIT_SUCCESS) {
+            ret = EXIT_FAILURE;
+            goto done;
+        }
+
+        /* Repeated records, like arrays of structs */
+        for (j = 0; j < size; j++)
+            buf[j] = (unsigned char) ((j % 24 < 8) ? j / 24 : j % 24);
+        if (check_round_trip("records", buf, size, COMP_BOUND(size)) !=
+            EXIT_SUCCESS) {
+            ret = EXIT_FAILURE;
+            goto done;
+        }
+
+        /* Random data does not compress but must still round-trip */
+        srand(42);
+        for (j = 0; j < size; j++)
+            buf[j] = (unsigned char) rand();
+        if (check_round_trip("random", buf, size, COMP_BOUND(size)) !=
+            EXIT_SUCCESS) {
+            ret = EXIT_FAILURE;
+            goto done;
+        }
+    }
+
+    /* Incompressible data does not fit into a buffer of its own size */
+    if (hg_compress_lz(buf, 4096, comp, 4096) != 0) {
+        fprintf(stderr, "Error: random data fit into its own size\n");
+        ret = EXIT_FAILURE;
+        goto done;
+    }
+
+    /* Repeated data does */
+    memset(buf, 'x', 4096);
+    if (hg_compress_lz(buf, 4096, comp, 64) == 0) {
+        fprintf(stderr, "Error: repeated data did not compress\n");
+        ret = EXIT_FAILURE;
+        goto done;
+    }
+
+    /* Overlapping match repeats the last bytes */
+    if (hg_decompress_lz(overlap, sizeof(overlap), out, 9) != 9 ||
+        memcmp(out, "aaaaaaaaa", 9) != 0) {
+        fprintf(stderr, "Error: overlapping match not decoded\n");
+        ret = EXIT_FAILURE;
+        goto done;
+    }
+
+    /* Malformed data is rejected without writing past the output */
+    for (i = 0; i < sizeof(malformed) / sizeof(malformed[0]); i++) {
+        if (hg_decompress_lz(malformed[i].data, malformed[i].size, out,
+                malformed[i].dst_size) != 0) {
+            fprintf(stderr, "Error: %s not rejected\n", malformed[i].name);
+            ret = EXIT_FAILURE;
+            goto done;
+        }
+    }
+
+done:
+    return ret;
+}
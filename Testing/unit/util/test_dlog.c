@@ -0,0 +1,549 @@
+/**
+ * Copyright (c) 2013-2022 UChicago Argonne, LLC and The HDF Group.
+ * Copyright (c) 2022 Intel Corporation.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "mercury_dlog.h"
+
+#include <inttypes.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define NTHREADS  (4)
+#define NENTRIES  (64)
+#define NDUMPS    (200)
+#define LOOP_SIZE (16)
+#define NOPS      (3)
+#define NSTAGES   (3)
+
+/* name of the trace dumped by check_trace() */
+#define TRACE_BASE "hg_test_dlog_trace"
+
+struct thread_args {
+    struct hg_dlog *d;
+    hg_atomic_int32_t *nlogged;
+    uint64_t op_base;
+    int ret;
+};
+
+struct writer_args {
+    struct hg_dlog *d;
+    hg_atomic_int32_t stop;
+};
+
+struct stage_args {
+    struct hg_dlog *d;
+    int stage;
+};
+
+/* entries seen by count_log() */
+static unsigned int seen[2 * NTHREADS * NENTRIES + 1];
+static unsigned int nseen;
+static int mismatch;
+
+static const char *stage_names[NSTAGES] = {"create", "forward", "complete"};
+
+static HG_THREAD_RETURN_TYPE
+thread_cb_log(void *arg)
+{
+    hg_thread_ret_t thread_ret = (hg_thread_ret_t) 0;
+    struct thread_args *args = (struct thread_args *) arg;
+    uint64_t i;
+
+    for (i = 0; i < NENTRIES; i++) {
+        uint64_t op_id = args->op_base + i + 1;
+
+        if (!hg_dlog_addevent(args->d, __FILE__, __LINE__, __func__, "log",
+                NULL, op_id, (size_t) op_id)) {
+            fprintf(stderr, "Error: could not add entry %" PRIu64 "\n", op_id);
+            args->ret = EXIT_FAILURE;
+            goto done;
+        }
+    }
+
+    /* ring is full and does not loop */
+    if (hg_dlog_addevent(
+            args->d, __FILE__, __LINE__, __func__, "log", NULL, 0, 1)) {
+        fprintf(stderr, "Error: entry added to full ring\n");
+        args->ret = EXIT_FAILURE;
+    }
+
+done:
+    /* keep ring until all threads have logged so that none is reused */
+    hg_atomic_incr32(args->nlogged);
+    while (hg_atomic_get32(args->nlogged) < NTHREADS)
+        hg_thread_yield();
+
+    hg_thread_exit(thread_ret);
+    return thread_ret;
+}
+
+static HG_THREAD_RETURN_TYPE
+thread_cb_write(void *arg)
+{
+    hg_thread_ret_t thread_ret = (hg_thread_ret_t) 0;
+    struct writer_args *args = (struct writer_args *) arg;
+    uint64_t op_id = 1;
+
+    /* op_id and size always match unless an entry is torn */
+    while (!hg_atomic_get32(&args->stop)) {
+        hg_dlog_addevent(args->d, __FILE__, __LINE__, __func__, "write", NULL,
+            op_id, (size_t) op_id);
+        op_id++;
+    }
+
+    hg_thread_exit(thread_ret);
+    return thread_ret;
+}
+
+static HG_THREAD_RETURN_TYPE
+thread_cb_stage(void *arg)
+{
+    hg_thread_ret_t thread_ret = (hg_thread_ret_t) 0;
+    struct stage_args *args = (struct stage_args *) arg;
+    uint64_t op_id;
+
+    for (op_id = 1; op_id <= NOPS; op_id++)
+        hg_dlog_addevent(args->d, __FILE__, __LINE__, __func__,
+            stage_names[args->stage], NULL, op_id, 0);
+
+    hg_thread_exit(thread_ret);
+    return thread_ret;
+}
+
+/* log_func of hg_dlog_dump() that records the op_id of each entry */
+static int
+count_log(FILE *stream, const char *fmt, ...)
+{
+    char line[256];
+    const char *op;
+    uint64_t op_id;
+    size_t size;
+    va_list ap;
+
+    (void) stream;
+
+    va_start(ap, fmt);
+    vsnprintf(line, sizeof(line), fmt, ap);
+    va_end(ap);
+
+    if (strncmp(line, "## ", 3) != 0 || !(op = strstr(line, " op=")))
+        return 0;
+    if (sscanf(op, " op=%" SCNu64 " size=%zu", &op_id, &size) != 2 ||
+        op_id != (uint64_t) size) {
+        mismatch++;
+        return 0;
+    }
+    if (op_id < sizeof(seen) / sizeof(seen[0]))
+        seen[op_id]++;
+    nseen++;
+
+    return 0;
+}
+
+static void
+count_reset(void)
+{
+    memset(seen, 0, sizeof(seen));
+    nseen = 0;
+    mismatch = 0;
+}
+
+static unsigned int
+ring_count(struct hg_dlog *d)
+{
+    struct hg_dlog_ring *ring;
+    unsigned int n = 0;
+
+    HG_LIST_FOREACH (ring, &d->rings, l)
+        n++;
+
+    return n;
+}
+
+static unsigned int
+free_ring_count(struct hg_dlog *d)
+{
+    struct hg_dlog_ring *ring;
+    unsigned int n = 0;
+
+    HG_LIST_FOREACH (ring, &d->free_rings, fl)
+        n++;
+
+    return n;
+}
+
+/* Log NENTRIES from each of NTHREADS concurrent threads */
+static int
+log_threads(struct hg_dlog *d, uint64_t op_base)
+{
+    hg_thread_t threads[NTHREADS];
+    struct thread_args args[NTHREADS];
+    hg_atomic_int32_t nlogged;
+    int ret = EXIT_SUCCESS;
+    int i;
+
+    hg_atomic_init32(&nlogged, 0);
+    for (i = 0; i < NTHREADS; i++) {
+        args[i].d = d;
+        args[i].nlogged = &nlogged;
+        args[i].op_base = op_base + (uint64_t) i * NENTRIES;
+        args[i].ret = EXIT_SUCCESS;
+        hg_thread_create(&threads[i], thread_cb_log, &args[i]);
+    }
+    for (i = 0; i < NTHREADS; i++) {
+        hg_thread_join(threads[i]);
+        if (args[i].ret != EXIT_SUCCESS)
+            ret = EXIT_FAILURE;
+    }
+
+    return ret;
+}
+
+/* Check that entries op_base + 1 .. op_base + count were each dumped once */
+static int
+check_dump(struct hg_dlog *d, uint64_t op_base, unsigned int count)
+{
+    unsigned int i;
+
+    count_reset();
+    hg_dlog_dump(d, count_log, stderr, 0);
+
+    if (mismatch) {
+        fprintf(stderr, "Error: %d torn entries dumped\n", mismatch);
+        return EXIT_FAILURE;
+    }
+    if (nseen != count) {
+        fprintf(stderr, "Error: dumped %u entries (expected %u)\n", nseen,
+            count);
+        return EXIT_FAILURE;
+    }
+    for (i = 1; i <= count; i++) {
+        if (seen[op_base + i] != 1) {
+            fprintf(stderr, "Error: entry %" PRIu64 " dumped %u times\n",
+                op_base + i, seen[op_base + i]);
+            return EXIT_FAILURE;
+        }
+    }
+
+    return EXIT_SUCCESS;
+}
+
+/* Return value of key in a trace event line */
+static const char *
+json_find(const char *line, const char *key)
+{
+    char pattern[32];
+    const char *p;
+
+    snprintf(pattern, sizeof(pattern), "\"%s\": ", key);
+    p = strstr(line, pattern);
+
+    return p ? p + strlen(pattern) : NULL;
+}
+
+static int
+json_str(const char *line, const char *key, char *buf, size_t size)
+{
+    const char *p = json_find(line, key), *end;
+
+    if (!p || *p++ != '"' || !(end = strchr(p, '"')) ||
+        (size_t) (end - p) >= size)
+        return -1;
+    memcpy(buf, p, (size_t) (end - p));
+    buf[end - p] = '\0';
+
+    return 0;
+}
+
+static int
+json_num(const char *line, const char *key, double *val)
+{
+    const char *p = json_find(line, key);
+    char *end;
+
+    if (!p)
+        return -1;
+    *val = strtod(p, &end);
+
+    return (end == p) ? -1 : 0;
+}
+
+/* Read the whole dumped trace */
+static char *
+trace_read(const char *path)
+{
+    FILE *fp = fopen(path, "r");
+    char *buf = NULL;
+    long len;
+
+    if (!fp)
+        return NULL;
+    if (fseek(fp, 0, SEEK_END) != 0 || (len = ftell(fp)) < 0 ||
+        fseek(fp, 0, SEEK_SET) != 0)
+        goto done;
+    buf = malloc((size_t) len + 1);
+    if (!buf)
+        goto done;
+    if (fread(buf, 1, (size_t) len, fp) != (size_t) len) {
+        free(buf);
+        buf = NULL;
+        goto done;
+    }
+    buf[len] = '\0';
+
+done:
+    fclose(fp);
+    return buf;
+}
+
+/* Parse trace events and check instant events and op spans */
+static int
+trace_parse(char *events)
+{
+    char name[64], b_name[64] = "", expected[64], ph[4];
+    double ts, tid, op_id, id, last_ts = 0, last_op = -1, b_id = 0, b_ts = 0;
+    double create_tid = -1;
+    unsigned int ninstants = 0, nspans = 0;
+    char *line;
+
+    for (line = strtok(events, "\n"); line; line = strtok(NULL, "\n")) {
+        size_t len = strlen(line);
+
+        if (line[len - 1] == ',')
+            line[--len] = '\0';
+        if (line[0] != '{' || line[len - 1] != '}') {
+            fprintf(stderr, "Error: malformed event: %s\n", line);
+            return EXIT_FAILURE;
+        }
+        if (json_str(line, "ph", ph, sizeof(ph)) < 0 ||
+            json_str(line, "name", name, sizeof(name)) < 0 ||
+            json_num(line, "ts", &ts) < 0 || json_num(line, "tid", &tid) < 0) {
+            fprintf(stderr, "Error: missing event field: %s\n", line);
+            return EXIT_FAILURE;
+        }
+
+        if (strcmp(ph, "i") == 0) {
+            if (json_num(line, "op_id", &op_id) < 0) {
+                fprintf(stderr, "Error: missing op_id: %s\n", line);
+                return EXIT_FAILURE;
+            }
+            if (strcmp(name, "torn") == 0) {
+                fprintf(stderr, "Error: torn entry in trace\n");
+                return EXIT_FAILURE;
+            }
+            /* stages of an op are grouped and in time order */
+            if (op_id < last_op || (op_id == last_op && ts < last_ts)) {
+                fprintf(stderr, "Error: event out of order: %s\n", line);
+                return EXIT_FAILURE;
+            }
+            if (strcmp(name, "create") == 0)
+                create_tid = tid;
+            else if (strcmp(name, "forward") == 0 && tid == create_tid) {
+                fprintf(stderr, "Error: forward recorded on create thread\n");
+                return EXIT_FAILURE;
+            }
+            last_op = op_id;
+            last_ts = ts;
+            ninstants++;
+        } else if (strcmp(ph, "b") == 0) {
+            if (json_num(line, "id", &b_id) < 0) {
+                fprintf(stderr, "Error: missing span id: %s\n", line);
+                return EXIT_FAILURE;
+            }
+            snprintf(expected, sizeof(expected), "%s -> %s",
+                stage_names[nspans % (NSTAGES - 1)],
+                stage_names[nspans % (NSTAGES - 1) + 1]);
+            if (strcmp(name, expected) != 0 || b_id != last_op) {
+                fprintf(stderr, "Error: unexpected span: %s\n", line);
+                return EXIT_FAILURE;
+            }
+            strcpy(b_name, name);
+            b_ts = ts;
+        } else if (strcmp(ph, "e") == 0) {
+            /* must close the span opened by the previous event */
+            if (json_num(line, "id", &id) < 0 || id != b_id ||
+                strcmp(name, b_name) != 0 || ts < b_ts) {
+                fprintf(stderr, "Error: unmatched span end: %s\n", line);
+                return EXIT_FAILURE;
+            }
+            b_name[0] = '\0';
+            nspans++;
+        } else {
+            fprintf(stderr, "Error: unexpected phase: %s\n", line);
+            return EXIT_FAILURE;
+        }
+    }
+
+    /* one idle entry without op_id, no span for it */
+    if (ninstants != NOPS * NSTAGES + 1 || nspans != NOPS * (NSTAGES - 1) ||
+        b_name[0] != '\0') {
+        fprintf(stderr, "Error: %u events, %u spans (expected %d, %d)\n",
+            ninstants, nspans, NOPS * NSTAGES + 1, NOPS * (NSTAGES - 1));
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
+
+/* Dump stages of ops recorded by two threads and parse the trace back */
+static int
+check_trace(struct hg_dlog *d)
+{
+    static const char header[] =
+        "{\"displayTimeUnit\": \"ns\", \"traceEvents\": [\n";
+    static const char trailer[] = "\n]}\n";
+    struct stage_args args;
+    hg_thread_t thread;
+    char *buf = NULL;
+    size_t len;
+    uint64_t op_id;
+    int ret = EXIT_SUCCESS;
+
+    /* first ring belongs to this thread, entries go to le[0..] */
+    for (op_id = 1; op_id <= NOPS; op_id++)
+        hg_dlog_addevent(
+            d, __FILE__, __LINE__, __func__, stage_names[0], NULL, op_id, 0);
+    args.d = d;
+    args.stage = 1;
+    hg_thread_create(&thread, thread_cb_stage, &args);
+    hg_thread_join(thread);
+    for (op_id = 1; op_id <= NOPS; op_id++)
+        hg_dlog_addevent(
+            d, __FILE__, __LINE__, __func__, stage_names[2], NULL, op_id, 0);
+    hg_dlog_addlog(d, __FILE__, __LINE__, __func__, "idle", NULL);
+    hg_dlog_addlog(d, __FILE__, __LINE__, __func__, "torn", NULL);
+    hg_atomic_set32(&d->le[2 * NOPS + 1].seq, 0);
+
+    if (hg_dlog_dump_trace(d, TRACE_BASE, 0) != HG_UTIL_SUCCESS) {
+        fprintf(stderr, "Error: could not dump trace\n");
+        return EXIT_FAILURE;
+    }
+    buf = trace_read(TRACE_BASE ".json");
+    remove(TRACE_BASE ".json");
+    if (!buf) {
+        fprintf(stderr, "Error: could not read trace\n");
+        return EXIT_FAILURE;
+    }
+
+    len = strlen(buf);
+    if (len < sizeof(header) + sizeof(trailer) ||
+        strncmp(buf, header, sizeof(header) - 1) != 0 ||
+        strcmp(buf + len - (sizeof(trailer) - 1), trailer) != 0) {
+        fprintf(stderr, "Error: malformed trace header or trailer\n");
+        ret = EXIT_FAILURE;
+        goto done;
+    }
+    buf[len - (sizeof(trailer) - 1)] = '\0';
+    ret = trace_parse(buf + sizeof(header) - 1);
+
+done:
+    free(buf);
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+
+int
+main(void)
+{
+    struct hg_dlog *d;
+    struct hg_dlog_ring *ring;
+    struct writer_args writer_args;
+    hg_thread_t writer;
+    int ret = EXIT_SUCCESS;
+    int i;
+
+    d = hg_dlog_alloc("test", NENTRIES, 0);
+    if (!d) {
+        fprintf(stderr, "Error: could not allocate dlog\n");
+        return EXIT_FAILURE;
+    }
+
+    /* Each thread logs to its own ring */
+    ret = log_threads(d, 0);
+    if (ret != EXIT_SUCCESS)
+        goto done;
+    if (ring_count(d) != NTHREADS || free_ring_count(d) != NTHREADS) {
+        fprintf(stderr, "Error: %u rings, %u free (expected %d)\n",
+            ring_count(d), free_ring_count(d), NTHREADS);
+        ret = EXIT_FAILURE;
+        goto done;
+    }
+    ret = check_dump(d, 0, NTHREADS * NENTRIES);
+    if (ret != EXIT_SUCCESS)
+        goto done;
+
+    /* Entries being written or overwritten are skipped */
+    ring = HG_LIST_FIRST(&d->rings);
+    hg_atomic_set32(&ring->le[0].seq, 0);
+    hg_atomic_set32(&ring->le[1].seq, NENTRIES + 2);
+    count_reset();
+    hg_dlog_dump(d, count_log, stderr, 0);
+    if (nseen != NTHREADS * NENTRIES - 2) {
+        fprintf(stderr, "Error: dumped %u entries (expected %d)\n", nseen,
+            NTHREADS * NENTRIES - 2);
+        ret = EXIT_FAILURE;
+        goto done;
+    }
+
+    /* Threads started after the first ones exited reuse their rings */
+    hg_dlog_resetlog(d);
+    ret = log_threads(d, NTHREADS * NENTRIES);
+    if (ret != EXIT_SUCCESS)
+        goto done;
+    if (ring_count(d) != NTHREADS) {
+        fprintf(stderr, "Error: %u rings (expected %d)\n", ring_count(d),
+            NTHREADS);
+        ret = EXIT_FAILURE;
+        goto done;
+    }
+    ret = check_dump(d, NTHREADS * NENTRIES, NTHREADS * NENTRIES);
+    if (ret != EXIT_SUCCESS)
+        goto done;
+
+    hg_dlog_free(d);
+
+    /* Dump while another thread keeps overwriting a looping ring */
+    d = hg_dlog_alloc("test", LOOP_SIZE, 1);
+    if (!d) {
+        fprintf(stderr, "Error: could not allocate dlog\n");
+        return EXIT_FAILURE;
+    }
+    writer_args.d = d;
+    hg_atomic_init32(&writer_args.stop, 0);
+    hg_thread_create(&writer, thread_cb_write, &writer_args);
+    for (i = 0; i < NDUMPS; i++) {
+        count_reset();
+        hg_dlog_dump(d, count_log, stderr, 0);
+        if (mismatch || nseen > LOOP_SIZE) {
+            fprintf(stderr, "Error: dumped %u entries, %d torn\n", nseen,
+                mismatch);
+            ret = EXIT_FAILURE;
+            break;
+        }
+    }
+    hg_atomic_set32(&writer_args.stop, 1);
+    hg_thread_join(writer);
+    if (ret != EXIT_SUCCESS)
+        goto done;
+
+    hg_dlog_free(d);
+
+    /* Dumped trace can be parsed back */
+    d = hg_dlog_alloc("test", NENTRIES, 0);
+    if (!d) {
+        fprintf(stderr, "Error: could not allocate dlog\n");
+        return EXIT_FAILURE;
+    }
+    ret = check_trace(d);
+
+done:
+    hg_dlog_free(d);
+
+    return ret;
+}
@@ -0,0 +1,334 @@
+/**
+ * Copyright (c) 2013-2022 UChicago Argonne, LLC and The HDF Group.
+ * Copyright (c) 2022 Intel Corporation.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "mercury_hash_map.h"
+#include "mercury_hash_table.h"
+#include "mercury_time.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#define NENTRIES 100000
+
+/* Benchmark models an address map with this many connected clients by
+ * default, both can be changed from the command line */
+#define BENCH_NCLIENTS (10000)
+#define BENCH_NLOOPS   (20)
+
+/* Key with an odd size to exercise partial word hashing */
+struct test_key {
+    uint32_t pid;
+    uint8_t id;
+};
+
+static unsigned int
+u64_hash(hg_hash_table_key_t key)
+{
+    return (unsigned int) (*((uint64_t *) key) & 0xffffffff);
+}
+
+static int
+u64_equal(hg_hash_table_key_t key1, hg_hash_table_key_t key2)
+{
+    return *((uint64_t *) key1) == *((uint64_t *) key2);
+}
+
+static void
+value_free(void *value)
+{
+    (*(int *) value)++;
+}
+
+/*---------------------------------------------------------------------------*/
+static int
+test_hash_map_ops(void)
+{
+    hg_hash_map_t *hash_map;
+    hg_hash_map_iter_t iter;
+    uint64_t *keys = NULL;
+    int *freed = NULL;
+    struct test_key key = {0, 0};
+    unsigned int i, count;
+    int ret = EXIT_SUCCESS;
+
+    keys = (uint64_t *) malloc(NENTRIES * sizeof(*keys));
+    freed = (int *) calloc(NENTRIES, sizeof(*freed));
+    hash_map = hg_hash_map_new(sizeof(uint64_t));
+    if (keys == NULL || freed == NULL || hash_map == NULL) {
+        fprintf(stderr, "Error: could not allocate hash map\n");
+        ret = EXIT_FAILURE;
+        goto done;
+    }
+    hg_hash_map_register_free_function(hash_map, value_free);
+
+    for (i = 0; i < NENTRIES; i++) {
+        keys[i] = (uint64_t) i * 0x10001;
+        if (!hg_hash_map_insert(hash_map, &keys[i], &freed[i])) {
+            fprintf(stderr, "Error: could not insert key %u\n", i);
+            ret = EXIT_FAILURE;
+            goto done;
+        }
+    }
+    if (hg_hash_map_num_entries(hash_map) != NENTRIES) {
+        fprintf(stderr, "Error: unexpected number of entries\n");
+        ret = EXIT_FAILURE;
+        goto done;
+    }
+
+    for (i = 0; i < NENTRIES; i++) {
+        if (hg_hash_map_lookup(hash_map, &keys[i]) != &freed[i]) {
+            fprintf(stderr, "Error: could not find key %u\n", i);
+            ret = EXIT_FAILURE;
+            goto done;
+        }
+    }
+
+    /* Remove every other entry and make sure tombstones do not break probing */
+    for (i = 0; i < NENTRIES; i += 2) {
+        if (!hg_hash_map_remove(hash_map, &keys[i]) ||
+            hg_hash_map_remove(hash_map, &keys[i])) {
+            fprintf(stderr, "Error: could not remove key %u\n", i);
+            ret = EXIT_FAILURE;
+            goto done;
+        }
+    }
+    for (i = 0; i < NENTRIES; i++) {
+        void *value = hg_hash_map_lookup(hash_map, &keys[i]);
+
+        if ((i % 2 == 0 && (value != NULL || freed[i] != 1)) ||
+            (i % 2 != 0 && value != &freed[i])) {
+            fprintf(stderr, "Error: unexpected lookup result for key %u\n", i);
+            ret = EXIT_FAILURE;
+            goto done;
+        }
+    }
+
+    /* Re-insert removed entries */
+    for (i = 0; i < NENTRIES; i += 2)
+        hg_hash_map_insert(hash_map, &keys[i], &freed[i]);
+
+    count = 0;
+    hg_hash_map_iterate(hash_map, &iter);
+    while (hg_hash_map_iter_has_more(&iter))
+        if (hg_hash_map_iter_next(&iter) != NULL)
+            count++;
+    if (count != NENTRIES || hg_hash_map_iter_next(&iter) != NULL) {
+        fprintf(stderr, "Error: iterated over %u entries\n", count);
+        ret = EXIT_FAILURE;
+        goto done;
+    }
+
+    hg_hash_map_free(hash_map);
+    hash_map = NULL;
+    for (i = 0; i < NENTRIES; i++) {
+        if (freed[i] != (i % 2 == 0) + 1) {
+            fprintf(stderr, "Error: value %u freed %d times\n", i, freed[i]);
+            ret = EXIT_FAILURE;
+            goto done;
+        }
+    }
+
+    /* Odd-sized keys */
+    hash_map = hg_hash_map_new(sizeof(uint32_t) + sizeof(uint8_t));
+    if (hash_map == NULL) {
+        fprintf(stderr, "Error: could not allocate hash map\n");
+        ret = EXIT_FAILURE;
+        goto done;
+    }
+    key.pid = 1234;
+    key.id = 1;
+    hg_hash_map_insert(hash_map, &key, &freed[0]);
+    key.id = 2;
+    hg_hash_map_insert(hash_map, &key, &freed[1]);
+    key.id = 1;
+    if (hg_hash_map_lookup(hash_map, &key) != &freed[0]) {
+        fprintf(stderr, "Error: could not find odd-sized key\n");
+        ret = EXIT_FAILURE;
+        goto done;
+    }
+
+done:
+    hg_hash_map_free(hash_map);
+    free(keys);
+    free(freed);
+
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static double
+bench_elapsed(hg_time_t t1)
+{
+    hg_time_t t2;
+
+    hg_time_get_current(&t2);
+
+    return hg_time_to_double(hg_time_subtract(t2, t1));
+}
+
+/*---------------------------------------------------------------------------*/
+static void
+bench_print(const char *name, const double *times, unsigned int nclients,
+    unsigned int nloops)
+{
+    double ops = (double) nclients * nloops;
+
+    printf("%-16s %10.2f %10.2f %10.2f %10.2f\n", name, times[0] * 1e9 / ops,
+        times[1] * 1e9 / ops, times[2] * 1e9 / ops, times[3] * 1e9 / ops);
+}
+
+/*---------------------------------------------------------------------------*/
+static int
+test_hash_map_bench(unsigned int nclients, unsigned int nloops)
+{
+    hg_hash_table_t *hash_table = NULL;
+    hg_hash_map_t *hash_map = NULL;
+    uint64_t *keys = NULL;
+    unsigned int *order = NULL;
+    double table_times[4] = {0}, map_times[4] = {0};
+    hg_time_t t1;
+    unsigned int i, j;
+    int ret = EXIT_SUCCESS;
+
+    /* Keys of connected clients followed by keys of clients replacing them */
+    keys = (uint64_t *) malloc(2 * nclients * sizeof(*keys));
+    order = (unsigned int *) malloc(nclients * sizeof(*order));
+    if (keys == NULL || order == NULL) {
+        fprintf(stderr, "Error: could not allocate keys\n");
+        ret = EXIT_FAILURE;
+        goto done;
+    }
+
+    /* Random keys, removed and looked up in random order */
+    srand(42);
+    for (i = 0; i < 2 * nclients; i++)
+        keys[i] = ((uint64_t) rand() << 32) | (uint64_t) rand();
+    for (i = 0; i < nclients; i++)
+        order[i] = i;
+    for (i = nclients - 1; i > 0; i--) {
+        unsigned int k = (unsigned int) rand() % (i + 1), tmp = order[i];
+
+        order[i] = order[k];
+        order[k] = tmp;
+    }
+
+    /* Each loop times, per client: insert into a new table (connect), remove
+     * and insert of another client (churn), lookup (receive path) and free
+     * (shutdown) */
+    for (j = 0; j < nloops; j++) {
+        hg_time_get_current(&t1);
+        hash_table = hg_hash_table_new(u64_hash, u64_equal);
+        for (i = 0; i < nclients && hash_table != NULL; i++)
+            if (!hg_hash_table_insert(hash_table, &keys[i], &keys[i]))
+                ret = EXIT_FAILURE;
+        table_times[0] += bench_elapsed(t1);
+        if (hash_table == NULL || ret != EXIT_SUCCESS) {
+            fprintf(stderr, "Error: could not fill hash table\n");
+            ret = EXIT_FAILURE;
+            goto done;
+        }
+
+        hg_time_get_current(&t1);
+        for (i = 0; i < nclients; i++) {
+            hg_hash_table_remove(hash_table, &keys[order[i]]);
+            if (!hg_hash_table_insert(hash_table, &keys[nclients + order[i]],
+                    &keys[nclients + order[i]]))
+                ret = EXIT_FAILURE;
+        }
+        table_times[1] += bench_elapsed(t1);
+
+        hg_time_get_current(&t1);
+        for (i = 0; i < nclients; i++)
+            if (hg_hash_table_lookup(hash_table, &keys[nclients + order[i]]) !=
+                &keys[nclients + order[i]])
+                ret = EXIT_FAILURE;
+        table_times[2] += bench_elapsed(t1);
+
+        hg_time_get_current(&t1);
+        hg_hash_table_free(hash_table);
+        hash_table = NULL;
+        table_times[3] += bench_elapsed(t1);
+
+        hg_time_get_current(&t1);
+        hash_map = hg_hash_map_new(sizeof(uint64_t));
+        for (i = 0; i < nclients && hash_map != NULL; i++)
+            if (!hg_hash_map_insert(hash_map, &keys[i], &keys[i]))
+                ret = EXIT_FAILURE;
+        map_times[0] += bench_elapsed(t1);
+        if (hash_map == NULL || ret != EXIT_SUCCESS) {
+            fprintf(stderr, "Error: could not fill hash map\n");
+            ret = EXIT_FAILURE;
+            goto done;
+        }
+
+        hg_time_get_current(&t1);
+        for (i = 0; i < nclients; i++) {
+            hg_hash_map_remove(hash_map, &keys[order[i]]);
+            if (!hg_hash_map_insert(hash_map, &keys[nclients + order[i]],
+                    &keys[nclients + order[i]]))
+                ret = EXIT_FAILURE;
+        }
+        map_times[1] += bench_elapsed(t1);
+
+        hg_time_get_current(&t1);
+        for (i = 0; i < nclients; i++)
+            if (hg_hash_map_lookup(hash_map, &keys[nclients + order[i]]) !=
+                &keys[nclients + order[i]])
+                ret = EXIT_FAILURE;
+        map_times[2] += bench_elapsed(t1);
+
+        hg_time_get_current(&t1);
+        hg_hash_map_free(hash_map);
+        hash_map = NULL;
+        map_times[3] += bench_elapsed(t1);
+
+        if (ret != EXIT_SUCCESS) {
+            fprintf(stderr, "Error: lookup returned wrong value\n");
+            goto done;
+        }
+    }
+
+    printf("# %u clients, average over %u loops (ns/client)\n", nclients,
+        nloops);
+    printf("%-16s %10s %10s %10s %10s\n", "# Table", "insert", "churn",
+        "lookup", "free");
+    bench_print("hg_hash_table", table_times, nclients, nloops);
+    bench_print("hg_hash_map", map_times, nclients, nloops);
+
+done:
+    if (hash_table != NULL)
+        hg_hash_table_free(hash_table);
+    hg_hash_map_free(hash_map);
+    free(keys);
+    free(order);
+
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+int
+main(int argc, char *argv[])
+{
+    unsigned int nclients = BENCH_NCLIENTS, nloops = BENCH_NLOOPS;
+    int ret;
+
+    /* Usage: hg_test_hash_map [number of clients] [number of loops] */
+    if (argc > 1)
+        nclients = (unsigned int) atoi(argv[1]);
+    if (argc > 2)
+        nloops = (unsigned int) atoi(argv[2]);
+    if (nclients == 0 || nloops == 0) {
+        fprintf(stderr, "Error: invalid number of clients or loops\n");
+        return EXIT_FAILURE;
+    }
+
+    ret = test_hash_map_ops();
+    if (ret != EXIT_SUCCESS)
+        return ret;
+
+    return test_hash_map_bench(nclients, nloops);
+}
@@ -6,6 +6,7 @@
  */
 
 #include "mercury_atomic.h"
+#include "mercury_mem.h"
 #include "mercury_mem_pool.h"
 #include "mercury_thread.h"
 #include "mercury_thread_condition.h"
@@ -22,6 +23,14 @@
 #define CHUNK_COUNT1 (2)
 #define BLOCK_COUNT1 (1)
 
+#define CHUNK_SIZE2  (64)
+#define CHUNK_COUNT2 (128)
+#define HOLD_COUNT2  (200)
+#define ROUND_COUNT2 (16)
+
+#define CHUNK_SIZE3  (4096)
+#define CHUNK_COUNT3 (8)
+
 #ifndef HG_TEST_NUM_THREADS_DEFAULT
 #    define HG_TEST_NUM_THREADS_DEFAULT (8)
 #endif
@@ -36,9 +45,16 @@ struct thread_args {
     hg_thread_cond_t cond;
     unsigned int n_threads;
     hg_atomic_int32_t n_mr;
+    hg_atomic_int32_t n_errors;
     int mr;
 };
 
+struct huge_args {
+    unsigned long flags; /* Flags passed to register_func */
+    size_t len;          /* Length of last registered block */
+    int n_mr;            /* Number of registered blocks */
+};
+
 /********************/
 /* Local Prototypes */
 /********************/
@@ -53,6 +69,15 @@ hg_test_mem_pool_deregister(void *handle, void *arg);
 static void
 hg_test_mem_pool_alloc(struct hg_mem_pool *hg_mem_pool, int mr);
 
+static int
+hg_test_mem_pool_hold(struct hg_mem_pool *hg_mem_pool, unsigned char id);
+
+static int
+hg_test_mem_pool_threads(struct thread_args *thread_args);
+
+static int
+hg_test_mem_pool_huge(void);
+
 /*******************/
 /* Local Variables */
 /*******************/
@@ -116,6 +141,30 @@ hg_test_alloc_thread(void *arg)
     return thread_ret;
 }
 
+/*---------------------------------------------------------------------------*/
+static HG_THREAD_RETURN_TYPE
+hg_test_hold_thread(void *arg)
+{
+    struct thread_args *thread_args = (struct thread_args *) arg;
+    hg_thread_ret_t thread_ret = (hg_thread_ret_t) 0;
+    unsigned char id;
+
+    /* Wait for all threads to have reached that point */
+    hg_thread_mutex_lock(&thread_args->mutex);
+    id = (unsigned char) ++thread_args->n_threads;
+    if (thread_args->n_threads == HG_TEST_NUM_THREADS_DEFAULT)
+        hg_thread_cond_broadcast(&thread_args->cond);
+    while (thread_args->n_threads != HG_TEST_NUM_THREADS_DEFAULT)
+        hg_thread_cond_wait(&thread_args->cond, &thread_args->mutex);
+    hg_thread_mutex_unlock(&thread_args->mutex);
+
+    if (hg_test_mem_pool_hold(thread_args->mem_pool, id) != EXIT_SUCCESS)
+        hg_atomic_incr32(&thread_args->n_errors);
+
+    hg_thread_exit(thread_ret);
+    return thread_ret;
+}
+
 /*---------------------------------------------------------------------------*/
 static void
 hg_test_mem_pool_alloc(struct hg_mem_pool *hg_mem_pool, int mr)
@@ -137,6 +186,225 @@ hg_test_mem_pool_alloc(struct hg_mem_pool *hg_mem_pool, int mr)
     }
 }
 
+/*---------------------------------------------------------------------------*/
+static int
+hg_test_mem_pool_hold(struct hg_mem_pool *hg_mem_pool, unsigned char id)
+{
+    void *mem_ptrs[HOLD_COUNT2];
+    int i, j, k;
+
+    /* Hold more chunks than a thread cache can keep so that chunks move
+     * between thread caches, the depot and new blocks */
+    for (i = 0; i < ROUND_COUNT2; i++) {
+        for (j = 0; j < HOLD_COUNT2; j++) {
+            mem_ptrs[j] = hg_mem_pool_alloc(hg_mem_pool, CHUNK_SIZE2, NULL);
+            if (mem_ptrs[j] == NULL) {
+                fprintf(stderr, "Error: could not allocate chunk\n");
+                return EXIT_FAILURE;
+            }
+            memset(mem_ptrs[j], id, CHUNK_SIZE2);
+        }
+
+        /* A chunk given to two threads would have been overwritten */
+        for (j = 0; j < HOLD_COUNT2; j++) {
+            for (k = 0; k < CHUNK_SIZE2; k++) {
+                if (((unsigned char *) mem_ptrs[j])[k] != id) {
+                    fprintf(stderr, "Error: chunk %p is shared\n", mem_ptrs[j]);
+                    return EXIT_FAILURE;
+                }
+            }
+        }
+
+        for (j = 0; j < HOLD_COUNT2; j++)
+            hg_mem_pool_free(hg_mem_pool, mem_ptrs[j], NULL);
+    }
+
+    return EXIT_SUCCESS;
+}
+
+/*---------------------------------------------------------------------------*/
+static int
+hg_test_mem_pool_threads(struct thread_args *thread_args)
+{
+    hg_thread_t threads[HG_TEST_NUM_THREADS_DEFAULT];
+    struct hg_mem_pool_stats stats;
+    size_t expected = (size_t) HG_TEST_NUM_THREADS_DEFAULT * HOLD_COUNT2 *
+                      ROUND_COUNT2;
+    void **mem_ptrs = NULL;
+    size_t block_count, chunk_count, i;
+    int ret = EXIT_SUCCESS;
+
+    thread_args->n_threads = 0;
+    hg_atomic_init32(&thread_args->n_errors, 0);
+    thread_args->mem_pool = hg_mem_pool_create(
+        CHUNK_SIZE2, CHUNK_COUNT2, 1, NULL, 0, NULL, NULL);
+    if (thread_args->mem_pool == NULL)
+        return EXIT_FAILURE;
+
+    for (i = 0; i < HG_TEST_NUM_THREADS_DEFAULT; i++)
+        hg_thread_create(&threads[i], hg_test_hold_thread, thread_args);
+
+    for (i = 0; i < HG_TEST_NUM_THREADS_DEFAULT; i++)
+        hg_thread_join(threads[i]);
+
+    if (hg_atomic_get32(&thread_args->n_errors) != 0) {
+        ret = EXIT_FAILURE;
+        goto done;
+    }
+
+    hg_mem_pool_get_stats(thread_args->mem_pool, &stats);
+    if (stats.alloc_count != expected || stats.free_count != expected) {
+        fprintf(stderr,
+            "Error: %zu allocs / %zu frees counted (expected %zu)\n",
+            stats.alloc_count, stats.free_count, expected);
+        ret = EXIT_FAILURE;
+        goto done;
+    }
+
+#ifndef _WIN32
+    /* Chunks cached by exited threads must have been returned, all chunks can
+     * therefore be allocated without extending the pool */
+    block_count = stats.block_count;
+    chunk_count = stats.chunk_count;
+    mem_ptrs = (void **) malloc(chunk_count * sizeof(*mem_ptrs));
+    if (mem_ptrs == NULL) {
+        ret = EXIT_FAILURE;
+        goto done;
+    }
+    for (i = 0; i < chunk_count; i++)
+        mem_ptrs[i] =
+            hg_mem_pool_alloc(thread_args->mem_pool, CHUNK_SIZE2, NULL);
+
+    hg_mem_pool_get_stats(thread_args->mem_pool, &stats);
+    if (stats.block_count != block_count) {
+        fprintf(stderr, "Error: pool was extended (%zu blocks, expected %zu)\n",
+            stats.block_count, block_count);
+        ret = EXIT_FAILURE;
+    }
+
+    for (i = 0; i < chunk_count; i++)
+        hg_mem_pool_free(thread_args->mem_pool, mem_ptrs[i], NULL);
+    free(mem_ptrs);
+#else
+    (void) block_count;
+    (void) chunk_count;
+    (void) mem_ptrs;
+#endif
+
+done:
+    hg_mem_pool_destroy(thread_args->mem_pool);
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static int
+hg_test_mem_pool_register_huge(
+    const void *buf, size_t len, unsigned long flags, void **handle, void *arg)
+{
+    struct huge_args *huge_args = (struct huge_args *) arg;
+
+    (void) buf;
+
+    huge_args->flags = flags;
+    huge_args->len = len;
+    huge_args->n_mr++;
+    *handle = huge_args;
+
+    return HG_UTIL_SUCCESS;
+}
+
+/*---------------------------------------------------------------------------*/
+static int
+hg_test_mem_pool_deregister_huge(void *handle, void *arg)
+{
+    struct huge_args *huge_args = (struct huge_args *) arg;
+
+    (void) handle;
+    huge_args->n_mr--;
+
+    return HG_UTIL_SUCCESS;
+}
+
+/*---------------------------------------------------------------------------*/
+static int
+hg_test_mem_pool_huge(void)
+{
+    struct huge_args huge_args = {0, 0, 0};
+    struct hg_mem_pool *hg_mem_pool;
+    struct hg_mem_pool_stats stats;
+    size_t huge_page_size = (size_t) hg_mem_get_hugepage_size();
+    void *mem_ptrs[CHUNK_COUNT3], *mr_handles[CHUNK_COUNT3];
+    size_t i, j;
+    int ret = EXIT_SUCCESS;
+
+    /* Blocks fall back to regular pages if no huge pages are reserved */
+    hg_mem_pool = hg_mem_pool_create(CHUNK_SIZE3, CHUNK_COUNT3, 1,
+        hg_test_mem_pool_register_huge, HG_MEM_POOL_HUGE_PAGES,
+        hg_test_mem_pool_deregister_huge, &huge_args);
+    if (hg_mem_pool == NULL) {
+        fprintf(stderr, "Error: could not create pool with huge pages\n");
+        return EXIT_FAILURE;
+    }
+
+    if (huge_args.n_mr != 1 || (huge_args.flags & HG_MEM_POOL_HUGE_PAGES)) {
+        fprintf(stderr, "Error: %d blocks registered with flags 0x%lx\n",
+            huge_args.n_mr, huge_args.flags);
+        ret = EXIT_FAILURE;
+        goto done;
+    }
+
+    /* Huge blocks are rounded up and the extra space used for chunks */
+    hg_mem_pool_get_stats(hg_mem_pool, &stats);
+    if (huge_page_size > 0 && huge_args.len % huge_page_size == 0) {
+        if (stats.chunk_count <= CHUNK_COUNT3) {
+            fprintf(stderr, "Error: %zu chunks in %zu bytes huge block\n",
+                stats.chunk_count, huge_args.len);
+            ret = EXIT_FAILURE;
+            goto done;
+        }
+    } else if (stats.chunk_count != CHUNK_COUNT3) {
+        fprintf(stderr, "Error: %zu chunks in fallback block (expected %d)\n",
+            stats.chunk_count, CHUNK_COUNT3);
+        ret = EXIT_FAILURE;
+        goto done;
+    }
+
+    /* Chunks of the block are usable and distinct */
+    for (i = 0; i < CHUNK_COUNT3; i++) {
+        mem_ptrs[i] =
+            hg_mem_pool_alloc(hg_mem_pool, CHUNK_SIZE3, &mr_handles[i]);
+        if (mem_ptrs[i] == NULL || mr_handles[i] != &huge_args) {
+            fprintf(stderr, "Error: could not allocate registered chunk\n");
+            while (i-- > 0)
+                hg_mem_pool_free(hg_mem_pool, mem_ptrs[i], mr_handles[i]);
+            ret = EXIT_FAILURE;
+            goto done;
+        }
+        memset(mem_ptrs[i], (int) i + 1, CHUNK_SIZE3);
+    }
+    for (i = 0; i < CHUNK_COUNT3; i++) {
+        for (j = 0; j < CHUNK_SIZE3; j++) {
+            if (((unsigned char *) mem_ptrs[i])[j] != i + 1) {
+                fprintf(stderr, "Error: chunk %p is shared\n", mem_ptrs[i]);
+                ret = EXIT_FAILURE;
+                break;
+            }
+        }
+    }
+    for (i = 0; i < CHUNK_COUNT3; i++)
+        hg_mem_pool_free(hg_mem_pool, mem_ptrs[i], mr_handles[i]);
+
+done:
+    hg_mem_pool_destroy(hg_mem_pool);
+    if (huge_args.n_mr != 0) {
+        fprintf(stderr, "Error: memory still registered (%d)\n",
+            huge_args.n_mr);
+        ret = EXIT_FAILURE;
+    }
+
+    return ret;
+}
+
 /*---------------------------------------------------------------------------*/
 int
 main(void)
@@ -187,6 +455,14 @@ main(void)
             (int) hg_atomic_get32(&thread_args.n_mr));
     }
 
+    /* Concurrent allocations holding many chunks */
+    ret = hg_test_mem_pool_threads(&thread_args);
+    if (ret != EXIT_SUCCESS)
+        goto done;
+
+    /* Pool backed by huge pages */
+    ret = hg_test_mem_pool_huge();
+
 done:
     hg_thread_mutex_destroy(&thread_args.mutex);
     hg_thread_cond_destroy(&thread_args.cond);
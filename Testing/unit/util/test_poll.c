@@ -10,6 +10,10 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+
+/* Exit code used when the requested backend is not available */
+#define HG_TEST_POLL_SKIP (77)
 
 int
 main(void)
@@ -18,9 +22,24 @@ main(void)
     struct hg_poll_event events[2];
     unsigned int nevents = 0;
     bool signaled = false;
+    const char *backend;
     int event_fd1, event_fd2, ret = EXIT_SUCCESS;
 
     poll_set = hg_poll_create();
+    if (!poll_set) {
+        fprintf(stderr, "Error: could not create poll set\n");
+        return EXIT_FAILURE;
+    }
+
+    /* Skip if a backend was requested and could not be used */
+    backend = getenv("HG_POLL_BACKEND");
+    printf("# Using %s poll backend\n", hg_poll_get_backend(poll_set));
+    if (backend && strcmp(backend, hg_poll_get_backend(poll_set)) != 0) {
+        printf("# %s poll backend not available, skipping\n", backend);
+        hg_poll_destroy(poll_set);
+        return HG_TEST_POLL_SKIP;
+    }
+
     event_fd1 = hg_event_create();
     event_fd2 = hg_event_create();
 
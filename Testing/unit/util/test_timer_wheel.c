@@ -0,0 +1,240 @@
+/**
+ * Copyright (c) 2013-2022 UChicago Argonne, LLC and The HDF Group.
+ * Copyright (c) 2022 Intel Corporation.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "mercury_atomic.h"
+#include "mercury_thread.h"
+#include "mercury_time.h"
+#include "mercury_timer_wheel.h"
+
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define NTIMERS 128
+
+struct rearm_args {
+    struct hg_timer_wheel *wheel;
+    struct hg_timer *timer; /* Timer re-armed by callback */
+    int *expired;
+};
+
+struct slow_args {
+    hg_atomic_int32_t started;
+    hg_atomic_int32_t done;
+};
+
+static void
+timer_cb(void *arg)
+{
+    (*(int *) arg)++;
+}
+
+static void
+timer_rearm_cb(void *arg)
+{
+    struct rearm_args *args = (struct rearm_args *) arg;
+
+    /* Supersede a pending expiration of another timer */
+    (void) hg_timer_wheel_del(args->wheel, args->timer);
+    (void) hg_timer_wheel_add(args->wheel, args->timer, 3600 * 1000);
+    (*args->expired)++;
+}
+
+static void
+timer_slow_cb(void *arg)
+{
+    struct slow_args *args = (struct slow_args *) arg;
+
+    hg_atomic_set32(&args->started, 1);
+    hg_time_sleep(hg_time_from_ms(100));
+    hg_atomic_set32(&args->done, 1);
+}
+
+static HG_THREAD_RETURN_TYPE
+expire_thread_cb(void *arg)
+{
+    hg_thread_ret_t thread_ret = (hg_thread_ret_t) 0;
+    struct hg_timer_wheel *wheel = (struct hg_timer_wheel *) arg;
+    unsigned int count = 0;
+
+    while (count == 0) {
+        hg_time_sleep(hg_time_from_ms(1));
+        count = hg_timer_wheel_expire(wheel);
+    }
+
+    hg_thread_exit(thread_ret);
+    return thread_ret;
+}
+
+int
+main(int argc, char *argv[])
+{
+    struct hg_timer_wheel *wheel;
+    struct hg_timer timers[NTIMERS], long_timer, rearm_timers[2];
+    struct rearm_args rearm_args[2];
+    struct slow_args slow_args;
+    hg_thread_t thread;
+    hg_time_t t1, t2;
+    int expired[NTIMERS] = {0}, long_expired = 0, rearm_expired = 0;
+    unsigned int i, count = 0, timeout;
+    int ret = EXIT_SUCCESS;
+
+    (void) argc;
+    (void) argv;
+
+    wheel = hg_timer_wheel_create();
+    if (wheel == NULL) {
+        fprintf(stderr, "Error: could not create timer wheel\n");
+        return EXIT_FAILURE;
+    }
+
+    if (!hg_timer_wheel_is_empty(wheel) ||
+        hg_timer_wheel_next_timeout(wheel) != UINT_MAX) {
+        fprintf(stderr, "Error: wheel should be empty\n");
+        ret = EXIT_FAILURE;
+        goto done;
+    }
+
+    /* Arm timers with deadlines spanning multiple levels, every other timer is
+     * disarmed before expiring */
+    for (i = 0; i < NTIMERS; i++) {
+        hg_timer_init(&timers[i], timer_cb, &expired[i]);
+        if (hg_timer_wheel_add(wheel, &timers[i], i * 3) != 0) {
+            fprintf(stderr, "Error: could not arm timer %u\n", i);
+            ret = EXIT_FAILURE;
+            goto done;
+        }
+    }
+    hg_timer_init(&long_timer, timer_cb, &long_expired);
+    hg_timer_wheel_add(wheel, &long_timer, 3600 * 1000);
+
+    /* Re-arming an armed timer must fail */
+    if (hg_timer_wheel_add(wheel, &timers[0], 1) == 0) {
+        fprintf(stderr, "Error: timer was armed twice\n");
+        ret = EXIT_FAILURE;
+        goto done;
+    }
+
+    for (i = 1; i < NTIMERS; i += 2) {
+        if (!hg_timer_wheel_del(wheel, &timers[i])) {
+            fprintf(stderr, "Error: timer %u should be armed\n", i);
+            ret = EXIT_FAILURE;
+            goto done;
+        }
+    }
+    if (hg_timer_wheel_del(wheel, &timers[1])) {
+        fprintf(stderr, "Error: timer 1 should not be armed\n");
+        ret = EXIT_FAILURE;
+        goto done;
+    }
+
+    /* Wait for all the short timers to expire */
+    hg_time_get_current_ms(&t1);
+    do {
+        timeout = hg_timer_wheel_next_timeout(wheel);
+        if (timeout == UINT_MAX) {
+            fprintf(stderr, "Error: long timer should still be armed\n");
+            ret = EXIT_FAILURE;
+            goto done;
+        }
+        hg_time_sleep(hg_time_from_ms(1));
+        count += hg_timer_wheel_expire(wheel);
+        hg_time_get_current_ms(&t2);
+    } while (count < NTIMERS / 2 && hg_time_to_ms(hg_time_subtract(t2, t1)) <
+                                        (NTIMERS * 3) + 1000);
+
+    if (count != NTIMERS / 2) {
+        fprintf(stderr, "Error: %u timers expired, expected %u\n", count,
+            NTIMERS / 2);
+        ret = EXIT_FAILURE;
+        goto done;
+    }
+
+    for (i = 0; i < NTIMERS; i++) {
+        if (expired[i] != (int) ((i % 2) == 0)) {
+            fprintf(stderr, "Error: timer %u expired %d times\n", i,
+                expired[i]);
+            ret = EXIT_FAILURE;
+            goto done;
+        }
+    }
+
+    if (long_expired != 0 || hg_timer_wheel_is_empty(wheel)) {
+        fprintf(stderr, "Error: long timer should not have expired\n");
+        ret = EXIT_FAILURE;
+        goto done;
+    }
+
+    if (!hg_timer_wheel_del(wheel, &long_timer) ||
+        !hg_timer_wheel_is_empty(wheel)) {
+        fprintf(stderr, "Error: wheel should be empty\n");
+        ret = EXIT_FAILURE;
+        goto done;
+    }
+
+    /* Timers on different levels that are due after an idle period must all
+     * expire with a single call */
+    memset(expired, 0, sizeof(expired));
+    for (i = 0; i < 3; i++) {
+        hg_timer_init(&timers[i], timer_cb, &expired[i]);
+        hg_timer_wheel_add(wheel, &timers[i], (i == 2) ? 3600 * 1000 : i * 70);
+    }
+    hg_time_sleep(hg_time_from_ms(200));
+    count = hg_timer_wheel_expire(wheel);
+    if (count != 2 || expired[0] != 1 || expired[1] != 1 || expired[2] != 0) {
+        fprintf(stderr, "Error: %u timers expired after idle period\n", count);
+        ret = EXIT_FAILURE;
+        goto done;
+    }
+    hg_timer_wheel_del(wheel, &timers[2]);
+
+    /* Timers expiring together, the first callback to run re-arms the other
+     * timer, whose expiration must then be dropped */
+    for (i = 0; i < 2; i++) {
+        rearm_args[i].wheel = wheel;
+        rearm_args[i].timer = &rearm_timers[1 - i];
+        rearm_args[i].expired = &rearm_expired;
+        hg_timer_init(&rearm_timers[i], timer_rearm_cb, &rearm_args[i]);
+    }
+    hg_timer_wheel_add(wheel, &rearm_timers[0], 5);
+    hg_timer_wheel_add(wheel, &rearm_timers[1], 5);
+    hg_time_sleep(hg_time_from_ms(20));
+    count = hg_timer_wheel_expire(wheel);
+    if (count != 1 || rearm_expired != 1) {
+        fprintf(stderr, "Error: %u callbacks executed, expected 1\n", count);
+        ret = EXIT_FAILURE;
+        goto done;
+    }
+    if (hg_timer_wheel_is_empty(wheel)) {
+        fprintf(stderr, "Error: re-armed timer should be armed\n");
+        ret = EXIT_FAILURE;
+        goto done;
+    }
+    hg_timer_wheel_del(wheel, &rearm_timers[0]);
+    hg_timer_wheel_del(wheel, &rearm_timers[1]);
+
+    /* Disarming a timer whose callback is running waits for it to return */
+    hg_atomic_init32(&slow_args.started, 0);
+    hg_atomic_init32(&slow_args.done, 0);
+    hg_timer_init(&timers[0], timer_slow_cb, &slow_args);
+    hg_timer_wheel_add(wheel, &timers[0], 1);
+    hg_thread_create(&thread, expire_thread_cb, wheel);
+    while (hg_atomic_get32(&slow_args.started) == 0)
+        hg_thread_yield();
+    if (hg_timer_wheel_del(wheel, &timers[0]) ||
+        hg_atomic_get32(&slow_args.done) != 1) {
+        fprintf(stderr, "Error: del returned before callback completed\n");
+        ret = EXIT_FAILURE;
+    }
+    hg_thread_join(thread);
+
+done:
+    hg_timer_wheel_destroy(wheel);
+
+    return ret;
+}
@@ -11,6 +11,7 @@
 #include "mercury_proc.h"
 #include "mercury_proc_bulk.h"
 
+#include "mercury_compress.h"
 #include "mercury_hash_string.h"
 #include "mercury_mem.h"
 #include "mercury_thread_spin.h"
@@ -34,6 +35,10 @@
 #define HG_STRINGIFY(x)       HG_UTIL_STRINGIFY(x)
 #define HG_SUBSYS_NAME_STRING HG_STRINGIFY(HG_SUBSYS_NAME)
 
+/* Largest expansion of a compressed payload (each extended length byte of the
+ * codec produces at most 255 bytes) */
+#define HG_COMPRESS_MAX_RATIO (255)
+
 /************************************/
 /* Local Type and Struct Definition */
 /************************************/
@@ -54,6 +59,7 @@ struct hg_proc_info {
     hg_proc_cb_t out_proc_cb;      /* Output proc callback */
     void *data;                    /* User data */
     void (*free_callback)(void *); /* User data free callback */
+    hg_size_t compress_threshold;  /* Compress payloads of that size */
     hg_bool_t no_response;         /* RPC response not expected */
 };
 
@@ -69,6 +75,8 @@ struct hg_private_handle {
     void *respond_arg;                  /* Respond callback args */
     void *in_extra_buf;                 /* Extra input buffer */
     void *out_extra_buf;                /* Extra output buffer */
+    void *in_raw_buf;                   /* Decompressed input payload */
+    void *out_raw_buf;                  /* Decompressed output payload */
     hg_proc_t in_proc;                  /* Proc for input */
     hg_proc_t out_proc;                 /* Proc for output */
     hg_bulk_t in_extra_bulk;            /* Extra input bulk handle */
@@ -78,6 +86,15 @@ struct hg_private_handle {
     hg_bool_t use_checksums;            /* Handle uses checksums */
 };
 
+/* Pre-encoded RPC payload */
+struct hg_payload {
+    hg_core_payload_t core_payload; /* Core payload */
+    hg_id_t id;                     /* RPC ID */
+    hg_size_t payload_size;         /* Encoded size */
+    hg_uint8_t proc_flags;          /* Proc flags used for encoding */
+    hg_bool_t no_response;          /* RPC response not expected */
+};
+
 /* HG op id */
 struct hg_op_info_lookup {
     struct hg_addr *hg_addr; /* Address */
@@ -161,6 +178,32 @@ hg_set_struct(struct hg_private_handle *hg_handle,
     const struct hg_proc_info *hg_proc_info, hg_op_t op, void *struct_ptr,
     hg_size_t *payload_size, hg_bool_t *more_data);
 
+/**
+ * Same as hg_set_struct() but copy payload already encoded by another handle
+ * when possible.
+ */
+static hg_return_t
+hg_set_struct_shared(struct hg_private_handle *hg_handle,
+    struct hg_private_handle *hg_handle_src,
+    const struct hg_proc_info *hg_proc_info, hg_op_t op, void *struct_ptr,
+    hg_size_t *payload_size, hg_bool_t *more_data);
+
+#ifndef HG_HAS_XDR
+/**
+ * Compress encoded payload, into the eager buffer when possible.
+ */
+static hg_return_t
+hg_set_struct_compress(hg_proc_t proc, void *buf, hg_size_t buf_size,
+    struct hg_header_comp *hg_header_comp, void **comp_buf_p,
+    hg_size_t *comp_size_p);
+#endif
+
+/**
+ * Get proc flags used for encoding input/output structure.
+ */
+static hg_uint8_t
+hg_set_struct_flags(struct hg_private_handle *hg_handle);
+
 /**
  * Free allocated members from input/output structure.
  */
@@ -187,6 +230,13 @@ hg_get_extra_payload_cb(const struct hg_cb_info *callback_info);
 static void
 hg_free_extra_payload(struct hg_private_handle *hg_handle);
 
+/**
+ * Forward handle with optional timeout.
+ */
+static hg_return_t
+hg_forward(hg_handle_t handle, hg_cb_t callback, void *arg, void *in_struct,
+    unsigned int timeout_ms);
+
 /**
  * Forward callback.
  */
@@ -371,6 +421,13 @@ hg_more_data_free_cb(hg_core_handle_t core_handle)
         return;
 
     hg_free_extra_payload(hg_handle);
+
+    /* Decompressed payloads may still be referenced by cached bulk handles
+     * until the handle is released */
+    free(hg_handle->in_raw_buf);
+    hg_handle->in_raw_buf = NULL;
+    free(hg_handle->out_raw_buf);
+    hg_handle->out_raw_buf = NULL;
 }
 
 /*---------------------------------------------------------------------------*/
@@ -438,12 +495,13 @@ hg_get_struct(struct hg_private_handle *hg_handle,
 {
     hg_proc_t proc = HG_PROC_NULL;
     hg_proc_cb_t proc_cb = NULL;
-    void *buf, *extra_buf;
+    void *buf, *extra_buf, *raw_buf = NULL, **raw_buf_p = NULL;
     hg_size_t buf_size, extra_buf_size;
     struct hg_header *hg_header = &hg_handle->hg_header;
 #ifdef HG_HAS_CHECKSUMS
     struct hg_header_hash *hg_header_hash = NULL;
 #endif
+    struct hg_header_comp *hg_header_comp = NULL;
     hg_size_t header_offset = hg_header_get_size(op);
     hg_return_t ret;
 
@@ -457,6 +515,7 @@ hg_get_struct(struct hg_private_handle *hg_handle,
 #ifdef HG_HAS_CHECKSUMS
             hg_header_hash = &hg_header->msg.input.hash;
 #endif
+            hg_header_comp = &hg_header->msg.input.comp;
 
             /* Get core input buffer */
             ret = HG_Core_get_input(
@@ -467,6 +526,7 @@ hg_get_struct(struct hg_private_handle *hg_handle,
 
             extra_buf = hg_handle->in_extra_buf;
             extra_buf_size = hg_handle->in_extra_buf_size;
+            raw_buf_p = &hg_handle->in_raw_buf;
             break;
         case HG_OUTPUT:
             /* Cannot respond if no_response flag set */
@@ -482,6 +542,7 @@ hg_get_struct(struct hg_private_handle *hg_handle,
 #ifdef HG_HAS_CHECKSUMS
             hg_header_hash = &hg_header->msg.output.hash;
 #endif
+            hg_header_comp = &hg_header->msg.output.comp;
 
             /* Get core output buffer */
             ret = HG_Core_get_output(
@@ -491,6 +552,7 @@ hg_get_struct(struct hg_private_handle *hg_handle,
 
             extra_buf = hg_handle->out_extra_buf;
             extra_buf_size = hg_handle->out_extra_buf_size;
+            raw_buf_p = &hg_handle->out_raw_buf;
             break;
         default:
             HG_GOTO_SUBSYS_ERROR(
@@ -517,6 +579,37 @@ hg_get_struct(struct hg_private_handle *hg_handle,
         buf_size -= header_offset;
     }
 
+    /* Decompress payload if the sender compressed it */
+    if (hg_header_comp->raw_size > 0) {
+#ifdef HG_HAS_XDR
+        HG_GOTO_SUBSYS_ERROR(rpc, error, ret, HG_PROTONOSUPPORT,
+            "Compressed payloads are not supported with XDR");
+#else
+        size_t raw_size = (size_t) hg_header_comp->raw_size;
+
+        /* Size comes from the peer, do not allocate more than the codec can
+         * produce from the received buffer */
+        HG_CHECK_SUBSYS_ERROR(rpc,
+            raw_size / HG_COMPRESS_MAX_RATIO > (size_t) buf_size, error, ret,
+            HG_PROTOCOL_ERROR,
+            "Decompressed payload size (%zu) exceeds maximum for %" PRIu64
+            " bytes received",
+            raw_size, buf_size);
+
+        raw_buf = malloc(raw_size);
+        HG_CHECK_SUBSYS_ERROR(rpc, raw_buf == NULL, error, ret, HG_NOMEM,
+            "Could not allocate %zu bytes for decompressed payload", raw_size);
+
+        HG_CHECK_SUBSYS_ERROR(rpc,
+            hg_decompress_lz(buf, (size_t) buf_size, raw_buf, raw_size) !=
+                raw_size,
+            error, ret, HG_PROTOCOL_ERROR, "Could not decompress payload");
+
+        buf = raw_buf;
+        buf_size = (hg_size_t) raw_size;
+#endif
+    }
+
     /* Reset proc */
     ret = hg_proc_reset(proc, buf, buf_size, HG_DECODE);
     HG_CHECK_SUBSYS_HG_ERROR(rpc, error, ret, "Could not reset proc");
@@ -549,6 +642,13 @@ hg_get_struct(struct hg_private_handle *hg_handle,
     }
 #endif
 
+    /* Decoded bulk handles cache pointers into the decompressed payload, keep
+     * it until the handle is released */
+    if (raw_buf) {
+        free(*raw_buf_p);
+        *raw_buf_p = raw_buf;
+    }
+
     /* Increment ref count on handle so that it remains valid until free_struct
      * is called */
     HG_Core_ref_incr(hg_handle->handle.core_handle);
@@ -556,6 +656,7 @@ hg_get_struct(struct hg_private_handle *hg_handle,
     return HG_SUCCESS;
 
 error:
+    free(raw_buf);
     return ret;
 }
 
@@ -567,14 +668,14 @@ hg_set_struct(struct hg_private_handle *hg_handle,
 {
     hg_proc_t proc = HG_PROC_NULL;
     hg_proc_cb_t proc_cb = NULL;
-    hg_uint8_t proc_flags = 0;
-    void *buf, **extra_buf;
-    hg_size_t buf_size, *extra_buf_size;
+    void *buf, **extra_buf, *comp_buf = NULL;
+    hg_size_t buf_size, *extra_buf_size, comp_size = 0;
     hg_bulk_t *extra_bulk;
     struct hg_header *hg_header = &hg_handle->hg_header;
 #ifdef HG_HAS_CHECKSUMS
     struct hg_header_hash *hg_header_hash = NULL;
 #endif
+    struct hg_header_comp *hg_header_comp = NULL;
     hg_size_t header_offset = hg_header_get_size(op);
     hg_return_t ret;
 
@@ -588,6 +689,7 @@ hg_set_struct(struct hg_private_handle *hg_handle,
 #ifdef HG_HAS_CHECKSUMS
             hg_header_hash = &hg_header->msg.input.hash;
 #endif
+            hg_header_comp = &hg_header->msg.input.comp;
 
             /* Get core input buffer */
             ret = HG_Core_get_input(
@@ -613,6 +715,7 @@ hg_set_struct(struct hg_private_handle *hg_handle,
 #ifdef HG_HAS_CHECKSUMS
             hg_header_hash = &hg_header->msg.output.hash;
 #endif
+            hg_header_comp = &hg_header->msg.output.comp;
 
             /* Get core output buffer */
             ret = HG_Core_get_output(
@@ -629,7 +732,12 @@ hg_set_struct(struct hg_private_handle *hg_handle,
                 rpc, error, ret, HG_INVALID_ARG, "Invalid HG op");
     }
     if (proc_cb == NULL || struct_ptr == NULL) {
-        /* Silently skip */
+        /* Silently skip, only encode an empty header so that no payload
+         * info left from a previous use of the handle is sent */
+        hg_header_reset(hg_header, op);
+        ret = hg_header_proc(HG_ENCODE, buf, buf_size, hg_header);
+        HG_CHECK_SUBSYS_HG_ERROR(rpc, error, ret, "Could not process header");
+
         *payload_size = header_offset;
         return HG_SUCCESS;
     }
@@ -645,19 +753,7 @@ hg_set_struct(struct hg_private_handle *hg_handle,
     ret = hg_proc_reset(proc, buf, buf_size, HG_ENCODE);
     HG_CHECK_SUBSYS_HG_ERROR(rpc, error, ret, "Could not reset proc");
 
-#ifdef NA_HAS_SM
-    /* Determine if we need special handling for SM */
-    if (HG_Core_addr_get_na_sm(hg_handle->handle.core_handle->info.addr) !=
-        NULL)
-        proc_flags |= HG_PROC_SM;
-#endif
-
-    /* Attempt to use eager bulk transfers when appropriate */
-    if (HG_HANDLE_CLASS(&hg_handle->handle)->bulk_eager &&
-        !HG_Core_addr_is_self(hg_handle->handle.core_handle->info.addr))
-        proc_flags |= HG_PROC_BULK_EAGER;
-
-    hg_proc_set_flags(proc, proc_flags);
+    hg_proc_set_flags(proc, hg_set_struct_flags(hg_handle));
 
     /* Encode parameters */
     ret = proc_cb(proc, struct_ptr);
@@ -677,6 +773,16 @@ hg_set_struct(struct hg_private_handle *hg_handle,
     }
 #endif
 
+#ifndef HG_HAS_XDR
+    /* Compress payload once it reaches the RPC compression threshold */
+    if (hg_proc_info->compress_threshold > 0 &&
+        hg_proc_get_size_used(proc) >= hg_proc_info->compress_threshold) {
+        ret = hg_set_struct_compress(
+            proc, buf, buf_size, hg_header_comp, &comp_buf, &comp_size);
+        HG_CHECK_SUBSYS_HG_ERROR(rpc, error, ret, "Could not compress payload");
+    }
+#endif
+
     /* The proc object may have allocated an extra buffer at this point.
      * If the payload did not fit into the original buffer, we need to send a
      * message with "more data" flag set along with the bulk data descriptor
@@ -690,12 +796,20 @@ hg_set_struct(struct hg_private_handle *hg_handle,
         HG_GOTO_SUBSYS_ERROR(rpc, error, ret, HG_OVERFLOW,
             "Arguments overflow is not supported with XDR");
 #endif
-        /* Create a bulk descriptor only of the size that is used */
-        *extra_buf = hg_proc_get_extra_buf(proc);
-        *extra_buf_size = hg_proc_get_size_used(proc);
-
-        /* Prevent buffer from being freed when proc_reset is called */
-        hg_proc_set_extra_buf_is_mine(proc, HG_TRUE);
+        if (comp_buf) {
+            /* Send compressed payload, proc_reset frees the original one */
+            *extra_buf = comp_buf;
+            *extra_buf_size = comp_size;
+            comp_buf = NULL;
+            comp_size = 0;
+        } else {
+            /* Create a bulk descriptor only of the size that is used */
+            *extra_buf = hg_proc_get_extra_buf(proc);
+            *extra_buf_size = hg_proc_get_size_used(proc);
+
+            /* Prevent buffer from being freed when proc_reset is called */
+            hg_proc_set_extra_buf_is_mine(proc, HG_TRUE);
+        }
 
         /* Create bulk descriptor */
         ret = HG_Bulk_create(hg_handle->handle.info.hg_class, 1, extra_buf,
@@ -708,21 +822,7 @@ hg_set_struct(struct hg_private_handle *hg_handle,
         HG_CHECK_SUBSYS_HG_ERROR(rpc, error, ret, "Could not reset proc");
 
         /* Reset proc flags */
-        proc_flags = 0;
-
-#ifdef NA_HAS_SM
-        /* Determine if we need special handling for SM */
-        if (HG_Core_addr_get_na_sm(hg_handle->handle.core_handle->info.addr) !=
-            NULL)
-            proc_flags |= HG_PROC_SM;
-#endif
-
-        /* Attempt to use eager bulk transfers when appropriate */
-        if (HG_HANDLE_CLASS(&hg_handle->handle)->bulk_eager &&
-            !HG_Core_addr_is_self(hg_handle->handle.core_handle->info.addr))
-            proc_flags |= HG_PROC_BULK_EAGER;
-
-        hg_proc_set_flags(proc, proc_flags);
+        hg_proc_set_flags(proc, hg_set_struct_flags(hg_handle));
 
         /* Encode extra_bulk_handle, we can do that safely here because
          * the user payload has been copied so we don't have to worry
@@ -738,7 +838,9 @@ hg_set_struct(struct hg_private_handle *hg_handle,
             HG_OVERFLOW, "Extra bulk handle could not fit into buffer");
 
         *more_data = HG_TRUE;
-    }
+    } else if (hg_header_comp->raw_size > 0)
+        /* Compressed payload fits into the eager buffer */
+        comp_size += header_offset;
 
     /* Encode header */
     buf = (char *) buf - header_offset;
@@ -751,15 +853,165 @@ hg_set_struct(struct hg_private_handle *hg_handle,
     *payload_size = buf_size;
 #else
     /* Only send the actual size of the data, not the entire buffer */
-    *payload_size = hg_proc_get_size_used(proc) + header_offset;
+    *payload_size = (comp_size > 0)
+                        ? comp_size
+                        : hg_proc_get_size_used(proc) + header_offset;
 #endif
 
     return HG_SUCCESS;
 
 error:
+    if (comp_buf)
+        hg_mem_aligned_free(comp_buf);
     return ret;
 }
 
+#ifndef HG_HAS_XDR
+/*---------------------------------------------------------------------------*/
+static hg_return_t
+hg_set_struct_compress(hg_proc_t proc, void *buf, hg_size_t buf_size,
+    struct hg_header_comp *hg_header_comp, void **comp_buf_p,
+    hg_size_t *comp_size_p)
+{
+    void *extra_buf = hg_proc_get_extra_buf(proc);
+    void *src = (extra_buf) ? extra_buf : buf;
+    hg_size_t src_size = hg_proc_get_size_used(proc);
+    void *tmp_buf = NULL;
+    size_t comp_size;
+    hg_return_t ret;
+
+    /* Header stores 32-bit sizes */
+    if (src_size > UINT32_MAX)
+        return HG_SUCCESS;
+
+    if (extra_buf) {
+        /* Overflow payload may now fit into the eager buffer, the eager
+         * buffer is no longer used by the proc at this point */
+        comp_size = hg_compress_lz(src, (size_t) src_size, buf,
+            (size_t) ((buf_size < src_size) ? buf_size : src_size - 1));
+        if (comp_size > 0) {
+            /* Release overflow buffer */
+            ret = hg_proc_reset(proc, buf, buf_size, HG_ENCODE);
+            HG_CHECK_SUBSYS_HG_ERROR(rpc, error, ret, "Could not reset proc");
+
+            hg_header_comp->raw_size = (hg_uint32_t) src_size;
+            *comp_size_p = (hg_size_t) comp_size;
+            return HG_SUCCESS;
+        }
+
+        /* Otherwise send a smaller overflow payload */
+        tmp_buf = hg_mem_aligned_alloc(
+            (size_t) hg_mem_get_page_size(), (size_t) src_size);
+    } else
+        tmp_buf = malloc((size_t) src_size);
+    HG_CHECK_SUBSYS_ERROR(rpc, tmp_buf == NULL, error, ret, HG_NOMEM,
+        "Could not allocate compression buffer");
+
+    comp_size = hg_compress_lz(
+        src, (size_t) src_size, tmp_buf, (size_t) src_size - 1);
+    if (comp_size > 0) {
+        hg_header_comp->raw_size = (hg_uint32_t) src_size;
+        *comp_size_p = (hg_size_t) comp_size;
+    }
+
+    if (extra_buf) {
+        if (comp_size > 0)
+            *comp_buf_p = tmp_buf;
+        else
+            hg_mem_aligned_free(tmp_buf);
+    } else {
+        if (comp_size > 0)
+            memcpy(buf, tmp_buf, comp_size);
+        free(tmp_buf);
+    }
+
+    return HG_SUCCESS;
+
+error:
+    return ret;
+}
+#endif
+
+/*---------------------------------------------------------------------------*/
+static hg_return_t
+hg_set_struct_shared(struct hg_private_handle *hg_handle,
+    struct hg_private_handle *hg_handle_src,
+    const struct hg_proc_info *hg_proc_info, hg_op_t op, void *struct_ptr,
+    hg_size_t *payload_size, hg_bool_t *more_data)
+{
+    void *buf, *buf_src;
+    hg_size_t buf_size, buf_src_size;
+    hg_return_t ret;
+
+    /* Extra payloads are bound to the handle and encoding may depend on the
+     * target addr, encode again if that is the case */
+    if (hg_handle_src == NULL || *more_data ||
+        hg_set_struct_flags(hg_handle) != hg_set_struct_flags(hg_handle_src))
+        return hg_set_struct(hg_handle, hg_proc_info, op, struct_ptr,
+            payload_size, more_data);
+
+    switch (op) {
+        case HG_INPUT:
+            ret = HG_Core_get_input(
+                hg_handle_src->handle.core_handle, &buf_src, &buf_src_size);
+            HG_CHECK_SUBSYS_HG_ERROR(
+                rpc, error, ret, "Could not get input buffer");
+
+            ret = HG_Core_get_input(
+                hg_handle->handle.core_handle, &buf, &buf_size);
+            HG_CHECK_SUBSYS_HG_ERROR(
+                rpc, error, ret, "Could not get input buffer");
+            break;
+        case HG_OUTPUT:
+            ret = HG_Core_get_output(
+                hg_handle_src->handle.core_handle, &buf_src, &buf_src_size);
+            HG_CHECK_SUBSYS_HG_ERROR(
+                rpc, error, ret, "Could not get output buffer");
+
+            ret = HG_Core_get_output(
+                hg_handle->handle.core_handle, &buf, &buf_size);
+            HG_CHECK_SUBSYS_HG_ERROR(
+                rpc, error, ret, "Could not get output buffer");
+            break;
+        default:
+            HG_GOTO_SUBSYS_ERROR(
+                rpc, error, ret, HG_INVALID_ARG, "Invalid HG op");
+    }
+    HG_CHECK_SUBSYS_ERROR(rpc, *payload_size > buf_size, error, ret,
+        HG_OVERFLOW,
+        "Encoded payload (%" PRIu64 ") exceeds buffer size (%" PRIu64 ")",
+        *payload_size, buf_size);
+
+    /* Header and payload are copied as is */
+    memcpy(buf, buf_src, (size_t) *payload_size);
+
+    return HG_SUCCESS;
+
+error:
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static hg_uint8_t
+hg_set_struct_flags(struct hg_private_handle *hg_handle)
+{
+    hg_uint8_t proc_flags = 0;
+
+#ifdef NA_HAS_SM
+    /* Determine if we need special handling for SM */
+    if (HG_Core_addr_get_na_sm(hg_handle->handle.core_handle->info.addr) !=
+        NULL)
+        proc_flags |= HG_PROC_SM;
+#endif
+
+    /* Attempt to use eager bulk transfers when appropriate */
+    if (HG_HANDLE_CLASS(&hg_handle->handle)->bulk_eager &&
+        !HG_Core_addr_is_self(hg_handle->handle.core_handle->info.addr))
+        proc_flags |= HG_PROC_BULK_EAGER;
+
+    return proc_flags;
+}
+
 /*---------------------------------------------------------------------------*/
 static hg_return_t
 hg_free_struct(struct hg_private_handle *hg_handle,
@@ -962,6 +1214,60 @@ hg_free_extra_payload(struct hg_private_handle *hg_handle)
     }
 }
 
+/*---------------------------------------------------------------------------*/
+static hg_return_t
+hg_forward(hg_handle_t handle, hg_cb_t callback, void *arg, void *in_struct,
+    unsigned int timeout_ms)
+{
+    struct hg_private_handle *private_handle =
+        (struct hg_private_handle *) handle;
+    const struct hg_proc_info *hg_proc_info = NULL;
+    hg_size_t payload_size = 0;
+    hg_bool_t more_data = HG_FALSE;
+    hg_uint8_t flags = 0;
+    hg_return_t ret;
+
+    HG_CHECK_SUBSYS_ERROR(rpc, handle == HG_HANDLE_NULL, error, ret,
+        HG_INVALID_ARG, "NULL HG handle");
+    HG_CHECK_SUBSYS_ERROR(rpc, handle->info.addr == HG_ADDR_NULL, error, ret,
+        HG_INVALID_ARG, "NULL target addr");
+
+    /* Set callback data */
+    private_handle->forward_cb = callback;
+    private_handle->forward_arg = arg;
+
+    /* Retrieve RPC data */
+    hg_proc_info =
+        (const struct hg_proc_info *) HG_Core_get_rpc_data(handle->core_handle);
+    HG_CHECK_SUBSYS_ERROR(rpc, hg_proc_info == NULL, error, ret, HG_FAULT,
+        "Could not get proc info");
+
+    /* Set input struct */
+    ret = hg_set_struct(private_handle, hg_proc_info, HG_INPUT, in_struct,
+        &payload_size, &more_data);
+    HG_CHECK_SUBSYS_HG_ERROR(
+        rpc, error, ret, "Could not set input (%s)", HG_Error_to_string(ret));
+
+    /* Set more data flag on handle so that handle_more_callback is triggered */
+    if (more_data)
+        flags |= HG_CORE_MORE_DATA;
+
+    /* Set no response flag if no response required */
+    if (hg_proc_info->no_response)
+        flags |= HG_CORE_NO_RESPONSE;
+
+    /* Send request */
+    ret = HG_Core_forward_timed(handle->core_handle, hg_core_forward_cb,
+        handle, flags, payload_size, timeout_ms);
+    HG_CHECK_SUBSYS_HG_ERROR(rpc, error, ret, "Could not forward call (%s)",
+        HG_Error_to_string(ret));
+
+    return HG_SUCCESS;
+
+error:
+    return ret;
+}
+
 /*---------------------------------------------------------------------------*/
 static HG_INLINE hg_return_t
 hg_core_forward_cb(const struct hg_core_cb_info *callback_info)
@@ -1143,6 +1449,13 @@ HG_Set_log_stream(const char *level, FILE *stream)
     }
 }
 
+/*---------------------------------------------------------------------------*/
+hg_return_t
+HG_Trace_dump(const char *file_base)
+{
+    return HG_Core_trace_dump(file_base);
+}
+
 /*---------------------------------------------------------------------------*/
 hg_return_t
 HG_Class_set_handle_create_callback(hg_class_t *hg_class,
@@ -1510,6 +1823,104 @@ error:
     return ret;
 }
 
+/*---------------------------------------------------------------------------*/
+hg_return_t
+HG_Registered_set_compression(
+    hg_class_t *hg_class, hg_id_t id, hg_size_t threshold)
+{
+    struct hg_proc_info *hg_proc_info = NULL;
+    hg_return_t ret;
+
+    HG_CHECK_SUBSYS_ERROR(
+        cls, hg_class == NULL, error, ret, HG_INVALID_ARG, "NULL HG class");
+#ifdef HG_HAS_XDR
+    HG_CHECK_SUBSYS_ERROR(cls, threshold > 0, error, ret, HG_OPNOTSUPPORTED,
+        "Compression is not supported with XDR");
+#endif
+
+    /* Retrieve proc function from function map */
+    hg_proc_info = (struct hg_proc_info *) HG_Core_registered_data(
+        hg_class->core_class, id);
+    HG_CHECK_SUBSYS_ERROR(cls, hg_proc_info == NULL, error, ret, HG_NOENTRY,
+        "Could not get registered data for RPC ID %" PRIu64, id);
+
+    hg_proc_info->compress_threshold = threshold;
+
+    return HG_SUCCESS;
+
+error:
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+hg_return_t
+HG_Registered_get_compression(
+    hg_class_t *hg_class, hg_id_t id, hg_size_t *threshold_p)
+{
+    struct hg_proc_info *hg_proc_info = NULL;
+    hg_return_t ret;
+
+    HG_CHECK_SUBSYS_ERROR(
+        cls, hg_class == NULL, error, ret, HG_INVALID_ARG, "NULL HG class");
+    HG_CHECK_SUBSYS_ERROR(cls, threshold_p == NULL, error, ret,
+        HG_INVALID_ARG, "NULL pointer to threshold");
+
+    /* Retrieve proc function from function map */
+    hg_proc_info = (struct hg_proc_info *) HG_Core_registered_data(
+        hg_class->core_class, id);
+    HG_CHECK_SUBSYS_ERROR(cls, hg_proc_info == NULL, error, ret, HG_NOENTRY,
+        "Could not get registered data for RPC ID %" PRIu64, id);
+
+    *threshold_p = hg_proc_info->compress_threshold;
+
+    return HG_SUCCESS;
+
+error:
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+hg_return_t
+HG_Registered_set_priority(
+    hg_class_t *hg_class, hg_id_t id, hg_priority_t priority)
+{
+    hg_return_t ret;
+
+    HG_CHECK_SUBSYS_ERROR(
+        cls, hg_class == NULL, error, ret, HG_INVALID_ARG, "NULL HG class");
+
+    ret = HG_Core_registered_set_priority(hg_class->core_class, id, priority);
+    HG_CHECK_SUBSYS_HG_ERROR(cls, error, ret,
+        "Could not set priority for RPC ID %" PRIu64 " (%s)", id,
+        HG_Error_to_string(ret));
+
+    return HG_SUCCESS;
+
+error:
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+hg_return_t
+HG_Registered_get_priority(
+    hg_class_t *hg_class, hg_id_t id, hg_priority_t *priority_p)
+{
+    hg_return_t ret;
+
+    HG_CHECK_SUBSYS_ERROR(
+        cls, hg_class == NULL, error, ret, HG_INVALID_ARG, "NULL HG class");
+
+    ret = HG_Core_registered_get_priority(hg_class->core_class, id, priority_p);
+    HG_CHECK_SUBSYS_HG_ERROR(cls, error, ret,
+        "Could not get priority for RPC ID %" PRIu64 " (%s)", id,
+        HG_Error_to_string(ret));
+
+    return HG_SUCCESS;
+
+error:
+    return ret;
+}
+
 /*---------------------------------------------------------------------------*/
 hg_return_t
 HG_Addr_lookup1(hg_context_t *context, hg_cb_t callback, void *arg,
@@ -1566,6 +1977,28 @@ error:
     return ret;
 }
 
+/*---------------------------------------------------------------------------*/
+hg_return_t
+HG_Addr_lookup_multi(hg_class_t *hg_class, const char *const *names,
+    hg_size_t count, hg_addr_t *addrs)
+{
+    hg_return_t ret;
+
+    HG_CHECK_SUBSYS_ERROR(
+        addr, hg_class == NULL, error, ret, HG_INVALID_ARG, "NULL HG class");
+
+    ret = HG_Core_addr_lookup_multi(
+        hg_class->core_class, names, count, (hg_core_addr_t *) addrs);
+    HG_CHECK_SUBSYS_HG_ERROR(addr, error, ret,
+        "Could not lookup %" PRIu64 " addresses (%s)", count,
+        HG_Error_to_string(ret));
+
+    return HG_SUCCESS;
+
+error:
+    return ret;
+}
+
 /*---------------------------------------------------------------------------*/
 hg_return_t
 HG_Addr_free(hg_class_t *hg_class, hg_addr_t addr)
@@ -2013,11 +2446,242 @@ error:
 hg_return_t
 HG_Forward(hg_handle_t handle, hg_cb_t callback, void *arg, void *in_struct)
 {
-    struct hg_private_handle *private_handle =
-        (struct hg_private_handle *) handle;
+    return hg_forward(handle, callback, arg, in_struct, 0);
+}
+
+/*---------------------------------------------------------------------------*/
+hg_return_t
+HG_Forward_timed(hg_handle_t handle, hg_cb_t callback, void *arg,
+    void *in_struct, unsigned int timeout_ms)
+{
+    return hg_forward(handle, callback, arg, in_struct, timeout_ms);
+}
+
+/*---------------------------------------------------------------------------*/
+hg_return_t
+HG_Forward_multi(hg_handle_t *handles, unsigned int count, hg_cb_t callback,
+    void *arg, void *in_struct)
+{
+    struct hg_private_handle *hg_handle_src = NULL;
     const struct hg_proc_info *hg_proc_info = NULL;
     hg_size_t payload_size = 0;
     hg_bool_t more_data = HG_FALSE;
+    unsigned int i;
+    hg_return_t ret;
+
+    HG_CHECK_SUBSYS_ERROR(rpc, handles == NULL || count == 0, error, ret,
+        HG_INVALID_ARG, "NULL array of HG handles");
+
+    for (i = 0; i < count; i++) {
+        struct hg_private_handle *private_handle =
+            (struct hg_private_handle *) handles[i];
+        hg_size_t handle_payload_size = payload_size;
+        hg_bool_t handle_more_data = more_data;
+        hg_uint8_t flags = 0;
+
+        HG_CHECK_SUBSYS_ERROR(rpc, handles[i] == HG_HANDLE_NULL, error, ret,
+            HG_INVALID_ARG, "NULL HG handle");
+        HG_CHECK_SUBSYS_ERROR(rpc, handles[i]->info.addr == HG_ADDR_NULL,
+            error, ret, HG_INVALID_ARG, "NULL target addr");
+
+        /* Input is shared so all handles must refer to the same RPC */
+        if (hg_proc_info == NULL) {
+            hg_proc_info = (const struct hg_proc_info *) HG_Core_get_rpc_data(
+                handles[i]->core_handle);
+            HG_CHECK_SUBSYS_ERROR(rpc, hg_proc_info == NULL, error, ret,
+                HG_FAULT, "Could not get proc info");
+        } else
+            HG_CHECK_SUBSYS_ERROR(rpc,
+                HG_Core_get_rpc_data(handles[i]->core_handle) != hg_proc_info,
+                error, ret, HG_INVALID_ARG,
+                "Handles must be created for the same RPC");
+
+        /* Set callback data */
+        private_handle->forward_cb = callback;
+        private_handle->forward_arg = arg;
+
+        /* Set input struct, input is only serialized once when possible */
+        ret = hg_set_struct_shared(private_handle, hg_handle_src, hg_proc_info,
+            HG_INPUT, in_struct, &handle_payload_size, &handle_more_data);
+        HG_CHECK_SUBSYS_HG_ERROR(rpc, error, ret, "Could not set input (%s)",
+            HG_Error_to_string(ret));
+        if (hg_handle_src == NULL) {
+            hg_handle_src = private_handle;
+            payload_size = handle_payload_size;
+            more_data = handle_more_data;
+        }
+
+        /* Set more data flag on handle so that handle_more_callback is
+         * triggered */
+        if (handle_more_data)
+            flags |= HG_CORE_MORE_DATA;
+
+        /* Set no response flag if no response required */
+        if (hg_proc_info->no_response)
+            flags |= HG_CORE_NO_RESPONSE;
+
+        /* Send request */
+        ret = HG_Core_forward(handles[i]->core_handle, hg_core_forward_cb,
+            handles[i], flags, handle_payload_size);
+        HG_CHECK_SUBSYS_HG_ERROR(rpc, error, ret,
+            "Could not forward call (%s)", HG_Error_to_string(ret));
+    }
+
+    return HG_SUCCESS;
+
+error:
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+hg_return_t
+HG_Payload_create(
+    hg_class_t *hg_class, hg_id_t id, void *in_struct, hg_payload_t *payload_p)
+{
+    struct hg_private_class *private_class =
+        (struct hg_private_class *) hg_class;
+    const struct hg_proc_info *hg_proc_info;
+    struct hg_payload *hg_payload = NULL;
+    struct hg_header hg_header;
+    hg_proc_t proc = HG_PROC_NULL;
+    hg_size_t header_offset = hg_header_get_size(HG_INPUT), buf_size;
+    void *buf;
+    hg_return_t ret;
+
+    HG_CHECK_SUBSYS_ERROR(
+        rpc, hg_class == NULL, error, ret, HG_INVALID_ARG, "NULL HG class");
+    HG_CHECK_SUBSYS_ERROR(rpc, payload_p == NULL, error, ret, HG_INVALID_ARG,
+        "NULL pointer to payload");
+
+    hg_header_init(&hg_header, HG_INPUT);
+
+    /* Retrieve proc function from function map */
+    hg_proc_info = (const struct hg_proc_info *) HG_Core_registered_data(
+        hg_class->core_class, id);
+    HG_CHECK_SUBSYS_ERROR(rpc, hg_proc_info == NULL, error, ret, HG_NOENTRY,
+        "Could not get registered data for RPC ID %" PRIu64, id);
+
+    hg_payload = (struct hg_payload *) calloc(1, sizeof(*hg_payload));
+    HG_CHECK_SUBSYS_ERROR(rpc, hg_payload == NULL, error, ret, HG_NOMEM,
+        "Could not allocate payload");
+    hg_payload->id = id;
+    hg_payload->no_response = hg_proc_info->no_response;
+
+    ret = HG_Core_payload_create(
+        hg_class->core_class, &hg_payload->core_payload);
+    HG_CHECK_SUBSYS_HG_ERROR(rpc, error, ret, "Could not create core payload");
+
+    ret = HG_Core_payload_get_buf(hg_payload->core_payload, &buf, &buf_size);
+    HG_CHECK_SUBSYS_HG_ERROR(rpc, error, ret, "Could not get payload buffer");
+
+    /* Use custom header offset */
+    header_offset += hg_class->in_offset;
+    hg_payload->payload_size = header_offset;
+    if (hg_proc_info->in_proc_cb == NULL || in_struct == NULL) {
+        /* Silently skip, only encode an empty header */
+        ret = hg_header_proc(HG_ENCODE, buf, buf_size, &hg_header);
+        HG_CHECK_SUBSYS_HG_ERROR(rpc, error, ret, "Could not process header");
+
+        *payload_p = hg_payload;
+        return HG_SUCCESS;
+    }
+
+    ret = hg_proc_create(hg_class,
+        (private_class->checksum_level > HG_CHECKSUM_RPC_HEADERS) ? HG_CRC32
+                                                                   : HG_NOHASH,
+        &proc);
+    HG_CHECK_SUBSYS_HG_ERROR(rpc, error, ret, "Cannot create HG proc");
+
+    ret = hg_proc_reset(proc, (char *) buf + header_offset,
+        buf_size - header_offset, HG_ENCODE);
+    HG_CHECK_SUBSYS_HG_ERROR(rpc, error, ret, "Could not reset proc");
+
+    /* Payload is encoded for remote targets */
+    if (private_class->bulk_eager)
+        hg_payload->proc_flags |= HG_PROC_BULK_EAGER;
+    hg_proc_set_flags(proc, hg_payload->proc_flags);
+
+    /* Encode parameters */
+    ret = hg_proc_info->in_proc_cb(proc, in_struct);
+    HG_CHECK_SUBSYS_HG_ERROR(rpc, error, ret, "Could not encode parameters");
+
+    /* Flush proc */
+    ret = hg_proc_flush(proc);
+    HG_CHECK_SUBSYS_HG_ERROR(rpc, error, ret, "Error in proc flush");
+
+    /* Extra payloads are bound to a handle and cannot be shared */
+    HG_CHECK_SUBSYS_ERROR(rpc, hg_proc_get_extra_buf(proc) != NULL, error,
+        ret, HG_OVERFLOW, "Payload does not fit into eager buffer");
+
+#ifdef HG_HAS_CHECKSUMS
+    /* Set checksum in header */
+    if (private_class->checksum_level > HG_CHECKSUM_RPC_HEADERS) {
+        ret = hg_proc_checksum_get(proc, &hg_header.msg.input.hash.payload,
+            sizeof(hg_header.msg.input.hash.payload));
+        HG_CHECK_SUBSYS_HG_ERROR(
+            rpc, error, ret, "Error in getting proc checksum");
+    }
+#endif
+
+    /* Encode header */
+    ret = hg_header_proc(HG_ENCODE, buf, buf_size, &hg_header);
+    HG_CHECK_SUBSYS_HG_ERROR(rpc, error, ret, "Could not process header");
+
+#ifdef HG_HAS_XDR
+    /* XDR requires entire buffer payload */
+    hg_payload->payload_size = buf_size;
+#else
+    /* Only send the actual size of the data, not the entire buffer */
+    hg_payload->payload_size = hg_proc_get_size_used(proc) + header_offset;
+#endif
+
+    hg_proc_free(proc);
+    hg_header_finalize(&hg_header);
+
+    *payload_p = hg_payload;
+
+    return HG_SUCCESS;
+
+error:
+    if (proc != HG_PROC_NULL)
+        hg_proc_free(proc);
+    if (hg_payload != NULL) {
+        (void) HG_Core_payload_destroy(hg_payload->core_payload);
+        free(hg_payload);
+    }
+    hg_header_finalize(&hg_header);
+
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+hg_return_t
+HG_Payload_destroy(hg_payload_t payload)
+{
+    hg_return_t ret;
+
+    if (payload == NULL)
+        return HG_SUCCESS;
+
+    /* Core payload remains until all handles using it have completed */
+    ret = HG_Core_payload_destroy(payload->core_payload);
+    HG_CHECK_SUBSYS_HG_ERROR(rpc, error, ret, "Could not destroy core payload");
+
+    free(payload);
+
+    return HG_SUCCESS;
+
+error:
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+hg_return_t
+HG_Forward_payload(
+    hg_handle_t handle, hg_cb_t callback, void *arg, hg_payload_t payload)
+{
+    struct hg_private_handle *private_handle =
+        (struct hg_private_handle *) handle;
     hg_uint8_t flags = 0;
     hg_return_t ret;
 
@@ -2025,34 +2689,30 @@ HG_Forward(hg_handle_t handle, hg_cb_t callback, void *arg, void *in_struct)
         HG_INVALID_ARG, "NULL HG handle");
     HG_CHECK_SUBSYS_ERROR(rpc, handle->info.addr == HG_ADDR_NULL, error, ret,
         HG_INVALID_ARG, "NULL target addr");
+    HG_CHECK_SUBSYS_ERROR(rpc, payload == NULL, error, ret, HG_INVALID_ARG,
+        "NULL payload");
+    HG_CHECK_SUBSYS_ERROR(rpc, handle->info.id != payload->id, error, ret,
+        HG_INVALID_ARG,
+        "Payload RPC ID (%" PRIu64 ") does not match handle RPC ID (%" PRIu64
+        ")",
+        payload->id, handle->info.id);
+
+    /* Encoding of some types (e.g., bulk handles) depends on the target */
+    HG_CHECK_SUBSYS_ERROR(rpc,
+        hg_set_struct_flags(private_handle) != payload->proc_flags, error, ret,
+        HG_OPNOTSUPPORTED, "Payload was not encoded for that type of target");
 
     /* Set callback data */
     private_handle->forward_cb = callback;
     private_handle->forward_arg = arg;
 
-    /* Retrieve RPC data */
-    hg_proc_info =
-        (const struct hg_proc_info *) HG_Core_get_rpc_data(handle->core_handle);
-    HG_CHECK_SUBSYS_ERROR(rpc, hg_proc_info == NULL, error, ret, HG_FAULT,
-        "Could not get proc info");
-
-    /* Set input struct */
-    ret = hg_set_struct(private_handle, hg_proc_info, HG_INPUT, in_struct,
-        &payload_size, &more_data);
-    HG_CHECK_SUBSYS_HG_ERROR(
-        rpc, error, ret, "Could not set input (%s)", HG_Error_to_string(ret));
-
-    /* Set more data flag on handle so that handle_more_callback is triggered */
-    if (more_data)
-        flags |= HG_CORE_MORE_DATA;
-
     /* Set no response flag if no response required */
-    if (hg_proc_info->no_response)
+    if (payload->no_response)
         flags |= HG_CORE_NO_RESPONSE;
 
     /* Send request */
-    ret = HG_Core_forward(
-        handle->core_handle, hg_core_forward_cb, handle, flags, payload_size);
+    ret = HG_Core_forward_payload(handle->core_handle, hg_core_forward_cb,
+        handle, flags, payload->core_payload, payload->payload_size);
     HG_CHECK_SUBSYS_HG_ERROR(rpc, error, ret, "Could not forward call (%s)",
         HG_Error_to_string(ret));
 
@@ -2109,6 +2769,76 @@ error:
     return ret;
 }
 
+/*---------------------------------------------------------------------------*/
+hg_return_t
+HG_Respond_multi(hg_handle_t *handles, unsigned int count, hg_cb_t callback,
+    void *arg, void *out_struct)
+{
+    struct hg_private_handle *hg_handle_src = NULL;
+    const struct hg_proc_info *hg_proc_info = NULL;
+    hg_size_t payload_size = 0;
+    hg_bool_t more_data = HG_FALSE;
+    unsigned int i;
+    hg_return_t ret;
+
+    HG_CHECK_SUBSYS_ERROR(rpc, handles == NULL || count == 0, error, ret,
+        HG_INVALID_ARG, "NULL array of HG handles");
+
+    for (i = 0; i < count; i++) {
+        struct hg_private_handle *private_handle =
+            (struct hg_private_handle *) handles[i];
+        hg_size_t handle_payload_size = payload_size;
+        hg_bool_t handle_more_data = more_data;
+        hg_uint8_t flags = 0;
+
+        HG_CHECK_SUBSYS_ERROR(rpc, handles[i] == HG_HANDLE_NULL, error, ret,
+            HG_INVALID_ARG, "NULL HG handle");
+
+        /* Output is shared so all handles must refer to the same RPC */
+        if (hg_proc_info == NULL) {
+            hg_proc_info = (const struct hg_proc_info *) HG_Core_get_rpc_data(
+                handles[i]->core_handle);
+            HG_CHECK_SUBSYS_ERROR(rpc, hg_proc_info == NULL, error, ret,
+                HG_FAULT, "Could not get proc info");
+        } else
+            HG_CHECK_SUBSYS_ERROR(rpc,
+                HG_Core_get_rpc_data(handles[i]->core_handle) != hg_proc_info,
+                error, ret, HG_INVALID_ARG,
+                "Handles must refer to the same RPC");
+
+        /* Set callback data */
+        private_handle->respond_cb = callback;
+        private_handle->respond_arg = arg;
+
+        /* Set output struct, output is only serialized once when possible */
+        ret = hg_set_struct_shared(private_handle, hg_handle_src, hg_proc_info,
+            HG_OUTPUT, out_struct, &handle_payload_size, &handle_more_data);
+        HG_CHECK_SUBSYS_HG_ERROR(rpc, error, ret, "Could not set output (%s)",
+            HG_Error_to_string(ret));
+        if (hg_handle_src == NULL) {
+            hg_handle_src = private_handle;
+            payload_size = handle_payload_size;
+            more_data = handle_more_data;
+        }
+
+        /* Set more data flag on handle so that handle_more_callback is
+         * triggered */
+        if (handle_more_data)
+            flags |= HG_CORE_MORE_DATA;
+
+        /* Send response back */
+        ret = HG_Core_respond(handles[i]->core_handle, hg_core_respond_cb,
+            handles[i], flags, handle_payload_size);
+        HG_CHECK_SUBSYS_HG_ERROR(
+            rpc, error, ret, "Could not respond (%s)", HG_Error_to_string(ret));
+    }
+
+    return HG_SUCCESS;
+
+error:
+    return ret;
+}
+
 /*---------------------------------------------------------------------------*/
 hg_return_t
 HG_Progress(hg_context_t *context, unsigned int timeout)
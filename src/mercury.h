@@ -147,6 +147,18 @@ HG_Set_log_func(int (*log_func)(FILE *stream, const char *format, ...));
 HG_PUBLIC void
 HG_Set_log_stream(const char *level, FILE *stream);
 
+/**
+ * Dump RPC and bulk lifecycle trace events in Chrome trace-event JSON format
+ * to "file_base-pid.json". Events are only recorded while the "trace" log
+ * sub-system is active (see HG_Set_log_subsys()).
+ *
+ * \param file_base [IN]        output file basename
+ *
+ * \return HG_SUCCESS or corresponding HG error code
+ */
+HG_PUBLIC hg_return_t
+HG_Trace_dump(const char *file_base);
+
 /**
  * Obtain the name of the given class.
  *
@@ -509,6 +521,72 @@ HG_PUBLIC hg_return_t
 HG_Registered_disabled_response(
     hg_class_t *hg_class, hg_id_t id, hg_bool_t *disabled_p);
 
+/**
+ * Compress input and output payloads of a given RPC ID that this process sends
+ * once their encoded size reaches threshold bytes, using the built-in LZ codec.
+ * Compressed payloads are flagged in the RPC header and decompressed by the
+ * receiver, which does not need to enable compression. Payloads that do not
+ * shrink are sent uncompressed. Compression applies both to payloads that fit
+ * into the eager buffer and to payloads that overflow into an extra buffer,
+ * which may then fit into the eager buffer and save a bulk transfer. By
+ * default, compression is disabled. Not supported with XDR encoding.
+ *
+ * \param hg_class [IN]         pointer to HG class
+ * \param id [IN]               registered function ID
+ * \param threshold [IN]        minimum encoded size to compress (0 to disable)
+ *
+ * \return HG_SUCCESS or corresponding HG error code
+ */
+HG_PUBLIC hg_return_t
+HG_Registered_set_compression(
+    hg_class_t *hg_class, hg_id_t id, hg_size_t threshold);
+
+/**
+ * Get the compression threshold of a given RPC ID
+ * (see HG_Registered_set_compression()).
+ *
+ * \param hg_class [IN]         pointer to HG class
+ * \param id [IN]               registered function ID
+ * \param threshold_p [OUT]     compression threshold (0 if disabled)
+ *
+ * \return HG_SUCCESS or corresponding HG error code
+ */
+HG_PUBLIC hg_return_t
+HG_Registered_get_compression(
+    hg_class_t *hg_class, hg_id_t id, hg_size_t *threshold_p);
+
+/**
+ * Set the priority class of a given RPC ID. Completions (forward, respond and
+ * incoming requests) of RPCs that belong to a higher priority class are
+ * triggered by HG_Trigger() before completions of lower priority classes, so
+ * that latency-sensitive RPCs do not queue behind bulk traffic. The scheduling
+ * policy between classes is controlled through hg_init_info. By default, all
+ * RPCs belong to the HG_PRIORITY_DEFAULT class and bulk transfer completions
+ * are always triggered as HG_PRIORITY_DEFAULT.
+ *
+ * \param hg_class [IN]         pointer to HG class
+ * \param id [IN]               registered function ID
+ * \param priority [IN]         priority class
+ *
+ * \return HG_SUCCESS or corresponding HG error code
+ */
+HG_PUBLIC hg_return_t
+HG_Registered_set_priority(
+    hg_class_t *hg_class, hg_id_t id, hg_priority_t priority);
+
+/**
+ * Retrieve the priority class of a given RPC ID.
+ *
+ * \param hg_class [IN]         pointer to HG class
+ * \param id [IN]               registered function ID
+ * \param priority_p [OUT]      pointer to priority class
+ *
+ * \return HG_SUCCESS or corresponding HG error code
+ */
+HG_PUBLIC hg_return_t
+HG_Registered_get_priority(
+    hg_class_t *hg_class, hg_id_t id, hg_priority_t *priority_p);
+
 /**
  * Lookup an addr from a peer address/name. Addresses need to be
  * freed by calling HG_Addr_free(). After completion, user callback is
@@ -546,6 +624,24 @@ HG_Addr_lookup1(hg_context_t *context, hg_cb_t callback, void *arg,
 HG_PUBLIC hg_return_t
 HG_Addr_lookup2(hg_class_t *hg_class, const char *name, hg_addr_t *addr_p);
 
+/**
+ * Lookup an array of addrs from peer addresses/names. Names that resolve to
+ * the same NA class are looked up at once, which is preferred to individual
+ * lookups when connecting to a large number of peers. Either all or none of
+ * the addresses are returned. Addresses need to be freed by calling
+ * HG_Addr_free().
+ *
+ * \param hg_class [IN/OUT]     pointer to HG class
+ * \param names [IN]            array of lookup names
+ * \param count [IN]            number of names
+ * \param addrs [OUT]           array of abstract addresses
+ *
+ * \return HG_SUCCESS or corresponding HG error code
+ */
+HG_PUBLIC hg_return_t
+HG_Addr_lookup_multi(hg_class_t *hg_class, const char *const *names,
+    hg_size_t count, hg_addr_t *addrs);
+
 /**
  * Free the addr.
  *
@@ -894,6 +990,20 @@ HG_Get_output_extra_buf(
 static HG_INLINE hg_return_t
 HG_Set_target_id(hg_handle_t handle, hg_uint8_t id);
 
+/**
+ * Mark handle as persistent, for repeated forwards of the same RPC to the
+ * same target (e.g., heartbeats). See HG_Core_set_persistent().
+ *
+ * \remark Persistent mode is cleared by HG_Reset().
+ *
+ * \param handle [IN]           HG handle
+ * \param persistent [IN]       enable / disable persistent mode
+ *
+ * \return HG_SUCCESS or corresponding HG error code
+ */
+static HG_INLINE hg_return_t
+HG_Set_persistent(hg_handle_t handle, hg_bool_t persistent);
+
 /**
  * Forward a call to a local/remote target using an existing HG handle.
  * Input structure can be passed and parameters serialized using a previously
@@ -916,6 +1026,96 @@ HG_Set_target_id(hg_handle_t handle, hg_uint8_t id);
 HG_PUBLIC hg_return_t
 HG_Forward(hg_handle_t handle, hg_cb_t callback, void *arg, void *in_struct);
 
+/**
+ * Same as HG_Forward() but cancel the RPC if it has not completed within
+ * \timeout_ms ms, in which case HG_TIMEOUT is returned to the user callback
+ * through the hg_cb_info ret field. Deadlines are tracked by a timer wheel on
+ * the handle's context and are only checked while making progress on that
+ * context. Forwarding to self ignores the timeout.
+ *
+ * \param handle [IN]           HG handle
+ * \param callback [IN]         pointer to function callback
+ * \param arg [IN]              pointer to data passed to callback
+ * \param in_struct [IN]        pointer to input structure
+ * \param timeout_ms [IN]       timeout (in milliseconds), 0 for no timeout
+ *
+ * \return HG_SUCCESS or corresponding HG error code
+ */
+HG_PUBLIC hg_return_t
+HG_Forward_timed(hg_handle_t handle, hg_cb_t callback, void *arg,
+    void *in_struct, unsigned int timeout_ms);
+
+/**
+ * Forward the same call to multiple targets using an array of existing HG
+ * handles, typically created for different addresses. The input structure is
+ * only serialized once and the encoded payload is then copied to the other
+ * handles (handles that require a different encoding, e.g., shared-memory
+ * targets or payloads that do not fit into the eager buffer, are serialized
+ * separately). All handles must have been created for the same RPC ID.
+ * \callback is triggered once for each handle with its own handle passed in
+ * the hg_cb_info forward field.
+ *
+ * \remark If an error is returned, handles that precede the failing handle
+ * have been forwarded and their callback will still be triggered.
+ *
+ * \param handles [IN]          array of HG handles
+ * \param count [IN]            number of handles
+ * \param callback [IN]         pointer to function callback
+ * \param arg [IN]              pointer to data passed to callback
+ * \param in_struct [IN]        pointer to input structure
+ *
+ * \return HG_SUCCESS or corresponding HG error code
+ */
+HG_PUBLIC hg_return_t
+HG_Forward_multi(hg_handle_t *handles, unsigned int count, hg_cb_t callback,
+    void *arg, void *in_struct);
+
+/**
+ * Serialize input structure once using the input proc registered for RPC \id
+ * so that it can be forwarded by any number of handles using
+ * HG_Forward_payload(). The encoded payload must fit into the eager buffer
+ * (HG_OVERFLOW is returned otherwise) and is encoded for remote targets
+ * (not shared-memory or self).
+ *
+ * \param hg_class [IN]         pointer to HG class
+ * \param id [IN]               registered function ID
+ * \param in_struct [IN]        pointer to input structure
+ * \param payload_p [OUT]       pointer to payload
+ *
+ * \return HG_SUCCESS or corresponding HG error code
+ */
+HG_PUBLIC hg_return_t
+HG_Payload_create(
+    hg_class_t *hg_class, hg_id_t id, void *in_struct, hg_payload_t *payload_p);
+
+/**
+ * Destroy payload. Can be called while RPCs using that payload are still in
+ * flight, the payload is released once they complete.
+ *
+ * \param payload [IN/OUT]      payload
+ *
+ * \return HG_SUCCESS or corresponding HG error code
+ */
+HG_PUBLIC hg_return_t
+HG_Payload_destroy(hg_payload_t payload);
+
+/**
+ * Forward a call using a payload previously encoded with HG_Payload_create().
+ * Handles forwarded with the same payload send from the same registered buffer
+ * without re-encoding or copying the input. Handle must have been created for
+ * the RPC ID that was used to create the payload.
+ *
+ * \param handle [IN]           HG handle
+ * \param callback [IN]         pointer to function callback
+ * \param arg [IN]              pointer to data passed to callback
+ * \param payload [IN]          pre-encoded payload
+ *
+ * \return HG_SUCCESS or corresponding HG error code
+ */
+HG_PUBLIC hg_return_t
+HG_Forward_payload(
+    hg_handle_t handle, hg_cb_t callback, void *arg, hg_payload_t payload);
+
 /**
  * Respond back to origin using an existing HG handle.
  * Output structure can be passed and parameters serialized using a previously
@@ -937,6 +1137,23 @@ HG_Forward(hg_handle_t handle, hg_cb_t callback, void *arg, void *in_struct);
 HG_PUBLIC hg_return_t
 HG_Respond(hg_handle_t handle, hg_cb_t callback, void *arg, void *out_struct);
 
+/**
+ * Respond with the same output to multiple origins using an array of existing
+ * HG handles. The output structure is only serialized once, see
+ * HG_Forward_multi() for details. \callback is triggered once for each handle.
+ *
+ * \param handles [IN]          array of HG handles
+ * \param count [IN]            number of handles
+ * \param callback [IN]         pointer to function callback
+ * \param arg [IN]              pointer to data passed to callback
+ * \param out_struct [IN]       pointer to output structure
+ *
+ * \return HG_SUCCESS or corresponding HG error code
+ */
+HG_PUBLIC hg_return_t
+HG_Respond_multi(hg_handle_t *handles, unsigned int count, hg_cb_t callback,
+    void *arg, void *out_struct);
+
 /**
  * Try to progress RPC execution for at most timeout until timeout is reached or
  * any completion has occurred.
@@ -1161,6 +1378,13 @@ HG_Set_target_id(hg_handle_t handle, hg_uint8_t id)
     return HG_Core_set_target_id(handle->core_handle, id);
 }
 
+/*---------------------------------------------------------------------------*/
+static HG_INLINE hg_return_t
+HG_Set_persistent(hg_handle_t handle, hg_bool_t persistent)
+{
+    return HG_Core_set_persistent(handle->core_handle, persistent);
+}
+
 #ifdef __cplusplus
 }
 #endif
@@ -12,7 +12,9 @@
 #include "mercury_private.h"
 
 #include "mercury_atomic.h"
+#include "mercury_checksum.h"
 #include "mercury_list.h"
+#include "mercury_mem.h"
 #include "mercury_thread_condition.h"
 #include "mercury_thread_spin.h"
 
@@ -32,6 +34,16 @@
 #define HG_BULK_REGV  (1 << 6) /* single registration for multiple segments */
 #define HG_BULK_VIRT  (1 << 7) /* addresses are virtual */
 
+/* Extended bulk flags */
+#define HG_BULK_DIGEST (1 << 0) /* expected digest follows descriptor */
+#define HG_BULK_OFFSET (1 << 1) /* NA handle offset follows descriptor */
+
+/* Smallest bulk buffer carved out of the slab (log2) */
+#define HG_BULK_SLAB_MIN_SHIFT (12)
+
+/* Number of slab size classes (powers of two from the smallest size) */
+#define HG_BULK_SLAB_CLASS_MAX (40)
+
 /* Op ID status bits */
 #define HG_BULK_OP_COMPLETED (1 << 0)
 #define HG_BULK_OP_CANCELED  (1 << 1)
@@ -94,6 +106,10 @@
     ((x)->op_count > HG_BULK_STATIC_MAX) ? (x)->na_sm_op_ids.d                 \
                                          : (x)->na_sm_op_ids.s
 
+#define HG_BULK_NA_OP_RANGES(x)                                                \
+    ((x)->op_count > HG_BULK_STATIC_MAX) ? (x)->na_op_ranges.d                 \
+                                         : (x)->na_op_ranges.s
+
 /* Check permission flags */
 #define HG_BULK_CHECK_FLAGS(op, origin_flags, local_flags, label, ret)         \
     switch (op) {                                                              \
@@ -179,8 +195,45 @@ struct hg_bulk {
     void *serialize_ptr;         /* Cached serialization buffer */
     hg_size_t serialize_size;    /* Cached serialization size */
     hg_atomic_int32_t ref_count; /* Reference count */
+    hg_size_t na_offset;         /* Offset of data in NA memory handle */
+    hg_uint32_t digest;          /* Expected CRC32C of data (if set) */
     hg_uint8_t context_id;       /* Context ID (valid if bound to handle) */
     hg_bool_t registered;        /* Handle was registered */
+    hg_bool_t slab;              /* Handle uses slab registration */
+    hg_bool_t checksum;          /* Checksum data transferred */
+};
+
+/* Buffer carved out of the slab. Each buffer is registered on its own, once
+ * per access mode, the first time that a handle is created over it, so that
+ * remote peers can only access that buffer with the handle's access flags.
+ * Registrations are kept when the buffer is freed and reused. */
+struct hg_bulk_slab_buf {
+    na_mem_handle_t *na_mem_handles[HG_BULK_READWRITE]; /* Per access mode */
+    size_t na_serialize_sizes[HG_BULK_READWRITE];       /* Serialize sizes */
+#ifdef NA_HAS_SM
+    na_mem_handle_t *na_sm_mem_handles[HG_BULK_READWRITE]; /* SM handles */
+    size_t na_sm_serialize_sizes[HG_BULK_READWRITE];       /* SM sizes */
+#endif
+    struct hg_bulk_slab_buf *next; /* Next free buffer of same class */
+    char *base;                    /* Buffer address */
+    hg_size_t size;                /* Buffer size */
+    unsigned int size_class;       /* Size class */
+};
+
+/* Slab that bulk buffers are carved from. Buffers are rounded up to a power
+ * of two and freed buffers are kept per size class. */
+struct hg_bulk_slab {
+    struct hg_bulk_slab_buf *free_lists[HG_BULK_SLAB_CLASS_MAX]; /* Free */
+    struct hg_bulk_slab_buf **bufs; /* Buffer that each page belongs to */
+    char *base;                     /* Base address */
+    na_class_t *na_class;           /* NA class */
+#ifdef NA_HAS_SM
+    na_class_t *na_sm_class; /* NA SM class */
+#endif
+    hg_size_t size;        /* Slab size */
+    hg_size_t used;        /* Size carved out so far */
+    hg_thread_spin_t lock; /* Allocation lock */
+    hg_bool_t huge;        /* Slab uses huge pages */
 };
 
 /* HG bulk NA op IDs (not a union as we re-use op IDs) */
@@ -189,6 +242,21 @@ typedef struct {
     na_op_id_t **d;                    /* Dynamic array */
 } hg_bulk_na_op_id_t;
 
+/* Local data moved by a NA operation (used to checksum data) */
+struct hg_bulk_na_op_range {
+    struct hg_bulk_op_id *hg_bulk_op_id; /* Parent op ID */
+    hg_size_t segment_offset;            /* Offset in first local segment */
+    hg_size_t len;                       /* Size of data */
+    hg_size_t trailing_len;              /* Size of data that follows */
+    hg_uint32_t segment_index;           /* First local segment */
+};
+
+/* HG bulk NA op ranges */
+typedef struct {
+    struct hg_bulk_na_op_range s[HG_BULK_STATIC_MAX]; /* Static array */
+    struct hg_bulk_na_op_range *d;                    /* Dynamic array */
+} hg_bulk_na_op_range_t;
+
 /* HG Bulk op ID */
 struct hg_bulk_op_id {
     struct hg_completion_entry
@@ -201,6 +269,7 @@ struct hg_bulk_op_id {
 #ifdef NA_HAS_SM
     hg_bulk_na_op_id_t na_sm_op_ids; /* NA SM operations IDs */
 #endif
+    hg_bulk_na_op_range_t na_op_ranges;   /* NA operations local data */
     hg_core_context_t *core_context;      /* Context */
     na_class_t *na_class;                 /* NA class */
     na_context_t *na_context;             /* NA context */
@@ -208,7 +277,11 @@ struct hg_bulk_op_id {
     hg_atomic_int32_t ret_status;         /* Return status */
     hg_atomic_int32_t op_completed_count; /* Number of operations completed */
     hg_atomic_int32_t ref_count;          /* Refcount */
+    hg_atomic_int32_t checksum;           /* CRC32C of local data */
+    hg_uint64_t trace_id;                 /* Lifecycle trace ID */
     hg_uint32_t op_count;                 /* Number of ongoing operations */
+    hg_bool_t checksum_enabled;           /* Checksum local data */
+    hg_bool_t checksum_verify;            /* Verify against origin digest */
     hg_bool_t reuse;                      /* Re-use op ID once ref_count is 0 */
 };
 
@@ -247,6 +320,39 @@ hg_bulk_create(hg_core_class_t *core_class, hg_uint32_t count, void **bufs,
     const hg_size_t *lens, hg_uint8_t flags, const struct hg_bulk_attr *attrs,
     struct hg_bulk **hg_bulk_p);
 
+/**
+ * Get slab buffer that contains [buf, buf + len), NULL if there is none.
+ */
+static struct hg_bulk_slab_buf *
+hg_bulk_slab_lookup(
+    struct hg_bulk_slab *hg_bulk_slab, const void *buf, hg_size_t len);
+
+/**
+ * Register slab buffer with access flags if not registered yet.
+ */
+static hg_return_t
+hg_bulk_slab_register(struct hg_bulk_slab *hg_bulk_slab,
+    struct hg_bulk_slab_buf *hg_bulk_slab_buf, hg_uint8_t flags);
+
+/**
+ * Deregister and free slab buffer.
+ */
+static void
+hg_bulk_slab_buf_free(struct hg_bulk_slab *hg_bulk_slab,
+    struct hg_bulk_slab_buf *hg_bulk_slab_buf);
+
+/**
+ * Allocate buffer from slab.
+ */
+static void *
+hg_bulk_slab_alloc(struct hg_bulk_slab *hg_bulk_slab, hg_size_t size);
+
+/**
+ * Release buffer to slab.
+ */
+static void
+hg_bulk_slab_free(struct hg_bulk_slab *hg_bulk_slab, void *buf);
+
 /**
  * Free handle.
  */
@@ -351,6 +457,14 @@ hg_bulk_offset_translate(const struct hg_bulk_segment *segments,
     hg_uint32_t count, hg_size_t offset, hg_uint32_t *segment_start_index,
     hg_size_t *segment_start_offset);
 
+/**
+ * Update CRC32C with data contained in segments.
+ */
+static hg_uint32_t
+hg_bulk_checksum(const struct hg_bulk_segment *segments, hg_uint32_t count,
+    hg_uint32_t segment_index, hg_size_t segment_offset, hg_size_t size,
+    hg_uint32_t checksum);
+
 /**
  * Create bulk operation ID.
  */
@@ -400,7 +514,7 @@ hg_bulk_transfer_segments_self(hg_bulk_copy_op_t copy_op,
     hg_size_t origin_segment_start_index, hg_size_t origin_segment_start_offset,
     const struct hg_bulk_segment *local_segments, hg_uint32_t local_count,
     hg_size_t local_segment_start_index, hg_size_t local_segment_start_offset,
-    hg_size_t size);
+    hg_size_t size, hg_uint32_t *checksum_p);
 
 /**
  * Memcpy.
@@ -431,11 +545,11 @@ static hg_return_t
 hg_bulk_transfer_na(hg_bulk_op_t op, na_addr_t *na_origin_addr,
     hg_uint8_t origin_id, const struct hg_bulk_segment *origin_segments,
     hg_uint32_t origin_count, na_mem_handle_t **origin_mem_handles,
-    hg_uint8_t origin_flags, hg_size_t origin_offset,
-    const struct hg_bulk_segment *local_segments, hg_uint32_t local_count,
-    na_mem_handle_t **local_mem_handles, hg_uint8_t local_flags,
-    hg_size_t local_offset, hg_size_t size,
-    struct hg_bulk_op_id *hg_bulk_op_id);
+    hg_size_t origin_na_offset, hg_uint8_t origin_flags,
+    hg_size_t origin_offset, const struct hg_bulk_segment *local_segments,
+    hg_uint32_t local_count, na_mem_handle_t **local_mem_handles,
+    hg_size_t local_na_offset, hg_uint8_t local_flags, hg_size_t local_offset,
+    hg_size_t size, struct hg_bulk_op_id *hg_bulk_op_id);
 
 /**
  * Get number of required operations to transfer data.
@@ -456,12 +570,13 @@ hg_bulk_transfer_segments_na(na_class_t *na_class, na_context_t *na_context,
     na_bulk_op_t na_bulk_op, na_cb_t callback, void *arg,
     na_addr_t *origin_addr, uint8_t origin_id,
     const struct hg_bulk_segment *origin_segments, hg_uint32_t origin_count,
-    na_mem_handle_t **origin_mem_handles, hg_size_t origin_segment_start_index,
-    hg_size_t origin_segment_start_offset,
+    na_mem_handle_t **origin_mem_handles, hg_size_t origin_na_offset,
+    hg_size_t origin_segment_start_index, hg_size_t origin_segment_start_offset,
     const struct hg_bulk_segment *local_segments, hg_uint32_t local_count,
-    na_mem_handle_t **local_mem_handles, hg_size_t local_segment_start_index,
-    hg_size_t local_segment_start_offset, hg_size_t size,
-    na_op_id_t *na_op_ids[], hg_uint32_t na_op_count);
+    na_mem_handle_t **local_mem_handles, hg_size_t local_na_offset,
+    hg_size_t local_segment_start_index, hg_size_t local_segment_start_offset,
+    hg_size_t size, na_op_id_t *na_op_ids[],
+    struct hg_bulk_na_op_range *na_op_ranges, hg_uint32_t na_op_count);
 
 /**
  * NA_Put wrapper
@@ -499,6 +614,19 @@ hg_bulk_na_get(na_class_t *na_class, na_context_t *context, na_cb_t callback,
 static void
 hg_bulk_transfer_cb(const struct na_cb_info *callback_info);
 
+/**
+ * Transfer callback, checksums local data moved by the NA operation.
+ */
+static void
+hg_bulk_transfer_checksum_cb(const struct na_cb_info *callback_info);
+
+/**
+ * Complete one of the NA operations of a bulk operation.
+ */
+static void
+hg_bulk_transfer_na_complete(
+    struct hg_bulk_op_id *hg_bulk_op_id, na_return_t na_ret);
+
 /**
  * Complete operation ID.
  */
@@ -589,6 +717,49 @@ hg_bulk_create(hg_core_class_t *core_class, hg_uint32_t count, void **bufs,
         "Creating bulk handle with %u segment(s), len is %" PRIu64 " bytes",
         hg_bulk->desc.info.segment_count, hg_bulk->desc.info.len);
 
+    /* Buffers carved out of the slab reuse their registration */
+    if (bufs && (count == 1) && (attrs->mem_type == HG_MEM_TYPE_HOST) &&
+        (flags & HG_BULK_READWRITE)) {
+        struct hg_bulk_slab *hg_bulk_slab =
+            hg_core_class_get_bulk_slab(core_class);
+        struct hg_bulk_slab_buf *hg_bulk_slab_buf =
+            (hg_bulk_slab)
+                ? hg_bulk_slab_lookup(hg_bulk_slab, bufs[0], lens[0])
+                : NULL;
+
+        if (hg_bulk_slab_buf) {
+            unsigned int mode = (unsigned int) (flags & HG_BULK_READWRITE) - 1;
+
+            HG_LOG_SUBSYS_DEBUG(bulk, "Using slab registration");
+
+            ret = hg_bulk_slab_register(hg_bulk_slab, hg_bulk_slab_buf, flags);
+            HG_CHECK_SUBSYS_HG_ERROR(
+                bulk, error, ret, "Could not register slab buffer");
+
+            hg_bulk->na_offset =
+                (hg_size_t) ((char *) bufs[0] - hg_bulk_slab_buf->base);
+            if (hg_bulk->na_offset > 0)
+                hg_bulk->desc.info.ext_flags |= HG_BULK_OFFSET;
+            hg_bulk->na_mem_descs.handles.s[0] =
+                hg_bulk_slab_buf->na_mem_handles[mode];
+            hg_bulk->na_mem_descs.serialize_sizes.s[0] =
+                hg_bulk_slab_buf->na_serialize_sizes[mode];
+#ifdef NA_HAS_SM
+            hg_bulk->na_sm_mem_descs.handles.s[0] =
+                hg_bulk_slab_buf->na_sm_mem_handles[mode];
+            hg_bulk->na_sm_mem_descs.serialize_sizes.s[0] =
+                hg_bulk_slab_buf->na_sm_serialize_sizes[mode];
+#endif
+            hg_bulk->slab = HG_TRUE;
+            hg_bulk->registered = HG_TRUE;
+            hg_core_bulk_incr(core_class);
+
+            *hg_bulk_p = hg_bulk;
+
+            return HG_SUCCESS;
+        }
+    }
+
     /* Query max segment limit that NA plugin can handle */
     if ((count > 1) && na_class->ops->mem_handle_create_segments) {
         size_t max_segments =
@@ -683,9 +854,11 @@ hg_bulk_free(struct hg_bulk *hg_bulk)
     if (hg_atomic_decr32(&hg_bulk->ref_count))
         return HG_SUCCESS;
 
-    /* Deregister segments */
-    if (hg_bulk->desc.info.flags & HG_BULK_REGV ||
-        (hg_bulk->desc.info.segment_count == 1)) {
+    /* Deregister segments (slab registration is owned by the class) */
+    if (hg_bulk->slab) {
+        /* Nothing to deregister */
+    } else if (hg_bulk->desc.info.flags & HG_BULK_REGV ||
+               (hg_bulk->desc.info.segment_count == 1)) {
         if (hg_bulk->na_mem_descs.handles.s[0] != NULL) {
             ret = hg_bulk_deregister(hg_bulk->na_class,
                 hg_bulk->na_mem_descs.handles.s[0], hg_bulk->registered);
@@ -989,6 +1162,14 @@ hg_bulk_get_serialize_size(struct hg_bulk *hg_bulk, hg_uint8_t flags)
     ret = sizeof(*desc_info) +
           desc_info->segment_count * sizeof(struct hg_bulk_segment);
 
+    /* Expected digest */
+    if (desc_info->ext_flags & HG_BULK_DIGEST)
+        ret += sizeof(hg_uint32_t);
+
+    /* NA handle offset */
+    if (desc_info->ext_flags & HG_BULK_OFFSET)
+        ret += sizeof(hg_size_t);
+
     /* Memory handles */
     if ((desc_info->flags & HG_BULK_REGV) || (desc_info->segment_count == 1)) {
         /* Only one single memory handle in that case */
@@ -1107,6 +1288,16 @@ hg_bulk_serialize(
     HG_BULK_ENCODE(error, ret, buf_ptr, buf_size_left, &desc_info,
         struct hg_bulk_desc_info);
 
+    /* Expected digest */
+    if (desc_info.ext_flags & HG_BULK_DIGEST)
+        HG_BULK_ENCODE(error, ret, buf_ptr, buf_size_left, &hg_bulk->digest,
+            hg_uint32_t);
+
+    /* NA handle offset */
+    if (desc_info.ext_flags & HG_BULK_OFFSET)
+        HG_BULK_ENCODE(error, ret, buf_ptr, buf_size_left, &hg_bulk->na_offset,
+            hg_size_t);
+
     /* Segments */
     HG_BULK_ENCODE_ARRAY(error, ret, buf_ptr, buf_size_left, segments,
         struct hg_bulk_segment, desc_info.segment_count);
@@ -1303,6 +1494,16 @@ hg_bulk_deserialize(hg_core_class_t *core_class, struct hg_bulk **hg_bulk_p,
         " bytes",
         hg_bulk->desc.info.segment_count, hg_bulk->desc.info.len);
 
+    /* Expected digest */
+    if (hg_bulk->desc.info.ext_flags & HG_BULK_DIGEST)
+        HG_BULK_DECODE(error, ret, buf_ptr, buf_size_left, &hg_bulk->digest,
+            hg_uint32_t);
+
+    /* NA handle offset */
+    if (hg_bulk->desc.info.ext_flags & HG_BULK_OFFSET)
+        HG_BULK_DECODE(error, ret, buf_ptr, buf_size_left, &hg_bulk->na_offset,
+            hg_size_t);
+
 #ifdef NA_HAS_SM
     /* Use SM classes if requested */
     if (hg_bulk->desc.info.flags & HG_BULK_SM) {
@@ -1606,6 +1807,27 @@ hg_bulk_offset_translate(const struct hg_bulk_segment *segments,
     *segment_start_offset = new_segment_offset;
 }
 
+/*---------------------------------------------------------------------------*/
+static hg_uint32_t
+hg_bulk_checksum(const struct hg_bulk_segment *segments, hg_uint32_t count,
+    hg_uint32_t segment_index, hg_size_t segment_offset, hg_size_t size,
+    hg_uint32_t checksum)
+{
+    while (size > 0 && segment_index < count) {
+        hg_size_t len = HG_BULK_MIN(
+            size, segments[segment_index].len - segment_offset);
+
+        checksum = hg_checksum_crc32c_buf(checksum,
+            (const void *) (segments[segment_index].base + segment_offset),
+            len);
+        size -= len;
+        segment_index++;
+        segment_offset = 0;
+    }
+
+    return checksum;
+}
+
 /*---------------------------------------------------------------------------*/
 static hg_return_t
 hg_bulk_op_create(
@@ -1713,6 +1935,8 @@ hg_bulk_op_destroy(struct hg_bulk_op_id *hg_bulk_op_id)
             hg_bulk_op_id->na_sm_op_ids.d = NULL;
 #endif
         }
+        free(hg_bulk_op_id->na_op_ranges.d);
+        hg_bulk_op_id->na_op_ranges.d = NULL;
     }
 
     /* Repost handle if we were listening, otherwise destroy it */
@@ -1844,6 +2068,288 @@ hg_bulk_op_pool_destroy(struct hg_bulk_op_pool *hg_bulk_op_pool)
     free(hg_bulk_op_pool);
 }
 
+/*---------------------------------------------------------------------------*/
+hg_return_t
+hg_bulk_slab_create(hg_core_class_t *core_class, hg_size_t size,
+    struct hg_bulk_slab **hg_bulk_slab_p)
+{
+    struct hg_bulk_slab *hg_bulk_slab = NULL;
+    size_t page_size = (size_t) hg_mem_get_hugepage_size();
+    hg_return_t ret;
+
+    hg_bulk_slab = (struct hg_bulk_slab *) calloc(1, sizeof(*hg_bulk_slab));
+    HG_CHECK_SUBSYS_ERROR(bulk, hg_bulk_slab == NULL, error, ret, HG_NOMEM,
+        "Could not allocate bulk slab");
+    hg_thread_spin_init(&hg_bulk_slab->lock);
+    hg_bulk_slab->na_class = HG_Core_class_get_na(core_class);
+#ifdef NA_HAS_SM
+    hg_bulk_slab->na_sm_class = HG_Core_class_get_na_sm(core_class);
+#endif
+
+    /* Try huge pages first, fall back to regular pages */
+    if (page_size > 0 && size >= page_size) {
+        hg_bulk_slab->size = ((size + page_size - 1) / page_size) * page_size;
+        hg_bulk_slab->base = (char *) hg_mem_huge_alloc(hg_bulk_slab->size);
+        hg_bulk_slab->huge = (hg_bulk_slab->base != NULL);
+    }
+    if (hg_bulk_slab->base == NULL) {
+        page_size = (size_t) hg_mem_get_page_size();
+        hg_bulk_slab->size = ((size + page_size - 1) / page_size) * page_size;
+        hg_bulk_slab->base =
+            (char *) hg_mem_aligned_alloc(page_size, hg_bulk_slab->size);
+        HG_CHECK_SUBSYS_ERROR(bulk, hg_bulk_slab->base == NULL, error, ret,
+            HG_NOMEM, "Could not allocate %" PRIu64 " bytes for bulk slab",
+            hg_bulk_slab->size);
+    }
+
+    hg_bulk_slab->bufs = (struct hg_bulk_slab_buf **) calloc(
+        hg_bulk_slab->size >> HG_BULK_SLAB_MIN_SHIFT,
+        sizeof(struct hg_bulk_slab_buf *));
+    HG_CHECK_SUBSYS_ERROR(bulk, hg_bulk_slab->bufs == NULL, error, ret,
+        HG_NOMEM, "Could not allocate slab page table");
+
+    HG_LOG_SUBSYS_DEBUG(bulk,
+        "Created bulk slab of %" PRIu64 " bytes at %p (huge pages: %d)",
+        hg_bulk_slab->size, (void *) hg_bulk_slab->base,
+        (int) hg_bulk_slab->huge);
+
+    *hg_bulk_slab_p = hg_bulk_slab;
+
+    return HG_SUCCESS;
+
+error:
+    hg_bulk_slab_destroy(hg_bulk_slab);
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+void
+hg_bulk_slab_destroy(struct hg_bulk_slab *hg_bulk_slab)
+{
+    if (hg_bulk_slab == NULL)
+        return;
+
+    if (hg_bulk_slab->bufs != NULL) {
+        hg_size_t page_count = hg_bulk_slab->used >> HG_BULK_SLAB_MIN_SHIFT;
+        hg_size_t i = 0;
+
+        /* Pages of a buffer all point to that buffer */
+        while (i < page_count) {
+            struct hg_bulk_slab_buf *hg_bulk_slab_buf = hg_bulk_slab->bufs[i];
+
+            if (hg_bulk_slab_buf == NULL) {
+                i++;
+                continue;
+            }
+            i += hg_bulk_slab_buf->size >> HG_BULK_SLAB_MIN_SHIFT;
+            hg_bulk_slab_buf_free(hg_bulk_slab, hg_bulk_slab_buf);
+        }
+    }
+
+    if (hg_bulk_slab->huge)
+        (void) hg_mem_huge_free(hg_bulk_slab->base, hg_bulk_slab->size);
+    else
+        hg_mem_aligned_free(hg_bulk_slab->base);
+    free(hg_bulk_slab->bufs);
+    hg_thread_spin_destroy(&hg_bulk_slab->lock);
+    free(hg_bulk_slab);
+}
+
+/*---------------------------------------------------------------------------*/
+static struct hg_bulk_slab_buf *
+hg_bulk_slab_lookup(
+    struct hg_bulk_slab *hg_bulk_slab, const void *buf, hg_size_t len)
+{
+    struct hg_bulk_slab_buf *hg_bulk_slab_buf = NULL;
+    const char *ptr = (const char *) buf;
+
+    hg_thread_spin_lock(&hg_bulk_slab->lock);
+    if (ptr >= hg_bulk_slab->base &&
+        (hg_size_t) (ptr - hg_bulk_slab->base) < hg_bulk_slab->used)
+        hg_bulk_slab_buf =
+            hg_bulk_slab->bufs[(hg_size_t) (ptr - hg_bulk_slab->base) >>
+                               HG_BULK_SLAB_MIN_SHIFT];
+    hg_thread_spin_unlock(&hg_bulk_slab->lock);
+
+    /* Range must not cross the end of the buffer */
+    if (hg_bulk_slab_buf &&
+        len > hg_bulk_slab_buf->size -
+                  (hg_size_t) (ptr - hg_bulk_slab_buf->base))
+        return NULL;
+
+    return hg_bulk_slab_buf;
+}
+
+/*---------------------------------------------------------------------------*/
+static hg_return_t
+hg_bulk_slab_register(struct hg_bulk_slab *hg_bulk_slab,
+    struct hg_bulk_slab_buf *hg_bulk_slab_buf, hg_uint8_t flags)
+{
+    unsigned int mode = (unsigned int) (flags & HG_BULK_READWRITE) - 1;
+    na_mem_handle_t *na_mem_handle = NULL;
+    size_t na_serialize_size = 0;
+#ifdef NA_HAS_SM
+    na_mem_handle_t *na_sm_mem_handle = NULL;
+    size_t na_sm_serialize_size = 0;
+#endif
+    hg_bool_t registered;
+    hg_return_t ret = HG_SUCCESS;
+
+    hg_thread_spin_lock(&hg_bulk_slab->lock);
+    registered = (hg_bulk_slab_buf->na_mem_handles[mode] != NULL);
+    hg_thread_spin_unlock(&hg_bulk_slab->lock);
+    if (registered)
+        return HG_SUCCESS;
+
+    /* Register buffer only, with the access flags of the handle */
+    ret = hg_bulk_register(hg_bulk_slab->na_class, hg_bulk_slab_buf->base,
+        (size_t) hg_bulk_slab_buf->size, flags & HG_BULK_READWRITE,
+        NA_MEM_TYPE_HOST, 0, &na_mem_handle, &na_serialize_size);
+    HG_CHECK_SUBSYS_HG_ERROR(bulk, done, ret, "Could not register buffer");
+
+#ifdef NA_HAS_SM
+    if (hg_bulk_slab->na_sm_class) {
+        ret = hg_bulk_register(hg_bulk_slab->na_sm_class,
+            hg_bulk_slab_buf->base, (size_t) hg_bulk_slab_buf->size,
+            flags & HG_BULK_READWRITE, NA_MEM_TYPE_HOST, 0, &na_sm_mem_handle,
+            &na_sm_serialize_size);
+        HG_CHECK_SUBSYS_HG_ERROR(
+            bulk, done, ret, "Could not register buffer with SM");
+    }
+#endif
+
+    /* Keep registration unless another thread registered the buffer first */
+    hg_thread_spin_lock(&hg_bulk_slab->lock);
+    if (hg_bulk_slab_buf->na_mem_handles[mode] == NULL) {
+        hg_bulk_slab_buf->na_mem_handles[mode] = na_mem_handle;
+        hg_bulk_slab_buf->na_serialize_sizes[mode] = na_serialize_size;
+        na_mem_handle = NULL;
+#ifdef NA_HAS_SM
+        hg_bulk_slab_buf->na_sm_mem_handles[mode] = na_sm_mem_handle;
+        hg_bulk_slab_buf->na_sm_serialize_sizes[mode] = na_sm_serialize_size;
+        na_sm_mem_handle = NULL;
+#endif
+    }
+    hg_thread_spin_unlock(&hg_bulk_slab->lock);
+
+done:
+    if (na_mem_handle != NULL)
+        (void) hg_bulk_deregister(hg_bulk_slab->na_class, na_mem_handle, true);
+#ifdef NA_HAS_SM
+    if (na_sm_mem_handle != NULL)
+        (void) hg_bulk_deregister(
+            hg_bulk_slab->na_sm_class, na_sm_mem_handle, true);
+#endif
+
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static void
+hg_bulk_slab_buf_free(struct hg_bulk_slab *hg_bulk_slab,
+    struct hg_bulk_slab_buf *hg_bulk_slab_buf)
+{
+    unsigned int i;
+
+    for (i = 0; i < HG_BULK_READWRITE; i++) {
+        hg_return_t ret;
+
+        if (hg_bulk_slab_buf->na_mem_handles[i] != NULL) {
+            ret = hg_bulk_deregister(hg_bulk_slab->na_class,
+                hg_bulk_slab_buf->na_mem_handles[i], true);
+            HG_CHECK_SUBSYS_ERROR_DONE(
+                bulk, ret != HG_SUCCESS, "Could not deregister slab buffer");
+        }
+#ifdef NA_HAS_SM
+        if (hg_bulk_slab_buf->na_sm_mem_handles[i] != NULL) {
+            ret = hg_bulk_deregister(hg_bulk_slab->na_sm_class,
+                hg_bulk_slab_buf->na_sm_mem_handles[i], true);
+            HG_CHECK_SUBSYS_ERROR_DONE(bulk, ret != HG_SUCCESS,
+                "Could not deregister slab buffer with SM");
+        }
+#endif
+    }
+    free(hg_bulk_slab_buf);
+}
+
+/*---------------------------------------------------------------------------*/
+static void *
+hg_bulk_slab_alloc(struct hg_bulk_slab *hg_bulk_slab, hg_size_t size)
+{
+    struct hg_bulk_slab_buf *hg_bulk_slab_buf = NULL;
+    hg_size_t class_size = (hg_size_t) 1 << HG_BULK_SLAB_MIN_SHIFT;
+    unsigned int size_class = 0;
+    char *buf = NULL;
+    hg_size_t i;
+
+    /* Round up to size class */
+    while (class_size < size) {
+        if (++size_class == HG_BULK_SLAB_CLASS_MAX ||
+            class_size > hg_bulk_slab->size)
+            return NULL;
+        class_size <<= 1;
+    }
+
+    hg_thread_spin_lock(&hg_bulk_slab->lock);
+    hg_bulk_slab_buf = hg_bulk_slab->free_lists[size_class];
+    if (hg_bulk_slab_buf != NULL)
+        hg_bulk_slab->free_lists[size_class] = hg_bulk_slab_buf->next;
+    else if (hg_bulk_slab->size - hg_bulk_slab->used >= class_size) {
+        /* Reserve space, pages are mapped to the buffer once created */
+        buf = hg_bulk_slab->base + hg_bulk_slab->used;
+        hg_bulk_slab->used += class_size;
+    }
+    hg_thread_spin_unlock(&hg_bulk_slab->lock);
+
+    if (hg_bulk_slab_buf != NULL)
+        return (void *) hg_bulk_slab_buf->base;
+    if (buf == NULL)
+        return NULL;
+
+    hg_bulk_slab_buf =
+        (struct hg_bulk_slab_buf *) calloc(1, sizeof(*hg_bulk_slab_buf));
+    HG_CHECK_SUBSYS_ERROR_NORET(bulk, hg_bulk_slab_buf == NULL, error,
+        "Could not allocate slab buffer");
+    hg_bulk_slab_buf->base = buf;
+    hg_bulk_slab_buf->size = class_size;
+    hg_bulk_slab_buf->size_class = size_class;
+
+    hg_thread_spin_lock(&hg_bulk_slab->lock);
+    for (i = 0; i < class_size >> HG_BULK_SLAB_MIN_SHIFT; i++)
+        hg_bulk_slab->bufs[((hg_size_t) (buf - hg_bulk_slab->base) >>
+                               HG_BULK_SLAB_MIN_SHIFT) +
+                           i] = hg_bulk_slab_buf;
+    hg_thread_spin_unlock(&hg_bulk_slab->lock);
+
+    return (void *) buf;
+
+error:
+    /* Reserved space is lost */
+    return NULL;
+}
+
+/*---------------------------------------------------------------------------*/
+static void
+hg_bulk_slab_free(struct hg_bulk_slab *hg_bulk_slab, void *buf)
+{
+    struct hg_bulk_slab_buf *hg_bulk_slab_buf =
+        hg_bulk_slab_lookup(hg_bulk_slab, buf, 0);
+
+    /* Only accept the exact address that was returned by alloc */
+    HG_CHECK_SUBSYS_ERROR_NORET(bulk,
+        hg_bulk_slab_buf == NULL || hg_bulk_slab_buf->base != (char *) buf,
+        error, "Pointer (%p) is not a slab buffer", buf);
+
+    hg_thread_spin_lock(&hg_bulk_slab->lock);
+    hg_bulk_slab_buf->next =
+        hg_bulk_slab->free_lists[hg_bulk_slab_buf->size_class];
+    hg_bulk_slab->free_lists[hg_bulk_slab_buf->size_class] = hg_bulk_slab_buf;
+    hg_thread_spin_unlock(&hg_bulk_slab->lock);
+
+error:
+    return;
+}
+
 /*---------------------------------------------------------------------------*/
 static hg_return_t
 hg_bulk_op_pool_get(struct hg_bulk_op_pool *hg_bulk_op_pool,
@@ -1963,6 +2469,21 @@ hg_bulk_transfer(hg_core_context_t *core_context, hg_cb_t callback, void *arg,
     hg_atomic_incr32(&hg_bulk_local->ref_count);
     hg_bulk_op_id->callback_info.info.bulk.op = op;
     hg_bulk_op_id->callback_info.info.bulk.size = size;
+    hg_bulk_op_id->callback_info.info.bulk.checksum = 0;
+
+    /* Checksum local data if requested, data is verified on pull if the
+     * transfer covers the entire region described by the origin digest */
+    hg_atomic_set32(&hg_bulk_op_id->checksum, 0);
+    hg_bulk_op_id->checksum_enabled = hg_bulk_local->checksum;
+    hg_bulk_op_id->checksum_verify = hg_bulk_local->checksum &&
+                                     (op == HG_BULK_PULL) &&
+                                     (origin_offset == 0) &&
+                                     (size == hg_bulk_origin->desc.info.len) &&
+                                     (hg_bulk_origin->desc.info.ext_flags &
+                                         HG_BULK_DIGEST);
+
+    hg_bulk_op_id->trace_id = hg_core_trace_id_next();
+    HG_TRACE_EVENT("bulk_start", hg_bulk_op_id, hg_bulk_op_id->trace_id, size);
 
     /* Reset status */
     hg_atomic_set32(&hg_bulk_op_id->status, 0);
@@ -2020,9 +2541,11 @@ hg_bulk_transfer(hg_core_context_t *core_context, hg_cb_t callback, void *arg,
             HG_BULK_MEM_HANDLES(local_mem_descs, local_count, local_flags);
 
         ret = hg_bulk_transfer_na(op, na_origin_addr, origin_id,
-            origin_segments, origin_count, origin_mem_handles, origin_flags,
-            origin_offset, local_segments, local_count, local_mem_handles,
-            local_flags, local_offset, size, hg_bulk_op_id);
+            origin_segments, origin_count, origin_mem_handles,
+            hg_bulk_origin->na_offset, origin_flags, origin_offset,
+            local_segments, local_count, local_mem_handles,
+            hg_bulk_local->na_offset, local_flags, local_offset, size,
+            hg_bulk_op_id);
     }
 
     /* Assign op_id */
@@ -2048,6 +2571,7 @@ hg_bulk_transfer_self(hg_bulk_op_t op,
 {
     hg_uint32_t origin_segment_start_index = 0, local_segment_start_index = 0;
     hg_size_t origin_segment_start_offset = 0, local_segment_start_offset = 0;
+    hg_uint32_t checksum = HG_CHECKSUM_CRC32C_INIT;
     hg_bulk_copy_op_t copy_op;
     hg_return_t ret;
 
@@ -2075,11 +2599,14 @@ hg_bulk_transfer_self(hg_bulk_op_t op,
         hg_bulk_offset_translate(local_segments, local_count, local_offset,
             &local_segment_start_index, &local_segment_start_offset);
 
-    /* Do actual transfer */
+    /* Do actual transfer, local data is checksummed as it is copied */
     hg_bulk_transfer_segments_self(copy_op, origin_segments, origin_count,
         origin_segment_start_index, origin_segment_start_offset, local_segments,
         local_count, local_segment_start_index, local_segment_start_offset,
-        size);
+        size, hg_bulk_op_id->checksum_enabled ? &checksum : NULL);
+    if (hg_bulk_op_id->checksum_enabled)
+        hg_atomic_set32(&hg_bulk_op_id->checksum,
+            (int32_t) hg_checksum_crc32c_final(checksum));
 
     /* Complete immediately */
     hg_bulk_complete(hg_bulk_op_id, HG_SUCCESS, HG_TRUE);
@@ -2097,7 +2624,7 @@ hg_bulk_transfer_segments_self(hg_bulk_copy_op_t copy_op,
     hg_size_t origin_segment_start_index, hg_size_t origin_segment_start_offset,
     const struct hg_bulk_segment *local_segments, hg_uint32_t local_count,
     hg_size_t local_segment_start_index, hg_size_t local_segment_start_offset,
-    hg_size_t size)
+    hg_size_t size, hg_uint32_t *checksum_p)
 {
     hg_size_t origin_segment_index = origin_segment_start_index;
     hg_size_t local_segment_index = local_segment_start_index;
@@ -2119,6 +2646,11 @@ hg_bulk_transfer_segments_self(hg_bulk_copy_op_t copy_op,
         copy_op(local_segments[local_segment_index].base, local_segment_offset,
             origin_segments[origin_segment_index].base, origin_segment_offset,
             transfer_size);
+        if (checksum_p)
+            *checksum_p = hg_checksum_crc32c_buf(*checksum_p,
+                (const void *) (local_segments[local_segment_index].base +
+                                local_segment_offset),
+                transfer_size);
 
         /* Decrease remaining size from the size of data we transferred
          * and exit if everything has been transferred */
@@ -2148,13 +2680,17 @@ static hg_return_t
 hg_bulk_transfer_na(hg_bulk_op_t op, na_addr_t *na_origin_addr,
     hg_uint8_t origin_id, const struct hg_bulk_segment *origin_segments,
     hg_uint32_t origin_count, na_mem_handle_t **origin_mem_handles,
-    hg_uint8_t origin_flags, hg_size_t origin_offset,
-    const struct hg_bulk_segment *local_segments, hg_uint32_t local_count,
-    na_mem_handle_t **local_mem_handles, hg_uint8_t local_flags,
-    hg_size_t local_offset, hg_size_t size, struct hg_bulk_op_id *hg_bulk_op_id)
+    hg_size_t origin_na_offset, hg_uint8_t origin_flags,
+    hg_size_t origin_offset, const struct hg_bulk_segment *local_segments,
+    hg_uint32_t local_count, na_mem_handle_t **local_mem_handles,
+    hg_size_t local_na_offset, hg_uint8_t local_flags, hg_size_t local_offset,
+    hg_size_t size, struct hg_bulk_op_id *hg_bulk_op_id)
 {
     hg_bulk_na_op_id_t *hg_bulk_na_op_ids;
     na_bulk_op_t na_bulk_op;
+    na_cb_t na_cb = hg_bulk_op_id->checksum_enabled
+                        ? hg_bulk_transfer_checksum_cb
+                        : hg_bulk_transfer_cb;
     hg_return_t ret;
 
     /* Map op to NA op */
@@ -2180,15 +2716,33 @@ hg_bulk_transfer_na(hg_bulk_op_t op, na_addr_t *na_origin_addr,
 
     if (((origin_flags & HG_BULK_REGV) || origin_count == 1) &&
         ((local_flags & HG_BULK_REGV) || local_count == 1)) {
+        void *na_arg = hg_bulk_op_id;
         na_return_t na_ret;
 
         HG_LOG_SUBSYS_DEBUG(
             bulk, "Transferring data through NA in single operation");
 
+        if (hg_bulk_op_id->checksum_enabled) {
+            struct hg_bulk_na_op_range *na_op_range =
+                &hg_bulk_op_id->na_op_ranges.s[0];
+
+            na_op_range->hg_bulk_op_id = hg_bulk_op_id;
+            na_op_range->segment_index = 0;
+            na_op_range->segment_offset = 0;
+            na_op_range->len = size;
+            na_op_range->trailing_len = 0;
+            if (local_offset > 0)
+                hg_bulk_offset_translate(local_segments, local_count,
+                    local_offset, &na_op_range->segment_index,
+                    &na_op_range->segment_offset);
+            na_arg = na_op_range;
+        }
+
         na_ret = na_bulk_op(hg_bulk_op_id->na_class, hg_bulk_op_id->na_context,
-            hg_bulk_transfer_cb, hg_bulk_op_id, local_mem_handles[0],
-            local_offset, origin_mem_handles[0], origin_offset, size,
-            na_origin_addr, origin_id, hg_bulk_na_op_ids->s[0]);
+            na_cb, na_arg, local_mem_handles[0],
+            local_na_offset + local_offset, origin_mem_handles[0],
+            origin_na_offset + origin_offset, size, na_origin_addr, origin_id,
+            hg_bulk_na_op_ids->s[0]);
         HG_CHECK_SUBSYS_ERROR(bulk, na_ret != NA_SUCCESS, error, ret,
             (hg_return_t) na_ret, "Could not transfer data (%s)",
             NA_Error_to_string(na_ret));
@@ -2197,6 +2751,7 @@ hg_bulk_transfer_na(hg_bulk_op_t op, na_addr_t *na_origin_addr,
                     local_segment_start_index = 0;
         hg_size_t origin_segment_start_offset = 0,
                   local_segment_start_offset = 0;
+        struct hg_bulk_na_op_range *na_op_ranges = NULL;
         na_op_id_t **na_op_ids;
 
         /* Translate bulk_offset */
@@ -2244,14 +2799,27 @@ hg_bulk_transfer_na(hg_bulk_op_t op, na_addr_t *na_origin_addr,
         } else
             na_op_ids = hg_bulk_na_op_ids->s;
 
+        /* Keep track of local data moved by each operation to checksum it */
+        if (hg_bulk_op_id->checksum_enabled) {
+            if (hg_bulk_op_id->op_count > HG_BULK_STATIC_MAX) {
+                hg_bulk_op_id->na_op_ranges.d =
+                    malloc(sizeof(struct hg_bulk_na_op_range) *
+                           hg_bulk_op_id->op_count);
+                HG_CHECK_SUBSYS_ERROR(bulk,
+                    hg_bulk_op_id->na_op_ranges.d == NULL, error, ret,
+                    HG_NOMEM, "Could not allocate memory for op ranges");
+            }
+            na_op_ranges = HG_BULK_NA_OP_RANGES(hg_bulk_op_id);
+        }
+
         /* Do actual transfer */
         ret = hg_bulk_transfer_segments_na(hg_bulk_op_id->na_class,
-            hg_bulk_op_id->na_context, na_bulk_op, hg_bulk_transfer_cb,
-            hg_bulk_op_id, na_origin_addr, origin_id, origin_segments,
-            origin_count, origin_mem_handles, origin_segment_start_index,
+            hg_bulk_op_id->na_context, na_bulk_op, na_cb, hg_bulk_op_id,
+            na_origin_addr, origin_id, origin_segments, origin_count,
+            origin_mem_handles, origin_na_offset, origin_segment_start_index,
             origin_segment_start_offset, local_segments, local_count,
-            local_mem_handles, local_segment_start_index,
-            local_segment_start_offset, size, na_op_ids,
+            local_mem_handles, local_na_offset, local_segment_start_index,
+            local_segment_start_offset, size, na_op_ids, na_op_ranges,
             hg_bulk_op_id->op_count);
         HG_CHECK_SUBSYS_HG_ERROR(
             bulk, error, ret, "Could not transfer data segments");
@@ -2323,12 +2891,13 @@ hg_bulk_transfer_segments_na(na_class_t *na_class, na_context_t *na_context,
     na_bulk_op_t na_bulk_op, na_cb_t callback, void *arg,
     na_addr_t *origin_addr, uint8_t origin_id,
     const struct hg_bulk_segment *origin_segments, hg_uint32_t origin_count,
-    na_mem_handle_t **origin_mem_handles, hg_size_t origin_segment_start_index,
-    hg_size_t origin_segment_start_offset,
+    na_mem_handle_t **origin_mem_handles, hg_size_t origin_na_offset,
+    hg_size_t origin_segment_start_index, hg_size_t origin_segment_start_offset,
     const struct hg_bulk_segment *local_segments, hg_uint32_t local_count,
-    na_mem_handle_t **local_mem_handles, hg_size_t local_segment_start_index,
-    hg_size_t local_segment_start_offset, hg_size_t size,
-    na_op_id_t *na_op_ids[], hg_uint32_t na_op_count)
+    na_mem_handle_t **local_mem_handles, hg_size_t local_na_offset,
+    hg_size_t local_segment_start_index, hg_size_t local_segment_start_offset,
+    hg_size_t size, na_op_id_t *na_op_ids[],
+    struct hg_bulk_na_op_range *na_op_ranges, hg_uint32_t na_op_count)
 {
     hg_size_t origin_segment_index = origin_segment_start_index;
     hg_size_t local_segment_index = local_segment_start_index;
@@ -2344,15 +2913,30 @@ hg_bulk_transfer_segments_na(na_class_t *na_class, na_context_t *na_context,
         hg_size_t transfer_size = HG_BULK_MIN(
             (origin_segments[origin_segment_index].len - origin_segment_offset),
             (local_segments[local_segment_index].len - local_segment_offset));
+        void *op_arg = arg;
         na_return_t na_ret;
 
         /* Remaining size may be smaller */
         transfer_size = HG_BULK_MIN(remaining_size, transfer_size);
 
-        na_ret = na_bulk_op(na_class, na_context, callback, arg,
-            local_mem_handles[local_segment_index], local_segment_offset,
-            origin_mem_handles[origin_segment_index], origin_segment_offset,
-            transfer_size, origin_addr, origin_id, na_op_ids[count]);
+        /* Each operation gets its own range if data must be checksummed */
+        if (na_op_ranges) {
+            struct hg_bulk_na_op_range *na_op_range = &na_op_ranges[count];
+
+            na_op_range->hg_bulk_op_id = (struct hg_bulk_op_id *) arg;
+            na_op_range->segment_index = (hg_uint32_t) local_segment_index;
+            na_op_range->segment_offset = local_segment_offset;
+            na_op_range->len = transfer_size;
+            na_op_range->trailing_len = remaining_size - transfer_size;
+            op_arg = na_op_range;
+        }
+
+        na_ret = na_bulk_op(na_class, na_context, callback, op_arg,
+            local_mem_handles[local_segment_index],
+            local_na_offset + local_segment_offset,
+            origin_mem_handles[origin_segment_index],
+            origin_na_offset + origin_segment_offset, transfer_size,
+            origin_addr, origin_id, na_op_ids[count]);
         HG_CHECK_SUBSYS_ERROR(bulk, na_ret != NA_SUCCESS, error, ret,
             (hg_return_t) na_ret, "Could not transfer data (%s)",
             NA_Error_to_string(na_ret));
@@ -2395,12 +2979,47 @@ error:
 static void
 hg_bulk_transfer_cb(const struct na_cb_info *callback_info)
 {
-    struct hg_bulk_op_id *hg_bulk_op_id =
-        (struct hg_bulk_op_id *) callback_info->arg;
+    hg_bulk_transfer_na_complete(
+        (struct hg_bulk_op_id *) callback_info->arg, callback_info->ret);
+}
 
+/*---------------------------------------------------------------------------*/
+static void
+hg_bulk_transfer_checksum_cb(const struct na_cb_info *callback_info)
+{
+    struct hg_bulk_na_op_range *na_op_range =
+        (struct hg_bulk_na_op_range *) callback_info->arg;
+    struct hg_bulk_op_id *hg_bulk_op_id = na_op_range->hg_bulk_op_id;
+
+    /* Checksum data moved by this operation while it is still in cache.
+     * Operations may complete out of order, the CRC of each range is therefore
+     * shifted by the size of the data that follows it (combining with a 0 CRC)
+     * so that shifted CRCs can be XORed in any order. */
     if (callback_info->ret == NA_SUCCESS) {
+        struct hg_bulk *hg_bulk_local = (struct hg_bulk *)
+            hg_bulk_op_id->callback_info.info.bulk.local_handle;
+        hg_uint32_t checksum = hg_checksum_crc32c_final(hg_bulk_checksum(
+            HG_BULK_SEGMENTS(hg_bulk_local),
+            hg_bulk_local->desc.info.segment_count, na_op_range->segment_index,
+            na_op_range->segment_offset, na_op_range->len,
+            HG_CHECKSUM_CRC32C_INIT));
+
+        hg_atomic_xor32(&hg_bulk_op_id->checksum,
+            (int32_t) hg_checksum_crc32c_combine(
+                checksum, 0, na_op_range->trailing_len));
+    }
+
+    hg_bulk_transfer_na_complete(hg_bulk_op_id, callback_info->ret);
+}
+
+/*---------------------------------------------------------------------------*/
+static void
+hg_bulk_transfer_na_complete(
+    struct hg_bulk_op_id *hg_bulk_op_id, na_return_t na_ret)
+{
+    if (na_ret == NA_SUCCESS) {
         /* Nothing */
-    } else if (callback_info->ret == NA_CANCELED) {
+    } else if (na_ret == NA_CANCELED) {
         HG_CHECK_SUBSYS_WARNING(bulk,
             hg_atomic_get32(&hg_bulk_op_id->status) & HG_BULK_OP_COMPLETED,
             "Operation was completed");
@@ -2415,19 +3034,18 @@ hg_bulk_transfer_cb(const struct na_cb_info *callback_info)
 
         /* Keep first non-success ret status */
         hg_atomic_cas32(&hg_bulk_op_id->ret_status, (int32_t) HG_SUCCESS,
-            (int32_t) callback_info->ret);
+            (int32_t) na_ret);
         HG_LOG_ERROR("NA callback returned error (%s)",
-            NA_Error_to_string(callback_info->ret));
+            NA_Error_to_string(na_ret));
     }
 
     /* When all NA transfers that correspond to the bulk operation complete,
      * complete the bulk operation. */
     if ((hg_uint32_t) hg_atomic_incr32(&hg_bulk_op_id->op_completed_count) ==
-        hg_bulk_op_id->op_count) {
+        hg_bulk_op_id->op_count)
         hg_bulk_complete(hg_bulk_op_id,
             (hg_return_t) hg_atomic_get32(&hg_bulk_op_id->ret_status),
             HG_FALSE);
-    }
 }
 
 /*---------------------------------------------------------------------------*/
@@ -2438,9 +3056,31 @@ hg_bulk_complete(
     /* Mark op id as completed */
     hg_atomic_or32(&hg_bulk_op_id->status, HG_BULK_OP_COMPLETED);
 
+    /* Finalize checksum and verify it against origin digest */
+    if (ret == HG_SUCCESS && hg_bulk_op_id->checksum_enabled) {
+        struct hg_cb_info_bulk *bulk_info =
+            &hg_bulk_op_id->callback_info.info.bulk;
+
+        bulk_info->checksum =
+            (hg_uint32_t) hg_atomic_get32(&hg_bulk_op_id->checksum);
+        if (hg_bulk_op_id->checksum_verify &&
+            bulk_info->checksum !=
+                ((struct hg_bulk *) bulk_info->origin_handle)->digest) {
+            HG_LOG_SUBSYS_ERROR(bulk,
+                "checksum 0x%08" PRIx32 " does not match (expected 0x%08" PRIx32
+                "!)",
+                bulk_info->checksum,
+                ((struct hg_bulk *) bulk_info->origin_handle)->digest);
+            ret = HG_CHECKSUM_ERROR;
+        }
+    }
+
     /* Forward status to callback */
     hg_bulk_op_id->callback_info.ret = ret;
 
+    HG_TRACE_EVENT("bulk_end", hg_bulk_op_id, hg_bulk_op_id->trace_id,
+        hg_bulk_op_id->callback_info.info.bulk.size);
+
     hg_bulk_op_id->hg_completion_entry.op_type = HG_BULK;
     hg_bulk_op_id->hg_completion_entry.op_id.hg_bulk_op_id = hg_bulk_op_id;
 
@@ -2498,6 +3138,7 @@ hg_bulk_trigger_entry(struct hg_bulk_op_id *hg_bulk_op_id)
     hg_return_t ret;
 
     /* Execute callback */
+    HG_TRACE_EVENT("trigger", hg_bulk_op_id, hg_bulk_op_id->trace_id, 0);
     if (hg_bulk_op_id->callback)
         hg_bulk_op_id->callback(&hg_bulk_op_id->callback_info);
 
@@ -2602,6 +3243,62 @@ error:
     return ret;
 }
 
+/*---------------------------------------------------------------------------*/
+void *
+HG_Bulk_buf_alloc(hg_class_t *hg_class, hg_size_t size)
+{
+    struct hg_bulk_slab *hg_bulk_slab;
+    void *buf = NULL;
+
+    HG_CHECK_SUBSYS_ERROR_NORET(
+        bulk, hg_class == NULL, error, "NULL HG class");
+    HG_CHECK_SUBSYS_ERROR_NORET(bulk, size == 0, error, "NULL buffer size");
+
+    hg_bulk_slab = hg_core_class_get_bulk_slab(hg_class->core_class);
+    if (hg_bulk_slab)
+        buf = hg_bulk_slab_alloc(hg_bulk_slab, size);
+
+    /* Slab is not enabled or exhausted */
+    if (buf == NULL) {
+        buf = hg_mem_aligned_alloc((size_t) hg_mem_get_page_size(), size);
+        HG_CHECK_SUBSYS_ERROR_NORET(bulk, buf == NULL, error,
+            "Could not allocate %" PRIu64 " bytes", size);
+    }
+
+    HG_LOG_SUBSYS_DEBUG(bulk, "Allocated bulk buffer (%p) of %" PRIu64
+        " bytes", buf, size);
+
+    return buf;
+
+error:
+    return NULL;
+}
+
+/*---------------------------------------------------------------------------*/
+void
+HG_Bulk_buf_free(hg_class_t *hg_class, void *buf)
+{
+    struct hg_bulk_slab *hg_bulk_slab;
+
+    HG_CHECK_SUBSYS_ERROR_NORET(
+        bulk, hg_class == NULL, error, "NULL HG class");
+
+    if (buf == NULL)
+        return;
+
+    HG_LOG_SUBSYS_DEBUG(bulk, "Freeing bulk buffer (%p)", buf);
+
+    hg_bulk_slab = hg_core_class_get_bulk_slab(hg_class->core_class);
+    if (hg_bulk_slab && (char *) buf >= hg_bulk_slab->base &&
+        (hg_size_t) ((char *) buf - hg_bulk_slab->base) < hg_bulk_slab->size)
+        hg_bulk_slab_free(hg_bulk_slab, buf);
+    else
+        hg_mem_aligned_free(buf);
+
+error:
+    return;
+}
+
 /*---------------------------------------------------------------------------*/
 hg_return_t
 HG_Bulk_free(hg_bulk_t handle)
@@ -2715,6 +3412,101 @@ error:
     return ret;
 }
 
+/*---------------------------------------------------------------------------*/
+hg_return_t
+HG_Bulk_set_checksum(hg_bulk_t handle, hg_bool_t enable)
+{
+    struct hg_bulk *hg_bulk = (struct hg_bulk *) handle;
+    hg_return_t ret;
+
+    HG_CHECK_SUBSYS_ERROR(bulk, hg_bulk == NULL, error, ret, HG_INVALID_ARG,
+        "NULL bulk handle passed");
+    HG_CHECK_SUBSYS_ERROR(bulk,
+        enable && ((hg_bulk->desc.info.flags & HG_BULK_VIRT) ||
+                      (hg_bulk->attrs.mem_type != HG_MEM_TYPE_HOST)),
+        error, ret, HG_OPNOTSUPPORTED,
+        "Checksums require local host memory");
+
+    hg_bulk->checksum = enable;
+
+    return HG_SUCCESS;
+
+error:
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+hg_return_t
+HG_Bulk_compute_digest(hg_bulk_t handle, hg_uint32_t *digest_p)
+{
+    struct hg_bulk *hg_bulk = (struct hg_bulk *) handle;
+    hg_return_t ret;
+
+    HG_CHECK_SUBSYS_ERROR(bulk, hg_bulk == NULL, error, ret, HG_INVALID_ARG,
+        "NULL bulk handle passed");
+    HG_CHECK_SUBSYS_ERROR(bulk, digest_p == NULL, error, ret, HG_INVALID_ARG,
+        "NULL digest pointer");
+    HG_CHECK_SUBSYS_ERROR(bulk,
+        (hg_bulk->desc.info.flags & HG_BULK_VIRT) ||
+            (hg_bulk->attrs.mem_type != HG_MEM_TYPE_HOST),
+        error, ret, HG_OPNOTSUPPORTED, "Digest requires local host memory");
+
+    *digest_p = hg_checksum_crc32c_final(hg_bulk_checksum(
+        HG_BULK_SEGMENTS(hg_bulk), hg_bulk->desc.info.segment_count, 0, 0,
+        hg_bulk->desc.info.len, HG_CHECKSUM_CRC32C_INIT));
+
+    return HG_SUCCESS;
+
+error:
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+hg_return_t
+HG_Bulk_set_digest(hg_bulk_t handle, hg_uint32_t digest)
+{
+    struct hg_bulk *hg_bulk = (struct hg_bulk *) handle;
+    hg_return_t ret;
+
+    HG_CHECK_SUBSYS_ERROR(bulk, hg_bulk == NULL, error, ret, HG_INVALID_ARG,
+        "NULL bulk handle passed");
+
+    hg_bulk->digest = digest;
+    hg_bulk->desc.info.ext_flags |= HG_BULK_DIGEST;
+
+    /* Descriptor changed, cached serialization buffer is no longer valid */
+    hg_bulk->serialize_ptr = NULL;
+    hg_bulk->serialize_size = 0;
+
+    return HG_SUCCESS;
+
+error:
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+hg_return_t
+HG_Bulk_get_digest(hg_bulk_t handle, hg_uint32_t *digest_p)
+{
+    struct hg_bulk *hg_bulk = (struct hg_bulk *) handle;
+    hg_return_t ret;
+
+    HG_CHECK_SUBSYS_ERROR(bulk, hg_bulk == NULL, error, ret, HG_INVALID_ARG,
+        "NULL bulk handle passed");
+    HG_CHECK_SUBSYS_ERROR(bulk, digest_p == NULL, error, ret, HG_INVALID_ARG,
+        "NULL digest pointer");
+
+    if (!(hg_bulk->desc.info.ext_flags & HG_BULK_DIGEST))
+        return HG_NOENTRY;
+
+    *digest_p = hg_bulk->digest;
+
+    return HG_SUCCESS;
+
+error:
+    return ret;
+}
+
 /*---------------------------------------------------------------------------*/
 hg_size_t
 HG_Bulk_get_serialize_size(hg_bulk_t handle, unsigned long flags)
@@ -80,6 +80,33 @@ HG_Bulk_create_attr(hg_class_t *hg_class, hg_uint32_t count, void **buf_ptrs,
     const hg_size_t *buf_sizes, hg_uint8_t flags,
     const struct hg_bulk_attr *attrs, hg_bulk_t *handle);
 
+/**
+ * Allocate a buffer of \size bytes out of the slab of the HG class (see
+ * bulk_buf_slab_size in hg_init_info). The buffer is registered the first time
+ * that a single-segment bulk handle is created over it (or any part of it),
+ * with the access flags of that handle, and the registration is kept while the
+ * buffer is freed and reused. Buffers are not zeroed. If the slab is
+ * not enabled or is exhausted, regular memory is returned, which is registered
+ * as usual when a handle is created.
+ *
+ * \param hg_class [IN]         pointer to HG class
+ * \param size [IN]             buffer size
+ *
+ * \return Pointer to buffer or NULL in case of failure
+ */
+HG_PUBLIC void *
+HG_Bulk_buf_alloc(hg_class_t *hg_class, hg_size_t size);
+
+/**
+ * Free a buffer allocated with HG_Bulk_buf_alloc(). Bulk handles created over
+ * the buffer must have been freed first.
+ *
+ * \param hg_class [IN]         pointer to HG class
+ * \param buf [IN]              pointer to buffer
+ */
+HG_PUBLIC void
+HG_Bulk_buf_free(hg_class_t *hg_class, void *buf);
+
 /**
  * Free bulk handle.
  *
@@ -173,6 +200,61 @@ HG_Bulk_access(hg_bulk_t handle, hg_size_t offset, hg_size_t size,
     hg_uint8_t flags, hg_uint32_t max_count, void **buf_ptrs,
     hg_size_t *buf_sizes, hg_uint32_t *actual_count);
 
+/**
+ * Enable or disable checksumming of data transferred through a local bulk
+ * handle. When enabled, a CRC32C of the local data moved by HG_Bulk_transfer()
+ * is returned in the bulk callback info. If a pull transfer covers the entire
+ * region of an origin handle that carries a digest (see HG_Bulk_set_digest()),
+ * the transfer completes with HG_CHECKSUM_ERROR when checksums do not match.
+ *
+ * \remark The digest describes the whole origin region: pull transfers of a
+ * sub-range and push transfers are not verified, callers can compare the
+ * returned checksum against their own expected value instead.
+ *
+ * \param handle [IN]           abstract bulk handle
+ * \param enable [IN]           enable checksums
+ *
+ * \return HG_SUCCESS or corresponding HG error code
+ */
+HG_PUBLIC hg_return_t
+HG_Bulk_set_checksum(hg_bulk_t handle, hg_bool_t enable);
+
+/**
+ * Compute CRC32C of the data abstracted by a local bulk handle.
+ *
+ * \param handle [IN]           abstract bulk handle
+ * \param digest_p [OUT]        pointer to returned digest
+ *
+ * \return HG_SUCCESS or corresponding HG error code
+ */
+HG_PUBLIC hg_return_t
+HG_Bulk_compute_digest(hg_bulk_t handle, hg_uint32_t *digest_p);
+
+/**
+ * Attach an expected CRC32C digest of the data abstracted by bulk handle.
+ * The digest is serialized along with the bulk descriptor and only verified
+ * by pull transfers that cover the entire region (see HG_Bulk_set_checksum()).
+ *
+ * \param handle [IN]           abstract bulk handle
+ * \param digest [IN]           CRC32C digest
+ *
+ * \return HG_SUCCESS or corresponding HG error code
+ */
+HG_PUBLIC hg_return_t
+HG_Bulk_set_digest(hg_bulk_t handle, hg_uint32_t digest);
+
+/**
+ * Retrieve the expected digest attached to a bulk handle.
+ *
+ * \param handle [IN]           abstract bulk handle
+ * \param digest_p [OUT]        pointer to returned digest
+ *
+ * \return HG_SUCCESS, HG_NOENTRY if no digest is attached or corresponding
+ * HG error code
+ */
+HG_PUBLIC hg_return_t
+HG_Bulk_get_digest(hg_bulk_t handle, hg_uint32_t *digest_p);
+
 /**
  * Get total size of data abstracted by bulk handle.
  *
@@ -345,6 +427,7 @@ struct hg_bulk_desc_info {
     hg_size_t len;             /* Size of region */
     hg_uint32_t segment_count; /* Segment count */
     hg_uint8_t flags;          /* Flags of operation access */
+    hg_uint8_t ext_flags;      /* Extended flags */
 };
 
 /*---------------------------------------------------------------------------*/
@@ -11,6 +11,8 @@
 #include "mercury_atomic_queue.h"
 #include "mercury_error.h"
 #include "mercury_event.h"
+#include "mercury_hash_map.h"
+#include "mercury_hash_string.h"
 #include "mercury_hash_table.h"
 #include "mercury_list.h"
 #include "mercury_mem.h"
@@ -23,6 +25,7 @@
 #include "mercury_thread_rwlock.h"
 #include "mercury_thread_spin.h"
 #include "mercury_time.h"
+#include "mercury_timer_wheel.h"
 
 #ifdef NA_HAS_SM
 #    include <na_sm.h>
@@ -37,10 +40,15 @@
 
 /* Private flags */
 #define HG_CORE_SELF_FORWARD (1 << 3) /* Forward to self */
+#define HG_CORE_BATCH        (1 << 4) /* Message of coalesced requests */
 
 /* Size of comletion queue used for holding completed requests */
 #define HG_CORE_ATOMIC_QUEUE_SIZE (1024)
 
+/* Default number of completions of a priority class that are triggered before
+ * yielding to the next lower class */
+#define HG_CORE_PRIORITY_WEIGHT (16)
+
 /* Pre-posted requests and op IDs */
 #define HG_CORE_POST_INIT          (512)
 #define HG_CORE_POST_INCR          (512)
@@ -52,6 +60,13 @@
 /* Timeout on finalize */
 #define HG_CORE_CLEANUP_TIMEOUT (5000)
 
+/* Coalesced requests are each prefixed by their tag and size */
+#define HG_CORE_BATCH_ENTRY_HEADER_SIZE (2 * sizeof(hg_uint32_t))
+
+/* Addr table format */
+#define HG_CORE_ADDR_TABLE_MAGIC   (0x48474154) /* "HGAT" */
+#define HG_CORE_ADDR_TABLE_VERSION (1)
+
 /* Max number of events for progress */
 #define HG_CORE_MAX_EVENTS        (1)
 #define HG_CORE_MAX_TRIGGER_COUNT (1)
@@ -75,6 +90,7 @@
 #define HG_CORE_OP_ERRORED    (1 << 3) /* Operation encountered error */
 #define HG_CORE_OP_QUEUED     (1 << 4) /* Operation queued into CQ */
 #define HG_CORE_OP_MULTI_RECV (1 << 5) /* Operation uses multi-recv */
+#define HG_CORE_OP_TIMEDOUT   (1 << 6) /* Operation deadline expired */
 
 /* Encode type */
 #define HG_CORE_TYPE_ENCODE(                                                   \
@@ -134,17 +150,27 @@ struct hg_core_init_info {
     hg_uint32_t request_post_init;      /* Init request count */
     hg_uint32_t request_post_incr;      /* Increment request count */
     hg_checksum_level_t checksum_level; /* Checksum level */
+    hg_uint32_t priority_weight;        /* Priority class weight */
+    hg_uint32_t coalesce_count;         /* Max coalesced requests */
     uint8_t progress_mode;              /* Progress mode */
     hg_bool_t loopback;                 /* Use loopback capability */
     hg_bool_t na_ext_init;              /* NA externally initialized */
     hg_bool_t multi_recv;               /* Use multi-recv capability */
     hg_bool_t listen;                   /* Listening on incoming RPC requests */
+    hg_bool_t priority_strict;          /* Strict priority ordering */
+    hg_bool_t addr_cache;               /* Cache looked up addresses */
 };
 
 /* RPC map */
 struct hg_core_map {
     hg_thread_rwlock_t lock; /* Map RW lock */
-    hg_hash_table_t *map;    /* Map */
+    hg_hash_map_t *map;      /* Map */
+};
+
+/* Addr cache */
+struct hg_core_addr_cache {
+    hg_thread_rwlock_t lock; /* Cache RW lock */
+    hg_hash_table_t *table;  /* Name to addr table */
 };
 
 /* More data callbacks */
@@ -173,7 +199,9 @@ struct hg_core_private_class {
     na_sm_id_t host_id; /* Host ID for local identification */
 #endif
     struct hg_core_map rpc_map;               /* RPC Map */
+    struct hg_core_addr_cache addr_cache;     /* Addr cache */
     struct hg_core_more_data_cb more_data_cb; /* More data callbacks */
+    struct hg_bulk_slab *bulk_slab;           /* Bulk buffer slab */
     na_tag_t request_max_tag;                 /* Max value for tag */
 #ifdef HG_HAS_DEBUG
     struct hg_core_counters counters; /* Diag counters */
@@ -195,10 +223,10 @@ typedef enum hg_core_poll_type {
 
 /* Completion queue */
 struct hg_core_completion_queue {
-    HG_QUEUE_HEAD(hg_completion_entry) queue; /* Completion queue */
+    HG_QUEUE_HEAD(hg_completion_entry) queue[HG_PRIORITY_MAX]; /* Queues */
+    hg_atomic_int32_t count[HG_PRIORITY_MAX]; /* Number of entries */
     hg_thread_cond_t cond;                    /* Completion queue cond */
     hg_thread_mutex_t mutex;                  /* Completion queue mutex */
-    hg_atomic_int32_t count;                  /* Number of entries */
 };
 
 /* List of handles */
@@ -207,6 +235,49 @@ struct hg_core_handle_list {
     hg_thread_spin_t lock;                     /* Handle list lock */
 };
 
+/* Coalesced requests sent as a single unexpected message */
+struct hg_core_batch {
+    HG_LIST_ENTRY(hg_core_batch) entry;      /* Pending/free list entry */
+    struct hg_core_private_context *context; /* Context */
+    struct hg_core_private_handle **handles; /* Coalesced handles */
+    na_class_t *na_class;                    /* NA class */
+    na_context_t *na_context;                /* NA context */
+    na_addr_t *na_addr;                      /* Target NA addr */
+    void *buf;                               /* Message buffer */
+    void *buf_plugin_data;                   /* Message buffer plugin data */
+    na_op_id_t *na_op_id;                    /* Operation ID for send */
+    hg_size_t buf_size;                      /* Message buffer size */
+    hg_size_t buf_used;                      /* Amount of buffer used */
+    hg_size_t header_size;                   /* Message header size */
+    unsigned int count;                      /* Number of handles */
+    hg_uint8_t context_id;                   /* Target context ID */
+    hg_bool_t pending;                       /* Being filled */
+};
+
+/* Queue of coalesced requests */
+struct hg_core_batch_queue {
+    HG_LIST_HEAD(hg_core_batch) pending; /* Batches being filled */
+    HG_LIST_HEAD(hg_core_batch) free;    /* Batches that can be re-used */
+    hg_thread_mutex_t mutex;             /* Queue mutex */
+    hg_atomic_int32_t pending_count;     /* Number of pending batches */
+};
+
+/* Pre-encoded request payload shared by multiple handles */
+struct hg_core_payload {
+    struct hg_core_private_class *hg_core_class; /* HG core class */
+    na_class_t *na_class;                        /* NA class */
+    void *buf;                                   /* Message buffer */
+    void *buf_plugin_data;                       /* Buffer plugin data */
+    hg_size_t buf_size;                          /* Message buffer size */
+    hg_size_t header_size;                       /* Message header size */
+    hg_thread_spin_t lock;                       /* Lock for request header */
+    hg_atomic_int32_t ref_count;                 /* Reference count */
+    hg_id_t header_id;                           /* Encoded RPC ID */
+    hg_uint8_t header_flags;                     /* Encoded flags */
+    hg_uint8_t header_cookie;                    /* Encoded cookie */
+    hg_bool_t header_set;                        /* Header was encoded */
+};
+
 /* Handle create callback info */
 struct hg_core_handle_create_cb {
     hg_return_t (*callback)(hg_core_handle_t, void *); /* Callback */
@@ -250,9 +321,12 @@ struct hg_core_handle_pool {
 struct hg_core_private_context {
     struct hg_core_context core_context; /* Must remain as first field */
     struct hg_core_completion_queue backfill_queue; /* Backfill queue */
-    struct hg_atomic_queue *completion_queue;       /* Default queue */
+    struct hg_atomic_queue *completion_queue[HG_PRIORITY_MAX]; /* Queues */
+    hg_atomic_int32_t priority_credits[HG_PRIORITY_MAX];       /* Credits */
     struct hg_core_loopback_notify loopback_notify; /* Loopback notification */
     struct hg_core_handle_list created_list;        /* Created handle list */
+    struct hg_core_handle_list batch_handle_list;   /* Unpacking handles */
+    struct hg_core_batch_queue batch_queue;         /* Coalesced requests */
     struct hg_core_handle_pool *handle_pool;        /* Pool of handles */
 #ifdef NA_HAS_SM
     struct hg_core_handle_pool *sm_handle_pool; /* Pool of SM handles */
@@ -260,6 +334,7 @@ struct hg_core_private_context {
     struct hg_core_multi_recv_op multi_recv_ops[HG_CORE_MULTI_RECV_OP_MAX];
     struct hg_core_handle_create_cb handle_create_cb;     /* Handle create cb */
     struct hg_bulk_op_pool *hg_bulk_op_pool;              /* Pool of op IDs */
+    struct hg_timer_wheel *timer_wheel;                   /* Deadlines */
     struct hg_poll_set *poll_set;                         /* Poll set */
     struct hg_poll_event poll_events[HG_CORE_MAX_EVENTS]; /* Poll events */
     int na_event;                                         /* NA event */
@@ -287,6 +362,7 @@ struct hg_core_private_addr {
     size_t na_sm_addr_serialize_size; /* Cached serialization size */
     na_sm_id_t host_id;               /* NA SM Host ID */
 #endif
+    char *cache_name;            /* Name in addr cache */
     hg_atomic_int32_t ref_count; /* Reference count */
 };
 
@@ -334,8 +410,16 @@ struct hg_core_private_handle {
     na_op_id_t *na_recv_op_id;      /* Operation ID for recv */
     na_op_id_t *na_ack_op_id;       /* Operation ID for ack */
     struct hg_core_multi_recv_op *multi_recv_op; /* Multi-recv operation */
+    struct hg_core_private_handle *batch_handle; /* Coalesced requests */
+    struct hg_core_batch *batch;     /* Batch that holds request */
+    struct hg_core_payload *payload; /* Shared input payload */
+    void *own_in_buf;                /* Own input buffer (shared payload) */
+    void *own_in_buf_plugin_data;    /* Own input buffer plugin data */
+    struct hg_timer timer;           /* Forward deadline timer */
     size_t in_buf_used;              /* Amount of input buffer used */
     size_t out_buf_used;             /* Amount of output buffer used */
+    size_t na_inject_size;           /* Max size of injected NA messages */
+    hg_uint64_t trace_id;            /* Lifecycle trace ID */
     na_tag_t tag;                    /* Tag used for request and response */
     hg_atomic_int32_t ref_count;     /* Reference count */
     hg_atomic_int32_t status;        /* Handle status */
@@ -349,6 +433,10 @@ struct hg_core_private_handle {
     hg_bool_t reuse;           /* Re-use handle once ref_count is 0 */
     hg_bool_t is_self;         /* Self processed */
     hg_bool_t no_response;     /* Require response or not */
+    hg_bool_t batched;         /* Unpacked from coalesced requests */
+    hg_bool_t persistent;      /* Re-use encoded request header */
+    hg_bool_t in_header_set;   /* Request header encoded in in_buf */
+    hg_bool_t deadline;        /* Deadline timer armed by forward */
 };
 
 /* HG op id */
@@ -527,23 +615,11 @@ hg_core_handle_pool_insert(struct hg_core_private_context *context,
 static hg_return_t
 hg_core_handle_pool_unpost(struct hg_core_handle_pool *hg_core_handle_pool);
 
-/**
- * Hash map keys based on RPC ID.
- */
-static HG_INLINE unsigned int
-hg_core_map_hash(hg_hash_table_key_t key);
-
-/**
- * Determine if map keys are equal using RPC ID.
- */
-static HG_INLINE int
-hg_core_map_equal(hg_hash_table_key_t key1, hg_hash_table_key_t key2);
-
 /**
  * Free value in map.
  */
 static void
-hg_core_map_value_free(hg_hash_table_value_t value);
+hg_core_map_value_free(void *value);
 
 /**
  * Lookup entry for RPC ID.
@@ -571,6 +647,68 @@ static hg_return_t
 hg_core_addr_lookup(struct hg_core_private_class *hg_core_class,
     const char *name, struct hg_core_private_addr **addr_p);
 
+/**
+ * Lookup array of addrs.
+ */
+static hg_return_t
+hg_core_addr_lookup_multi(struct hg_core_private_class *hg_core_class,
+    const char *const *names, size_t count,
+    struct hg_core_private_addr **addrs);
+
+/**
+ * Parse addr name and select NA class used for lookup.
+ */
+static hg_return_t
+hg_core_addr_parse(struct hg_core_private_class *hg_core_class,
+    const char *name, struct hg_core_private_addr *hg_core_addr,
+    na_class_t **na_class_p, const char **name_str_p);
+
+/**
+ * Attach NA addr looked up from na_class to addr.
+ */
+static void
+hg_core_addr_set_na(struct hg_core_private_addr *hg_core_addr,
+    na_class_t *na_class, na_addr_t *na_addr);
+
+/**
+ * Lookup addr in addr cache.
+ */
+static struct hg_core_private_addr *
+hg_core_addr_cache_lookup(
+    struct hg_core_private_class *hg_core_class, const char *name);
+
+/**
+ * Insert addr into addr cache, addr is replaced if name is already present.
+ */
+static hg_return_t
+hg_core_addr_cache_insert(struct hg_core_private_class *hg_core_class,
+    const char *name, struct hg_core_private_addr **hg_core_addr_p);
+
+/**
+ * Remove addr from addr cache.
+ */
+static void
+hg_core_addr_cache_remove(struct hg_core_private_addr *hg_core_addr);
+
+/**
+ * Free addr cache value.
+ */
+static void
+hg_core_addr_cache_value_free(hg_hash_table_value_t value);
+
+/**
+ * Compare addr cache keys.
+ */
+static HG_INLINE int
+hg_core_addr_cache_key_equal(
+    hg_hash_table_key_t key1, hg_hash_table_key_t key2);
+
+/**
+ * Hash addr cache key.
+ */
+static HG_INLINE unsigned int
+hg_core_addr_cache_key_hash(hg_hash_table_key_t key);
+
 /**
  * Create addr.
  */
@@ -646,6 +784,51 @@ hg_core_addr_deserialize(struct hg_core_private_class *hg_core_class,
     struct hg_core_private_addr **hg_core_addr_p, const void *buf,
     hg_size_t buf_size);
 
+/**
+ * Get serialize size of addr table.
+ */
+static hg_size_t
+hg_core_addr_table_get_serialize_size(struct hg_core_private_addr **addrs,
+    size_t count, hg_uint8_t flags);
+
+/**
+ * Serialize array of addrs into addr table.
+ */
+static hg_return_t
+hg_core_addr_table_serialize(void *buf, hg_size_t buf_size, hg_uint8_t flags,
+    struct hg_core_private_addr **addrs, size_t count);
+
+/**
+ * Deserialize addr table into array of addrs.
+ */
+static hg_return_t
+hg_core_addr_table_deserialize(struct hg_core_private_class *hg_core_class,
+    struct hg_core_private_addr **addrs, size_t count, const void *buf,
+    hg_size_t buf_size);
+
+/**
+ * Get serialize size and stride of one NA class section of addr table.
+ */
+static hg_size_t
+hg_core_addr_table_section_size(struct hg_core_private_addr **addrs,
+    size_t count, hg_bool_t sm, size_t *stride_p);
+
+/**
+ * Serialize one NA class section of addr table.
+ */
+static hg_return_t
+hg_core_addr_table_section_serialize(char **buf_ptr_p,
+    hg_size_t *buf_size_left_p, struct hg_core_private_addr **addrs,
+    size_t count, hg_bool_t sm);
+
+/**
+ * Deserialize one NA class section of addr table.
+ */
+static hg_return_t
+hg_core_addr_table_section_deserialize(const char **buf_ptr_p,
+    hg_size_t *buf_size_left_p, struct hg_core_private_addr **addrs,
+    size_t count, hg_bool_t sm);
+
 /**
  * Determine which NA component should be used.
  */
@@ -737,7 +920,47 @@ hg_core_release_input(struct hg_core_private_handle *hg_core_handle);
  */
 static hg_return_t
 hg_core_forward(struct hg_core_private_handle *hg_core_handle,
-    hg_core_cb_t callback, void *arg, hg_uint8_t flags, hg_size_t payload_size);
+    hg_core_cb_t callback, void *arg, hg_uint8_t flags, hg_size_t payload_size,
+    unsigned int timeout_ms);
+
+
+/**
+ * Forward handle using shared payload.
+ */
+static hg_return_t
+hg_core_forward_payload(struct hg_core_private_handle *hg_core_handle,
+    hg_core_cb_t callback, void *arg, hg_uint8_t flags,
+    struct hg_core_payload *hg_core_payload, hg_size_t payload_size);
+
+/**
+ * Encode request header into shared payload if not already encoded.
+ */
+static hg_return_t
+hg_core_payload_header_set(struct hg_core_payload *hg_core_payload,
+    hg_id_t id, hg_uint8_t flags, hg_uint8_t cookie, hg_bool_t *shared_p);
+
+/**
+ * Restore handle's input buffer and release shared payload.
+ */
+static HG_INLINE void
+hg_core_payload_release(struct hg_core_private_handle *hg_core_handle);
+
+/**
+ * Decrement ref count and free shared payload.
+ */
+static void
+hg_core_payload_free(struct hg_core_payload *hg_core_payload);
+/**
+ * Forward deadline expiration callback.
+ */
+static void
+hg_core_forward_timeout_cb(void *arg);
+
+/**
+ * Disarm forward deadline timer.
+ */
+static HG_INLINE void
+hg_core_forward_timer_del(struct hg_core_private_handle *hg_core_handle);
 
 /**
  * Forward handle locally.
@@ -751,6 +974,59 @@ hg_core_forward_self(struct hg_core_private_handle *hg_core_handle);
 static hg_return_t
 hg_core_forward_na(struct hg_core_private_handle *hg_core_handle);
 
+/**
+ * Add request to pending batch of coalesced requests.
+ */
+static hg_return_t
+hg_core_batch_add(
+    struct hg_core_private_handle *hg_core_handle, hg_bool_t *added_p);
+
+/**
+ * Remove request from batch if batch has not been sent yet. Return whether
+ * request was coalesced.
+ */
+static hg_bool_t
+hg_core_batch_remove(
+    struct hg_core_private_handle *hg_core_handle, hg_bool_t *removed_p);
+
+/**
+ * Allocate new batch.
+ */
+static hg_return_t
+hg_core_batch_alloc(struct hg_core_private_context *context,
+    na_class_t *na_class, na_context_t *na_context,
+    struct hg_core_batch **hg_core_batch_p);
+
+/**
+ * Free batch.
+ */
+static void
+hg_core_batch_free(struct hg_core_batch *hg_core_batch);
+
+/**
+ * Send batch.
+ */
+static void
+hg_core_batch_send(struct hg_core_batch *hg_core_batch);
+
+/**
+ * Send all pending batches.
+ */
+static void
+hg_core_batch_flush(struct hg_core_private_context *context);
+
+/**
+ * Send batch callback.
+ */
+static void
+hg_core_batch_send_cb(const struct na_cb_info *callback_info);
+
+/**
+ * Complete send of coalesced requests and release batch.
+ */
+static void
+hg_core_batch_complete(struct hg_core_batch *hg_core_batch, na_return_t ret);
+
 /**
  * Send response.
  */
@@ -789,6 +1065,13 @@ hg_core_no_respond_na(struct hg_core_private_handle *hg_core_handle);
 static HG_INLINE void
 hg_core_send_input_cb(const struct na_cb_info *callback_info);
 
+/**
+ * Complete send of input.
+ */
+static void
+hg_core_send_input_complete(
+    struct hg_core_private_handle *hg_core_handle, na_return_t ret);
+
 /**
  * Recv input callback.
  */
@@ -807,6 +1090,25 @@ hg_core_multi_recv_input_cb(const struct na_cb_info *callback_info);
 static hg_return_t
 hg_core_process_input(struct hg_core_private_handle *hg_core_handle);
 
+/**
+ * Unpack coalesced requests into separate handles.
+ */
+static hg_return_t
+hg_core_process_batch(struct hg_core_private_handle *hg_core_batch_handle);
+
+/**
+ * Get handle for unpacking coalesced request.
+ */
+static hg_return_t
+hg_core_batch_handle_get(struct hg_core_private_handle *hg_core_batch_handle,
+    struct hg_core_private_handle **hg_core_handle_p);
+
+/**
+ * Release handle used for unpacking coalesced request.
+ */
+static hg_return_t
+hg_core_batch_handle_release(struct hg_core_private_handle *hg_core_handle);
+
 /**
  * Send output callback.
  */
@@ -868,12 +1170,52 @@ hg_core_process(struct hg_core_private_handle *hg_core_handle);
 static HG_INLINE void
 hg_core_complete_op(struct hg_core_private_handle *hg_core_handle);
 
+/**
+ * Complete handle operation that completed in place outside of NA progress
+ * (e.g., injected send). Progress is woken up if it is waiting.
+ */
+static HG_INLINE void
+hg_core_complete_op_inline(struct hg_core_private_handle *hg_core_handle);
+
 /**
  * Complete handle and add to completion queue.
  */
 static HG_INLINE void
-hg_core_complete(
-    struct hg_core_private_handle *hg_core_handle, hg_return_t ret);
+hg_core_complete(struct hg_core_private_handle *hg_core_handle,
+    hg_return_t ret, hg_bool_t loopback_notify);
+
+/**
+ * Get priority class of completion entry.
+ */
+static HG_INLINE hg_priority_t
+hg_core_completion_priority(
+    const struct hg_completion_entry *hg_completion_entry);
+
+/**
+ * Check whether all completion queues are empty.
+ */
+static HG_INLINE hg_bool_t
+hg_core_completion_queue_is_empty(struct hg_core_private_context *context);
+
+/**
+ * Check whether completion queues of classes lower than priority are empty.
+ */
+static HG_INLINE hg_bool_t
+hg_core_completion_queue_is_empty_below(
+    struct hg_core_private_context *context, hg_priority_t priority);
+
+/**
+ * Pop next entry from completion queue of a given priority class.
+ */
+static HG_INLINE struct hg_completion_entry *
+hg_core_completion_pop_priority(
+    struct hg_core_private_context *context, hg_priority_t priority);
+
+/**
+ * Pop next entry from completion queues following scheduling policy.
+ */
+static struct hg_completion_entry *
+hg_core_completion_pop(struct hg_core_private_context *context);
 
 /**
  * Make progress.
@@ -942,6 +1284,12 @@ hg_core_trigger_entry(struct hg_core_private_handle *hg_core_handle);
 static hg_return_t
 hg_core_cancel(struct hg_core_private_handle *hg_core_handle);
 
+/**
+ * Return code used when handle operations are canceled.
+ */
+static HG_INLINE hg_return_t
+hg_core_cancel_ret(struct hg_core_private_handle *hg_core_handle);
+
 /*******************/
 /* Local Variables */
 /*******************/
@@ -987,6 +1335,18 @@ static HG_LOG_DEBUG_DECL_DLOG(diag) = HG_LOG_DLOG_INITIALIZER(
     diag, HG_LOG_DEBUG_LESIZE);
 static HG_LOG_SUBSYS_DLOG_DECL_REGISTER(diag, hg);
 
+/* HG_LOG_TRACE_LESIZE: number of trace events kept per thread. */
+#define HG_LOG_TRACE_LESIZE (4096)
+
+/* Declare debug log for lifecycle trace events, off by default */
+static HG_LOG_DEBUG_DECL_LE(trace, HG_LOG_TRACE_LESIZE);
+static HG_LOG_DEBUG_DECL_DLOG(trace) = HG_LOG_DLOG_INITIALIZER(
+    trace, HG_LOG_TRACE_LESIZE);
+HG_LOG_SUBSYS_DLOG_DECL_STATE_REGISTER(trace, hg, HG_LOG_OFF);
+
+/* Lifecycle trace ID generator */
+static hg_atomic_int64_t hg_core_trace_id_g = HG_ATOMIC_VAR_INIT(0);
+
 /*---------------------------------------------------------------------------*/
 #ifdef HG_HAS_DEBUG
 static void
@@ -1115,15 +1475,18 @@ hg_core_init(const char *na_info_string, hg_bool_t na_listen,
     HG_CHECK_SUBSYS_ERROR(cls, rc != HG_UTIL_SUCCESS, error_free, ret, HG_NOMEM,
         "hg_thread_rwlock_init() failed");
 
+    rc = hg_thread_rwlock_init(&hg_core_class->addr_cache.lock);
+    HG_CHECK_SUBSYS_ERROR(cls, rc != HG_UTIL_SUCCESS, error_free, ret, HG_NOMEM,
+        "hg_thread_rwlock_init() failed");
+
     /* Create new function map */
-    hg_core_class->rpc_map.map =
-        hg_hash_table_new(hg_core_map_hash, hg_core_map_equal);
+    hg_core_class->rpc_map.map = hg_hash_map_new(sizeof(hg_id_t));
     HG_CHECK_SUBSYS_ERROR(cls, hg_core_class->rpc_map.map == NULL, error, ret,
         HG_NOMEM, "Could not create RPC map");
 
     /* Automatically free all the values with the hash map */
-    hg_hash_table_register_free_functions(
-        hg_core_class->rpc_map.map, NULL, hg_core_map_value_free);
+    hg_hash_map_register_free_function(
+        hg_core_class->rpc_map.map, hg_core_map_value_free);
 
     /* Get init info and overwrite defaults */
     if (hg_init_info_p)
@@ -1151,6 +1514,27 @@ hg_core_init(const char *na_info_string, hg_bool_t na_listen,
     hg_core_class->init_info.checksum_level = HG_CHECKSUM_NONE;
 #endif
 
+    /* Save priority scheduling policy */
+    hg_core_class->init_info.priority_weight =
+        (hg_init_info.priority_weight == 0) ? HG_CORE_PRIORITY_WEIGHT
+                                            : hg_init_info.priority_weight;
+    hg_core_class->init_info.priority_strict = hg_init_info.priority_strict;
+
+    /* Save request coalescing */
+    hg_core_class->init_info.coalesce_count = hg_init_info.coalesce_count;
+
+    /* Create addr cache */
+    hg_core_class->init_info.addr_cache = hg_init_info.addr_cache;
+    if (hg_init_info.addr_cache) {
+        hg_core_class->addr_cache.table = hg_hash_table_new(
+            hg_core_addr_cache_key_hash, hg_core_addr_cache_key_equal);
+        HG_CHECK_SUBSYS_ERROR(cls, hg_core_class->addr_cache.table == NULL,
+            error, ret, HG_NOMEM, "Could not create addr cache");
+        hg_hash_table_register_free_functions(
+            hg_core_class->addr_cache.table, free,
+            hg_core_addr_cache_value_free);
+    }
+
     /* Save progress mode */
     hg_core_class->init_info.progress_mode =
         hg_init_info.na_init_info.progress_mode;
@@ -1255,6 +1639,14 @@ hg_core_init(const char *na_info_string, hg_bool_t na_listen,
         "please turn ON NA_USE_SM in CMake options");
 #endif
 
+    /* Register slab for bulk buffers once all NA classes are initialized */
+    if (hg_init_info.bulk_buf_slab_size > 0) {
+        ret = hg_bulk_slab_create(&hg_core_class->core_class,
+            hg_init_info.bulk_buf_slab_size, &hg_core_class->bulk_slab);
+        HG_CHECK_SUBSYS_HG_ERROR(
+            cls, error, ret, "Could not create bulk buffer slab");
+    }
+
     *class_p = hg_core_class;
 
     return HG_SUCCESS;
@@ -1274,7 +1666,7 @@ error:
     }
 #endif
     if (hg_core_class->rpc_map.map)
-        hg_hash_table_free(hg_core_class->rpc_map.map);
+        hg_hash_map_free(hg_core_class->rpc_map.map);
     (void) hg_thread_rwlock_destroy(&hg_core_class->rpc_map.lock);
 
 error_free:
@@ -1304,10 +1696,20 @@ hg_core_finalize(struct hg_core_private_class *hg_core_class)
         "HG contexts must be destroyed before finalizing HG (%d remaining)",
         n_contexts);
 
+    /* Release cached addrs */
+    if (hg_core_class->addr_cache.table != NULL) {
+        hg_hash_table_free(hg_core_class->addr_cache.table);
+        hg_core_class->addr_cache.table = NULL;
+    }
+
     n_addrs = hg_atomic_get32(&hg_core_class->n_addrs);
     HG_CHECK_SUBSYS_ERROR(cls, n_addrs != 0, error, ret, HG_BUSY,
         "HG addrs must be freed before finalizing HG (%d remaining)", n_addrs);
 
+    /* Release bulk buffer slab */
+    hg_bulk_slab_destroy(hg_core_class->bulk_slab);
+    hg_core_class->bulk_slab = NULL;
+
     /* Finalize NA class */
     if (hg_core_class->core_class.na_class != NULL &&
         !hg_core_class->init_info.na_ext_init) {
@@ -1336,10 +1738,11 @@ hg_core_finalize(struct hg_core_private_class *hg_core_class)
 
     /* Delete RPC map */
     if (hg_core_class->rpc_map.map != NULL) {
-        hg_hash_table_free(hg_core_class->rpc_map.map);
+        hg_hash_map_free(hg_core_class->rpc_map.map);
         hg_core_class->rpc_map.map = NULL;
     }
     (void) hg_thread_rwlock_destroy(&hg_core_class->rpc_map.lock);
+    (void) hg_thread_rwlock_destroy(&hg_core_class->addr_cache.lock);
     free(hg_core_class);
 
     return HG_SUCCESS;
@@ -1372,11 +1775,13 @@ hg_core_context_create(struct hg_core_private_class *hg_core_class,
     struct hg_core_private_context *context = NULL;
     struct hg_core_completion_queue *backfill_queue = NULL;
     hg_return_t ret;
-    int na_poll_fd, loopback_event = 0, rc;
+    int na_poll_fd, loopback_event = 0, rc, i;
     hg_bool_t backfill_queue_mutex_init = HG_FALSE,
               backfill_queue_cond_init = HG_FALSE,
               loopback_notify_mutex_init = HG_FALSE,
-              created_list_lock_init = HG_FALSE;
+              created_list_lock_init = HG_FALSE,
+              batch_handle_list_lock_init = HG_FALSE,
+              batch_queue_mutex_init = HG_FALSE;
 
     context = (struct hg_core_private_context *) calloc(1, sizeof(*context));
     HG_CHECK_SUBSYS_ERROR(ctx, context == NULL, error, ret, HG_NOMEM,
@@ -1386,8 +1791,10 @@ hg_core_context_create(struct hg_core_private_class *hg_core_class,
     context->core_context.core_class = (struct hg_core_class *) hg_core_class;
     backfill_queue = &context->backfill_queue;
 
-    HG_QUEUE_INIT(&backfill_queue->queue);
-    hg_atomic_init32(&backfill_queue->count, 0);
+    for (i = 0; i < HG_PRIORITY_MAX; i++) {
+        HG_QUEUE_INIT(&backfill_queue->queue[i]);
+        hg_atomic_init32(&backfill_queue->count[i], 0);
+    }
     rc = hg_thread_mutex_init(&backfill_queue->mutex);
     HG_CHECK_SUBSYS_ERROR(ctx, rc != HG_UTIL_SUCCESS, error, ret, HG_NOMEM,
         "hg_thread_mutex_init() failed");
@@ -1397,10 +1804,14 @@ hg_core_context_create(struct hg_core_private_class *hg_core_class,
         "hg_thread_cond_init() failed");
     backfill_queue_cond_init = HG_TRUE;
 
-    context->completion_queue =
-        hg_atomic_queue_alloc(HG_CORE_ATOMIC_QUEUE_SIZE);
-    HG_CHECK_SUBSYS_ERROR(ctx, context->completion_queue == NULL, error, ret,
-        HG_NOMEM, "Could not allocate queue");
+    for (i = 0; i < HG_PRIORITY_MAX; i++) {
+        context->completion_queue[i] =
+            hg_atomic_queue_alloc(HG_CORE_ATOMIC_QUEUE_SIZE);
+        HG_CHECK_SUBSYS_ERROR(ctx, context->completion_queue[i] == NULL, error,
+            ret, HG_NOMEM, "Could not allocate queue");
+        hg_atomic_init32(&context->priority_credits[i],
+            (int32_t) hg_core_class->init_info.priority_weight);
+    }
 
     /* Notifications of completion queue events */
     hg_atomic_init32(&context->loopback_notify.must_notify, 0);
@@ -1415,6 +1826,26 @@ hg_core_context_create(struct hg_core_private_class *hg_core_class,
         "hg_thread_spin_init() failed");
     created_list_lock_init = HG_TRUE;
 
+    /* Coalesced requests */
+    HG_LIST_INIT(&context->batch_handle_list.list);
+    rc = hg_thread_spin_init(&context->batch_handle_list.lock);
+    HG_CHECK_SUBSYS_ERROR(ctx, rc != HG_UTIL_SUCCESS, error, ret, HG_NOMEM,
+        "hg_thread_spin_init() failed");
+    batch_handle_list_lock_init = HG_TRUE;
+
+    HG_LIST_INIT(&context->batch_queue.pending);
+    HG_LIST_INIT(&context->batch_queue.free);
+    hg_atomic_init32(&context->batch_queue.pending_count, 0);
+    rc = hg_thread_mutex_init(&context->batch_queue.mutex);
+    HG_CHECK_SUBSYS_ERROR(ctx, rc != HG_UTIL_SUCCESS, error, ret, HG_NOMEM,
+        "hg_thread_mutex_init() failed");
+    batch_queue_mutex_init = HG_TRUE;
+
+    /* Timer wheel used for forward deadlines */
+    context->timer_wheel = hg_timer_wheel_create();
+    HG_CHECK_SUBSYS_ERROR(ctx, context->timer_wheel == NULL, error, ret,
+        HG_NOMEM, "Could not create timer wheel");
+
     /* Create NA context */
     context->core_context.na_context =
         NA_Context_create_id(hg_core_class->core_class.na_class, id);
@@ -1556,7 +1987,14 @@ error:
             (void) hg_thread_mutex_destroy(&context->loopback_notify.mutex);
         if (created_list_lock_init)
             (void) hg_thread_spin_destroy(&context->created_list.lock);
-        hg_atomic_queue_free(context->completion_queue);
+        if (batch_handle_list_lock_init)
+            (void) hg_thread_spin_destroy(&context->batch_handle_list.lock);
+        if (batch_queue_mutex_init)
+            (void) hg_thread_mutex_destroy(&context->batch_queue.mutex);
+        if (context->timer_wheel != NULL)
+            hg_timer_wheel_destroy(context->timer_wheel);
+        for (i = 0; i < HG_PRIORITY_MAX; i++)
+            hg_atomic_queue_free(context->completion_queue[i]);
         free(context);
     }
 
@@ -1571,7 +2009,7 @@ hg_core_context_destroy(struct hg_core_private_context *context)
     struct hg_core_completion_queue *backfill_queue = NULL;
     hg_bool_t empty;
     hg_return_t ret;
-    int rc;
+    int rc, i;
 
     if (context == NULL)
         return HG_SUCCESS;
@@ -1591,19 +2029,30 @@ hg_core_context_destroy(struct hg_core_private_context *context)
     HG_CHECK_SUBSYS_HG_ERROR(
         ctx, error, ret, "Handles for that context are still in use");
 
-    /* Check that backfill completion queue is empty now */
+    /* Check that backfill completion queues are empty now */
     backfill_queue = &context->backfill_queue;
     hg_thread_mutex_lock(&backfill_queue->mutex);
-    empty = HG_QUEUE_IS_EMPTY(&backfill_queue->queue);
+    for (i = 0, empty = HG_TRUE; i < HG_PRIORITY_MAX && empty; i++)
+        empty = HG_QUEUE_IS_EMPTY(&backfill_queue->queue[i]);
     hg_thread_mutex_unlock(&backfill_queue->mutex);
     HG_CHECK_SUBSYS_ERROR(ctx, empty == HG_FALSE, error, ret, HG_BUSY,
         "Completion queue should be empty");
 
-    /* Check that atomic completion queue is empty now */
-    empty = hg_atomic_queue_is_empty(context->completion_queue);
+    /* Check that atomic completion queues are empty now */
+    for (i = 0, empty = HG_TRUE; i < HG_PRIORITY_MAX && empty; i++)
+        empty = hg_atomic_queue_is_empty(context->completion_queue[i]);
     HG_CHECK_SUBSYS_ERROR(ctx, empty == HG_FALSE, error, ret, HG_BUSY,
         "Completion queue should be empty");
 
+    /* Free batches of coalesced requests, all requests have completed */
+    while (!HG_LIST_IS_EMPTY(&context->batch_queue.free)) {
+        struct hg_core_batch *hg_core_batch =
+            HG_LIST_FIRST(&context->batch_queue.free);
+
+        HG_LIST_REMOVE(hg_core_batch, entry);
+        hg_core_batch_free(hg_core_batch);
+    }
+
     /* Destroy pool of bulk op IDs */
     if (context->hg_bulk_op_pool != NULL) {
         hg_bulk_op_pool_destroy(context->hg_bulk_op_pool);
@@ -1679,8 +2128,14 @@ hg_core_context_destroy(struct hg_core_private_context *context)
     (void) hg_thread_cond_destroy(&backfill_queue->cond);
     (void) hg_thread_mutex_destroy(&context->loopback_notify.mutex);
     (void) hg_thread_spin_destroy(&context->created_list.lock);
+    (void) hg_thread_spin_destroy(&context->batch_handle_list.lock);
+    (void) hg_thread_mutex_destroy(&context->batch_queue.mutex);
+
+    /* All handles are released so no timer can be armed at this point */
+    hg_timer_wheel_destroy(context->timer_wheel);
 
-    hg_atomic_queue_free(context->completion_queue);
+    for (i = 0; i < HG_PRIORITY_MAX; i++)
+        hg_atomic_queue_free(context->completion_queue[i]);
     free(context);
 
     /* Decrement context count of parent class */
@@ -1807,6 +2262,22 @@ hg_core_context_unpost(struct hg_core_private_context *context)
     }
 #endif
 
+    /* Free handles used for unpacking coalesced requests */
+    hg_thread_spin_lock(&context->batch_handle_list.lock);
+    while (!HG_LIST_IS_EMPTY(&context->batch_handle_list.list)) {
+        struct hg_core_private_handle *hg_core_handle =
+            HG_LIST_FIRST(&context->batch_handle_list.list);
+
+        HG_LIST_REMOVE(hg_core_handle, pending);
+
+        /* Prevent re-initialization */
+        hg_core_handle->reuse = HG_FALSE;
+
+        /* Destroy handle */
+        (void) hg_core_destroy(hg_core_handle);
+    }
+    hg_thread_spin_unlock(&context->batch_handle_list.lock);
+
     /* Wait on created list */
     ret = hg_core_context_list_wait(context, &context->created_list);
     HG_CHECK_SUBSYS_HG_ERROR(ctx, error, ret, "Could not wait on handle list");
@@ -2065,6 +2536,13 @@ hg_core_context_get_bulk_op_pool(struct hg_core_context *core_context)
     return ((struct hg_core_private_context *) core_context)->hg_bulk_op_pool;
 }
 
+/*---------------------------------------------------------------------------*/
+struct hg_bulk_slab *
+hg_core_class_get_bulk_slab(hg_core_class_t *core_class)
+{
+    return ((struct hg_core_private_class *) core_class)->bulk_slab;
+}
+
 /*---------------------------------------------------------------------------*/
 static hg_return_t
 hg_core_handle_pool_create(struct hg_core_private_context *context,
@@ -2368,23 +2846,9 @@ error:
     return ret;
 }
 
-/*---------------------------------------------------------------------------*/
-static HG_INLINE unsigned int
-hg_core_map_hash(hg_hash_table_key_t key)
-{
-    return *((hg_id_t *) key) & 0xffffffff;
-}
-
-/*---------------------------------------------------------------------------*/
-static HG_INLINE int
-hg_core_map_equal(hg_hash_table_key_t key1, hg_hash_table_key_t key2)
-{
-    return *((hg_id_t *) key1) == *((hg_id_t *) key2);
-}
-
 /*---------------------------------------------------------------------------*/
 static void
-hg_core_map_value_free(hg_hash_table_value_t value)
+hg_core_map_value_free(void *value)
 {
     struct hg_core_rpc_info *hg_core_rpc_info =
         (struct hg_core_rpc_info *) value;
@@ -2398,15 +2862,15 @@ hg_core_map_value_free(hg_hash_table_value_t value)
 static HG_INLINE struct hg_core_rpc_info *
 hg_core_map_lookup(struct hg_core_map *hg_core_map, hg_id_t *id)
 {
-    hg_hash_table_value_t value = NULL;
+    struct hg_core_rpc_info *hg_core_rpc_info;
 
     /* Lookup key */
     hg_thread_rwlock_rdlock(&hg_core_map->lock);
-    value = hg_hash_table_lookup(hg_core_map->map, (hg_hash_table_key_t) id);
+    hg_core_rpc_info =
+        (struct hg_core_rpc_info *) hg_hash_map_lookup(hg_core_map->map, id);
     hg_thread_rwlock_release_rdlock(&hg_core_map->lock);
 
-    return (value == HG_HASH_TABLE_NULL) ? NULL
-                                         : (struct hg_core_rpc_info *) value;
+    return hg_core_rpc_info;
 }
 
 /*---------------------------------------------------------------------------*/
@@ -2424,14 +2888,14 @@ hg_core_map_insert(struct hg_core_map *hg_core_map, hg_id_t *id,
     HG_CHECK_SUBSYS_ERROR(cls, hg_core_rpc_info == NULL, error, ret, HG_NOMEM,
         "Could not allocate HG core RPC info");
     hg_core_rpc_info->id = *id;
+    hg_core_rpc_info->priority = HG_PRIORITY_DEFAULT;
 
     hg_thread_rwlock_wrlock(&hg_core_map->lock);
-    rc = hg_hash_table_insert(hg_core_map->map,
-        (hg_hash_table_key_t) &hg_core_rpc_info->id,
-        (hg_hash_table_value_t) hg_core_rpc_info);
+    rc = hg_hash_map_insert(
+        hg_core_map->map, &hg_core_rpc_info->id, hg_core_rpc_info);
     hg_thread_rwlock_release_wrlock(&hg_core_map->lock);
     HG_CHECK_SUBSYS_ERROR(
-        cls, rc == 0, error, ret, HG_NOMEM, "hg_hash_table_insert() failed");
+        cls, rc == 0, error, ret, HG_NOMEM, "hg_hash_map_insert() failed");
 
     *hg_core_rpc_info_p = hg_core_rpc_info;
 
@@ -2452,10 +2916,10 @@ hg_core_map_remove(struct hg_core_map *hg_core_map, hg_id_t *id)
 
     /* Remove key */
     hg_thread_rwlock_wrlock(&hg_core_map->lock);
-    rc = hg_hash_table_remove(hg_core_map->map, (hg_hash_table_key_t) id);
+    rc = hg_hash_map_remove(hg_core_map->map, id);
     hg_thread_rwlock_release_wrlock(&hg_core_map->lock);
     HG_CHECK_SUBSYS_ERROR(
-        cls, rc != 1, error, ret, HG_NOENTRY, "hg_hash_table_remove() failed");
+        cls, rc != 1, error, ret, HG_NOENTRY, "hg_hash_map_remove() failed");
 
     return HG_SUCCESS;
 
@@ -2469,31 +2933,193 @@ hg_core_addr_lookup(struct hg_core_private_class *hg_core_class,
     const char *name, struct hg_core_private_addr **addr_p)
 {
     struct hg_core_private_addr *hg_core_addr = NULL;
-    na_class_t **na_class_p = NULL;
-    na_addr_t **na_addr_p = NULL;
-    size_t *na_addr_serialize_size_p = NULL;
-    na_return_t na_ret;
+    na_class_t *na_class = NULL;
+    na_addr_t *na_addr = NULL;
     const char *name_str = NULL;
+    na_return_t na_ret;
     hg_return_t ret;
 
+    /* Previously looked up addresses can be returned directly */
+    if (hg_core_class->addr_cache.table != NULL) {
+        hg_core_addr = hg_core_addr_cache_lookup(hg_core_class, name);
+        if (hg_core_addr != NULL) {
+            HG_LOG_SUBSYS_DEBUG(addr, "Found %s in addr cache", name);
+            *addr_p = hg_core_addr;
+            return HG_SUCCESS;
+        }
+    }
+
     /* Allocate addr */
     ret = hg_core_addr_create(hg_core_class, &hg_core_addr);
     HG_CHECK_SUBSYS_HG_ERROR(addr, error, ret, "Could not create HG core addr");
 
     /* TODO lookup could also create self addresses */
 
-#ifdef NA_HAS_SM
-    if (hg_core_class->core_class.na_sm_class != NULL)
-        name_str = strstr(name, HG_CORE_ADDR_DELIMITER);
+    ret = hg_core_addr_parse(
+        hg_core_class, name, hg_core_addr, &na_class, &name_str);
+    HG_CHECK_SUBSYS_HG_ERROR(addr, error, ret, "Could not parse %s", name);
 
-    /* Parse name string */
-    if (name_str != NULL) {
-        char uuid_str[NA_SM_HOST_ID_LEN + 1];
-        int rc;
+    /* Lookup adress */
+    na_ret = NA_Addr_lookup(na_class, name_str, &na_addr);
+    HG_CHECK_SUBSYS_ERROR(addr, na_ret != NA_SUCCESS, error, ret,
+        (hg_return_t) na_ret, "Could not lookup address %s (%s)", name_str,
+        NA_Error_to_string(na_ret));
 
-        /* Get first part of address string with host ID */
-        rc = sscanf(name, "uid://%11[^#]", uuid_str);
-        HG_CHECK_SUBSYS_ERROR(addr, rc != 1, error, ret, HG_PROTONOSUPPORT,
+    hg_core_addr_set_na(hg_core_addr, na_class, na_addr);
+
+    if (hg_core_class->addr_cache.table != NULL) {
+        ret = hg_core_addr_cache_insert(hg_core_class, name, &hg_core_addr);
+        HG_CHECK_SUBSYS_HG_ERROR(
+            addr, error, ret, "Could not insert %s into addr cache", name);
+    }
+
+    *addr_p = hg_core_addr;
+
+    return HG_SUCCESS;
+
+error:
+    hg_core_addr_free(hg_core_addr);
+
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static hg_return_t
+hg_core_addr_lookup_multi(struct hg_core_private_class *hg_core_class,
+    const char *const *names, size_t count,
+    struct hg_core_private_addr **addrs)
+{
+    na_class_t *na_classes[2] = {hg_core_class->core_class.na_class, NULL};
+    na_class_t **addr_na_classes = NULL;
+    const char **name_strs = NULL, **na_names = NULL;
+    na_addr_t **na_addrs = NULL;
+    size_t *indices = NULL;
+    size_t n_missing = 0, i, j;
+    hg_return_t ret;
+
+#ifdef NA_HAS_SM
+    na_classes[1] = hg_core_class->core_class.na_sm_class;
+#endif
+
+    for (i = 0; i < count; i++)
+        addrs[i] = NULL;
+
+    addr_na_classes = (na_class_t **) malloc(count * sizeof(*addr_na_classes));
+    name_strs = (const char **) malloc(count * sizeof(*name_strs));
+    na_names = (const char **) malloc(count * sizeof(*na_names));
+    na_addrs = (na_addr_t **) malloc(count * sizeof(*na_addrs));
+    indices = (size_t *) malloc(count * sizeof(*indices));
+    HG_CHECK_SUBSYS_ERROR(addr,
+        addr_na_classes == NULL || name_strs == NULL || na_names == NULL ||
+            na_addrs == NULL || indices == NULL,
+        error, ret, HG_NOMEM, "Could not allocate lookup arrays");
+
+    /* Serve cached addresses and select NA class of remaining ones */
+    for (i = 0; i < count; i++) {
+        HG_CHECK_SUBSYS_ERROR(addr, names[i] == NULL, error, ret,
+            HG_INVALID_ARG, "NULL lookup name");
+
+        addr_na_classes[i] = NULL;
+        if (hg_core_class->addr_cache.table != NULL) {
+            addrs[i] = hg_core_addr_cache_lookup(hg_core_class, names[i]);
+            if (addrs[i] != NULL)
+                continue;
+        }
+
+        ret = hg_core_addr_create(hg_core_class, &addrs[i]);
+        HG_CHECK_SUBSYS_HG_ERROR(
+            addr, error, ret, "Could not create HG core addr");
+
+        ret = hg_core_addr_parse(hg_core_class, names[i], addrs[i],
+            &addr_na_classes[i], &name_strs[i]);
+        HG_CHECK_SUBSYS_HG_ERROR(
+            addr, error, ret, "Could not parse %s", names[i]);
+        n_missing++;
+    }
+
+    HG_LOG_SUBSYS_DEBUG(addr, "Looking up %zu/%zu addresses", n_missing, count);
+
+    /* Issue one lookup per NA class */
+    for (i = 0; i < 2 && n_missing > 0; i++) {
+        size_t n = 0;
+        na_return_t na_ret;
+
+        if (na_classes[i] == NULL)
+            continue;
+
+        for (j = 0; j < count; j++) {
+            if (addr_na_classes[j] != na_classes[i])
+                continue;
+            na_names[n] = name_strs[j];
+            indices[n++] = j;
+        }
+        if (n == 0)
+            continue;
+
+        na_ret = NA_Addr_lookup_multi(na_classes[i], na_names, n, na_addrs);
+        HG_CHECK_SUBSYS_ERROR(addr, na_ret != NA_SUCCESS, error, ret,
+            (hg_return_t) na_ret, "Could not lookup %zu addresses (%s)", n,
+            NA_Error_to_string(na_ret));
+
+        for (j = 0; j < n; j++)
+            hg_core_addr_set_na(addrs[indices[j]], na_classes[i], na_addrs[j]);
+        n_missing -= n;
+    }
+
+    if (hg_core_class->addr_cache.table != NULL) {
+        for (i = 0; i < count; i++) {
+            if (addr_na_classes[i] == NULL)
+                continue;
+            ret = hg_core_addr_cache_insert(hg_core_class, names[i], &addrs[i]);
+            HG_CHECK_SUBSYS_HG_ERROR(addr, error, ret,
+                "Could not insert %s into addr cache", names[i]);
+        }
+    }
+
+    free(addr_na_classes);
+    free(name_strs);
+    free(na_names);
+    free(na_addrs);
+    free(indices);
+
+    return HG_SUCCESS;
+
+error:
+    for (i = 0; i < count; i++) {
+        hg_core_addr_free(addrs[i]);
+        addrs[i] = NULL;
+    }
+    free(addr_na_classes);
+    free(name_strs);
+    free(na_names);
+    free(na_addrs);
+    free(indices);
+
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static hg_return_t
+hg_core_addr_parse(struct hg_core_private_class *hg_core_class,
+    const char *name, struct hg_core_private_addr *hg_core_addr,
+    na_class_t **na_class_p, const char **name_str_p)
+{
+    const char *name_str = NULL;
+    hg_return_t ret;
+
+#ifdef NA_HAS_SM
+    if (hg_core_class->core_class.na_sm_class != NULL)
+        name_str = strstr(name, HG_CORE_ADDR_DELIMITER);
+
+    /* Parse name string */
+    if (name_str != NULL) {
+        char uuid_str[NA_SM_HOST_ID_LEN + 1];
+        na_return_t na_ret;
+        int rc;
+
+        /* Get first part of address string with host ID */
+        rc = sscanf(name, "uid://%11[^#]", uuid_str);
+        HG_CHECK_SUBSYS_ERROR(addr, rc != 1, error, ret, HG_PROTONOSUPPORT,
             "Malformed address format (%s)", name);
 
         na_ret = NA_SM_String_to_host_id(uuid_str, &hg_core_addr->host_id);
@@ -2507,9 +3133,7 @@ hg_core_addr_lookup(struct hg_core_private_class *hg_core_class,
         /* Compare IDs, if they match it's local address */
         if (NA_SM_Host_id_cmp(hg_core_addr->host_id, hg_core_class->host_id)) {
             HG_LOG_SUBSYS_DEBUG(addr, "%s is a local address", name);
-            na_class_p = &hg_core_addr->core_addr.core_class->na_sm_class;
-            na_addr_p = &hg_core_addr->core_addr.na_sm_addr;
-            na_addr_serialize_size_p = &hg_core_addr->na_sm_addr_serialize_size;
+            *na_class_p = hg_core_class->core_class.na_sm_class;
         } else {
             /* Remote lookup */
             name_str = strstr(name_str, HG_CORE_ADDR_DELIMITER);
@@ -2517,42 +3141,172 @@ hg_core_addr_lookup(struct hg_core_private_class *hg_core_class,
                 HG_PROTONOSUPPORT, "Malformed remote address string (%s)",
                 name);
 
-            na_class_p = &hg_core_addr->core_addr.core_class->na_class;
-            na_addr_p = &hg_core_addr->core_addr.na_addr;
-            na_addr_serialize_size_p = &hg_core_addr->na_addr_serialize_size;
+            *na_class_p = hg_core_class->core_class.na_class;
             name_str += HG_CORE_ADDR_DELIMITER_LEN;
         }
     } else {
+#else
+    (void) hg_core_addr;
 #endif
         /* Remote lookup */
-        na_class_p = &hg_core_addr->core_addr.core_class->na_class;
-        na_addr_p = &hg_core_addr->core_addr.na_addr;
-        na_addr_serialize_size_p = &hg_core_addr->na_addr_serialize_size;
+        *na_class_p = hg_core_class->core_class.na_class;
         name_str = name;
 #ifdef NA_HAS_SM
     }
 #endif
 
-    /* Lookup adress */
-    na_ret = NA_Addr_lookup(*na_class_p, name_str, na_addr_p);
-    HG_CHECK_SUBSYS_ERROR(addr, na_ret != NA_SUCCESS, error, ret,
-        (hg_return_t) na_ret, "Could not lookup address %s (%s)", name_str,
-        NA_Error_to_string(na_ret));
+    *name_str_p = name_str;
 
-    /* Cache serialize size */
-    *na_addr_serialize_size_p =
-        NA_Addr_get_serialize_size(*na_class_p, *na_addr_p);
+    return HG_SUCCESS;
 
-    *addr_p = hg_core_addr;
+#ifdef NA_HAS_SM
+error:
+    return ret;
+#endif
+}
+
+/*---------------------------------------------------------------------------*/
+static void
+hg_core_addr_set_na(struct hg_core_private_addr *hg_core_addr,
+    na_class_t *na_class, na_addr_t *na_addr)
+{
+#ifdef NA_HAS_SM
+    if (na_class == hg_core_addr->core_addr.core_class->na_sm_class) {
+        hg_core_addr->core_addr.na_sm_addr = na_addr;
+        hg_core_addr->na_sm_addr_serialize_size =
+            NA_Addr_get_serialize_size(na_class, na_addr);
+        return;
+    }
+#endif
+
+    hg_core_addr->core_addr.na_addr = na_addr;
+    hg_core_addr->na_addr_serialize_size =
+        NA_Addr_get_serialize_size(na_class, na_addr);
+}
+
+/*---------------------------------------------------------------------------*/
+static struct hg_core_private_addr *
+hg_core_addr_cache_lookup(
+    struct hg_core_private_class *hg_core_class, const char *name)
+{
+    struct hg_core_private_addr *hg_core_addr = NULL;
+    hg_hash_table_value_t value;
+
+    hg_thread_rwlock_rdlock(&hg_core_class->addr_cache.lock);
+    value = hg_hash_table_lookup(hg_core_class->addr_cache.table,
+        (hg_hash_table_key_t) (uintptr_t) name);
+    if (value != HG_HASH_TABLE_NULL) {
+        hg_core_addr = (struct hg_core_private_addr *) value;
+        /* Take reference for the caller while holding the lock */
+        hg_atomic_incr32(&hg_core_addr->ref_count);
+    }
+    hg_thread_rwlock_release_rdlock(&hg_core_class->addr_cache.lock);
+
+    return hg_core_addr;
+}
+
+/*---------------------------------------------------------------------------*/
+static hg_return_t
+hg_core_addr_cache_insert(struct hg_core_private_class *hg_core_class,
+    const char *name, struct hg_core_private_addr **hg_core_addr_p)
+{
+    struct hg_core_private_addr *hg_core_addr = *hg_core_addr_p;
+    hg_hash_table_value_t value;
+    char *cache_name = NULL;
+    hg_return_t ret;
+    int rc;
+
+    hg_thread_rwlock_wrlock(&hg_core_class->addr_cache.lock);
+
+    /* Concurrent lookup of the same name may have completed first, keep that
+     * entry so that the name always maps to a single addr */
+    value = hg_hash_table_lookup(hg_core_class->addr_cache.table,
+        (hg_hash_table_key_t) (uintptr_t) name);
+    if (value != HG_HASH_TABLE_NULL) {
+        struct hg_core_private_addr *cached_addr =
+            (struct hg_core_private_addr *) value;
+
+        hg_atomic_incr32(&cached_addr->ref_count);
+        hg_thread_rwlock_release_wrlock(&hg_core_class->addr_cache.lock);
+
+        hg_core_addr_free(hg_core_addr);
+        *hg_core_addr_p = cached_addr;
+
+        return HG_SUCCESS;
+    }
+
+    cache_name = strdup(name);
+    HG_CHECK_SUBSYS_ERROR(addr, cache_name == NULL, unlock, ret, HG_NOMEM,
+        "Could not duplicate name");
+
+    rc = hg_hash_table_insert(hg_core_class->addr_cache.table,
+        (hg_hash_table_key_t) cache_name, (hg_hash_table_value_t) hg_core_addr);
+    HG_CHECK_SUBSYS_ERROR(addr, rc == 0, unlock, ret, HG_NOMEM,
+        "hg_hash_table_insert() failed");
+
+    /* Cache keeps its own reference */
+    hg_core_addr->cache_name = cache_name;
+    hg_atomic_incr32(&hg_core_addr->ref_count);
+
+    hg_thread_rwlock_release_wrlock(&hg_core_class->addr_cache.lock);
 
     return HG_SUCCESS;
 
-error:
-    hg_core_addr_free(hg_core_addr);
+unlock:
+    hg_thread_rwlock_release_wrlock(&hg_core_class->addr_cache.lock);
+    free(cache_name);
 
     return ret;
 }
 
+/*---------------------------------------------------------------------------*/
+static void
+hg_core_addr_cache_remove(struct hg_core_private_addr *hg_core_addr)
+{
+    struct hg_core_private_class *hg_core_class =
+        HG_CORE_ADDR_CLASS(hg_core_addr);
+
+    if (hg_core_class->addr_cache.table == NULL)
+        return;
+
+    hg_thread_rwlock_wrlock(&hg_core_class->addr_cache.lock);
+    if (hg_core_addr->cache_name != NULL) {
+        char *cache_name = hg_core_addr->cache_name;
+
+        /* Key and cache reference are released by the table free functions,
+         * caller still holds a reference to the addr */
+        hg_core_addr->cache_name = NULL;
+        (void) hg_hash_table_remove(
+            hg_core_class->addr_cache.table, (hg_hash_table_key_t) cache_name);
+    }
+    hg_thread_rwlock_release_wrlock(&hg_core_class->addr_cache.lock);
+}
+
+/*---------------------------------------------------------------------------*/
+static void
+hg_core_addr_cache_value_free(hg_hash_table_value_t value)
+{
+    struct hg_core_private_addr *hg_core_addr =
+        (struct hg_core_private_addr *) value;
+
+    hg_core_addr->cache_name = NULL;
+    hg_core_addr_free(hg_core_addr);
+}
+
+/*---------------------------------------------------------------------------*/
+static HG_INLINE int
+hg_core_addr_cache_key_equal(hg_hash_table_key_t key1, hg_hash_table_key_t key2)
+{
+    return strcmp((const char *) key1, (const char *) key2) == 0;
+}
+
+/*---------------------------------------------------------------------------*/
+static HG_INLINE unsigned int
+hg_core_addr_cache_key_hash(hg_hash_table_key_t key)
+{
+    return hg_hash_string((const char *) key);
+}
+
 /*---------------------------------------------------------------------------*/
 static hg_return_t
 hg_core_addr_create(struct hg_core_private_class *hg_core_class,
@@ -2640,6 +3394,9 @@ hg_core_addr_set_remove(struct hg_core_private_addr *hg_core_addr)
 {
     hg_return_t ret;
 
+    /* Removed addrs must be looked up again */
+    hg_core_addr_cache_remove(hg_core_addr);
+
     if (hg_core_addr->core_addr.na_addr != NULL) {
         na_return_t na_ret =
             NA_Addr_set_remove(hg_core_addr->core_addr.core_class->na_class,
@@ -3017,33 +3774,376 @@ hg_core_addr_deserialize(struct hg_core_private_class *hg_core_class,
     }
 
 #ifdef NA_HAS_SM
-    HG_CORE_DECODE(addr, error, ret, buf_ptr, buf_size_left,
-        &hg_core_addr->na_sm_addr_serialize_size, size_t);
+    HG_CORE_DECODE(addr, error, ret, buf_ptr, buf_size_left,
+        &hg_core_addr->na_sm_addr_serialize_size, size_t);
+
+    if (hg_core_addr->na_sm_addr_serialize_size != 0) {
+        na_return_t na_ret =
+            NA_Addr_deserialize(hg_core_class->core_class.na_sm_class,
+                &hg_core_addr->core_addr.na_sm_addr, buf_ptr, buf_size_left);
+        HG_CHECK_SUBSYS_ERROR(addr, na_ret != NA_SUCCESS, error, ret,
+            (hg_return_t) na_ret, "Could not deserialize NA SM address (%s)",
+            NA_Error_to_string(na_ret));
+        /*
+        buf_ptr += hg_core_addr->na_sm_addr_serialize_size;
+        buf_size_left -= hg_core_addr->na_sm_addr_serialize_size;
+        */
+        is_self &=
+            (hg_bool_t) NA_Addr_is_self(hg_core_class->core_class.na_class,
+                hg_core_addr->core_addr.na_addr);
+    }
+#endif
+    hg_core_addr->core_addr.is_self = is_self;
+
+    *hg_core_addr_p = hg_core_addr;
+
+    return HG_SUCCESS;
+
+error:
+    hg_core_addr_free(hg_core_addr);
+
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static hg_size_t
+hg_core_addr_table_get_serialize_size(struct hg_core_private_addr **addrs,
+    size_t count, hg_uint8_t flags)
+{
+    hg_size_t ret = 2 * sizeof(hg_uint32_t) + sizeof(hg_uint64_t);
+    size_t stride, i;
+
+    /* Make sure serialize sizes are cached */
+    for (i = 0; i < count; i++)
+        (void) hg_core_addr_get_serialize_size(addrs[i], flags);
+
+    ret += hg_core_addr_table_section_size(addrs, count, HG_FALSE, &stride);
+
+#ifdef NA_HAS_SM
+    if ((flags & HG_CORE_SM) &&
+        HG_CORE_ADDR_CLASS(addrs[0])->core_class.na_sm_class != NULL)
+        ret += sizeof(na_sm_id_t) +
+               hg_core_addr_table_section_size(addrs, count, HG_TRUE, &stride);
+#endif
+
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static hg_return_t
+hg_core_addr_table_serialize(void *buf, hg_size_t buf_size, hg_uint8_t flags,
+    struct hg_core_private_addr **addrs, size_t count)
+{
+    struct hg_core_private_class *hg_core_class =
+        HG_CORE_ADDR_CLASS(addrs[0]);
+    char *buf_ptr = (char *) buf;
+    hg_size_t buf_size_left = buf_size;
+    hg_uint32_t magic = HG_CORE_ADDR_TABLE_MAGIC;
+    hg_uint32_t version = HG_CORE_ADDR_TABLE_VERSION;
+    hg_uint64_t n = (hg_uint64_t) count;
+    hg_return_t ret;
+
+#ifdef NA_HAS_SM
+    /* SM section is only present if SM is enabled */
+    if (hg_core_class->core_class.na_sm_class == NULL)
+        flags &= (hg_uint8_t) ~HG_CORE_SM;
+#else
+    flags &= (hg_uint8_t) ~HG_CORE_SM;
+    (void) hg_core_class;
+#endif
+
+    /* Version and flags share the second word */
+    version |= (hg_uint32_t) flags << 16;
+
+    HG_CORE_ENCODE(
+        addr, error, ret, buf_ptr, buf_size_left, &magic, hg_uint32_t);
+    HG_CORE_ENCODE(
+        addr, error, ret, buf_ptr, buf_size_left, &version, hg_uint32_t);
+    HG_CORE_ENCODE(addr, error, ret, buf_ptr, buf_size_left, &n, hg_uint64_t);
+
+    ret = hg_core_addr_table_section_serialize(
+        &buf_ptr, &buf_size_left, addrs, count, HG_FALSE);
+    HG_CHECK_SUBSYS_HG_ERROR(
+        addr, error, ret, "Could not serialize NA addresses");
+
+#ifdef NA_HAS_SM
+    if (flags & HG_CORE_SM) {
+        /* SM addresses are local to this host, host ID is encoded once */
+        HG_CORE_ENCODE(addr, error, ret, buf_ptr, buf_size_left,
+            &hg_core_class->host_id, na_sm_id_t);
+
+        ret = hg_core_addr_table_section_serialize(
+            &buf_ptr, &buf_size_left, addrs, count, HG_TRUE);
+        HG_CHECK_SUBSYS_HG_ERROR(
+            addr, error, ret, "Could not serialize NA SM addresses");
+    }
+#endif
+
+    return HG_SUCCESS;
+
+error:
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static hg_return_t
+hg_core_addr_table_deserialize(struct hg_core_private_class *hg_core_class,
+    struct hg_core_private_addr **addrs, size_t count, const void *buf,
+    hg_size_t buf_size)
+{
+    const char *buf_ptr = (const char *) buf;
+    hg_size_t buf_size_left = buf_size;
+    hg_uint32_t magic, version;
+    hg_uint64_t n;
+    hg_uint8_t flags;
+    hg_return_t ret;
+    size_t i;
+
+    for (i = 0; i < count; i++)
+        addrs[i] = NULL;
+
+    HG_CORE_DECODE(
+        addr, error, ret, buf_ptr, buf_size_left, &magic, hg_uint32_t);
+    HG_CHECK_SUBSYS_ERROR(addr, magic != HG_CORE_ADDR_TABLE_MAGIC, error, ret,
+        HG_PROTOCOL_ERROR, "Not an address table (magic 0x%" PRIx32 ")", magic);
+    HG_CORE_DECODE(
+        addr, error, ret, buf_ptr, buf_size_left, &version, hg_uint32_t);
+    flags = (hg_uint8_t) (version >> 16);
+    version &= 0xffff;
+    HG_CHECK_SUBSYS_ERROR(addr, version != HG_CORE_ADDR_TABLE_VERSION, error,
+        ret, HG_PROTONOSUPPORT, "Unsupported address table version %" PRIu32,
+        version);
+    HG_CORE_DECODE(addr, error, ret, buf_ptr, buf_size_left, &n, hg_uint64_t);
+    HG_CHECK_SUBSYS_ERROR(addr, n != (hg_uint64_t) count, error, ret,
+        HG_INVALID_ARG,
+        "Address table count mismatch (got %" PRIu64 ", expected %zu)", n,
+        count);
+
+    for (i = 0; i < count; i++) {
+        ret = hg_core_addr_create(hg_core_class, &addrs[i]);
+        HG_CHECK_SUBSYS_HG_ERROR(
+            addr, error, ret, "Could not create HG core addr");
+    }
+
+    ret = hg_core_addr_table_section_deserialize(
+        &buf_ptr, &buf_size_left, addrs, count, HG_FALSE);
+    HG_CHECK_SUBSYS_HG_ERROR(
+        addr, error, ret, "Could not deserialize NA addresses");
+
+#ifdef NA_HAS_SM
+    if ((flags & HG_CORE_SM) && hg_core_class->core_class.na_sm_class != NULL) {
+        na_sm_id_t host_id;
+
+        HG_CORE_DECODE(
+            addr, error, ret, buf_ptr, buf_size_left, &host_id, na_sm_id_t);
+
+        /* SM addresses of other hosts cannot be used and are skipped */
+        if (NA_SM_Host_id_cmp(host_id, hg_core_class->host_id)) {
+            ret = hg_core_addr_table_section_deserialize(
+                &buf_ptr, &buf_size_left, addrs, count, HG_TRUE);
+            HG_CHECK_SUBSYS_HG_ERROR(
+                addr, error, ret, "Could not deserialize NA SM addresses");
+        }
+    }
+#else
+    (void) flags;
+#endif
+
+    for (i = 0; i < count; i++) {
+#ifdef NA_HAS_SM
+        NA_SM_Host_id_copy(&addrs[i]->host_id, hg_core_class->host_id);
+#endif
+        addrs[i]->core_addr.is_self =
+            (addrs[i]->core_addr.na_addr != NULL) &&
+            NA_Addr_is_self(hg_core_class->core_class.na_class,
+                addrs[i]->core_addr.na_addr);
+    }
+
+    return HG_SUCCESS;
+
+error:
+    for (i = 0; i < count; i++) {
+        hg_core_addr_free(addrs[i]);
+        addrs[i] = NULL;
+    }
+
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static hg_size_t
+hg_core_addr_table_section_size(struct hg_core_private_addr **addrs,
+    size_t count, hg_bool_t sm, size_t *stride_p)
+{
+    hg_size_t var_size = 0;
+    size_t stride = 0, i;
+    hg_bool_t fixed = HG_TRUE;
+
+    for (i = 0; i < count; i++) {
+        size_t size = addrs[i]->na_addr_serialize_size;
+
+#ifdef NA_HAS_SM
+        if (sm)
+            size = addrs[i]->na_sm_addr_serialize_size;
+#else
+        (void) sm;
+#endif
+
+        /* Entries can only be packed without size if they are all equal */
+        if (size == 0 || (i > 0 && size != stride))
+            fixed = HG_FALSE;
+        stride = size;
+        var_size += sizeof(hg_uint32_t) + size;
+    }
+    *stride_p = fixed ? stride : 0;
+
+    return sizeof(hg_uint64_t) + (fixed ? count * stride : var_size);
+}
+
+/*---------------------------------------------------------------------------*/
+static hg_return_t
+hg_core_addr_table_section_serialize(char **buf_ptr_p,
+    hg_size_t *buf_size_left_p, struct hg_core_private_addr **addrs,
+    size_t count, hg_bool_t sm)
+{
+    na_class_t *na_class = HG_CORE_ADDR_CLASS(addrs[0])->core_class.na_class;
+    char *buf_ptr = *buf_ptr_p;
+    hg_size_t buf_size_left = *buf_size_left_p;
+    size_t stride, i;
+    hg_uint64_t stride64;
+    hg_return_t ret;
+
+#ifdef NA_HAS_SM
+    if (sm)
+        na_class = HG_CORE_ADDR_CLASS(addrs[0])->core_class.na_sm_class;
+#else
+    (void) sm;
+#endif
+    (void) hg_core_addr_table_section_size(addrs, count, sm, &stride);
+    stride64 = (hg_uint64_t) stride;
+
+    /* A stride of 0 means that each entry is prefixed by its size */
+    HG_CORE_ENCODE(
+        addr, error, ret, buf_ptr, buf_size_left, &stride64, hg_uint64_t);
+
+    for (i = 0; i < count; i++) {
+        na_addr_t *na_addr = addrs[i]->core_addr.na_addr;
+        size_t size = addrs[i]->na_addr_serialize_size;
+        na_return_t na_ret;
+
+#ifdef NA_HAS_SM
+        if (sm) {
+            na_addr = addrs[i]->core_addr.na_sm_addr;
+            size = addrs[i]->na_sm_addr_serialize_size;
+        }
+#endif
+        if (stride == 0) {
+            hg_uint32_t size32 = (na_addr != NULL) ? (hg_uint32_t) size : 0;
+
+            HG_CORE_ENCODE(
+                addr, error, ret, buf_ptr, buf_size_left, &size32, hg_uint32_t);
+            if (size32 == 0)
+                continue;
+        }
+
+        HG_CHECK_SUBSYS_ERROR(addr, buf_size_left < size, error, ret,
+            HG_OVERFLOW, "Buffer size too small (%" PRIu64 ")", buf_size_left);
+        na_ret = NA_Addr_serialize(na_class, buf_ptr, size, na_addr);
+        HG_CHECK_SUBSYS_ERROR(addr, na_ret != NA_SUCCESS, error, ret,
+            (hg_return_t) na_ret, "Could not serialize NA address (%s)",
+            NA_Error_to_string(na_ret));
+        buf_ptr += size;
+        buf_size_left -= size;
+    }
+
+    *buf_ptr_p = buf_ptr;
+    *buf_size_left_p = buf_size_left;
+
+    return HG_SUCCESS;
+
+error:
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static hg_return_t
+hg_core_addr_table_section_deserialize(const char **buf_ptr_p,
+    hg_size_t *buf_size_left_p, struct hg_core_private_addr **addrs,
+    size_t count, hg_bool_t sm)
+{
+    na_class_t *na_class = HG_CORE_ADDR_CLASS(addrs[0])->core_class.na_class;
+    const char *buf_ptr = *buf_ptr_p;
+    hg_size_t buf_size_left = *buf_size_left_p;
+    na_addr_t **na_addrs = NULL;
+    hg_uint64_t stride;
+    hg_return_t ret;
+    size_t i;
+
+#ifdef NA_HAS_SM
+    if (sm)
+        na_class = HG_CORE_ADDR_CLASS(addrs[0])->core_class.na_sm_class;
+#else
+    (void) sm;
+#endif
 
-    if (hg_core_addr->na_sm_addr_serialize_size != 0) {
-        na_return_t na_ret =
-            NA_Addr_deserialize(hg_core_class->core_class.na_sm_class,
-                &hg_core_addr->core_addr.na_sm_addr, buf_ptr, buf_size_left);
+    HG_CORE_DECODE(
+        addr, error, ret, buf_ptr, buf_size_left, &stride, hg_uint64_t);
+
+    if (stride != 0) {
+        na_return_t na_ret;
+
+        HG_CHECK_SUBSYS_ERROR(addr, buf_size_left / stride < count, error, ret,
+            HG_OVERFLOW, "Buffer size too small (%" PRIu64 ")", buf_size_left);
+
+        na_addrs = (na_addr_t **) malloc(count * sizeof(*na_addrs));
+        HG_CHECK_SUBSYS_ERROR(addr, na_addrs == NULL, error, ret, HG_NOMEM,
+            "Could not allocate array of NA addresses");
+
+        /* Entries are packed, deserialize all of them at once */
+        na_ret = NA_Addr_deserialize_multi(
+            na_class, na_addrs, count, buf_ptr, (size_t) stride);
         HG_CHECK_SUBSYS_ERROR(addr, na_ret != NA_SUCCESS, error, ret,
-            (hg_return_t) na_ret, "Could not deserialize NA SM address (%s)",
+            (hg_return_t) na_ret, "Could not deserialize NA addresses (%s)",
             NA_Error_to_string(na_ret));
-        /*
-        buf_ptr += hg_core_addr->na_sm_addr_serialize_size;
-        buf_size_left -= hg_core_addr->na_sm_addr_serialize_size;
-        */
-        is_self &=
-            (hg_bool_t) NA_Addr_is_self(hg_core_class->core_class.na_class,
-                hg_core_addr->core_addr.na_addr);
+
+        for (i = 0; i < count; i++)
+            hg_core_addr_set_na(addrs[i], na_class, na_addrs[i]);
+        buf_ptr += count * stride;
+        buf_size_left -= count * stride;
+
+        free(na_addrs);
+    } else {
+        for (i = 0; i < count; i++) {
+            na_addr_t *na_addr = NULL;
+            hg_uint32_t size;
+            na_return_t na_ret;
+
+            HG_CORE_DECODE(
+                addr, error, ret, buf_ptr, buf_size_left, &size, hg_uint32_t);
+            if (size == 0)
+                continue;
+            HG_CHECK_SUBSYS_ERROR(addr, buf_size_left < size, error, ret,
+                HG_OVERFLOW, "Buffer size too small (%" PRIu64 ")",
+                buf_size_left);
+
+            na_ret = NA_Addr_deserialize(na_class, &na_addr, buf_ptr, size);
+            HG_CHECK_SUBSYS_ERROR(addr, na_ret != NA_SUCCESS, error, ret,
+                (hg_return_t) na_ret, "Could not deserialize NA address (%s)",
+                NA_Error_to_string(na_ret));
+
+            hg_core_addr_set_na(addrs[i], na_class, na_addr);
+            buf_ptr += size;
+            buf_size_left -= size;
+        }
     }
-#endif
-    hg_core_addr->core_addr.is_self = is_self;
 
-    *hg_core_addr_p = hg_core_addr;
+    *buf_ptr_p = buf_ptr;
+    *buf_size_left_p = buf_size_left;
 
     return HG_SUCCESS;
 
 error:
-    hg_core_addr_free(hg_core_addr);
+    free(na_addrs);
 
     return ret;
 }
@@ -3217,6 +4317,10 @@ hg_core_alloc(struct hg_core_private_context *context,
     /* Default return code */
     hg_core_handle->ret = HG_SUCCESS;
 
+    /* Forward deadline */
+    hg_timer_init(
+        &hg_core_handle->timer, hg_core_forward_timeout_cb, hg_core_handle);
+
     /* Add handle to handle list so that we can track it */
     hg_thread_spin_lock(&context->created_list.lock);
     HG_LIST_INSERT_HEAD(&context->created_list.list, hg_core_handle, created);
@@ -3320,6 +4424,7 @@ hg_core_alloc_na(struct hg_core_private_handle *hg_core_handle,
         NA_Msg_get_unexpected_header_size(na_class);
     hg_core_handle->core_handle.na_out_header_offset =
         NA_Msg_get_expected_header_size(na_class);
+    hg_core_handle->na_inject_size = NA_Msg_get_max_inject_size(na_class);
 
     hg_core_handle->core_handle.out_buf =
         NA_Msg_buf_alloc(na_class, hg_core_handle->core_handle.out_buf_size,
@@ -3374,6 +4479,12 @@ hg_core_free_na(struct hg_core_private_handle *hg_core_handle)
             hg_atomic_decr32(&hg_core_handle->multi_recv_op->ref_count);
             hg_core_handle->multi_recv_op = NULL;
         }
+    } else if (hg_core_handle->batched) {
+        /* Input buffer belongs to batch handle */
+        if (hg_core_handle->batch_handle != NULL) {
+            (void) hg_core_destroy(hg_core_handle->batch_handle);
+            hg_core_handle->batch_handle = NULL;
+        }
     } else {
         NA_Msg_buf_free(hg_core_handle->na_class,
             hg_core_handle->core_handle.in_buf,
@@ -3423,6 +4534,9 @@ hg_core_reset(struct hg_core_private_handle *hg_core_handle)
     hg_core_handle->op_expected_count = 1; /* Default (no response) */
     hg_core_handle->op_completed_count = 0;
     hg_core_handle->no_response = HG_FALSE;
+    hg_core_handle->persistent = HG_FALSE;
+    hg_core_handle->in_header_set = HG_FALSE;
+    hg_core_handle->deadline = HG_FALSE;
 
     /* Free extra data here if needed */
     if (hg_core_class->more_data_cb.release)
@@ -3444,6 +4558,10 @@ hg_core_reset_post(struct hg_core_private_handle *hg_core_handle)
     struct hg_core_multi_recv_op *multi_recv_op = hg_core_handle->multi_recv_op;
     hg_return_t ret;
 
+    /* Handles unpacked from coalesced requests are never posted */
+    if (hg_core_handle->batched)
+        return hg_core_batch_handle_release(hg_core_handle);
+
     /* Reset handle info */
     if (hg_core_handle->core_handle.info.addr != HG_CORE_ADDR_NULL) {
         hg_core_addr_free_na((struct hg_core_private_addr *)
@@ -3626,6 +4744,18 @@ hg_core_release_input(struct hg_core_private_handle *hg_core_handle)
     struct hg_core_multi_recv_op *multi_recv_op = hg_core_handle->multi_recv_op;
     hg_return_t ret;
 
+    /* Release hold on coalesced requests */
+    if (hg_core_handle->batched && hg_core_handle->batch_handle != NULL) {
+        struct hg_core_private_handle *hg_core_batch_handle =
+            hg_core_handle->batch_handle;
+
+        hg_core_handle->core_handle.in_buf = NULL;
+        hg_core_handle->core_handle.in_buf_size = 0;
+        hg_core_handle->batch_handle = NULL;
+
+        return hg_core_destroy(hg_core_batch_handle);
+    }
+
     if (!(hg_atomic_get32(&hg_core_handle->status) & HG_CORE_OP_MULTI_RECV))
         return HG_SUCCESS;
 
@@ -3667,8 +4797,13 @@ error:
 /*---------------------------------------------------------------------------*/
 static hg_return_t
 hg_core_forward(struct hg_core_private_handle *hg_core_handle,
-    hg_core_cb_t callback, void *arg, hg_uint8_t flags, hg_size_t payload_size)
+    hg_core_cb_t callback, void *arg, hg_uint8_t flags, hg_size_t payload_size,
+    unsigned int timeout_ms)
 {
+    struct hg_core_header_request *request =
+        &hg_core_handle->in_header.msg.request;
+    hg_id_t id = hg_core_handle->core_handle.info.id;
+    hg_uint8_t cookie = hg_core_handle->core_handle.info.context->id;
     int32_t status;
     hg_size_t header_size;
     hg_return_t ret = HG_SUCCESS;
@@ -3682,6 +4817,10 @@ hg_core_forward(struct hg_core_private_handle *hg_core_handle,
      * pre-emptively called */
     hg_atomic_incr32(&hg_core_handle->ref_count);
 
+    hg_core_handle->trace_id = hg_core_trace_id_next();
+    HG_TRACE_EVENT(
+        "forward", hg_core_handle, hg_core_handle->trace_id, payload_size);
+
     /* Reset op counts */
     hg_core_handle->op_expected_count = 1; /* Default (no response) */
     hg_core_handle->op_completed_count = 0;
@@ -3714,20 +4853,29 @@ hg_core_forward(struct hg_core_private_handle *hg_core_handle,
     hg_core_handle->request_callback = callback;
     hg_core_handle->request_arg = arg;
 
-    /* Set header */
-    hg_core_handle->in_header.msg.request.id =
-        hg_core_handle->core_handle.info.id;
-    hg_core_handle->in_header.msg.request.flags = flags;
-    /* Set the cookie as origin context ID, so that when the cookie is
-     * unpacked by the target and assigned to HG info context_id, the NA
-     * layer knows which context ID it needs to send the response to. */
-    hg_core_handle->in_header.msg.request.cookie =
-        hg_core_handle->core_handle.info.context->id;
-
-    /* Encode request header */
-    ret = hg_core_proc_header_request(
-        &hg_core_handle->core_handle, &hg_core_handle->in_header, HG_ENCODE);
-    HG_CHECK_SUBSYS_HG_ERROR(rpc, error, ret, "Could not encode header");
+    /* Persistent handles keep the header encoded by a previous forward if
+     * it has not changed */
+    if (!hg_core_handle->persistent || !hg_core_handle->in_header_set ||
+        hg_core_handle->payload != NULL || request->id != id ||
+        request->flags != flags || request->cookie != cookie) {
+        /* Set header */
+        request->id = id;
+        request->flags = flags;
+        /* Set the cookie as origin context ID, so that when the cookie is
+         * unpacked by the target and assigned to HG info context_id, the NA
+         * layer knows which context ID it needs to send the response to. */
+        request->cookie = cookie;
+        hg_core_handle->in_header_set = HG_FALSE;
+
+        /* Encode request header, shared payloads already carry it */
+        if (hg_core_handle->payload == NULL) {
+            ret = hg_core_proc_header_request(&hg_core_handle->core_handle,
+                &hg_core_handle->in_header, HG_ENCODE);
+            HG_CHECK_SUBSYS_HG_ERROR(
+                rpc, error, ret, "Could not encode header");
+            hg_core_handle->in_header_set = HG_TRUE;
+        }
+    }
 
 #ifdef HG_HAS_DEBUG
     /* Increment counter */
@@ -3735,6 +4883,24 @@ hg_core_forward(struct hg_core_private_handle *hg_core_handle,
         HG_CORE_HANDLE_CLASS(hg_core_handle)->counters.rpc_req_sent_count);
 #endif
 
+    /* Arm deadline before posting so that completion always finds it, the
+     * timer holds its own reference to the handle. Local forwards cannot be
+     * canceled and therefore have no deadline. */
+    if (timeout_ms > 0 && !hg_core_handle->is_self) {
+        struct hg_core_private_context *context =
+            HG_CORE_HANDLE_CONTEXT(hg_core_handle);
+        int rc;
+
+        hg_atomic_incr32(&hg_core_handle->ref_count);
+        rc = hg_timer_wheel_add(
+            context->timer_wheel, &hg_core_handle->timer, timeout_ms);
+        if (rc != HG_UTIL_SUCCESS)
+            hg_atomic_decr32(&hg_core_handle->ref_count);
+        HG_CHECK_SUBSYS_ERROR(rpc, rc != HG_UTIL_SUCCESS, error, ret, HG_BUSY,
+            "Could not arm deadline timer");
+        hg_core_handle->deadline = HG_TRUE;
+    }
+
     /* If addr is self, forward locally, otherwise send the encoded buffer
      * through NA and pre-post response */
     ret = hg_core_handle->ops.forward(hg_core_handle);
@@ -3744,6 +4910,12 @@ done:
     return ret;
 
 error:
+    /* Disarm deadline if it was armed */
+    hg_core_forward_timer_del(hg_core_handle);
+
+    /* Release shared payload if any */
+    hg_core_payload_release(hg_core_handle);
+
     /* Handle is no longer in use */
     hg_atomic_set32(&hg_core_handle->status, HG_CORE_OP_COMPLETED);
 
@@ -3753,6 +4925,185 @@ error:
     return ret;
 }
 
+/*---------------------------------------------------------------------------*/
+static void
+hg_core_forward_timeout_cb(void *arg)
+{
+    struct hg_core_private_handle *hg_core_handle =
+        (struct hg_core_private_handle *) arg;
+    hg_return_t ret;
+
+    HG_LOG_SUBSYS_DEBUG(
+        rpc, "Deadline expired on handle %p", (void *) hg_core_handle);
+
+    /* Report HG_TIMEOUT instead of HG_CANCELED to the user callback */
+    hg_atomic_or32(&hg_core_handle->status, HG_CORE_OP_TIMEDOUT);
+
+    ret = hg_core_cancel(hg_core_handle);
+    HG_CHECK_SUBSYS_ERROR_DONE(rpc, ret != HG_SUCCESS,
+        "Could not cancel handle %p", (void *) hg_core_handle);
+
+    /* Release reference held by timer */
+    (void) hg_core_destroy(hg_core_handle);
+}
+
+/*---------------------------------------------------------------------------*/
+static HG_INLINE void
+hg_core_forward_timer_del(struct hg_core_private_handle *hg_core_handle)
+{
+    if (!hg_core_handle->deadline)
+        return;
+    hg_core_handle->deadline = HG_FALSE;
+
+    /* Timer reference is released by whoever disarms it first, the armed
+     * state is only checked under the wheel lock. This also waits for a
+     * concurrent expiration callback so that it cannot act on a later
+     * forward of the same handle. */
+    if (hg_timer_wheel_del(HG_CORE_HANDLE_CONTEXT(hg_core_handle)->timer_wheel,
+            &hg_core_handle->timer))
+        hg_atomic_decr32(&hg_core_handle->ref_count);
+}
+
+/*---------------------------------------------------------------------------*/
+static hg_return_t
+hg_core_forward_payload(struct hg_core_private_handle *hg_core_handle,
+    hg_core_cb_t callback, void *arg, hg_uint8_t flags,
+    struct hg_core_payload *hg_core_payload, hg_size_t payload_size)
+{
+    hg_size_t header_size = hg_core_header_request_get_size() +
+                            hg_core_handle->core_handle.na_in_header_offset;
+    hg_bool_t shared = HG_FALSE;
+    int32_t status;
+    hg_return_t ret;
+
+    /* Input buffer must not be swapped while handle is in use */
+    status = hg_atomic_get32(&hg_core_handle->status);
+    HG_CHECK_SUBSYS_ERROR(rpc,
+        !(status & HG_CORE_OP_COMPLETED) || (status & HG_CORE_OP_QUEUED), error,
+        ret, HG_BUSY, "Attempting to use handle that was not completed");
+    HG_CHECK_SUBSYS_ERROR(rpc, header_size != hg_core_payload->header_size,
+        error, ret, HG_INVALID_ARG, "Payload header size mismatch");
+
+    /* Payload buffer can only be sent as is through the same NA class and if
+     * the request header matches */
+    if (!hg_core_handle->is_self &&
+        hg_core_handle->na_class == hg_core_payload->na_class &&
+        hg_core_handle->core_handle.in_buf_size == hg_core_payload->buf_size) {
+        ret = hg_core_payload_header_set(hg_core_payload,
+            hg_core_handle->core_handle.info.id, flags,
+            hg_core_handle->core_handle.info.context->id, &shared);
+        HG_CHECK_SUBSYS_HG_ERROR(
+            rpc, error, ret, "Could not set payload header");
+    }
+
+    if (shared) {
+        /* Send directly from payload buffer, handle's own input buffer is
+         * restored once the RPC completes */
+        hg_atomic_incr32(&hg_core_payload->ref_count);
+        hg_core_handle->payload = hg_core_payload;
+        hg_core_handle->own_in_buf = hg_core_handle->core_handle.in_buf;
+        hg_core_handle->own_in_buf_plugin_data =
+            hg_core_handle->in_buf_plugin_data;
+        hg_core_handle->core_handle.in_buf = hg_core_payload->buf;
+        hg_core_handle->in_buf_plugin_data = hg_core_payload->buf_plugin_data;
+    } else {
+        HG_CHECK_SUBSYS_ERROR(rpc,
+            header_size + payload_size >
+                hg_core_handle->core_handle.in_buf_size,
+            error, ret, HG_MSGSIZE, "Exceeding input buffer size");
+
+        /* Fallback to copying payload into handle's input buffer */
+        memcpy((char *) hg_core_handle->core_handle.in_buf + header_size,
+            (const char *) hg_core_payload->buf + header_size,
+            (size_t) payload_size);
+    }
+
+    HG_LOG_SUBSYS_DEBUG(rpc, "Forwarding handle (%p) using %s payload (%p)",
+        (void *) hg_core_handle, shared ? "shared" : "copied",
+        (void *) hg_core_payload);
+
+    return hg_core_forward(
+        hg_core_handle, callback, arg, flags, payload_size, 0);
+
+error:
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static hg_return_t
+hg_core_payload_header_set(struct hg_core_payload *hg_core_payload,
+    hg_id_t id, hg_uint8_t flags, hg_uint8_t cookie, hg_bool_t *shared_p)
+{
+    hg_return_t ret = HG_SUCCESS;
+
+    hg_thread_spin_lock(&hg_core_payload->lock);
+
+    if (!hg_core_payload->header_set) {
+        struct hg_core_header hg_core_header;
+        hg_size_t na_header_size = hg_core_payload->header_size -
+                                   hg_core_header_request_get_size();
+
+        /* First forward defines the header, it is encoded before any send is
+         * posted from that buffer */
+        hg_core_header_request_init(&hg_core_header,
+            hg_core_payload->hg_core_class->init_info.checksum_level >
+                HG_CHECKSUM_NONE);
+        hg_core_header.msg.request.id = id;
+        hg_core_header.msg.request.flags = flags;
+        hg_core_header.msg.request.cookie = cookie;
+        ret = hg_core_header_request_proc(HG_ENCODE,
+            (char *) hg_core_payload->buf + na_header_size,
+            hg_core_payload->buf_size - na_header_size, &hg_core_header);
+        hg_core_header_request_finalize(&hg_core_header);
+        HG_CHECK_SUBSYS_HG_ERROR(rpc, unlock, ret, "Could not encode header");
+
+        hg_core_payload->header_id = id;
+        hg_core_payload->header_flags = flags;
+        hg_core_payload->header_cookie = cookie;
+        hg_core_payload->header_set = HG_TRUE;
+        *shared_p = HG_TRUE;
+    } else
+        *shared_p = (hg_core_payload->header_id == id &&
+                     hg_core_payload->header_flags == flags &&
+                     hg_core_payload->header_cookie == cookie);
+
+unlock:
+    hg_thread_spin_unlock(&hg_core_payload->lock);
+
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static HG_INLINE void
+hg_core_payload_release(struct hg_core_private_handle *hg_core_handle)
+{
+    struct hg_core_payload *hg_core_payload = hg_core_handle->payload;
+
+    if (hg_core_payload == NULL)
+        return;
+
+    hg_core_handle->core_handle.in_buf = hg_core_handle->own_in_buf;
+    hg_core_handle->in_buf_plugin_data = hg_core_handle->own_in_buf_plugin_data;
+    hg_core_handle->own_in_buf = NULL;
+    hg_core_handle->own_in_buf_plugin_data = NULL;
+    hg_core_handle->payload = NULL;
+
+    hg_core_payload_free(hg_core_payload);
+}
+
+/*---------------------------------------------------------------------------*/
+static void
+hg_core_payload_free(struct hg_core_payload *hg_core_payload)
+{
+    if (hg_atomic_decr32(&hg_core_payload->ref_count) > 0)
+        return; /* Cannot free yet */
+
+    NA_Msg_buf_free(hg_core_payload->na_class, hg_core_payload->buf,
+        hg_core_payload->buf_plugin_data);
+    hg_thread_spin_destroy(&hg_core_payload->lock);
+    free(hg_core_payload);
+}
+
 /*---------------------------------------------------------------------------*/
 static hg_return_t
 hg_core_forward_self(struct hg_core_private_handle *hg_core_handle)
@@ -3798,6 +5149,20 @@ hg_core_forward_na(struct hg_core_private_handle *hg_core_handle)
     /* Mark handle as posted */
     hg_atomic_or32(&hg_core_handle->status, HG_CORE_OP_POSTED);
 
+    /* Coalesce with other requests to the same target if enabled */
+    if (HG_CORE_HANDLE_CLASS(hg_core_handle)->init_info.coalesce_count > 1) {
+        hg_bool_t added = HG_FALSE;
+
+        ret = hg_core_batch_add(hg_core_handle, &added);
+        HG_CHECK_SUBSYS_HG_ERROR(
+            rpc, error_send, ret, "Could not coalesce request");
+        if (added)
+            return HG_SUCCESS;
+    }
+
+    HG_TRACE_EVENT("na_send_post", hg_core_handle, hg_core_handle->trace_id,
+        hg_core_handle->in_buf_used);
+
     /* Post send (input) */
     na_ret = NA_Msg_send_unexpected(hg_core_handle->na_class,
         hg_core_handle->na_context, hg_core_send_input_cb, hg_core_handle,
@@ -3824,21 +5189,365 @@ error_send:
     } else {
         hg_core_handle->op_expected_count--;
 
-        /* Keep error for return status */
-        hg_atomic_set32(&hg_core_handle->ret_status, (int32_t) ret);
+        /* Keep error for return status */
+        hg_atomic_set32(&hg_core_handle->ret_status, (int32_t) ret);
+
+        /* Mark op as canceled and let it complete */
+        hg_atomic_or32(&hg_core_handle->status, HG_CORE_OP_CANCELED);
+
+        /* Cancel the above posted recv op */
+        na_ret = NA_Cancel(hg_core_handle->na_class, hg_core_handle->na_context,
+            hg_core_handle->na_recv_op_id);
+        HG_CHECK_SUBSYS_ERROR_DONE(rpc, na_ret != NA_SUCCESS,
+            "Could not cancel recv op id (%s)", NA_Error_to_string(na_ret));
+
+        /* Return success here but callback will return canceled */
+        return HG_SUCCESS;
+    }
+}
+
+/*---------------------------------------------------------------------------*/
+static hg_return_t
+hg_core_batch_add(
+    struct hg_core_private_handle *hg_core_handle, hg_bool_t *added_p)
+{
+    struct hg_core_private_context *context =
+        HG_CORE_HANDLE_CONTEXT(hg_core_handle);
+    struct hg_core_batch_queue *batch_queue = &context->batch_queue;
+    struct hg_core_batch *hg_core_batch = NULL, *hg_core_batch_full = NULL;
+    hg_uint32_t coalesce_count =
+        HG_CORE_CONTEXT_CLASS(context)->init_info.coalesce_count;
+    hg_uint8_t context_id = hg_core_handle->core_handle.info.context_id;
+    hg_size_t entry_size = hg_core_handle->in_buf_used -
+                           hg_core_handle->core_handle.na_in_header_offset;
+    hg_uint32_t tag = (hg_uint32_t) hg_core_handle->tag,
+                size = (hg_uint32_t) entry_size;
+    char *buf_ptr;
+    hg_return_t ret;
+
+    /* Requests with extra payload or that do not fit into a batch are sent
+     * directly */
+    if ((hg_core_handle->in_header.msg.request.flags & HG_CORE_MORE_DATA) ||
+        hg_core_handle->core_handle.na_in_header_offset +
+            hg_core_header_request_get_size() +
+            HG_CORE_BATCH_ENTRY_HEADER_SIZE + entry_size >
+        hg_core_handle->core_handle.in_buf_size) {
+        *added_p = HG_FALSE;
+        return HG_SUCCESS;
+    }
+
+    hg_thread_mutex_lock(&batch_queue->mutex);
+
+    /* Look for a batch that is being filled for that target */
+    HG_LIST_FOREACH (hg_core_batch, &batch_queue->pending, entry) {
+        if (hg_core_batch->na_class == hg_core_handle->na_class &&
+            hg_core_batch->na_addr == hg_core_handle->na_addr &&
+            hg_core_batch->context_id == context_id)
+            break;
+    }
+
+    /* Send batch first if request does not fit into it */
+    if (hg_core_batch != NULL &&
+        hg_core_batch->buf_used + HG_CORE_BATCH_ENTRY_HEADER_SIZE +
+                entry_size >
+            hg_core_batch->buf_size) {
+        HG_LIST_REMOVE(hg_core_batch, entry);
+        hg_core_batch->pending = HG_FALSE;
+        hg_atomic_decr32(&batch_queue->pending_count);
+        hg_core_batch_full = hg_core_batch;
+        hg_core_batch = NULL;
+    }
+
+    if (hg_core_batch == NULL) {
+        /* Re-use batch if possible */
+        HG_LIST_FOREACH (hg_core_batch, &batch_queue->free, entry) {
+            if (hg_core_batch->na_class == hg_core_handle->na_class)
+                break;
+        }
+        if (hg_core_batch != NULL)
+            HG_LIST_REMOVE(hg_core_batch, entry);
+        else {
+            ret = hg_core_batch_alloc(context, hg_core_handle->na_class,
+                hg_core_handle->na_context, &hg_core_batch);
+            HG_CHECK_SUBSYS_HG_ERROR(
+                rpc, unlock, ret, "Could not allocate batch");
+        }
+        hg_core_batch->na_addr = hg_core_handle->na_addr;
+        hg_core_batch->context_id = context_id;
+        hg_core_batch->pending = HG_TRUE;
+
+        HG_LIST_INSERT_HEAD(&batch_queue->pending, hg_core_batch, entry);
+        hg_atomic_incr32(&batch_queue->pending_count);
+    }
+
+    /* Append request prefixed by its tag and size */
+    buf_ptr = (char *) hg_core_batch->buf + hg_core_batch->buf_used;
+    memcpy(buf_ptr, &tag, sizeof(tag));
+    buf_ptr += sizeof(tag);
+    memcpy(buf_ptr, &size, sizeof(size));
+    buf_ptr += sizeof(size);
+    memcpy(buf_ptr,
+        (char *) hg_core_handle->core_handle.in_buf +
+            hg_core_handle->core_handle.na_in_header_offset,
+        entry_size);
+    hg_core_batch->buf_used += HG_CORE_BATCH_ENTRY_HEADER_SIZE + entry_size;
+    hg_core_batch->handles[hg_core_batch->count++] = hg_core_handle;
+    hg_core_handle->batch = hg_core_batch;
+
+    /* Send batch once full */
+    if (hg_core_batch->count == coalesce_count) {
+        HG_LIST_REMOVE(hg_core_batch, entry);
+        hg_core_batch->pending = HG_FALSE;
+        hg_atomic_decr32(&batch_queue->pending_count);
+    } else
+        hg_core_batch = NULL;
+
+    hg_thread_mutex_unlock(&batch_queue->mutex);
+
+    HG_LOG_SUBSYS_DEBUG(rpc, "Coalesced request of handle %p, tag=%u",
+        (void *) hg_core_handle, hg_core_handle->tag);
+
+    if (hg_core_batch_full != NULL)
+        hg_core_batch_send(hg_core_batch_full);
+    if (hg_core_batch != NULL)
+        hg_core_batch_send(hg_core_batch);
+
+    *added_p = HG_TRUE;
+
+    return HG_SUCCESS;
+
+unlock:
+    hg_thread_mutex_unlock(&batch_queue->mutex);
+
+    if (hg_core_batch_full != NULL)
+        hg_core_batch_send(hg_core_batch_full);
+
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static hg_bool_t
+hg_core_batch_remove(
+    struct hg_core_private_handle *hg_core_handle, hg_bool_t *removed_p)
+{
+    struct hg_core_batch_queue *batch_queue =
+        &HG_CORE_HANDLE_CONTEXT(hg_core_handle)->batch_queue;
+    struct hg_core_batch *hg_core_batch;
+    hg_bool_t coalesced;
+
+    *removed_p = HG_FALSE;
+
+    hg_thread_mutex_lock(&batch_queue->mutex);
+    hg_core_batch = hg_core_handle->batch;
+    coalesced = (hg_core_batch != NULL);
+    if (coalesced && hg_core_batch->pending) {
+        char *buf = (char *) hg_core_batch->buf;
+        hg_size_t offset = hg_core_batch->header_size, entry_size;
+        hg_uint32_t size;
+        unsigned int i;
+
+        /* Locate entry of request, each entry is prefixed by tag and size */
+        for (i = 0;; i++) {
+            memcpy(&size, buf + offset + sizeof(hg_uint32_t), sizeof(size));
+            entry_size = HG_CORE_BATCH_ENTRY_HEADER_SIZE + size;
+            if (hg_core_batch->handles[i] == hg_core_handle)
+                break;
+            offset += entry_size;
+        }
+
+        memmove(buf + offset, buf + offset + entry_size,
+            hg_core_batch->buf_used - offset - entry_size);
+        hg_core_batch->buf_used -= entry_size;
+        memmove(&hg_core_batch->handles[i], &hg_core_batch->handles[i + 1],
+            (hg_core_batch->count - i - 1) * sizeof(*hg_core_batch->handles));
+        hg_core_batch->count--;
+        hg_core_handle->batch = NULL;
+
+        /* Batch can be re-used if no request is left */
+        if (hg_core_batch->count == 0) {
+            HG_LIST_REMOVE(hg_core_batch, entry);
+            hg_core_batch->pending = HG_FALSE;
+            hg_core_batch->na_addr = NULL;
+            hg_atomic_decr32(&batch_queue->pending_count);
+            HG_LIST_INSERT_HEAD(&batch_queue->free, hg_core_batch, entry);
+        }
+        *removed_p = HG_TRUE;
+    }
+    hg_thread_mutex_unlock(&batch_queue->mutex);
+
+    return coalesced;
+}
+
+/*---------------------------------------------------------------------------*/
+static hg_return_t
+hg_core_batch_alloc(struct hg_core_private_context *context,
+    na_class_t *na_class, na_context_t *na_context,
+    struct hg_core_batch **hg_core_batch_p)
+{
+    struct hg_core_private_class *hg_core_class =
+        HG_CORE_CONTEXT_CLASS(context);
+    struct hg_core_batch *hg_core_batch = NULL;
+    struct hg_core_header hg_core_header;
+    hg_size_t na_header_size = NA_Msg_get_unexpected_header_size(na_class);
+    hg_return_t ret;
+    na_return_t na_ret;
+
+    hg_core_batch = (struct hg_core_batch *) calloc(1, sizeof(*hg_core_batch));
+    HG_CHECK_SUBSYS_ERROR(rpc, hg_core_batch == NULL, error, ret, HG_NOMEM,
+        "Could not allocate batch");
+    hg_core_batch->context = context;
+    hg_core_batch->na_class = na_class;
+    hg_core_batch->na_context = na_context;
+
+    hg_core_batch->handles = (struct hg_core_private_handle **) malloc(
+        hg_core_class->init_info.coalesce_count *
+        sizeof(*hg_core_batch->handles));
+    HG_CHECK_SUBSYS_ERROR(rpc, hg_core_batch->handles == NULL, error, ret,
+        HG_NOMEM, "Could not allocate array of coalesced handles");
+
+    hg_core_batch->buf_size = NA_Msg_get_max_unexpected_size(na_class);
+    hg_core_batch->buf = NA_Msg_buf_alloc(na_class, hg_core_batch->buf_size,
+        NA_SEND, &hg_core_batch->buf_plugin_data);
+    HG_CHECK_SUBSYS_ERROR(rpc, hg_core_batch->buf == NULL, error, ret,
+        HG_NOMEM, "Could not allocate buffer for coalesced requests");
+
+    na_ret = NA_Msg_init_unexpected(
+        na_class, hg_core_batch->buf, hg_core_batch->buf_size);
+    HG_CHECK_SUBSYS_ERROR(rpc, na_ret != NA_SUCCESS, error, ret,
+        (hg_return_t) na_ret, "Could not initialize buffer (%s)",
+        NA_Error_to_string(na_ret));
+
+    hg_core_batch->na_op_id = NA_Op_create(na_class, NA_OP_SINGLE);
+    HG_CHECK_SUBSYS_ERROR(rpc, hg_core_batch->na_op_id == NULL, error, ret,
+        HG_NA_ERROR, "Could not create NA op ID");
+
+    /* Request header is the same for all batches, each coalesced request
+     * carries its own header */
+    hg_core_header_request_init(
+        &hg_core_header,
+        hg_core_class->init_info.checksum_level > HG_CHECKSUM_NONE);
+    hg_core_header.msg.request.id = 0;
+    hg_core_header.msg.request.flags = HG_CORE_BATCH;
+    hg_core_header.msg.request.cookie = context->core_context.id;
+    ret = hg_core_header_request_proc(HG_ENCODE,
+        (char *) hg_core_batch->buf + na_header_size,
+        hg_core_batch->buf_size - na_header_size, &hg_core_header);
+    hg_core_header_request_finalize(&hg_core_header);
+    HG_CHECK_SUBSYS_HG_ERROR(rpc, error, ret, "Could not encode header");
+
+    hg_core_batch->header_size =
+        na_header_size + hg_core_header_request_get_size();
+    hg_core_batch->buf_used = hg_core_batch->header_size;
+
+    *hg_core_batch_p = hg_core_batch;
+
+    return HG_SUCCESS;
+
+error:
+    hg_core_batch_free(hg_core_batch);
+
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static void
+hg_core_batch_free(struct hg_core_batch *hg_core_batch)
+{
+    if (hg_core_batch == NULL)
+        return;
+
+    NA_Op_destroy(hg_core_batch->na_class, hg_core_batch->na_op_id);
+    NA_Msg_buf_free(hg_core_batch->na_class, hg_core_batch->buf,
+        hg_core_batch->buf_plugin_data);
+    free(hg_core_batch->handles);
+    free(hg_core_batch);
+}
+
+/*---------------------------------------------------------------------------*/
+static void
+hg_core_batch_send(struct hg_core_batch *hg_core_batch)
+{
+    na_return_t na_ret;
+
+    HG_LOG_SUBSYS_DEBUG(rpc,
+        "Sending batch %p of %u coalesced requests, buf_size=%" PRIu64,
+        (void *) hg_core_batch, hg_core_batch->count, hg_core_batch->buf_used);
+
+    na_ret = NA_Msg_send_unexpected(hg_core_batch->na_class,
+        hg_core_batch->na_context, hg_core_batch_send_cb, hg_core_batch,
+        hg_core_batch->buf, hg_core_batch->buf_used,
+        hg_core_batch->buf_plugin_data, hg_core_batch->na_addr,
+        hg_core_batch->context_id, 0, hg_core_batch->na_op_id);
+    if (na_ret != NA_SUCCESS) {
+        HG_LOG_SUBSYS_ERROR(rpc,
+            "Could not post send for coalesced requests (%s)",
+            NA_Error_to_string(na_ret));
+
+        /* Requests complete with the send error */
+        hg_core_batch_complete(hg_core_batch, na_ret);
+    }
+}
+
+/*---------------------------------------------------------------------------*/
+static void
+hg_core_batch_flush(struct hg_core_private_context *context)
+{
+    struct hg_core_batch_queue *batch_queue = &context->batch_queue;
+    HG_LIST_HEAD(hg_core_batch) batch_list = HG_LIST_HEAD_INITIALIZER(batch);
+
+    hg_thread_mutex_lock(&batch_queue->mutex);
+    while (!HG_LIST_IS_EMPTY(&batch_queue->pending)) {
+        struct hg_core_batch *hg_core_batch =
+            HG_LIST_FIRST(&batch_queue->pending);
+
+        HG_LIST_REMOVE(hg_core_batch, entry);
+        hg_core_batch->pending = HG_FALSE;
+        HG_LIST_INSERT_HEAD(&batch_list, hg_core_batch, entry);
+    }
+    hg_atomic_set32(&batch_queue->pending_count, 0);
+    hg_thread_mutex_unlock(&batch_queue->mutex);
+
+    while (!HG_LIST_IS_EMPTY(&batch_list)) {
+        struct hg_core_batch *hg_core_batch = HG_LIST_FIRST(&batch_list);
+
+        HG_LIST_REMOVE(hg_core_batch, entry);
+        hg_core_batch_send(hg_core_batch);
+    }
+}
+
+/*---------------------------------------------------------------------------*/
+static void
+hg_core_batch_send_cb(const struct na_cb_info *callback_info)
+{
+    hg_core_batch_complete(
+        (struct hg_core_batch *) callback_info->arg, callback_info->ret);
+}
+
+/*---------------------------------------------------------------------------*/
+static void
+hg_core_batch_complete(struct hg_core_batch *hg_core_batch, na_return_t ret)
+{
+    struct hg_core_batch_queue *batch_queue =
+        &hg_core_batch->context->batch_queue;
+    unsigned int i;
 
-        /* Mark op as canceled and let it complete */
-        hg_atomic_or32(&hg_core_handle->status, HG_CORE_OP_CANCELED);
+    /* Requests can no longer be removed from batch */
+    hg_thread_mutex_lock(&batch_queue->mutex);
+    for (i = 0; i < hg_core_batch->count; i++)
+        hg_core_batch->handles[i]->batch = NULL;
+    hg_thread_mutex_unlock(&batch_queue->mutex);
 
-        /* Cancel the above posted recv op */
-        na_ret = NA_Cancel(hg_core_handle->na_class, hg_core_handle->na_context,
-            hg_core_handle->na_recv_op_id);
-        HG_CHECK_SUBSYS_ERROR_DONE(rpc, na_ret != NA_SUCCESS,
-            "Could not cancel recv op id (%s)", NA_Error_to_string(na_ret));
+    for (i = 0; i < hg_core_batch->count; i++)
+        hg_core_send_input_complete(hg_core_batch->handles[i], ret);
 
-        /* Return success here but callback will return canceled */
-        return HG_SUCCESS;
-    }
+    /* Batch can be re-used */
+    hg_core_batch->count = 0;
+    hg_core_batch->buf_used = hg_core_batch->header_size;
+    hg_core_batch->na_addr = NULL;
+
+    hg_thread_mutex_lock(&batch_queue->mutex);
+    HG_LIST_INSERT_HEAD(&batch_queue->free, hg_core_batch, entry);
+    hg_thread_mutex_unlock(&batch_queue->mutex);
 }
 
 /*---------------------------------------------------------------------------*/
@@ -3857,6 +5566,9 @@ hg_core_respond(struct hg_core_private_handle *hg_core_handle,
     /* Reset handle ret */
     hg_core_handle->ret = HG_SUCCESS;
 
+    HG_TRACE_EVENT(
+        "respond", hg_core_handle, hg_core_handle->trace_id, payload_size);
+
     /* Reset status */
     hg_atomic_and32(&hg_core_handle->status, ~HG_CORE_OP_COMPLETED);
     hg_atomic_set32(&hg_core_handle->ret_status, (int32_t) hg_core_handle->ret);
@@ -3998,6 +5710,23 @@ hg_core_respond_na(struct hg_core_private_handle *hg_core_handle)
     /* Mark handle as posted */
     hg_atomic_or32(&hg_core_handle->status, HG_CORE_OP_POSTED);
 
+    /* Small responses that are not followed by an ack complete in place */
+    if (!ack_recv_posted &&
+        hg_core_handle->out_buf_used <= hg_core_handle->na_inject_size) {
+        na_ret = NA_Msg_send_expected_inject(hg_core_handle->na_class,
+            hg_core_handle->na_context, hg_core_handle->core_handle.out_buf,
+            hg_core_handle->out_buf_used, hg_core_handle->out_buf_plugin_data,
+            hg_core_handle->na_addr,
+            hg_core_handle->core_handle.info.context_id, hg_core_handle->tag);
+        if (na_ret == NA_SUCCESS) {
+            hg_core_complete_op_inline(hg_core_handle);
+            return HG_SUCCESS;
+        }
+        HG_CHECK_SUBSYS_ERROR(rpc, na_ret != NA_AGAIN, error, ret,
+            (hg_return_t) na_ret, "Could not inject output buffer (%s)",
+            NA_Error_to_string(na_ret));
+    }
+
     /* Post expected send (output) */
     na_ret = NA_Msg_send_expected(hg_core_handle->na_class,
         hg_core_handle->na_context, hg_core_send_output_cb, hg_core_handle,
@@ -4062,12 +5791,20 @@ hg_core_no_respond_na(struct hg_core_private_handle *hg_core_handle)
 static HG_INLINE void
 hg_core_send_input_cb(const struct na_cb_info *callback_info)
 {
-    struct hg_core_private_handle *hg_core_handle =
-        (struct hg_core_private_handle *) callback_info->arg;
+    hg_core_send_input_complete(
+        (struct hg_core_private_handle *) callback_info->arg,
+        callback_info->ret);
+}
 
-    if (callback_info->ret == NA_SUCCESS) {
-        /* Nothing */
-    } else if (callback_info->ret == NA_CANCELED) {
+/*---------------------------------------------------------------------------*/
+static void
+hg_core_send_input_complete(
+    struct hg_core_private_handle *hg_core_handle, na_return_t ret)
+{
+    if (ret == NA_SUCCESS) {
+        HG_TRACE_EVENT("na_send_complete", hg_core_handle,
+            hg_core_handle->trace_id, hg_core_handle->in_buf_used);
+    } else if (ret == NA_CANCELED) {
         HG_CHECK_SUBSYS_WARNING(rpc,
             hg_atomic_get32(&hg_core_handle->status) & HG_CORE_OP_COMPLETED,
             "Operation was completed");
@@ -4075,7 +5812,7 @@ hg_core_send_input_cb(const struct na_cb_info *callback_info)
             rpc, "NA_CANCELED event on handle %p", (void *) hg_core_handle);
 
         hg_atomic_cas32(&hg_core_handle->ret_status, (int32_t) HG_SUCCESS,
-            (int32_t) HG_CANCELED);
+            (int32_t) hg_core_cancel_ret(hg_core_handle));
     } else { /* All other errors */
         int32_t status;
 
@@ -4083,10 +5820,10 @@ hg_core_send_input_cb(const struct na_cb_info *callback_info)
         status = hg_atomic_or32(&hg_core_handle->status, HG_CORE_OP_ERRORED);
 
         /* Keep first non-success ret status */
-        hg_atomic_cas32(&hg_core_handle->ret_status, (int32_t) HG_SUCCESS,
-            (int32_t) callback_info->ret);
-        HG_LOG_SUBSYS_ERROR(rpc, "NA callback returned error (%s)",
-            NA_Error_to_string(callback_info->ret));
+        hg_atomic_cas32(
+            &hg_core_handle->ret_status, (int32_t) HG_SUCCESS, (int32_t) ret);
+        HG_LOG_SUBSYS_ERROR(
+            rpc, "NA callback returned error (%s)", NA_Error_to_string(ret));
 
         if (!(status & HG_CORE_OP_CANCELED) && !hg_core_handle->no_response) {
             na_return_t na_ret;
@@ -4173,8 +5910,12 @@ hg_core_recv_input_cb(const struct na_cb_info *callback_info)
         ret = hg_core_process_input(hg_core_handle);
         HG_CHECK_SUBSYS_HG_ERROR(rpc, error, ret, "Could not process input");
 
-        /* Complete operation */
-        hg_core_complete_op(hg_core_handle);
+        /* Complete operation, handle is only used to carry coalesced requests
+         * that have already been dispatched */
+        if (hg_core_handle->in_header.msg.request.flags & HG_CORE_BATCH)
+            (void) hg_core_destroy(hg_core_handle);
+        else
+            hg_core_complete_op(hg_core_handle);
     } else if (callback_info->ret == NA_CANCELED) {
         HG_CHECK_SUBSYS_WARNING(rpc,
             hg_atomic_get32(&hg_core_handle->status) & HG_CORE_OP_COMPLETED,
@@ -4270,8 +6011,12 @@ hg_core_multi_recv_input_cb(const struct na_cb_info *callback_info)
         ret = hg_core_process_input(hg_core_handle);
         HG_CHECK_SUBSYS_HG_ERROR(rpc, error, ret, "Could not process input");
 
-        /* Complete operation */
-        hg_core_complete_op(hg_core_handle);
+        /* Complete operation, handle is only used to carry coalesced requests
+         * that have already been dispatched */
+        if (hg_core_handle->in_header.msg.request.flags & HG_CORE_BATCH)
+            (void) hg_core_destroy(hg_core_handle);
+        else
+            hg_core_complete_op(hg_core_handle);
     } else if (callback_info->ret == NA_CANCELED) {
         HG_LOG_SUBSYS_DEBUG(
             rpc, "NA_CANCELED event on multi-recv op %d", multi_recv_op->id);
@@ -4317,6 +6062,14 @@ hg_core_process_input(struct hg_core_private_handle *hg_core_handle)
     HG_CHECK_SUBSYS_HG_ERROR(
         rpc, error, ret, "Could not decode request header");
 
+    /* Dispatch coalesced requests */
+    if (hg_core_handle->in_header.msg.request.flags & HG_CORE_BATCH) {
+        HG_CHECK_SUBSYS_ERROR(rpc, hg_core_handle->batched, error, ret,
+            HG_PROTOCOL_ERROR, "Coalesced requests cannot be nested");
+
+        return hg_core_process_batch(hg_core_handle);
+    }
+
     /* Get operation ID from header */
     hg_core_handle->core_handle.info.id =
         hg_core_handle->in_header.msg.request.id;
@@ -4328,6 +6081,10 @@ hg_core_process_input(struct hg_core_private_handle *hg_core_handle)
     hg_core_handle->no_response =
         hg_core_handle->in_header.msg.request.flags & HG_CORE_NO_RESPONSE;
 
+    hg_core_handle->trace_id = hg_core_trace_id_next();
+    HG_TRACE_EVENT("recv", hg_core_handle, hg_core_handle->trace_id,
+        hg_core_handle->in_buf_used);
+
     HG_LOG_SUBSYS_DEBUG(rpc,
         "Processed input for handle %p, ID=%" PRIu64 ", cookie=%" PRIu8
         ", no_response=%d",
@@ -4366,6 +6123,182 @@ error:
     return ret;
 }
 
+/*---------------------------------------------------------------------------*/
+static hg_return_t
+hg_core_process_batch(struct hg_core_private_handle *hg_core_batch_handle)
+{
+    hg_size_t na_header_size =
+        hg_core_batch_handle->core_handle.na_in_header_offset;
+    char *buf_ptr = (char *) hg_core_batch_handle->core_handle.in_buf +
+                    na_header_size + hg_core_header_request_get_size();
+    hg_size_t buf_size_left = hg_core_batch_handle->in_buf_used -
+                              na_header_size -
+                              hg_core_header_request_get_size();
+    unsigned int count = 0;
+    hg_return_t ret;
+
+    while (buf_size_left > 0) {
+        struct hg_core_private_handle *hg_core_handle = NULL;
+        hg_uint32_t tag, size;
+
+        HG_CORE_DECODE(rpc, error, ret, buf_ptr, buf_size_left, &tag,
+            hg_uint32_t);
+        HG_CORE_DECODE(rpc, error, ret, buf_ptr, buf_size_left, &size,
+            hg_uint32_t);
+        HG_CHECK_SUBSYS_ERROR(rpc, buf_size_left < size, error, ret,
+            HG_OVERFLOW, "Coalesced request exceeds message size (%" PRIu32
+            ")", size);
+
+        ret = hg_core_batch_handle_get(hg_core_batch_handle, &hg_core_handle);
+        HG_CHECK_SUBSYS_HG_ERROR(rpc, error, ret,
+            "Could not get handle for coalesced request");
+
+        /* Input buffer points directly to coalesced request, NA header space
+         * is always available in front of it */
+        hg_core_handle->core_handle.in_buf = buf_ptr - na_header_size;
+        hg_core_handle->core_handle.in_buf_size = na_header_size + size;
+        hg_core_handle->in_buf_used = hg_core_handle->core_handle.in_buf_size;
+        hg_core_handle->tag = (na_tag_t) tag;
+        buf_ptr += size;
+        buf_size_left -= size;
+        count++;
+
+        /* Process input information */
+        ret = hg_core_process_input(hg_core_handle);
+        if (ret != HG_SUCCESS) {
+            HG_LOG_SUBSYS_ERROR(rpc,
+                "Could not process coalesced input for handle %p (%d)",
+                (void *) hg_core_handle, (int) ret);
+
+            /* Mark handle as errored */
+            hg_atomic_or32(&hg_core_handle->status, HG_CORE_OP_ERRORED);
+            hg_atomic_cas32(&hg_core_handle->ret_status, (int32_t) HG_SUCCESS,
+                (int32_t) ret);
+        }
+
+        /* Complete operation */
+        hg_core_complete_op(hg_core_handle);
+    }
+
+    HG_LOG_SUBSYS_DEBUG(rpc, "Unpacked %u coalesced requests from handle %p",
+        count, (void *) hg_core_batch_handle);
+
+    return HG_SUCCESS;
+
+error:
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static hg_return_t
+hg_core_batch_handle_get(struct hg_core_private_handle *hg_core_batch_handle,
+    struct hg_core_private_handle **hg_core_handle_p)
+{
+    struct hg_core_private_context *context =
+        HG_CORE_HANDLE_CONTEXT(hg_core_batch_handle);
+    struct hg_core_private_handle *hg_core_handle;
+    struct hg_core_private_addr *hg_core_addr;
+    na_addr_t *na_addr = NULL;
+    hg_return_t ret;
+    na_return_t na_ret;
+
+    hg_thread_spin_lock(&context->batch_handle_list.lock);
+    hg_core_handle = HG_LIST_FIRST(&context->batch_handle_list.list);
+    if (hg_core_handle != NULL)
+        HG_LIST_REMOVE(hg_core_handle, pending);
+    hg_thread_spin_unlock(&context->batch_handle_list.lock);
+
+    if (hg_core_handle == NULL) {
+        /* Input buffers are never allocated for these handles */
+        ret = hg_core_create(context, hg_core_batch_handle->na_class,
+            hg_core_batch_handle->na_context,
+            HG_CORE_HANDLE_LISTEN | HG_CORE_HANDLE_MULTI_RECV, &hg_core_handle);
+        HG_CHECK_SUBSYS_HG_ERROR(
+            rpc, error, ret, "Could not create HG core handle");
+
+        /* Reset status */
+        hg_atomic_set32(&hg_core_handle->status, 0);
+        hg_atomic_set32(&hg_core_handle->ret_status, (int32_t) HG_SUCCESS);
+
+        ret = hg_core_addr_create(
+            HG_CORE_CONTEXT_CLASS(context), &hg_core_addr);
+        HG_CHECK_SUBSYS_HG_ERROR(rpc, error, ret, "Could not create HG addr");
+        hg_core_handle->core_handle.info.addr = (hg_core_addr_t) hg_core_addr;
+
+        hg_core_handle->batched = HG_TRUE;
+        hg_core_handle->reuse = HG_TRUE;
+    }
+
+    /* Each request keeps its own reference to the source addr */
+    na_ret = NA_Addr_dup(
+        hg_core_handle->na_class, hg_core_batch_handle->na_addr, &na_addr);
+    HG_CHECK_SUBSYS_ERROR(rpc, na_ret != NA_SUCCESS, error, ret,
+        (hg_return_t) na_ret, "Could not duplicate source addr (%s)",
+        NA_Error_to_string(na_ret));
+    hg_core_handle->na_addr = na_addr;
+#ifdef NA_HAS_SM
+    if (hg_core_handle->na_class ==
+        hg_core_handle->core_handle.info.core_class->na_sm_class)
+        hg_core_handle->core_handle.info.addr->na_sm_addr = na_addr;
+    else
+#endif
+        hg_core_handle->core_handle.info.addr->na_addr = na_addr;
+
+    /* Hold on to coalesced requests until handle is released */
+    hg_atomic_incr32(&hg_core_batch_handle->ref_count);
+    hg_core_handle->batch_handle = hg_core_batch_handle;
+
+    *hg_core_handle_p = hg_core_handle;
+
+    return HG_SUCCESS;
+
+error:
+    if (hg_core_handle != NULL) {
+        hg_core_handle->reuse = HG_FALSE;
+        (void) hg_core_destroy(hg_core_handle);
+    }
+
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static hg_return_t
+hg_core_batch_handle_release(struct hg_core_private_handle *hg_core_handle)
+{
+    struct hg_core_private_context *context =
+        HG_CORE_HANDLE_CONTEXT(hg_core_handle);
+    struct hg_core_private_handle *hg_core_batch_handle =
+        hg_core_handle->batch_handle;
+
+    /* Reset handle info */
+    hg_core_addr_free_na(
+        (struct hg_core_private_addr *) hg_core_handle->core_handle.info.addr);
+    hg_core_handle->na_addr = NULL;
+    hg_core_handle->core_handle.info.id = 0;
+
+    /* Reset the handle */
+    hg_core_reset(hg_core_handle);
+
+    /* Also reset additional handle parameters */
+    hg_atomic_set32(&hg_core_handle->ref_count, 1);
+    hg_core_handle->core_handle.rpc_info = NULL;
+    hg_core_handle->core_handle.in_buf = NULL;
+    hg_core_handle->core_handle.in_buf_size = 0;
+    hg_core_handle->batch_handle = NULL;
+
+    /* Reset status */
+    hg_atomic_set32(&hg_core_handle->status, 0);
+    hg_atomic_set32(&hg_core_handle->ret_status, (int32_t) hg_core_handle->ret);
+
+    hg_thread_spin_lock(&context->batch_handle_list.lock);
+    HG_LIST_INSERT_HEAD(
+        &context->batch_handle_list.list, hg_core_handle, pending);
+    hg_thread_spin_unlock(&context->batch_handle_list.lock);
+
+    /* Release hold on coalesced requests (if not released early) */
+    return hg_core_destroy(hg_core_batch_handle);
+}
+
 /*---------------------------------------------------------------------------*/
 static HG_INLINE void
 hg_core_send_output_cb(const struct na_cb_info *callback_info)
@@ -4374,7 +6307,8 @@ hg_core_send_output_cb(const struct na_cb_info *callback_info)
         (struct hg_core_private_handle *) callback_info->arg;
 
     if (callback_info->ret == NA_SUCCESS) {
-        /* Nothing */
+        HG_TRACE_EVENT("na_send_complete", hg_core_handle,
+            hg_core_handle->trace_id, hg_core_handle->out_buf_used);
     } else if (callback_info->ret == NA_CANCELED) {
         HG_CHECK_SUBSYS_WARNING(rpc,
             hg_atomic_get32(&hg_core_handle->status) & HG_CORE_OP_COMPLETED,
@@ -4383,7 +6317,7 @@ hg_core_send_output_cb(const struct na_cb_info *callback_info)
             rpc, "NA_CANCELED event on handle %p", (void *) hg_core_handle);
 
         hg_atomic_cas32(&hg_core_handle->ret_status, (int32_t) HG_SUCCESS,
-            (int32_t) HG_CANCELED);
+            (int32_t) hg_core_cancel_ret(hg_core_handle));
     } else {
         /* Mark handle as errored */
         hg_atomic_or32(&hg_core_handle->status, HG_CORE_OP_ERRORED);
@@ -4410,6 +6344,9 @@ hg_core_recv_output_cb(const struct na_cb_info *callback_info)
     if (callback_info->ret == NA_SUCCESS) {
         HG_LOG_SUBSYS_DEBUG(rpc, "Processing output for handle %p, tag=%u",
             (void *) hg_core_handle, hg_core_handle->tag);
+        HG_TRACE_EVENT("na_recv_complete", hg_core_handle,
+            hg_core_handle->trace_id,
+            callback_info->info.recv_expected.actual_buf_size);
 
         /* Process output information */
         ret = hg_core_process_output(hg_core_handle, hg_core_send_ack);
@@ -4423,7 +6360,7 @@ hg_core_recv_output_cb(const struct na_cb_info *callback_info)
             rpc, "NA_CANCELED event on handle %p", (void *) hg_core_handle);
 
         hg_atomic_cas32(&hg_core_handle->ret_status, (int32_t) HG_SUCCESS,
-            (int32_t) HG_CANCELED);
+            (int32_t) hg_core_cancel_ret(hg_core_handle));
     } else
         HG_GOTO_SUBSYS_ERROR(rpc, error, ret, (hg_return_t) callback_info->ret,
             "NA callback returned error (%s)",
@@ -4551,6 +6488,21 @@ hg_core_send_ack(hg_core_handle_t handle, hg_return_t ret)
             NA_Error_to_string(na_ret));
     }
 
+    /* Acks are small enough to be injected and complete in place */
+    if (buf_size <= hg_core_handle->na_inject_size) {
+        na_ret = NA_Msg_send_expected_inject(hg_core_handle->na_class,
+            hg_core_handle->na_context, hg_core_handle->ack_buf, buf_size,
+            hg_core_handle->ack_buf_plugin_data, hg_core_handle->na_addr,
+            hg_core_handle->core_handle.info.context_id, hg_core_handle->tag);
+        if (na_ret == NA_SUCCESS) {
+            hg_core_complete_op_inline(hg_core_handle);
+            return;
+        }
+        HG_CHECK_SUBSYS_ERROR(rpc, na_ret != NA_AGAIN, error, ret,
+            (hg_return_t) na_ret, "Could not inject ack buffer (%s)",
+            NA_Error_to_string(na_ret));
+    }
+
     /* Post expected send (ack) */
     na_ret = NA_Msg_send_expected(hg_core_handle->na_class,
         hg_core_handle->na_context, hg_core_ack_cb, hg_core_handle,
@@ -4598,7 +6550,7 @@ hg_core_ack_cb(const struct na_cb_info *callback_info)
             rpc, "NA_CANCELED event on handle %p", (void *) hg_core_handle);
 
         hg_atomic_cas32(&hg_core_handle->ret_status, (int32_t) HG_SUCCESS,
-            (int32_t) HG_CANCELED);
+            (int32_t) hg_core_cancel_ret(hg_core_handle));
     } else {
         /* Mark handle as errored */
         hg_atomic_or32(&hg_core_handle->status, HG_CORE_OP_ERRORED);
@@ -4747,14 +6699,43 @@ hg_core_complete_op(struct hg_core_private_handle *hg_core_handle)
      * completed */
     if (op_completed_count == hg_core_handle->op_expected_count) {
         hg_core_complete(hg_core_handle,
-            (hg_return_t) hg_atomic_get32(&hg_core_handle->ret_status));
+            (hg_return_t) hg_atomic_get32(&hg_core_handle->ret_status),
+            hg_core_handle->is_self);
     }
 }
 
 /*---------------------------------------------------------------------------*/
 static HG_INLINE void
-hg_core_complete(struct hg_core_private_handle *hg_core_handle, hg_return_t ret)
+hg_core_complete_op_inline(struct hg_core_private_handle *hg_core_handle)
 {
+    unsigned int op_completed_count = ++hg_core_handle->op_completed_count;
+
+    HG_LOG_SUBSYS_DEBUG(rpc,
+        "Completed %u/%u NA operations in place for handle (%p)",
+        op_completed_count, hg_core_handle->op_expected_count,
+        (void *) hg_core_handle);
+
+    /* No NA completion will be raised for that operation, notify progress
+     * as it may be waiting on NA */
+    if (op_completed_count == hg_core_handle->op_expected_count) {
+        hg_core_complete(hg_core_handle,
+            (hg_return_t) hg_atomic_get32(&hg_core_handle->ret_status),
+            HG_TRUE);
+    }
+}
+
+/*---------------------------------------------------------------------------*/
+static HG_INLINE void
+hg_core_complete(struct hg_core_private_handle *hg_core_handle,
+    hg_return_t ret, hg_bool_t loopback_notify)
+{
+    /* Disarm forward deadline and release shared payload, all NA operations
+     * have completed at this point */
+    if (hg_core_handle->op_type == HG_CORE_FORWARD) {
+        hg_core_forward_timer_del(hg_core_handle);
+        hg_core_payload_release(hg_core_handle);
+    }
+
     /* Mark op id as completed, also mark the operation as queued to track
      * when it will be released from the completion queue. */
     hg_atomic_or32(
@@ -4767,8 +6748,20 @@ hg_core_complete(struct hg_core_private_handle *hg_core_handle, hg_return_t ret)
     hg_core_handle->hg_completion_entry.op_id.hg_core_handle =
         (hg_core_handle_t) hg_core_handle;
 
+    HG_TRACE_EVENT("complete", hg_core_handle, hg_core_handle->trace_id, 0);
+
     hg_core_completion_add(hg_core_handle->core_handle.info.context,
-        &hg_core_handle->hg_completion_entry, hg_core_handle->is_self);
+        &hg_core_handle->hg_completion_entry, loopback_notify);
+}
+
+/*---------------------------------------------------------------------------*/
+hg_uint64_t
+hg_core_trace_id_next(void)
+{
+    if (!HG_TRACE_ACTIVE())
+        return 0;
+
+    return (hg_uint64_t) hg_atomic_incr64(&hg_core_trace_id_g);
 }
 
 /*---------------------------------------------------------------------------*/
@@ -4779,6 +6772,7 @@ hg_core_completion_add(struct hg_core_context *core_context,
     struct hg_core_private_context *context =
         (struct hg_core_private_context *) core_context;
     struct hg_core_completion_queue *backfill_queue = &context->backfill_queue;
+    hg_priority_t priority;
     int rc;
 
 #ifdef HG_HAS_DEBUG
@@ -4787,15 +6781,18 @@ hg_core_completion_add(struct hg_core_context *core_context,
         hg_atomic_incr64(HG_CORE_CONTEXT_CLASS(context)->counters.bulk_count);
 #endif
 
-    rc = hg_atomic_queue_push(context->completion_queue, hg_completion_entry);
+    priority = hg_core_completion_priority(hg_completion_entry);
+    rc = hg_atomic_queue_push(
+        context->completion_queue[priority], hg_completion_entry);
     if (rc != HG_UTIL_SUCCESS) {
         HG_LOG_SUBSYS_WARNING(perf, "Atomic completion queue is full, pushing "
                                     "completion data to backfill queue");
 
         /* Queue is full */
         hg_thread_mutex_lock(&backfill_queue->mutex);
-        HG_QUEUE_PUSH_TAIL(&backfill_queue->queue, hg_completion_entry, entry);
-        hg_atomic_incr32(&backfill_queue->count);
+        HG_QUEUE_PUSH_TAIL(
+            &backfill_queue->queue[priority], hg_completion_entry, entry);
+        hg_atomic_incr32(&backfill_queue->count[priority]);
         hg_thread_mutex_unlock(&backfill_queue->mutex);
     }
 
@@ -4819,6 +6816,125 @@ unlock:
     }
 }
 
+/*---------------------------------------------------------------------------*/
+static HG_INLINE hg_priority_t
+hg_core_completion_priority(
+    const struct hg_completion_entry *hg_completion_entry)
+{
+    /* Address lookups and bulk transfers use the default priority class */
+    if (hg_completion_entry->op_type == HG_RPC &&
+        hg_completion_entry->op_id.hg_core_handle->rpc_info != NULL)
+        return hg_completion_entry->op_id.hg_core_handle->rpc_info->priority;
+    else
+        return HG_PRIORITY_DEFAULT;
+}
+
+/*---------------------------------------------------------------------------*/
+static HG_INLINE hg_bool_t
+hg_core_completion_queue_is_empty(struct hg_core_private_context *context)
+{
+    int i;
+
+    for (i = 0; i < HG_PRIORITY_MAX; i++)
+        if (!hg_atomic_queue_is_empty(context->completion_queue[i]) ||
+            hg_atomic_get32(&context->backfill_queue.count[i]) > 0)
+            return HG_FALSE;
+
+    return HG_TRUE;
+}
+
+/*---------------------------------------------------------------------------*/
+static HG_INLINE hg_bool_t
+hg_core_completion_queue_is_empty_below(
+    struct hg_core_private_context *context, hg_priority_t priority)
+{
+    int i;
+
+    for (i = (int) priority + 1; i < HG_PRIORITY_MAX; i++)
+        if (!hg_atomic_queue_is_empty(context->completion_queue[i]) ||
+            hg_atomic_get32(&context->backfill_queue.count[i]) > 0)
+            return HG_FALSE;
+
+    return HG_TRUE;
+}
+
+/*---------------------------------------------------------------------------*/
+static HG_INLINE struct hg_completion_entry *
+hg_core_completion_pop_priority(
+    struct hg_core_private_context *context, hg_priority_t priority)
+{
+    struct hg_completion_entry *hg_completion_entry;
+    struct hg_core_completion_queue *backfill_queue;
+
+    hg_completion_entry =
+        hg_atomic_queue_pop_mc(context->completion_queue[priority]);
+    if (hg_completion_entry != NULL)
+        return hg_completion_entry;
+
+    /* Check backfill queue, only lock it if this class has entries */
+    backfill_queue = &context->backfill_queue;
+    if (hg_atomic_get32(&backfill_queue->count[priority]) == 0)
+        return NULL;
+
+    hg_thread_mutex_lock(&backfill_queue->mutex);
+    hg_completion_entry = HG_QUEUE_FIRST(&backfill_queue->queue[priority]);
+    if (hg_completion_entry != NULL) {
+        HG_QUEUE_POP_HEAD(&backfill_queue->queue[priority], entry);
+        hg_atomic_decr32(&backfill_queue->count[priority]);
+    }
+    hg_thread_mutex_unlock(&backfill_queue->mutex);
+
+    return hg_completion_entry;
+}
+
+/*---------------------------------------------------------------------------*/
+static struct hg_completion_entry *
+hg_core_completion_pop(struct hg_core_private_context *context)
+{
+    const struct hg_core_init_info *init_info =
+        &HG_CORE_CONTEXT_CLASS(context)->init_info;
+    struct hg_completion_entry *hg_completion_entry;
+    int i;
+
+    /* Walk priority classes from highest to lowest. Unless strict ordering is
+     * requested, a class that has used up its credits yields once to the lower
+     * classes (weighted round-robin) so that they cannot be starved. Credits
+     * are only consumed while lower classes have completions waiting. */
+    for (i = 0; i < HG_PRIORITY_MAX; i++) {
+        if (!init_info->priority_strict && i < HG_PRIORITY_MAX - 1 &&
+            hg_atomic_get32(&context->priority_credits[i]) <= 0) {
+            hg_atomic_set32(&context->priority_credits[i],
+                (int32_t) init_info->priority_weight);
+            continue;
+        }
+
+        hg_completion_entry =
+            hg_core_completion_pop_priority(context, (hg_priority_t) i);
+        if (hg_completion_entry != NULL) {
+            if (init_info->priority_strict || i == HG_PRIORITY_MAX - 1)
+                return hg_completion_entry;
+
+            if (hg_core_completion_queue_is_empty_below(
+                    context, (hg_priority_t) i))
+                hg_atomic_set32(&context->priority_credits[i],
+                    (int32_t) init_info->priority_weight);
+            else
+                hg_atomic_decr32(&context->priority_credits[i]);
+            return hg_completion_entry;
+        }
+    }
+
+    /* Lower classes were empty, do not leave skipped classes idle */
+    for (i = 0; i < HG_PRIORITY_MAX - 1; i++) {
+        hg_completion_entry =
+            hg_core_completion_pop_priority(context, (hg_priority_t) i);
+        if (hg_completion_entry != NULL)
+            return hg_completion_entry;
+    }
+
+    return NULL;
+}
+
 /*---------------------------------------------------------------------------*/
 static hg_return_t
 hg_core_progress(
@@ -4835,6 +6951,15 @@ hg_core_progress(
         hg_bool_t safe_wait = HG_FALSE, progressed = HG_FALSE;
         unsigned int poll_timeout = 0;
 
+        /* Cancel forwards whose deadline expired, cancelation completes
+         * through NA progress below */
+        if (!hg_timer_wheel_is_empty(context->timer_wheel))
+            (void) hg_timer_wheel_expire(context->timer_wheel);
+
+        /* Send coalesced requests that are still pending */
+        if (hg_atomic_get32(&context->batch_queue.pending_count) > 0)
+            hg_core_batch_flush(context);
+
         /* Bypass notifications if timeout_ms is 0 to prevent system calls
          */
         if (timeout_ms == 0) {
@@ -4856,6 +6981,16 @@ hg_core_progress(
             poll_timeout = hg_time_to_ms(hg_time_subtract(deadline, now));
         }
 
+        /* Do not block past the next forward deadline */
+        if (poll_timeout > 0 &&
+            !hg_timer_wheel_is_empty(context->timer_wheel)) {
+            unsigned int timer_timeout =
+                hg_timer_wheel_next_timeout(context->timer_wheel);
+
+            if (timer_timeout < poll_timeout)
+                poll_timeout = timer_timeout;
+        }
+
         /* Only enter blocking wait if it is safe to */
         if (safe_wait) {
             ret = hg_core_poll_wait(context, poll_timeout, &progressed);
@@ -4868,9 +7003,7 @@ hg_core_progress(
         }
 
         /* We progressed or we have something to trigger */
-        if (progressed ||
-            !hg_atomic_queue_is_empty(context->completion_queue) ||
-            hg_atomic_get32(&context->backfill_queue.count) > 0)
+        if (progressed || !hg_core_completion_queue_is_empty(context))
             return HG_SUCCESS;
 
         if (timeout_ms != 0)
@@ -4888,8 +7021,7 @@ static HG_INLINE hg_bool_t
 hg_core_poll_try_wait(struct hg_core_private_context *context)
 {
     /* Something is in one of the completion queues */
-    if (!hg_atomic_queue_is_empty(context->completion_queue) ||
-        (hg_atomic_get32(&context->backfill_queue.count) > 0))
+    if (!hg_core_completion_queue_is_empty(context))
         return HG_FALSE;
 
 #ifdef NA_HAS_SM
@@ -5124,49 +7256,37 @@ hg_core_trigger(struct hg_core_private_context *context,
     while (count < max_count) {
         struct hg_completion_entry *hg_completion_entry = NULL;
 
-        hg_completion_entry = hg_atomic_queue_pop_mc(context->completion_queue);
+        hg_completion_entry = hg_core_completion_pop(context);
         if (!hg_completion_entry) {
             struct hg_core_completion_queue *backfill_queue =
                 &context->backfill_queue;
 
-            /* Check backfill queue */
-            if (hg_atomic_get32(&backfill_queue->count) > 0) {
-                hg_thread_mutex_lock(&backfill_queue->mutex);
-                hg_completion_entry = HG_QUEUE_FIRST(&backfill_queue->queue);
-                HG_QUEUE_POP_HEAD(&backfill_queue->queue, entry);
-                hg_atomic_decr32(&backfill_queue->count);
-                hg_thread_mutex_unlock(&backfill_queue->mutex);
-                if (hg_completion_entry == NULL)
-                    continue; /* Give another change to grab it */
-            } else {
-                /* If something was already processed leave */
-                if (count > 0)
-                    break;
-
-                /* Timeout is 0 so leave */
-                if (!hg_time_less(now, deadline)) {
-                    ret = HG_TIMEOUT;
-                    break;
-                }
-
-                hg_thread_mutex_lock(&backfill_queue->mutex);
-                /* Otherwise wait remaining ms */
-                if (hg_atomic_queue_is_empty(context->completion_queue) &&
-                    hg_atomic_get32(&backfill_queue->count) == 0) {
-                    if (hg_thread_cond_timedwait(&backfill_queue->cond,
-                            &backfill_queue->mutex,
-                            hg_time_to_ms(hg_time_subtract(deadline, now))) !=
-                        HG_UTIL_SUCCESS)
-                        ret = HG_TIMEOUT; /* Timeout occurred so leave */
-                }
-                hg_thread_mutex_unlock(&backfill_queue->mutex);
-                if (ret == HG_TIMEOUT)
-                    break;
-
-                if (timeout_ms != 0)
-                    hg_time_get_current_ms(&now);
-                continue; /* Give another change to grab it */
+            /* If something was already processed leave */
+            if (count > 0)
+                break;
+
+            /* Timeout is 0 so leave */
+            if (!hg_time_less(now, deadline)) {
+                ret = HG_TIMEOUT;
+                break;
+            }
+
+            hg_thread_mutex_lock(&backfill_queue->mutex);
+            /* Otherwise wait remaining ms */
+            if (hg_core_completion_queue_is_empty(context)) {
+                if (hg_thread_cond_timedwait(&backfill_queue->cond,
+                        &backfill_queue->mutex,
+                        hg_time_to_ms(hg_time_subtract(deadline, now))) !=
+                    HG_UTIL_SUCCESS)
+                    ret = HG_TIMEOUT; /* Timeout occurred so leave */
             }
+            hg_thread_mutex_unlock(&backfill_queue->mutex);
+            if (ret == HG_TIMEOUT)
+                break;
+
+            if (timeout_ms != 0)
+                hg_time_get_current_ms(&now);
+            continue; /* Give another change to grab it */
         }
 
         /* Completion queue should not be empty now */
@@ -5251,6 +7371,9 @@ hg_core_trigger_entry(struct hg_core_private_handle *hg_core_handle)
          * after the response is sent */
         hg_atomic_incr32(&hg_core_handle->ref_count);
 
+        HG_TRACE_EVENT(
+            "handler_start", hg_core_handle, hg_core_handle->trace_id, 0);
+
         /* Run RPC callback */
         ret = hg_core_process(hg_core_handle);
         if (ret != HG_SUCCESS && !hg_core_handle->no_response) {
@@ -5311,6 +7434,7 @@ hg_core_trigger_entry(struct hg_core_private_handle *hg_core_handle)
         /* Execute user callback.
          * NB. The handle cannot be destroyed before the callback execution
          * as the user may carry the handle in the callback. */
+        HG_TRACE_EVENT("trigger", hg_core_handle, hg_core_handle->trace_id, 0);
         if (hg_cb)
             hg_cb(&hg_core_cb_info);
     }
@@ -5327,6 +7451,7 @@ done:
 static hg_return_t
 hg_core_cancel(struct hg_core_private_handle *hg_core_handle)
 {
+    hg_bool_t coalesced, removed;
     hg_return_t ret;
     int32_t status;
 
@@ -5344,6 +7469,12 @@ hg_core_cancel(struct hg_core_private_handle *hg_core_handle)
         HG_CORE_OP_CANCELED)
         return HG_SUCCESS;
 
+    /* Coalesced requests have no send operation of their own, a request whose
+     * batch has not been sent yet is removed from it and completes here */
+    coalesced = hg_core_batch_remove(hg_core_handle, &removed);
+    if (removed)
+        hg_core_send_input_complete(hg_core_handle, NA_CANCELED);
+
     /* Cancel all NA operations issued */
     if (hg_core_handle->na_recv_op_id != NULL) {
         na_return_t na_ret = NA_Cancel(hg_core_handle->na_class,
@@ -5353,7 +7484,7 @@ hg_core_cancel(struct hg_core_private_handle *hg_core_handle)
             NA_Error_to_string(na_ret));
     }
 
-    if (hg_core_handle->na_send_op_id != NULL) {
+    if (hg_core_handle->na_send_op_id != NULL && !coalesced) {
         na_return_t na_ret = NA_Cancel(hg_core_handle->na_class,
             hg_core_handle->na_context, hg_core_handle->na_send_op_id);
         HG_CHECK_SUBSYS_ERROR(rpc, na_ret != NA_SUCCESS, error, ret,
@@ -5375,6 +7506,15 @@ error:
     return ret;
 }
 
+/*---------------------------------------------------------------------------*/
+static HG_INLINE hg_return_t
+hg_core_cancel_ret(struct hg_core_private_handle *hg_core_handle)
+{
+    return (hg_atomic_get32(&hg_core_handle->status) & HG_CORE_OP_TIMEDOUT)
+               ? HG_TIMEOUT
+               : HG_CANCELED;
+}
+
 /*---------------------------------------------------------------------------*/
 hg_core_class_t *
 HG_Core_init(const char *na_info_string, hg_bool_t na_listen)
@@ -5435,17 +7575,35 @@ HG_Core_finalize(hg_core_class_t *hg_core_class)
 
     return HG_SUCCESS;
 
-error:
+error:
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+void
+HG_Core_cleanup(void)
+{
+    NA_Cleanup();
+}
+
+/*---------------------------------------------------------------------------*/
+hg_return_t
+HG_Core_trace_dump(const char *file_base)
+{
+    hg_return_t ret = HG_SUCCESS;
+    int rc;
+
+    HG_CHECK_SUBSYS_ERROR(
+        cls, file_base == NULL, done, ret, HG_INVALID_ARG, "NULL file base");
+
+    rc = hg_dlog_dump_trace(&HG_LOG_DEBUG_DLOG(trace), file_base, 1);
+    HG_CHECK_SUBSYS_ERROR(cls, rc != HG_UTIL_SUCCESS, done, ret, HG_FAULT,
+        "Could not dump trace events to %s", file_base);
+
+done:
     return ret;
 }
 
-/*---------------------------------------------------------------------------*/
-void
-HG_Core_cleanup(void)
-{
-    NA_Cleanup();
-}
-
 /*---------------------------------------------------------------------------*/
 hg_return_t
 HG_Core_set_more_data_callback(struct hg_core_class *hg_core_class,
@@ -5708,6 +7866,64 @@ error:
     return NULL;
 }
 
+/*---------------------------------------------------------------------------*/
+hg_return_t
+HG_Core_registered_set_priority(
+    hg_core_class_t *hg_core_class, hg_id_t id, hg_priority_t priority)
+{
+    struct hg_core_private_class *private_class =
+        (struct hg_core_private_class *) hg_core_class;
+    struct hg_core_rpc_info *hg_core_rpc_info = NULL;
+    hg_return_t ret;
+
+    HG_CHECK_SUBSYS_ERROR(cls, hg_core_class == NULL, error, ret,
+        HG_INVALID_ARG, "NULL HG core class");
+    HG_CHECK_SUBSYS_ERROR(cls, (unsigned int) priority >= HG_PRIORITY_MAX,
+        error, ret, HG_INVALID_ARG, "Invalid priority class (%d)",
+        (int) priority);
+
+    hg_core_rpc_info = hg_core_map_lookup(&private_class->rpc_map, &id);
+    HG_CHECK_SUBSYS_ERROR(cls, hg_core_rpc_info == NULL, error, ret, HG_NOENTRY,
+        "Could not find RPC ID (%" PRIu64 ") in RPC map", id);
+
+    HG_LOG_SUBSYS_DEBUG(cls,
+        "Setting priority class of RPC ID (%" PRIu64 ") to %d", id,
+        (int) priority);
+    hg_core_rpc_info->priority = priority;
+
+    return HG_SUCCESS;
+
+error:
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+hg_return_t
+HG_Core_registered_get_priority(
+    hg_core_class_t *hg_core_class, hg_id_t id, hg_priority_t *priority_p)
+{
+    struct hg_core_private_class *private_class =
+        (struct hg_core_private_class *) hg_core_class;
+    struct hg_core_rpc_info *hg_core_rpc_info = NULL;
+    hg_return_t ret;
+
+    HG_CHECK_SUBSYS_ERROR(cls, hg_core_class == NULL, error, ret,
+        HG_INVALID_ARG, "NULL HG core class");
+    HG_CHECK_SUBSYS_ERROR(cls, priority_p == NULL, error, ret, HG_INVALID_ARG,
+        "NULL pointer to priority");
+
+    hg_core_rpc_info = hg_core_map_lookup(&private_class->rpc_map, &id);
+    HG_CHECK_SUBSYS_ERROR(cls, hg_core_rpc_info == NULL, error, ret, HG_NOENTRY,
+        "Could not find RPC ID (%" PRIu64 ") in RPC map", id);
+
+    *priority_p = hg_core_rpc_info->priority;
+
+    return HG_SUCCESS;
+
+error:
+    return ret;
+}
+
 /*---------------------------------------------------------------------------*/
 hg_return_t
 HG_Core_addr_lookup1(hg_core_context_t *context, hg_core_cb_t callback,
@@ -5793,6 +8009,34 @@ error:
     return ret;
 }
 
+/*---------------------------------------------------------------------------*/
+hg_return_t
+HG_Core_addr_lookup_multi(hg_core_class_t *hg_core_class,
+    const char *const *names, hg_size_t count, hg_core_addr_t *addrs)
+{
+    hg_return_t ret;
+
+    HG_CHECK_SUBSYS_ERROR(addr, hg_core_class == NULL, error, ret,
+        HG_INVALID_ARG, "NULL HG core class");
+    HG_CHECK_SUBSYS_ERROR(addr, names == NULL || count == 0, error, ret,
+        HG_INVALID_ARG, "NULL array of lookup names");
+    HG_CHECK_SUBSYS_ERROR(addr, addrs == NULL, error, ret, HG_INVALID_ARG,
+        "NULL array of addresses");
+
+    HG_LOG_SUBSYS_DEBUG(addr, "Looking up %" PRIu64 " addresses", count);
+
+    ret = hg_core_addr_lookup_multi(
+        (struct hg_core_private_class *) hg_core_class, names, (size_t) count,
+        (struct hg_core_private_addr **) addrs);
+    HG_CHECK_SUBSYS_HG_ERROR(
+        addr, error, ret, "Could not lookup %" PRIu64 " addresses", count);
+
+    return HG_SUCCESS;
+
+error:
+    return ret;
+}
+
 /*---------------------------------------------------------------------------*/
 hg_return_t
 HG_Core_addr_free(hg_core_addr_t addr)
@@ -5992,6 +8236,134 @@ error:
     return ret;
 }
 
+/*---------------------------------------------------------------------------*/
+hg_size_t
+HG_Core_addr_table_get_serialize_size(
+    const hg_core_addr_t *addrs, hg_size_t count, unsigned long flags)
+{
+    hg_size_t ret;
+    hg_size_t i;
+
+    HG_CHECK_SUBSYS_ERROR_NORET(addr, addrs == NULL || count == 0, error,
+        "NULL array of HG core addresses");
+    for (i = 0; i < count; i++)
+        HG_CHECK_SUBSYS_ERROR_NORET(
+            addr, addrs[i] == HG_CORE_ADDR_NULL, error, "NULL HG core address");
+
+    ret = hg_core_addr_table_get_serialize_size(
+        (struct hg_core_private_addr **) (uintptr_t) addrs, (size_t) count,
+        flags & 0xff);
+
+    HG_LOG_SUBSYS_DEBUG(addr,
+        "Serialize size is %" PRIu64 " bytes for %" PRIu64 " addresses", ret,
+        count);
+
+    return ret;
+
+error:
+    return 0;
+}
+
+/*---------------------------------------------------------------------------*/
+hg_return_t
+HG_Core_addr_table_serialize(void *buf, hg_size_t buf_size,
+    unsigned long flags, const hg_core_addr_t *addrs, hg_size_t count)
+{
+    hg_return_t ret;
+    hg_size_t i;
+
+    HG_CHECK_SUBSYS_ERROR(addr, buf == NULL, error, ret, HG_INVALID_ARG,
+        "NULL pointer to buffer");
+    HG_CHECK_SUBSYS_ERROR(
+        addr, buf_size == 0, error, ret, HG_INVALID_ARG, "NULL buffer size");
+    HG_CHECK_SUBSYS_ERROR(addr, addrs == NULL || count == 0, error, ret,
+        HG_INVALID_ARG, "NULL array of HG core addresses");
+    for (i = 0; i < count; i++) {
+        HG_CHECK_SUBSYS_ERROR(addr, addrs[i] == HG_CORE_ADDR_NULL, error, ret,
+            HG_INVALID_ARG, "NULL HG core address");
+        HG_CHECK_SUBSYS_ERROR(addr,
+            addrs[i]->core_class != addrs[0]->core_class, error, ret,
+            HG_INVALID_ARG, "Addresses belong to different classes");
+    }
+
+    HG_LOG_SUBSYS_DEBUG(addr, "Serializing %" PRIu64 " addresses", count);
+
+    ret = hg_core_addr_table_serialize(buf, buf_size, flags & 0xff,
+        (struct hg_core_private_addr **) (uintptr_t) addrs, (size_t) count);
+    HG_CHECK_SUBSYS_HG_ERROR(
+        addr, error, ret, "Could not serialize address table");
+
+    return HG_SUCCESS;
+
+error:
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+hg_return_t
+HG_Core_addr_table_get_count(
+    const void *buf, hg_size_t buf_size, hg_size_t *count_p)
+{
+    const char *buf_ptr = (const char *) buf;
+    hg_size_t buf_size_left = buf_size;
+    hg_uint32_t magic, version;
+    hg_uint64_t count;
+    hg_return_t ret;
+
+    HG_CHECK_SUBSYS_ERROR(addr, buf == NULL, error, ret, HG_INVALID_ARG,
+        "NULL pointer to buffer");
+    HG_CHECK_SUBSYS_ERROR(addr, count_p == NULL, error, ret, HG_INVALID_ARG,
+        "NULL pointer to count");
+
+    HG_CORE_DECODE(
+        addr, error, ret, buf_ptr, buf_size_left, &magic, hg_uint32_t);
+    HG_CHECK_SUBSYS_ERROR(addr, magic != HG_CORE_ADDR_TABLE_MAGIC, error, ret,
+        HG_PROTOCOL_ERROR, "Not an address table (magic 0x%" PRIx32 ")", magic);
+    HG_CORE_DECODE(
+        addr, error, ret, buf_ptr, buf_size_left, &version, hg_uint32_t);
+    HG_CORE_DECODE(
+        addr, error, ret, buf_ptr, buf_size_left, &count, hg_uint64_t);
+
+    *count_p = (hg_size_t) count;
+
+    return HG_SUCCESS;
+
+error:
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+hg_return_t
+HG_Core_addr_table_deserialize(hg_core_class_t *hg_core_class,
+    hg_core_addr_t *addrs, hg_size_t count, const void *buf,
+    hg_size_t buf_size)
+{
+    hg_return_t ret;
+
+    HG_CHECK_SUBSYS_ERROR(addr, hg_core_class == NULL, error, ret,
+        HG_INVALID_ARG, "NULL HG core class");
+    HG_CHECK_SUBSYS_ERROR(addr, addrs == NULL || count == 0, error, ret,
+        HG_INVALID_ARG, "NULL array of HG core addresses");
+    HG_CHECK_SUBSYS_ERROR(addr, buf == NULL, error, ret, HG_INVALID_ARG,
+        "NULL pointer to buffer");
+    HG_CHECK_SUBSYS_ERROR(
+        addr, buf_size == 0, error, ret, HG_INVALID_ARG, "NULL buffer size");
+
+    ret = hg_core_addr_table_deserialize(
+        (struct hg_core_private_class *) hg_core_class,
+        (struct hg_core_private_addr **) addrs, (size_t) count, buf, buf_size);
+    HG_CHECK_SUBSYS_HG_ERROR(addr, error, ret,
+        "Could not deserialize address table from (%p, %zu)", buf,
+        (size_t) buf_size);
+
+    HG_LOG_SUBSYS_DEBUG(addr, "Deserialized %" PRIu64 " addresses", count);
+
+    return HG_SUCCESS;
+
+error:
+    return ret;
+}
+
 /*---------------------------------------------------------------------------*/
 hg_return_t
 HG_Core_create(hg_core_context_t *context, hg_core_addr_t addr, hg_id_t id,
@@ -6155,6 +8527,31 @@ error:
     return -1;
 }
 
+/*---------------------------------------------------------------------------*/
+hg_return_t
+HG_Core_set_persistent(hg_core_handle_t handle, hg_bool_t persistent)
+{
+    struct hg_core_private_handle *hg_core_handle =
+        (struct hg_core_private_handle *) handle;
+    hg_return_t ret;
+
+    HG_CHECK_SUBSYS_ERROR(rpc, hg_core_handle == NULL, error, ret,
+        HG_INVALID_ARG, "NULL HG core handle");
+
+    /* Header must not be modified while a forward is in flight */
+    HG_CHECK_SUBSYS_ERROR(rpc,
+        !(hg_atomic_get32(&hg_core_handle->status) & HG_CORE_OP_COMPLETED),
+        error, ret, HG_BUSY, "Cannot change persistent mode, handle in use");
+
+    hg_core_handle->persistent = persistent;
+    hg_core_handle->in_header_set = HG_FALSE;
+
+    return HG_SUCCESS;
+
+error:
+    return ret;
+}
+
 /*---------------------------------------------------------------------------*/
 hg_return_t
 HG_Core_release_input(hg_core_handle_t handle)
@@ -6194,7 +8591,168 @@ HG_Core_forward(hg_core_handle_t handle, hg_core_cb_t callback, void *arg,
         (void *) handle, payload_size);
 
     ret = hg_core_forward((struct hg_core_private_handle *) handle, callback,
-        arg, flags, payload_size);
+        arg, flags, payload_size, 0);
+    HG_CHECK_SUBSYS_HG_ERROR(
+        rpc, error, ret, "Could not forward handle (%p)", (void *) handle);
+
+    return HG_SUCCESS;
+
+error:
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+hg_return_t
+HG_Core_forward_timed(hg_core_handle_t handle, hg_core_cb_t callback,
+    void *arg, hg_uint8_t flags, hg_size_t payload_size,
+    unsigned int timeout_ms)
+{
+    hg_return_t ret;
+
+    HG_CHECK_SUBSYS_ERROR(rpc, handle == HG_CORE_HANDLE_NULL, error, ret,
+        HG_INVALID_ARG, "NULL HG core handle");
+    HG_CHECK_SUBSYS_ERROR(rpc, handle->info.addr == HG_CORE_ADDR_NULL, error,
+        ret, HG_INVALID_ARG, "NULL target addr");
+    HG_CHECK_SUBSYS_ERROR(
+        rpc, handle->info.id == 0, error, ret, HG_INVALID_ARG, "NULL RPC ID");
+
+    HG_LOG_SUBSYS_DEBUG(rpc,
+        "Forwarding handle (%p), payload size is %" PRIu64 ", timeout is %u ms",
+        (void *) handle, payload_size, timeout_ms);
+
+    ret = hg_core_forward((struct hg_core_private_handle *) handle, callback,
+        arg, flags, payload_size, timeout_ms);
+    HG_CHECK_SUBSYS_HG_ERROR(
+        rpc, error, ret, "Could not forward handle (%p)", (void *) handle);
+
+    return HG_SUCCESS;
+
+error:
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+hg_return_t
+HG_Core_payload_create(
+    hg_core_class_t *hg_core_class, hg_core_payload_t *payload_p)
+{
+    struct hg_core_payload *hg_core_payload = NULL;
+    na_class_t *na_class;
+    na_return_t na_ret;
+    hg_return_t ret;
+    int rc;
+
+    HG_CHECK_SUBSYS_ERROR(rpc, hg_core_class == NULL, error, ret,
+        HG_INVALID_ARG, "NULL HG core class");
+    HG_CHECK_SUBSYS_ERROR(rpc, payload_p == NULL, error, ret, HG_INVALID_ARG,
+        "NULL pointer to payload");
+    na_class = hg_core_class->na_class;
+
+    hg_core_payload =
+        (struct hg_core_payload *) calloc(1, sizeof(*hg_core_payload));
+    HG_CHECK_SUBSYS_ERROR(rpc, hg_core_payload == NULL, error, ret, HG_NOMEM,
+        "Could not allocate payload");
+    hg_core_payload->hg_core_class =
+        (struct hg_core_private_class *) hg_core_class;
+    hg_core_payload->na_class = na_class;
+    hg_atomic_init32(&hg_core_payload->ref_count, 1);
+
+    rc = hg_thread_spin_init(&hg_core_payload->lock);
+    HG_CHECK_SUBSYS_ERROR(rpc, rc != HG_UTIL_SUCCESS, error_free, ret,
+        HG_NOMEM, "hg_thread_spin_init() failed");
+
+    /* Same layout as handle input buffers */
+    hg_core_payload->buf_size = NA_Msg_get_max_unexpected_size(na_class);
+    hg_core_payload->header_size = NA_Msg_get_unexpected_header_size(na_class) +
+                                   hg_core_header_request_get_size();
+    hg_core_payload->buf = NA_Msg_buf_alloc(na_class,
+        hg_core_payload->buf_size, NA_SEND, &hg_core_payload->buf_plugin_data);
+    HG_CHECK_SUBSYS_ERROR(rpc, hg_core_payload->buf == NULL, error_lock, ret,
+        HG_NOMEM, "Could not allocate buffer for payload");
+
+    na_ret = NA_Msg_init_unexpected(
+        na_class, hg_core_payload->buf, hg_core_payload->buf_size);
+    HG_CHECK_SUBSYS_ERROR(rpc, na_ret != NA_SUCCESS, error_buf, ret,
+        (hg_return_t) na_ret, "Could not initialize payload buffer (%s)",
+        NA_Error_to_string(na_ret));
+
+    *payload_p = (hg_core_payload_t) hg_core_payload;
+
+    return HG_SUCCESS;
+
+error_buf:
+    NA_Msg_buf_free(
+        na_class, hg_core_payload->buf, hg_core_payload->buf_plugin_data);
+error_lock:
+    hg_thread_spin_destroy(&hg_core_payload->lock);
+error_free:
+    free(hg_core_payload);
+error:
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+hg_return_t
+HG_Core_payload_destroy(hg_core_payload_t payload)
+{
+    if (payload == NULL)
+        return HG_SUCCESS;
+
+    /* Payload is freed once all handles using it have completed */
+    hg_core_payload_free((struct hg_core_payload *) payload);
+
+    return HG_SUCCESS;
+}
+
+/*---------------------------------------------------------------------------*/
+hg_return_t
+HG_Core_payload_get_buf(
+    hg_core_payload_t payload, void **buf_p, hg_size_t *buf_size_p)
+{
+    struct hg_core_payload *hg_core_payload =
+        (struct hg_core_payload *) payload;
+    hg_return_t ret;
+
+    HG_CHECK_SUBSYS_ERROR(rpc, payload == NULL, error, ret, HG_INVALID_ARG,
+        "NULL payload");
+    HG_CHECK_SUBSYS_ERROR(rpc, buf_p == NULL, error, ret, HG_INVALID_ARG,
+        "NULL pointer to buffer");
+
+    /* Space for NA and HG core headers is reserved */
+    *buf_p = (char *) hg_core_payload->buf + hg_core_payload->header_size;
+    if (buf_size_p)
+        *buf_size_p = hg_core_payload->buf_size - hg_core_payload->header_size;
+
+    return HG_SUCCESS;
+
+error:
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+hg_return_t
+HG_Core_forward_payload(hg_core_handle_t handle, hg_core_cb_t callback,
+    void *arg, hg_uint8_t flags, hg_core_payload_t payload,
+    hg_size_t payload_size)
+{
+    hg_return_t ret;
+
+    HG_CHECK_SUBSYS_ERROR(rpc, handle == HG_CORE_HANDLE_NULL, error, ret,
+        HG_INVALID_ARG, "NULL HG core handle");
+    HG_CHECK_SUBSYS_ERROR(rpc, handle->info.addr == HG_CORE_ADDR_NULL, error,
+        ret, HG_INVALID_ARG, "NULL target addr");
+    HG_CHECK_SUBSYS_ERROR(
+        rpc, handle->info.id == 0, error, ret, HG_INVALID_ARG, "NULL RPC ID");
+    HG_CHECK_SUBSYS_ERROR(rpc, payload == NULL, error, ret, HG_INVALID_ARG,
+        "NULL payload");
+
+    HG_LOG_SUBSYS_DEBUG(rpc,
+        "Forwarding handle (%p) with payload (%p), payload size is %" PRIu64,
+        (void *) handle, (void *) payload, payload_size);
+
+    ret = hg_core_forward_payload((struct hg_core_private_handle *) handle,
+        callback, arg, flags, (struct hg_core_payload *) payload,
+        payload_size);
     HG_CHECK_SUBSYS_HG_ERROR(
         rpc, error, ret, "Could not forward handle (%p)", (void *) handle);
 
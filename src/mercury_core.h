@@ -17,11 +17,12 @@
 /* Public Type and Struct Definition */
 /*************************************/
 
-typedef struct hg_core_class hg_core_class_t;     /* Opaque HG core class */
-typedef struct hg_core_context hg_core_context_t; /* Opaque HG core context */
-typedef struct hg_core_addr *hg_core_addr_t;      /* Abstract HG address */
-typedef struct hg_core_handle *hg_core_handle_t;  /* Abstract RPC handle */
-typedef struct hg_core_op_id *hg_core_op_id_t;    /* Abstract operation id */
+typedef struct hg_core_class hg_core_class_t;      /* Opaque HG core class */
+typedef struct hg_core_context hg_core_context_t;  /* Opaque HG core context */
+typedef struct hg_core_addr *hg_core_addr_t;       /* Abstract HG address */
+typedef struct hg_core_handle *hg_core_handle_t;   /* Abstract RPC handle */
+typedef struct hg_core_op_id *hg_core_op_id_t;     /* Abstract operation id */
+typedef struct hg_core_payload *hg_core_payload_t; /* Shared payload */
 
 /* HG info struct */
 struct hg_core_info {
@@ -133,6 +134,19 @@ HG_Core_finalize(hg_core_class_t *hg_core_class);
 HG_PUBLIC void
 HG_Core_cleanup(void);
 
+/**
+ * Dump RPC and bulk lifecycle trace events in Chrome trace-event JSON format
+ * to "file_base-pid.json". Events are only recorded while the "trace" log
+ * sub-system is active at "min_debug" level or higher (e.g.,
+ * HG_LOG_SUBSYS=trace HG_LOG_LEVEL=min_debug).
+ *
+ * \param file_base [IN]        output file basename
+ *
+ * \return HG_SUCCESS or corresponding HG error code
+ */
+HG_PUBLIC hg_return_t
+HG_Core_trace_dump(const char *file_base);
+
 /**
  * Set callback that will be triggered when additional data needs to be
  * transferred and HG_Core_set_more_data() has been called, usually when the
@@ -451,6 +465,35 @@ HG_Core_register_data(hg_core_class_t *hg_core_class, hg_id_t id, void *data,
 HG_PUBLIC void *
 HG_Core_registered_data(hg_core_class_t *hg_core_class, hg_id_t id);
 
+/**
+ * Set the priority class of a registered RPC ID. Completions of RPCs that
+ * belong to a higher priority class are triggered before completions of lower
+ * priority classes, see hg_init_info for the scheduling policy. By default,
+ * RPCs belong to the HG_PRIORITY_DEFAULT class.
+ *
+ * \param hg_core_class [IN]    pointer to HG core class
+ * \param id [IN]               registered function ID
+ * \param priority [IN]         priority class
+ *
+ * \return HG_SUCCESS or corresponding HG error code
+ */
+HG_PUBLIC hg_return_t
+HG_Core_registered_set_priority(
+    hg_core_class_t *hg_core_class, hg_id_t id, hg_priority_t priority);
+
+/**
+ * Retrieve the priority class of a registered RPC ID.
+ *
+ * \param hg_core_class [IN]    pointer to HG core class
+ * \param id [IN]               registered function ID
+ * \param priority_p [OUT]      pointer to priority class
+ *
+ * \return HG_SUCCESS or corresponding HG error code
+ */
+HG_PUBLIC hg_return_t
+HG_Core_registered_get_priority(
+    hg_core_class_t *hg_core_class, hg_id_t id, hg_priority_t *priority_p);
+
 /**
  * Lookup an addr from a peer address/name. Addresses need to be
  * freed by calling HG_Core_addr_free(). After completion, user callback is
@@ -482,6 +525,23 @@ HG_PUBLIC hg_return_t
 HG_Core_addr_lookup2(
     hg_core_class_t *hg_core_class, const char *name, hg_core_addr_t *addr_p);
 
+/**
+ * Lookup an array of addrs from peer addresses/names. Names that resolve to
+ * the same NA class are looked up at once. Either all or none of the
+ * addresses are returned. Addresses need to be freed by calling
+ * HG_Core_addr_free().
+ *
+ * \param hg_core_class [IN]    pointer to HG core class
+ * \param names [IN]            array of lookup names
+ * \param count [IN]            number of names
+ * \param addrs [OUT]           array of abstract addresses
+ *
+ * \return HG_SUCCESS or corresponding HG error code
+ */
+HG_PUBLIC hg_return_t
+HG_Core_addr_lookup_multi(hg_core_class_t *hg_core_class,
+    const char *const *names, hg_size_t count, hg_core_addr_t *addrs);
+
 /**
  * Free the addr from the list of peers.
  *
@@ -628,6 +688,69 @@ HG_PUBLIC hg_return_t
 HG_Core_addr_deserialize(hg_core_class_t *hg_core_class, hg_core_addr_t *addr_p,
     const void *buf, hg_size_t buf_size);
 
+/**
+ * Get size required to serialize an array of addresses into an address table.
+ *
+ * \param addrs [IN]            array of abstract addresses
+ * \param count [IN]            number of addresses
+ * \param flags [IN]            optional flags
+ *
+ * \return Non-negative value
+ */
+HG_PUBLIC hg_size_t
+HG_Core_addr_table_get_serialize_size(
+    const hg_core_addr_t *addrs, hg_size_t count, unsigned long flags);
+
+/**
+ * Serialize an array of addresses into a single address table. Addresses
+ * are encoded back to back without individual headers, information common
+ * to all the addresses (e.g., host ID of SM addresses) is only encoded once.
+ *
+ * \param buf [IN/OUT]          pointer to destination buffer
+ * \param buf_size [IN]         buffer size
+ * \param flags [IN]            optional flags
+ * \param addrs [IN]            array of abstract addresses
+ * \param count [IN]            number of addresses
+ *
+ * \return HG_SUCCESS or corresponding HG error code
+ */
+HG_PUBLIC hg_return_t
+HG_Core_addr_table_serialize(void *buf, hg_size_t buf_size,
+    unsigned long flags, const hg_core_addr_t *addrs, hg_size_t count);
+
+/**
+ * Get the number of addresses contained in an address table.
+ *
+ * \param buf [IN]              pointer to address table
+ * \param buf_size [IN]         buffer size
+ * \param count_p [OUT]         pointer to number of addresses
+ *
+ * \return HG_SUCCESS or corresponding HG error code
+ */
+HG_PUBLIC hg_return_t
+HG_Core_addr_table_get_count(
+    const void *buf, hg_size_t buf_size, hg_size_t *count_p);
+
+/**
+ * Deserialize an address table into an array of addresses. NA addresses are
+ * deserialized at once when possible. SM addresses are only restored if the
+ * table was serialized on the local host. Either all or none of the
+ * addresses are returned. Returned addresses must be freed with
+ * HG_Core_addr_free().
+ *
+ * \param hg_core_class [IN]    pointer to HG core class
+ * \param addrs [OUT]           array of abstract addresses
+ * \param count [IN]            number of addresses (must match table)
+ * \param buf [IN]              pointer to address table
+ * \param buf_size [IN]         buffer size
+ *
+ * \return HG_SUCCESS or corresponding HG error code
+ */
+HG_PUBLIC hg_return_t
+HG_Core_addr_table_deserialize(hg_core_class_t *hg_core_class,
+    hg_core_addr_t *addrs, hg_size_t count, const void *buf,
+    hg_size_t buf_size);
+
 /**
  * Initiate a new HG RPC using the specified function ID and the local/remote
  * target defined by addr. The HG handle created can be used to query input
@@ -691,6 +814,22 @@ HG_Core_ref_incr(hg_core_handle_t handle);
 HG_PUBLIC hg_int32_t
 HG_Core_ref_get(hg_core_handle_t handle);
 
+/**
+ * Mark handle as persistent so that repeated forwards to the same target
+ * re-use the request header that was encoded by the first forward. Only the
+ * tag and the payload size are updated on subsequent forwards, as long as the
+ * RPC ID, flags and origin context are unchanged.
+ *
+ * \remark Persistent mode is cleared by HG_Core_reset().
+ *
+ * \param handle [IN]           HG handle
+ * \param persistent [IN]       enable / disable persistent mode
+ *
+ * \return HG_SUCCESS or corresponding HG error code
+ */
+HG_PUBLIC hg_return_t
+HG_Core_set_persistent(hg_core_handle_t handle, hg_bool_t persistent);
+
 /**
  * Allows upper layers to attach data to an existing HG handle.
  * The free_callback argument allows allocated resources to be released when
@@ -813,6 +952,85 @@ HG_PUBLIC hg_return_t
 HG_Core_forward(hg_core_handle_t handle, hg_core_cb_t callback, void *arg,
     hg_uint8_t flags, hg_size_t payload_size);
 
+/**
+ * Same as HG_Core_forward() but cancel the operation if it has not completed
+ * within \timeout_ms ms, in which case the callback is passed HG_TIMEOUT.
+ * Deadlines are only checked when making progress on the handle's context.
+ *
+ * \param handle [IN]           HG handle
+ * \param callback [IN]         pointer to function callback
+ * \param arg [IN]              pointer to data passed to callback
+ * \param payload_size [IN]     size of payload to send
+ * \param timeout_ms [IN]       timeout (in milliseconds), 0 for no timeout
+ *
+ * \return HG_SUCCESS or corresponding HG error code
+ */
+HG_PUBLIC hg_return_t
+HG_Core_forward_timed(hg_core_handle_t handle, hg_core_cb_t callback,
+    void *arg, hg_uint8_t flags, hg_size_t payload_size,
+    unsigned int timeout_ms);
+
+/**
+ * Create a payload that can be pre-encoded once and forwarded by multiple
+ * handles of that class. The buffer used for encoding must be queried using
+ * HG_Core_payload_get_buf().
+ *
+ * \param hg_core_class [IN]    pointer to HG core class
+ * \param payload_p [OUT]       pointer to payload
+ *
+ * \return HG_SUCCESS or corresponding HG error code
+ */
+HG_PUBLIC hg_return_t
+HG_Core_payload_create(
+    hg_core_class_t *hg_core_class, hg_core_payload_t *payload_p);
+
+/**
+ * Destroy payload. Payload is only freed once all the handles that were
+ * forwarded using it have completed.
+ *
+ * \param payload [IN/OUT]      payload
+ *
+ * \return HG_SUCCESS or corresponding HG error code
+ */
+HG_PUBLIC hg_return_t
+HG_Core_payload_destroy(hg_core_payload_t payload);
+
+/**
+ * Get buffer that can be used to encode payload (space for headers is
+ * already reserved).
+ *
+ * \param payload [IN]          payload
+ * \param buf_p [OUT]           pointer to buffer
+ * \param buf_size_p [OUT]      pointer to buffer size
+ *
+ * \return HG_SUCCESS or corresponding HG error code
+ */
+HG_PUBLIC hg_return_t
+HG_Core_payload_get_buf(
+    hg_core_payload_t payload, void **buf_p, hg_size_t *buf_size_p);
+
+/**
+ * Same as HG_Core_forward() but send payload_size bytes of a payload that was
+ * pre-encoded using HG_Core_payload_get_buf(). The payload buffer is sent as
+ * is and shared by all the handles that use the same RPC ID, flags and origin
+ * context, the request header being encoded in it by the first handle.
+ * Handles that do not match (or that use a different NA class) copy the
+ * payload into their own input buffer instead.
+ *
+ * \param handle [IN]           HG handle
+ * \param callback [IN]         pointer to function callback
+ * \param arg [IN]              pointer to data passed to callback
+ * \param flags [IN]            flags to pass
+ * \param payload [IN]          pre-encoded payload
+ * \param payload_size [IN]     size of payload to send
+ *
+ * \return HG_SUCCESS or corresponding HG error code
+ */
+HG_PUBLIC hg_return_t
+HG_Core_forward_payload(hg_core_handle_t handle, hg_core_cb_t callback,
+    void *arg, hg_uint8_t flags, hg_core_payload_t payload,
+    hg_size_t payload_size);
+
 /**
  * Respond back to the origin. The output buffer, which can be used to encode
  * the response, must first be queried using HG_Core_get_output().
@@ -913,6 +1131,7 @@ struct hg_core_rpc_info {
     void *data;                    /* User data */
     void (*free_callback)(void *); /* User data free callback */
     hg_id_t id;                    /* RPC ID */
+    hg_priority_t priority;        /* Priority class */
 };
 
 /* HG core handle */
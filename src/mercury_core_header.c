@@ -9,7 +9,7 @@
 #include "mercury_error.h"
 
 #ifdef HG_HAS_CHECKSUMS
-#    include <mchecksum.h>
+#    include "mercury_checksum.h"
 #endif
 
 #include "mercury_inet.h"
@@ -21,8 +21,6 @@
 /* Local Macros */
 /****************/
 
-#define HG_CORE_HEADER_CHECKSUM "crc16"
-
 /* Convert values between host and network byte order */
 #define hg_core_header_proc_hg_uint8_t_enc(x)  (x & 0xff)
 #define hg_core_header_proc_hg_uint8_t_dec(x)  (x & 0xff)
@@ -47,8 +45,9 @@
 #ifdef HG_HAS_CHECKSUMS
 #    define HG_CORE_HEADER_CHECKSUM_UPDATE(hg_header, data, type)              \
         do {                                                                   \
-            if (hg_header->checksum != MCHECKSUM_OBJECT_NULL)                  \
-                mchecksum_update(hg_header->checksum, &data, sizeof(type));    \
+            if (hg_header->use_checksum)                                       \
+                hg_header->checksum = hg_checksum_crc32c_update(               \
+                    hg_header->checksum, &data, sizeof(type));                 \
         } while (0)
 #else
 #    define HG_CORE_HEADER_CHECKSUM_UPDATE(hg_header, data, type)
@@ -95,9 +94,8 @@ hg_core_header_request_init(
     struct hg_core_header *hg_core_header, hg_bool_t use_checksum)
 {
 #ifdef HG_HAS_CHECKSUMS
-    /* Create a new checksum (CRC16) */
-    if (use_checksum)
-        mchecksum_init(HG_CORE_HEADER_CHECKSUM, &hg_core_header->checksum);
+    /* Header checksum is a 16-bit truncated CRC32C */
+    hg_core_header->use_checksum = use_checksum;
 #else
     (void) use_checksum;
 #endif
@@ -111,9 +109,8 @@ hg_core_header_response_init(
     struct hg_core_header *hg_core_header, hg_bool_t use_checksum)
 {
 #ifdef HG_HAS_CHECKSUMS
-    /* Create a new checksum (CRC16) */
-    if (use_checksum)
-        mchecksum_init(HG_CORE_HEADER_CHECKSUM, &hg_core_header->checksum);
+    /* Header checksum is a 16-bit truncated CRC32C */
+    hg_core_header->use_checksum = use_checksum;
 #else
     (void) use_checksum;
 #endif
@@ -126,8 +123,7 @@ void
 hg_core_header_request_finalize(struct hg_core_header *hg_core_header)
 {
 #ifdef HG_HAS_CHECKSUMS
-    mchecksum_destroy(hg_core_header->checksum);
-    hg_core_header->checksum = MCHECKSUM_OBJECT_NULL;
+    hg_core_header->use_checksum = HG_FALSE;
 #else
     (void) hg_core_header;
 #endif
@@ -138,8 +134,7 @@ void
 hg_core_header_response_finalize(struct hg_core_header *hg_core_header)
 {
 #ifdef HG_HAS_CHECKSUMS
-    mchecksum_destroy(hg_core_header->checksum);
-    hg_core_header->checksum = MCHECKSUM_OBJECT_NULL;
+    hg_core_header->use_checksum = HG_FALSE;
 #else
     (void) hg_core_header;
 #endif
@@ -155,8 +150,7 @@ hg_core_header_request_reset(struct hg_core_header *hg_core_header)
     hg_core_header->msg.request.protocol = HG_CORE_PROTOCOL_VERSION;
 
 #ifdef HG_HAS_CHECKSUMS
-    if (hg_core_header->checksum != MCHECKSUM_OBJECT_NULL)
-        mchecksum_reset(hg_core_header->checksum);
+    hg_core_header->checksum = HG_CHECKSUM_CRC32C_INIT;
 #endif
 }
 
@@ -168,8 +162,7 @@ hg_core_header_response_reset(struct hg_core_header *hg_core_header)
         sizeof(struct hg_core_header_response));
 
 #ifdef HG_HAS_CHECKSUMS
-    if (hg_core_header->checksum != MCHECKSUM_OBJECT_NULL)
-        mchecksum_reset(hg_core_header->checksum);
+    hg_core_header->checksum = HG_CHECKSUM_CRC32C_INIT;
 #endif
 }
 
@@ -187,8 +180,7 @@ hg_core_header_request_proc(hg_proc_op_t op, void *buf, size_t buf_size,
 
 #ifdef HG_HAS_CHECKSUMS
     /* Reset header checksum first */
-    if (hg_core_header->checksum != MCHECKSUM_OBJECT_NULL)
-        mchecksum_reset(hg_core_header->checksum);
+    hg_core_header->checksum = HG_CHECKSUM_CRC32C_INIT;
 #endif
 
     /* HG byte */
@@ -209,10 +201,10 @@ hg_core_header_request_proc(hg_proc_op_t op, void *buf, size_t buf_size,
         hg_core_header, buf_ptr, header->cookie, hg_uint8_t, op);
 
 #ifdef HG_HAS_CHECKSUMS
-    if (hg_core_header->checksum != MCHECKSUM_OBJECT_NULL) {
+    if (hg_core_header->use_checksum) {
         /* Checksum of header */
-        mchecksum_get(hg_core_header->checksum, &header->hash.header,
-            sizeof(hg_uint16_t), MCHECKSUM_FINALIZE);
+        header->hash.header = (hg_uint16_t) hg_checksum_crc32c_final(
+            hg_core_header->checksum);
 
         if (op == HG_ENCODE) {
             HG_CORE_HEADER_PROC_TYPE(
@@ -221,6 +213,12 @@ hg_core_header_request_proc(hg_proc_op_t op, void *buf, size_t buf_size,
             hg_uint16_t h_hash_header = 0;
 
             HG_CORE_HEADER_PROC_TYPE(buf_ptr, h_hash_header, hg_uint16_t, op);
+
+            /* Hash of other protocol versions differs (e.g., CRC16 before
+             * 0x06), let verify report the version mismatch instead */
+            if (header->protocol != HG_CORE_PROTOCOL_VERSION)
+                goto done;
+
             HG_CHECK_ERROR(header->hash.header != h_hash_header, done, ret,
                 HG_CHECKSUM_ERROR,
                 "checksum 0x%04" PRIx16 " does not match (expected 0x%04" PRIx16
@@ -248,8 +246,7 @@ hg_core_header_response_proc(hg_proc_op_t op, void *buf, size_t buf_size,
 
 #ifdef HG_HAS_CHECKSUMS
     /* Reset header checksum first */
-    if (hg_core_header->checksum != MCHECKSUM_OBJECT_NULL)
-        mchecksum_reset(hg_core_header->checksum);
+    hg_core_header->checksum = HG_CHECKSUM_CRC32C_INIT;
 #endif
 
     /* Return code */
@@ -264,10 +261,10 @@ hg_core_header_response_proc(hg_proc_op_t op, void *buf, size_t buf_size,
         hg_core_header, buf_ptr, header->cookie, hg_uint16_t, op);
 
 #ifdef HG_HAS_CHECKSUMS
-    if (hg_core_header->checksum != MCHECKSUM_OBJECT_NULL) {
+    if (hg_core_header->use_checksum) {
         /* Checksum of header */
-        mchecksum_get(hg_core_header->checksum, &header->hash.header,
-            sizeof(hg_uint16_t), MCHECKSUM_FINALIZE);
+        header->hash.header = (hg_uint16_t) hg_checksum_crc32c_final(
+            hg_core_header->checksum);
 
         if (op == HG_ENCODE) {
             HG_CORE_HEADER_PROC_TYPE(
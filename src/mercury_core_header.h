@@ -64,7 +64,8 @@ struct hg_core_header {
         struct hg_core_header_response response;
     } msg;
 #ifdef HG_HAS_CHECKSUMS
-    struct mchecksum_object *checksum; /* Checksum of header */
+    hg_uint32_t checksum;   /* Checksum of header */
+    hg_bool_t use_checksum; /* Checksum header data */
 #endif
 };
 
@@ -89,8 +90,11 @@ struct hg_core_header {
 /* Mercury identifier for packets sent */
 #define HG_CORE_IDENTIFIER (('H' << 1) | ('G')) /* 0xD7 */
 
-/* Mercury protocol version number */
-#define HG_CORE_PROTOCOL_VERSION 0x05
+/* Mercury protocol version number (0x06: header hash is a CRC32C truncated to
+ * 16 bits instead of a CRC16, peers running 0x05 are rejected; 0x07: RPC
+ * input/output headers carry the uncompressed payload size, which shifts the
+ * payload of older peers) */
+#define HG_CORE_PROTOCOL_VERSION 0x07
 
 /*********************/
 /* Public Prototypes */
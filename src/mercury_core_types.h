@@ -26,6 +26,14 @@ typedef enum hg_checksum_level {
                                 headers) */
 } hg_checksum_level_t;
 
+/* RPC priority classes (completions of higher classes are triggered first) */
+typedef enum hg_priority {
+    HG_PRIORITY_HIGH,    /*!< latency-sensitive RPCs (e.g., metadata) */
+    HG_PRIORITY_DEFAULT, /*!< default priority class */
+    HG_PRIORITY_LOW,     /*!< background RPCs */
+    HG_PRIORITY_MAX
+} hg_priority_t;
+
 /**
  * HG init info struct
  * NB. should be initialized using HG_INIT_INFO_INITIALIZER
@@ -92,6 +100,41 @@ struct hg_init_info {
     /* Disable use of multi_recv when available and post separate buffers.
      * Default is: false */
     hg_bool_t no_multi_recv;
+
+    /* Controls how completions of different priority classes are interleaved
+     * when triggered: up to priority_weight completions of a given class are
+     * triggered before one completion of the next lower class is let through.
+     * A value of zero is equivalent to using the internal default value.
+     * Default value is: 16 */
+    hg_uint32_t priority_weight;
+
+    /* Trigger completions in strict priority order, a lower class is only
+     * triggered when all higher classes are empty. Note that this may starve
+     * lower priority classes (priority_weight is ignored when set).
+     * Default is: false */
+    hg_bool_t priority_strict;
+
+    /* Coalesce small RPC requests forwarded to the same target context into
+     * a single unexpected message. Requests are accumulated until either
+     * coalesce_count requests are pending, the message is full, or progress is
+     * made on the context. Targets always accept coalesced requests,
+     * responses are still sent separately. A value of 0 or 1 disables it.
+     * Default is: 0 */
+    hg_uint32_t coalesce_count;
+
+    /* Cache addresses looked up by name so that subsequent lookups of the
+     * same name do not go through NA again. Cached addresses remain
+     * referenced until HG_Addr_set_remove() is called or HG is finalized.
+     * Default is: false */
+    hg_bool_t addr_cache;
+
+    /* Size of the slab that HG_Bulk_buf_alloc() carves buffers out of. The
+     * slab is allocated from huge pages when available and each buffer keeps
+     * its registration, so that bulk handles created over reused buffers need
+     * no registration.
+     * A value of 0 disables the slab.
+     * Default is: 0 */
+    hg_size_t bulk_buf_slab_size;
 };
 
 /* Error return codes:
@@ -184,7 +227,9 @@ typedef enum {
         .request_post_init = 0, .request_post_incr = 0, .auto_sm = HG_FALSE,   \
         .sm_info_string = NULL, .checksum_level = HG_CHECKSUM_NONE,            \
         .no_bulk_eager = HG_FALSE, .no_loopback = HG_FALSE, .stats = HG_FALSE, \
-        .no_multi_recv = HG_FALSE                                              \
+        .no_multi_recv = HG_FALSE, .priority_weight = 0,                       \
+        .priority_strict = HG_FALSE, .coalesce_count = 0,                      \
+        .addr_cache = HG_FALSE, .bulk_buf_slab_size = 0                        \
     }
 
 #endif /* MERCURY_CORE_TYPES_H */
@@ -28,6 +28,13 @@
 #    define HG_LOG_SUBSYS_DEBUG(...) (void) 0
 #endif
 
+/* Lifecycle trace events, recorded when the "trace" subsys is active */
+extern HG_PRIVATE HG_LOG_OUTLET_DECL(trace);
+#define HG_TRACE_ACTIVE()                                                      \
+    (HG_LOG_OUTLET(trace).level >= HG_LOG_LEVEL_MIN_DEBUG)
+#define HG_TRACE_EVENT(event, handle, op_id, size)                             \
+    HG_LOG_EVENT(trace, event, (const void *) (handle), op_id, size)
+
 /* Branch predictor hints */
 #ifndef _WIN32
 #    define likely(x)   __builtin_expect(!!(x), 1)
@@ -85,36 +85,40 @@ hg_header_proc(
 {
 #ifdef HG_HAS_CHECKSUMS
     struct hg_header_hash *header_hash = NULL;
-    void *buf_ptr = buf;
 #endif
+    struct hg_header_comp *header_comp = NULL;
+    void *buf_ptr = buf;
     hg_return_t ret = HG_SUCCESS;
 
-#ifdef HG_HAS_CHECKSUMS
     switch (hg_header->op) {
         case HG_INPUT:
             HG_CHECK_ERROR(buf_size < sizeof(struct hg_header_input), done, ret,
                 HG_INVALID_ARG, "Invalid buffer size");
+#ifdef HG_HAS_CHECKSUMS
             header_hash = &hg_header->msg.input.hash;
+#endif
+            header_comp = &hg_header->msg.input.comp;
             break;
         case HG_OUTPUT:
             HG_CHECK_ERROR(buf_size < sizeof(struct hg_header_output), done,
                 ret, HG_INVALID_ARG, "Invalid buffer size");
+#ifdef HG_HAS_CHECKSUMS
             header_hash = &hg_header->msg.output.hash;
+#endif
+            header_comp = &hg_header->msg.output.comp;
             break;
         default:
             HG_GOTO_ERROR(done, ret, HG_INVALID_ARG, "Invalid header op");
     }
 
+#ifdef HG_HAS_CHECKSUMS
     /* Checksum of user payload */
     HG_HEADER_PROC_TYPE(buf_ptr, header_hash->payload, hg_uint32_t, op);
-
-done:
-#else
-    (void) hg_header;
-    (void) buf;
-    (void) buf_size;
-    (void) op;
 #endif
 
+    /* Size of compressed user payload once decompressed */
+    HG_HEADER_PROC_TYPE(buf_ptr, header_comp->raw_size, hg_uint32_t, op);
+
+done:
     return ret;
 }
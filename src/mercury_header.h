@@ -14,6 +14,10 @@
 /* Public Type and Struct Definition */
 /*************************************/
 
+HG_PACKED(struct hg_header_comp {
+    hg_uint32_t raw_size; /* Uncompressed size (0 if not compressed) */
+});
+
 #ifdef HG_HAS_CHECKSUMS
 HG_PACKED(struct hg_header_hash {
     hg_uint32_t payload; /* Payload checksum (32-bits checksum) */
@@ -21,22 +25,24 @@ HG_PACKED(struct hg_header_hash {
 
 HG_PACKED(struct hg_header_input {
     struct hg_header_hash hash; /* Hash */
-    /* 160 bits here */
+    struct hg_header_comp comp; /* Compression */
+    /* 192 bits here */
 });
 
 HG_PACKED(struct hg_header_output {
     struct hg_header_hash hash; /* Hash */
-    /* 160 bits here */
+    struct hg_header_comp comp; /* Compression */
+    /* 192 bits here */
 });
 #else
 HG_PACKED(struct hg_header_input {
-    hg_uint32_t pad;
-    /* 128 bits here */
+    struct hg_header_comp comp; /* Compression */
+    /* 160 bits here */
 });
 
 HG_PACKED(struct hg_header_output {
-    hg_uint32_t pad;
-    /* 128 bits here */
+    struct hg_header_comp comp; /* Compression */
+    /* 160 bits here */
 });
 #endif
 
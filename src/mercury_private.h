@@ -38,6 +38,7 @@ struct hg_completion_entry {
 };
 
 struct hg_bulk_op_pool;
+struct hg_bulk_slab;
 
 /*****************/
 /* Public Macros */
@@ -81,6 +82,15 @@ hg_core_bulk_decr(hg_core_class_t *hg_core_class);
 HG_PRIVATE struct hg_bulk_op_pool *
 hg_core_context_get_bulk_op_pool(struct hg_core_context *core_context);
 
+HG_PRIVATE struct hg_bulk_slab *
+hg_core_class_get_bulk_slab(hg_core_class_t *core_class);
+
+/**
+ * Get a new ID for lifecycle tracing, 0 if tracing is not active.
+ */
+HG_PRIVATE hg_uint64_t
+hg_core_trace_id_next(void);
+
 /**
  * Add entry to completion queue.
  */
@@ -107,6 +117,13 @@ hg_bulk_op_pool_create(hg_core_context_t *core_context, unsigned int init_count,
 HG_PRIVATE void
 hg_bulk_op_pool_destroy(struct hg_bulk_op_pool *hg_bulk_op_pool);
 
+HG_PRIVATE hg_return_t
+hg_bulk_slab_create(hg_core_class_t *core_class, hg_size_t size,
+    struct hg_bulk_slab **hg_bulk_slab_p);
+
+HG_PRIVATE void
+hg_bulk_slab_destroy(struct hg_bulk_slab *hg_bulk_slab);
+
 #ifdef __cplusplus
 }
 #endif
@@ -9,9 +9,6 @@
 #include "mercury_error.h"
 #include "mercury_mem.h"
 
-#ifdef HG_HAS_CHECKSUMS
-#    include <mchecksum.h>
-#endif
 #include <stdlib.h>
 
 /****************/
@@ -38,9 +35,6 @@ hg_return_t
 hg_proc_create(hg_class_t *hg_class, hg_proc_hash_t hash, hg_proc_t *proc_p)
 {
     struct hg_proc *hg_proc = NULL;
-#ifdef HG_HAS_CHECKSUMS
-    const char *hash_method;
-#endif
     hg_return_t ret;
 
     HG_CHECK_SUBSYS_ERROR(
@@ -53,32 +47,22 @@ hg_proc_create(hg_class_t *hg_class, hg_proc_hash_t hash, hg_proc_t *proc_p)
     hg_proc->hg_class = hg_class;
 
 #ifdef HG_HAS_CHECKSUMS
-    /* Map enum to string */
+    /* Only CRC32C is computed */
     switch (hash) {
-        case HG_CRC16:
-            hash_method = "crc16";
-            break;
         case HG_CRC32:
-            hash_method = "crc32c";
+            hg_proc->checksum_size = sizeof(hg_uint32_t);
             break;
+        case HG_CRC16:
+            HG_GOTO_SUBSYS_ERROR(proc, error, ret, HG_PROTONOSUPPORT,
+                "CRC16 checksums are not supported");
         case HG_CRC64:
-            hash_method = "crc64";
-            break;
+            HG_GOTO_SUBSYS_ERROR(proc, error, ret, HG_PROTONOSUPPORT,
+                "CRC64 checksums are not supported");
         default:
-            hash_method = NULL;
+            hg_proc->checksum_size = 0;
             break;
     }
-
-    if (hash_method) {
-        int rc = mchecksum_init(hash_method, &hg_proc->checksum);
-        HG_CHECK_SUBSYS_ERROR(proc, rc != 0, error, ret, HG_CHECKSUM_ERROR,
-            "Could not initialize checksum");
-
-        hg_proc->checksum_size = mchecksum_get_size(hg_proc->checksum);
-        hg_proc->checksum_hash = (char *) malloc(hg_proc->checksum_size);
-        HG_CHECK_SUBSYS_ERROR(proc, hg_proc->checksum_hash == NULL, error, ret,
-            HG_NOMEM, "Could not allocate space for checksum hash");
-    }
+    hg_proc->checksum = HG_CHECKSUM_CRC32C_INIT;
 #else
     (void) hash;
 #endif
@@ -91,13 +75,8 @@ hg_proc_create(hg_class_t *hg_class, hg_proc_hash_t hash, hg_proc_t *proc_p)
     return HG_SUCCESS;
 
 error:
-    if (hg_proc) {
-#ifdef HG_HAS_CHECKSUMS
-        mchecksum_destroy(hg_proc->checksum);
-        free(hg_proc->checksum_hash);
-#endif
-        free(hg_proc);
-    }
+    free(hg_proc);
+
     return ret;
 }
 
@@ -135,11 +114,6 @@ hg_proc_free(hg_proc_t proc)
     if (!hg_proc)
         return HG_SUCCESS;
 
-#ifdef HG_HAS_CHECKSUMS
-    mchecksum_destroy(hg_proc->checksum);
-    free(hg_proc->checksum_hash);
-#endif
-
     /* Free extra proc buffer if needed */
     if (hg_proc->extra_buf.buf && hg_proc->extra_buf.is_mine)
         hg_mem_aligned_free(hg_proc->extra_buf.buf);
@@ -205,12 +179,8 @@ hg_proc_reset(hg_proc_t proc, void *buf, hg_size_t buf_size, hg_proc_op_t op)
 
 #ifdef HG_HAS_CHECKSUMS
     /* Reset checksum */
-    if (hg_proc->checksum != MCHECKSUM_OBJECT_NULL) {
-        int rc = mchecksum_reset(hg_proc->checksum);
-        HG_CHECK_SUBSYS_ERROR(proc, rc != 0, error, ret, HG_CHECKSUM_ERROR,
-            "Could not reset checksum");
-        memset(hg_proc->checksum_hash, 0, hg_proc->checksum_size);
-    }
+    hg_proc->checksum = HG_CHECKSUM_CRC32C_INIT;
+    hg_proc->checksum_hash = 0;
 #endif
 
     return HG_SUCCESS;
@@ -324,7 +294,7 @@ hg_proc_restore_ptr(hg_proc_t proc, void *data, hg_size_t data_size)
         ret, HG_INVALID_ARG, "Cannot restore_ptr on HG_FREE");
 
 #ifdef HG_HAS_CHECKSUMS
-    hg_proc_checksum_update(proc, data, data_size);
+    HG_PROC_CHECKSUM_UPDATE(proc, data, data_size);
 #else
     /* Silent warning */
     (void) data;
@@ -364,20 +334,16 @@ hg_proc_flush(hg_proc_t proc)
     hg_return_t ret;
 #ifdef HG_HAS_CHECKSUMS
     struct hg_proc *hg_proc = (struct hg_proc *) proc;
-    int rc;
 #endif
 
     HG_CHECK_SUBSYS_ERROR(proc, proc == HG_PROC_NULL, error, ret,
         HG_INVALID_ARG, "Proc is not initialized");
 
 #ifdef HG_HAS_CHECKSUMS
-    if (hg_proc->checksum == MCHECKSUM_OBJECT_NULL)
+    if (hg_proc->checksum_size == 0)
         return HG_SUCCESS;
 
-    rc = mchecksum_get(hg_proc->checksum, hg_proc->checksum_hash,
-        hg_proc->checksum_size, MCHECKSUM_FINALIZE);
-    HG_CHECK_SUBSYS_ERROR(
-        proc, rc != 0, error, ret, HG_CHECKSUM_ERROR, "Could not get checksum");
+    hg_proc->checksum_hash = hg_checksum_crc32c_final(hg_proc->checksum);
 #endif
 
     return HG_SUCCESS;
@@ -391,21 +357,7 @@ error:
 void
 hg_proc_checksum_update(hg_proc_t proc, void *data, hg_size_t data_size)
 {
-    struct hg_proc *hg_proc = (struct hg_proc *) proc;
-    int rc;
-
-    if (hg_proc->checksum == MCHECKSUM_OBJECT_NULL)
-        return;
-
-    /* Update checksum */
-    rc = mchecksum_update(((struct hg_proc *) proc)->checksum, data, data_size);
-    HG_CHECK_SUBSYS_ERROR_NORET(
-        proc, rc != 0, error, "Could not update checksum");
-
-    return;
-
-error:
-    return;
+    HG_PROC_CHECKSUM_UPDATE(proc, data, data_size);
 }
 
 /*---------------------------------------------------------------------------*/
@@ -419,12 +371,12 @@ hg_proc_checksum_get(hg_proc_t proc, void *hash, hg_size_t hash_size)
         HG_INVALID_ARG, "Proc is not initialized");
     HG_CHECK_SUBSYS_ERROR(
         proc, hash == NULL, error, ret, HG_INVALID_ARG, "NULL hash pointer");
-    HG_CHECK_SUBSYS_ERROR(proc, hg_proc->checksum_hash == NULL, error, ret,
+    HG_CHECK_SUBSYS_ERROR(proc, hg_proc->checksum_size == 0, error, ret,
         HG_INVALID_ARG, "Proc has no checksum hash");
     HG_CHECK_SUBSYS_ERROR(proc, hash_size < hg_proc->checksum_size, error, ret,
         HG_INVALID_ARG, "Hash size passed is too small");
 
-    memcpy(hash, hg_proc->checksum_hash, hg_proc->checksum_size);
+    memcpy(hash, &hg_proc->checksum_hash, sizeof(hg_uint32_t));
 
     return HG_SUCCESS;
 
@@ -437,39 +389,24 @@ hg_return_t
 hg_proc_checksum_verify(hg_proc_t proc, const void *hash, hg_size_t hash_size)
 {
     struct hg_proc *hg_proc = (struct hg_proc *) proc;
+    hg_uint32_t hash32;
     hg_return_t ret;
 
     HG_CHECK_SUBSYS_ERROR(proc, proc == HG_PROC_NULL, error, ret,
         HG_INVALID_ARG, "Proc is not initialized");
     HG_CHECK_SUBSYS_ERROR(
         proc, hash == NULL, error, ret, HG_INVALID_ARG, "NULL hash pointer");
-    HG_CHECK_SUBSYS_ERROR(proc, hg_proc->checksum_hash == NULL, error, ret,
+    HG_CHECK_SUBSYS_ERROR(proc, hg_proc->checksum_size == 0, error, ret,
         HG_INVALID_ARG, "Proc has no checksum hash");
     HG_CHECK_SUBSYS_ERROR(proc, hash_size < hg_proc->checksum_size, error, ret,
         HG_INVALID_ARG, "Hash size passed is too small");
 
     /* Verify checksums */
-    if (memcmp(hash, hg_proc->checksum_hash, hg_proc->checksum_size) != 0) {
-        if (hg_proc->checksum_size == sizeof(hg_uint16_t))
-            HG_LOG_SUBSYS_ERROR(proc,
-                "checksum 0x%04X does not match (expected 0x%04X!)",
-                *(hg_uint16_t *) hg_proc->checksum_hash,
-                *(const hg_uint16_t *) hash);
-        else if (hg_proc->checksum_size == sizeof(hg_uint32_t))
-            HG_LOG_SUBSYS_ERROR(proc,
-                "checksum 0x%08X does not match (expected 0x%08X!)",
-                *(hg_uint32_t *) hg_proc->checksum_hash,
-                *(const hg_uint32_t *) hash);
-        else if (hg_proc->checksum_size == sizeof(hg_uint64_t))
-            HG_LOG_SUBSYS_ERROR(proc,
-                "checksum 0x%016" PRIx64
-                " does not match (expected 0x%016" PRIx64 "!)",
-                *(hg_uint64_t *) hg_proc->checksum_hash,
-                *(const hg_uint64_t *) hash);
-        else
-            HG_LOG_SUBSYS_ERROR(proc, "Checksums do not match (unknown size?)");
-        return HG_CHECKSUM_ERROR;
-    }
+    memcpy(&hash32, hash, sizeof(hash32));
+    HG_CHECK_SUBSYS_ERROR(proc, hash32 != hg_proc->checksum_hash, error, ret,
+        HG_CHECKSUM_ERROR,
+        "checksum 0x%08" PRIx32 " does not match (expected 0x%08" PRIx32 "!)",
+        hg_proc->checksum_hash, hash32);
 
     return HG_SUCCESS;
 
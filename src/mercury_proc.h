@@ -10,6 +10,10 @@
 
 #include "mercury_types.h"
 
+#ifdef HG_HAS_CHECKSUMS
+#    include "mercury_checksum.h"
+#endif
+
 #include <string.h>
 #ifdef HG_HAS_XDR
 #    include <limits.h>
@@ -37,7 +41,9 @@
 /*************************************/
 
 /**
- * Hash methods available for proc.
+ * Hash methods available for proc. Only HG_CRC32 (CRC32C) is supported,
+ * HG_CRC16 and HG_CRC64 are kept for compatibility and are rejected with
+ * HG_PROTONOSUPPORT.
  */
 typedef enum { HG_CRC16, HG_CRC32, HG_CRC64, HG_NOHASH } hg_proc_hash_t;
 
@@ -109,7 +115,12 @@ typedef enum { HG_CRC16, HG_CRC32, HG_CRC64, HG_NOHASH } hg_proc_hash_t;
 /* Update checksum */
 #ifdef HG_HAS_CHECKSUMS
 #    define HG_PROC_CHECKSUM_UPDATE(proc, data, size)                          \
-        hg_proc_checksum_update(proc, data, size)
+        do {                                                                   \
+            if (((struct hg_proc *) proc)->checksum_size != 0)                 \
+                ((struct hg_proc *) proc)->checksum =                          \
+                    hg_checksum_crc32c_update(                                 \
+                        ((struct hg_proc *) proc)->checksum, data, size);      \
+        } while (0)
 #else
 #    define HG_PROC_CHECKSUM_UPDATE(proc, data, size)
 #endif
@@ -203,10 +214,11 @@ extern "C" {
  * \param hg_class [IN]         HG class
  * \param hash [IN]             hash method used for computing checksum
  *                              (if NULL, checksum is not computed)
- *                              hash method: HG_CRC16, HG_CRC64, HG_NOHASH
+ *                              hash method: HG_CRC32, HG_NOHASH
  * \param proc_p [OUT]          pointer to abstract processor object
  *
- * \return HG_SUCCESS or corresponding HG error code
+ * \return HG_SUCCESS, HG_PROTONOSUPPORT if hash is HG_CRC16 or HG_CRC64, or
+ *         corresponding HG error code
  */
 HG_PUBLIC hg_return_t
 hg_proc_create(hg_class_t *hg_class, hg_proc_hash_t hash, hg_proc_t *proc_p);
@@ -221,10 +233,11 @@ hg_proc_create(hg_class_t *hg_class, hg_proc_hash_t hash, hg_proc_t *proc_p);
  * \param op [IN]               operation type: HG_ENCODE / HG_DECODE / HG_FREE
  * \param hash [IN]             hash method used for computing checksum
  *                              (if NULL, checksum is not computed)
- *                              hash method: HG_CRC16, HG_CRC64, HG_NOHASH
+ *                              hash method: HG_CRC32, HG_NOHASH
  * \param proc_p [OUT]          pointer to abstract processor object
  *
- * \return HG_SUCCESS or corresponding HG error code
+ * \return HG_SUCCESS, HG_PROTONOSUPPORT if hash is HG_CRC16 or HG_CRC64, or
+ *         corresponding HG error code
  */
 HG_PUBLIC hg_return_t
 hg_proc_create_set(hg_class_t *hg_class, void *buf, hg_size_t buf_size,
@@ -599,9 +612,9 @@ struct hg_proc {
     hg_class_t *hg_class; /* HG class */
     struct hg_proc_buf *current_buf;
 #ifdef HG_HAS_CHECKSUMS
-    struct mchecksum_object *checksum; /* Checksum */
-    void *checksum_hash;               /* Base checksum buf */
-    size_t checksum_size;              /* Checksum size */
+    hg_uint32_t checksum;      /* Running CRC32C */
+    hg_uint32_t checksum_hash; /* Finalized checksum */
+    size_t checksum_size;      /* Checksum size (0 if no checksum) */
 #endif
     hg_proc_op_t op;
     hg_uint8_t flags;
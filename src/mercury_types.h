@@ -14,13 +14,14 @@
 /* Public Type and Struct Definition */
 /*************************************/
 
-typedef struct hg_class hg_class_t;     /* Opaque HG class */
-typedef struct hg_context hg_context_t; /* Opaque HG context */
-typedef struct hg_addr *hg_addr_t;      /* Abstract HG address */
-typedef struct hg_handle *hg_handle_t;  /* Abstract RPC handle */
-typedef struct hg_bulk *hg_bulk_t;      /* Abstract bulk data handle */
-typedef struct hg_proc *hg_proc_t;      /* Abstract serialization processor */
-typedef struct hg_op_id *hg_op_id_t;    /* Abstract operation id */
+typedef struct hg_class hg_class_t;      /* Opaque HG class */
+typedef struct hg_context hg_context_t;  /* Opaque HG context */
+typedef struct hg_addr *hg_addr_t;       /* Abstract HG address */
+typedef struct hg_handle *hg_handle_t;   /* Abstract RPC handle */
+typedef struct hg_bulk *hg_bulk_t;       /* Abstract bulk data handle */
+typedef struct hg_proc *hg_proc_t;       /* Abstract serialization processor */
+typedef struct hg_op_id *hg_op_id_t;     /* Abstract operation id */
+typedef struct hg_payload *hg_payload_t; /* Pre-encoded RPC payload */
 
 /* HG info struct */
 struct hg_info {
@@ -72,6 +73,7 @@ struct hg_cb_info_bulk {
     hg_bulk_t local_handle;  /* HG Bulk local handle */
     hg_bulk_op_t op;         /* Operation type */
     hg_size_t size;          /* Total size transferred */
+    hg_uint32_t checksum;    /* CRC32C of local data (if enabled) */
 };
 
 struct hg_cb_info {
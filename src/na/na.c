@@ -9,6 +9,7 @@
 
 #include "mercury_atomic_queue.h"
 #include "mercury_mem.h"
+#include "mercury_mem_pool.h"
 #include "mercury_thread_spin.h"
 
 #include <stdlib.h>
@@ -34,13 +35,22 @@
 
 #define NA_ATOMIC_QUEUE_SIZE 1024 /* TODO make it configurable */
 
+/* Default number of chunks per block of the message buffer pool (blocks are
+ * rounded up to the huge page size) */
+#define NA_MSG_BUF_POOL_CHUNK_COUNT (256)
+
+/* Plugin data values of message buffers allocated by NA */
+#define NA_MSG_BUF_ALIGNED ((void *) 1)
+#define NA_MSG_BUF_POOL    ((void *) 2)
+
 /************************************/
 /* Local Type and Struct Definition */
 /************************************/
 
 /* Private class */
 struct na_private_class {
-    struct na_class na_class; /* Must remain as first field */
+    struct na_class na_class;         /* Must remain as first field */
+    struct hg_mem_pool *msg_buf_pool; /* Message buffer pool */
 };
 
 /* Completion queue */
@@ -109,6 +119,9 @@ static const struct na_class_ops *const na_class_table_g[] = {
 #endif
 #ifdef NA_HAS_PSM2
     &NA_PLUGIN_OPS(psm2),
+#endif
+#ifdef NA_HAS_TCP
+    &NA_PLUGIN_OPS(tcp),
 #endif
     NULL};
 
@@ -305,16 +318,15 @@ NA_Initialize_opt(const char *info_string, bool listen,
             continue;
 
         /* Check that protocol is supported, if no class name specified, take
-         * the first plugin that supports the protocol */
+         * the first plugin that supports the protocol (several plugins may
+         * share the same class name, e.g., "na" for sm and tcp) */
         if (ops->check_protocol(na_info->protocol_name))
             break;
-        else
-            NA_CHECK_SUBSYS_ERROR(fatal, class_name != NULL, error, ret,
-                NA_PROTONOSUPPORT,
-                "Specified class name \"%s\" does not support requested "
-                "protocol",
-                class_name);
     }
+    NA_CHECK_SUBSYS_ERROR(fatal, ops == NULL && class_name != NULL, error, ret,
+        NA_PROTONOSUPPORT,
+        "Specified class name \"%s\" does not support requested protocol",
+        class_name);
     NA_CHECK_SUBSYS_ERROR(fatal, ops == NULL, error, ret, NA_PROTONOSUPPORT,
         "No suitable plugin found that matches %s", info_string);
 
@@ -336,11 +348,32 @@ NA_Initialize_opt(const char *info_string, bool listen,
 
     na_private_class->na_class.listen = listen;
 
+    /* Plugins that allocate their own message buffers handle huge pages */
+    if (na_init_info && na_init_info->msg_buf_huge_pages &&
+        ops->msg_buf_alloc == NULL) {
+        na_class_t *na_class = &na_private_class->na_class;
+        size_t chunk_size = NA_Msg_get_max_unexpected_size(na_class);
+
+        if (NA_Msg_get_max_expected_size(na_class) > chunk_size)
+            chunk_size = NA_Msg_get_max_expected_size(na_class);
+
+        na_private_class->msg_buf_pool =
+            hg_mem_pool_create(chunk_size, NA_MSG_BUF_POOL_CHUNK_COUNT, 1, NULL,
+                HG_MEM_POOL_HUGE_PAGES, NULL, NULL);
+        NA_CHECK_SUBSYS_ERROR(cls, na_private_class->msg_buf_pool == NULL,
+            error_finalize, ret, NA_NOMEM,
+            "Could not create message buffer pool (chunk size %zu)",
+            chunk_size);
+    }
+
     free(class_name);
     na_info_free(na_info);
 
     return (na_class_t *) na_private_class;
 
+error_finalize:
+    (void) na_private_class->na_class.ops->finalize(
+        &na_private_class->na_class);
 error:
     free(class_name);
     na_info_free(na_info);
@@ -369,6 +402,8 @@ NA_Finalize(na_class_t *na_class)
     ret = na_class->ops->finalize(&na_private_class->na_class);
     NA_CHECK_SUBSYS_NA_ERROR(cls, error, ret, "Could not finalize plugin");
 
+    hg_mem_pool_destroy(na_private_class->msg_buf_pool);
+
     free(na_private_class->na_class.protocol_name);
     free(na_private_class);
 
@@ -599,6 +634,66 @@ error:
     return ret;
 }
 
+/*---------------------------------------------------------------------------*/
+na_return_t
+NA_Addr_lookup_multi(na_class_t *na_class, const char *const *names,
+    size_t count, na_addr_t **addrs)
+{
+    const char **short_names = NULL;
+    na_return_t ret;
+    size_t i;
+
+    NA_CHECK_SUBSYS_ERROR(
+        addr, na_class == NULL, error, ret, NA_INVALID_ARG, "NULL NA class");
+    NA_CHECK_SUBSYS_ERROR(addr, names == NULL || count == 0, error, ret,
+        NA_INVALID_ARG, "NULL array of lookup names");
+    NA_CHECK_SUBSYS_ERROR(addr, addrs == NULL, error, ret, NA_INVALID_ARG,
+        "NULL array of NA addrs");
+
+    /* Fallback to individual lookups */
+    if (na_class->ops->addr_lookup_multi == NULL) {
+        for (i = 0; i < count; i++) {
+            ret = NA_Addr_lookup(na_class, names[i], &addrs[i]);
+            if (ret != NA_SUCCESS) {
+                while (i-- > 0)
+                    NA_Addr_free(na_class, addrs[i]);
+                goto error;
+            }
+        }
+        return NA_SUCCESS;
+    }
+
+    short_names = (const char **) malloc(count * sizeof(*short_names));
+    NA_CHECK_SUBSYS_ERROR(addr, short_names == NULL, error, ret, NA_NOMEM,
+        "Could not allocate array of names");
+
+    /* Remove class name from each name (see NA_Addr_lookup()) */
+    for (i = 0; i < count; i++) {
+        NA_CHECK_SUBSYS_ERROR(addr, names[i] == NULL, error, ret,
+            NA_INVALID_ARG, "Lookup name is NULL");
+        short_names[i] = strstr(names[i], NA_CLASS_DELIMITER);
+        short_names[i] = (short_names[i] == NULL)
+                             ? names[i]
+                             : short_names[i] + NA_CLASS_DELIMITER_LEN;
+    }
+
+    NA_LOG_SUBSYS_DEBUG(addr, "Looking up %zu addrs", count);
+
+    ret = na_class->ops->addr_lookup_multi(
+        na_class, short_names, count, addrs);
+    NA_CHECK_SUBSYS_NA_ERROR(
+        addr, error, ret, "Could not lookup %zu addresses", count);
+
+    free(short_names);
+
+    return NA_SUCCESS;
+
+error:
+    free(short_names);
+
+    return ret;
+}
+
 /*---------------------------------------------------------------------------*/
 void
 NA_Addr_free(na_class_t *na_class, na_addr_t *addr)
@@ -852,6 +947,50 @@ error:
     return ret;
 }
 
+/*---------------------------------------------------------------------------*/
+na_return_t
+NA_Addr_deserialize_multi(na_class_t *na_class, na_addr_t **addrs,
+    size_t count, const void *buf, size_t stride)
+{
+    na_return_t ret;
+    size_t i;
+
+    NA_CHECK_SUBSYS_ERROR(
+        addr, na_class == NULL, error, ret, NA_INVALID_ARG, "NULL NA class");
+    NA_CHECK_SUBSYS_ERROR(addr, addrs == NULL || count == 0, error, ret,
+        NA_INVALID_ARG, "NULL array of addrs");
+    NA_CHECK_SUBSYS_ERROR(
+        addr, buf == NULL, error, ret, NA_INVALID_ARG, "NULL buffer");
+    NA_CHECK_SUBSYS_ERROR(
+        addr, stride == 0, error, ret, NA_INVALID_ARG, "NULL stride");
+
+    /* Fallback to individual deserialization */
+    if (na_class->ops->addr_deserialize_multi == NULL) {
+        for (i = 0; i < count; i++) {
+            ret = NA_Addr_deserialize(
+                na_class, &addrs[i], (const char *) buf + i * stride, stride);
+            if (ret != NA_SUCCESS) {
+                while (i-- > 0)
+                    NA_Addr_free(na_class, addrs[i]);
+                goto error;
+            }
+        }
+        return NA_SUCCESS;
+    }
+
+    ret = na_class->ops->addr_deserialize_multi(
+        na_class, addrs, count, buf, stride);
+    NA_CHECK_SUBSYS_NA_ERROR(
+        addr, error, ret, "Could not deserialize %zu addrs", count);
+
+    NA_LOG_SUBSYS_DEBUG(addr, "Deserialized %zu addresses", count);
+
+    return NA_SUCCESS;
+
+error:
+    return ret;
+}
+
 /*---------------------------------------------------------------------------*/
 void *
 NA_Msg_buf_alloc(na_class_t *na_class, size_t buf_size, unsigned long flags,
@@ -870,13 +1009,22 @@ NA_Msg_buf_alloc(na_class_t *na_class, size_t buf_size, unsigned long flags,
         NA_CHECK_SUBSYS_ERROR_NORET(msg, ret == NULL, error,
             "Could not allocate buffer of size %zu", buf_size);
     } else {
-        size_t page_size = (size_t) hg_mem_get_page_size();
-
-        ret = hg_mem_aligned_alloc(page_size, buf_size);
-        NA_CHECK_SUBSYS_ERROR_NORET(msg, ret == NULL, error,
-            "Could not allocate buffer of size %zu", buf_size);
-        memset(ret, 0, buf_size);
-        *plugin_data_p = (void *) 1; /* Sanity check on free */
+        struct hg_mem_pool *msg_buf_pool =
+            ((struct na_private_class *) na_class)->msg_buf_pool;
+
+        if (msg_buf_pool != NULL &&
+            (ret = hg_mem_pool_alloc(msg_buf_pool, buf_size, NULL)) != NULL) {
+            memset(ret, 0, buf_size);
+            *plugin_data_p = NA_MSG_BUF_POOL;
+        } else {
+            size_t page_size = (size_t) hg_mem_get_page_size();
+
+            ret = hg_mem_aligned_alloc(page_size, buf_size);
+            NA_CHECK_SUBSYS_ERROR_NORET(msg, ret == NULL, error,
+                "Could not allocate buffer of size %zu", buf_size);
+            memset(ret, 0, buf_size);
+            *plugin_data_p = NA_MSG_BUF_ALIGNED; /* Sanity check on free */
+        }
     }
 
     NA_LOG_SUBSYS_DEBUG(msg,
@@ -903,9 +1051,12 @@ NA_Msg_buf_free(na_class_t *na_class, void *buf, void *plugin_data)
 
     if (na_class->ops && na_class->ops->msg_buf_free) {
         na_class->ops->msg_buf_free(na_class, buf, plugin_data);
+    } else if (plugin_data == NA_MSG_BUF_POOL) {
+        hg_mem_pool_free(
+            ((struct na_private_class *) na_class)->msg_buf_pool, buf, NULL);
     } else {
-        NA_CHECK_SUBSYS_WARNING(
-            msg, plugin_data != (void *) 1, "Invalid plugin data value");
+        NA_CHECK_SUBSYS_WARNING(msg, plugin_data != NA_MSG_BUF_ALIGNED,
+            "Invalid plugin data value");
         hg_mem_aligned_free(buf);
     }
 
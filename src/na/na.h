@@ -215,6 +215,23 @@ NA_Op_destroy(na_class_t *na_class, na_op_id_t *op_id);
 NA_PUBLIC na_return_t
 NA_Addr_lookup(na_class_t *na_class, const char *name, na_addr_t **addr_p);
 
+/**
+ * Lookup an array of addrs from peer addresses/names. Plugins that support it
+ * resolve all the addresses at once (e.g., single AV insertion), others fall
+ * back to individual lookups. Either all or none of the addresses are
+ * returned. Addresses need to be freed by calling NA_Addr_free().
+ *
+ * \param na_class [IN/OUT]     pointer to NA class
+ * \param names [IN]            array of lookup names
+ * \param count [IN]            number of names
+ * \param addrs [OUT]           array of NA addresses
+ *
+ * \return NA_SUCCESS or corresponding NA error code
+ */
+NA_PUBLIC na_return_t
+NA_Addr_lookup_multi(na_class_t *na_class, const char *const *names,
+    size_t count, na_addr_t **addrs);
+
 /**
  * Free the addr from the list of peers.
  *
@@ -345,6 +362,25 @@ NA_PUBLIC na_return_t
 NA_Addr_deserialize(
     na_class_t *na_class, na_addr_t **addr_p, const void *buf, size_t buf_size);
 
+/**
+ * Deserialize an array of addresses packed contiguously into a buffer, each
+ * serialized address occupying stride bytes. Plugins that support it insert
+ * all the addresses at once, others fall back to individual deserialization.
+ * Either all or none of the addresses are returned. Returned addresses must
+ * be freed with NA_Addr_free().
+ *
+ * \param na_class [IN/OUT]     pointer to NA class
+ * \param addrs [OUT]           array of NA addresses
+ * \param count [IN]            number of addresses
+ * \param buf [IN]              pointer to buffer used for deserialization
+ * \param stride [IN]           size of each serialized address
+ *
+ * \return NA_SUCCESS or corresponding NA error code
+ */
+NA_PUBLIC na_return_t
+NA_Addr_deserialize_multi(na_class_t *na_class, na_addr_t **addrs,
+    size_t count, const void *buf, size_t stride);
+
 /**
  * Get the maximum size of messages supported by unexpected send/recv.
  * Small message size.
@@ -403,6 +439,18 @@ NA_Msg_get_expected_header_size(
 static NA_INLINE na_tag_t
 NA_Msg_get_max_tag(const na_class_t *na_class) NA_WARN_UNUSED_RESULT;
 
+/**
+ * Get the maximum size of expected messages that can be sent through
+ * NA_Msg_send_expected_inject(). A size of 0 indicates that the plugin does
+ * not support injecting messages.
+ *
+ * \param na_class [IN]         pointer to NA class
+ *
+ * \return Non-negative value
+ */
+static NA_INLINE size_t
+NA_Msg_get_max_inject_size(const na_class_t *na_class) NA_WARN_UNUSED_RESULT;
+
 /**
  * Allocate buf_size bytes and return a pointer to the allocated memory.
  * If size is 0, NA_Msg_buf_alloc() returns NULL. The plugin_data output
@@ -612,6 +660,30 @@ NA_Msg_recv_expected(na_class_t *na_class, na_context_t *context,
     na_cb_t callback, void *arg, void *buf, size_t buf_size, void *plugin_data,
     na_addr_t *source_addr, uint8_t source_id, na_tag_t tag, na_op_id_t *op_id);
 
+/**
+ * Inject an expected message to dest_addr. Unlike NA_Msg_send_expected(), the
+ * send is complete once the call returns: buf can be re-used immediately, no
+ * operation ID is used and no callback is placed into the context completion
+ * queue. buf_size must not exceed NA_Msg_get_max_inject_size().
+ * If the message cannot be injected without blocking, NA_AGAIN is returned and
+ * the message should be sent through NA_Msg_send_expected() instead.
+ *
+ * \param na_class [IN/OUT]     pointer to NA class
+ * \param context [IN/OUT]      pointer to context of execution
+ * \param buf [IN]              pointer to send buffer
+ * \param buf_size [IN]         buffer size
+ * \param plugin_data [IN]      pointer to internal plugin data
+ * \param dest_addr [IN]        NA address of destination
+ * \param dest_id [IN]          destination context ID
+ * \param tag [IN]              tag attached to message
+ *
+ * \return NA_SUCCESS or corresponding NA error code
+ */
+static NA_INLINE na_return_t
+NA_Msg_send_expected_inject(na_class_t *na_class, na_context_t *context,
+    const void *buf, size_t buf_size, void *plugin_data, na_addr_t *dest_addr,
+    uint8_t dest_id, na_tag_t tag);
+
 /**
  * Create memory handle for RMA operations.
  * For non-contiguous memory, use NA_Mem_handle_create_segments() instead.
@@ -933,6 +1005,8 @@ struct na_class_ops {
     void (*op_destroy)(na_class_t *na_class, na_op_id_t *op_id);
     na_return_t (*addr_lookup)(
         na_class_t *na_class, const char *name, na_addr_t **addr_p);
+    na_return_t (*addr_lookup_multi)(na_class_t *na_class,
+        const char *const *names, size_t count, na_addr_t **addrs);
     void (*addr_free)(na_class_t *na_class, na_addr_t *addr);
     na_return_t (*addr_set_remove)(na_class_t *na_class, na_addr_t *addr);
     na_return_t (*addr_self)(na_class_t *na_class, na_addr_t **addr_p);
@@ -947,10 +1021,13 @@ struct na_class_ops {
         na_class_t *na_class, void *buf, size_t buf_size, na_addr_t *addr);
     na_return_t (*addr_deserialize)(na_class_t *na_class, na_addr_t **addr_p,
         const void *buf, size_t buf_size);
+    na_return_t (*addr_deserialize_multi)(na_class_t *na_class,
+        na_addr_t **addrs, size_t count, const void *buf, size_t stride);
     size_t (*msg_get_max_unexpected_size)(const na_class_t *na_class);
     size_t (*msg_get_max_expected_size)(const na_class_t *na_class);
     size_t (*msg_get_unexpected_header_size)(const na_class_t *na_class);
     size_t (*msg_get_expected_header_size)(const na_class_t *na_class);
+    size_t (*msg_get_max_inject_size)(const na_class_t *na_class);
     na_tag_t (*msg_get_max_tag)(const na_class_t *na_class);
     void *(*msg_buf_alloc)(na_class_t *na_class, size_t buf_size,
         unsigned long flags, void **plugin_data_p);
@@ -973,6 +1050,9 @@ struct na_class_ops {
         na_context_t *context, na_cb_t callback, void *arg, const void *buf,
         size_t buf_size, void *plugin_data, na_addr_t *dest_addr,
         uint8_t dest_id, na_tag_t tag, na_op_id_t *op_id);
+    na_return_t (*msg_send_expected_inject)(na_class_t *na_class,
+        na_context_t *context, const void *buf, size_t buf_size,
+        void *plugin_data, na_addr_t *dest_addr, uint8_t dest_id, na_tag_t tag);
     na_return_t (*msg_recv_expected)(na_class_t *na_class,
         na_context_t *context, na_cb_t callback, void *arg, void *buf,
         size_t buf_size, void *plugin_data, na_addr_t *source_addr,
@@ -1089,6 +1169,15 @@ NA_Msg_get_max_tag(const na_class_t *na_class)
     return na_class->ops->msg_get_max_tag(na_class);
 }
 
+/*---------------------------------------------------------------------------*/
+static NA_INLINE size_t
+NA_Msg_get_max_inject_size(const na_class_t *na_class)
+{
+    return (na_class->ops->msg_get_max_inject_size)
+               ? na_class->ops->msg_get_max_inject_size(na_class)
+               : 0;
+}
+
 /*---------------------------------------------------------------------------*/
 static NA_INLINE na_return_t
 NA_Msg_send_unexpected(na_class_t *na_class, na_context_t *context,
@@ -1143,6 +1232,18 @@ NA_Msg_recv_expected(na_class_t *na_class, na_context_t *context,
         buf, buf_size, plugin_data, source_addr, source_id, tag, op_id);
 }
 
+/*---------------------------------------------------------------------------*/
+static NA_INLINE na_return_t
+NA_Msg_send_expected_inject(na_class_t *na_class, na_context_t *context,
+    const void *buf, size_t buf_size, void *plugin_data, na_addr_t *dest_addr,
+    uint8_t dest_id, na_tag_t tag)
+{
+    return (na_class->ops->msg_send_expected_inject)
+               ? na_class->ops->msg_send_expected_inject(na_class, context,
+                     buf, buf_size, plugin_data, dest_addr, dest_id, tag)
+               : NA_OPNOTSUPPORTED;
+}
+
 /*---------------------------------------------------------------------------*/
 static NA_INLINE size_t
 NA_Mem_handle_get_max_segments(const na_class_t *na_class)
@@ -453,6 +453,7 @@ const struct na_class_ops NA_PLUGIN_OPS(bmi) = {
     na_bmi_op_create,                     /* op_create */
     na_bmi_op_destroy,                    /* op_destroy */
     na_bmi_addr_lookup,                   /* addr_lookup */
+    NULL,                                 /* addr_lookup_multi */
     na_bmi_addr_free,                     /* addr_free */
     NULL,                                 /* addr_set_remove */
     na_bmi_addr_self,                     /* addr_self */
@@ -463,10 +464,12 @@ const struct na_class_ops NA_PLUGIN_OPS(bmi) = {
     NULL,                                 /* addr_get_serialize_size */
     NULL,                                 /* addr_serialize */
     NULL,                                 /* addr_deserialize */
+    NULL,                                 /* addr_deserialize_multi */
     na_bmi_msg_get_max_unexpected_size,   /* msg_get_max_unexpected_size */
     na_bmi_msg_get_max_expected_size,     /* msg_get_max_expected_size */
     NULL,                                 /* msg_get_unexpected_header_size */
     NULL,                                 /* msg_get_expected_header_size */
+    NULL,                                 /* msg_get_max_inject_size */
     na_bmi_msg_get_max_tag,               /* msg_get_max_tag */
     NULL,                                 /* msg_buf_alloc */
     NULL,                                 /* msg_buf_free */
@@ -476,6 +479,7 @@ const struct na_class_ops NA_PLUGIN_OPS(bmi) = {
     NULL,                                 /* msg_multi_recv_unexpected */
     NULL,                                 /* msg_init_expected */
     na_bmi_msg_send_expected,             /* msg_send_expected */
+    NULL,                                 /* msg_send_expected_inject */
     na_bmi_msg_recv_expected,             /* msg_recv_expected */
     na_bmi_mem_handle_create,             /* mem_handle_create */
     NULL,                                 /* mem_handle_create_segment */
@@ -371,6 +371,7 @@ const struct na_class_ops NA_PLUGIN_OPS(cci) = {
     na_cci_op_create,                     /* op_create */
     na_cci_op_destroy,                    /* op_destroy */
     na_cci_addr_lookup,                   /* addr_lookup */
+    NULL,                                 /* addr_lookup_multi */
     na_cci_addr_free,                     /* addr_free */
     NULL,                                 /* addr_set_remove */
     na_cci_addr_self,                     /* addr_self */
@@ -381,10 +382,12 @@ const struct na_class_ops NA_PLUGIN_OPS(cci) = {
     NULL,                                 /* addr_get_serialize_size */
     NULL,                                 /* addr_serialize */
     NULL,                                 /* addr_deserialize */
+    NULL,                                 /* addr_deserialize_multi */
     na_cci_msg_get_max_unexpected_size,   /* msg_get_max_unexpected_size */
     na_cci_msg_get_max_expected_size,     /* msg_get_max_expected_size */
     NULL,                                 /* msg_get_unexpected_header_size */
     NULL,                                 /* msg_get_expected_header_size */
+    NULL,                                 /* msg_get_max_inject_size */
     na_cci_msg_get_max_tag,               /* msg_get_max_tag */
     NULL,                                 /* msg_buf_alloc */
     NULL,                                 /* msg_buf_free */
@@ -394,6 +397,7 @@ const struct na_class_ops NA_PLUGIN_OPS(cci) = {
     NULL,                                 /* msg_multi_recv_unexpected */
     NULL,                                 /* msg_init_expected */
     na_cci_msg_send_expected,             /* msg_send_expected */
+    NULL,                                 /* msg_send_expected_inject */
     na_cci_msg_recv_expected,             /* msg_recv_expected */
     na_cci_mem_handle_create,             /* mem_handle_create */
     NULL,                                 /* mem_handle_create_segment */
@@ -48,6 +48,16 @@ static int MPI_MAX_TAG = 32767;
 #define NA_MPI_RMA_TAG         (NA_MPI_RMA_REQUEST_TAG + 1)
 #define NA_MPI_MAX_RMA_TAG     (MPI_MAX_TAG >> 1)
 
+/* Native one-sided RMA through MPI-3 dynamic windows */
+#if MPI_VERSION >= 3
+#    define NA_MPI_HAS_RMA
+#endif
+
+/* Max number of regions attached to the RMA window, implementations bound it
+ * (osc_rdma_max_attach is 32 with Open MPI) and may not recover from an
+ * attach that goes past that limit */
+#define NA_MPI_MAX_ATTACH (32)
+
 #define NA_MPI_CLASS(na_class)                                                 \
     ((struct na_mpi_class *) (na_class->plugin_class))
 
@@ -66,6 +76,7 @@ struct na_mpi_addr {
     MPI_Comm comm;     /* Communicator */
     MPI_Comm rma_comm; /* Communicator used for one sided emulation */
     int rank;          /* Rank in this communicator */
+    int win_rank;      /* Rank in RMA window (-1 if not translated yet) */
     bool unexpected;   /* Address generated from unexpected recv */
     bool self;         /* Boolean for self */
     bool dynamic;      /* Address generated using MPI DPM routines */
@@ -77,7 +88,9 @@ struct na_mpi_addr {
 struct na_mpi_mem_handle {
     void *base;    /* Initial address of memory */
     MPI_Aint size; /* Size of memory */
+    MPI_Aint disp; /* Displacement of memory in RMA window */
     uint8_t attr;  /* Flag of operation access */
+    bool attached; /* Memory attached to RMA window */
 };
 
 /* na_mpi_rma_op */
@@ -126,6 +139,7 @@ struct na_mpi_info_put {
     MPI_Request rma_request;
     MPI_Request data_request;
     struct na_mpi_rma_info *rma_info;
+    int target_rank;        /* Window rank flushed on completion (native) */
     bool internal_progress; /* Used for internal RMA emulation */
 };
 
@@ -180,6 +194,14 @@ struct na_mpi_class {
 
     hg_atomic_int32_t rma_tag; /* Atomic RMA tag value */
 
+#ifdef NA_MPI_HAS_RMA
+    MPI_Comm win_comm;              /* Communicator of RMA window */
+    MPI_Group win_group;            /* Group of RMA window communicator */
+    MPI_Win win;                    /* Dynamic RMA window */
+    hg_atomic_int32_t attach_count; /* Number of attached regions */
+#endif
+    bool use_rma; /* Use native one-sided RMA */
+
     HG_LIST_HEAD(na_mpi_op_id) op_id_list; /* List of na_mpi_op_ids */
     hg_thread_mutex_t op_id_list_mutex;    /* Mutex */
 };
@@ -225,6 +247,26 @@ na_mpi_msg_unexpected_op_pop(na_class_t *na_class);
 static NA_INLINE na_tag_t
 na_mpi_gen_rma_tag(na_class_t *na_class);
 
+#ifdef NA_MPI_HAS_RMA
+/* win_create */
+static na_return_t
+na_mpi_win_create(struct na_mpi_class *na_mpi_class);
+
+/* win_destroy */
+static na_return_t
+na_mpi_win_destroy(struct na_mpi_class *na_mpi_class);
+
+/* addr_win_rank */
+static na_return_t
+na_mpi_addr_win_rank(
+    struct na_mpi_class *na_mpi_class, struct na_mpi_addr *na_mpi_addr);
+
+/* rma_post */
+static na_return_t
+na_mpi_rma_post(na_class_t *na_class, struct na_mpi_op_id *na_mpi_op_id,
+    void *buf, MPI_Aint disp, int count, struct na_mpi_addr *na_mpi_addr);
+#endif
+
 /* verify */
 static bool
 na_mpi_check_protocol(const char *protocol_name);
@@ -315,6 +357,15 @@ na_mpi_mem_handle_create(na_class_t *na_class, void *buf, size_t buf_size,
 static void
 na_mpi_mem_handle_free(na_class_t *na_class, na_mem_handle_t *mem_handle);
 
+/* mem_register */
+static na_return_t
+na_mpi_mem_register(na_class_t *na_class, na_mem_handle_t *mem_handle,
+    enum na_mem_type mem_type, uint64_t device);
+
+/* mem_deregister */
+static na_return_t
+na_mpi_mem_deregister(na_class_t *na_class, na_mem_handle_t *mem_handle);
+
 /* mem_handle serialization */
 static size_t
 na_mpi_mem_handle_get_serialize_size(
@@ -397,6 +448,7 @@ const struct na_class_ops NA_PLUGIN_OPS(mpi) = {
     na_mpi_op_create,                     /* op_create */
     na_mpi_op_destroy,                    /* op_destroy */
     na_mpi_addr_lookup,                   /* addr_lookup */
+    NULL,                                 /* addr_lookup_multi */
     na_mpi_addr_free,                     /* addr_free */
     NULL,                                 /* addr_set_remove */
     na_mpi_addr_self,                     /* addr_self */
@@ -407,10 +459,12 @@ const struct na_class_ops NA_PLUGIN_OPS(mpi) = {
     NULL,                                 /* addr_get_serialize_size */
     NULL,                                 /* addr_serialize */
     NULL,                                 /* addr_deserialize */
+    NULL,                                 /* addr_deserialize_multi */
     na_mpi_msg_get_max_unexpected_size,   /* msg_get_max_unexpected_size */
     na_mpi_msg_get_max_expected_size,     /* msg_get_max_expected_size */
     NULL,                                 /* msg_get_unexpected_header_size */
     NULL,                                 /* msg_get_expected_header_size */
+    NULL,                                 /* msg_get_max_inject_size */
     na_mpi_msg_get_max_tag,               /* msg_get_max_tag */
     NULL,                                 /* msg_buf_alloc */
     NULL,                                 /* msg_buf_free */
@@ -420,13 +474,14 @@ const struct na_class_ops NA_PLUGIN_OPS(mpi) = {
     NULL,                                 /* msg_multi_recv_unexpected */
     NULL,                                 /* msg_init_expected */
     na_mpi_msg_send_expected,             /* msg_send_expected */
+    NULL,                                 /* msg_send_expected_inject */
     na_mpi_msg_recv_expected,             /* msg_recv_expected */
     na_mpi_mem_handle_create,             /* mem_handle_create */
     NULL,                                 /* mem_handle_create_segment */
     na_mpi_mem_handle_free,               /* mem_handle_free */
     NULL,                                 /* mem_handle_get_max_segments */
-    NULL,                                 /* mem_register */
-    NULL,                                 /* mem_deregister */
+    na_mpi_mem_register,                  /* mem_register */
+    na_mpi_mem_deregister,                /* mem_deregister */
     na_mpi_mem_handle_get_serialize_size, /* mem_handle_get_serialize_size */
     na_mpi_mem_handle_serialize,          /* mem_handle_serialize */
     na_mpi_mem_handle_deserialize,        /* mem_handle_deserialize */
@@ -604,6 +659,7 @@ na_mpi_accept(struct na_mpi_class *na_mpi_class)
     na_mpi_addr->comm = new_comm;
     na_mpi_addr->rma_comm = new_rma_comm;
     na_mpi_addr->rank = MPI_ANY_SOURCE;
+    na_mpi_addr->win_rank = -1;
     na_mpi_addr->unexpected = false;
     na_mpi_addr->dynamic = (bool) (!na_mpi_class->use_static_inter_comm);
     memset(na_mpi_addr->port_name, '\0', MPI_MAX_PORT_NAME);
@@ -718,6 +774,192 @@ na_mpi_gen_rma_tag(na_class_t *na_class)
     return tag;
 }
 
+#ifdef NA_MPI_HAS_RMA
+/*---------------------------------------------------------------------------*/
+static na_return_t
+na_mpi_win_create(struct na_mpi_class *na_mpi_class)
+{
+    na_return_t ret = NA_SUCCESS;
+    int mpi_ret;
+
+    mpi_ret = MPI_Comm_dup(MPI_COMM_WORLD, &na_mpi_class->win_comm);
+    if (mpi_ret != MPI_SUCCESS) {
+        NA_LOG_ERROR("MPI_Comm_dup() failed");
+        ret = NA_PROTOCOL_ERROR;
+        goto done;
+    }
+
+    mpi_ret = MPI_Comm_group(na_mpi_class->win_comm, &na_mpi_class->win_group);
+    if (mpi_ret != MPI_SUCCESS) {
+        NA_LOG_ERROR("MPI_Comm_group() failed");
+        ret = NA_PROTOCOL_ERROR;
+        goto free_comm;
+    }
+
+    /* Memory is attached to the window when it is registered */
+    mpi_ret = MPI_Win_create_dynamic(
+        MPI_INFO_NULL, na_mpi_class->win_comm, &na_mpi_class->win);
+    if (mpi_ret != MPI_SUCCESS) {
+        NA_LOG_ERROR("MPI_Win_create_dynamic() failed");
+        ret = NA_PROTOCOL_ERROR;
+        goto free_group;
+    }
+
+    /* Do not let a failed attach abort the job */
+    mpi_ret = MPI_Win_set_errhandler(na_mpi_class->win, MPI_ERRORS_RETURN);
+    if (mpi_ret != MPI_SUCCESS) {
+        NA_LOG_ERROR("MPI_Win_set_errhandler() failed");
+        ret = NA_PROTOCOL_ERROR;
+        goto free_win;
+    }
+
+    /* Open a passive target epoch to all processes for the window lifetime */
+    mpi_ret = MPI_Win_lock_all(MPI_MODE_NOCHECK, na_mpi_class->win);
+    if (mpi_ret != MPI_SUCCESS) {
+        NA_LOG_ERROR("MPI_Win_lock_all() failed");
+        ret = NA_PROTOCOL_ERROR;
+        goto free_win;
+    }
+
+    hg_atomic_init32(&na_mpi_class->attach_count, 0);
+    na_mpi_class->use_rma = true;
+
+done:
+    return ret;
+
+free_win:
+    MPI_Win_free(&na_mpi_class->win);
+free_group:
+    MPI_Group_free(&na_mpi_class->win_group);
+free_comm:
+    MPI_Comm_free(&na_mpi_class->win_comm);
+
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static na_return_t
+na_mpi_win_destroy(struct na_mpi_class *na_mpi_class)
+{
+    na_return_t ret = NA_SUCCESS;
+    int mpi_ret;
+
+    mpi_ret = MPI_Win_unlock_all(na_mpi_class->win);
+    if (mpi_ret != MPI_SUCCESS) {
+        NA_LOG_ERROR("MPI_Win_unlock_all() failed");
+        ret = NA_PROTOCOL_ERROR;
+        goto done;
+    }
+
+    /* Collective over the window communicator */
+    mpi_ret = MPI_Win_free(&na_mpi_class->win);
+    if (mpi_ret != MPI_SUCCESS) {
+        NA_LOG_ERROR("MPI_Win_free() failed");
+        ret = NA_PROTOCOL_ERROR;
+        goto done;
+    }
+
+    MPI_Group_free(&na_mpi_class->win_group);
+    MPI_Comm_free(&na_mpi_class->win_comm);
+    na_mpi_class->use_rma = false;
+
+done:
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static na_return_t
+na_mpi_addr_win_rank(
+    struct na_mpi_class *na_mpi_class, struct na_mpi_addr *na_mpi_addr)
+{
+    MPI_Group group;
+    int is_inter = 0;
+    na_return_t ret = NA_SUCCESS;
+    int mpi_ret;
+
+    if (na_mpi_addr->win_rank >= 0)
+        goto done;
+
+    if (na_mpi_addr->self) {
+        MPI_Comm_rank(na_mpi_class->win_comm, &na_mpi_addr->win_rank);
+        goto done;
+    }
+
+    /* Remote ranks of inter-communicators belong to the remote group */
+    MPI_Comm_test_inter(na_mpi_addr->comm, &is_inter);
+    mpi_ret = (is_inter) ? MPI_Comm_remote_group(na_mpi_addr->comm, &group)
+                         : MPI_Comm_group(na_mpi_addr->comm, &group);
+    if (mpi_ret != MPI_SUCCESS) {
+        NA_LOG_ERROR("Could not get group of communicator");
+        ret = NA_PROTOCOL_ERROR;
+        goto done;
+    }
+
+    mpi_ret = MPI_Group_translate_ranks(group, 1, &na_mpi_addr->rank,
+        na_mpi_class->win_group, &na_mpi_addr->win_rank);
+    MPI_Group_free(&group);
+    if (mpi_ret != MPI_SUCCESS || na_mpi_addr->win_rank == MPI_UNDEFINED) {
+        NA_LOG_ERROR("Could not translate rank %d", na_mpi_addr->rank);
+        na_mpi_addr->win_rank = -1;
+        ret = NA_PROTOCOL_ERROR;
+        goto done;
+    }
+
+done:
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static na_return_t
+na_mpi_rma_post(na_class_t *na_class, struct na_mpi_op_id *na_mpi_op_id,
+    void *buf, MPI_Aint disp, int count, struct na_mpi_addr *na_mpi_addr)
+{
+    struct na_mpi_class *na_mpi_class = NA_MPI_CLASS(na_class);
+    na_return_t ret = NA_SUCCESS;
+    int mpi_ret;
+
+    ret = na_mpi_addr_win_rank(na_mpi_class, na_mpi_addr);
+    if (ret != NA_SUCCESS) {
+        NA_LOG_ERROR("Could not get window rank of target");
+        goto done;
+    }
+
+    if (na_mpi_op_id->type == NA_CB_PUT) {
+        mpi_ret = MPI_Rput(buf, count, MPI_BYTE, na_mpi_addr->win_rank, disp,
+            count, MPI_BYTE, na_mpi_class->win,
+            &na_mpi_op_id->info.put.data_request);
+        if (mpi_ret != MPI_SUCCESS) {
+            NA_LOG_ERROR("MPI_Rput() failed");
+            ret = NA_PROTOCOL_ERROR;
+            goto done;
+        }
+        na_mpi_op_id->info.put.target_rank = na_mpi_addr->win_rank;
+    } else {
+        /* Rget requests complete once data is available locally */
+        mpi_ret = MPI_Rget(buf, count, MPI_BYTE, na_mpi_addr->win_rank, disp,
+            count, MPI_BYTE, na_mpi_class->win,
+            &na_mpi_op_id->info.get.data_request);
+        if (mpi_ret != MPI_SUCCESS) {
+            NA_LOG_ERROR("MPI_Rget() failed");
+            ret = NA_PROTOCOL_ERROR;
+            goto done;
+        }
+    }
+
+    NA_LOG_SUBSYS_DEBUG(rma, "Posted native RMA %s of %d bytes to rank %d",
+        (na_mpi_op_id->type == NA_CB_PUT) ? "put" : "get", count,
+        na_mpi_addr->win_rank);
+
+    /* Append op_id to op_id list */
+    hg_thread_mutex_lock(&na_mpi_class->op_id_list_mutex);
+    HG_LIST_INSERT_HEAD(&na_mpi_class->op_id_list, na_mpi_op_id, entry);
+    hg_thread_mutex_unlock(&na_mpi_class->op_id_list_mutex);
+
+done:
+    return ret;
+}
+#endif
+
 /*---------------------------------------------------------------------------*/
 na_return_t
 NA_MPI_Set_init_intra_comm(MPI_Comm intra_comm)
@@ -968,6 +1210,20 @@ na_mpi_initialize(
     /* Initialize atomic op */
     hg_atomic_set32(&na_mpi_class->rma_tag, NA_MPI_RMA_TAG);
 
+#ifdef NA_MPI_HAS_RMA
+    /* Static mode requires MPI_COMM_WORLD to be made of the server and
+     * client groups only (see na_mpi_accept()), whether it was split by the
+     * application or not. All processes can therefore collectively create a
+     * window that spans both clients and servers */
+    if (use_static_inter_comm) {
+        ret = na_mpi_win_create(na_mpi_class);
+        if (ret != NA_SUCCESS) {
+            NA_LOG_ERROR("Could not create RMA window");
+            goto done;
+        }
+    }
+#endif
+
     /* If server opens a port */
     if (listening) {
         na_mpi_class->accepting = true;
@@ -1037,6 +1293,17 @@ na_mpi_finalize(na_class_t *na_class)
         ret = NA_PROTOCOL_ERROR;
     }
 
+#ifdef NA_MPI_HAS_RMA
+    /* Free RMA window */
+    if (NA_MPI_CLASS(na_class)->use_rma) {
+        ret = na_mpi_win_destroy(NA_MPI_CLASS(na_class));
+        if (ret != NA_SUCCESS) {
+            NA_LOG_ERROR("Could not destroy RMA window");
+            goto done;
+        }
+    }
+#endif
+
     /* Free the private dup'ed comm */
     mpi_ret = MPI_Comm_free(&NA_MPI_CLASS(na_class)->intra_comm);
     if (mpi_ret != MPI_SUCCESS) {
@@ -1118,6 +1385,7 @@ na_mpi_addr_lookup(na_class_t *na_class, const char *name, na_addr_t **addr)
         goto done;
     }
     na_mpi_addr->rank = 0;
+    na_mpi_addr->win_rank = -1;
     na_mpi_addr->comm = MPI_COMM_NULL;
     na_mpi_addr->rma_comm = MPI_COMM_NULL;
     na_mpi_addr->unexpected = false;
@@ -1214,6 +1482,7 @@ na_mpi_addr_self(na_class_t *na_class, na_addr_t **addr)
     na_mpi_addr->comm = MPI_COMM_NULL;
     na_mpi_addr->rma_comm = MPI_COMM_NULL;
     na_mpi_addr->rank = 0;
+    na_mpi_addr->win_rank = -1;
     na_mpi_addr->unexpected = false;
     na_mpi_addr->self = true;
     na_mpi_addr->dynamic = false;
@@ -1550,6 +1819,89 @@ na_mpi_mem_handle_free(
     free(mpi_mem_handle);
 }
 
+/*---------------------------------------------------------------------------*/
+static na_return_t
+na_mpi_mem_register(na_class_t *na_class, na_mem_handle_t *mem_handle,
+    enum na_mem_type NA_UNUSED mem_type, uint64_t NA_UNUSED device)
+{
+    na_return_t ret = NA_SUCCESS;
+#ifdef NA_MPI_HAS_RMA
+    struct na_mpi_mem_handle *na_mpi_mem_handle =
+        (struct na_mpi_mem_handle *) mem_handle;
+    int mpi_ret;
+
+    if (!NA_MPI_CLASS(na_class)->use_rma || na_mpi_mem_handle->size == 0)
+        goto done;
+
+    /* Transfers to memory that is not attached fall back to the two-sided
+     * emulation */
+    if (hg_atomic_incr32(&NA_MPI_CLASS(na_class)->attach_count) >
+        NA_MPI_MAX_ATTACH) {
+        hg_atomic_decr32(&NA_MPI_CLASS(na_class)->attach_count);
+        NA_LOG_SUBSYS_DEBUG(mem, "Too many attached regions, using RMA "
+                                 "emulation for %p",
+            na_mpi_mem_handle->base);
+        goto done;
+    }
+    mpi_ret = MPI_Win_attach(NA_MPI_CLASS(na_class)->win,
+        na_mpi_mem_handle->base, na_mpi_mem_handle->size);
+    if (mpi_ret != MPI_SUCCESS) {
+        hg_atomic_decr32(&NA_MPI_CLASS(na_class)->attach_count);
+        NA_LOG_SUBSYS_DEBUG(mem,
+            "MPI_Win_attach() failed, using RMA emulation for %p",
+            na_mpi_mem_handle->base);
+        goto done;
+    }
+    na_mpi_mem_handle->attached = true;
+
+    /* Remote processes address dynamic windows using absolute addresses */
+    mpi_ret =
+        MPI_Get_address(na_mpi_mem_handle->base, &na_mpi_mem_handle->disp);
+    if (mpi_ret != MPI_SUCCESS) {
+        NA_LOG_ERROR("MPI_Get_address() failed");
+        ret = NA_PROTOCOL_ERROR;
+        goto done;
+    }
+
+done:
+#else
+    (void) na_class;
+    (void) mem_handle;
+#endif
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static na_return_t
+na_mpi_mem_deregister(na_class_t *na_class, na_mem_handle_t *mem_handle)
+{
+    na_return_t ret = NA_SUCCESS;
+#ifdef NA_MPI_HAS_RMA
+    struct na_mpi_mem_handle *na_mpi_mem_handle =
+        (struct na_mpi_mem_handle *) mem_handle;
+    int mpi_ret;
+
+    if (!na_mpi_mem_handle->attached)
+        goto done;
+
+    mpi_ret =
+        MPI_Win_detach(NA_MPI_CLASS(na_class)->win, na_mpi_mem_handle->base);
+    if (mpi_ret != MPI_SUCCESS) {
+        NA_LOG_ERROR("MPI_Win_detach() failed");
+        ret = NA_PROTOCOL_ERROR;
+        goto done;
+    }
+    na_mpi_mem_handle->attached = false;
+    hg_atomic_decr32(&NA_MPI_CLASS(na_class)->attach_count);
+
+done:
+#else
+    (void) na_class;
+    (void) mem_handle;
+#endif
+    return ret;
+}
+
 /*---------------------------------------------------------------------------*/
 static size_t
 na_mpi_mem_handle_get_serialize_size(
@@ -1603,6 +1955,8 @@ na_mpi_mem_handle_deserialize(na_class_t NA_UNUSED *na_class,
     }
 
     /* Copy struct */
+    /* Keep attached flag, it tells whether remote memory is in the window
+     * (deserialized handles are never deregistered) */
     memcpy(na_mpi_mem_handle, buf, sizeof(struct na_mpi_mem_handle));
 
     *mem_handle = (na_mem_handle_t *) na_mpi_mem_handle;
@@ -1658,6 +2012,20 @@ na_mpi_put(na_class_t *na_class, na_context_t *context, na_cb_t callback,
     na_mpi_op_id->info.put.data_request = MPI_REQUEST_NULL;
     na_mpi_op_id->info.put.internal_progress = false;
     na_mpi_op_id->info.put.rma_info = NULL;
+    na_mpi_op_id->info.put.target_rank = -1;
+
+#ifdef NA_MPI_HAS_RMA
+    /* Native one-sided put, target does not need to make progress */
+    if (NA_MPI_CLASS(na_class)->use_rma && mpi_remote_mem_handle->attached) {
+        ret = na_mpi_rma_post(na_class, na_mpi_op_id,
+            (char *) mpi_local_mem_handle->base + mpi_local_offset,
+            mpi_remote_mem_handle->disp + mpi_remote_offset, mpi_length,
+            na_mpi_addr);
+        goto done;
+    }
+#endif
+
+    NA_LOG_SUBSYS_DEBUG(rma, "Emulating RMA put of %d bytes", mpi_length);
 
     /* Allocate rma info (use calloc to avoid uninitialized transfer) */
     na_mpi_rma_info =
@@ -1756,6 +2124,19 @@ na_mpi_get(na_class_t *na_class, na_context_t *context, na_cb_t callback,
     na_mpi_op_id->info.put.internal_progress = false;
     na_mpi_op_id->info.get.rma_info = NULL;
 
+#ifdef NA_MPI_HAS_RMA
+    /* Native one-sided get, target does not need to make progress */
+    if (NA_MPI_CLASS(na_class)->use_rma && mpi_remote_mem_handle->attached) {
+        ret = na_mpi_rma_post(na_class, na_mpi_op_id,
+            (char *) mpi_local_mem_handle->base + mpi_local_offset,
+            mpi_remote_mem_handle->disp + mpi_remote_offset, mpi_length,
+            na_mpi_addr);
+        goto done;
+    }
+#endif
+
+    NA_LOG_SUBSYS_DEBUG(rma, "Emulating RMA get of %d bytes", mpi_length);
+
     /* Allocate rma info (use calloc to avoid uninitialized transfer) */
     na_mpi_rma_info =
         (struct na_mpi_rma_info *) calloc(1, sizeof(struct na_mpi_rma_info));
@@ -2186,6 +2567,21 @@ na_mpi_progress_expected(na_class_t *na_class, na_context_t NA_UNUSED *context,
             /* Remove entry from list */
             HG_LIST_REMOVE(na_mpi_op_id, entry);
 
+#ifdef NA_MPI_HAS_RMA
+            /* Rput only completes locally, make sure data has reached the
+             * target before completing */
+            if (na_mpi_op_id->type == NA_CB_PUT &&
+                na_mpi_op_id->info.put.target_rank >= 0) {
+                mpi_ret = MPI_Win_flush(na_mpi_op_id->info.put.target_rank,
+                    NA_MPI_CLASS(na_class)->win);
+                if (mpi_ret != MPI_SUCCESS) {
+                    NA_LOG_ERROR("MPI_Win_flush() failed");
+                    ret = NA_PROTOCOL_ERROR;
+                    goto done;
+                }
+            }
+#endif
+
             ret = na_mpi_complete(na_mpi_op_id);
             if (ret != NA_SUCCESS) {
                 NA_LOG_ERROR("Could not complete operation");
@@ -2257,6 +2653,7 @@ na_mpi_complete(struct na_mpi_op_id *na_mpi_op_id)
             na_mpi_addr->comm = na_mpi_remote_addr->comm;
             na_mpi_addr->rma_comm = na_mpi_remote_addr->rma_comm;
             na_mpi_addr->rank = status->MPI_SOURCE;
+            na_mpi_addr->win_rank = -1;
             na_mpi_addr->unexpected = true;
             na_mpi_addr->self = false;
             na_mpi_addr->dynamic = true;
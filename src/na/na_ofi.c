@@ -11,6 +11,7 @@
 #include "na_ip.h"
 #include "na_loc.h"
 
+#include "mercury_hash_map.h"
 #include "mercury_hash_string.h"
 #include "mercury_hash_table.h"
 #include "mercury_inet.h"
@@ -258,9 +259,14 @@ static unsigned long const na_ofi_prov_flags[] = {NA_OFI_PROV_TYPES};
 #define NA_OFI_TAG_MASK       ((uint64_t) 0x0FFFFFFFF)
 #define NA_OFI_UNEXPECTED_TAG (NA_OFI_TAG_MASK + 1)
 
-/* Default OP multi CQ size */
+/* Number of completion entries allocated at once for multi-event OPs */
 #define NA_OFI_OP_MULTI_CQ_SIZE (64)
 
+/* Initial and max number of entries of directly indexed FI addr table, FI
+ * addrs that exceed the max size are stored in a hash map */
+#define NA_OFI_FI_ADDR_TABLE_SIZE_INIT (256)
+#define NA_OFI_FI_ADDR_TABLE_SIZE_MAX  (1 << 20)
+
 /* Number of CQ event provided for fi_cq_read() */
 #define NA_OFI_CQ_EVENT_NUM (16)
 /* CQ depth (the socket provider's default value is 256 */
@@ -509,12 +515,26 @@ struct na_ofi_rma_info {
     size_t remote_iovcnt;
 };
 
+/* Multi-event completion entry */
+struct na_ofi_completion_multi_entry {
+    struct na_cb_completion_data data;                /* Must remain first */
+    struct na_ofi_completion_multi *completion_multi; /* Owning pool       */
+};
+
+/* Chunk of multi-event completion entries */
+struct na_ofi_completion_multi_chunk {
+    struct na_ofi_completion_multi_chunk *next; /* Next chunk */
+    struct na_ofi_completion_multi_entry entries[NA_OFI_OP_MULTI_CQ_SIZE];
+};
+
+/* Growable pool of multi-event completion entries */
 struct na_ofi_completion_multi {
-    struct na_cb_completion_data *data;
-    hg_atomic_int32_t head;
-    hg_atomic_int32_t tail;
-    int32_t mask;
-    uint32_t size;
+    HG_QUEUE_HEAD(na_cb_completion_data) free_queue; /* Free entries      */
+    struct na_ofi_completion_multi_chunk *chunks;    /* Allocated chunks  */
+    struct na_cb_completion_data **waiter;           /* Starved op entry  */
+    hg_atomic_int32_t *starved_count;                /* Starved op count  */
+    hg_thread_spin_t lock;                           /* Pool lock         */
+    uint32_t size;                                   /* Number of entries */
     uint32_t completion_count; /* Total completion count */
 };
 
@@ -528,7 +548,6 @@ struct na_ofi_op_id {
         struct na_ofi_msg_info msg;     /* Msg info (tagged and non-tagged) */
         struct na_ofi_rma_info rma;     /* RMA info */
     } info;                             /* Op info                  */
-    HG_QUEUE_ENTRY(na_ofi_op_id) multi; /* Entry in multi queue     */
     HG_QUEUE_ENTRY(na_ofi_op_id) retry; /* Entry in retry queue     */
     struct fi_context fi_ctx[2];        /* Context handle           */
     hg_time_t retry_deadline;           /* Retry deadline           */
@@ -566,12 +585,11 @@ struct na_ofi_eq {
 
 /* Context */
 struct na_ofi_context {
-    struct na_ofi_op_queue multi_op_queue; /* To keep track of multi-events */
-    struct fid_ep *fi_tx;                  /* Transmit context handle       */
-    struct fid_ep *fi_rx;                  /* Receive context handle        */
-    struct na_ofi_eq *eq;                  /* Event queues                  */
-    hg_atomic_int32_t multi_op_count;      /* Number of multi-events ops    */
-    uint8_t idx;                           /* Context index                 */
+    struct fid_ep *fi_tx;                  /* Transmit context handle */
+    struct fid_ep *fi_rx;                  /* Receive context handle  */
+    struct na_ofi_eq *eq;                  /* Event queues            */
+    hg_atomic_int32_t multi_starved_count; /* Multi-event ops waiting */
+    uint8_t idx;                           /* Context index           */
 };
 
 /* Endpoint */
@@ -583,11 +601,19 @@ struct na_ofi_endpoint {
     size_t expected_msg_size_max;   /* Max expected msg size */
 };
 
+/* Table of addresses indexed by FI addr */
+struct na_ofi_fi_addr_table {
+    struct na_ofi_fi_addr_table *prev; /* Previous (retired) table */
+    hg_atomic_int64_t *entries;        /* Address pointers */
+    size_t size;                       /* Number of entries */
+};
+
 /* Map (used to cache addresses) */
 struct na_ofi_map {
     hg_thread_rwlock_t lock;
-    hg_hash_table_t *key_map; /* Primary */
-    hg_hash_table_t *fi_map;  /* Secondary */
+    hg_hash_table_t *key_map;   /* Primary */
+    hg_hash_map_t *fi_map;      /* Secondary (large FI addrs) */
+    hg_atomic_int64_t fi_table; /* Secondary (lock-free lookup) */
 };
 
 /* Domain */
@@ -608,6 +634,8 @@ struct na_ofi_domain {
     int64_t max_key;                 /* Max key if not FI_MR_PROV_KEY */
     uint64_t max_tag;                /* Max tag from CQ data size */
     hg_atomic_int32_t *mr_reg_count; /* Number of MR registered */
+    hg_atomic_int32_t *grow_count;   /* Multi-event pool grow count */
+    hg_atomic_int32_t *stall_count;  /* Multi-event CQ stall count */
     int32_t refcount;                /* Refcount of this domain */
     bool no_wait;                    /* Wait disabled on domain */
     bool shared;                     /* Domain may be shared between classes */
@@ -793,6 +821,13 @@ static na_return_t
 na_ofi_addr_key_lookup(struct na_ofi_class *na_ofi_class,
     struct na_ofi_addr_key *addr_key, struct na_ofi_addr **na_ofi_addr_p);
 
+/**
+ * Lookup array of addr keys and insert missing keys at once.
+ */
+static na_return_t
+na_ofi_addr_key_lookup_multi(struct na_ofi_class *na_ofi_class,
+    struct na_ofi_addr_key *addr_keys, size_t count, na_addr_t **addrs);
+
 /**
  * Key hash for hash table.
  */
@@ -833,6 +868,15 @@ na_ofi_addr_map_insert(struct na_ofi_class *na_ofi_class,
     struct na_ofi_map *na_ofi_map, struct na_ofi_addr_key *addr_key,
     struct na_ofi_addr **na_ofi_addr_p);
 
+/**
+ * Insert array of addr keys into map using a single AV insertion. Entries of
+ * na_ofi_addrs that are not NULL are skipped, others are filled.
+ */
+static na_return_t
+na_ofi_addr_map_insert_multi(struct na_ofi_class *na_ofi_class,
+    struct na_ofi_map *na_ofi_map, struct na_ofi_addr_key *addr_keys,
+    size_t count, struct na_ofi_addr **na_ofi_addrs);
+
 /**
  * Remove addr key from map.
  */
@@ -841,22 +885,35 @@ na_ofi_addr_map_remove(
     struct na_ofi_map *na_ofi_map, struct na_ofi_addr_key *addr_key);
 
 /**
- * Key hash for hash table.
+ * Lookup addr key from map.
  */
-static NA_INLINE unsigned int
-na_ofi_fi_addr_hash(hg_hash_table_key_t key);
+static NA_INLINE struct na_ofi_addr *
+na_ofi_fi_addr_map_lookup(struct na_ofi_map *na_ofi_map, fi_addr_t *fi_addr);
 
 /**
- * Compare key.
+ * Insert FI addr into secondary map (map lock must be held).
  */
-static NA_INLINE int
-na_ofi_fi_addr_equal(hg_hash_table_key_t key1, hg_hash_table_key_t key2);
+static na_return_t
+na_ofi_fi_addr_map_insert(struct na_ofi_map *na_ofi_map,
+    fi_addr_t fi_addr, struct na_ofi_addr *na_ofi_addr);
 
 /**
- * Lookup addr key from map.
+ * Remove FI addr from secondary map (map lock must be held).
  */
-static NA_INLINE struct na_ofi_addr *
-na_ofi_fi_addr_map_lookup(struct na_ofi_map *na_ofi_map, fi_addr_t *fi_addr);
+static na_return_t
+na_ofi_fi_addr_map_remove(struct na_ofi_map *na_ofi_map, fi_addr_t fi_addr);
+
+/**
+ * Grow FI addr table so that it can hold at least size entries.
+ */
+static na_return_t
+na_ofi_fi_addr_table_grow(struct na_ofi_map *na_ofi_map, size_t size);
+
+/**
+ * Free FI addr table and all retired tables.
+ */
+static void
+na_ofi_fi_addr_table_free(struct na_ofi_map *na_ofi_map);
 
 /**
  * Get info caps from providers and return matching providers.
@@ -1303,44 +1360,48 @@ static na_return_t
 na_ofi_op_cancel(struct na_ofi_op_id *na_ofi_op_id);
 
 /**
- * Init ring-buffer to hold multi CQ events.
+ * Init pool of entries to hold multi CQ events.
  */
 static na_return_t
-na_ofi_completion_multi_init(
-    struct na_ofi_completion_multi *completion_multi, uint32_t size);
+na_ofi_completion_multi_init(struct na_ofi_completion_multi *completion_multi);
 
 /**
- * Destroy ring-buffer to hold multi CQ events.
+ * Destroy pool of entries to hold multi CQ events.
  */
 static void
 na_ofi_completion_multi_destroy(
     struct na_ofi_completion_multi *completion_multi);
 
 /**
- * Reserve entry to hold CQ data.
+ * Add a new chunk of entries to the pool (lock must be held).
  */
-static struct na_cb_completion_data *
-na_ofi_completion_multi_push(struct na_ofi_completion_multi *completion_multi);
+static na_return_t
+na_ofi_completion_multi_grow(struct na_ofi_completion_multi *completion_multi);
 
 /**
- * Release last entry from ring-buffer.
+ * Reserve entry to hold CQ data, the pool grows if no entry is available.
  */
-static void
-na_ofi_completion_multi_pop(struct na_ofi_completion_multi *completion_multi);
+static struct na_cb_completion_data *
+na_ofi_completion_multi_push(struct na_ofi_completion_multi *completion_multi);
 
 /**
- * Determine whether ring-buffer is empty.
+ * Reserve next entry to hold CQ data. If the pool cannot grow, the next entry
+ * released is handed over to *completion_data_p and *starved_count is
+ * incremented until then so that CQ reads can be paused. Returns true in that
+ * case.
  */
-/*
-static NA_INLINE bool
-na_ofi_completion_multi_empty(struct na_ofi_completion_multi *completion_multi);
-*/
+static bool
+na_ofi_completion_multi_reserve(
+    struct na_ofi_completion_multi *completion_multi,
+    struct na_cb_completion_data **completion_data_p,
+    hg_atomic_int32_t *starved_count);
 
 /**
- * Determine number of entries in the ring-buffer.
+ * Release entry back to the pool.
  */
-static NA_INLINE unsigned int
-na_ofi_completion_multi_count(struct na_ofi_completion_multi *completion_multi);
+static void
+na_ofi_completion_multi_pop(struct na_ofi_completion_multi *completion_multi,
+    struct na_cb_completion_data *completion_data);
 
 /********************/
 /* Plugin callbacks */
@@ -1383,6 +1444,11 @@ na_ofi_op_destroy(na_class_t *na_class, na_op_id_t *op_id);
 static na_return_t
 na_ofi_addr_lookup(na_class_t *na_class, const char *name, na_addr_t **addr_p);
 
+/* addr_lookup_multi */
+static na_return_t
+na_ofi_addr_lookup_multi(na_class_t *na_class, const char *const *names,
+    size_t count, na_addr_t **addrs);
+
 /* addr_free */
 static NA_INLINE void
 na_ofi_addr_free(na_class_t *na_class, na_addr_t *addr);
@@ -1426,6 +1492,11 @@ static na_return_t
 na_ofi_addr_deserialize(
     na_class_t *na_class, na_addr_t **addr_p, const void *buf, size_t buf_size);
 
+/* addr_deserialize_multi */
+static na_return_t
+na_ofi_addr_deserialize_multi(na_class_t *na_class, na_addr_t **addrs,
+    size_t count, const void *buf, size_t stride);
+
 /* msg_get_max_unexpected_size */
 static NA_INLINE size_t
 na_ofi_msg_get_max_unexpected_size(const na_class_t *na_class);
@@ -1438,6 +1509,10 @@ na_ofi_msg_get_max_expected_size(const na_class_t *na_class);
 static NA_INLINE size_t
 na_ofi_msg_get_unexpected_header_size(const na_class_t *na_class);
 
+/* msg_get_max_inject_size */
+static NA_INLINE size_t
+na_ofi_msg_get_max_inject_size(const na_class_t *na_class);
+
 /* msg_get_max_tag */
 static NA_INLINE na_tag_t
 na_ofi_msg_get_max_tag(const na_class_t *na_class);
@@ -1481,6 +1556,12 @@ na_ofi_msg_send_expected(na_class_t *na_class, na_context_t *context,
     void *plugin_data, na_addr_t *dest_addr, uint8_t dest_id, na_tag_t tag,
     na_op_id_t *op_id);
 
+/* msg_send_expected_inject */
+static na_return_t
+na_ofi_msg_send_expected_inject(na_class_t *na_class, na_context_t *context,
+    const void *buf, size_t buf_size, void *plugin_data, na_addr_t *dest_addr,
+    uint8_t dest_id, na_tag_t tag);
+
 /* msg_recv_expected */
 static na_return_t
 na_ofi_msg_recv_expected(na_class_t *na_class, na_context_t *context,
@@ -1572,6 +1653,7 @@ const struct na_class_ops NA_PLUGIN_OPS(ofi) = {
     na_ofi_op_create,                      /* op_create */
     na_ofi_op_destroy,                     /* op_destroy */
     na_ofi_addr_lookup,                    /* addr_lookup */
+    na_ofi_addr_lookup_multi,              /* addr_lookup_multi */
     na_ofi_addr_free,                      /* addr_free */
     na_ofi_addr_set_remove,                /* addr_set_remove */
     na_ofi_addr_self,                      /* addr_self */
@@ -1582,10 +1664,12 @@ const struct na_class_ops NA_PLUGIN_OPS(ofi) = {
     na_ofi_addr_get_serialize_size,        /* addr_get_serialize_size */
     na_ofi_addr_serialize,                 /* addr_serialize */
     na_ofi_addr_deserialize,               /* addr_deserialize */
+    na_ofi_addr_deserialize_multi,         /* addr_deserialize_multi */
     na_ofi_msg_get_max_unexpected_size,    /* msg_get_max_unexpected_size */
     na_ofi_msg_get_max_expected_size,      /* msg_get_max_expected_size */
     na_ofi_msg_get_unexpected_header_size, /* msg_get_unexpected_header_size */
     NULL,                                  /* msg_get_expected_header_size */
+    na_ofi_msg_get_max_inject_size,        /* msg_get_max_inject_size */
     na_ofi_msg_get_max_tag,                /* msg_get_max_tag */
     na_ofi_msg_buf_alloc,                  /* msg_buf_alloc */
     na_ofi_msg_buf_free,                   /* msg_buf_free */
@@ -1595,6 +1679,7 @@ const struct na_class_ops NA_PLUGIN_OPS(ofi) = {
     na_ofi_msg_multi_recv_unexpected,      /* msg_multi_recv_unexpected */
     NULL,                                  /* msg_init_expected */
     na_ofi_msg_send_expected,              /* msg_send_expected */
+    na_ofi_msg_send_expected_inject,       /* msg_send_expected_inject */
     na_ofi_msg_recv_expected,              /* msg_recv_expected */
     na_ofi_mem_handle_create,              /* mem_handle_create */
     na_ofi_mem_handle_create_segments,     /* mem_handle_create_segment */
@@ -2471,6 +2556,54 @@ error:
     return ret;
 }
 
+/*---------------------------------------------------------------------------*/
+static na_return_t
+na_ofi_addr_key_lookup_multi(struct na_ofi_class *na_ofi_class,
+    struct na_ofi_addr_key *addr_keys, size_t count, na_addr_t **addrs)
+{
+    struct na_ofi_map *na_ofi_map = &na_ofi_class->domain->addr_map;
+    struct na_ofi_addr **na_ofi_addrs = NULL;
+    size_t n_missing = 0, i;
+    na_return_t ret;
+
+    na_ofi_addrs = (struct na_ofi_addr **) calloc(count, sizeof(*na_ofi_addrs));
+    NA_CHECK_SUBSYS_ERROR(addr, na_ofi_addrs == NULL, error, ret, NA_NOMEM,
+        "Could not allocate array of addrs");
+
+    /* Addresses already known only require a map lookup */
+    for (i = 0; i < count; i++) {
+        na_ofi_addrs[i] = na_ofi_addr_map_lookup(na_ofi_map, &addr_keys[i]);
+        if (na_ofi_addrs[i] == NULL)
+            n_missing++;
+    }
+
+    NA_LOG_SUBSYS_DEBUG(
+        addr, "%zu/%zu addresses were not found", n_missing, count);
+
+    /* Insert all missing addresses at once */
+    if (n_missing > 0) {
+        ret = na_ofi_addr_map_insert_multi(
+            na_ofi_class, na_ofi_map, addr_keys, count, na_ofi_addrs);
+        NA_CHECK_SUBSYS_NA_ERROR(
+            addr, error, ret, "Could not insert %zu addresses", n_missing);
+    }
+
+    /* Map keeps its own reference, take one for the caller */
+    for (i = 0; i < count; i++) {
+        na_ofi_addr_ref_incr(na_ofi_addrs[i]);
+        addrs[i] = (na_addr_t *) na_ofi_addrs[i];
+    }
+
+    free(na_ofi_addrs);
+
+    return NA_SUCCESS;
+
+error:
+    free(na_ofi_addrs);
+
+    return ret;
+}
+
 /*---------------------------------------------------------------------------*/
 static NA_INLINE unsigned int
 na_ofi_addr_key_hash(hg_hash_table_key_t key)
@@ -2576,11 +2709,9 @@ na_ofi_addr_map_insert(struct na_ofi_class *na_ofi_class,
 
     /* Insert new value to secondary map to look up by FI addr and prevent
      * fi_av_lookup() followed by map lookup call */
-    rc = hg_hash_table_insert(na_ofi_map->fi_map,
-        (hg_hash_table_key_t) &na_ofi_addr->fi_addr,
-        (hg_hash_table_value_t) na_ofi_addr);
-    NA_CHECK_SUBSYS_ERROR(
-        addr, rc == 0, out, ret, NA_NOMEM, "hg_hash_table_insert() failed");
+    ret = na_ofi_fi_addr_map_insert(
+        na_ofi_map, na_ofi_addr->fi_addr, na_ofi_addr);
+    NA_CHECK_SUBSYS_NA_ERROR(addr, out, ret, "Could not insert FI addr");
 
     /* Insert new value to primary map */
     rc = hg_hash_table_insert(na_ofi_map->key_map,
@@ -2604,6 +2735,117 @@ error:
     return ret;
 }
 
+/*---------------------------------------------------------------------------*/
+static na_return_t
+na_ofi_addr_map_insert_multi(struct na_ofi_class *na_ofi_class,
+    struct na_ofi_map *na_ofi_map, struct na_ofi_addr_key *addr_keys,
+    size_t count, struct na_ofi_addr **na_ofi_addrs)
+{
+    size_t addr_size =
+        na_ofi_prov_addr_size((int) na_ofi_class->fi_info->addr_format);
+    struct na_ofi_addr **new_addrs = NULL;
+    fi_addr_t *fi_addrs = NULL;
+    char *raw_addrs = NULL;
+    size_t n_new = 0, n_mapped = 0, i;
+    na_return_t ret = NA_SUCCESS;
+    int rc;
+
+    new_addrs = (struct na_ofi_addr **) malloc(count * sizeof(*new_addrs));
+    NA_CHECK_SUBSYS_ERROR(addr, new_addrs == NULL, out, ret, NA_NOMEM,
+        "Could not allocate array of new addrs");
+
+    fi_addrs = (fi_addr_t *) malloc(count * sizeof(*fi_addrs));
+    NA_CHECK_SUBSYS_ERROR(addr, fi_addrs == NULL, out, ret, NA_NOMEM,
+        "Could not allocate array of FI addrs");
+
+    /* Raw addresses must be packed contiguously for fi_av_insert() */
+    raw_addrs = (char *) malloc(count * addr_size);
+    NA_CHECK_SUBSYS_ERROR(addr, raw_addrs == NULL, out, ret, NA_NOMEM,
+        "Could not allocate array of raw addrs");
+
+    hg_thread_rwlock_wrlock(&na_ofi_map->lock);
+
+    for (i = 0; i < count; i++) {
+        struct na_ofi_addr *na_ofi_addr;
+
+        if (na_ofi_addrs[i] != NULL)
+            continue;
+
+        /* Look up again to prevent race between lock release/acquire, this
+         * also removes duplicates from the batch */
+        na_ofi_addr = (struct na_ofi_addr *) hg_hash_table_lookup(
+            na_ofi_map->key_map, (hg_hash_table_key_t) &addr_keys[i]);
+        if (na_ofi_addr == NULL) {
+            ret = na_ofi_addr_create(na_ofi_class, &addr_keys[i], &na_ofi_addr);
+            NA_CHECK_SUBSYS_NA_ERROR(
+                addr, error, ret, "Could not allocate address");
+
+            rc = hg_hash_table_insert(na_ofi_map->key_map,
+                (hg_hash_table_key_t) &na_ofi_addr->addr_key,
+                (hg_hash_table_value_t) na_ofi_addr);
+            if (rc == 0) {
+                na_ofi_addr->addr_key.val = 0;
+                na_ofi_addr_destroy(na_ofi_addr);
+                NA_GOTO_SUBSYS_ERROR(
+                    addr, error, ret, NA_NOMEM, "hg_hash_table_insert() failed");
+            }
+
+            memcpy(raw_addrs + n_new * addr_size, &na_ofi_addr->addr_key.addr,
+                addr_size);
+            fi_addrs[n_new] = FI_ADDR_NOTAVAIL;
+            new_addrs[n_new++] = na_ofi_addr;
+        }
+        na_ofi_addrs[i] = na_ofi_addr;
+    }
+
+    if (n_new > 0) {
+        /* Insert all new addrs into AV at once */
+        rc = fi_av_insert(na_ofi_class->domain->fi_av, raw_addrs, n_new,
+            fi_addrs, 0 /* flags */, NULL);
+        NA_CHECK_SUBSYS_ERROR(addr, rc < 0 || (size_t) rc != n_new, error, ret,
+            (rc < 0) ? na_ofi_errno_to_na(-rc) : NA_ADDRNOTAVAIL,
+            "fi_av_insert() failed, inserted: %d/%zu", rc, n_new);
+
+        NA_LOG_SUBSYS_DEBUG(addr, "Inserted %zu new addrs", n_new);
+
+        for (n_mapped = 0; n_mapped < n_new; n_mapped++) {
+            new_addrs[n_mapped]->fi_addr = fi_addrs[n_mapped];
+            ret = na_ofi_fi_addr_map_insert(
+                na_ofi_map, fi_addrs[n_mapped], new_addrs[n_mapped]);
+            NA_CHECK_SUBSYS_NA_ERROR(
+                addr, error, ret, "Could not insert FI addr");
+        }
+    }
+
+    hg_thread_rwlock_release_wrlock(&na_ofi_map->lock);
+
+out:
+    free(new_addrs);
+    free(fi_addrs);
+    free(raw_addrs);
+
+    return ret;
+
+error:
+    /* Roll back new entries, existing entries are left untouched */
+    for (i = 0; i < n_new; i++) {
+        struct na_ofi_addr *na_ofi_addr = new_addrs[i];
+
+        hg_hash_table_remove(
+            na_ofi_map->key_map, (hg_hash_table_key_t) &na_ofi_addr->addr_key);
+        if (i < n_mapped)
+            (void) na_ofi_fi_addr_map_remove(na_ofi_map, fi_addrs[i]);
+        if (fi_addrs[i] != FI_ADDR_NOTAVAIL)
+            (void) fi_av_remove(
+                na_ofi_class->domain->fi_av, &fi_addrs[i], 1, 0 /* flags */);
+        na_ofi_addr->addr_key.val = 0;
+        na_ofi_addr_destroy(na_ofi_addr);
+    }
+    hg_thread_rwlock_release_wrlock(&na_ofi_map->lock);
+
+    goto out;
+}
+
 /*---------------------------------------------------------------------------*/
 static na_return_t
 na_ofi_addr_map_remove(
@@ -2627,10 +2869,8 @@ na_ofi_addr_map_remove(
         "hg_hash_table_remove() failed");
 
     /* Remove FI addr from secondary map */
-    rc = hg_hash_table_remove(
-        na_ofi_map->fi_map, (hg_hash_table_key_t) &na_ofi_addr->fi_addr);
-    NA_CHECK_SUBSYS_ERROR(addr, rc != 1, unlock, ret, NA_NOENTRY,
-        "hg_hash_table_remove() failed");
+    ret = na_ofi_fi_addr_map_remove(na_ofi_map, na_ofi_addr->fi_addr);
+    NA_CHECK_SUBSYS_NA_ERROR(addr, unlock, ret, "Could not remove FI addr");
 
     /* Remove address from AV */
     rc = fi_av_remove(na_ofi_addr->class->domain->fi_av, &na_ofi_addr->fi_addr,
@@ -2650,38 +2890,176 @@ unlock:
 }
 
 /*---------------------------------------------------------------------------*/
-static NA_INLINE unsigned int
-na_ofi_fi_addr_hash(hg_hash_table_key_t key)
+static NA_INLINE struct na_ofi_addr *
+na_ofi_fi_addr_map_lookup(struct na_ofi_map *na_ofi_map, fi_addr_t *fi_addr)
 {
-    fi_addr_t fi_addr = *((fi_addr_t *) key);
-    uint32_t hi, lo;
+    struct na_ofi_fi_addr_table *fi_table =
+        (struct na_ofi_fi_addr_table *) (uintptr_t) hg_atomic_get64(
+            &na_ofi_map->fi_table);
+    struct na_ofi_addr *na_ofi_addr;
 
-    hi = (uint32_t) (fi_addr >> 32);
-    lo = (fi_addr & 0xFFFFFFFFU);
+    /* Lock-free lookup, AV indices are dense so most FI addrs are small */
+    if (likely(fi_table != NULL && *fi_addr < fi_table->size)) {
+        na_ofi_addr = (struct na_ofi_addr *) (uintptr_t) hg_atomic_get64(
+            &fi_table->entries[*fi_addr]);
+        if (likely(na_ofi_addr != NULL))
+            return na_ofi_addr;
+    }
 
-    return ((hi & 0xFFFF0000U) | (lo & 0xFFFFU));
+    /* Entry is either not present, not published yet or FI addr is too large
+     * to be indexed, take the lock to synchronize with insertion */
+    hg_thread_rwlock_rdlock(&na_ofi_map->lock);
+    if (*fi_addr < NA_OFI_FI_ADDR_TABLE_SIZE_MAX) {
+        fi_table = (struct na_ofi_fi_addr_table *) (uintptr_t) hg_atomic_get64(
+            &na_ofi_map->fi_table);
+        na_ofi_addr = (fi_table != NULL && *fi_addr < fi_table->size)
+                          ? (struct na_ofi_addr *) (uintptr_t) hg_atomic_get64(
+                                &fi_table->entries[*fi_addr])
+                          : NULL;
+    } else
+        na_ofi_addr = (struct na_ofi_addr *) hg_hash_map_lookup(
+            na_ofi_map->fi_map, fi_addr);
+    hg_thread_rwlock_release_rdlock(&na_ofi_map->lock);
+
+    return na_ofi_addr;
 }
 
 /*---------------------------------------------------------------------------*/
-static NA_INLINE int
-na_ofi_fi_addr_equal(hg_hash_table_key_t key1, hg_hash_table_key_t key2)
+static na_return_t
+na_ofi_fi_addr_map_insert(struct na_ofi_map *na_ofi_map,
+    fi_addr_t fi_addr, struct na_ofi_addr *na_ofi_addr)
 {
-    return *((fi_addr_t *) key1) == *((fi_addr_t *) key2);
+    struct na_ofi_fi_addr_table *fi_table;
+    na_return_t ret;
+    int rc;
+
+    if (fi_addr >= NA_OFI_FI_ADDR_TABLE_SIZE_MAX) {
+        rc = hg_hash_map_insert(na_ofi_map->fi_map, &fi_addr, na_ofi_addr);
+        NA_CHECK_SUBSYS_ERROR(addr, rc == 0, error, ret, NA_NOMEM,
+            "hg_hash_map_insert() failed");
+
+        return NA_SUCCESS;
+    }
+
+    fi_table = (struct na_ofi_fi_addr_table *) (uintptr_t) hg_atomic_get64(
+        &na_ofi_map->fi_table);
+    if (fi_table == NULL || fi_addr >= fi_table->size) {
+        ret = na_ofi_fi_addr_table_grow(na_ofi_map, (size_t) fi_addr + 1);
+        NA_CHECK_SUBSYS_NA_ERROR(
+            addr, error, ret, "Could not grow FI addr table");
+
+        fi_table = (struct na_ofi_fi_addr_table *) (uintptr_t) hg_atomic_get64(
+            &na_ofi_map->fi_table);
+    }
+
+    /* Publish entry, address must be fully initialized at this point */
+    hg_atomic_set64(
+        &fi_table->entries[fi_addr], (int64_t) (uintptr_t) na_ofi_addr);
+
+    return NA_SUCCESS;
+
+error:
+    return ret;
 }
 
 /*---------------------------------------------------------------------------*/
-static NA_INLINE struct na_ofi_addr *
-na_ofi_fi_addr_map_lookup(struct na_ofi_map *na_ofi_map, fi_addr_t *fi_addr)
+static na_return_t
+na_ofi_fi_addr_map_remove(struct na_ofi_map *na_ofi_map, fi_addr_t fi_addr)
 {
-    hg_hash_table_value_t value = NULL;
+    struct na_ofi_fi_addr_table *fi_table;
+    na_return_t ret;
+    int rc;
 
-    /* Lookup key */
-    hg_thread_rwlock_rdlock(&na_ofi_map->lock);
-    value =
-        hg_hash_table_lookup(na_ofi_map->fi_map, (hg_hash_table_key_t) fi_addr);
-    hg_thread_rwlock_release_rdlock(&na_ofi_map->lock);
+    if (fi_addr >= NA_OFI_FI_ADDR_TABLE_SIZE_MAX) {
+        rc = hg_hash_map_remove(na_ofi_map->fi_map, &fi_addr);
+        NA_CHECK_SUBSYS_ERROR(addr, rc != 1, error, ret, NA_NOENTRY,
+            "hg_hash_map_remove() failed");
 
-    return (value == HG_HASH_TABLE_NULL) ? NULL : (struct na_ofi_addr *) value;
+        return NA_SUCCESS;
+    }
+
+    fi_table = (struct na_ofi_fi_addr_table *) (uintptr_t) hg_atomic_get64(
+        &na_ofi_map->fi_table);
+    NA_CHECK_SUBSYS_ERROR(addr, fi_table == NULL || fi_addr >= fi_table->size,
+        error, ret, NA_NOENTRY, "FI addr %" PRIu64 " not found", fi_addr);
+
+    /* Clear entry from retired tables as well so that a concurrent reader
+     * still holding a retired table cannot return a stale address */
+    for (; fi_table != NULL; fi_table = fi_table->prev)
+        if (fi_addr < fi_table->size)
+            hg_atomic_set64(&fi_table->entries[fi_addr], 0);
+
+    return NA_SUCCESS;
+
+error:
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static na_return_t
+na_ofi_fi_addr_table_grow(struct na_ofi_map *na_ofi_map, size_t size)
+{
+    struct na_ofi_fi_addr_table *old_table =
+        (struct na_ofi_fi_addr_table *) (uintptr_t) hg_atomic_get64(
+            &na_ofi_map->fi_table);
+    struct na_ofi_fi_addr_table *new_table = NULL;
+    size_t new_size =
+        (old_table != NULL) ? old_table->size : NA_OFI_FI_ADDR_TABLE_SIZE_INIT;
+    size_t i;
+    na_return_t ret;
+
+    while (new_size < size)
+        new_size *= 2;
+    if (new_size > NA_OFI_FI_ADDR_TABLE_SIZE_MAX)
+        new_size = NA_OFI_FI_ADDR_TABLE_SIZE_MAX;
+
+    new_table = (struct na_ofi_fi_addr_table *) malloc(sizeof(*new_table));
+    NA_CHECK_SUBSYS_ERROR(addr, new_table == NULL, error, ret, NA_NOMEM,
+        "Could not allocate FI addr table");
+
+    new_table->entries =
+        (hg_atomic_int64_t *) malloc(new_size * sizeof(hg_atomic_int64_t));
+    NA_CHECK_SUBSYS_ERROR(addr, new_table->entries == NULL, error, ret,
+        NA_NOMEM, "Could not allocate FI addr table entries (%zu)", new_size);
+    new_table->size = new_size;
+    new_table->prev = old_table;
+
+    for (i = 0; i < new_size; i++)
+        hg_atomic_init64(&new_table->entries[i],
+            (old_table != NULL && i < old_table->size)
+                ? hg_atomic_get64(&old_table->entries[i])
+                : 0);
+
+    /* Readers may still be using the old table, it is therefore only retired
+     * and released once the domain is destroyed */
+    hg_atomic_set64(&na_ofi_map->fi_table, (int64_t) (uintptr_t) new_table);
+
+    NA_LOG_SUBSYS_DEBUG(addr, "Grew FI addr table to %zu entries", new_size);
+
+    return NA_SUCCESS;
+
+error:
+    free(new_table);
+
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static void
+na_ofi_fi_addr_table_free(struct na_ofi_map *na_ofi_map)
+{
+    struct na_ofi_fi_addr_table *fi_table =
+        (struct na_ofi_fi_addr_table *) (uintptr_t) hg_atomic_get64(
+            &na_ofi_map->fi_table);
+
+    while (fi_table != NULL) {
+        struct na_ofi_fi_addr_table *prev = fi_table->prev;
+
+        free(fi_table->entries);
+        free(fi_table);
+        fi_table = prev;
+    }
+    hg_atomic_set64(&na_ofi_map->fi_table, 0);
 }
 
 /*---------------------------------------------------------------------------*/
@@ -3532,6 +3910,10 @@ na_ofi_domain_open(const struct na_ofi_fabric *na_ofi_fabric,
 
     HG_LOG_ADD_COUNTER32(
         na, &na_ofi_domain->mr_reg_count, "mr_reg_count", "MR reg count");
+    HG_LOG_ADD_COUNTER32(na, &na_ofi_domain->grow_count, "multi_grow_count",
+        "Multi-event completion pool grow count");
+    HG_LOG_ADD_COUNTER32(na, &na_ofi_domain->stall_count, "multi_stall_count",
+        "Multi-event CQ read stall count");
 
     /* Init rw lock */
     rc = hg_thread_rwlock_init(&na_ofi_domain->addr_map.lock);
@@ -3673,8 +4055,7 @@ na_ofi_domain_open(const struct na_ofi_fabric *na_ofi_fabric,
         ret, NA_NOMEM, "Could not allocate key map");
 
     /* Create secondary hash-table to lookup by fi_addr */
-    na_ofi_domain->addr_map.fi_map =
-        hg_hash_table_new(na_ofi_fi_addr_hash, na_ofi_fi_addr_equal);
+    na_ofi_domain->addr_map.fi_map = hg_hash_map_new(sizeof(fi_addr_t));
     NA_CHECK_SUBSYS_ERROR(addr, na_ofi_domain->addr_map.fi_map == NULL, error,
         ret, NA_NOMEM, "Could not allocate FI addr map");
 
@@ -3698,7 +4079,8 @@ error:
         if (na_ofi_domain->addr_map.key_map)
             hg_hash_table_free(na_ofi_domain->addr_map.key_map);
         if (na_ofi_domain->addr_map.fi_map)
-            hg_hash_table_free(na_ofi_domain->addr_map.fi_map);
+            hg_hash_map_free(na_ofi_domain->addr_map.fi_map);
+        na_ofi_fi_addr_table_free(&na_ofi_domain->addr_map);
 
         hg_thread_rwlock_destroy(&na_ofi_domain->addr_map.lock);
         free(na_ofi_domain->name);
@@ -3756,7 +4138,8 @@ na_ofi_domain_close(
     if (na_ofi_domain->addr_map.key_map)
         hg_hash_table_free(na_ofi_domain->addr_map.key_map);
     if (na_ofi_domain->addr_map.fi_map)
-        hg_hash_table_free(na_ofi_domain->addr_map.fi_map);
+        hg_hash_map_free(na_ofi_domain->addr_map.fi_map);
+    na_ofi_fi_addr_table_free(&na_ofi_domain->addr_map);
 
     hg_thread_rwlock_destroy(&na_ofi_domain->addr_map.lock);
 
@@ -5562,24 +5945,18 @@ na_ofi_op_complete_multi(
 {
     struct na_cb_completion_data *completion_data =
         na_ofi_op_id->completion_data;
+    struct na_ofi_completion_multi *completion_multi =
+        &na_ofi_op_id->completion_data_storage.multi;
+    struct na_ofi_domain *na_ofi_domain = na_ofi_op_id->na_ofi_class->domain;
+    uint32_t pool_size = completion_multi->size;
 
-    na_ofi_op_id->completion_data_storage.multi.completion_count++;
+    completion_multi->completion_count++;
 
     if (complete) {
-        struct na_ofi_op_queue *multi_op_queue =
-            &NA_OFI_CONTEXT(na_ofi_op_id->context)->multi_op_queue;
-
         /* Mark op id as completed (independent of cb_ret) */
         hg_atomic_or32(&na_ofi_op_id->status, NA_OFI_OP_COMPLETED);
         NA_LOG_SUBSYS_DEBUG(op, "Completed %" PRIu32 " events for same buffer",
-            na_ofi_op_id->completion_data_storage.multi.completion_count);
-
-        hg_thread_spin_lock(&multi_op_queue->lock);
-        HG_QUEUE_REMOVE(
-            &multi_op_queue->queue, na_ofi_op_id, na_ofi_op_id, multi);
-        hg_atomic_decr32(
-            &NA_OFI_CONTEXT(na_ofi_op_id->context)->multi_op_count);
-        hg_thread_spin_unlock(&multi_op_queue->lock);
+            completion_multi->completion_count);
     }
 
     /* Set callback ret */
@@ -5588,30 +5965,33 @@ na_ofi_op_complete_multi(
     completion_data->callback_info.ret = cb_ret;
     completion_data->callback = na_ofi_op_id->callback;
 
-    completion_data->plugin_callback_args = na_ofi_op_id;
+    /* Entry is released back to the pool once the callback has been
+     * triggered */
+    completion_data->plugin_callback_args = completion_data;
     completion_data->plugin_callback = na_ofi_op_release_multi;
 
-    /* In the case of multi-event, set next completion data */
-    na_ofi_op_id->completion_data = na_ofi_completion_multi_push(
-        &na_ofi_op_id->completion_data_storage.multi);
-    NA_CHECK_SUBSYS_ERROR_NORET(
-        op, na_ofi_op_id->completion_data == NULL, error, "Queue is full");
+    /* In the case of multi-event, set next completion data (the pool grows on
+     * demand so that CQ reads only wait for NA_Trigger() if it cannot) */
+    if (na_ofi_completion_multi_reserve(completion_multi,
+            &na_ofi_op_id->completion_data,
+            &NA_OFI_CONTEXT(na_ofi_op_id->context)->multi_starved_count))
+        hg_atomic_incr32(na_ofi_domain->stall_count);
+    else if (completion_multi->size != pool_size)
+        hg_atomic_incr32(na_ofi_domain->grow_count);
 
     NA_LOG_SUBSYS_DEBUG(op, "Adding completion data to queue");
     /* Add OP to NA completion queue */
     na_cb_completion_add(na_ofi_op_id->context, completion_data);
-
-error:
-    return;
 }
 
 /*---------------------------------------------------------------------------*/
 static NA_INLINE void
 na_ofi_op_release_multi(void *arg)
 {
-    struct na_ofi_op_id *na_ofi_op_id = (struct na_ofi_op_id *) arg;
+    struct na_ofi_completion_multi_entry *entry =
+        (struct na_ofi_completion_multi_entry *) arg;
 
-    na_ofi_completion_multi_pop(&na_ofi_op_id->completion_data_storage.multi);
+    na_ofi_completion_multi_pop(entry->completion_multi, &entry->data);
 }
 
 /*---------------------------------------------------------------------------*/
@@ -5674,23 +6054,30 @@ error:
 
 /*---------------------------------------------------------------------------*/
 static na_return_t
-na_ofi_completion_multi_init(
-    struct na_ofi_completion_multi *completion_multi, unsigned int count)
+na_ofi_completion_multi_init(struct na_ofi_completion_multi *completion_multi)
 {
     na_return_t ret;
+    int rc;
 
-    completion_multi->data = (struct na_cb_completion_data *) calloc(
-        count, sizeof(struct na_cb_completion_data));
-    NA_CHECK_SUBSYS_ERROR(op, completion_multi->data == NULL, error, ret,
-        NA_NOMEM, "Could not allocate %u completion data entries", count);
-    completion_multi->size = count;
-    completion_multi->mask = (int32_t) (count - 1);
-    hg_atomic_init32(&completion_multi->head, 0);
-    hg_atomic_init32(&completion_multi->tail, 0);
+    HG_QUEUE_INIT(&completion_multi->free_queue);
+    completion_multi->chunks = NULL;
+    completion_multi->waiter = NULL;
+    completion_multi->starved_count = NULL;
+    completion_multi->size = 0;
     completion_multi->completion_count = 0;
 
+    rc = hg_thread_spin_init(&completion_multi->lock);
+    NA_CHECK_SUBSYS_ERROR(op, rc != HG_UTIL_SUCCESS, error, ret, NA_NOMEM,
+        "hg_thread_spin_init() failed");
+
+    ret = na_ofi_completion_multi_grow(completion_multi);
+    NA_CHECK_SUBSYS_NA_ERROR(op, error_lock, ret,
+        "Could not allocate multi-event completion entries");
+
     return NA_SUCCESS;
 
+error_lock:
+    (void) hg_thread_spin_destroy(&completion_multi->lock);
 error:
     return ret;
 }
@@ -5700,67 +6087,118 @@ static void
 na_ofi_completion_multi_destroy(
     struct na_ofi_completion_multi *completion_multi)
 {
-    free(completion_multi->data);
-    completion_multi->data = NULL;
+    struct na_ofi_completion_multi_chunk *chunk = completion_multi->chunks;
+
+    /* Op is destroyed while waiting for an entry */
+    if (completion_multi->waiter != NULL)
+        hg_atomic_decr32(completion_multi->starved_count);
+
+    while (chunk != NULL) {
+        struct na_ofi_completion_multi_chunk *next = chunk->next;
+
+        free(chunk);
+        chunk = next;
+    }
+    completion_multi->chunks = NULL;
+    HG_QUEUE_INIT(&completion_multi->free_queue);
+    (void) hg_thread_spin_destroy(&completion_multi->lock);
 }
 
 /*---------------------------------------------------------------------------*/
-static struct na_cb_completion_data *
-na_ofi_completion_multi_push(struct na_ofi_completion_multi *completion_multi)
+static na_return_t
+na_ofi_completion_multi_grow(struct na_ofi_completion_multi *completion_multi)
 {
-    struct na_cb_completion_data *completion_data;
-    int32_t head, next, tail;
+    struct na_ofi_completion_multi_chunk *chunk;
+    na_return_t ret;
+    unsigned int i;
 
-    head = hg_atomic_get32(&completion_multi->head);
-    next = (head + 1) & completion_multi->mask;
-    tail = hg_atomic_get32(&completion_multi->tail);
+    chunk = (struct na_ofi_completion_multi_chunk *) calloc(1, sizeof(*chunk));
+    NA_CHECK_SUBSYS_ERROR(op, chunk == NULL, error, ret, NA_NOMEM,
+        "Could not allocate %d completion data entries",
+        NA_OFI_OP_MULTI_CQ_SIZE);
 
-    if (next == tail)
-        /* Full */
-        return NULL;
+    for (i = 0; i < NA_OFI_OP_MULTI_CQ_SIZE; i++) {
+        chunk->entries[i].completion_multi = completion_multi;
+        HG_QUEUE_PUSH_TAIL(
+            &completion_multi->free_queue, &chunk->entries[i].data, entry);
+    }
+    chunk->next = completion_multi->chunks;
+    completion_multi->chunks = chunk;
+    completion_multi->size += NA_OFI_OP_MULTI_CQ_SIZE;
 
-    completion_data = &completion_multi->data[head];
+    NA_LOG_SUBSYS_DEBUG(op, "Grew multi-event completion pool to %" PRIu32
+                            " entries", completion_multi->size);
 
-    hg_atomic_set32(&completion_multi->head, next);
+    return NA_SUCCESS;
 
-    return completion_data;
+error:
+    return ret;
 }
 
 /*---------------------------------------------------------------------------*/
-static void
-na_ofi_completion_multi_pop(struct na_ofi_completion_multi *completion_multi)
+static struct na_cb_completion_data *
+na_ofi_completion_multi_push(struct na_ofi_completion_multi *completion_multi)
 {
-    int32_t head, next, tail;
+    struct na_cb_completion_data *completion_data = NULL;
+
+    hg_thread_spin_lock(&completion_multi->lock);
+    if (HG_QUEUE_IS_EMPTY(&completion_multi->free_queue) &&
+        na_ofi_completion_multi_grow(completion_multi) != NA_SUCCESS)
+        goto unlock;
 
-    head = hg_atomic_get32(&completion_multi->head);
-    tail = hg_atomic_get32(&completion_multi->tail);
+    completion_data = HG_QUEUE_FIRST(&completion_multi->free_queue);
+    HG_QUEUE_POP_HEAD(&completion_multi->free_queue, entry);
 
-    if (head == tail)
-        /* Empty */
-        return;
+unlock:
+    hg_thread_spin_unlock(&completion_multi->lock);
 
-    next = (tail + 1) & completion_multi->mask;
-    hg_atomic_set32(&completion_multi->tail, next);
+    return completion_data;
 }
 
 /*---------------------------------------------------------------------------*/
-/*
-static NA_INLINE bool
-na_ofi_completion_multi_empty(struct na_ofi_completion_multi *completion_multi)
-{
-    return hg_atomic_get32(&completion_multi->head) ==
-           hg_atomic_get32(&completion_multi->tail);
+static bool
+na_ofi_completion_multi_reserve(
+    struct na_ofi_completion_multi *completion_multi,
+    struct na_cb_completion_data **completion_data_p,
+    hg_atomic_int32_t *starved_count)
+{
+    bool starved = false;
+
+    hg_thread_spin_lock(&completion_multi->lock);
+    if (HG_QUEUE_IS_EMPTY(&completion_multi->free_queue) &&
+        na_ofi_completion_multi_grow(completion_multi) != NA_SUCCESS) {
+        NA_LOG_SUBSYS_WARNING(op,
+            "Could not grow multi-event completion pool, pausing CQ reads "
+            "until entries are released");
+        *completion_data_p = NULL;
+        completion_multi->waiter = completion_data_p;
+        completion_multi->starved_count = starved_count;
+        hg_atomic_incr32(starved_count);
+        starved = true;
+    } else {
+        *completion_data_p = HG_QUEUE_FIRST(&completion_multi->free_queue);
+        HG_QUEUE_POP_HEAD(&completion_multi->free_queue, entry);
+    }
+    hg_thread_spin_unlock(&completion_multi->lock);
+
+    return starved;
 }
-*/
 
 /*---------------------------------------------------------------------------*/
-static NA_INLINE unsigned int
-na_ofi_completion_multi_count(struct na_ofi_completion_multi *completion_multi)
-{
-    return (unsigned int) (((int32_t) completion_multi->size +
-                               hg_atomic_get32(&completion_multi->head) -
-                               hg_atomic_get32(&completion_multi->tail)) &
-                           completion_multi->mask);
+static void
+na_ofi_completion_multi_pop(struct na_ofi_completion_multi *completion_multi,
+    struct na_cb_completion_data *completion_data)
+{
+    hg_thread_spin_lock(&completion_multi->lock);
+    if (completion_multi->waiter != NULL) {
+        /* Hand entry over to starved op and resume CQ reads */
+        *completion_multi->waiter = completion_data;
+        completion_multi->waiter = NULL;
+        hg_atomic_decr32(completion_multi->starved_count);
+    } else
+        HG_QUEUE_PUSH_TAIL(
+            &completion_multi->free_queue, completion_data, entry);
+    hg_thread_spin_unlock(&completion_multi->lock);
 }
 
 /********************/
@@ -5835,6 +6273,7 @@ na_ofi_initialize(
     na_return_t ret;
 #ifdef NA_OFI_HAS_MEM_POOL
     size_t pool_chunk_size;
+    unsigned long pool_flags;
 #endif
 #ifdef NA_OFI_HAS_ADDR_POOL
     unsigned int i;
@@ -5964,11 +6403,12 @@ na_ofi_initialize(
 #ifdef NA_OFI_HAS_MEM_POOL
     pool_chunk_size = MAX(na_ofi_class->endpoint->unexpected_msg_size_max,
         na_ofi_class->endpoint->expected_msg_size_max);
+    pool_flags = na_init_info.msg_buf_huge_pages ? HG_MEM_POOL_HUGE_PAGES : 0;
 
     /* Register initial mempool */
     na_ofi_class->send_pool = hg_mem_pool_create(pool_chunk_size,
         NA_OFI_MEM_CHUNK_COUNT, NA_OFI_MEM_BLOCK_COUNT, na_ofi_mem_buf_register,
-        NA_SEND, na_ofi_mem_buf_deregister, (void *) na_ofi_class);
+        NA_SEND | pool_flags, na_ofi_mem_buf_deregister, (void *) na_ofi_class);
     NA_CHECK_SUBSYS_ERROR(cls, na_ofi_class->send_pool == NULL, error, ret,
         NA_NOMEM,
         "Could not create send pool with %d blocks of size %d x %zu bytes",
@@ -5977,7 +6417,7 @@ na_ofi_initialize(
     /* Register initial mempool */
     na_ofi_class->recv_pool = hg_mem_pool_create(pool_chunk_size,
         NA_OFI_MEM_CHUNK_COUNT, NA_OFI_MEM_BLOCK_COUNT, na_ofi_mem_buf_register,
-        NA_RECV, na_ofi_mem_buf_deregister, (void *) na_ofi_class);
+        NA_RECV | pool_flags, na_ofi_mem_buf_deregister, (void *) na_ofi_class);
     NA_CHECK_SUBSYS_ERROR(cls, na_ofi_class->recv_pool == NULL, error, ret,
         NA_NOMEM,
         "Could not create memory pool with %d blocks of size %d x %zu bytes",
@@ -6071,6 +6511,7 @@ na_ofi_context_create(na_class_t *na_class, void **context_p, uint8_t id)
     NA_CHECK_SUBSYS_ERROR(ctx, na_ofi_context == NULL, error, ret, NA_NOMEM,
         "Could not allocate na_ofi_context");
     na_ofi_context->idx = id;
+    hg_atomic_init32(&na_ofi_context->multi_starved_count, 0);
 
     /* If not using SEP, just point to class' endpoint */
     if (!na_ofi_with_sep(na_ofi_class)) {
@@ -6123,12 +6564,6 @@ na_ofi_context_create(na_class_t *na_class, void **context_p, uint8_t id)
             "fi_enable() noc_rx failed, rc: %d (%s)", rc, fi_strerror(-rc));
     }
 
-    /* Create queue for tracking multi-event ops */
-    rc = hg_thread_spin_init(&na_ofi_context->multi_op_queue.lock);
-    NA_CHECK_SUBSYS_ERROR_NORET(
-        ctx, rc != HG_UTIL_SUCCESS, error, "hg_thread_spin_init() failed");
-    HG_QUEUE_INIT(&na_ofi_context->multi_op_queue.queue);
-
     hg_atomic_incr32(&na_ofi_class->n_contexts);
 
     *context_p = (void *) na_ofi_context;
@@ -6192,7 +6627,6 @@ na_ofi_context_destroy(na_class_t *na_class, void *context)
         }
     }
 
-    (void) hg_thread_spin_destroy(&na_ofi_context->multi_op_queue.lock);
     free(na_ofi_context);
     hg_atomic_decr32(&na_ofi_class->n_contexts);
 
@@ -6215,8 +6649,7 @@ na_ofi_op_create(na_class_t *na_class, unsigned long flags)
         na_return_t ret;
 
         ret = na_ofi_completion_multi_init(
-            &na_ofi_op_id->completion_data_storage.multi,
-            NA_OFI_OP_MULTI_CQ_SIZE);
+            &na_ofi_op_id->completion_data_storage.multi);
         NA_CHECK_SUBSYS_NA_ERROR(
             op, error, ret, "Could not allocate multi-operation queue");
         na_ofi_op_id->multi_event = true;
@@ -6254,17 +6687,6 @@ na_ofi_op_destroy(na_class_t NA_UNUSED *na_class, na_op_id_t *op_id)
     struct na_ofi_op_id *na_ofi_op_id = (struct na_ofi_op_id *) op_id;
 
     if (na_ofi_op_id->multi_event) {
-        if (!(hg_atomic_get32(&na_ofi_op_id->status) & NA_OFI_OP_COMPLETED)) {
-            struct na_ofi_op_queue *multi_op_queue =
-                &NA_OFI_CONTEXT(na_ofi_op_id->context)->multi_op_queue;
-
-            hg_thread_spin_lock(&multi_op_queue->lock);
-            HG_QUEUE_REMOVE(
-                &multi_op_queue->queue, na_ofi_op_id, na_ofi_op_id, multi);
-            hg_atomic_decr32(
-                &NA_OFI_CONTEXT(na_ofi_op_id->context)->multi_op_count);
-            hg_thread_spin_unlock(&multi_op_queue->lock);
-        }
         na_ofi_completion_multi_destroy(
             &na_ofi_op_id->completion_data_storage.multi);
     } else {
@@ -6316,6 +6738,55 @@ error:
     return ret;
 }
 
+/*---------------------------------------------------------------------------*/
+static na_return_t
+na_ofi_addr_lookup_multi(na_class_t *na_class, const char *const *names,
+    size_t count, na_addr_t **addrs)
+{
+    struct na_ofi_class *na_ofi_class = NA_OFI_CLASS(na_class);
+    int addr_format = (int) na_ofi_class->fi_info->addr_format;
+    struct na_ofi_addr_key *addr_keys = NULL;
+    na_return_t ret;
+    size_t i;
+
+    addr_keys = (struct na_ofi_addr_key *) malloc(count * sizeof(*addr_keys));
+    NA_CHECK_SUBSYS_ERROR(addr, addr_keys == NULL, error, ret, NA_NOMEM,
+        "Could not allocate array of addr keys");
+
+    for (i = 0; i < count; i++) {
+        /* Check provider from name */
+        NA_CHECK_SUBSYS_ERROR(fatal,
+            na_ofi_addr_prov(names[i]) != na_ofi_class->fabric->prov_type,
+            error, ret, NA_INVALID_ARG,
+            "Unrecognized provider type found from: %s", names[i]);
+
+        /* Convert name to raw address */
+        ret = na_ofi_str_to_raw_addr(names[i], addr_format, &addr_keys[i].addr);
+        NA_CHECK_SUBSYS_NA_ERROR(
+            addr, error, ret, "Could not convert string to address");
+
+        /* Create key from addr for faster lookups */
+        addr_keys[i].val =
+            na_ofi_raw_addr_to_key(addr_format, &addr_keys[i].addr);
+        NA_CHECK_SUBSYS_ERROR(addr, addr_keys[i].val == 0, error, ret,
+            NA_PROTONOSUPPORT, "Could not generate key from addr");
+    }
+
+    /* Lookup keys and create new addrs if they do not exist */
+    ret = na_ofi_addr_key_lookup_multi(na_ofi_class, addr_keys, count, addrs);
+    NA_CHECK_SUBSYS_NA_ERROR(
+        addr, error, ret, "Could not lookup %zu address keys", count);
+
+    free(addr_keys);
+
+    return NA_SUCCESS;
+
+error:
+    free(addr_keys);
+
+    return ret;
+}
+
 /*---------------------------------------------------------------------------*/
 static NA_INLINE void
 na_ofi_addr_free(na_class_t NA_UNUSED *na_class, na_addr_t *addr)
@@ -6479,6 +6950,63 @@ error:
     return ret;
 }
 
+/*---------------------------------------------------------------------------*/
+static na_return_t
+na_ofi_addr_deserialize_multi(na_class_t *na_class, na_addr_t **addrs,
+    size_t count, const void *buf, size_t stride)
+{
+    struct na_ofi_class *na_ofi_class = NA_OFI_CLASS(na_class);
+    int addr_format = (int) na_ofi_class->fi_info->addr_format;
+    struct na_ofi_addr_key *addr_keys = NULL;
+    na_return_t ret;
+    size_t i;
+
+    addr_keys = (struct na_ofi_addr_key *) malloc(count * sizeof(*addr_keys));
+    NA_CHECK_SUBSYS_ERROR(addr, addr_keys == NULL, error, ret, NA_NOMEM,
+        "Could not allocate array of addr keys");
+
+    for (i = 0; i < count; i++) {
+        const char *buf_ptr = (const char *) buf + i * stride;
+        size_t buf_size_left = stride;
+#ifndef NA_OFI_ADDR_OPT
+        uint64_t len;
+
+        NA_DECODE(error, ret, buf_ptr, buf_size_left, &len, uint64_t);
+        NA_CHECK_SUBSYS_ERROR(addr,
+            len != (uint64_t) na_ofi_raw_addr_serialize_size(addr_format),
+            error, ret, NA_PROTOCOL_ERROR,
+            "Address size mismatch (got %" PRIu64 ", expected %zu)", len,
+            na_ofi_raw_addr_serialize_size(addr_format));
+#endif
+
+        /* Deserialize raw address */
+        ret = na_ofi_raw_addr_deserialize(
+            addr_format, &addr_keys[i].addr, buf_ptr, buf_size_left);
+        NA_CHECK_SUBSYS_NA_ERROR(
+            addr, error, ret, "Could not deserialize address key");
+
+        /* Create key from addr for faster lookups */
+        addr_keys[i].val =
+            na_ofi_raw_addr_to_key(addr_format, &addr_keys[i].addr);
+        NA_CHECK_SUBSYS_ERROR(addr, addr_keys[i].val == 0, error, ret,
+            NA_PROTONOSUPPORT, "Could not generate key from addr");
+    }
+
+    /* Lookup keys and insert new addrs into AV at once */
+    ret = na_ofi_addr_key_lookup_multi(na_ofi_class, addr_keys, count, addrs);
+    NA_CHECK_SUBSYS_NA_ERROR(
+        addr, error, ret, "Could not lookup %zu address keys", count);
+
+    free(addr_keys);
+
+    return NA_SUCCESS;
+
+error:
+    free(addr_keys);
+
+    return ret;
+}
+
 /*---------------------------------------------------------------------------*/
 static NA_INLINE size_t
 na_ofi_msg_get_max_unexpected_size(const na_class_t *na_class)
@@ -6504,6 +7032,13 @@ na_ofi_msg_get_unexpected_header_size(const na_class_t *na_class)
     return 0;
 }
 
+/*---------------------------------------------------------------------------*/
+static NA_INLINE size_t
+na_ofi_msg_get_max_inject_size(const na_class_t *na_class)
+{
+    return NA_OFI_CLASS(na_class)->fi_info->tx_attr->inject_size;
+}
+
 /*---------------------------------------------------------------------------*/
 static NA_INLINE na_tag_t
 na_ofi_msg_get_max_tag(const na_class_t *na_class)
@@ -6730,13 +7265,6 @@ na_ofi_msg_multi_recv_unexpected(na_class_t NA_UNUSED *na_class,
         callback, arg, NULL);
     na_ofi_op_id->completion_data_storage.multi.completion_count = 0;
 
-    /* Add operation ID to context multi-op queue for tracking */
-    hg_thread_spin_lock(&na_ofi_context->multi_op_queue.lock);
-    HG_QUEUE_PUSH_TAIL(
-        &na_ofi_context->multi_op_queue.queue, na_ofi_op_id, multi);
-    hg_atomic_incr32(&na_ofi_context->multi_op_count);
-    hg_thread_spin_unlock(&na_ofi_context->multi_op_queue.lock);
-
     /* We assume buf remains valid (safe because we pre-allocate buffers) */
     na_ofi_op_id->info.msg = (struct na_ofi_msg_info){.buf.ptr = buf,
         .buf_size = buf_size,
@@ -6758,11 +7286,6 @@ na_ofi_msg_multi_recv_unexpected(na_class_t NA_UNUSED *na_class,
     return NA_SUCCESS;
 
 release:
-    hg_thread_spin_lock(&na_ofi_context->multi_op_queue.lock);
-    HG_QUEUE_REMOVE(&na_ofi_context->multi_op_queue.queue, na_ofi_op_id,
-        na_ofi_op_id, multi);
-    hg_atomic_decr32(&na_ofi_context->multi_op_count);
-    hg_thread_spin_unlock(&na_ofi_context->multi_op_queue.lock);
     NA_OFI_OP_RELEASE(na_ofi_op_id);
 
 error:
@@ -6822,6 +7345,45 @@ error:
     return ret;
 }
 
+/*---------------------------------------------------------------------------*/
+static na_return_t
+na_ofi_msg_send_expected_inject(na_class_t *na_class, na_context_t *context,
+    const void *buf, size_t buf_size, void NA_UNUSED *plugin_data,
+    na_addr_t *dest_addr, uint8_t dest_id, na_tag_t tag)
+{
+    struct na_ofi_context *na_ofi_context = NA_OFI_CONTEXT(context);
+    struct na_ofi_addr *na_ofi_addr = (struct na_ofi_addr *) dest_addr;
+    fi_addr_t fi_addr =
+        fi_rx_addr(na_ofi_addr->fi_addr, dest_id, NA_OFI_SEP_RX_CTX_BITS);
+    na_return_t ret;
+    ssize_t rc;
+
+    NA_CHECK_SUBSYS_ERROR(msg,
+        buf_size > NA_OFI_CLASS(na_class)->fi_info->tx_attr->inject_size,
+        error, ret, NA_MSGSIZE, "Cannot inject message of size %zu", buf_size);
+
+    NA_LOG_SUBSYS_DEBUG(msg,
+        "Posting fi_tinject() (buf=%p, len=%zu, dest_addr=%" PRIu64
+        ", tag=%" PRIu64 ")",
+        buf, buf_size, fi_addr, (uint64_t) tag);
+
+    /* Buffer can be re-used as soon as the call returns and no completion is
+     * generated */
+    rc = fi_tinject(na_ofi_context->fi_tx, buf, buf_size, fi_addr, tag);
+    if (rc == 0)
+        return NA_SUCCESS;
+    else if (rc == -FI_EAGAIN)
+        return NA_AGAIN;
+    else
+        NA_GOTO_SUBSYS_ERROR(msg, error, ret, na_ofi_errno_to_na((int) -rc),
+            "fi_tinject() failed, rc: %zd (%s), buf=%p, len=%zu, "
+            "dest_addr=%" PRIu64 ", tag=%" PRIu64,
+            rc, fi_strerror((int) -rc), buf, buf_size, fi_addr, (uint64_t) tag);
+
+error:
+    return ret;
+}
+
 /*---------------------------------------------------------------------------*/
 static na_return_t
 na_ofi_msg_recv_expected(na_class_t NA_UNUSED *na_class, na_context_t *context,
@@ -7321,6 +7883,11 @@ na_ofi_progress(
         size_t i, actual_count = 0;
         bool err_avail = false;
 
+        /* If a multi-event op has no entry left to hold CQ data, do not
+         * attempt to read from CQ until NA_Trigger() has released one */
+        if (hg_atomic_get32(&na_ofi_context->multi_starved_count) > 0)
+            return NA_SUCCESS;
+
         if (timeout_ms != 0 && na_ofi_context->eq->fi_wait != NULL) {
             /* Wait in wait set if provider does not support wait on FDs */
             int rc = fi_wait(na_ofi_context->eq->fi_wait,
@@ -7339,24 +7906,6 @@ na_ofi_progress(
                 fi_strerror(-rc));
         }
 
-        /* If we can't hold more than NA_OFI_CQ_EVENT_NUM entries do not attempt
-         * to read from CQ until NA_Trigger() has been called */
-        if (hg_atomic_get32(&na_ofi_context->multi_op_count) > 0) {
-            struct na_ofi_op_id *na_ofi_op_id;
-
-            hg_thread_spin_lock(&na_ofi_context->multi_op_queue.lock);
-            HG_QUEUE_FOREACH (
-                na_ofi_op_id, &na_ofi_context->multi_op_queue.queue, multi) {
-                unsigned int count = na_ofi_completion_multi_count(
-                    &na_ofi_op_id->completion_data_storage.multi);
-                if ((NA_OFI_OP_MULTI_CQ_SIZE - count) < NA_OFI_CQ_EVENT_NUM) {
-                    hg_thread_spin_unlock(&na_ofi_context->multi_op_queue.lock);
-                    return NA_SUCCESS;
-                }
-            }
-            hg_thread_spin_unlock(&na_ofi_context->multi_op_queue.lock);
-        }
-
         /* Read from CQ and process events */
         ret = na_ofi_cq_read(na_ofi_context->eq->fi_cq, cq_events,
             NA_OFI_CQ_EVENT_NUM, src_addrs, &actual_count, &err_avail);
@@ -162,6 +162,9 @@ extern NA_PRIVATE const struct na_class_ops NA_PLUGIN_OPS(psm);
 #ifdef NA_HAS_PSM2
 extern NA_PRIVATE const struct na_class_ops NA_PLUGIN_OPS(psm2);
 #endif
+#ifdef NA_HAS_TCP
+extern NA_PRIVATE const struct na_class_ops NA_PLUGIN_OPS(tcp);
+#endif
 
 #ifdef __cplusplus
 }
@@ -2625,6 +2625,7 @@ const struct na_class_ops NA_PSM_PLUGIN_VARIABLE = {
     na_psm_op_create,                      /* op_create */
     na_psm_op_destroy,                     /* op_destroy */
     na_psm_addr_lookup,                    /* addr_lookup */
+    NULL,                                  /* addr_lookup_multi */
     na_psm_addr_free,                      /* addr_free */
     NULL,                                  /* addr_set_remove */
     na_psm_addr_self,                      /* addr_self */
@@ -2635,10 +2636,12 @@ const struct na_class_ops NA_PSM_PLUGIN_VARIABLE = {
     na_psm_addr_get_serialize_size,        /* addr_get_serialize_size */
     na_psm_addr_serialize,                 /* addr_serialize */
     na_psm_addr_deserialize,               /* addr_deserialize */
+    NULL,                                  /* addr_deserialize_multi */
     na_psm_msg_get_max_unexpected_size,    /* msg_get_max_unexpected_size */
     na_psm_msg_get_max_expected_size,      /* msg_get_max_expected_size */
     na_psm_msg_get_unexpected_header_size, /* msg_get_unexpected_header_size */
     NULL,                                  /* msg_get_expected_header_size */
+    NULL,                                  /* msg_get_max_inject_size */
     na_psm_msg_get_max_tag,                /* msg_get_max_tag */
     NULL,                                  /* msg_buf_alloc */
     NULL,                                  /* msg_buf_free */
@@ -2648,6 +2651,7 @@ const struct na_class_ops NA_PSM_PLUGIN_VARIABLE = {
     NULL,                                  /* msg_multi_recv_unexpected */
     NULL,                                  /* msg_init_expected */
     na_psm_msg_send_expected,              /* msg_send_expected */
+    NULL,                                  /* msg_send_expected_inject */
     na_psm_msg_recv_expected,              /* msg_recv_expected */
     na_psm_mem_handle_create,              /* mem_handle_create */
     NULL,                                  /* mem_handle_create_segment */
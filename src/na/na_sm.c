@@ -13,7 +13,7 @@
 
 #include "mercury_atomic_queue.h"
 #include "mercury_event.h"
-#include "mercury_hash_table.h"
+#include "mercury_hash_map.h"
 #include "mercury_list.h"
 #include "mercury_mem.h"
 #include "mercury_poll.h"
@@ -86,11 +86,31 @@
 #define NA_SM_ADDR_RESERVED   (1 << 0)
 #define NA_SM_ADDR_CMD_PUSHED (1 << 1)
 #define NA_SM_ADDR_RESOLVED   (1 << 2)
+#define NA_SM_ADDR_CONNECTING (1 << 3)
 
 /* Msg sizes */
 #define NA_SM_UNEXPECTED_SIZE NA_SM_COPY_BUF_SIZE
 #define NA_SM_EXPECTED_SIZE   NA_SM_UNEXPECTED_SIZE
 
+/* Messages that exceed a copy buffer are pulled by the receiver */
+#if defined(NA_SM_HAS_CMA) || defined(__APPLE__)
+#    define NA_SM_HAS_RDV
+#endif
+
+/* Msg type flag (data is pulled from sender) */
+#define NA_SM_MSG_RDV (1 << 7)
+
+/* Rendezvous status values */
+#define NA_SM_RDV_PENDING   0
+#define NA_SM_RDV_COMPLETED 1
+#define NA_SM_RDV_ERRORED   2
+#define NA_SM_RDV_PULLING   3 /* Receiver is pulling data */
+#define NA_SM_RDV_CANCELED  4 /* Sender canceled, receiver releases buffer */
+
+/* Rendezvous info stored in copy buffer */
+#define NA_SM_RDV_INFO(region, index)                                          \
+    ((struct na_sm_rdv_info *) (region)->copy_bufs.buf[index])
+
 /* Max tag */
 #define NA_SM_MAX_TAG NA_TAG_MAX
 
@@ -106,6 +126,7 @@
 #define NA_SM_OP_CANCELED  (1 << 2)
 #define NA_SM_OP_QUEUED    (1 << 3)
 #define NA_SM_OP_ERRORED   (1 << 4)
+#define NA_SM_OP_RDV       (1 << 5) /* Waiting for receiver to pull data */
 
 /* Private data access */
 #define NA_SM_CLASS(na_class) ((struct na_sm_class *) (na_class->plugin_class))
@@ -186,6 +207,13 @@ NA_PACKED(union na_sm_msg_hdr {
     uint64_t val;
 });
 
+/* Rendezvous info (sent in place of data, receiver sets status once pulled) */
+struct na_sm_rdv_info {
+    hg_atomic_int32_t status; /* Rendezvous status */
+    uint64_t addr;            /* Address of data in sender */
+    uint64_t size;            /* Size of data */
+};
+
 /* Make sure this is cache-line aligned */
 union na_sm_cacheline_atomic_int64 {
     hg_atomic_int64_t val;
@@ -275,27 +303,31 @@ struct na_sm_region {
 enum na_sm_poll_type {
     NA_SM_POLL_SOCK = 1,
     NA_SM_POLL_RX_NOTIFY,
-    NA_SM_POLL_TX_NOTIFY
+    NA_SM_POLL_TX_NOTIFY,
+    NA_SM_POLL_CONNECT
 };
 
 /* Address */
 struct na_sm_addr {
-    hg_thread_mutex_t resolve_lock;     /* Lock to resolve address */
-    HG_LIST_ENTRY(na_sm_addr) entry;    /* Entry in poll list */
-    struct na_sm_addr_key addr_key;     /* Address key */
-    struct na_sm_endpoint *endpoint;    /* Endpoint */
-    struct na_sm_region *shared_region; /* Shared-memory region */
-    struct na_sm_msg_queue *tx_queue;   /* Pointer to shared tx queue */
-    struct na_sm_msg_queue *rx_queue;   /* Pointer to shared rx queue */
-    char *uri;                          /* Generated URI */
-    int tx_notify;                      /* Notify fd for tx queue */
-    int rx_notify;                      /* Notify fd for rx queue */
-    enum na_sm_poll_type tx_poll_type;  /* Tx poll type */
-    enum na_sm_poll_type rx_poll_type;  /* Rx poll type */
-    hg_atomic_int32_t refcount;         /* Ref count */
-    hg_atomic_int32_t status;           /* Status bits */
-    uint8_t queue_pair_idx;             /* Shared queue pair index */
-    bool unexpected;                    /* Unexpected address */
+    hg_thread_mutex_t resolve_lock;          /* Lock to resolve address */
+    HG_LIST_ENTRY(na_sm_addr) entry;         /* Entry in poll list */
+    HG_LIST_ENTRY(na_sm_addr) connect_entry; /* Entry in connect list */
+    struct na_sm_addr_key addr_key;          /* Address key */
+    struct na_sm_endpoint *endpoint;         /* Endpoint */
+    struct na_sm_region *shared_region;      /* Shared-memory region */
+    struct na_sm_msg_queue *tx_queue;        /* Pointer to shared tx queue */
+    struct na_sm_msg_queue *rx_queue;        /* Pointer to shared rx queue */
+    char *uri;                               /* Generated URI */
+    int tx_notify;                           /* Notify fd for tx queue */
+    int rx_notify;                           /* Notify fd for rx queue */
+    int connect_sock;                        /* Sock connected to peer */
+    enum na_sm_poll_type tx_poll_type;       /* Tx poll type */
+    enum na_sm_poll_type rx_poll_type;       /* Rx poll type */
+    enum na_sm_poll_type connect_poll_type;  /* Connect sock poll type */
+    hg_atomic_int32_t refcount;              /* Ref count */
+    hg_atomic_int32_t status;                /* Status bits */
+    uint8_t queue_pair_idx;                  /* Shared queue pair index */
+    bool unexpected;                         /* Unexpected address */
 };
 
 /* Address list */
@@ -307,7 +339,7 @@ struct na_sm_addr_list {
 /* Map (used to cache addresses) */
 struct na_sm_map {
     hg_thread_rwlock_t lock;
-    hg_hash_table_t *map;
+    hg_hash_map_t *map;
 };
 
 /* Memory descriptor info */
@@ -337,6 +369,7 @@ struct na_sm_msg_info {
     } buf;
     size_t buf_size;
     na_tag_t tag;
+    unsigned int rdv_buf_idx; /* Copy buffer holding rendezvous info */
 };
 
 /* Unexpected msg info */
@@ -386,7 +419,9 @@ struct na_sm_endpoint {
     struct na_sm_op_queue unexpected_op_queue; /* Unexpected op queue */
     struct na_sm_op_queue expected_op_queue;   /* Expected op queue */
     struct na_sm_op_queue retry_op_queue;      /* Retry op queue */
+    struct na_sm_op_queue rdv_op_queue;        /* Rendezvous op queue */
     struct na_sm_addr_list poll_addr_list;     /* List of addresses to poll */
+    struct na_sm_addr_list connect_addr_list;  /* Addresses being connected */
     struct na_sm_addr *source_addr;            /* Source addr */
     hg_poll_set_t *poll_set;                   /* Poll set */
     int sock;                                  /* Sock fd */
@@ -405,6 +440,8 @@ struct na_sm_context {
 struct na_sm_class {
     struct na_sm_endpoint endpoint; /* Endpoint */
     size_t iov_max;                 /* Max number of IOVs */
+    size_t max_unexpected_size;     /* Max unexpected size */
+    size_t max_expected_size;       /* Max expected size */
     uint8_t context_max;            /* Max number of contexts */
 };
 
@@ -492,16 +529,10 @@ na_sm_cmd_queue_pop(
     struct na_sm_cmd_queue *na_sm_queue, union na_sm_cmd_hdr *cmd_hdr);
 
 /**
- * Key hash for hash table.
+ * Pack addr key into a 64-bit map key (avoids comparing struct padding).
  */
-static NA_INLINE unsigned int
-na_sm_addr_key_hash(hg_hash_table_key_t key);
-
-/**
- * Compare key.
- */
-static NA_INLINE int
-na_sm_addr_key_equal(hg_hash_table_key_t key1, hg_hash_table_key_t key2);
+static NA_INLINE uint64_t
+na_sm_addr_key_pack(const struct na_sm_addr_key *addr_key);
 
 /**
  * Get SM address from string.
@@ -676,6 +707,33 @@ na_sm_addr_ref_decr(struct na_sm_addr *na_sm_addr);
 static na_return_t
 na_sm_addr_resolve(struct na_sm_addr *na_sm_addr);
 
+/**
+ * Start resolving address without waiting for the first message to be sent.
+ * Addresses that cannot be resolved immediately are added to the connect list
+ * and resolution is resumed from progress.
+ */
+static void
+na_sm_addr_connect(struct na_sm_addr *na_sm_addr);
+
+/**
+ * Resume resolution of address. If the peer's sock is full, a sock connected
+ * to the peer is polled so that progress wakes up once the peer drains it.
+ */
+static na_return_t
+na_sm_addr_connect_resume(struct na_sm_addr *na_sm_addr);
+
+/**
+ * Open sock connected to peer and register it for polling.
+ */
+static na_return_t
+na_sm_addr_connect_sock_open(struct na_sm_addr *na_sm_addr);
+
+/**
+ * Deregister and close sock connected to peer.
+ */
+static void
+na_sm_addr_connect_sock_close(struct na_sm_addr *na_sm_addr);
+
 /**
  * Release address.
  */
@@ -683,7 +741,7 @@ static na_return_t
 na_sm_addr_release(struct na_sm_addr *na_sm_addr);
 
 /**
- * Send events as ancillary data.
+ * Send events as ancillary data. dest_name is NULL if sock is connected.
  */
 static na_return_t
 na_sm_addr_event_send(int sock, const char *dest_name,
@@ -710,9 +768,55 @@ na_sm_msg_send(struct na_sm_class *na_sm_class, na_context_t *context,
  * Post msg.
  */
 static na_return_t
-na_sm_msg_send_post(struct na_sm_endpoint *na_sm_endpoint, na_cb_type_t cb_type,
-    const void *buf, size_t buf_size, struct na_sm_addr *na_sm_addr,
-    na_tag_t tag);
+na_sm_msg_send_post(struct na_sm_endpoint *na_sm_endpoint,
+    struct na_sm_addr *na_sm_addr, na_cb_type_t cb_type,
+    struct na_sm_msg_info *msg_info);
+
+/**
+ * Complete or queue msg that was posted.
+ */
+static NA_INLINE void
+na_sm_msg_send_posted(
+    struct na_sm_endpoint *na_sm_endpoint, struct na_sm_op_id *na_sm_op_id);
+
+/**
+ * Get size of data sent with msg.
+ */
+static NA_INLINE size_t
+na_sm_msg_data_size(struct na_sm_addr *poll_addr, union na_sm_msg_hdr msg_hdr);
+
+/**
+ * Claim data of rendezvous msg before processing it. Returns false if sender
+ * canceled msg, in which case msg must be dropped.
+ */
+static NA_INLINE bool
+na_sm_msg_data_claim(struct na_sm_addr *poll_addr, union na_sm_msg_hdr msg_hdr);
+
+/**
+ * Copy data sent with msg or pull it from sender.
+ */
+static na_return_t
+na_sm_msg_data_recv(struct na_sm_addr *poll_addr, union na_sm_msg_hdr msg_hdr,
+    void *buf, size_t buf_size);
+
+/**
+ * Discard data sent with msg and let sender release its buffer.
+ */
+static void
+na_sm_msg_data_drop(struct na_sm_addr *poll_addr, union na_sm_msg_hdr msg_hdr);
+
+/**
+ * Set rendezvous status and wake up sender.
+ */
+static void
+na_sm_msg_rdv_done(struct na_sm_addr *poll_addr,
+    struct na_sm_rdv_info *rdv_info, int32_t status);
+
+/**
+ * Complete msgs whose data was pulled by receiver.
+ */
+static void
+na_sm_progress_rdv(struct na_sm_endpoint *na_sm_endpoint, bool *progressed);
 
 /**
  * Reserve shared buffer.
@@ -858,6 +962,13 @@ static na_return_t
 na_sm_process_expected(struct na_sm_op_queue *expected_op_queue,
     struct na_sm_addr *poll_addr, union na_sm_msg_hdr msg_hdr);
 
+/**
+ * Resume resolution of addresses on connect list.
+ */
+static void
+na_sm_progress_connects(
+    struct na_sm_endpoint *na_sm_endpoint, bool *progressed);
+
 /**
  * Process retries.
  */
@@ -973,6 +1084,10 @@ na_sm_msg_get_max_unexpected_size(const na_class_t *na_class);
 static NA_INLINE size_t
 na_sm_msg_get_max_expected_size(const na_class_t *na_class);
 
+/* msg_get_max_inject_size */
+static NA_INLINE size_t
+na_sm_msg_get_max_inject_size(const na_class_t *na_class);
+
 /* msg_get_max_tag */
 static NA_INLINE na_tag_t
 na_sm_msg_get_max_tag(const na_class_t *na_class);
@@ -997,6 +1112,12 @@ na_sm_msg_send_expected(na_class_t *na_class, na_context_t *context,
     void *plugin_data, na_addr_t *dest_addr, uint8_t dest_id, na_tag_t tag,
     na_op_id_t *op_id);
 
+/* msg_send_expected_inject */
+static na_return_t
+na_sm_msg_send_expected_inject(na_class_t *na_class, na_context_t *context,
+    const void *buf, size_t buf_size, void *plugin_data, na_addr_t *dest_addr,
+    uint8_t dest_id, na_tag_t tag);
+
 /* msg_recv_expected */
 static na_return_t
 na_sm_msg_recv_expected(na_class_t *na_class, na_context_t *context,
@@ -1088,6 +1209,7 @@ const struct na_class_ops NA_PLUGIN_OPS(sm) = {
     na_sm_op_create,                   /* op_create */
     na_sm_op_destroy,                  /* op_destroy */
     na_sm_addr_lookup,                 /* addr_lookup */
+    NULL,                              /* addr_lookup_multi */
     na_sm_addr_free,                   /* addr_free */
     NULL,                              /* addr_set_remove */
     na_sm_addr_self,                   /* addr_self */
@@ -1098,10 +1220,12 @@ const struct na_class_ops NA_PLUGIN_OPS(sm) = {
     na_sm_addr_get_serialize_size,     /* addr_get_serialize_size */
     na_sm_addr_serialize,              /* addr_serialize */
     na_sm_addr_deserialize,            /* addr_deserialize */
+    NULL,                              /* addr_deserialize_multi */
     na_sm_msg_get_max_unexpected_size, /* msg_get_max_unexpected_size */
     na_sm_msg_get_max_expected_size,   /* msg_get_max_expected_size */
     NULL,                              /* msg_get_unexpected_header_size */
     NULL,                              /* msg_get_expected_header_size */
+    na_sm_msg_get_max_inject_size,     /* msg_get_max_inject_size */
     na_sm_msg_get_max_tag,             /* msg_get_max_tag */
     NULL,                              /* msg_buf_alloc */
     NULL,                              /* msg_buf_free */
@@ -1111,6 +1235,7 @@ const struct na_class_ops NA_PLUGIN_OPS(sm) = {
     NULL,                              /* msg_multi_recv_unexpected */
     NULL,                              /* msg_init_expected */
     na_sm_msg_send_expected,           /* msg_send_expected */
+    na_sm_msg_send_expected_inject,    /* msg_send_expected_inject */
     na_sm_msg_recv_expected,           /* msg_recv_expected */
     na_sm_mem_handle_create,           /* mem_handle_create */
 #ifdef NA_SM_HAS_CMA
@@ -1568,21 +1693,10 @@ na_sm_cmd_queue_pop(
 }
 
 /*---------------------------------------------------------------------------*/
-static NA_INLINE unsigned int
-na_sm_addr_key_hash(hg_hash_table_key_t key)
+static NA_INLINE uint64_t
+na_sm_addr_key_pack(const struct na_sm_addr_key *addr_key)
 {
-    /* Hashing through PIDs should be sufficient in practice */
-    return (unsigned int) ((struct na_sm_addr_key *) key)->pid;
-}
-
-/*---------------------------------------------------------------------------*/
-static NA_INLINE int
-na_sm_addr_key_equal(hg_hash_table_key_t key1, hg_hash_table_key_t key2)
-{
-    struct na_sm_addr_key *addr_key1 = (struct na_sm_addr_key *) key1,
-                          *addr_key2 = (struct na_sm_addr_key *) key2;
-
-    return (addr_key1->pid == addr_key2->pid && addr_key1->id == addr_key2->id);
+    return ((uint64_t) (uint32_t) addr_key->pid << 8) | addr_key->id;
 }
 
 /*---------------------------------------------------------------------------*/
@@ -2146,6 +2260,9 @@ na_sm_endpoint_open(struct na_sm_endpoint *na_sm_endpoint, const char *name,
     HG_QUEUE_INIT(&na_sm_endpoint->retry_op_queue.queue);
     hg_thread_spin_init(&na_sm_endpoint->retry_op_queue.lock);
 
+    HG_QUEUE_INIT(&na_sm_endpoint->rdv_op_queue.queue);
+    hg_thread_spin_init(&na_sm_endpoint->rdv_op_queue.lock);
+
     /* Initialize number of fds */
     hg_atomic_init32(&na_sm_endpoint->nofile, 0);
     na_sm_endpoint->nofile_max = nofile_max;
@@ -2154,11 +2271,14 @@ na_sm_endpoint_open(struct na_sm_endpoint *na_sm_endpoint, const char *name,
     HG_LIST_INIT(&na_sm_endpoint->poll_addr_list.list);
     hg_thread_spin_init(&na_sm_endpoint->poll_addr_list.lock);
 
+    /* Initialize connect addr list */
+    HG_LIST_INIT(&na_sm_endpoint->connect_addr_list.list);
+    hg_thread_spin_init(&na_sm_endpoint->connect_addr_list.lock);
+
     /* Create addr hash-table */
-    na_sm_endpoint->addr_map.map =
-        hg_hash_table_new(na_sm_addr_key_hash, na_sm_addr_key_equal);
+    na_sm_endpoint->addr_map.map = hg_hash_map_new(sizeof(uint64_t));
     NA_CHECK_SUBSYS_ERROR(cls, na_sm_endpoint->addr_map.map == NULL, error, ret,
-        NA_NOMEM, "hg_hash_table_new() failed");
+        NA_NOMEM, "hg_hash_map_new() failed");
     hg_thread_rwlock_init(&na_sm_endpoint->addr_map.lock);
 
     if (listen) {
@@ -2326,7 +2446,7 @@ error:
     if (shared_region)
         na_sm_region_close(uri_p, shared_region);
     if (na_sm_endpoint->addr_map.map) {
-        hg_hash_table_free(na_sm_endpoint->addr_map.map);
+        hg_hash_map_free(na_sm_endpoint->addr_map.map);
         hg_thread_rwlock_destroy(&na_sm_endpoint->addr_map.lock);
     }
 
@@ -2347,6 +2467,17 @@ na_sm_endpoint_close(struct na_sm_endpoint *na_sm_endpoint)
     na_return_t ret = NA_SUCCESS;
     bool empty;
 
+    /* Give up on addresses that are still being connected */
+    while (!HG_LIST_IS_EMPTY(&na_sm_endpoint->connect_addr_list.list)) {
+        struct na_sm_addr *na_sm_addr =
+            HG_LIST_FIRST(&na_sm_endpoint->connect_addr_list.list);
+
+        HG_LIST_REMOVE(na_sm_addr, connect_entry);
+        na_sm_addr_connect_sock_close(na_sm_addr);
+        hg_atomic_and32(&na_sm_addr->status, ~NA_SM_ADDR_CONNECTING);
+        na_sm_addr_ref_decr(na_sm_addr);
+    }
+
     /* Check that poll addr list is empty */
     empty = HG_LIST_IS_EMPTY(&na_sm_endpoint->poll_addr_list.list);
     if (!empty) {
@@ -2389,6 +2520,11 @@ na_sm_endpoint_close(struct na_sm_endpoint *na_sm_endpoint)
     NA_CHECK_SUBSYS_ERROR(cls, empty == false, done, ret, NA_BUSY,
         "Retry op queue should be empty");
 
+    /* Check that rendezvous op queue is empty */
+    empty = HG_QUEUE_IS_EMPTY(&na_sm_endpoint->rdv_op_queue.queue);
+    NA_CHECK_SUBSYS_ERROR(cls, empty == false, done, ret, NA_BUSY,
+        "Rendezvous op queue should be empty");
+
     if (source_addr) {
         if (source_addr->shared_region) {
             na_sm_queue_pair_release(
@@ -2455,7 +2591,7 @@ na_sm_endpoint_close(struct na_sm_endpoint *na_sm_endpoint)
 
     /* Free hash table */
     if (na_sm_endpoint->addr_map.map) {
-        hg_hash_table_free(na_sm_endpoint->addr_map.map);
+        hg_hash_map_free(na_sm_endpoint->addr_map.map);
         hg_thread_rwlock_destroy(&na_sm_endpoint->addr_map.lock);
     }
 
@@ -2470,7 +2606,9 @@ na_sm_endpoint_close(struct na_sm_endpoint *na_sm_endpoint)
     hg_thread_spin_destroy(&na_sm_endpoint->unexpected_op_queue.lock);
     hg_thread_spin_destroy(&na_sm_endpoint->expected_op_queue.lock);
     hg_thread_spin_destroy(&na_sm_endpoint->retry_op_queue.lock);
+    hg_thread_spin_destroy(&na_sm_endpoint->rdv_op_queue.lock);
     hg_thread_spin_destroy(&na_sm_endpoint->poll_addr_list.lock);
+    hg_thread_spin_destroy(&na_sm_endpoint->connect_addr_list.lock);
 
 done:
     return ret;
@@ -2537,15 +2675,15 @@ static NA_INLINE struct na_sm_addr *
 na_sm_addr_map_lookup(
     struct na_sm_map *na_sm_map, struct na_sm_addr_key *addr_key)
 {
-    hg_hash_table_value_t value = NULL;
+    uint64_t key = na_sm_addr_key_pack(addr_key);
+    struct na_sm_addr *na_sm_addr;
 
     /* Lookup key */
     hg_thread_rwlock_rdlock(&na_sm_map->lock);
-    value =
-        hg_hash_table_lookup(na_sm_map->map, (hg_hash_table_key_t) addr_key);
+    na_sm_addr = (struct na_sm_addr *) hg_hash_map_lookup(na_sm_map->map, &key);
     hg_thread_rwlock_release_rdlock(&na_sm_map->lock);
 
-    return (value == HG_HASH_TABLE_NULL) ? NULL : (struct na_sm_addr *) value;
+    return na_sm_addr;
 }
 
 /*---------------------------------------------------------------------------*/
@@ -2554,6 +2692,7 @@ na_sm_addr_map_insert(struct na_sm_endpoint *na_sm_endpoint,
     struct na_sm_map *na_sm_map, const char *uri,
     struct na_sm_addr_key *addr_key, struct na_sm_addr **na_sm_addr_p)
 {
+    uint64_t key = na_sm_addr_key_pack(addr_key);
     struct na_sm_addr *na_sm_addr = NULL;
     na_return_t ret = NA_SUCCESS;
     int rc;
@@ -2561,8 +2700,7 @@ na_sm_addr_map_insert(struct na_sm_endpoint *na_sm_endpoint,
     hg_thread_rwlock_wrlock(&na_sm_map->lock);
 
     /* Look up again to prevent race between lock release/acquire */
-    na_sm_addr = (struct na_sm_addr *) hg_hash_table_lookup(
-        na_sm_map->map, (hg_hash_table_key_t) addr_key);
+    na_sm_addr = (struct na_sm_addr *) hg_hash_map_lookup(na_sm_map->map, &key);
     if (na_sm_addr) {
         ret = NA_EXIST; /* Entry already exists */
         goto done;
@@ -2573,11 +2711,9 @@ na_sm_addr_map_insert(struct na_sm_endpoint *na_sm_endpoint,
     NA_CHECK_SUBSYS_NA_ERROR(addr, error, ret, "Could not allocate address");
 
     /* Insert new value */
-    rc = hg_hash_table_insert(na_sm_map->map,
-        (hg_hash_table_key_t) &na_sm_addr->addr_key,
-        (hg_hash_table_value_t) na_sm_addr);
+    rc = hg_hash_map_insert(na_sm_map->map, &key, na_sm_addr);
     NA_CHECK_SUBSYS_ERROR(
-        addr, rc == 0, error, ret, NA_NOMEM, "hg_hash_table_insert() failed");
+        addr, rc == 0, error, ret, NA_NOMEM, "hg_hash_map_insert() failed");
 
 done:
     hg_thread_rwlock_release_wrlock(&na_sm_map->lock);
@@ -2599,21 +2735,14 @@ static na_return_t
 na_sm_addr_map_remove(
     struct na_sm_map *na_sm_map, struct na_sm_addr_key *addr_key)
 {
-    na_return_t ret = NA_SUCCESS;
-    int rc;
+    uint64_t key = na_sm_addr_key_pack(addr_key);
 
+    /* Key may have already been removed */
     hg_thread_rwlock_wrlock(&na_sm_map->lock);
-    if (hg_hash_table_lookup(na_sm_map->map, (hg_hash_table_key_t) addr_key) ==
-        HG_HASH_TABLE_NULL)
-        goto unlock;
-
-    rc = hg_hash_table_remove(na_sm_map->map, (hg_hash_table_key_t) addr_key);
-    NA_CHECK_SUBSYS_ERROR_DONE(addr, rc == 0, "Could not remove key");
-
-unlock:
+    (void) hg_hash_map_remove(na_sm_map->map, &key);
     hg_thread_rwlock_release_wrlock(&na_sm_map->lock);
 
-    return ret;
+    return NA_SUCCESS;
 }
 
 /*---------------------------------------------------------------------------*/
@@ -2649,6 +2778,7 @@ na_sm_addr_create(struct na_sm_endpoint *na_sm_endpoint, const char *uri,
     /* Default values */
     na_sm_addr->tx_notify = -1;
     na_sm_addr->rx_notify = -1;
+    na_sm_addr->connect_sock = -1;
 
     *addr_p = na_sm_addr;
 
@@ -2800,9 +2930,14 @@ na_sm_addr_resolve(struct na_sm_addr *na_sm_addr)
                 addr, error, ret, "Could not add rx notify to poll set");
         }
 
-        /* Send events to remote process */
-        ret = na_sm_addr_event_send(na_sm_endpoint->sock, na_sm_addr->uri,
-            cmd_hdr, na_sm_addr->tx_notify, na_sm_addr->rx_notify, false);
+        /* Send events to remote process, retries go through the connected
+         * sock so that a full peer sock can be waited on */
+        if (na_sm_addr->connect_sock < 0)
+            ret = na_sm_addr_event_send(na_sm_endpoint->sock, na_sm_addr->uri,
+                cmd_hdr, na_sm_addr->tx_notify, na_sm_addr->rx_notify, false);
+        else
+            ret = na_sm_addr_event_send(na_sm_addr->connect_sock, NULL,
+                cmd_hdr, na_sm_addr->tx_notify, na_sm_addr->rx_notify, false);
         if (unlikely(ret == NA_AGAIN))
             return ret;
         else
@@ -2858,6 +2993,134 @@ error:
     return ret;
 }
 
+/*---------------------------------------------------------------------------*/
+static void
+na_sm_addr_connect(struct na_sm_addr *na_sm_addr)
+{
+    struct na_sm_addr_list *connect_addr_list =
+        &na_sm_addr->endpoint->connect_addr_list;
+    na_return_t ret;
+
+    ret = na_sm_addr_connect_resume(na_sm_addr);
+    if (ret == NA_AGAIN &&
+        !(hg_atomic_or32(&na_sm_addr->status, NA_SM_ADDR_CONNECTING) &
+            NA_SM_ADDR_CONNECTING)) {
+        /* Keep a reference while address is on connect list */
+        na_sm_addr_ref_incr(na_sm_addr);
+
+        hg_thread_spin_lock(&connect_addr_list->lock);
+        HG_LIST_INSERT_HEAD(
+            &connect_addr_list->list, na_sm_addr, connect_entry);
+        hg_thread_spin_unlock(&connect_addr_list->lock);
+    }
+
+    /* Errors are reported when the first message is sent */
+    if (ret != NA_SUCCESS && ret != NA_AGAIN)
+        NA_LOG_SUBSYS_DEBUG(addr,
+            "Could not connect to PID=%d, ID=%" PRIu8 " (%s)",
+            na_sm_addr->addr_key.pid, na_sm_addr->addr_key.id,
+            NA_Error_to_string(ret));
+}
+
+/*---------------------------------------------------------------------------*/
+static na_return_t
+na_sm_addr_connect_resume(struct na_sm_addr *na_sm_addr)
+{
+    na_return_t ret;
+
+    hg_thread_mutex_lock(&na_sm_addr->resolve_lock);
+    ret = na_sm_addr_resolve(na_sm_addr);
+    if (ret == NA_AGAIN) {
+        /* Only a full peer sock can be waited on, a full cmd queue is retried
+         * on the next progress call */
+        if (na_sm_addr->endpoint->poll_set && na_sm_addr->connect_sock < 0 &&
+            (hg_atomic_get32(&na_sm_addr->status) & NA_SM_ADDR_CMD_PUSHED)) {
+            na_return_t err_ret = na_sm_addr_connect_sock_open(na_sm_addr);
+            if (err_ret != NA_SUCCESS)
+                ret = err_ret;
+        }
+    } else
+        na_sm_addr_connect_sock_close(na_sm_addr);
+    hg_thread_mutex_unlock(&na_sm_addr->resolve_lock);
+
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static na_return_t
+na_sm_addr_connect_sock_open(struct na_sm_addr *na_sm_addr)
+{
+    struct na_sm_endpoint *na_sm_endpoint = na_sm_addr->endpoint;
+    struct hg_poll_event event = {
+        .events = HG_POLLOUT, .data.ptr = &na_sm_addr->connect_poll_type};
+    struct sockaddr_un addr;
+    int sock = -1, rc;
+    na_return_t ret;
+
+    ret = na_sm_sock_open(NULL, false, &sock);
+    NA_CHECK_SUBSYS_NA_ERROR(addr, error, ret, "Could not open sock");
+
+    /* Generate named socket path */
+    memset(&addr, 0, sizeof(struct sockaddr_un));
+    addr.sun_family = AF_UNIX;
+    rc = NA_SM_PRINT_SOCK_PATH(
+        addr.sun_path, NA_SM_MAX_FILENAME, na_sm_addr->uri);
+    NA_CHECK_SUBSYS_ERROR(addr, rc < 0 || rc > NA_SM_MAX_FILENAME, error, ret,
+        NA_OVERFLOW, "NA_SM_PRINT_SOCK_PATH() failed, rc: %d", rc);
+    strcat(addr.sun_path, NA_SM_SOCK_NAME);
+
+    /* A connected datagram sock is only writable once the peer's sock has
+     * room again */
+    rc = connect(
+        sock, (const struct sockaddr *) &addr, (socklen_t) SUN_LEN(&addr));
+    NA_CHECK_SUBSYS_ERROR(addr, rc == -1, error, ret, na_sm_errno_to_na(errno),
+        "connect() failed (%s)", strerror(errno));
+
+    na_sm_addr->connect_poll_type = NA_SM_POLL_CONNECT;
+    NA_LOG_SUBSYS_DEBUG(addr, "Registering connect sock %d for polling", sock);
+
+    rc = hg_poll_add(na_sm_endpoint->poll_set, sock, &event);
+    NA_CHECK_SUBSYS_ERROR(addr, rc != HG_UTIL_SUCCESS, error, ret,
+        na_sm_errno_to_na(errno), "hg_poll_add() failed");
+
+    na_sm_addr->connect_sock = sock;
+    hg_atomic_incr32(&na_sm_endpoint->nofile);
+
+    return NA_SUCCESS;
+
+error:
+    if (sock != -1) {
+        rc = close(sock);
+        NA_CHECK_SUBSYS_ERROR_DONE(
+            addr, rc == -1, "close() failed (%s)", strerror(errno));
+    }
+
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static void
+na_sm_addr_connect_sock_close(struct na_sm_addr *na_sm_addr)
+{
+    struct na_sm_endpoint *na_sm_endpoint = na_sm_addr->endpoint;
+    na_return_t ret;
+
+    if (na_sm_addr->connect_sock < 0)
+        return;
+
+    ret = na_sm_poll_deregister(
+        na_sm_endpoint->poll_set, na_sm_addr->connect_sock);
+    NA_CHECK_SUBSYS_ERROR_DONE(
+        addr, ret != NA_SUCCESS, "Could not remove connect sock from poll set");
+
+    ret = na_sm_sock_close(NULL, na_sm_addr->connect_sock);
+    NA_CHECK_SUBSYS_ERROR_DONE(
+        addr, ret != NA_SUCCESS, "Could not close connect sock");
+
+    na_sm_addr->connect_sock = -1;
+    hg_atomic_decr32(&na_sm_endpoint->nofile);
+}
+
 /*---------------------------------------------------------------------------*/
 static na_return_t
 na_sm_addr_release(struct na_sm_addr *na_sm_addr)
@@ -2954,17 +3217,24 @@ na_sm_addr_event_send(int sock, const char *dest_name,
     na_return_t ret = NA_SUCCESS;
     int rc;
 
-    /* Generate named socket path */
-    memset(&addr, 0, sizeof(struct sockaddr_un));
-    addr.sun_family = AF_UNIX;
-    rc = NA_SM_PRINT_SOCK_PATH(addr.sun_path, NA_SM_MAX_FILENAME, dest_name);
-    NA_CHECK_SUBSYS_ERROR(addr, rc < 0 || rc > NA_SM_MAX_FILENAME, done, ret,
-        NA_OVERFLOW, "NA_SM_PRINT_SOCK_PATH() failed, rc: %d", rc);
-    strcat(addr.sun_path, NA_SM_SOCK_NAME);
+    if (dest_name) {
+        /* Generate named socket path */
+        memset(&addr, 0, sizeof(struct sockaddr_un));
+        addr.sun_family = AF_UNIX;
+        rc = NA_SM_PRINT_SOCK_PATH(
+            addr.sun_path, NA_SM_MAX_FILENAME, dest_name);
+        NA_CHECK_SUBSYS_ERROR(addr, rc < 0 || rc > NA_SM_MAX_FILENAME, done,
+            ret, NA_OVERFLOW, "NA_SM_PRINT_SOCK_PATH() failed, rc: %d", rc);
+        strcat(addr.sun_path, NA_SM_SOCK_NAME);
 
-    /* Set address of destination */
-    msg.msg_name = &addr;
-    msg.msg_namelen = (socklen_t) SUN_LEN(&addr);
+        /* Set address of destination */
+        msg.msg_name = &addr;
+        msg.msg_namelen = (socklen_t) SUN_LEN(&addr);
+    } else {
+        /* Sock is connected to destination */
+        msg.msg_name = NULL;
+        msg.msg_namelen = 0;
+    }
     msg.msg_flags = 0; /* unused */
 
     /* Send cmd */
@@ -2992,7 +3262,8 @@ na_sm_addr_event_send(int sock, const char *dest_name,
 
     nsend = sendmsg(sock, &msg, 0);
     if (!ignore_error) {
-        if (unlikely(nsend == -1 && errno == ETOOMANYREFS))
+        /* Peer has not drained its sock yet */
+        if (unlikely(nsend == -1 && (errno == EAGAIN || errno == ETOOMANYREFS)))
             ret = NA_AGAIN;
         else
             NA_CHECK_SUBSYS_ERROR(addr, nsend == -1, done, ret,
@@ -3074,10 +3345,13 @@ na_sm_msg_send(struct na_sm_class *na_sm_class, na_context_t *context,
     size_t buf_size, struct na_sm_addr *na_sm_addr, na_tag_t tag,
     struct na_sm_op_id *na_sm_op_id)
 {
+    size_t max_size = (cb_type == NA_CB_SEND_UNEXPECTED)
+                          ? na_sm_class->max_unexpected_size
+                          : na_sm_class->max_expected_size;
     na_return_t ret;
 
-    NA_CHECK_SUBSYS_ERROR(msg, buf_size > NA_SM_COPY_BUF_SIZE, error, ret,
-        NA_OVERFLOW, "Exceeds copy buf size, %zu", buf_size);
+    NA_CHECK_SUBSYS_ERROR(msg, buf_size > max_size, error, ret, NA_OVERFLOW,
+        "Exceeds max msg size, %zu", buf_size);
 
     /* Check op_id */
     NA_CHECK_SUBSYS_ERROR(op, na_sm_op_id == NULL, error, ret, NA_INVALID_ARG,
@@ -3094,11 +3368,10 @@ na_sm_msg_send(struct na_sm_class *na_sm_class, na_context_t *context,
     na_sm_op_id->info.msg = (struct na_sm_msg_info){
         .buf.const_ptr = buf, .buf_size = buf_size, .tag = tag};
 
-    ret = na_sm_msg_send_post(
-        &na_sm_class->endpoint, cb_type, buf, buf_size, na_sm_addr, tag);
+    ret = na_sm_msg_send_post(&na_sm_class->endpoint, na_sm_addr, cb_type,
+        &na_sm_op_id->info.msg);
     if (ret == NA_SUCCESS) {
-        /* Immediate completion, add directly to completion queue. */
-        na_sm_complete(na_sm_op_id, NA_SUCCESS);
+        na_sm_msg_send_posted(&na_sm_class->endpoint, na_sm_op_id);
 
         /* Notify local completion */
         na_sm_complete_signal(na_sm_class);
@@ -3119,17 +3392,19 @@ error:
 
 /*---------------------------------------------------------------------------*/
 static na_return_t
-na_sm_msg_send_post(struct na_sm_endpoint *na_sm_endpoint, na_cb_type_t cb_type,
-    const void *buf, size_t buf_size, struct na_sm_addr *na_sm_addr,
-    na_tag_t tag)
+na_sm_msg_send_post(struct na_sm_endpoint *na_sm_endpoint,
+    struct na_sm_addr *na_sm_addr, na_cb_type_t cb_type,
+    struct na_sm_msg_info *msg_info)
 {
+    bool rdv = (msg_info->buf_size > NA_SM_COPY_BUF_SIZE);
+    size_t buf_size = rdv ? sizeof(struct na_sm_rdv_info) : msg_info->buf_size;
     unsigned int buf_idx = 0;
     union na_sm_msg_hdr msg_hdr;
     na_return_t ret;
     bool rc;
 
     /* Attempt to resolve address first if not resolved */
-    if (hg_atomic_get32(&na_sm_addr->status) != NA_SM_ADDR_RESOLVED) {
+    if (!(hg_atomic_get32(&na_sm_addr->status) & NA_SM_ADDR_RESOLVED)) {
         hg_thread_mutex_lock(&na_sm_addr->resolve_lock);
         ret = na_sm_addr_resolve(na_sm_addr);
         hg_thread_mutex_unlock(&na_sm_addr->resolve_lock);
@@ -3148,16 +3423,28 @@ na_sm_msg_send_post(struct na_sm_endpoint *na_sm_endpoint, na_cb_type_t cb_type,
         if (unlikely(ret == NA_AGAIN))
             return NA_AGAIN;
 
-        /* Reservation succeeded, copy buffer */
-        na_sm_buf_copy_to(
-            &na_sm_addr->shared_region->copy_bufs, buf_idx, buf, buf_size);
+        if (rdv) {
+            struct na_sm_rdv_info *rdv_info =
+                NA_SM_RDV_INFO(na_sm_addr->shared_region, buf_idx);
+
+            /* Only pass location of data, receiver pulls it */
+            hg_atomic_set32(&rdv_info->status, NA_SM_RDV_PENDING);
+            rdv_info->addr = (uint64_t) (uintptr_t) msg_info->buf.const_ptr;
+            rdv_info->size = (uint64_t) msg_info->buf_size;
+            msg_info->rdv_buf_idx = buf_idx;
+        } else {
+            /* Reservation succeeded, copy buffer */
+            na_sm_buf_copy_to(&na_sm_addr->shared_region->copy_bufs, buf_idx,
+                msg_info->buf.const_ptr, buf_size);
+        }
     }
 
     /* Post message to queue */
-    msg_hdr = (union na_sm_msg_hdr){.hdr.type = cb_type,
+    msg_hdr = (union na_sm_msg_hdr){
+        .hdr.type = (cb_type | (rdv ? NA_SM_MSG_RDV : 0)) & 0xff,
         .hdr.buf_idx = buf_idx & 0xff,
         .hdr.buf_size = buf_size & 0xffff,
-        .hdr.tag = tag};
+        .hdr.tag = msg_info->tag};
 
     rc = na_sm_msg_queue_push(na_sm_addr->tx_queue, &msg_hdr);
     NA_CHECK_SUBSYS_ERROR(
@@ -3185,6 +3472,186 @@ error:
     return ret;
 }
 
+/*---------------------------------------------------------------------------*/
+static NA_INLINE void
+na_sm_msg_send_posted(
+    struct na_sm_endpoint *na_sm_endpoint, struct na_sm_op_id *na_sm_op_id)
+{
+    if (na_sm_op_id->info.msg.buf_size > NA_SM_COPY_BUF_SIZE) {
+        struct na_sm_op_queue *rdv_op_queue = &na_sm_endpoint->rdv_op_queue;
+
+        /* Buffer cannot be released until receiver has pulled data */
+        hg_thread_spin_lock(&rdv_op_queue->lock);
+        HG_QUEUE_PUSH_TAIL(&rdv_op_queue->queue, na_sm_op_id, entry);
+        hg_atomic_or32(&na_sm_op_id->status, NA_SM_OP_RDV);
+        hg_thread_spin_unlock(&rdv_op_queue->lock);
+    } else
+        /* Immediate completion, add directly to completion queue. */
+        na_sm_complete(na_sm_op_id, NA_SUCCESS);
+}
+
+/*---------------------------------------------------------------------------*/
+static NA_INLINE size_t
+na_sm_msg_data_size(struct na_sm_addr *poll_addr, union na_sm_msg_hdr msg_hdr)
+{
+    if (msg_hdr.hdr.type & NA_SM_MSG_RDV)
+        return (size_t) NA_SM_RDV_INFO(
+            poll_addr->shared_region, msg_hdr.hdr.buf_idx)
+            ->size;
+    else
+        return (size_t) msg_hdr.hdr.buf_size;
+}
+
+/*---------------------------------------------------------------------------*/
+static NA_INLINE bool
+na_sm_msg_data_claim(struct na_sm_addr *poll_addr, union na_sm_msg_hdr msg_hdr)
+{
+    if (!(msg_hdr.hdr.type & NA_SM_MSG_RDV))
+        return true;
+
+    if (hg_atomic_cas32(
+            &NA_SM_RDV_INFO(poll_addr->shared_region, msg_hdr.hdr.buf_idx)
+                 ->status,
+            NA_SM_RDV_PENDING, NA_SM_RDV_PULLING))
+        return true;
+
+    /* Sender canceled msg and no longer owns copy buffer */
+    na_sm_buf_release(
+        &poll_addr->shared_region->copy_bufs, msg_hdr.hdr.buf_idx);
+
+    return false;
+}
+
+/*---------------------------------------------------------------------------*/
+static na_return_t
+na_sm_msg_data_recv(struct na_sm_addr *poll_addr, union na_sm_msg_hdr msg_hdr,
+    void *buf, size_t buf_size)
+{
+    struct na_sm_rdv_info *rdv_info;
+    na_return_t ret = NA_SUCCESS;
+    size_t size;
+
+    if (!(msg_hdr.hdr.type & NA_SM_MSG_RDV)) {
+        if (msg_hdr.hdr.buf_size > 0) {
+            /* Copy buffer */
+            na_sm_buf_copy_from(&poll_addr->shared_region->copy_bufs,
+                msg_hdr.hdr.buf_idx, buf, msg_hdr.hdr.buf_size);
+
+            /* Release buffer */
+            na_sm_buf_release(
+                &poll_addr->shared_region->copy_bufs, msg_hdr.hdr.buf_idx);
+        }
+        return NA_SUCCESS;
+    }
+
+    /* Copy buffer is released by sender once status is set */
+    rdv_info = NA_SM_RDV_INFO(poll_addr->shared_region, msg_hdr.hdr.buf_idx);
+    size = (size_t) rdv_info->size;
+    NA_CHECK_SUBSYS_ERROR(msg, size > buf_size, done, ret, NA_MSGSIZE,
+        "Msg size (%zu) exceeds buffer size (%zu)", size, buf_size);
+
+#ifdef NA_SM_HAS_RDV
+    {
+        struct iovec local_iov = {.iov_base = buf, .iov_len = size};
+        struct iovec remote_iov = {
+            .iov_base = (void *) (uintptr_t) rdv_info->addr, .iov_len = size};
+
+        /* Pull data directly from sender */
+        ret = na_sm_process_vm_readv(
+            poll_addr->addr_key.pid, &local_iov, 1, &remote_iov, 1, size);
+        NA_CHECK_SUBSYS_NA_ERROR(msg, done, ret, "Could not pull msg data");
+    }
+#else
+    NA_GOTO_SUBSYS_ERROR(msg, done, ret, NA_OPNOTSUPPORTED,
+        "Pulling msg data is not supported");
+#endif
+
+done:
+    na_sm_msg_rdv_done(poll_addr, rdv_info,
+        (ret == NA_SUCCESS) ? NA_SM_RDV_COMPLETED : NA_SM_RDV_ERRORED);
+
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static void
+na_sm_msg_data_drop(struct na_sm_addr *poll_addr, union na_sm_msg_hdr msg_hdr)
+{
+    if (msg_hdr.hdr.type & NA_SM_MSG_RDV)
+        na_sm_msg_rdv_done(poll_addr,
+            NA_SM_RDV_INFO(poll_addr->shared_region, msg_hdr.hdr.buf_idx),
+            NA_SM_RDV_ERRORED);
+    else if (msg_hdr.hdr.buf_size > 0)
+        na_sm_buf_release(
+            &poll_addr->shared_region->copy_bufs, msg_hdr.hdr.buf_idx);
+}
+
+/*---------------------------------------------------------------------------*/
+static void
+na_sm_msg_rdv_done(struct na_sm_addr *poll_addr,
+    struct na_sm_rdv_info *rdv_info, int32_t status)
+{
+    hg_atomic_set32(&rdv_info->status, status);
+
+    /* Wake up sender */
+    if (poll_addr == poll_addr->endpoint->source_addr &&
+        poll_addr->rx_notify > 0) {
+        int rc = hg_event_set(poll_addr->rx_notify);
+        NA_CHECK_SUBSYS_ERROR_DONE(
+            msg, rc != HG_UTIL_SUCCESS, "Could not notify sender");
+    } else if (poll_addr->tx_notify > 0) {
+        na_return_t err_ret = na_sm_event_set(poll_addr->tx_notify);
+        NA_CHECK_SUBSYS_ERROR_DONE(
+            msg, err_ret != NA_SUCCESS, "Could not notify sender");
+    }
+}
+
+/*---------------------------------------------------------------------------*/
+static void
+na_sm_progress_rdv(struct na_sm_endpoint *na_sm_endpoint, bool *progressed)
+{
+    struct na_sm_op_queue *rdv_op_queue = &na_sm_endpoint->rdv_op_queue;
+    HG_QUEUE_HEAD(na_sm_op_id) complete_queue;
+    struct na_sm_op_id *na_sm_op_id;
+
+    *progressed = false;
+    HG_QUEUE_INIT(&complete_queue);
+
+    /* Pick up msgs whose data was pulled */
+    hg_thread_spin_lock(&rdv_op_queue->lock);
+    na_sm_op_id = HG_QUEUE_FIRST(&rdv_op_queue->queue);
+    while (na_sm_op_id) {
+        struct na_sm_op_id *next = HG_QUEUE_NEXT(na_sm_op_id, entry);
+        int32_t status =
+            hg_atomic_get32(&NA_SM_RDV_INFO(na_sm_op_id->addr->shared_region,
+                na_sm_op_id->info.msg.rdv_buf_idx)
+                                 ->status);
+
+        if (status == NA_SM_RDV_COMPLETED || status == NA_SM_RDV_ERRORED) {
+            HG_QUEUE_REMOVE(
+                &rdv_op_queue->queue, na_sm_op_id, na_sm_op_id, entry);
+            hg_atomic_and32(&na_sm_op_id->status, ~NA_SM_OP_RDV);
+            HG_QUEUE_PUSH_TAIL(&complete_queue, na_sm_op_id, entry);
+        }
+        na_sm_op_id = next;
+    }
+    hg_thread_spin_unlock(&rdv_op_queue->lock);
+
+    while ((na_sm_op_id = HG_QUEUE_FIRST(&complete_queue)) != NULL) {
+        struct na_sm_region *shared_region = na_sm_op_id->addr->shared_region;
+        unsigned int buf_idx = na_sm_op_id->info.msg.rdv_buf_idx;
+        int32_t status =
+            hg_atomic_get32(&NA_SM_RDV_INFO(shared_region, buf_idx)->status);
+
+        HG_QUEUE_POP_HEAD(&complete_queue, entry);
+
+        na_sm_buf_release(&shared_region->copy_bufs, buf_idx);
+        na_sm_complete(na_sm_op_id,
+            (status == NA_SM_RDV_COMPLETED) ? NA_SUCCESS : NA_PROTOCOL_ERROR);
+        *progressed = true;
+    }
+}
+
 /*---------------------------------------------------------------------------*/
 static NA_INLINE na_return_t
 na_sm_buf_reserve(struct na_sm_copy_buf *na_sm_copy_buf, unsigned int *index)
@@ -3651,6 +4118,10 @@ na_sm_poll_wait(na_context_t *context, struct na_sm_endpoint *na_sm_endpoint,
                 NA_CHECK_SUBSYS_NA_ERROR(
                     poll, done, ret, "Could not progress sock");
                 break;
+            case NA_SM_POLL_CONNECT:
+                /* Peer drained its sock, connect is resumed from progress */
+                NA_LOG_SUBSYS_DEBUG(poll_loop, "NA_SM_POLL_CONNECT event");
+                break;
             case NA_SM_POLL_TX_NOTIFY:
                 NA_LOG_SUBSYS_DEBUG(poll_loop, "NA_SM_POLL_TX_NOTIFY event");
                 poll_addr = container_of(
@@ -3668,10 +4139,19 @@ na_sm_poll_wait(na_context_t *context, struct na_sm_endpoint *na_sm_endpoint,
                 NA_CHECK_SUBSYS_NA_ERROR(
                     poll, done, ret, "Could not progress rx notify");
 
-                ret = na_sm_progress_rx_queue(
-                    na_sm_endpoint, poll_addr, &progressed_rx);
-                NA_CHECK_SUBSYS_NA_ERROR(
-                    poll, done, ret, "Could not progress rx queue");
+                /* Drain the queue, io_uring polls coalesce notifications
+                 * that arrive before the event is reaped */
+                for (;;) {
+                    bool progressed_msg = false;
+
+                    ret = na_sm_progress_rx_queue(
+                        na_sm_endpoint, poll_addr, &progressed_msg);
+                    NA_CHECK_SUBSYS_NA_ERROR(
+                        poll, done, ret, "Could not progress rx queue");
+                    if (!progressed_msg)
+                        break;
+                    progressed_rx = true;
+                }
 
                 break;
             default:
@@ -3714,7 +4194,7 @@ na_sm_poll(struct na_sm_endpoint *na_sm_endpoint, bool *progressed_ptr)
     }
     hg_thread_spin_unlock(&poll_addr_list->lock);
 
-    /* Look for message in cmd queue (if listening) */
+    /* Look for messages in cmd queue (if listening) */
     if (na_sm_endpoint->source_addr->shared_region) {
         bool progressed_cmd = false;
 
@@ -3734,16 +4214,26 @@ done:
 static na_return_t
 na_sm_progress_sock(struct na_sm_endpoint *na_sm_endpoint, bool *progressed)
 {
-    union na_sm_cmd_hdr cmd_hdr = {.val = 0};
-    int tx_notify = -1, rx_notify = -1;
     na_return_t ret = NA_SUCCESS;
 
-    /* Attempt to receive addr info (events, queue index) */
-    ret = na_sm_addr_event_recv(
-        na_sm_endpoint->sock, &cmd_hdr, &tx_notify, &rx_notify, progressed);
-    NA_CHECK_SUBSYS_NA_ERROR(addr, done, ret, "Could not recv addr events");
+    *progressed = false;
+
+    /* Drain all pending requests so that peers connecting concurrently are
+     * not serviced one per progress call */
+    for (;;) {
+        union na_sm_cmd_hdr cmd_hdr = {.val = 0};
+        int tx_notify = -1, rx_notify = -1;
+        bool received = false;
+
+        /* Attempt to receive addr info (events, queue index) */
+        ret = na_sm_addr_event_recv(
+            na_sm_endpoint->sock, &cmd_hdr, &tx_notify, &rx_notify, &received);
+        NA_CHECK_SUBSYS_NA_ERROR(
+            addr, done, ret, "Could not recv addr events");
+        if (!received)
+            break;
+        *progressed = true;
 
-    if (*progressed) {
         if (tx_notify > 0)
             hg_atomic_incr32(&na_sm_endpoint->nofile);
 
@@ -3767,15 +4257,16 @@ na_sm_progress_cmd_queue(
     union na_sm_cmd_hdr cmd_hdr = {.val = 0};
     na_return_t ret = NA_SUCCESS;
 
-    /* Look for message in cmd queue */
-    if (!na_sm_cmd_queue_pop(
-            &na_sm_endpoint->source_addr->shared_region->cmd_queue, &cmd_hdr)) {
-        *progressed = false;
-        goto done;
-    }
+    *progressed = false;
 
-    ret = na_sm_process_cmd(na_sm_endpoint, cmd_hdr, -1, -1);
-    NA_CHECK_SUBSYS_NA_ERROR(addr, done, ret, "Could not process cmd");
+    /* Drain all messages in cmd queue */
+    while (na_sm_cmd_queue_pop(
+        &na_sm_endpoint->source_addr->shared_region->cmd_queue, &cmd_hdr)) {
+        *progressed = true;
+
+        ret = na_sm_process_cmd(na_sm_endpoint, cmd_hdr, -1, -1);
+        NA_CHECK_SUBSYS_NA_ERROR(addr, done, ret, "Could not process cmd");
+    }
 
 done:
     return ret;
@@ -3935,8 +4426,15 @@ na_sm_progress_rx_queue(struct na_sm_endpoint *na_sm_endpoint,
 
     NA_LOG_SUBSYS_DEBUG(msg, "Found msg in queue");
 
+    /* Drop msgs canceled by sender */
+    if (!na_sm_msg_data_claim(poll_addr, msg_hdr)) {
+        NA_LOG_SUBSYS_DEBUG(msg, "Dropping msg canceled by sender");
+        *progressed = true;
+        goto done;
+    }
+
     /* Process expected and unexpected messages */
-    switch (msg_hdr.hdr.type) {
+    switch (msg_hdr.hdr.type & ~NA_SM_MSG_RDV) {
         case NA_CB_SEND_UNEXPECTED:
             ret = na_sm_process_unexpected(&na_sm_endpoint->unexpected_op_queue,
                 poll_addr, msg_hdr, &na_sm_endpoint->unexpected_msg_queue);
@@ -3982,27 +4480,22 @@ na_sm_process_unexpected(struct na_sm_op_queue *unexpected_op_queue,
     hg_thread_spin_unlock(&unexpected_op_queue->lock);
 
     if (likely(na_sm_op_id)) {
+        na_return_t cb_ret;
+
         /* Fill info */
         na_sm_op_id->completion_data.callback_info.info.recv_unexpected =
             (struct na_cb_info_recv_unexpected){
                 .tag = (na_tag_t) msg_hdr.hdr.tag,
-                .actual_buf_size = (size_t) msg_hdr.hdr.buf_size,
+                .actual_buf_size = na_sm_msg_data_size(poll_addr, msg_hdr),
                 .source = (na_addr_t *) poll_addr};
         na_sm_addr_ref_incr(poll_addr);
 
-        if (msg_hdr.hdr.buf_size > 0) {
-            /* Copy buffer */
-            na_sm_buf_copy_from(&poll_addr->shared_region->copy_bufs,
-                msg_hdr.hdr.buf_idx, na_sm_op_id->info.msg.buf.ptr,
-                msg_hdr.hdr.buf_size);
-
-            /* Release buffer */
-            na_sm_buf_release(
-                &poll_addr->shared_region->copy_bufs, msg_hdr.hdr.buf_idx);
-        }
+        /* Copy or pull data */
+        cb_ret = na_sm_msg_data_recv(poll_addr, msg_hdr,
+            na_sm_op_id->info.msg.buf.ptr, na_sm_op_id->info.msg.buf_size);
 
         /* Complete operation (no need to notify) */
-        na_sm_complete(na_sm_op_id, NA_SUCCESS);
+        na_sm_complete(na_sm_op_id, cb_ret);
     } else {
         /* If no error and message arrived, keep a copy of the struct in
          * the unexpected message queue (should rarely happen) */
@@ -4012,8 +4505,10 @@ na_sm_process_unexpected(struct na_sm_op_queue *unexpected_op_queue,
             NA_NOMEM, "Could not allocate unexpected info");
 
         na_sm_unexpected_info->na_sm_addr = poll_addr;
-        na_sm_unexpected_info->buf_size = (size_t) msg_hdr.hdr.buf_size;
+        na_sm_unexpected_info->buf_size =
+            na_sm_msg_data_size(poll_addr, msg_hdr);
         na_sm_unexpected_info->tag = (na_tag_t) msg_hdr.hdr.tag;
+        na_sm_unexpected_info->buf = NULL;
 
         if (na_sm_unexpected_info->buf_size > 0) {
             /* Allocate buf */
@@ -4023,16 +4518,12 @@ na_sm_process_unexpected(struct na_sm_op_queue *unexpected_op_queue,
                 error, ret, NA_NOMEM,
                 "Could not allocate na_sm_unexpected_info buf");
 
-            /* Copy buffer */
-            na_sm_buf_copy_from(&poll_addr->shared_region->copy_bufs,
-                msg_hdr.hdr.buf_idx, na_sm_unexpected_info->buf,
-                msg_hdr.hdr.buf_size);
-
-            /* Release buffer */
-            na_sm_buf_release(
-                &poll_addr->shared_region->copy_bufs, msg_hdr.hdr.buf_idx);
-        } else
-            na_sm_unexpected_info->buf = NULL;
+            /* Copy or pull data */
+            ret = na_sm_msg_data_recv(poll_addr, msg_hdr,
+                na_sm_unexpected_info->buf, na_sm_unexpected_info->buf_size);
+            NA_CHECK_SUBSYS_NA_ERROR(
+                msg, error, ret, "Could not receive unexpected msg data");
+        }
 
         /* Otherwise push the unexpected message into our unexpected queue so
          * that we can treat it later when a recv_unexpected is posted */
@@ -4046,6 +4537,8 @@ done:
     return ret;
 
 error:
+    if (na_sm_unexpected_info)
+        free(na_sm_unexpected_info->buf);
     free(na_sm_unexpected_info);
     return ret;
 }
@@ -4073,29 +4566,72 @@ na_sm_process_expected(struct na_sm_op_queue *expected_op_queue,
     }
     hg_thread_spin_unlock(&expected_op_queue->lock);
 
-    NA_CHECK_SUBSYS_ERROR(op, na_sm_op_id == NULL, done, ret, NA_INVALID_ARG,
-        "Invalid operation ID");
+    if (unlikely(na_sm_op_id == NULL)) {
+        /* Let sender release its buffer */
+        na_sm_msg_data_drop(poll_addr, msg_hdr);
+        NA_GOTO_SUBSYS_ERROR(
+            op, done, ret, NA_INVALID_ARG, "Invalid operation ID");
+    }
     /* Cannot have an already completed operation ID, TODO add sanity check */
 
     na_sm_op_id->completion_data.callback_info.info.recv_expected
-        .actual_buf_size = msg_hdr.hdr.buf_size;
+        .actual_buf_size = na_sm_msg_data_size(poll_addr, msg_hdr);
 
-    if (msg_hdr.hdr.buf_size > 0) {
-        /* Copy buffer */
-        na_sm_buf_copy_from(&poll_addr->shared_region->copy_bufs,
-            msg_hdr.hdr.buf_idx, na_sm_op_id->info.msg.buf.ptr,
-            msg_hdr.hdr.buf_size);
+    /* Copy or pull data, then complete operation */
+    na_sm_complete(na_sm_op_id,
+        na_sm_msg_data_recv(poll_addr, msg_hdr, na_sm_op_id->info.msg.buf.ptr,
+            na_sm_op_id->info.msg.buf_size));
 
-        /* Release buffer */
-        na_sm_buf_release(
-            &poll_addr->shared_region->copy_bufs, msg_hdr.hdr.buf_idx);
+done:
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static void
+na_sm_progress_connects(
+    struct na_sm_endpoint *na_sm_endpoint, bool *progressed)
+{
+    struct na_sm_addr_list *connect_addr_list =
+        &na_sm_endpoint->connect_addr_list;
+    HG_LIST_HEAD(na_sm_addr) pending_list;
+    struct na_sm_addr *na_sm_addr;
+
+    *progressed = false;
+
+    /* Take all pending addresses so that they can be resumed unlocked */
+    hg_thread_spin_lock(&connect_addr_list->lock);
+    HG_LIST_INIT(&pending_list);
+    while ((na_sm_addr = HG_LIST_FIRST(&connect_addr_list->list)) != NULL) {
+        HG_LIST_REMOVE(na_sm_addr, connect_entry);
+        HG_LIST_INSERT_HEAD(&pending_list, na_sm_addr, connect_entry);
     }
+    hg_thread_spin_unlock(&connect_addr_list->lock);
 
-    /* Complete operation */
-    na_sm_complete(na_sm_op_id, NA_SUCCESS);
+    while ((na_sm_addr = HG_LIST_FIRST(&pending_list)) != NULL) {
+        na_return_t ret;
 
-done:
-    return ret;
+        HG_LIST_REMOVE(na_sm_addr, connect_entry);
+
+        ret = na_sm_addr_connect_resume(na_sm_addr);
+        if (ret == NA_AGAIN) {
+            /* Resume next time */
+            hg_thread_spin_lock(&connect_addr_list->lock);
+            HG_LIST_INSERT_HEAD(
+                &connect_addr_list->list, na_sm_addr, connect_entry);
+            hg_thread_spin_unlock(&connect_addr_list->lock);
+            continue;
+        }
+
+        if (ret != NA_SUCCESS)
+            NA_LOG_SUBSYS_DEBUG(addr,
+                "Could not connect to PID=%d, ID=%" PRIu8 " (%s)",
+                na_sm_addr->addr_key.pid, na_sm_addr->addr_key.id,
+                NA_Error_to_string(ret));
+
+        hg_atomic_and32(&na_sm_addr->status, ~NA_SM_ADDR_CONNECTING);
+        na_sm_addr_ref_decr(na_sm_addr);
+        *progressed = true;
+    }
 }
 
 /*---------------------------------------------------------------------------*/
@@ -4121,10 +4657,9 @@ na_sm_process_retries(struct na_sm_endpoint *na_sm_endpoint)
         NA_LOG_SUBSYS_DEBUG(op, "Attempting to retry %p", (void *) na_sm_op_id);
 
         /* Attempt to resolve address first */
-        ret = na_sm_msg_send_post(na_sm_endpoint,
+        ret = na_sm_msg_send_post(na_sm_endpoint, na_sm_op_id->addr,
             na_sm_op_id->completion_data.callback_info.type,
-            na_sm_op_id->info.msg.buf.const_ptr, na_sm_op_id->info.msg.buf_size,
-            na_sm_op_id->addr, na_sm_op_id->info.msg.tag);
+            &na_sm_op_id->info.msg);
         if (ret == NA_SUCCESS) {
             /* Succeeded, cannot cancel anymore */
             hg_thread_spin_lock(&op_queue->lock);
@@ -4134,8 +4669,7 @@ na_sm_process_retries(struct na_sm_endpoint *na_sm_endpoint)
             hg_atomic_and32(&na_sm_op_id->status, ~NA_SM_OP_QUEUED);
             hg_thread_spin_unlock(&op_queue->lock);
 
-            /* Immediate completion, add directly to completion queue. */
-            na_sm_complete(na_sm_op_id, NA_SUCCESS);
+            na_sm_msg_send_posted(na_sm_endpoint, na_sm_op_id);
         } else if (ret == NA_AGAIN) {
             bool canceled = false;
 
@@ -4285,6 +4819,17 @@ na_sm_initialize(
 #endif
     na_sm_class->context_max = na_init_info.max_contexts;
 
+    /* Size hints can only grow msg sizes when data can be pulled by receiver,
+     * msgs that fit into a copy buffer are still copied eagerly */
+    na_sm_class->max_unexpected_size = NA_SM_UNEXPECTED_SIZE;
+    na_sm_class->max_expected_size = NA_SM_EXPECTED_SIZE;
+#ifdef NA_SM_HAS_RDV
+    if (na_init_info.max_unexpected_size > NA_SM_UNEXPECTED_SIZE)
+        na_sm_class->max_unexpected_size = na_init_info.max_unexpected_size;
+    if (na_init_info.max_expected_size > NA_SM_EXPECTED_SIZE)
+        na_sm_class->max_expected_size = na_init_info.max_expected_size;
+#endif
+
     /* Open endpoint */
     ret = na_sm_endpoint_open(&na_sm_class->endpoint, na_info->host_name,
         listen, na_init_info.progress_mode & NA_NO_BLOCK,
@@ -4411,6 +4956,7 @@ na_sm_addr_lookup(na_class_t *na_class, const char *name, na_addr_t **addr_p)
     struct na_sm_addr *na_sm_addr = NULL;
     char uri[NA_SM_MAX_FILENAME];
     struct na_sm_addr_key addr_key;
+    bool inserted = false;
     na_return_t ret = NA_SUCCESS;
 
     /* Extra info from string */
@@ -4442,6 +4988,7 @@ na_sm_addr_lookup(na_class_t *na_class, const char *name, na_addr_t **addr_p)
             &na_sm_endpoint->addr_map, uri, &addr_key, &na_sm_addr);
         NA_CHECK_SUBSYS_ERROR(addr, na_ret != NA_SUCCESS && na_ret != NA_EXIST,
             error, ret, na_ret, "Could not insert new address");
+        inserted = (na_ret == NA_SUCCESS);
     } else {
         NA_LOG_SUBSYS_DEBUG(addr, "Address for PID=%d, ID=%" PRIu8 " was found",
             addr_key.pid, addr_key.id);
@@ -4450,6 +4997,11 @@ na_sm_addr_lookup(na_class_t *na_class, const char *name, na_addr_t **addr_p)
     /* Increment refcount */
     na_sm_addr_ref_incr(na_sm_addr);
 
+    /* Start handshake now so that the first message does not wait for it, a
+     * peer whose sock is full is connected in the background from progress */
+    if (inserted)
+        na_sm_addr_connect(na_sm_addr);
+
     *addr_p = (na_addr_t *) na_sm_addr;
 
     return NA_SUCCESS;
@@ -4614,16 +5166,24 @@ done:
 
 /*---------------------------------------------------------------------------*/
 static NA_INLINE size_t
-na_sm_msg_get_max_unexpected_size(const na_class_t NA_UNUSED *na_class)
+na_sm_msg_get_max_unexpected_size(const na_class_t *na_class)
 {
-    return NA_SM_UNEXPECTED_SIZE;
+    return NA_SM_CLASS(na_class)->max_unexpected_size;
 }
 
 /*---------------------------------------------------------------------------*/
 static NA_INLINE size_t
-na_sm_msg_get_max_expected_size(const na_class_t NA_UNUSED *na_class)
+na_sm_msg_get_max_expected_size(const na_class_t *na_class)
 {
-    return NA_SM_EXPECTED_SIZE;
+    return NA_SM_CLASS(na_class)->max_expected_size;
+}
+
+/*---------------------------------------------------------------------------*/
+static NA_INLINE size_t
+na_sm_msg_get_max_inject_size(const na_class_t *na_class)
+{
+    /* Injected msgs are copied, rendezvous needs the buffer until pulled */
+    return MIN(NA_SM_COPY_BUF_SIZE, NA_SM_CLASS(na_class)->max_expected_size);
 }
 
 /*---------------------------------------------------------------------------*/
@@ -4657,7 +5217,8 @@ na_sm_msg_recv_unexpected(na_class_t *na_class, na_context_t *context,
     struct na_sm_op_id *na_sm_op_id = (struct na_sm_op_id *) op_id;
     na_return_t ret;
 
-    NA_CHECK_SUBSYS_ERROR(msg, buf_size > NA_SM_UNEXPECTED_SIZE, error, ret,
+    NA_CHECK_SUBSYS_ERROR(msg,
+        buf_size > NA_SM_CLASS(na_class)->max_unexpected_size, error, ret,
         NA_OVERFLOW, "Exceeds unexpected size, %zu", buf_size);
 
     /* Check op_id */
@@ -4733,6 +5294,30 @@ na_sm_msg_send_expected(na_class_t *na_class, na_context_t *context,
         (struct na_sm_op_id *) op_id);
 }
 
+/*---------------------------------------------------------------------------*/
+static na_return_t
+na_sm_msg_send_expected_inject(na_class_t *na_class,
+    na_context_t NA_UNUSED *context, const void *buf, size_t buf_size,
+    void NA_UNUSED *plugin_data, na_addr_t *dest_addr,
+    uint8_t NA_UNUSED dest_id, na_tag_t tag)
+{
+    struct na_sm_msg_info msg_info = {
+        .buf.const_ptr = buf, .buf_size = buf_size, .tag = tag};
+    na_return_t ret;
+
+    NA_CHECK_SUBSYS_ERROR(msg,
+        buf_size > na_sm_msg_get_max_inject_size(na_class), error, ret,
+        NA_OVERFLOW, "Exceeds max inject size, %zu", buf_size);
+
+    /* Msg is copied to the peer's copy buffer or not posted at all, there is
+     * nothing left to complete once posted */
+    return na_sm_msg_send_post(&NA_SM_CLASS(na_class)->endpoint,
+        (struct na_sm_addr *) dest_addr, NA_CB_SEND_EXPECTED, &msg_info);
+
+error:
+    return ret;
+}
+
 /*---------------------------------------------------------------------------*/
 static na_return_t
 na_sm_msg_recv_expected(na_class_t *na_class, na_context_t *context,
@@ -4746,7 +5331,8 @@ na_sm_msg_recv_expected(na_class_t *na_class, na_context_t *context,
     struct na_sm_addr *na_sm_addr = (struct na_sm_addr *) source_addr;
     na_return_t ret;
 
-    NA_CHECK_SUBSYS_ERROR(msg, buf_size > NA_SM_EXPECTED_SIZE, error, ret,
+    NA_CHECK_SUBSYS_ERROR(msg,
+        buf_size > NA_SM_CLASS(na_class)->max_expected_size, error, ret,
         NA_OVERFLOW, "Exceeds expected size, %zu", buf_size);
 
     /* Check op_id */
@@ -5041,6 +5627,13 @@ na_sm_poll_try_wait(na_class_t *na_class, na_context_t NA_UNUSED *context)
     if (!empty)
         return false;
 
+    /* Check whether msgs are waiting for their data to be pulled */
+    hg_thread_spin_lock(&na_sm_endpoint->rdv_op_queue.lock);
+    empty = HG_QUEUE_IS_EMPTY(&na_sm_endpoint->rdv_op_queue.queue);
+    hg_thread_spin_unlock(&na_sm_endpoint->rdv_op_queue.lock);
+    if (!empty)
+        return false;
+
     return true;
 }
 
@@ -5073,6 +5666,22 @@ na_sm_progress(
                 "Could not make non-blocking progress on context");
         }
 
+        /* Complete msgs whose data was pulled by receiver */
+        if (!HG_QUEUE_IS_EMPTY(&na_sm_endpoint->rdv_op_queue.queue)) {
+            bool progressed_rdv = false;
+
+            na_sm_progress_rdv(na_sm_endpoint, &progressed_rdv);
+            progressed |= progressed_rdv;
+        }
+
+        /* Resume pending connections before retrying messages */
+        if (!HG_LIST_IS_EMPTY(&na_sm_endpoint->connect_addr_list.list)) {
+            bool progressed_connect = false;
+
+            na_sm_progress_connects(na_sm_endpoint, &progressed_connect);
+            progressed |= progressed_connect;
+        }
+
         /* Process retries */
         ret = na_sm_process_retries(&NA_SM_CLASS(na_class)->endpoint);
         NA_CHECK_SUBSYS_NA_ERROR(
@@ -5097,7 +5706,7 @@ na_sm_cancel(
     na_class_t *na_class, na_context_t NA_UNUSED *context, na_op_id_t *op_id)
 {
     struct na_sm_op_id *na_sm_op_id = (struct na_sm_op_id *) op_id;
-    struct na_sm_op_queue *op_queue = NULL;
+    struct na_sm_op_queue *op_queue = NULL, *rdv_op_queue = NULL;
     int32_t status;
     na_return_t ret;
 
@@ -5122,8 +5731,11 @@ na_sm_cancel(
             break;
         case NA_CB_SEND_UNEXPECTED:
         case NA_CB_SEND_EXPECTED:
-            /* Must remove op_id from retry op queue */
-            op_queue = &NA_SM_CLASS(na_class)->endpoint.retry_op_queue;
+            /* Must remove op_id from rendezvous or retry op queue */
+            if (status & NA_SM_OP_RDV)
+                rdv_op_queue = &NA_SM_CLASS(na_class)->endpoint.rdv_op_queue;
+            else
+                op_queue = &NA_SM_CLASS(na_class)->endpoint.retry_op_queue;
             break;
         case NA_CB_PUT:
         case NA_CB_GET:
@@ -5162,6 +5774,34 @@ na_sm_cancel(
         }
     }
 
+    /* Msg can only be canceled if receiver has not started pulling data, in
+     * which case receiver drops it and releases the copy buffer */
+    if (rdv_op_queue) {
+        bool canceled = false;
+
+        hg_thread_spin_lock(&rdv_op_queue->lock);
+        if ((hg_atomic_get32(&na_sm_op_id->status) & NA_SM_OP_RDV) &&
+            hg_atomic_cas32(
+                &NA_SM_RDV_INFO(na_sm_op_id->addr->shared_region,
+                    na_sm_op_id->info.msg.rdv_buf_idx)
+                     ->status,
+                NA_SM_RDV_PENDING, NA_SM_RDV_CANCELED)) {
+            HG_QUEUE_REMOVE(
+                &rdv_op_queue->queue, na_sm_op_id, na_sm_op_id, entry);
+            hg_atomic_and32(&na_sm_op_id->status, ~NA_SM_OP_RDV);
+            hg_atomic_or32(&na_sm_op_id->status, NA_SM_OP_CANCELED);
+            canceled = true;
+        }
+        hg_thread_spin_unlock(&rdv_op_queue->lock);
+
+        /* Cancel op id */
+        if (canceled) {
+            na_sm_complete(na_sm_op_id, NA_CANCELED);
+
+            na_sm_complete_signal(NA_SM_CLASS(na_class));
+        }
+    }
+
     return NA_SUCCESS;
 
 error:
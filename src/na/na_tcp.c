@@ -0,0 +1,3094 @@
+/**
+ * Copyright (c) 2013-2022 UChicago Argonne, LLC and The HDF Group.
+ * Copyright (c) 2022 Intel Corporation.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#if !defined(_WIN32) && !defined(_GNU_SOURCE)
+#    define _GNU_SOURCE
+#endif
+#include "na_plugin.h"
+
+#include "na_ip.h"
+
+#include "mercury_event.h"
+#include "mercury_list.h"
+#include "mercury_poll.h"
+#include "mercury_queue.h"
+#include "mercury_thread_mutex.h"
+#include "mercury_thread_rwlock.h"
+#include "mercury_thread_spin.h"
+#include "mercury_time.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <fcntl.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <sys/types.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#if defined(__linux__) && defined(SO_ZEROCOPY) && defined(MSG_ZEROCOPY)
+#    define NA_TCP_HAS_ZCOPY
+#    include <linux/errqueue.h>
+#endif
+
+/****************/
+/* Local Macros */
+/****************/
+
+/* Default protocol */
+#define NA_TCP_PROTOCOL "tcp"
+
+/* Max length of "host:port" strings */
+#define NA_TCP_MAX_URI (NI_MAXHOST + NI_MAXSERV)
+
+/* Default msg sizes */
+#define NA_TCP_UNEXPECTED_SIZE (4096)
+#define NA_TCP_EXPECTED_SIZE   NA_TCP_UNEXPECTED_SIZE
+
+/* Max tag */
+#define NA_TCP_MAX_TAG NA_TAG_MAX
+
+/* Listen backlog */
+#define NA_TCP_LISTEN_BACKLOG (128)
+
+/* Max events */
+#define NA_TCP_MAX_EVENTS 16
+
+/* Size of scratch buffer used to discard payloads */
+#define NA_TCP_DISCARD_SIZE (4096)
+
+/* Min RMA payload size sent with MSG_ZEROCOPY (when enabled) */
+#define NA_TCP_ZCOPY_THRESHOLD (65536)
+
+/* Msg types */
+#define NA_TCP_MSG_HELLO      (1)
+#define NA_TCP_MSG_UNEXPECTED (2)
+#define NA_TCP_MSG_EXPECTED   (3)
+#define NA_TCP_MSG_PUT        (4)
+#define NA_TCP_MSG_PUT_ACK    (5)
+#define NA_TCP_MSG_GET_REQ    (6)
+#define NA_TCP_MSG_GET_RESP   (7)
+
+/* Addr status bits */
+#define NA_TCP_ADDR_CONNECTED    (1 << 0)
+#define NA_TCP_ADDR_DISCONNECTED (1 << 1)
+#define NA_TCP_ADDR_POLLOUT      (1 << 2)
+#define NA_TCP_ADDR_ZCOPY        (1 << 3)
+
+/* Op ID status bits */
+#define NA_TCP_OP_COMPLETED (1 << 0)
+#define NA_TCP_OP_CANCELED  (1 << 1)
+#define NA_TCP_OP_QUEUED    (1 << 2)
+#define NA_TCP_OP_ERRORED   (1 << 3)
+#define NA_TCP_OP_TX        (1 << 4)
+
+/* Private data access */
+#define NA_TCP_CLASS(na_class)                                                 \
+    ((struct na_tcp_class *) (na_class->plugin_class))
+#define NA_TCP_CONTEXT(context)                                                \
+    ((struct na_tcp_context *) (context->plugin_context))
+
+/* Reset op ID */
+#define NA_TCP_OP_RESET(__op, __context, __cb_type, __cb, __arg, __addr)       \
+    do {                                                                       \
+        __op->context = __context;                                             \
+        __op->completion_data.callback_info.type = __cb_type;                  \
+        __op->completion_data.callback = __cb;                                 \
+        __op->completion_data.callback_info.arg = __arg;                       \
+        __op->addr = __addr;                                                   \
+        na_tcp_addr_ref_incr(__addr);                                          \
+        hg_atomic_set32(&__op->status, 0);                                     \
+    } while (0)
+
+#define NA_TCP_OP_RESET_UNEXPECTED_RECV(__op, __context, __cb, __arg)          \
+    do {                                                                       \
+        __op->context = __context;                                             \
+        __op->completion_data.callback_info.type = NA_CB_RECV_UNEXPECTED;      \
+        __op->completion_data.callback = __cb;                                 \
+        __op->completion_data.callback_info.arg = __arg;                       \
+        __op->completion_data.callback_info.info.recv_unexpected =             \
+            (struct na_cb_info_recv_unexpected){                               \
+                .actual_buf_size = 0, .source = NULL, .tag = 0};               \
+        __op->addr = NULL;                                                     \
+        hg_atomic_set32(&__op->status, 0);                                     \
+    } while (0)
+
+#define NA_TCP_OP_RELEASE(__op)                                                \
+    do {                                                                       \
+        if (__op->addr)                                                        \
+            na_tcp_addr_ref_decr(__op->addr);                                  \
+        hg_atomic_set32(&__op->status, NA_TCP_OP_COMPLETED);                   \
+    } while (0)
+
+/************************************/
+/* Local Type and Struct Definition */
+/************************************/
+
+/* Poll type */
+typedef enum na_tcp_poll_type {
+    NA_TCP_POLL_LISTEN = 1,
+    NA_TCP_POLL_NOTIFY,
+    NA_TCP_POLL_CONN
+} na_tcp_poll_type_t;
+
+/* Msg header (peers are expected to share the same byte order) */
+struct na_tcp_msg_hdr {
+    uint64_t addr;     /* Target address of RMA ops */
+    uint64_t cookie;   /* Initiator op ID of RMA ops */
+    uint64_t size;     /* Size of payload following header */
+    uint64_t rma_size; /* Requested size of RMA get */
+    uint32_t tag;      /* Msg tag or RMA status */
+    uint8_t type;      /* Msg type */
+    uint8_t pad[3];    /* Padding */
+};
+
+/* Tx entry */
+struct na_tcp_tx {
+    HG_QUEUE_ENTRY(na_tcp_tx) entry; /* Entry in tx queue */
+    struct na_tcp_msg_hdr hdr;       /* Msg header */
+    struct iovec iov[2];             /* Header and payload */
+    struct na_tcp_op_id *op_id;      /* Op ID (NULL if internal) */
+    size_t len;                      /* Total length */
+    size_t sent;                     /* Length sent */
+};
+
+/* Rx state */
+struct na_tcp_rx {
+    struct na_tcp_msg_hdr hdr;  /* Current header */
+    struct na_tcp_msg_hdr next; /* Read-ahead of next header */
+    struct na_tcp_op_id *op_id; /* Op ID matched against header */
+    char *buf;                  /* Payload destination (NULL to discard) */
+    void *tmp;                  /* Buffer owned by rx state */
+    size_t hdr_off;             /* Header bytes received */
+    size_t off;                 /* Payload bytes received */
+    na_return_t ret;            /* Status reported on completion */
+};
+
+/* Address */
+struct na_tcp_addr {
+    HG_LIST_ENTRY(na_tcp_addr) entry;  /* Entry in addr list */
+    HG_QUEUE_HEAD(na_tcp_tx) tx_queue; /* Pending tx */
+    struct na_tcp_rx rx;               /* Rx state */
+    struct sockaddr_storage ss;        /* Peer listening address */
+    struct na_tcp_class *na_tcp_class; /* Class */
+    hg_thread_mutex_t tx_lock;         /* Lock for tx queue and connect */
+    hg_thread_mutex_t rx_lock;         /* Lock for rx state */
+    socklen_t salen;                   /* Length of address (0 if unknown) */
+    hg_atomic_int32_t refcount;        /* Ref count */
+    hg_atomic_int32_t status;          /* Status bits */
+    enum na_tcp_poll_type poll_type;   /* Poll type */
+    int sock;                          /* Connected sock */
+    bool listed;                       /* Present in addr list */
+    char uri[NA_TCP_MAX_URI];          /* Peer listening "host:port" */
+};
+
+/* Address list */
+struct na_tcp_addr_list {
+    HG_LIST_HEAD(na_tcp_addr) list;
+    hg_thread_mutex_t lock;
+};
+
+/* Memory descriptor info */
+struct na_tcp_mem_desc_info {
+    uint64_t base; /* Base address */
+    uint64_t len;  /* Size of region */
+    uint8_t flags; /* Flag of operation access */
+};
+
+/* Memory handle */
+struct na_tcp_mem_handle {
+    HG_LIST_ENTRY(na_tcp_mem_handle) entry; /* Entry in mem list */
+    struct na_tcp_mem_desc_info info;       /* Segment info */
+    bool local;                             /* Created locally */
+};
+
+/* Memory list (used to validate incoming RMA requests) */
+struct na_tcp_mem_list {
+    HG_LIST_HEAD(na_tcp_mem_handle) list;
+    hg_thread_rwlock_t lock;
+};
+
+/* Msg info */
+struct na_tcp_msg_info {
+    union {
+        const void *const_ptr;
+        void *ptr;
+    } buf;
+    size_t buf_size;
+    na_tag_t tag;
+};
+
+/* RMA info */
+struct na_tcp_rma_info {
+    char *local_buf;
+    size_t length;
+};
+
+/* Operation ID */
+struct na_tcp_op_id {
+    struct na_cb_completion_data completion_data; /* Completion data */
+    union {
+        struct na_tcp_msg_info msg;
+        struct na_tcp_rma_info rma;
+    } info;                             /* Op info                  */
+    struct na_tcp_tx tx;                /* Tx entry                 */
+    HG_QUEUE_ENTRY(na_tcp_op_id) entry; /* Entry in queue           */
+    na_class_t *na_class;               /* NA class associated      */
+    na_context_t *context;              /* NA context associated    */
+    struct na_tcp_addr *addr;           /* Address associated       */
+    hg_atomic_int32_t status;           /* Operation status         */
+};
+
+/* Op ID queue */
+struct na_tcp_op_queue {
+    HG_QUEUE_HEAD(na_tcp_op_id) queue;
+    hg_thread_spin_t lock;
+};
+
+/* Unexpected msg info */
+struct na_tcp_unexpected_info {
+    HG_QUEUE_ENTRY(na_tcp_unexpected_info) entry;
+    struct na_tcp_addr *na_tcp_addr;
+    void *buf;
+    size_t buf_size;
+    na_tag_t tag;
+};
+
+/* Unexpected msg queue */
+struct na_tcp_unexpected_msg_queue {
+    HG_QUEUE_HEAD(na_tcp_unexpected_info) queue;
+    hg_thread_spin_t lock;
+};
+
+/* Private context */
+struct na_tcp_context {
+    struct hg_poll_event events[NA_TCP_MAX_EVENTS];
+};
+
+/* Private data */
+struct na_tcp_class {
+    struct na_tcp_addr_list addr_list; /* List of connections */
+    struct na_tcp_mem_list mem_list;   /* List of local mem handles */
+    struct na_tcp_unexpected_msg_queue
+        unexpected_msg_queue;                   /* Unexpected msg queue */
+    struct na_tcp_op_queue unexpected_op_queue; /* Unexpected op queue */
+    struct na_tcp_op_queue expected_op_queue;   /* Expected op queue */
+    struct na_tcp_op_queue rma_op_queue;        /* RMA op queue */
+    hg_poll_set_t *poll_set;                    /* Poll set */
+    size_t unexpected_size_max;                 /* Max unexpected size */
+    size_t expected_size_max;                   /* Max expected size */
+    int listen_sock;                            /* Listening sock */
+    int notify;                                 /* Completion notify fd */
+    enum na_tcp_poll_type listen_poll_type;     /* Listen poll type */
+    enum na_tcp_poll_type notify_poll_type;     /* Notify poll type */
+    bool no_block;                              /* Busy-spin on progress */
+    bool zcopy;                                 /* Use MSG_ZEROCOPY */
+    char uri[NA_TCP_MAX_URI];                   /* Listening "host:port" */
+    char discard[NA_TCP_DISCARD_SIZE];          /* Scratch buffer */
+};
+
+/********************/
+/* Local Prototypes */
+/********************/
+
+/**
+ * Convert errno to NA return values.
+ */
+static na_return_t
+na_tcp_errno_to_na(int rc);
+
+/**
+ * Resolve "host:port" string into a numeric URI and sockaddr.
+ */
+static na_return_t
+na_tcp_resolve(const char *name, char *uri, size_t uri_size,
+    struct sockaddr_storage *ss, socklen_t *salen_p);
+
+/**
+ * Open listening socket.
+ */
+static na_return_t
+na_tcp_listen_open(struct na_tcp_class *na_tcp_class, const char *host_name,
+    const char *ip_subnet);
+
+/**
+ * Set options on connected sockets.
+ */
+static na_return_t
+na_tcp_sock_set_opts(struct na_tcp_class *na_tcp_class, int sock, bool *zcopy);
+
+/**
+ * Allocate new address.
+ */
+static struct na_tcp_addr *
+na_tcp_addr_alloc(struct na_tcp_class *na_tcp_class);
+
+/**
+ * Increment ref count.
+ */
+static NA_INLINE void
+na_tcp_addr_ref_incr(struct na_tcp_addr *na_tcp_addr);
+
+/**
+ * Decrement ref count and free address if 0.
+ */
+static void
+na_tcp_addr_ref_decr(struct na_tcp_addr *na_tcp_addr);
+
+/**
+ * Insert address into address list (takes a reference).
+ */
+static void
+na_tcp_addr_list_insert(
+    struct na_tcp_addr_list *addr_list, struct na_tcp_addr *na_tcp_addr);
+
+/**
+ * Remove address from address list (releases reference).
+ */
+static void
+na_tcp_addr_list_remove(
+    struct na_tcp_addr_list *addr_list, struct na_tcp_addr *na_tcp_addr);
+
+/**
+ * Find address from URI.
+ */
+static struct na_tcp_addr *
+na_tcp_addr_list_find(struct na_tcp_addr_list *addr_list, const char *uri);
+
+/**
+ * Register connected socket to poll set.
+ */
+static na_return_t
+na_tcp_addr_poll_add(struct na_tcp_addr *na_tcp_addr, bool pollout);
+
+/**
+ * Connect address (must be called with tx lock held).
+ */
+static na_return_t
+na_tcp_addr_connect(struct na_tcp_addr *na_tcp_addr);
+
+/**
+ * Close connection and fail pending operations.
+ */
+static void
+na_tcp_addr_disconnect(struct na_tcp_addr *na_tcp_addr);
+
+/**
+ * Accept incoming connections.
+ */
+static na_return_t
+na_tcp_progress_accept(struct na_tcp_class *na_tcp_class, bool *progressed);
+
+/**
+ * Allocate internal tx entry.
+ */
+static struct na_tcp_tx *
+na_tcp_tx_alloc(uint8_t type, uint32_t tag, uint64_t addr, uint64_t cookie,
+    const void *payload, size_t size);
+
+/**
+ * Send as much as possible from tx entry.
+ */
+static na_return_t
+na_tcp_tx_send(struct na_tcp_addr *na_tcp_addr, struct na_tcp_tx *tx);
+
+/**
+ * Post tx entry, done is set if it was entirely sent.
+ */
+static na_return_t
+na_tcp_tx_post(
+    struct na_tcp_addr *na_tcp_addr, struct na_tcp_tx *tx, bool *done_p);
+
+/**
+ * Complete a tx entry that was sent or dropped.
+ */
+static void
+na_tcp_tx_complete(
+    struct na_tcp_class *na_tcp_class, struct na_tcp_tx *tx, na_return_t ret);
+
+/**
+ * Progress pending tx of address.
+ */
+static na_return_t
+na_tcp_progress_tx(struct na_tcp_addr *na_tcp_addr, bool *progressed);
+
+/**
+ * Progress rx of address.
+ */
+static na_return_t
+na_tcp_progress_rx(struct na_tcp_addr *na_tcp_addr, bool *progressed);
+
+#ifdef NA_TCP_HAS_ZCOPY
+/**
+ * Drain zero-copy notifications from error queue.
+ */
+static na_return_t
+na_tcp_progress_errqueue(struct na_tcp_addr *na_tcp_addr);
+#endif
+
+/**
+ * Start processing of message once header has been received.
+ */
+static na_return_t
+na_tcp_rx_start(struct na_tcp_addr *na_tcp_addr);
+
+/**
+ * Complete processing of message once payload has been received.
+ */
+static na_return_t
+na_tcp_rx_complete(struct na_tcp_addr *na_tcp_addr);
+
+/**
+ * Check that a local region was exposed with the requested access.
+ */
+static bool
+na_tcp_mem_check(struct na_tcp_mem_list *mem_list, uint64_t addr, size_t len,
+    uint8_t access);
+
+/**
+ * Find and remove RMA op from queue.
+ */
+static struct na_tcp_op_id *
+na_tcp_rma_op_pop(struct na_tcp_op_queue *rma_op_queue, uint64_t cookie);
+
+/**
+ * Send msg.
+ */
+static na_return_t
+na_tcp_msg_send(struct na_tcp_class *na_tcp_class, na_context_t *context,
+    na_cb_type_t cb_type, na_cb_t callback, void *arg, const void *buf,
+    size_t buf_size, struct na_tcp_addr *na_tcp_addr, uint8_t type,
+    na_tag_t tag, struct na_tcp_op_id *na_tcp_op_id);
+
+/**
+ * Post RMA op.
+ */
+static na_return_t
+na_tcp_rma(struct na_tcp_class *na_tcp_class, na_context_t *context,
+    na_cb_type_t cb_type, na_cb_t callback, void *arg,
+    struct na_tcp_mem_handle *local_mem_handle, na_offset_t local_offset,
+    struct na_tcp_mem_handle *remote_mem_handle, na_offset_t remote_offset,
+    size_t length, struct na_tcp_addr *na_tcp_addr,
+    struct na_tcp_op_id *na_tcp_op_id);
+
+/**
+ * Complete operation.
+ */
+static NA_INLINE void
+na_tcp_complete(struct na_tcp_op_id *na_tcp_op_id, na_return_t cb_ret);
+
+/**
+ * Signal completion outside of progress.
+ */
+static NA_INLINE void
+na_tcp_complete_signal(struct na_tcp_class *na_tcp_class);
+
+/**
+ * Release memory.
+ */
+static NA_INLINE void
+na_tcp_release(void *arg);
+
+/* check_protocol */
+static bool
+na_tcp_check_protocol(const char *protocol_name);
+
+/* initialize */
+static na_return_t
+na_tcp_initialize(
+    na_class_t *na_class, const struct na_info *na_info, bool listen);
+
+/* finalize */
+static na_return_t
+na_tcp_finalize(na_class_t *na_class);
+
+/* context_create */
+static na_return_t
+na_tcp_context_create(na_class_t *na_class, void **context_p, uint8_t id);
+
+/* context_destroy */
+static na_return_t
+na_tcp_context_destroy(na_class_t *na_class, void *context);
+
+/* op_create */
+static na_op_id_t *
+na_tcp_op_create(na_class_t *na_class, unsigned long flags);
+
+/* op_destroy */
+static void
+na_tcp_op_destroy(na_class_t *na_class, na_op_id_t *op_id);
+
+/* addr_lookup */
+static na_return_t
+na_tcp_addr_lookup(na_class_t *na_class, const char *name, na_addr_t **addr_p);
+
+/* addr_free */
+static void
+na_tcp_addr_free(na_class_t *na_class, na_addr_t *addr);
+
+/* addr_self */
+static na_return_t
+na_tcp_addr_self(na_class_t *na_class, na_addr_t **addr_p);
+
+/* addr_dup */
+static na_return_t
+na_tcp_addr_dup(na_class_t *na_class, na_addr_t *addr, na_addr_t **new_addr_p);
+
+/* addr_cmp */
+static bool
+na_tcp_addr_cmp(na_class_t *na_class, na_addr_t *addr1, na_addr_t *addr2);
+
+/* addr_is_self */
+static NA_INLINE bool
+na_tcp_addr_is_self(na_class_t *na_class, na_addr_t *addr);
+
+/* addr_to_string */
+static na_return_t
+na_tcp_addr_to_string(
+    na_class_t *na_class, char *buf, size_t *buf_size, na_addr_t *addr);
+
+/* addr_get_serialize_size */
+static NA_INLINE size_t
+na_tcp_addr_get_serialize_size(na_class_t *na_class, na_addr_t *addr);
+
+/* addr_serialize */
+static na_return_t
+na_tcp_addr_serialize(
+    na_class_t *na_class, void *buf, size_t buf_size, na_addr_t *addr);
+
+/* addr_deserialize */
+static na_return_t
+na_tcp_addr_deserialize(
+    na_class_t *na_class, na_addr_t **addr_p, const void *buf, size_t buf_size);
+
+/* msg_get_max_unexpected_size */
+static NA_INLINE size_t
+na_tcp_msg_get_max_unexpected_size(const na_class_t *na_class);
+
+/* msg_get_max_expected_size */
+static NA_INLINE size_t
+na_tcp_msg_get_max_expected_size(const na_class_t *na_class);
+
+/* msg_get_max_tag */
+static NA_INLINE na_tag_t
+na_tcp_msg_get_max_tag(const na_class_t *na_class);
+
+/* msg_send_unexpected */
+static na_return_t
+na_tcp_msg_send_unexpected(na_class_t *na_class, na_context_t *context,
+    na_cb_t callback, void *arg, const void *buf, size_t buf_size,
+    void *plugin_data, na_addr_t *dest_addr, uint8_t dest_id, na_tag_t tag,
+    na_op_id_t *op_id);
+
+/* msg_recv_unexpected */
+static na_return_t
+na_tcp_msg_recv_unexpected(na_class_t *na_class, na_context_t *context,
+    na_cb_t callback, void *arg, void *buf, size_t buf_size, void *plugin_data,
+    na_op_id_t *op_id);
+
+/* msg_send_expected */
+static na_return_t
+na_tcp_msg_send_expected(na_class_t *na_class, na_context_t *context,
+    na_cb_t callback, void *arg, const void *buf, size_t buf_size,
+    void *plugin_data, na_addr_t *dest_addr, uint8_t dest_id, na_tag_t tag,
+    na_op_id_t *op_id);
+
+/* msg_recv_expected */
+static na_return_t
+na_tcp_msg_recv_expected(na_class_t *na_class, na_context_t *context,
+    na_cb_t callback, void *arg, void *buf, size_t buf_size, void *plugin_data,
+    na_addr_t *source_addr, uint8_t source_id, na_tag_t tag, na_op_id_t *op_id);
+
+/* mem_handle_create */
+static na_return_t
+na_tcp_mem_handle_create(na_class_t *na_class, void *buf, size_t buf_size,
+    unsigned long flags, na_mem_handle_t **mem_handle_p);
+
+/* mem_handle_free */
+static void
+na_tcp_mem_handle_free(na_class_t *na_class, na_mem_handle_t *mem_handle);
+
+/* mem_handle_get_max_segments */
+static size_t
+na_tcp_mem_handle_get_max_segments(const na_class_t *na_class);
+
+/* mem_handle_get_serialize_size */
+static NA_INLINE size_t
+na_tcp_mem_handle_get_serialize_size(
+    na_class_t *na_class, na_mem_handle_t *mem_handle);
+
+/* mem_handle_serialize */
+static na_return_t
+na_tcp_mem_handle_serialize(na_class_t *na_class, void *buf, size_t buf_size,
+    na_mem_handle_t *mem_handle);
+
+/* mem_handle_deserialize */
+static na_return_t
+na_tcp_mem_handle_deserialize(na_class_t *na_class,
+    na_mem_handle_t **mem_handle_p, const void *buf, size_t buf_size);
+
+/* put */
+static NA_INLINE na_return_t
+na_tcp_put(na_class_t *na_class, na_context_t *context, na_cb_t callback,
+    void *arg, na_mem_handle_t *local_mem_handle, na_offset_t local_offset,
+    na_mem_handle_t *remote_mem_handle, na_offset_t remote_offset,
+    size_t length, na_addr_t *remote_addr, uint8_t remote_id,
+    na_op_id_t *op_id);
+
+/* get */
+static NA_INLINE na_return_t
+na_tcp_get(na_class_t *na_class, na_context_t *context, na_cb_t callback,
+    void *arg, na_mem_handle_t *local_mem_handle, na_offset_t local_offset,
+    na_mem_handle_t *remote_mem_handle, na_offset_t remote_offset,
+    size_t length, na_addr_t *remote_addr, uint8_t remote_id,
+    na_op_id_t *op_id);
+
+/* poll_get_fd */
+static NA_INLINE int
+na_tcp_poll_get_fd(na_class_t *na_class, na_context_t *context);
+
+/* poll_try_wait */
+static NA_INLINE bool
+na_tcp_poll_try_wait(na_class_t *na_class, na_context_t *context);
+
+/* progress */
+static na_return_t
+na_tcp_progress(
+    na_class_t *na_class, na_context_t *context, unsigned int timeout);
+
+/* cancel */
+static na_return_t
+na_tcp_cancel(na_class_t *na_class, na_context_t *context, na_op_id_t *op_id);
+
+/*******************/
+/* Local Variables */
+/*******************/
+
+const struct na_class_ops NA_PLUGIN_OPS(tcp) = {
+    "na",                                 /* name */
+    na_tcp_check_protocol,                /* check_protocol */
+    na_tcp_initialize,                    /* initialize */
+    na_tcp_finalize,                      /* finalize */
+    NULL,                                 /* cleanup */
+    NULL,                                 /* has_opt_feature */
+    na_tcp_context_create,                /* context_create */
+    na_tcp_context_destroy,               /* context_destroy */
+    na_tcp_op_create,                     /* op_create */
+    na_tcp_op_destroy,                    /* op_destroy */
+    na_tcp_addr_lookup,                   /* addr_lookup */
+    NULL,                                 /* addr_lookup_multi */
+    na_tcp_addr_free,                     /* addr_free */
+    NULL,                                 /* addr_set_remove */
+    na_tcp_addr_self,                     /* addr_self */
+    na_tcp_addr_dup,                      /* addr_dup */
+    na_tcp_addr_cmp,                      /* addr_cmp */
+    na_tcp_addr_is_self,                  /* addr_is_self */
+    na_tcp_addr_to_string,                /* addr_to_string */
+    na_tcp_addr_get_serialize_size,       /* addr_get_serialize_size */
+    na_tcp_addr_serialize,                /* addr_serialize */
+    na_tcp_addr_deserialize,              /* addr_deserialize */
+    NULL,                                 /* addr_deserialize_multi */
+    na_tcp_msg_get_max_unexpected_size,   /* msg_get_max_unexpected_size */
+    na_tcp_msg_get_max_expected_size,     /* msg_get_max_expected_size */
+    NULL,                                 /* msg_get_unexpected_header_size */
+    NULL,                                 /* msg_get_expected_header_size */
+    NULL,                                 /* msg_get_max_inject_size */
+    na_tcp_msg_get_max_tag,               /* msg_get_max_tag */
+    NULL,                                 /* msg_buf_alloc */
+    NULL,                                 /* msg_buf_free */
+    NULL,                                 /* msg_init_unexpected */
+    na_tcp_msg_send_unexpected,           /* msg_send_unexpected */
+    na_tcp_msg_recv_unexpected,           /* msg_recv_unexpected */
+    NULL,                                 /* msg_multi_recv_unexpected */
+    NULL,                                 /* msg_init_expected */
+    na_tcp_msg_send_expected,             /* msg_send_expected */
+    NULL,                                 /* msg_send_expected_inject */
+    na_tcp_msg_recv_expected,             /* msg_recv_expected */
+    na_tcp_mem_handle_create,             /* mem_handle_create */
+    NULL,                                 /* mem_handle_create_segments */
+    na_tcp_mem_handle_free,               /* mem_handle_free */
+    na_tcp_mem_handle_get_max_segments,   /* mem_handle_get_max_segments */
+    NULL,                                 /* mem_register */
+    NULL,                                 /* mem_deregister */
+    na_tcp_mem_handle_get_serialize_size, /* mem_handle_get_serialize_size */
+    na_tcp_mem_handle_serialize,          /* mem_handle_serialize */
+    na_tcp_mem_handle_deserialize,        /* mem_handle_deserialize */
+    na_tcp_put,                           /* put */
+    na_tcp_get,                           /* get */
+    na_tcp_poll_get_fd,                   /* poll_get_fd */
+    na_tcp_poll_try_wait,                 /* poll_try_wait */
+    na_tcp_progress,                      /* progress */
+    na_tcp_cancel                         /* cancel */
+};
+
+/********************/
+/* Plugin callbacks */
+/********************/
+
+static na_return_t
+na_tcp_errno_to_na(int rc)
+{
+    na_return_t ret;
+
+    switch (rc) {
+        case EPERM:
+            ret = NA_PERMISSION;
+            break;
+        case ENOENT:
+            ret = NA_NOENTRY;
+            break;
+        case EINTR:
+            ret = NA_INTERRUPT;
+            break;
+        case EAGAIN:
+            ret = NA_AGAIN;
+            break;
+        case ENOMEM:
+        case ENOBUFS:
+            ret = NA_NOMEM;
+            break;
+        case EACCES:
+            ret = NA_ACCESS;
+            break;
+        case EFAULT:
+            ret = NA_FAULT;
+            break;
+        case EBUSY:
+            ret = NA_BUSY;
+            break;
+        case EEXIST:
+        case EADDRINUSE:
+            ret = NA_EXIST;
+            break;
+        case EINVAL:
+            ret = NA_INVALID_ARG;
+            break;
+        case EMSGSIZE:
+            ret = NA_MSGSIZE;
+            break;
+        case EOPNOTSUPP:
+            ret = NA_OPNOTSUPPORTED;
+            break;
+        case EADDRNOTAVAIL:
+            ret = NA_ADDRNOTAVAIL;
+            break;
+        case ECONNREFUSED:
+        case ECONNRESET:
+        case EHOSTUNREACH:
+        case ENETUNREACH:
+        case EPIPE:
+            ret = NA_HOSTUNREACH;
+            break;
+        case ETIMEDOUT:
+            ret = NA_TIMEOUT;
+            break;
+        default:
+            ret = NA_PROTOCOL_ERROR;
+            break;
+    }
+
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static na_return_t
+na_tcp_resolve(const char *name, char *uri, size_t uri_size,
+    struct sockaddr_storage *ss, socklen_t *salen_p)
+{
+    char host[NI_MAXHOST], serv[NI_MAXSERV];
+    struct addrinfo hints, *addr_res = NULL;
+    const char *port_str;
+    size_t host_len;
+    na_return_t ret;
+    int rc;
+
+    /* Skip protocol prefix if present */
+    if (strncmp(name, NA_TCP_PROTOCOL "://", strlen(NA_TCP_PROTOCOL "://")) ==
+        0)
+        name += strlen(NA_TCP_PROTOCOL "://");
+
+    /* Port follows last delimiter */
+    port_str = strrchr(name, ':');
+    NA_CHECK_SUBSYS_ERROR(addr, port_str == NULL, error, ret, NA_INVALID_ARG,
+        "Malformed address string (%s), expected host:port", name);
+    host_len = (size_t) (port_str - name);
+    NA_CHECK_SUBSYS_ERROR(addr, host_len == 0 || host_len >= sizeof(host),
+        error, ret, NA_INVALID_ARG, "Invalid host name in (%s)", name);
+    memcpy(host, name, host_len);
+    host[host_len] = '\0';
+
+    memset(&hints, 0, sizeof(hints));
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+
+    rc = getaddrinfo(host, port_str + 1, &hints, &addr_res);
+    NA_CHECK_SUBSYS_ERROR(addr, rc != 0, error, ret, NA_ADDRNOTAVAIL,
+        "getaddrinfo() failed (%s) for %s", gai_strerror(rc), name);
+
+    memcpy(ss, addr_res->ai_addr, addr_res->ai_addrlen);
+    *salen_p = (socklen_t) addr_res->ai_addrlen;
+    freeaddrinfo(addr_res);
+
+    /* Generate canonical numeric URI so that it can be compared */
+    rc = getnameinfo((struct sockaddr *) ss, *salen_p, host, sizeof(host),
+        serv, sizeof(serv), NI_NUMERICHOST | NI_NUMERICSERV);
+    NA_CHECK_SUBSYS_ERROR(addr, rc != 0, error, ret, NA_ADDRNOTAVAIL,
+        "getnameinfo() failed (%s)", gai_strerror(rc));
+
+    rc = snprintf(uri, uri_size, "%s:%s", host, serv);
+    NA_CHECK_SUBSYS_ERROR(addr, rc < 0 || (size_t) rc >= uri_size, error, ret,
+        NA_OVERFLOW, "snprintf() failed or name truncated, rc: %d", rc);
+
+    return NA_SUCCESS;
+
+error:
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static na_return_t
+na_tcp_listen_open(struct na_tcp_class *na_tcp_class, const char *host_name,
+    const char *ip_subnet)
+{
+    struct sockaddr *sa = NULL;
+    struct sockaddr_storage ss;
+    socklen_t salen = 0;
+    char host[NI_MAXHOST], serv[NI_MAXSERV];
+    char *name = NULL, *port_str;
+    uint16_t port = 0;
+    int sock = -1, opt = 1;
+    na_return_t ret;
+    int rc;
+
+    /* Extract hostname : port */
+    if (host_name && strcmp(host_name, "") != 0) {
+        name = strdup(host_name);
+        NA_CHECK_SUBSYS_ERROR(cls, name == NULL, error, ret, NA_NOMEM,
+            "strdup() of host_name failed");
+        port_str = strrchr(name, ':');
+        if (port_str) {
+            *port_str++ = '\0';
+            port = (uint16_t) (strtoul(port_str, NULL, 10) & 0xffff);
+        }
+    }
+
+    if (name && strcmp(name, "") != 0 && strcmp(name, "0.0.0.0") != 0) {
+        /* Hostname or interface name */
+        ret = na_ip_check_interface(name, port, AF_UNSPEC, NULL, &sa, &salen);
+        NA_CHECK_SUBSYS_NA_ERROR(cls, error, ret, "Could not check interfaces");
+    } else {
+        char pref_anyip[NI_MAXHOST];
+        uint32_t subnet = 0, netmask = 0;
+
+        /* Try to use IP subnet */
+        if (ip_subnet) {
+            ret = na_ip_parse_subnet(ip_subnet, &subnet, &netmask);
+            NA_CHECK_SUBSYS_NA_ERROR(
+                cls, error, ret, "na_ip_parse_subnet() failed");
+        }
+        ret = na_ip_pref_addr(subnet, netmask, pref_anyip);
+        NA_CHECK_SUBSYS_NA_ERROR(cls, error, ret, "na_ip_pref_addr() failed");
+
+        ret = na_ip_check_interface(
+            pref_anyip, port, AF_INET, NULL, &sa, &salen);
+        NA_CHECK_SUBSYS_NA_ERROR(cls, error, ret, "Could not check interfaces");
+    }
+
+    sock = socket(sa->sa_family, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    NA_CHECK_SUBSYS_ERROR(cls, sock == -1, error, ret,
+        na_tcp_errno_to_na(errno), "socket() failed (%s)", strerror(errno));
+
+    rc = setsockopt(sock, SOL_SOCKET, SO_REUSEADDR, &opt, sizeof(opt));
+    NA_CHECK_SUBSYS_ERROR(cls, rc == -1, error, ret, na_tcp_errno_to_na(errno),
+        "setsockopt() failed (%s)", strerror(errno));
+
+    rc = bind(sock, sa, salen);
+    NA_CHECK_SUBSYS_ERROR(cls, rc == -1, error, ret, na_tcp_errno_to_na(errno),
+        "bind() failed (%s)", strerror(errno));
+
+    rc = listen(sock, NA_TCP_LISTEN_BACKLOG);
+    NA_CHECK_SUBSYS_ERROR(cls, rc == -1, error, ret, na_tcp_errno_to_na(errno),
+        "listen() failed (%s)", strerror(errno));
+
+    /* Retrieve port that was actually assigned */
+    salen = sizeof(ss);
+    rc = getsockname(sock, (struct sockaddr *) &ss, &salen);
+    NA_CHECK_SUBSYS_ERROR(cls, rc == -1, error, ret, na_tcp_errno_to_na(errno),
+        "getsockname() failed (%s)", strerror(errno));
+
+    rc = getnameinfo((struct sockaddr *) &ss, salen, host, sizeof(host), serv,
+        sizeof(serv), NI_NUMERICHOST | NI_NUMERICSERV);
+    NA_CHECK_SUBSYS_ERROR(cls, rc != 0, error, ret, NA_ADDRNOTAVAIL,
+        "getnameinfo() failed (%s)", gai_strerror(rc));
+
+    rc = snprintf(na_tcp_class->uri, sizeof(na_tcp_class->uri), "%s:%s", host,
+        serv);
+    NA_CHECK_SUBSYS_ERROR(cls,
+        rc < 0 || (size_t) rc >= sizeof(na_tcp_class->uri), error, ret,
+        NA_OVERFLOW, "snprintf() failed or name truncated, rc: %d", rc);
+
+    NA_LOG_SUBSYS_DEBUG(cls, "Listening on %s", na_tcp_class->uri);
+
+    na_tcp_class->listen_sock = sock;
+    free(sa);
+    free(name);
+
+    return NA_SUCCESS;
+
+error:
+    if (sock != -1)
+        close(sock);
+    free(sa);
+    free(name);
+
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static na_return_t
+na_tcp_sock_set_opts(
+    struct na_tcp_class NA_UNUSED *na_tcp_class, int sock, bool *zcopy)
+{
+    int opt = 1;
+    na_return_t ret;
+    int rc;
+
+    /* Headers and payloads are already coalesced by sendmsg() */
+    rc = setsockopt(sock, IPPROTO_TCP, TCP_NODELAY, &opt, sizeof(opt));
+    NA_CHECK_SUBSYS_ERROR(addr, rc == -1, error, ret,
+        na_tcp_errno_to_na(errno), "setsockopt() failed (%s)", strerror(errno));
+
+    *zcopy = false;
+#ifdef NA_TCP_HAS_ZCOPY
+    if (na_tcp_class->zcopy) {
+        rc = setsockopt(sock, SOL_SOCKET, SO_ZEROCOPY, &opt, sizeof(opt));
+        NA_CHECK_SUBSYS_WARNING(addr, rc == -1,
+            "Could not enable SO_ZEROCOPY (%s)", strerror(errno));
+        *zcopy = (rc == 0);
+    }
+#endif
+
+    return NA_SUCCESS;
+
+error:
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static struct na_tcp_addr *
+na_tcp_addr_alloc(struct na_tcp_class *na_tcp_class)
+{
+    struct na_tcp_addr *na_tcp_addr;
+
+    na_tcp_addr = (struct na_tcp_addr *) calloc(1, sizeof(*na_tcp_addr));
+    NA_CHECK_SUBSYS_ERROR_NORET(addr, na_tcp_addr == NULL, done,
+        "Could not allocate NA TCP addr");
+
+    HG_QUEUE_INIT(&na_tcp_addr->tx_queue);
+    hg_thread_mutex_init(&na_tcp_addr->tx_lock);
+    hg_thread_mutex_init(&na_tcp_addr->rx_lock);
+    hg_atomic_init32(&na_tcp_addr->refcount, 1);
+    hg_atomic_init32(&na_tcp_addr->status, 0);
+    na_tcp_addr->na_tcp_class = na_tcp_class;
+    na_tcp_addr->poll_type = NA_TCP_POLL_CONN;
+    na_tcp_addr->sock = -1;
+
+done:
+    return na_tcp_addr;
+}
+
+/*---------------------------------------------------------------------------*/
+static NA_INLINE void
+na_tcp_addr_ref_incr(struct na_tcp_addr *na_tcp_addr)
+{
+    hg_atomic_incr32(&na_tcp_addr->refcount);
+}
+
+/*---------------------------------------------------------------------------*/
+static void
+na_tcp_addr_ref_decr(struct na_tcp_addr *na_tcp_addr)
+{
+    struct na_tcp_tx *tx;
+
+    if (hg_atomic_decr32(&na_tcp_addr->refcount) > 0)
+        return;
+
+    NA_LOG_SUBSYS_DEBUG(addr, "Freeing addr (%p)", (void *) na_tcp_addr);
+
+    /* Remaining entries can only be internal */
+    while ((tx = HG_QUEUE_FIRST(&na_tcp_addr->tx_queue)) != NULL) {
+        HG_QUEUE_POP_HEAD(&na_tcp_addr->tx_queue, entry);
+        if (tx->op_id == NULL)
+            free(tx);
+    }
+    if (na_tcp_addr->sock != -1)
+        close(na_tcp_addr->sock);
+    free(na_tcp_addr->rx.tmp);
+    hg_thread_mutex_destroy(&na_tcp_addr->tx_lock);
+    hg_thread_mutex_destroy(&na_tcp_addr->rx_lock);
+    free(na_tcp_addr);
+}
+
+/*---------------------------------------------------------------------------*/
+static void
+na_tcp_addr_list_insert(
+    struct na_tcp_addr_list *addr_list, struct na_tcp_addr *na_tcp_addr)
+{
+    hg_thread_mutex_lock(&addr_list->lock);
+    if (!na_tcp_addr->listed) {
+        na_tcp_addr_ref_incr(na_tcp_addr);
+        HG_LIST_INSERT_HEAD(&addr_list->list, na_tcp_addr, entry);
+        na_tcp_addr->listed = true;
+    }
+    hg_thread_mutex_unlock(&addr_list->lock);
+}
+
+/*---------------------------------------------------------------------------*/
+static void
+na_tcp_addr_list_remove(
+    struct na_tcp_addr_list *addr_list, struct na_tcp_addr *na_tcp_addr)
+{
+    bool listed;
+
+    hg_thread_mutex_lock(&addr_list->lock);
+    listed = na_tcp_addr->listed;
+    if (listed) {
+        HG_LIST_REMOVE(na_tcp_addr, entry);
+        na_tcp_addr->listed = false;
+    }
+    hg_thread_mutex_unlock(&addr_list->lock);
+
+    if (listed)
+        na_tcp_addr_ref_decr(na_tcp_addr);
+}
+
+/*---------------------------------------------------------------------------*/
+static struct na_tcp_addr *
+na_tcp_addr_list_find(struct na_tcp_addr_list *addr_list, const char *uri)
+{
+    struct na_tcp_addr *na_tcp_addr;
+
+    hg_thread_mutex_lock(&addr_list->lock);
+    HG_LIST_FOREACH (na_tcp_addr, &addr_list->list, entry) {
+        if (strcmp(na_tcp_addr->uri, uri) == 0) {
+            na_tcp_addr_ref_incr(na_tcp_addr);
+            break;
+        }
+    }
+    hg_thread_mutex_unlock(&addr_list->lock);
+
+    return na_tcp_addr;
+}
+
+/*---------------------------------------------------------------------------*/
+static na_return_t
+na_tcp_addr_poll_add(struct na_tcp_addr *na_tcp_addr, bool pollout)
+{
+    struct hg_poll_event event = {
+        .events = HG_POLLIN | (pollout ? HG_POLLOUT : 0),
+        .data.ptr = &na_tcp_addr->poll_type};
+    na_return_t ret;
+    int rc;
+
+    rc = hg_poll_add(
+        na_tcp_addr->na_tcp_class->poll_set, na_tcp_addr->sock, &event);
+    NA_CHECK_SUBSYS_ERROR(addr, rc != HG_UTIL_SUCCESS, error, ret,
+        NA_PROTOCOL_ERROR, "hg_poll_add() failed");
+
+    return NA_SUCCESS;
+
+error:
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static na_return_t
+na_tcp_addr_connect(struct na_tcp_addr *na_tcp_addr)
+{
+    struct na_tcp_class *na_tcp_class = na_tcp_addr->na_tcp_class;
+    struct na_tcp_tx *hello = NULL;
+    bool zcopy = false;
+    int sock = -1;
+    na_return_t ret;
+    int rc;
+
+    NA_CHECK_SUBSYS_ERROR(addr, na_tcp_addr->salen == 0, error, ret,
+        NA_ADDRNOTAVAIL, "No listening address known for peer");
+
+    NA_LOG_SUBSYS_DEBUG(addr, "Connecting to %s", na_tcp_addr->uri);
+
+    sock = socket(na_tcp_addr->ss.ss_family, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    NA_CHECK_SUBSYS_ERROR(addr, sock == -1, error, ret,
+        na_tcp_errno_to_na(errno), "socket() failed (%s)", strerror(errno));
+
+    /* Connect synchronously, sockets are switched to non-blocking after */
+    do {
+        rc = connect(
+            sock, (struct sockaddr *) &na_tcp_addr->ss, na_tcp_addr->salen);
+    } while (rc == -1 && errno == EINTR);
+    NA_CHECK_SUBSYS_ERROR(addr, rc == -1, error, ret,
+        na_tcp_errno_to_na(errno), "connect() to %s failed (%s)",
+        na_tcp_addr->uri, strerror(errno));
+
+    rc = fcntl(sock, F_SETFL, fcntl(sock, F_GETFL) | O_NONBLOCK);
+    NA_CHECK_SUBSYS_ERROR(addr, rc == -1, error, ret,
+        na_tcp_errno_to_na(errno), "fcntl() failed (%s)", strerror(errno));
+
+    ret = na_tcp_sock_set_opts(na_tcp_class, sock, &zcopy);
+    NA_CHECK_SUBSYS_NA_ERROR(addr, error, ret, "Could not set sock options");
+
+    /* Let the peer know where we are listening so that it can use this
+     * connection for replies and reconnect if needed */
+    hello = na_tcp_tx_alloc(NA_TCP_MSG_HELLO, 0, 0, 0, na_tcp_class->uri,
+        strlen(na_tcp_class->uri));
+    NA_CHECK_SUBSYS_ERROR(addr, hello == NULL, error, ret, NA_NOMEM,
+        "Could not allocate hello msg");
+
+    na_tcp_addr->sock = sock;
+    hg_atomic_and32(&na_tcp_addr->status, ~NA_TCP_ADDR_DISCONNECTED);
+    hg_atomic_or32(&na_tcp_addr->status,
+        NA_TCP_ADDR_CONNECTED | (zcopy ? NA_TCP_ADDR_ZCOPY : 0));
+
+    /* Poll set holds a reference until disconnect */
+    na_tcp_addr_ref_incr(na_tcp_addr);
+    ret = na_tcp_addr_poll_add(na_tcp_addr, true);
+    if (ret != NA_SUCCESS) {
+        na_tcp_addr->sock = -1;
+        hg_atomic_and32(&na_tcp_addr->status, ~NA_TCP_ADDR_CONNECTED);
+        na_tcp_addr_ref_decr(na_tcp_addr);
+        goto error;
+    }
+    hg_atomic_or32(&na_tcp_addr->status, NA_TCP_ADDR_POLLOUT);
+
+    /* Hello is always the first msg sent, it is flushed by progress */
+    HG_QUEUE_PUSH_TAIL(&na_tcp_addr->tx_queue, hello, entry);
+
+    na_tcp_addr_list_insert(&na_tcp_class->addr_list, na_tcp_addr);
+
+    return NA_SUCCESS;
+
+error:
+    if (sock != -1)
+        close(sock);
+    free(hello);
+
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static void
+na_tcp_addr_disconnect(struct na_tcp_addr *na_tcp_addr)
+{
+    struct na_tcp_class *na_tcp_class = na_tcp_addr->na_tcp_class;
+    HG_QUEUE_HEAD(na_tcp_tx) tx_queue = HG_QUEUE_HEAD_INITIALIZER(tx_queue);
+    struct na_tcp_op_queue *rma_op_queue = &na_tcp_class->rma_op_queue;
+    struct na_tcp_op_id *na_tcp_op_id;
+    struct na_tcp_tx *tx;
+    int sock;
+
+    hg_thread_mutex_lock(&na_tcp_addr->tx_lock);
+    if (!(hg_atomic_get32(&na_tcp_addr->status) & NA_TCP_ADDR_CONNECTED)) {
+        hg_thread_mutex_unlock(&na_tcp_addr->tx_lock);
+        return;
+    }
+    NA_LOG_SUBSYS_DEBUG(addr, "Disconnecting from %s", na_tcp_addr->uri);
+
+    hg_atomic_and32(&na_tcp_addr->status,
+        ~(NA_TCP_ADDR_CONNECTED | NA_TCP_ADDR_POLLOUT | NA_TCP_ADDR_ZCOPY));
+    hg_atomic_or32(&na_tcp_addr->status, NA_TCP_ADDR_DISCONNECTED);
+    sock = na_tcp_addr->sock;
+    na_tcp_addr->sock = -1;
+    (void) hg_poll_remove(na_tcp_class->poll_set, sock);
+    close(sock);
+
+    /* Take pending tx */
+    while ((tx = HG_QUEUE_FIRST(&na_tcp_addr->tx_queue)) != NULL) {
+        HG_QUEUE_POP_HEAD(&na_tcp_addr->tx_queue, entry);
+        HG_QUEUE_PUSH_TAIL(&tx_queue, tx, entry);
+    }
+    hg_thread_mutex_unlock(&na_tcp_addr->tx_lock);
+
+    while ((tx = HG_QUEUE_FIRST(&tx_queue)) != NULL) {
+        HG_QUEUE_POP_HEAD(&tx_queue, entry);
+        na_tcp_tx_complete(na_tcp_class, tx, NA_HOSTUNREACH);
+    }
+
+    /* Reset rx state, message being received is lost */
+    hg_thread_mutex_lock(&na_tcp_addr->rx_lock);
+    if (na_tcp_addr->rx.op_id)
+        na_tcp_complete(na_tcp_addr->rx.op_id, NA_HOSTUNREACH);
+    free(na_tcp_addr->rx.tmp);
+    memset(&na_tcp_addr->rx, 0, sizeof(na_tcp_addr->rx));
+    hg_thread_mutex_unlock(&na_tcp_addr->rx_lock);
+
+    /* Fail RMA ops that are waiting for a reply from that peer */
+    do {
+        hg_thread_spin_lock(&rma_op_queue->lock);
+        HG_QUEUE_FOREACH (na_tcp_op_id, &rma_op_queue->queue, entry) {
+            if (na_tcp_op_id->addr == na_tcp_addr &&
+                !(hg_atomic_get32(&na_tcp_op_id->status) & NA_TCP_OP_TX)) {
+                HG_QUEUE_REMOVE(&rma_op_queue->queue, na_tcp_op_id,
+                    na_tcp_op_id, entry);
+                hg_atomic_and32(&na_tcp_op_id->status, ~NA_TCP_OP_QUEUED);
+                break;
+            }
+        }
+        hg_thread_spin_unlock(&rma_op_queue->lock);
+        if (na_tcp_op_id)
+            na_tcp_complete(na_tcp_op_id, NA_HOSTUNREACH);
+    } while (na_tcp_op_id != NULL);
+
+    na_tcp_addr_list_remove(&na_tcp_class->addr_list, na_tcp_addr);
+
+    /* Release poll set reference */
+    na_tcp_addr_ref_decr(na_tcp_addr);
+}
+
+/*---------------------------------------------------------------------------*/
+static na_return_t
+na_tcp_progress_accept(struct na_tcp_class *na_tcp_class, bool *progressed)
+{
+    na_return_t ret = NA_SUCCESS;
+
+    for (;;) {
+        struct na_tcp_addr *na_tcp_addr;
+        bool zcopy = false;
+        int sock;
+
+        sock = accept4(na_tcp_class->listen_sock, NULL, NULL,
+            SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (sock == -1) {
+            if (errno == EAGAIN || errno == EWOULDBLOCK)
+                break;
+            if (errno == EINTR || errno == ECONNABORTED)
+                continue;
+            NA_GOTO_SUBSYS_ERROR(addr, done, ret, na_tcp_errno_to_na(errno),
+                "accept4() failed (%s)", strerror(errno));
+        }
+
+        ret = na_tcp_sock_set_opts(na_tcp_class, sock, &zcopy);
+        if (ret != NA_SUCCESS) {
+            close(sock);
+            NA_GOTO_SUBSYS_ERROR(
+                addr, done, ret, ret, "Could not set sock options");
+        }
+
+        na_tcp_addr = na_tcp_addr_alloc(na_tcp_class);
+        if (na_tcp_addr == NULL) {
+            close(sock);
+            NA_GOTO_SUBSYS_ERROR(
+                addr, done, ret, NA_NOMEM, "Could not allocate addr");
+        }
+        na_tcp_addr->sock = sock;
+        hg_atomic_set32(&na_tcp_addr->status,
+            NA_TCP_ADDR_CONNECTED | (zcopy ? NA_TCP_ADDR_ZCOPY : 0));
+
+        /* Initial reference is owned by the poll set */
+        ret = na_tcp_addr_poll_add(na_tcp_addr, false);
+        if (ret != NA_SUCCESS) {
+            na_tcp_addr_ref_decr(na_tcp_addr);
+            NA_GOTO_SUBSYS_ERROR(
+                addr, done, ret, ret, "Could not add sock to poll set");
+        }
+        na_tcp_addr_list_insert(&na_tcp_class->addr_list, na_tcp_addr);
+
+        NA_LOG_SUBSYS_DEBUG(
+            addr, "Accepted new connection (%p)", (void *) na_tcp_addr);
+        *progressed = true;
+    }
+
+done:
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static struct na_tcp_tx *
+na_tcp_tx_alloc(uint8_t type, uint32_t tag, uint64_t addr, uint64_t cookie,
+    const void *payload, size_t size)
+{
+    struct na_tcp_tx *tx;
+
+    /* Small payloads are copied next to the entry */
+    tx = (struct na_tcp_tx *) malloc(sizeof(*tx) + size);
+    NA_CHECK_SUBSYS_ERROR_NORET(
+        msg, tx == NULL, done, "Could not allocate tx entry");
+
+    tx->hdr = (struct na_tcp_msg_hdr){.addr = addr,
+        .cookie = cookie,
+        .size = size,
+        .rma_size = 0,
+        .tag = tag,
+        .type = type};
+    tx->iov[0] =
+        (struct iovec){.iov_base = &tx->hdr, .iov_len = sizeof(tx->hdr)};
+    tx->iov[1] = (struct iovec){.iov_base = tx + 1, .iov_len = size};
+    if (size > 0)
+        memcpy(tx + 1, payload, size);
+    tx->op_id = NULL;
+    tx->len = sizeof(tx->hdr) + size;
+    tx->sent = 0;
+
+done:
+    return tx;
+}
+
+/*---------------------------------------------------------------------------*/
+static na_return_t
+na_tcp_tx_send(struct na_tcp_addr *na_tcp_addr, struct na_tcp_tx *tx)
+{
+    struct iovec iov[2];
+    struct msghdr msg;
+    int flags = MSG_NOSIGNAL;
+    na_return_t ret;
+
+    while (tx->sent < tx->len) {
+        size_t skip = tx->sent;
+        ssize_t nsent;
+        int i, iovcnt = 0;
+
+        /* Skip what was already sent */
+        for (i = 0; i < 2; i++) {
+            if (skip >= tx->iov[i].iov_len) {
+                skip -= tx->iov[i].iov_len;
+                continue;
+            }
+            iov[iovcnt].iov_base = (char *) tx->iov[i].iov_base + skip;
+            iov[iovcnt].iov_len = tx->iov[i].iov_len - skip;
+            iovcnt++;
+            skip = 0;
+        }
+
+        memset(&msg, 0, sizeof(msg));
+        msg.msg_iov = iov;
+        msg.msg_iovlen = (size_t) iovcnt;
+
+#ifdef NA_TCP_HAS_ZCOPY
+        /* Pages of large RMA payloads are pinned instead of copied. Target
+         * memory is not modified until the PUT ack / GET resp is processed,
+         * which cannot happen before the data has been acknowledged by the
+         * peer, notifications are therefore only drained. */
+        if ((hg_atomic_get32(&na_tcp_addr->status) & NA_TCP_ADDR_ZCOPY) &&
+            tx->iov[1].iov_len >= NA_TCP_ZCOPY_THRESHOLD)
+            flags |= MSG_ZEROCOPY;
+        else
+            flags &= ~MSG_ZEROCOPY;
+#endif
+
+        nsent = sendmsg(na_tcp_addr->sock, &msg, flags);
+        if (nsent < 0) {
+            if (errno == EINTR)
+                continue;
+            if (errno == EAGAIN || errno == EWOULDBLOCK)
+                return NA_AGAIN;
+#ifdef NA_TCP_HAS_ZCOPY
+            if (errno == ENOBUFS && (flags & MSG_ZEROCOPY)) {
+                /* Out of optmem, fall back to regular copy */
+                hg_atomic_and32(&na_tcp_addr->status, ~NA_TCP_ADDR_ZCOPY);
+                continue;
+            }
+#endif
+            NA_GOTO_SUBSYS_ERROR(msg, error, ret, na_tcp_errno_to_na(errno),
+                "sendmsg() to %s failed (%s)", na_tcp_addr->uri,
+                strerror(errno));
+        }
+        tx->sent += (size_t) nsent;
+    }
+
+    return NA_SUCCESS;
+
+error:
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static na_return_t
+na_tcp_tx_post(
+    struct na_tcp_addr *na_tcp_addr, struct na_tcp_tx *tx, bool *done_p)
+{
+    na_return_t ret;
+
+    *done_p = false;
+
+    hg_thread_mutex_lock(&na_tcp_addr->tx_lock);
+
+    if (!(hg_atomic_get32(&na_tcp_addr->status) & NA_TCP_ADDR_CONNECTED)) {
+        ret = na_tcp_addr_connect(na_tcp_addr);
+        NA_CHECK_SUBSYS_NA_ERROR(
+            addr, unlock, ret, "Could not connect to %s", na_tcp_addr->uri);
+    }
+
+    /* Preserve ordering, only send directly if nothing is pending */
+    if (HG_QUEUE_IS_EMPTY(&na_tcp_addr->tx_queue)) {
+        ret = na_tcp_tx_send(na_tcp_addr, tx);
+        if (ret == NA_SUCCESS) {
+            *done_p = true;
+            goto unlock;
+        } else if (ret != NA_AGAIN)
+            NA_GOTO_SUBSYS_ERROR(msg, unlock, ret, ret, "Could not send msg");
+    }
+
+    HG_QUEUE_PUSH_TAIL(&na_tcp_addr->tx_queue, tx, entry);
+    if (tx->op_id)
+        hg_atomic_or32(&tx->op_id->status, NA_TCP_OP_TX);
+
+    /* Wait for socket to become writable */
+    if (!(hg_atomic_get32(&na_tcp_addr->status) & NA_TCP_ADDR_POLLOUT)) {
+        (void) hg_poll_remove(
+            na_tcp_addr->na_tcp_class->poll_set, na_tcp_addr->sock);
+        ret = na_tcp_addr_poll_add(na_tcp_addr, true);
+        NA_CHECK_SUBSYS_NA_ERROR(
+            addr, unlock, ret, "Could not wait for sock to be writable");
+        hg_atomic_or32(&na_tcp_addr->status, NA_TCP_ADDR_POLLOUT);
+    }
+    ret = NA_SUCCESS;
+
+unlock:
+    hg_thread_mutex_unlock(&na_tcp_addr->tx_lock);
+
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static void
+na_tcp_tx_complete(
+    struct na_tcp_class *na_tcp_class, struct na_tcp_tx *tx, na_return_t ret)
+{
+    struct na_tcp_op_id *na_tcp_op_id = tx->op_id;
+    struct na_tcp_op_queue *rma_op_queue = &na_tcp_class->rma_op_queue;
+    bool complete = true;
+
+    if (na_tcp_op_id == NULL) {
+        free(tx);
+        return;
+    }
+
+    switch (na_tcp_op_id->completion_data.callback_info.type) {
+        case NA_CB_SEND_UNEXPECTED:
+        case NA_CB_SEND_EXPECTED:
+            hg_atomic_and32(&na_tcp_op_id->status, ~NA_TCP_OP_TX);
+            break;
+        case NA_CB_PUT:
+        case NA_CB_GET:
+            /* RMA ops complete once the peer replies, unless canceled or
+             * failed while sending */
+            hg_thread_spin_lock(&rma_op_queue->lock);
+            hg_atomic_and32(&na_tcp_op_id->status, ~NA_TCP_OP_TX);
+            if (ret == NA_SUCCESS && !(hg_atomic_get32(&na_tcp_op_id->status) &
+                                         NA_TCP_OP_CANCELED))
+                complete = false;
+            else if (hg_atomic_get32(&na_tcp_op_id->status) &
+                     NA_TCP_OP_QUEUED) {
+                HG_QUEUE_REMOVE(&rma_op_queue->queue, na_tcp_op_id,
+                    na_tcp_op_id, entry);
+                hg_atomic_and32(&na_tcp_op_id->status, ~NA_TCP_OP_QUEUED);
+            } else
+                complete = false;
+            hg_thread_spin_unlock(&rma_op_queue->lock);
+            if (ret == NA_SUCCESS)
+                ret = NA_CANCELED;
+            break;
+        default:
+            break;
+    }
+
+    if (complete)
+        na_tcp_complete(na_tcp_op_id, ret);
+}
+
+/*---------------------------------------------------------------------------*/
+static na_return_t
+na_tcp_progress_tx(struct na_tcp_addr *na_tcp_addr, bool *progressed)
+{
+    struct na_tcp_class *na_tcp_class = na_tcp_addr->na_tcp_class;
+    HG_QUEUE_HEAD(na_tcp_tx) tx_queue = HG_QUEUE_HEAD_INITIALIZER(tx_queue);
+    struct na_tcp_tx *tx;
+    na_return_t ret = NA_SUCCESS;
+
+    hg_thread_mutex_lock(&na_tcp_addr->tx_lock);
+    if (!(hg_atomic_get32(&na_tcp_addr->status) & NA_TCP_ADDR_CONNECTED)) {
+        hg_thread_mutex_unlock(&na_tcp_addr->tx_lock);
+        return NA_SUCCESS;
+    }
+
+    while ((tx = HG_QUEUE_FIRST(&na_tcp_addr->tx_queue)) != NULL) {
+        ret = na_tcp_tx_send(na_tcp_addr, tx);
+        if (ret != NA_SUCCESS)
+            break;
+        HG_QUEUE_POP_HEAD(&na_tcp_addr->tx_queue, entry);
+        HG_QUEUE_PUSH_TAIL(&tx_queue, tx, entry);
+    }
+
+    /* Stop polling for writes once everything is sent */
+    if (ret == NA_SUCCESS &&
+        (hg_atomic_get32(&na_tcp_addr->status) & NA_TCP_ADDR_POLLOUT)) {
+        (void) hg_poll_remove(na_tcp_class->poll_set, na_tcp_addr->sock);
+        ret = na_tcp_addr_poll_add(na_tcp_addr, false);
+        if (ret == NA_SUCCESS)
+            hg_atomic_and32(&na_tcp_addr->status, ~NA_TCP_ADDR_POLLOUT);
+    } else if (ret == NA_AGAIN)
+        ret = NA_SUCCESS;
+    hg_thread_mutex_unlock(&na_tcp_addr->tx_lock);
+
+    while ((tx = HG_QUEUE_FIRST(&tx_queue)) != NULL) {
+        HG_QUEUE_POP_HEAD(&tx_queue, entry);
+        na_tcp_tx_complete(na_tcp_class, tx, NA_SUCCESS);
+        *progressed = true;
+    }
+
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static na_return_t
+na_tcp_progress_rx(struct na_tcp_addr *na_tcp_addr, bool *progressed)
+{
+    struct na_tcp_rx *rx = &na_tcp_addr->rx;
+    na_return_t ret = NA_SUCCESS;
+
+    /* Another thread is already receiving */
+    if (hg_thread_mutex_try_lock(&na_tcp_addr->rx_lock) != HG_UTIL_SUCCESS)
+        return NA_SUCCESS;
+
+    while (na_tcp_addr->sock != -1) {
+        struct iovec iov[2];
+        struct msghdr msg;
+        size_t remaining;
+        ssize_t nrecv;
+
+        memset(&msg, 0, sizeof(msg));
+        msg.msg_iov = iov;
+        if (rx->hdr_off < sizeof(rx->hdr)) {
+            /* Header */
+            iov[0].iov_base = (char *) &rx->hdr + rx->hdr_off;
+            iov[0].iov_len = sizeof(rx->hdr) - rx->hdr_off;
+            msg.msg_iovlen = 1;
+            remaining = iov[0].iov_len;
+        } else {
+            /* Payload, followed by next header if it fits */
+            remaining = rx->hdr.size - rx->off;
+            if (rx->buf) {
+                iov[0].iov_base = rx->buf + rx->off;
+                iov[0].iov_len = remaining;
+            } else {
+                iov[0].iov_base = na_tcp_addr->na_tcp_class->discard;
+                iov[0].iov_len = MIN(remaining, NA_TCP_DISCARD_SIZE);
+            }
+            msg.msg_iovlen = 1;
+            if (iov[0].iov_len == remaining) {
+                iov[1].iov_base = &rx->next;
+                iov[1].iov_len = sizeof(rx->next);
+                msg.msg_iovlen = 2;
+            }
+        }
+
+        nrecv = recvmsg(na_tcp_addr->sock, &msg, 0);
+        if (nrecv < 0) {
+            if (errno == EINTR)
+                continue;
+            if (errno == EAGAIN || errno == EWOULDBLOCK)
+                break;
+            NA_LOG_SUBSYS_WARNING(addr, "recvmsg() from %s failed (%s)",
+                na_tcp_addr->uri, strerror(errno));
+            goto disconnect;
+        } else if (nrecv == 0) {
+            NA_LOG_SUBSYS_DEBUG(
+                addr, "Connection closed by peer (%s)", na_tcp_addr->uri);
+            goto disconnect;
+        }
+
+        if (rx->hdr_off < sizeof(rx->hdr)) {
+            rx->hdr_off += (size_t) nrecv;
+            if (rx->hdr_off < sizeof(rx->hdr))
+                continue;
+            ret = na_tcp_rx_start(na_tcp_addr);
+            if (ret != NA_SUCCESS)
+                goto protocol_error;
+        } else {
+            size_t next_off = 0;
+
+            if ((size_t) nrecv > remaining)
+                next_off = (size_t) nrecv - remaining;
+            rx->off += (size_t) nrecv - next_off;
+            if (rx->off < rx->hdr.size)
+                continue;
+            ret = na_tcp_rx_complete(na_tcp_addr);
+            if (ret != NA_SUCCESS)
+                goto protocol_error;
+
+            /* Consume read-ahead header */
+            if (next_off > 0) {
+                memcpy(&rx->hdr, &rx->next, next_off);
+                rx->hdr_off = next_off;
+                if (rx->hdr_off == sizeof(rx->hdr)) {
+                    ret = na_tcp_rx_start(na_tcp_addr);
+                    if (ret != NA_SUCCESS)
+                        goto protocol_error;
+                }
+            }
+        }
+        *progressed = true;
+    }
+    hg_thread_mutex_unlock(&na_tcp_addr->rx_lock);
+
+    return NA_SUCCESS;
+
+protocol_error:
+    NA_LOG_SUBSYS_ERROR(addr, "Protocol error on connection with %s (%s)",
+        na_tcp_addr->uri, NA_Error_to_string(ret));
+
+disconnect:
+    hg_thread_mutex_unlock(&na_tcp_addr->rx_lock);
+    na_tcp_addr_disconnect(na_tcp_addr);
+    *progressed = true;
+
+    return NA_SUCCESS;
+}
+
+#ifdef NA_TCP_HAS_ZCOPY
+/*---------------------------------------------------------------------------*/
+static na_return_t
+na_tcp_progress_errqueue(struct na_tcp_addr *na_tcp_addr)
+{
+    char control[CMSG_SPACE(sizeof(struct sock_extended_err))];
+
+    for (;;) {
+        struct msghdr msg;
+        struct cmsghdr *cmsg;
+        ssize_t rc;
+
+        memset(&msg, 0, sizeof(msg));
+        msg.msg_control = control;
+        msg.msg_controllen = sizeof(control);
+
+        rc = recvmsg(na_tcp_addr->sock, &msg, MSG_ERRQUEUE);
+        if (rc < 0)
+            break;
+
+        for (cmsg = CMSG_FIRSTHDR(&msg); cmsg != NULL;
+             cmsg = CMSG_NXTHDR(&msg, cmsg)) {
+            const struct sock_extended_err *serr =
+                (const struct sock_extended_err *) CMSG_DATA(cmsg);
+
+            /* Anything else than a zero-copy notification is an error */
+            if (serr->ee_origin != SO_EE_ORIGIN_ZEROCOPY)
+                return na_tcp_errno_to_na((int) serr->ee_errno);
+        }
+    }
+
+    return NA_SUCCESS;
+}
+#endif
+
+/*---------------------------------------------------------------------------*/
+static na_return_t
+na_tcp_rx_start(struct na_tcp_addr *na_tcp_addr)
+{
+    struct na_tcp_class *na_tcp_class = na_tcp_addr->na_tcp_class;
+    struct na_tcp_rx *rx = &na_tcp_addr->rx;
+    struct na_tcp_op_id *na_tcp_op_id = NULL;
+    na_return_t ret;
+
+    rx->op_id = NULL;
+    rx->buf = NULL;
+    rx->off = 0;
+    rx->ret = NA_SUCCESS;
+
+    switch (rx->hdr.type) {
+        case NA_TCP_MSG_HELLO:
+            NA_CHECK_SUBSYS_ERROR(addr, rx->hdr.size >= NA_TCP_MAX_URI, error,
+                ret, NA_PROTOCOL_ERROR, "Invalid hello size (%" PRIu64 ")",
+                rx->hdr.size);
+            rx->buf = na_tcp_addr->uri;
+            break;
+
+        case NA_TCP_MSG_UNEXPECTED: {
+            struct na_tcp_op_queue *unexpected_op_queue =
+                &na_tcp_class->unexpected_op_queue;
+
+            NA_CHECK_SUBSYS_ERROR(msg,
+                rx->hdr.size > na_tcp_class->unexpected_size_max, error, ret,
+                NA_PROTOCOL_ERROR, "Invalid unexpected size (%" PRIu64 ")",
+                rx->hdr.size);
+
+            hg_thread_spin_lock(&unexpected_op_queue->lock);
+            na_tcp_op_id = HG_QUEUE_FIRST(&unexpected_op_queue->queue);
+            if (na_tcp_op_id) {
+                HG_QUEUE_POP_HEAD(&unexpected_op_queue->queue, entry);
+                hg_atomic_and32(&na_tcp_op_id->status, ~NA_TCP_OP_QUEUED);
+            }
+            hg_thread_spin_unlock(&unexpected_op_queue->lock);
+
+            if (na_tcp_op_id) {
+                rx->op_id = na_tcp_op_id;
+                if (rx->hdr.size <= na_tcp_op_id->info.msg.buf_size)
+                    rx->buf = na_tcp_op_id->info.msg.buf.ptr;
+                else
+                    rx->ret = NA_MSGSIZE;
+            } else if (rx->hdr.size > 0) {
+                /* Keep it until a recv is posted */
+                rx->tmp = malloc(rx->hdr.size);
+                NA_CHECK_SUBSYS_ERROR(msg, rx->tmp == NULL, error, ret,
+                    NA_NOMEM, "Could not allocate unexpected buffer");
+                rx->buf = rx->tmp;
+            }
+        } break;
+
+        case NA_TCP_MSG_EXPECTED: {
+            struct na_tcp_op_queue *expected_op_queue =
+                &na_tcp_class->expected_op_queue;
+
+            NA_CHECK_SUBSYS_ERROR(msg,
+                rx->hdr.size > na_tcp_class->expected_size_max, error, ret,
+                NA_PROTOCOL_ERROR, "Invalid expected size (%" PRIu64 ")",
+                rx->hdr.size);
+
+            hg_thread_spin_lock(&expected_op_queue->lock);
+            HG_QUEUE_FOREACH (na_tcp_op_id, &expected_op_queue->queue, entry) {
+                if (na_tcp_op_id->addr == na_tcp_addr &&
+                    na_tcp_op_id->info.msg.tag == rx->hdr.tag) {
+                    HG_QUEUE_REMOVE(&expected_op_queue->queue, na_tcp_op_id,
+                        na_tcp_op_id, entry);
+                    hg_atomic_and32(&na_tcp_op_id->status, ~NA_TCP_OP_QUEUED);
+                    break;
+                }
+            }
+            hg_thread_spin_unlock(&expected_op_queue->lock);
+
+            if (na_tcp_op_id) {
+                rx->op_id = na_tcp_op_id;
+                if (rx->hdr.size <= na_tcp_op_id->info.msg.buf_size)
+                    rx->buf = na_tcp_op_id->info.msg.buf.ptr;
+                else
+                    rx->ret = NA_MSGSIZE;
+            } else
+                NA_LOG_SUBSYS_WARNING(msg,
+                    "Ignoring expected message from %s with tag %" PRIu32
+                    " that was not pre-posted",
+                    na_tcp_addr->uri, rx->hdr.tag);
+        } break;
+
+        case NA_TCP_MSG_PUT:
+            if (na_tcp_mem_check(&na_tcp_class->mem_list, rx->hdr.addr,
+                    rx->hdr.size, NA_MEM_WRITE_ONLY))
+                rx->buf = (char *) rx->hdr.addr;
+            else
+                rx->ret = NA_ACCESS;
+            break;
+
+        case NA_TCP_MSG_PUT_ACK:
+            NA_CHECK_SUBSYS_ERROR(rma, rx->hdr.size != 0, error, ret,
+                NA_PROTOCOL_ERROR, "Invalid put ack");
+            na_tcp_op_id =
+                na_tcp_rma_op_pop(&na_tcp_class->rma_op_queue, rx->hdr.cookie);
+            if (na_tcp_op_id)
+                na_tcp_complete(na_tcp_op_id, (na_return_t) rx->hdr.tag);
+            break;
+
+        case NA_TCP_MSG_GET_REQ: {
+            struct na_tcp_tx *tx;
+            bool done = false;
+
+            NA_CHECK_SUBSYS_ERROR(rma, rx->hdr.size != 0, error, ret,
+                NA_PROTOCOL_ERROR, "Invalid get request");
+
+            tx = na_tcp_tx_alloc(
+                NA_TCP_MSG_GET_RESP, NA_SUCCESS, 0, rx->hdr.cookie, NULL, 0);
+            NA_CHECK_SUBSYS_ERROR(rma, tx == NULL, error, ret, NA_NOMEM,
+                "Could not allocate get response");
+
+            /* Payload is sent directly from target memory */
+            if (na_tcp_mem_check(&na_tcp_class->mem_list, rx->hdr.addr,
+                    rx->hdr.rma_size, NA_MEM_READ_ONLY)) {
+                tx->hdr.size = rx->hdr.rma_size;
+                tx->iov[1].iov_base = (void *) rx->hdr.addr;
+                tx->iov[1].iov_len = rx->hdr.rma_size;
+                tx->len += rx->hdr.rma_size;
+            } else
+                tx->hdr.tag = (uint32_t) NA_ACCESS;
+
+            ret = na_tcp_tx_post(na_tcp_addr, tx, &done);
+            if (ret != NA_SUCCESS) {
+                free(tx);
+                NA_GOTO_SUBSYS_ERROR(
+                    rma, error, ret, ret, "Could not post get response");
+            }
+            if (done)
+                free(tx);
+        } break;
+
+        case NA_TCP_MSG_GET_RESP:
+            na_tcp_op_id =
+                na_tcp_rma_op_pop(&na_tcp_class->rma_op_queue, rx->hdr.cookie);
+            if (na_tcp_op_id == NULL)
+                break; /* Canceled */
+            rx->op_id = na_tcp_op_id;
+            rx->ret = (na_return_t) rx->hdr.tag;
+            if (rx->ret == NA_SUCCESS) {
+                if (rx->hdr.size == na_tcp_op_id->info.rma.length)
+                    rx->buf = na_tcp_op_id->info.rma.local_buf;
+                else
+                    rx->ret = NA_PROTOCOL_ERROR;
+            }
+            break;
+
+        default:
+            NA_GOTO_SUBSYS_ERROR(msg, error, ret, NA_PROTOCOL_ERROR,
+                "Unknown msg type (%" PRIu8 ")", rx->hdr.type);
+    }
+
+    /* Messages without payload are processed immediately */
+    if (rx->hdr.size == 0)
+        return na_tcp_rx_complete(na_tcp_addr);
+
+    return NA_SUCCESS;
+
+error:
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static na_return_t
+na_tcp_rx_complete(struct na_tcp_addr *na_tcp_addr)
+{
+    struct na_tcp_class *na_tcp_class = na_tcp_addr->na_tcp_class;
+    struct na_tcp_rx *rx = &na_tcp_addr->rx;
+    struct na_tcp_op_id *na_tcp_op_id = rx->op_id;
+    na_return_t ret = NA_SUCCESS;
+
+    switch (rx->hdr.type) {
+        case NA_TCP_MSG_HELLO: {
+            char uri[NA_TCP_MAX_URI];
+
+            na_tcp_addr->uri[rx->hdr.size] = '\0';
+            NA_LOG_SUBSYS_DEBUG(addr, "Connection (%p) is from %s",
+                (void *) na_tcp_addr, na_tcp_addr->uri);
+
+            /* Keep listening address to reconnect if needed */
+            if (na_tcp_resolve(na_tcp_addr->uri, uri, sizeof(uri),
+                    &na_tcp_addr->ss, &na_tcp_addr->salen) != NA_SUCCESS)
+                na_tcp_addr->salen = 0;
+        } break;
+
+        case NA_TCP_MSG_UNEXPECTED:
+            if (na_tcp_op_id) {
+                na_tcp_op_id->completion_data.callback_info.info
+                    .recv_unexpected = (struct na_cb_info_recv_unexpected){
+                    .tag = (na_tag_t) rx->hdr.tag,
+                    .actual_buf_size = (size_t) rx->hdr.size,
+                    .source = (na_addr_t *) na_tcp_addr};
+                na_tcp_addr_ref_incr(na_tcp_addr);
+                na_tcp_complete(na_tcp_op_id, rx->ret);
+            } else {
+                struct na_tcp_unexpected_msg_queue *unexpected_msg_queue =
+                    &na_tcp_class->unexpected_msg_queue;
+                struct na_tcp_unexpected_info *na_tcp_unexpected_info;
+
+                na_tcp_unexpected_info =
+                    (struct na_tcp_unexpected_info *) malloc(
+                        sizeof(*na_tcp_unexpected_info));
+                NA_CHECK_SUBSYS_ERROR(msg, na_tcp_unexpected_info == NULL,
+                    done, ret, NA_NOMEM,
+                    "Could not allocate unexpected info");
+
+                na_tcp_unexpected_info->na_tcp_addr = na_tcp_addr;
+                na_tcp_addr_ref_incr(na_tcp_addr);
+                na_tcp_unexpected_info->buf = rx->tmp;
+                na_tcp_unexpected_info->buf_size = (size_t) rx->hdr.size;
+                na_tcp_unexpected_info->tag = (na_tag_t) rx->hdr.tag;
+                rx->tmp = NULL;
+
+                hg_thread_spin_lock(&unexpected_msg_queue->lock);
+                HG_QUEUE_PUSH_TAIL(&unexpected_msg_queue->queue,
+                    na_tcp_unexpected_info, entry);
+                hg_thread_spin_unlock(&unexpected_msg_queue->lock);
+            }
+            break;
+
+        case NA_TCP_MSG_EXPECTED:
+            if (na_tcp_op_id) {
+                na_tcp_op_id->completion_data.callback_info.info.recv_expected
+                    .actual_buf_size = (size_t) rx->hdr.size;
+                na_tcp_complete(na_tcp_op_id, rx->ret);
+            }
+            break;
+
+        case NA_TCP_MSG_PUT: {
+            struct na_tcp_tx *tx;
+            bool done = false;
+
+            tx = na_tcp_tx_alloc(NA_TCP_MSG_PUT_ACK, (uint32_t) rx->ret, 0,
+                rx->hdr.cookie, NULL, 0);
+            NA_CHECK_SUBSYS_ERROR(rma, tx == NULL, done, ret, NA_NOMEM,
+                "Could not allocate put ack");
+
+            ret = na_tcp_tx_post(na_tcp_addr, tx, &done);
+            if (ret != NA_SUCCESS) {
+                free(tx);
+                NA_GOTO_SUBSYS_ERROR(
+                    rma, done, ret, ret, "Could not post put ack");
+            }
+            if (done)
+                free(tx);
+        } break;
+
+        case NA_TCP_MSG_GET_RESP:
+            if (na_tcp_op_id)
+                na_tcp_complete(na_tcp_op_id, rx->ret);
+            break;
+
+        default:
+            break;
+    }
+
+done:
+    /* Read-ahead header is preserved */
+    free(rx->tmp);
+    rx->tmp = NULL;
+    rx->op_id = NULL;
+    rx->buf = NULL;
+    rx->hdr_off = 0;
+    rx->off = 0;
+    rx->ret = NA_SUCCESS;
+
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static bool
+na_tcp_mem_check(struct na_tcp_mem_list *mem_list, uint64_t addr, size_t len,
+    uint8_t access)
+{
+    struct na_tcp_mem_handle *na_tcp_mem_handle;
+    bool found = false;
+
+    hg_thread_rwlock_rdlock(&mem_list->lock);
+    HG_LIST_FOREACH (na_tcp_mem_handle, &mem_list->list, entry) {
+        const struct na_tcp_mem_desc_info *info = &na_tcp_mem_handle->info;
+
+        if ((info->flags & access) && addr >= info->base &&
+            len <= info->len && addr - info->base <= info->len - len) {
+            found = true;
+            break;
+        }
+    }
+    hg_thread_rwlock_release_rdlock(&mem_list->lock);
+
+    return found;
+}
+
+/*---------------------------------------------------------------------------*/
+static struct na_tcp_op_id *
+na_tcp_rma_op_pop(struct na_tcp_op_queue *rma_op_queue, uint64_t cookie)
+{
+    struct na_tcp_op_id *na_tcp_op_id;
+
+    hg_thread_spin_lock(&rma_op_queue->lock);
+    HG_QUEUE_FOREACH (na_tcp_op_id, &rma_op_queue->queue, entry) {
+        if ((uint64_t) (uintptr_t) na_tcp_op_id == cookie) {
+            HG_QUEUE_REMOVE(
+                &rma_op_queue->queue, na_tcp_op_id, na_tcp_op_id, entry);
+            hg_atomic_and32(&na_tcp_op_id->status, ~NA_TCP_OP_QUEUED);
+            break;
+        }
+    }
+    hg_thread_spin_unlock(&rma_op_queue->lock);
+
+    return na_tcp_op_id;
+}
+
+/*---------------------------------------------------------------------------*/
+static na_return_t
+na_tcp_msg_send(struct na_tcp_class *na_tcp_class, na_context_t *context,
+    na_cb_type_t cb_type, na_cb_t callback, void *arg, const void *buf,
+    size_t buf_size, struct na_tcp_addr *na_tcp_addr, uint8_t type,
+    na_tag_t tag, struct na_tcp_op_id *na_tcp_op_id)
+{
+    struct na_tcp_tx *tx;
+    bool done = false;
+    na_return_t ret;
+
+    NA_CHECK_SUBSYS_ERROR(msg,
+        buf_size > ((type == NA_TCP_MSG_UNEXPECTED)
+                           ? na_tcp_class->unexpected_size_max
+                           : na_tcp_class->expected_size_max),
+        error, ret, NA_OVERFLOW, "Exceeds msg size, %zu", buf_size);
+
+    /* Check op_id */
+    NA_CHECK_SUBSYS_ERROR(op, na_tcp_op_id == NULL, error, ret,
+        NA_INVALID_ARG, "Invalid operation ID");
+    NA_CHECK_SUBSYS_ERROR(op,
+        !(hg_atomic_get32(&na_tcp_op_id->status) & NA_TCP_OP_COMPLETED), error,
+        ret, NA_BUSY, "Attempting to use OP ID that was not completed (%s)",
+        na_cb_type_to_string(na_tcp_op_id->completion_data.callback_info.type));
+
+    NA_TCP_OP_RESET(
+        na_tcp_op_id, context, cb_type, callback, arg, na_tcp_addr);
+
+    /* Header and payload are sent with a single sendmsg() */
+    na_tcp_op_id->info.msg = (struct na_tcp_msg_info){
+        .buf.const_ptr = buf, .buf_size = buf_size, .tag = tag};
+    tx = &na_tcp_op_id->tx;
+    tx->hdr = (struct na_tcp_msg_hdr){
+        .size = buf_size, .tag = (uint32_t) tag, .type = type};
+    tx->iov[0] =
+        (struct iovec){.iov_base = &tx->hdr, .iov_len = sizeof(tx->hdr)};
+    tx->iov[1] = (struct iovec){
+        .iov_base = na_tcp_op_id->info.msg.buf.ptr, .iov_len = buf_size};
+    tx->op_id = na_tcp_op_id;
+    tx->len = sizeof(tx->hdr) + buf_size;
+    tx->sent = 0;
+
+    ret = na_tcp_tx_post(na_tcp_addr, tx, &done);
+    NA_CHECK_SUBSYS_NA_ERROR(msg, release, ret, "Could not post msg");
+
+    if (done) {
+        na_tcp_complete(na_tcp_op_id, NA_SUCCESS);
+        na_tcp_complete_signal(na_tcp_class);
+    }
+
+    return NA_SUCCESS;
+
+release:
+    NA_TCP_OP_RELEASE(na_tcp_op_id);
+
+error:
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static na_return_t
+na_tcp_rma(struct na_tcp_class *na_tcp_class, na_context_t *context,
+    na_cb_type_t cb_type, na_cb_t callback, void *arg,
+    struct na_tcp_mem_handle *local_mem_handle, na_offset_t local_offset,
+    struct na_tcp_mem_handle *remote_mem_handle, na_offset_t remote_offset,
+    size_t length, struct na_tcp_addr *na_tcp_addr,
+    struct na_tcp_op_id *na_tcp_op_id)
+{
+    struct na_tcp_op_queue *rma_op_queue = &na_tcp_class->rma_op_queue;
+    char *local_buf = (char *) local_mem_handle->info.base + local_offset;
+    struct na_tcp_tx *tx;
+    bool done = false;
+    na_return_t ret;
+
+    NA_CHECK_SUBSYS_ERROR(rma,
+        local_offset + length > local_mem_handle->info.len ||
+            remote_offset + length > remote_mem_handle->info.len,
+        error, ret, NA_OVERFLOW, "Exceeds memory handle size");
+
+    /* Check op_id */
+    NA_CHECK_SUBSYS_ERROR(op, na_tcp_op_id == NULL, error, ret,
+        NA_INVALID_ARG, "Invalid operation ID");
+    NA_CHECK_SUBSYS_ERROR(op,
+        !(hg_atomic_get32(&na_tcp_op_id->status) & NA_TCP_OP_COMPLETED), error,
+        ret, NA_BUSY, "Attempting to use OP ID that was not completed (%s)",
+        na_cb_type_to_string(na_tcp_op_id->completion_data.callback_info.type));
+
+    NA_TCP_OP_RESET(
+        na_tcp_op_id, context, cb_type, callback, arg, na_tcp_addr);
+
+    na_tcp_op_id->info.rma =
+        (struct na_tcp_rma_info){.local_buf = local_buf, .length = length};
+
+    /* Puts push the data along with the request, gets only send the request
+     * and data comes back with the response */
+    tx = &na_tcp_op_id->tx;
+    tx->hdr = (struct na_tcp_msg_hdr){
+        .addr = remote_mem_handle->info.base + remote_offset,
+        .cookie = (uint64_t) (uintptr_t) na_tcp_op_id,
+        .size = (cb_type == NA_CB_PUT) ? length : 0,
+        .rma_size = length,
+        .type = (cb_type == NA_CB_PUT) ? NA_TCP_MSG_PUT : NA_TCP_MSG_GET_REQ};
+    tx->iov[0] =
+        (struct iovec){.iov_base = &tx->hdr, .iov_len = sizeof(tx->hdr)};
+    tx->iov[1] = (struct iovec){
+        .iov_base = local_buf, .iov_len = (size_t) tx->hdr.size};
+    tx->op_id = na_tcp_op_id;
+    tx->len = sizeof(tx->hdr) + (size_t) tx->hdr.size;
+    tx->sent = 0;
+
+    /* Queue before posting since the reply may arrive at any time */
+    hg_thread_spin_lock(&rma_op_queue->lock);
+    HG_QUEUE_PUSH_TAIL(&rma_op_queue->queue, na_tcp_op_id, entry);
+    hg_atomic_or32(&na_tcp_op_id->status, NA_TCP_OP_QUEUED);
+    hg_thread_spin_unlock(&rma_op_queue->lock);
+
+    ret = na_tcp_tx_post(na_tcp_addr, tx, &done);
+    if (ret != NA_SUCCESS) {
+        hg_thread_spin_lock(&rma_op_queue->lock);
+        HG_QUEUE_REMOVE(
+            &rma_op_queue->queue, na_tcp_op_id, na_tcp_op_id, entry);
+        hg_atomic_and32(&na_tcp_op_id->status, ~NA_TCP_OP_QUEUED);
+        hg_thread_spin_unlock(&rma_op_queue->lock);
+        NA_GOTO_SUBSYS_ERROR(rma, release, ret, ret, "Could not post RMA");
+    }
+
+    return NA_SUCCESS;
+
+release:
+    NA_TCP_OP_RELEASE(na_tcp_op_id);
+
+error:
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static NA_INLINE void
+na_tcp_complete(struct na_tcp_op_id *na_tcp_op_id, na_return_t cb_ret)
+{
+    /* Mark op id as completed before checking for cancelation */
+    hg_atomic_or32(&na_tcp_op_id->status, NA_TCP_OP_COMPLETED);
+
+    /* Set callback ret */
+    na_tcp_op_id->completion_data.callback_info.ret = cb_ret;
+
+    /* Add OP to NA completion queue */
+    na_cb_completion_add(na_tcp_op_id->context, &na_tcp_op_id->completion_data);
+}
+
+/*---------------------------------------------------------------------------*/
+static NA_INLINE void
+na_tcp_complete_signal(struct na_tcp_class *na_tcp_class)
+{
+    if (na_tcp_class->notify > 0) {
+        int rc = hg_event_set(na_tcp_class->notify);
+        NA_CHECK_SUBSYS_ERROR_DONE(
+            op, rc != HG_UTIL_SUCCESS, "Could not signal completion");
+    }
+}
+
+/*---------------------------------------------------------------------------*/
+static NA_INLINE void
+na_tcp_release(void *arg)
+{
+    struct na_tcp_op_id *na_tcp_op_id = (struct na_tcp_op_id *) arg;
+
+    NA_CHECK_SUBSYS_WARNING(op,
+        na_tcp_op_id &&
+            (!(hg_atomic_get32(&na_tcp_op_id->status) & NA_TCP_OP_COMPLETED)),
+        "Releasing resources from an uncompleted operation");
+
+    if (na_tcp_op_id->addr) {
+        na_tcp_addr_ref_decr(na_tcp_op_id->addr);
+        na_tcp_op_id->addr = NULL;
+    }
+}
+
+/********************/
+/* Plugin callbacks */
+/********************/
+
+static bool
+na_tcp_check_protocol(const char *protocol_name)
+{
+    bool accept = false;
+
+    if (!strcmp(NA_TCP_PROTOCOL, protocol_name))
+        accept = true;
+
+    return accept;
+}
+
+/*---------------------------------------------------------------------------*/
+static na_return_t
+na_tcp_initialize(
+    na_class_t *na_class, const struct na_info *na_info, bool NA_UNUSED listen)
+{
+    struct na_init_info na_init_info = NA_INIT_INFO_INITIALIZER;
+    struct na_tcp_class *na_tcp_class = NULL;
+    const char *zcopy_env;
+    na_return_t ret;
+    int rc;
+
+    /* Get init info and overwrite defaults */
+    if (na_info->na_init_info)
+        na_init_info = *na_info->na_init_info;
+
+    /* Initialize private data */
+    na_tcp_class = (struct na_tcp_class *) calloc(1, sizeof(*na_tcp_class));
+    NA_CHECK_SUBSYS_ERROR(cls, na_tcp_class == NULL, error, ret, NA_NOMEM,
+        "Could not allocate TCP private class");
+    na_tcp_class->listen_sock = -1;
+    na_tcp_class->notify = -1;
+    na_tcp_class->listen_poll_type = NA_TCP_POLL_LISTEN;
+    na_tcp_class->notify_poll_type = NA_TCP_POLL_NOTIFY;
+    na_tcp_class->no_block = na_init_info.progress_mode & NA_NO_BLOCK;
+    na_tcp_class->unexpected_size_max = na_init_info.max_unexpected_size
+                                            ? na_init_info.max_unexpected_size
+                                            : NA_TCP_UNEXPECTED_SIZE;
+    na_tcp_class->expected_size_max = na_init_info.max_expected_size
+                                          ? na_init_info.max_expected_size
+                                          : NA_TCP_EXPECTED_SIZE;
+
+    /* Zero-copy sends are only worth it for large transfers over a NIC */
+    zcopy_env = getenv("NA_TCP_ZCOPY");
+    na_tcp_class->zcopy = zcopy_env && (atoi(zcopy_env) > 0);
+
+    HG_LIST_INIT(&na_tcp_class->addr_list.list);
+    hg_thread_mutex_init(&na_tcp_class->addr_list.lock);
+    HG_LIST_INIT(&na_tcp_class->mem_list.list);
+    hg_thread_rwlock_init(&na_tcp_class->mem_list.lock);
+    HG_QUEUE_INIT(&na_tcp_class->unexpected_msg_queue.queue);
+    hg_thread_spin_init(&na_tcp_class->unexpected_msg_queue.lock);
+    HG_QUEUE_INIT(&na_tcp_class->unexpected_op_queue.queue);
+    hg_thread_spin_init(&na_tcp_class->unexpected_op_queue.lock);
+    HG_QUEUE_INIT(&na_tcp_class->expected_op_queue.queue);
+    hg_thread_spin_init(&na_tcp_class->expected_op_queue.lock);
+    HG_QUEUE_INIT(&na_tcp_class->rma_op_queue.queue);
+    hg_thread_spin_init(&na_tcp_class->rma_op_queue.lock);
+
+    /* Sockets are always polled, the poll set fd is only exposed if blocking
+     * progress is allowed */
+    na_tcp_class->poll_set = hg_poll_create();
+    NA_CHECK_SUBSYS_ERROR(cls, na_tcp_class->poll_set == NULL, error, ret,
+        NA_NOMEM, "Could not create poll set");
+
+    /* Always listen so that peers can connect back */
+    ret = na_tcp_listen_open(
+        na_tcp_class, na_info->host_name, na_init_info.ip_subnet);
+    NA_CHECK_SUBSYS_NA_ERROR(cls, error, ret, "Could not open listening sock");
+
+    rc = hg_poll_add(na_tcp_class->poll_set, na_tcp_class->listen_sock,
+        &(struct hg_poll_event){
+            .events = HG_POLLIN, .data.ptr = &na_tcp_class->listen_poll_type});
+    NA_CHECK_SUBSYS_ERROR(cls, rc != HG_UTIL_SUCCESS, error, ret,
+        NA_PROTOCOL_ERROR, "hg_poll_add() failed");
+
+    if (!na_tcp_class->no_block) {
+        na_tcp_class->notify = hg_event_create();
+        NA_CHECK_SUBSYS_ERROR(cls, na_tcp_class->notify == -1, error, ret,
+            NA_PROTOCOL_ERROR, "hg_event_create() failed");
+
+        rc = hg_poll_add(na_tcp_class->poll_set, na_tcp_class->notify,
+            &(struct hg_poll_event){.events = HG_POLLIN,
+                .data.ptr = &na_tcp_class->notify_poll_type});
+        NA_CHECK_SUBSYS_ERROR(cls, rc != HG_UTIL_SUCCESS, error, ret,
+            NA_PROTOCOL_ERROR, "hg_poll_add() failed");
+    }
+
+    na_class->plugin_class = (void *) na_tcp_class;
+
+    return NA_SUCCESS;
+
+error:
+    if (na_tcp_class) {
+        if (na_tcp_class->notify != -1)
+            hg_event_destroy(na_tcp_class->notify);
+        if (na_tcp_class->listen_sock != -1)
+            close(na_tcp_class->listen_sock);
+        if (na_tcp_class->poll_set)
+            hg_poll_destroy(na_tcp_class->poll_set);
+        hg_thread_mutex_destroy(&na_tcp_class->addr_list.lock);
+        hg_thread_rwlock_destroy(&na_tcp_class->mem_list.lock);
+        hg_thread_spin_destroy(&na_tcp_class->unexpected_msg_queue.lock);
+        hg_thread_spin_destroy(&na_tcp_class->unexpected_op_queue.lock);
+        hg_thread_spin_destroy(&na_tcp_class->expected_op_queue.lock);
+        hg_thread_spin_destroy(&na_tcp_class->rma_op_queue.lock);
+        free(na_tcp_class);
+    }
+
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static na_return_t
+na_tcp_finalize(na_class_t *na_class)
+{
+    struct na_tcp_class *na_tcp_class = NA_TCP_CLASS(na_class);
+    struct na_tcp_unexpected_info *na_tcp_unexpected_info;
+    struct na_tcp_addr *na_tcp_addr;
+    na_return_t ret = NA_SUCCESS;
+    bool empty;
+
+    if (na_tcp_class == NULL)
+        goto done;
+
+    /* Check that unexpected op queue is empty */
+    empty = HG_QUEUE_IS_EMPTY(&na_tcp_class->unexpected_op_queue.queue);
+    NA_CHECK_SUBSYS_ERROR(cls, empty == false, done, ret, NA_BUSY,
+        "Unexpected op queue should be empty");
+
+    /* Check that expected op queue is empty */
+    empty = HG_QUEUE_IS_EMPTY(&na_tcp_class->expected_op_queue.queue);
+    NA_CHECK_SUBSYS_ERROR(cls, empty == false, done, ret, NA_BUSY,
+        "Expected op queue should be empty");
+
+    /* Check that RMA op queue is empty */
+    empty = HG_QUEUE_IS_EMPTY(&na_tcp_class->rma_op_queue.queue);
+    NA_CHECK_SUBSYS_ERROR(cls, empty == false, done, ret, NA_BUSY,
+        "RMA op queue should be empty");
+
+    /* Drop unexpected msgs that were never received */
+    while ((na_tcp_unexpected_info = HG_QUEUE_FIRST(
+                &na_tcp_class->unexpected_msg_queue.queue)) != NULL) {
+        HG_QUEUE_POP_HEAD(&na_tcp_class->unexpected_msg_queue.queue, entry);
+        na_tcp_addr_ref_decr(na_tcp_unexpected_info->na_tcp_addr);
+        free(na_tcp_unexpected_info->buf);
+        free(na_tcp_unexpected_info);
+    }
+
+    /* Close remaining connections */
+    while ((na_tcp_addr = HG_LIST_FIRST(&na_tcp_class->addr_list.list)) !=
+           NULL) {
+        na_tcp_addr_ref_incr(na_tcp_addr);
+        na_tcp_addr_disconnect(na_tcp_addr);
+        na_tcp_addr_list_remove(&na_tcp_class->addr_list, na_tcp_addr);
+        na_tcp_addr_ref_decr(na_tcp_addr);
+    }
+
+    if (na_tcp_class->notify != -1) {
+        hg_poll_remove(na_tcp_class->poll_set, na_tcp_class->notify);
+        hg_event_destroy(na_tcp_class->notify);
+    }
+    hg_poll_remove(na_tcp_class->poll_set, na_tcp_class->listen_sock);
+    close(na_tcp_class->listen_sock);
+    hg_poll_destroy(na_tcp_class->poll_set);
+
+    hg_thread_mutex_destroy(&na_tcp_class->addr_list.lock);
+    hg_thread_rwlock_destroy(&na_tcp_class->mem_list.lock);
+    hg_thread_spin_destroy(&na_tcp_class->unexpected_msg_queue.lock);
+    hg_thread_spin_destroy(&na_tcp_class->unexpected_op_queue.lock);
+    hg_thread_spin_destroy(&na_tcp_class->expected_op_queue.lock);
+    hg_thread_spin_destroy(&na_tcp_class->rma_op_queue.lock);
+
+    free(na_tcp_class);
+    na_class->plugin_class = NULL;
+
+done:
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static na_return_t
+na_tcp_context_create(
+    na_class_t NA_UNUSED *na_class, void **context_p, uint8_t NA_UNUSED id)
+{
+    na_return_t ret = NA_SUCCESS;
+
+    *context_p = malloc(sizeof(struct na_tcp_context));
+    NA_CHECK_SUBSYS_ERROR(ctx, *context_p == NULL, done, ret, NA_NOMEM,
+        "Could not allocate TCP private context");
+
+done:
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static na_return_t
+na_tcp_context_destroy(na_class_t NA_UNUSED *na_class, void *context)
+{
+    free(context);
+
+    return NA_SUCCESS;
+}
+
+/*---------------------------------------------------------------------------*/
+static na_op_id_t *
+na_tcp_op_create(na_class_t *na_class, unsigned long NA_UNUSED flags)
+{
+    struct na_tcp_op_id *na_tcp_op_id = NULL;
+
+    na_tcp_op_id = (struct na_tcp_op_id *) malloc(sizeof(struct na_tcp_op_id));
+    NA_CHECK_SUBSYS_ERROR_NORET(op, na_tcp_op_id == NULL, done,
+        "Could not allocate NA TCP operation ID");
+    memset(na_tcp_op_id, 0, sizeof(struct na_tcp_op_id));
+
+    na_tcp_op_id->na_class = na_class;
+
+    /* Completed by default */
+    hg_atomic_init32(&na_tcp_op_id->status, NA_TCP_OP_COMPLETED);
+
+    /* Set op ID release callbacks */
+    na_tcp_op_id->completion_data.plugin_callback = na_tcp_release;
+    na_tcp_op_id->completion_data.plugin_callback_args = na_tcp_op_id;
+
+done:
+    return (na_op_id_t *) na_tcp_op_id;
+}
+
+/*---------------------------------------------------------------------------*/
+static void
+na_tcp_op_destroy(na_class_t NA_UNUSED *na_class, na_op_id_t *op_id)
+{
+    struct na_tcp_op_id *na_tcp_op_id = (struct na_tcp_op_id *) op_id;
+
+    NA_CHECK_SUBSYS_WARNING(op,
+        !(hg_atomic_get32(&na_tcp_op_id->status) & NA_TCP_OP_COMPLETED),
+        "Attempting to use OP ID that was not completed (%s)",
+        na_cb_type_to_string(na_tcp_op_id->completion_data.callback_info.type));
+
+    free(na_tcp_op_id);
+}
+
+/*---------------------------------------------------------------------------*/
+static na_return_t
+na_tcp_addr_lookup(na_class_t *na_class, const char *name, na_addr_t **addr_p)
+{
+    struct na_tcp_class *na_tcp_class = NA_TCP_CLASS(na_class);
+    struct na_tcp_addr *na_tcp_addr = NULL;
+    struct sockaddr_storage ss;
+    socklen_t salen;
+    char uri[NA_TCP_MAX_URI];
+    na_return_t ret;
+
+    ret = na_tcp_resolve(name, uri, sizeof(uri), &ss, &salen);
+    NA_CHECK_SUBSYS_NA_ERROR(addr, error, ret, "Could not resolve %s", name);
+
+    NA_LOG_SUBSYS_DEBUG(addr, "Lookup addr for %s", uri);
+
+    /* Re-use existing connection if any */
+    na_tcp_addr = na_tcp_addr_list_find(&na_tcp_class->addr_list, uri);
+    if (na_tcp_addr == NULL) {
+        na_tcp_addr = na_tcp_addr_alloc(na_tcp_class);
+        NA_CHECK_SUBSYS_ERROR(addr, na_tcp_addr == NULL, error, ret, NA_NOMEM,
+            "Could not allocate addr");
+        na_tcp_addr->ss = ss;
+        na_tcp_addr->salen = salen;
+        strcpy(na_tcp_addr->uri, uri);
+
+        /* Connection is established on first use */
+        na_tcp_addr_list_insert(&na_tcp_class->addr_list, na_tcp_addr);
+    }
+
+    *addr_p = (na_addr_t *) na_tcp_addr;
+
+    return NA_SUCCESS;
+
+error:
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static void
+na_tcp_addr_free(na_class_t NA_UNUSED *na_class, na_addr_t *addr)
+{
+    na_tcp_addr_ref_decr((struct na_tcp_addr *) addr);
+}
+
+/*---------------------------------------------------------------------------*/
+static na_return_t
+na_tcp_addr_self(na_class_t *na_class, na_addr_t **addr_p)
+{
+    return na_tcp_addr_lookup(na_class, NA_TCP_CLASS(na_class)->uri, addr_p);
+}
+
+/*---------------------------------------------------------------------------*/
+static na_return_t
+na_tcp_addr_dup(
+    na_class_t NA_UNUSED *na_class, na_addr_t *addr, na_addr_t **new_addr_p)
+{
+    na_tcp_addr_ref_incr((struct na_tcp_addr *) addr);
+    *new_addr_p = addr;
+
+    return NA_SUCCESS;
+}
+
+/*---------------------------------------------------------------------------*/
+static bool
+na_tcp_addr_cmp(
+    na_class_t NA_UNUSED *na_class, na_addr_t *addr1, na_addr_t *addr2)
+{
+    return (addr1 == addr2) || (strcmp(((struct na_tcp_addr *) addr1)->uri,
+                                    ((struct na_tcp_addr *) addr2)->uri) == 0);
+}
+
+/*---------------------------------------------------------------------------*/
+static NA_INLINE bool
+na_tcp_addr_is_self(na_class_t *na_class, na_addr_t *addr)
+{
+    return strcmp(NA_TCP_CLASS(na_class)->uri,
+               ((struct na_tcp_addr *) addr)->uri) == 0;
+}
+
+/*---------------------------------------------------------------------------*/
+static na_return_t
+na_tcp_addr_to_string(na_class_t NA_UNUSED *na_class, char *buf,
+    size_t *buf_size, na_addr_t *addr)
+{
+    struct na_tcp_addr *na_tcp_addr = (struct na_tcp_addr *) addr;
+    size_t string_len;
+    char addr_string[NA_TCP_MAX_URI + sizeof(NA_TCP_PROTOCOL "://")];
+    na_return_t ret = NA_SUCCESS;
+    int rc;
+
+    rc = snprintf(addr_string, sizeof(addr_string), NA_TCP_PROTOCOL "://%s",
+        na_tcp_addr->uri);
+    NA_CHECK_SUBSYS_ERROR(addr, rc < 0 || (size_t) rc >= sizeof(addr_string),
+        done, ret, NA_OVERFLOW, "snprintf() failed or name truncated, rc: %d",
+        rc);
+
+    string_len = strlen(addr_string);
+    if (buf) {
+        NA_CHECK_SUBSYS_ERROR(addr, string_len >= *buf_size, done, ret,
+            NA_OVERFLOW, "Buffer size (%zu) too small to copy addr",
+            *buf_size);
+        strcpy(buf, addr_string);
+    }
+    *buf_size = string_len + 1;
+
+done:
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static NA_INLINE size_t
+na_tcp_addr_get_serialize_size(na_class_t NA_UNUSED *na_class, na_addr_t *addr)
+{
+    return sizeof(uint64_t) + strlen(((struct na_tcp_addr *) addr)->uri);
+}
+
+/*---------------------------------------------------------------------------*/
+static na_return_t
+na_tcp_addr_serialize(
+    na_class_t NA_UNUSED *na_class, void *buf, size_t buf_size, na_addr_t *addr)
+{
+    struct na_tcp_addr *na_tcp_addr = (struct na_tcp_addr *) addr;
+    char *buf_ptr = (char *) buf;
+    size_t buf_size_left = buf_size;
+    uint64_t len = strlen(na_tcp_addr->uri);
+    na_return_t ret = NA_SUCCESS;
+
+    NA_ENCODE(done, ret, buf_ptr, buf_size_left, &len, uint64_t);
+    NA_ENCODE_ARRAY(
+        done, ret, buf_ptr, buf_size_left, na_tcp_addr->uri, char, len);
+
+done:
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static na_return_t
+na_tcp_addr_deserialize(
+    na_class_t *na_class, na_addr_t **addr_p, const void *buf, size_t buf_size)
+{
+    const char *buf_ptr = (const char *) buf;
+    size_t buf_size_left = buf_size;
+    char uri[NA_TCP_MAX_URI];
+    uint64_t len = 0;
+    na_return_t ret = NA_SUCCESS;
+
+    NA_DECODE(done, ret, buf_ptr, buf_size_left, &len, uint64_t);
+    NA_CHECK_SUBSYS_ERROR(addr, len >= sizeof(uri), done, ret, NA_OVERFLOW,
+        "Serialized address is too long (%" PRIu64 ")", len);
+    NA_DECODE_ARRAY(done, ret, buf_ptr, buf_size_left, uri, char, len);
+    uri[len] = '\0';
+
+    ret = na_tcp_addr_lookup(na_class, uri, addr_p);
+
+done:
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static NA_INLINE size_t
+na_tcp_msg_get_max_unexpected_size(const na_class_t *na_class)
+{
+    return NA_TCP_CLASS(na_class)->unexpected_size_max;
+}
+
+/*---------------------------------------------------------------------------*/
+static NA_INLINE size_t
+na_tcp_msg_get_max_expected_size(const na_class_t *na_class)
+{
+    return NA_TCP_CLASS(na_class)->expected_size_max;
+}
+
+/*---------------------------------------------------------------------------*/
+static NA_INLINE na_tag_t
+na_tcp_msg_get_max_tag(const na_class_t NA_UNUSED *na_class)
+{
+    return NA_TCP_MAX_TAG;
+}
+
+/*---------------------------------------------------------------------------*/
+static na_return_t
+na_tcp_msg_send_unexpected(na_class_t *na_class, na_context_t *context,
+    na_cb_t callback, void *arg, const void *buf, size_t buf_size,
+    void NA_UNUSED *plugin_data, na_addr_t *dest_addr,
+    uint8_t NA_UNUSED dest_id, na_tag_t tag, na_op_id_t *op_id)
+{
+    return na_tcp_msg_send(NA_TCP_CLASS(na_class), context,
+        NA_CB_SEND_UNEXPECTED, callback, arg, buf, buf_size,
+        (struct na_tcp_addr *) dest_addr, NA_TCP_MSG_UNEXPECTED, tag,
+        (struct na_tcp_op_id *) op_id);
+}
+
+/*---------------------------------------------------------------------------*/
+static na_return_t
+na_tcp_msg_recv_unexpected(na_class_t *na_class, na_context_t *context,
+    na_cb_t callback, void *arg, void *buf, size_t buf_size,
+    void NA_UNUSED *plugin_data, na_op_id_t *op_id)
+{
+    struct na_tcp_unexpected_msg_queue *unexpected_msg_queue =
+        &NA_TCP_CLASS(na_class)->unexpected_msg_queue;
+    struct na_tcp_unexpected_info *na_tcp_unexpected_info;
+    struct na_tcp_op_id *na_tcp_op_id = (struct na_tcp_op_id *) op_id;
+    na_return_t ret;
+
+    NA_CHECK_SUBSYS_ERROR(msg,
+        buf_size > NA_TCP_CLASS(na_class)->unexpected_size_max, error, ret,
+        NA_OVERFLOW, "Exceeds unexpected size, %zu", buf_size);
+
+    /* Check op_id */
+    NA_CHECK_SUBSYS_ERROR(op, na_tcp_op_id == NULL, error, ret,
+        NA_INVALID_ARG, "Invalid operation ID");
+    NA_CHECK_SUBSYS_ERROR(op,
+        !(hg_atomic_get32(&na_tcp_op_id->status) & NA_TCP_OP_COMPLETED), error,
+        ret, NA_BUSY, "Attempting to use OP ID that was not completed (%s)",
+        na_cb_type_to_string(na_tcp_op_id->completion_data.callback_info.type));
+
+    NA_TCP_OP_RESET_UNEXPECTED_RECV(na_tcp_op_id, context, callback, arg);
+
+    /* We assume buf remains valid (safe because we pre-allocate buffers) */
+    na_tcp_op_id->info.msg =
+        (struct na_tcp_msg_info){.buf.ptr = buf, .buf_size = buf_size};
+
+    /* Look for an unexpected message already received */
+    hg_thread_spin_lock(&unexpected_msg_queue->lock);
+    na_tcp_unexpected_info = HG_QUEUE_FIRST(&unexpected_msg_queue->queue);
+    HG_QUEUE_POP_HEAD(&unexpected_msg_queue->queue, entry);
+    hg_thread_spin_unlock(&unexpected_msg_queue->lock);
+    if (unlikely(na_tcp_unexpected_info)) {
+        na_return_t cb_ret = NA_SUCCESS;
+
+        /* Fill unexpected info (addr ref is transferred) */
+        na_tcp_op_id->completion_data.callback_info.info.recv_unexpected =
+            (struct na_cb_info_recv_unexpected){
+                .tag = na_tcp_unexpected_info->tag,
+                .actual_buf_size = na_tcp_unexpected_info->buf_size,
+                .source = (na_addr_t *) na_tcp_unexpected_info->na_tcp_addr};
+
+        if (na_tcp_unexpected_info->buf_size > buf_size)
+            cb_ret = NA_MSGSIZE;
+        else if (na_tcp_unexpected_info->buf_size > 0)
+            memcpy(buf, na_tcp_unexpected_info->buf,
+                na_tcp_unexpected_info->buf_size);
+        free(na_tcp_unexpected_info->buf);
+        free(na_tcp_unexpected_info);
+        na_tcp_complete(na_tcp_op_id, cb_ret);
+
+        /* Notify local completion */
+        na_tcp_complete_signal(NA_TCP_CLASS(na_class));
+    } else {
+        struct na_tcp_op_queue *unexpected_op_queue =
+            &NA_TCP_CLASS(na_class)->unexpected_op_queue;
+
+        /* Nothing has been received yet so add op_id to progress queue */
+        hg_thread_spin_lock(&unexpected_op_queue->lock);
+        HG_QUEUE_PUSH_TAIL(&unexpected_op_queue->queue, na_tcp_op_id, entry);
+        hg_atomic_or32(&na_tcp_op_id->status, NA_TCP_OP_QUEUED);
+        hg_thread_spin_unlock(&unexpected_op_queue->lock);
+    }
+
+    return NA_SUCCESS;
+
+error:
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static na_return_t
+na_tcp_msg_send_expected(na_class_t *na_class, na_context_t *context,
+    na_cb_t callback, void *arg, const void *buf, size_t buf_size,
+    void NA_UNUSED *plugin_data, na_addr_t *dest_addr,
+    uint8_t NA_UNUSED dest_id, na_tag_t tag, na_op_id_t *op_id)
+{
+    return na_tcp_msg_send(NA_TCP_CLASS(na_class), context, NA_CB_SEND_EXPECTED,
+        callback, arg, buf, buf_size, (struct na_tcp_addr *) dest_addr,
+        NA_TCP_MSG_EXPECTED, tag, (struct na_tcp_op_id *) op_id);
+}
+
+/*---------------------------------------------------------------------------*/
+static na_return_t
+na_tcp_msg_recv_expected(na_class_t *na_class, na_context_t *context,
+    na_cb_t callback, void *arg, void *buf, size_t buf_size,
+    void NA_UNUSED *plugin_data, na_addr_t *source_addr,
+    uint8_t NA_UNUSED source_id, na_tag_t tag, na_op_id_t *op_id)
+{
+    struct na_tcp_op_queue *expected_op_queue =
+        &NA_TCP_CLASS(na_class)->expected_op_queue;
+    struct na_tcp_op_id *na_tcp_op_id = (struct na_tcp_op_id *) op_id;
+    struct na_tcp_addr *na_tcp_addr = (struct na_tcp_addr *) source_addr;
+    na_return_t ret;
+
+    NA_CHECK_SUBSYS_ERROR(msg,
+        buf_size > NA_TCP_CLASS(na_class)->expected_size_max, error, ret,
+        NA_OVERFLOW, "Exceeds expected size, %zu", buf_size);
+
+    /* Check op_id */
+    NA_CHECK_SUBSYS_ERROR(op, na_tcp_op_id == NULL, error, ret,
+        NA_INVALID_ARG, "Invalid operation ID");
+    NA_CHECK_SUBSYS_ERROR(op,
+        !(hg_atomic_get32(&na_tcp_op_id->status) & NA_TCP_OP_COMPLETED), error,
+        ret, NA_BUSY, "Attempting to use OP ID that was not completed (%s)",
+        na_cb_type_to_string(na_tcp_op_id->completion_data.callback_info.type));
+
+    NA_TCP_OP_RESET(
+        na_tcp_op_id, context, NA_CB_RECV_EXPECTED, callback, arg, na_tcp_addr);
+
+    na_tcp_op_id->info.msg = (struct na_tcp_msg_info){
+        .buf.ptr = buf, .buf_size = buf_size, .tag = tag};
+
+    /* Expected messages must always be pre-posted, simply add op_id to queue */
+    hg_thread_spin_lock(&expected_op_queue->lock);
+    HG_QUEUE_PUSH_TAIL(&expected_op_queue->queue, na_tcp_op_id, entry);
+    hg_atomic_or32(&na_tcp_op_id->status, NA_TCP_OP_QUEUED);
+    hg_thread_spin_unlock(&expected_op_queue->lock);
+
+    return NA_SUCCESS;
+
+error:
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static na_return_t
+na_tcp_mem_handle_create(na_class_t *na_class, void *buf, size_t buf_size,
+    unsigned long flags, na_mem_handle_t **mem_handle_p)
+{
+    struct na_tcp_mem_list *mem_list = &NA_TCP_CLASS(na_class)->mem_list;
+    struct na_tcp_mem_handle *na_tcp_mem_handle = NULL;
+    na_return_t ret = NA_SUCCESS;
+
+    na_tcp_mem_handle =
+        (struct na_tcp_mem_handle *) malloc(sizeof(struct na_tcp_mem_handle));
+    NA_CHECK_SUBSYS_ERROR(mem, na_tcp_mem_handle == NULL, done, ret, NA_NOMEM,
+        "Could not allocate NA TCP memory handle");
+
+    na_tcp_mem_handle->info = (struct na_tcp_mem_desc_info){
+        .base = (uint64_t) (uintptr_t) buf,
+        .len = (uint64_t) buf_size,
+        .flags = (uint8_t) (flags & 0xff)};
+    na_tcp_mem_handle->local = true;
+
+    /* Expose region to remote RMA requests */
+    hg_thread_rwlock_wrlock(&mem_list->lock);
+    HG_LIST_INSERT_HEAD(&mem_list->list, na_tcp_mem_handle, entry);
+    hg_thread_rwlock_release_wrlock(&mem_list->lock);
+
+    *mem_handle_p = (na_mem_handle_t *) na_tcp_mem_handle;
+
+done:
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static void
+na_tcp_mem_handle_free(na_class_t *na_class, na_mem_handle_t *mem_handle)
+{
+    struct na_tcp_mem_list *mem_list = &NA_TCP_CLASS(na_class)->mem_list;
+    struct na_tcp_mem_handle *na_tcp_mem_handle =
+        (struct na_tcp_mem_handle *) mem_handle;
+
+    if (na_tcp_mem_handle->local) {
+        hg_thread_rwlock_wrlock(&mem_list->lock);
+        HG_LIST_REMOVE(na_tcp_mem_handle, entry);
+        hg_thread_rwlock_release_wrlock(&mem_list->lock);
+    }
+    free(na_tcp_mem_handle);
+}
+
+/*---------------------------------------------------------------------------*/
+static size_t
+na_tcp_mem_handle_get_max_segments(const na_class_t NA_UNUSED *na_class)
+{
+    return 1;
+}
+
+/*---------------------------------------------------------------------------*/
+static NA_INLINE size_t
+na_tcp_mem_handle_get_serialize_size(
+    na_class_t NA_UNUSED *na_class, na_mem_handle_t NA_UNUSED *mem_handle)
+{
+    return sizeof(struct na_tcp_mem_desc_info);
+}
+
+/*---------------------------------------------------------------------------*/
+static na_return_t
+na_tcp_mem_handle_serialize(na_class_t NA_UNUSED *na_class, void *buf,
+    size_t buf_size, na_mem_handle_t *mem_handle)
+{
+    struct na_tcp_mem_handle *na_tcp_mem_handle =
+        (struct na_tcp_mem_handle *) mem_handle;
+    char *buf_ptr = (char *) buf;
+    size_t buf_size_left = buf_size;
+    na_return_t ret = NA_SUCCESS;
+
+    /* Descriptor info */
+    NA_ENCODE(done, ret, buf_ptr, buf_size_left, &na_tcp_mem_handle->info,
+        struct na_tcp_mem_desc_info);
+
+done:
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static na_return_t
+na_tcp_mem_handle_deserialize(na_class_t NA_UNUSED *na_class,
+    na_mem_handle_t **mem_handle_p, const void *buf, size_t buf_size)
+{
+    struct na_tcp_mem_handle *na_tcp_mem_handle = NULL;
+    const char *buf_ptr = (const char *) buf;
+    size_t buf_size_left = buf_size;
+    na_return_t ret = NA_SUCCESS;
+
+    na_tcp_mem_handle =
+        (struct na_tcp_mem_handle *) malloc(sizeof(struct na_tcp_mem_handle));
+    NA_CHECK_SUBSYS_ERROR(mem, na_tcp_mem_handle == NULL, error, ret, NA_NOMEM,
+        "Could not allocate NA TCP memory handle");
+    na_tcp_mem_handle->local = false;
+
+    /* Descriptor info */
+    NA_DECODE(error, ret, buf_ptr, buf_size_left, &na_tcp_mem_handle->info,
+        struct na_tcp_mem_desc_info);
+
+    *mem_handle_p = (na_mem_handle_t *) na_tcp_mem_handle;
+
+    return ret;
+
+error:
+    free(na_tcp_mem_handle);
+
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static NA_INLINE na_return_t
+na_tcp_put(na_class_t *na_class, na_context_t *context, na_cb_t callback,
+    void *arg, na_mem_handle_t *local_mem_handle, na_offset_t local_offset,
+    na_mem_handle_t *remote_mem_handle, na_offset_t remote_offset,
+    size_t length, na_addr_t *remote_addr, uint8_t NA_UNUSED remote_id,
+    na_op_id_t *op_id)
+{
+    return na_tcp_rma(NA_TCP_CLASS(na_class), context, NA_CB_PUT, callback,
+        arg, (struct na_tcp_mem_handle *) local_mem_handle, local_offset,
+        (struct na_tcp_mem_handle *) remote_mem_handle, remote_offset, length,
+        (struct na_tcp_addr *) remote_addr, (struct na_tcp_op_id *) op_id);
+}
+
+/*---------------------------------------------------------------------------*/
+static NA_INLINE na_return_t
+na_tcp_get(na_class_t *na_class, na_context_t *context, na_cb_t callback,
+    void *arg, na_mem_handle_t *local_mem_handle, na_offset_t local_offset,
+    na_mem_handle_t *remote_mem_handle, na_offset_t remote_offset,
+    size_t length, na_addr_t *remote_addr, uint8_t NA_UNUSED remote_id,
+    na_op_id_t *op_id)
+{
+    return na_tcp_rma(NA_TCP_CLASS(na_class), context, NA_CB_GET, callback,
+        arg, (struct na_tcp_mem_handle *) local_mem_handle, local_offset,
+        (struct na_tcp_mem_handle *) remote_mem_handle, remote_offset, length,
+        (struct na_tcp_addr *) remote_addr, (struct na_tcp_op_id *) op_id);
+}
+
+/*---------------------------------------------------------------------------*/
+static NA_INLINE int
+na_tcp_poll_get_fd(na_class_t *na_class, na_context_t NA_UNUSED *context)
+{
+    int fd = -1;
+
+    if (!NA_TCP_CLASS(na_class)->no_block) {
+        fd = hg_poll_get_fd(NA_TCP_CLASS(na_class)->poll_set);
+        NA_CHECK_SUBSYS_ERROR_NORET(
+            poll, fd == -1, done, "Could not get poll fd from poll set");
+    }
+
+done:
+    return fd;
+}
+
+/*---------------------------------------------------------------------------*/
+static NA_INLINE bool
+na_tcp_poll_try_wait(
+    na_class_t NA_UNUSED *na_class, na_context_t NA_UNUSED *context)
+{
+    /* Nothing is buffered outside of the kernel */
+    return true;
+}
+
+/*---------------------------------------------------------------------------*/
+static na_return_t
+na_tcp_progress(
+    na_class_t *na_class, na_context_t *context, unsigned int timeout_ms)
+{
+    struct na_tcp_class *na_tcp_class = NA_TCP_CLASS(na_class);
+    struct hg_poll_event *events = NA_TCP_CONTEXT(context)->events;
+    hg_time_t deadline, now = hg_time_from_ms(0);
+    na_return_t ret;
+
+    if (timeout_ms != 0)
+        hg_time_get_current_ms(&now);
+    deadline = hg_time_add(now, hg_time_from_ms(timeout_ms));
+
+    do {
+        unsigned int nevents = 0, i;
+        bool progressed = false;
+        int rc;
+
+        rc = hg_poll_wait(na_tcp_class->poll_set,
+            na_tcp_class->no_block
+                ? 0
+                : hg_time_to_ms(hg_time_subtract(deadline, now)),
+            NA_TCP_MAX_EVENTS, events, &nevents);
+        NA_CHECK_SUBSYS_ERROR(poll, rc != HG_UTIL_SUCCESS, error, ret,
+            na_tcp_errno_to_na(errno), "hg_poll_wait() failed");
+
+        if (nevents == 1 && (events[0].events & HG_POLLINTR)) {
+            NA_LOG_SUBSYS_DEBUG(poll_loop, "Interrupted");
+            return NA_TIMEOUT;
+        }
+
+        for (i = 0; i < nevents; i++) {
+            struct na_tcp_addr *na_tcp_addr;
+
+            switch (*(enum na_tcp_poll_type *) events[i].data.ptr) {
+                case NA_TCP_POLL_LISTEN:
+                    NA_LOG_SUBSYS_DEBUG(poll_loop, "NA_TCP_POLL_LISTEN event");
+                    ret = na_tcp_progress_accept(na_tcp_class, &progressed);
+                    NA_CHECK_SUBSYS_NA_ERROR(
+                        poll, error, ret, "Could not accept connections");
+                    break;
+                case NA_TCP_POLL_NOTIFY: {
+                    bool notified = false;
+
+                    NA_LOG_SUBSYS_DEBUG(poll_loop, "NA_TCP_POLL_NOTIFY event");
+                    rc = hg_event_get(na_tcp_class->notify, &notified);
+                    NA_CHECK_SUBSYS_ERROR(poll, rc != HG_UTIL_SUCCESS, error,
+                        ret, NA_PROTOCOL_ERROR, "Could not get event");
+                    progressed |= notified;
+                } break;
+                case NA_TCP_POLL_CONN:
+                    NA_LOG_SUBSYS_DEBUG(poll_loop, "NA_TCP_POLL_CONN event");
+                    na_tcp_addr = container_of(
+                        events[i].data.ptr, struct na_tcp_addr, poll_type);
+
+                    /* Keep addr alive if it gets disconnected */
+                    na_tcp_addr_ref_incr(na_tcp_addr);
+#ifdef NA_TCP_HAS_ZCOPY
+                    if ((events[i].events & HG_POLLERR) &&
+                        na_tcp_progress_errqueue(na_tcp_addr) != NA_SUCCESS)
+                        na_tcp_addr_disconnect(na_tcp_addr);
+#endif
+                    if (events[i].events & HG_POLLOUT) {
+                        ret = na_tcp_progress_tx(na_tcp_addr, &progressed);
+                        if (ret != NA_SUCCESS)
+                            na_tcp_addr_disconnect(na_tcp_addr);
+                    }
+                    if (events[i].events &
+                        (HG_POLLIN | HG_POLLHUP | HG_POLLERR))
+                        (void) na_tcp_progress_rx(na_tcp_addr, &progressed);
+                    na_tcp_addr_ref_decr(na_tcp_addr);
+                    break;
+                default:
+                    NA_GOTO_SUBSYS_ERROR(poll, error, ret, NA_INVALID_ARG,
+                        "Operation type %d not supported",
+                        *(enum na_tcp_poll_type *) events[i].data.ptr);
+            }
+        }
+
+        if (progressed)
+            return NA_SUCCESS;
+
+        if (timeout_ms != 0)
+            hg_time_get_current_ms(&now);
+    } while (hg_time_less(now, deadline));
+
+    return NA_TIMEOUT;
+
+error:
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static na_return_t
+na_tcp_cancel(
+    na_class_t *na_class, na_context_t NA_UNUSED *context, na_op_id_t *op_id)
+{
+    struct na_tcp_class *na_tcp_class = NA_TCP_CLASS(na_class);
+    struct na_tcp_op_id *na_tcp_op_id = (struct na_tcp_op_id *) op_id;
+    struct na_tcp_op_queue *op_queue = NULL;
+    bool canceled = false;
+    int32_t status;
+    na_return_t ret;
+
+    /* Exit if op has already completed */
+    status = hg_atomic_get32(&na_tcp_op_id->status);
+    if ((status & NA_TCP_OP_COMPLETED) || (status & NA_TCP_OP_ERRORED) ||
+        (status & NA_TCP_OP_CANCELED))
+        return NA_SUCCESS;
+
+    NA_LOG_SUBSYS_DEBUG(op, "Canceling operation ID %p (%s)",
+        (void *) na_tcp_op_id,
+        na_cb_type_to_string(na_tcp_op_id->completion_data.callback_info.type));
+
+    switch (na_tcp_op_id->completion_data.callback_info.type) {
+        case NA_CB_RECV_UNEXPECTED:
+            /* Must remove op_id from unexpected op queue */
+            op_queue = &na_tcp_class->unexpected_op_queue;
+            break;
+        case NA_CB_RECV_EXPECTED:
+            /* Must remove op_id from expected op queue */
+            op_queue = &na_tcp_class->expected_op_queue;
+            break;
+        case NA_CB_PUT:
+        case NA_CB_GET:
+            /* Must remove op_id from RMA op queue, unless still sending */
+            op_queue = &na_tcp_class->rma_op_queue;
+            break;
+        case NA_CB_SEND_UNEXPECTED:
+        case NA_CB_SEND_EXPECTED: {
+            struct na_tcp_addr *na_tcp_addr = na_tcp_op_id->addr;
+
+            /* Can only cancel sends that have not started yet */
+            hg_thread_mutex_lock(&na_tcp_addr->tx_lock);
+            if ((hg_atomic_get32(&na_tcp_op_id->status) & NA_TCP_OP_TX) &&
+                na_tcp_op_id->tx.sent == 0) {
+                HG_QUEUE_REMOVE(&na_tcp_addr->tx_queue, &na_tcp_op_id->tx,
+                    na_tcp_tx, entry);
+                hg_atomic_and32(&na_tcp_op_id->status, ~NA_TCP_OP_TX);
+                hg_atomic_or32(&na_tcp_op_id->status, NA_TCP_OP_CANCELED);
+                canceled = true;
+            }
+            hg_thread_mutex_unlock(&na_tcp_addr->tx_lock);
+        } break;
+        default:
+            NA_GOTO_SUBSYS_ERROR(op, error, ret, NA_INVALID_ARG,
+                "Operation type %d not supported",
+                na_tcp_op_id->completion_data.callback_info.type);
+    }
+
+    /* Remove op id from queue it is on */
+    if (op_queue) {
+        hg_thread_spin_lock(&op_queue->lock);
+        if (hg_atomic_get32(&na_tcp_op_id->status) & NA_TCP_OP_QUEUED) {
+            hg_atomic_or32(&na_tcp_op_id->status, NA_TCP_OP_CANCELED);
+
+            /* If still being sent, tx completion will cancel it */
+            if (!(hg_atomic_get32(&na_tcp_op_id->status) & NA_TCP_OP_TX)) {
+                HG_QUEUE_REMOVE(
+                    &op_queue->queue, na_tcp_op_id, na_tcp_op_id, entry);
+                hg_atomic_and32(&na_tcp_op_id->status, ~NA_TCP_OP_QUEUED);
+                canceled = true;
+            }
+        }
+        hg_thread_spin_unlock(&op_queue->lock);
+    }
+
+    /* Cancel op id */
+    if (canceled) {
+        na_tcp_complete(na_tcp_op_id, NA_CANCELED);
+
+        na_tcp_complete_signal(na_tcp_class);
+    }
+
+    return NA_SUCCESS;
+
+error:
+    return ret;
+}
@@ -86,6 +86,11 @@ struct na_init_info {
     /* Request support for tranfers to/from memory devices (e.g., GPU, etc).
      * Default is: false. */
     bool request_mem_device;
+
+    /* Carve message buffers out of huge pages and register them as a single
+     * region when possible, falling back to regular pages otherwise.
+     * Default is: false. */
+    bool msg_buf_huge_pages;
 };
 
 /* Segment */
@@ -234,7 +239,7 @@ typedef void (*na_cb_t)(const struct na_cb_info *callback_info);
         .ip_subnet = NULL, .auth_key = NULL, .max_unexpected_size = 0,         \
         .max_expected_size = 0, .progress_mode = 0,                            \
         .addr_format = NA_ADDR_UNSPEC, .max_contexts = 1, .thread_mode = 0,    \
-        .request_mem_device = false                                            \
+        .request_mem_device = false, .msg_buf_huge_pages = false               \
     }
 
 #endif /* NA_TYPES_H */
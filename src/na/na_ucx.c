@@ -40,6 +40,10 @@
 /* Default max msg size */
 #define NA_UCX_MSG_SIZE_MAX (4096)
 
+/* Max size of injected msgs (sends that do not fit into a short message
+ * simply fail to complete immediately and are not injected) */
+#define NA_UCX_MSG_INJECT_SIZE_MAX (128)
+
 /* Address pool (enabled by default, comment out to disable) */
 #define NA_UCX_HAS_ADDR_POOL
 #define NA_UCX_ADDR_POOL_SIZE (64)
@@ -736,6 +740,10 @@ na_ucx_msg_get_max_unexpected_size(const na_class_t *na_class);
 static NA_INLINE size_t
 na_ucx_msg_get_max_expected_size(const na_class_t *na_class);
 
+/* msg_get_max_inject_size */
+static NA_INLINE size_t
+na_ucx_msg_get_max_inject_size(const na_class_t *na_class);
+
 /* msg_get_max_tag */
 static NA_INLINE na_tag_t
 na_ucx_msg_get_max_tag(const na_class_t *na_class);
@@ -769,6 +777,12 @@ na_ucx_msg_send_expected(na_class_t *na_class, na_context_t *context,
     void *plugin_data, na_addr_t *dest_addr, uint8_t dest_id, na_tag_t tag,
     na_op_id_t *op_id);
 
+/* msg_send_expected_inject */
+static na_return_t
+na_ucx_msg_send_expected_inject(na_class_t *na_class, na_context_t *context,
+    const void *buf, size_t buf_size, void *plugin_data, na_addr_t *dest_addr,
+    uint8_t dest_id, na_tag_t tag);
+
 /* msg_recv_expected */
 static na_return_t
 na_ucx_msg_recv_expected(na_class_t *na_class, na_context_t *context,
@@ -855,6 +869,7 @@ const struct na_class_ops NA_PLUGIN_OPS(ucx) = {
     na_ucx_op_create,                     /* op_create */
     na_ucx_op_destroy,                    /* op_destroy */
     na_ucx_addr_lookup,                   /* addr_lookup */
+    NULL,                                 /* addr_lookup_multi */
     na_ucx_addr_free,                     /* addr_free */
     NULL,                                 /* addr_set_remove */
     na_ucx_addr_self,                     /* addr_self */
@@ -865,10 +880,12 @@ const struct na_class_ops NA_PLUGIN_OPS(ucx) = {
     na_ucx_addr_get_serialize_size,       /* addr_get_serialize_size */
     na_ucx_addr_serialize,                /* addr_serialize */
     na_ucx_addr_deserialize,              /* addr_deserialize */
+    NULL,                                 /* addr_deserialize_multi */
     na_ucx_msg_get_max_unexpected_size,   /* msg_get_max_unexpected_size */
     na_ucx_msg_get_max_expected_size,     /* msg_get_max_expected_size */
     NULL,                                 /* msg_get_unexpected_header_size */
     NULL,                                 /* msg_get_expected_header_size */
+    na_ucx_msg_get_max_inject_size,       /* msg_get_max_inject_size */
     na_ucx_msg_get_max_tag,               /* msg_get_max_tag */
     na_ucx_msg_buf_alloc,                 /* msg_buf_alloc */
     na_ucx_msg_buf_free,                  /* msg_buf_free */
@@ -878,6 +895,7 @@ const struct na_class_ops NA_PLUGIN_OPS(ucx) = {
     NULL,                                 /* msg_multi_recv_unexpected */
     NULL,                                 /* msg_init_expected */
     na_ucx_msg_send_expected,             /* msg_send_expected */
+    na_ucx_msg_send_expected_inject,      /* msg_send_expected_inject */
     na_ucx_msg_recv_expected,             /* msg_recv_expected */
     na_ucx_mem_handle_create,             /* mem_handle_create */
     NULL,                                 /* mem_handle_create_segment */
@@ -2783,6 +2801,7 @@ na_ucx_initialize(
     ucs_sock_addr_t addr_key = {.addr = NULL, .addrlen = 0};
     ucp_config_t *config = NULL;
     bool no_wait = false;
+    unsigned long pool_flags = 0;
     size_t unexpected_size_max = 0, expected_size_max = 0;
     ucs_thread_mode_t context_thread_mode = UCS_THREAD_MODE_SINGLE,
                       worker_thread_mode = UCS_THREAD_MODE_MULTI;
@@ -2814,6 +2833,9 @@ na_ucx_initialize(
 
         if (na_info->na_init_info->thread_mode & NA_THREAD_MODE_SINGLE_CTX)
             worker_thread_mode = UCS_THREAD_MODE_SINGLE;
+        /* Message buffers */
+        if (na_info->na_init_info->msg_buf_huge_pages)
+            pool_flags |= HG_MEM_POOL_HUGE_PAGES;
     }
 
 #ifdef NA_UCX_HAS_LIB_QUERY
@@ -2935,7 +2957,7 @@ na_ucx_initialize(
     na_ucx_class->mem_pool = hg_mem_pool_create(
         MAX(na_ucx_class->unexpected_size_max, na_ucx_class->expected_size_max),
         NA_UCX_MEM_CHUNK_COUNT, NA_UCX_MEM_BLOCK_COUNT, na_ucp_mem_buf_register,
-        0, na_ucp_mem_buf_deregister, (void *) na_ucx_class);
+        pool_flags, na_ucp_mem_buf_deregister, (void *) na_ucx_class);
     NA_CHECK_SUBSYS_ERROR(cls, na_ucx_class->mem_pool == NULL, error, ret,
         NA_NOMEM,
         "Could not create memory pool with %d blocks of size %d x %zu bytes",
@@ -3297,6 +3319,17 @@ na_ucx_msg_get_max_expected_size(const na_class_t *na_class)
     return NA_UCX_CLASS(na_class)->expected_size_max;
 }
 
+/*---------------------------------------------------------------------------*/
+static NA_INLINE size_t
+na_ucx_msg_get_max_inject_size(const na_class_t *na_class)
+{
+    size_t expected_size_max = NA_UCX_CLASS(na_class)->expected_size_max;
+
+    return (expected_size_max < NA_UCX_MSG_INJECT_SIZE_MAX)
+               ? expected_size_max
+               : NA_UCX_MSG_INJECT_SIZE_MAX;
+}
+
 /*---------------------------------------------------------------------------*/
 static NA_INLINE na_tag_t
 na_ucx_msg_get_max_tag(const na_class_t NA_UNUSED *na_class)
@@ -3474,6 +3507,46 @@ error:
     return ret;
 }
 
+/*---------------------------------------------------------------------------*/
+static na_return_t
+na_ucx_msg_send_expected_inject(na_class_t NA_UNUSED *na_class,
+    na_context_t NA_UNUSED *context, const void *buf, size_t buf_size,
+    void NA_UNUSED *plugin_data, na_addr_t *dest_addr,
+    uint8_t NA_UNUSED dest_id, na_tag_t tag)
+{
+    struct na_ucx_addr *na_ucx_addr = (struct na_ucx_addr *) dest_addr;
+    /* Fail instead of returning a request if the send cannot complete in
+     * place, no callback or request is therefore needed */
+    const ucp_request_param_t send_params = {
+        .op_attr_mask = UCP_OP_ATTR_FLAG_FORCE_IMM_CMPL};
+    ucs_status_ptr_t status_ptr;
+    na_return_t ret;
+
+    /* Let regular sends resolve the EP if it is no longer valid */
+    if (!(hg_atomic_get32(&na_ucx_addr->status) & NA_UCX_ADDR_RESOLVED) ||
+        na_ucx_addr->ucp_ep == NULL)
+        return NA_AGAIN;
+
+    NA_LOG_SUBSYS_DEBUG(msg,
+        "Posting msg inject with buf_size=%zu, tag=%" PRIu64, buf_size,
+        (ucp_tag_t) tag);
+
+    status_ptr = ucp_tag_send_nbx(
+        na_ucx_addr->ucp_ep, buf, buf_size, (ucp_tag_t) tag, &send_params);
+    if (status_ptr == NULL)
+        return NA_SUCCESS;
+    else if (UCS_PTR_STATUS(status_ptr) == UCS_ERR_NO_RESOURCE)
+        return NA_AGAIN;
+    else
+        NA_GOTO_SUBSYS_ERROR(msg, error, ret,
+            na_ucs_status_to_na(UCS_PTR_STATUS(status_ptr)),
+            "ucp_tag_send_nbx() failed (%s)",
+            ucs_status_string(UCS_PTR_STATUS(status_ptr)));
+
+error:
+    return ret;
+}
+
 /*---------------------------------------------------------------------------*/
 static na_return_t
 na_ucx_msg_recv_expected(na_class_t *na_class, na_context_t *context,
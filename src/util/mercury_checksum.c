@@ -0,0 +1,244 @@
+/**
+ * Copyright (c) 2013-2022 UChicago Argonne, LLC and The HDF Group.
+ * Copyright (c) 2022 Intel Corporation.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "mercury_checksum.h"
+
+#if defined(HG_UTIL_HAS_CRC32C_SSE42)
+#    include <nmmintrin.h>
+#elif defined(HG_UTIL_HAS_CRC32C_ARMV8)
+#    include <arm_acle.h>
+#    include <asm/hwcap.h>
+#    include <sys/auxv.h>
+#endif
+
+/****************/
+/* Local Macros */
+/****************/
+
+/* CRC32C (Castagnoli) polynomial, reversed */
+#define HG_CHECKSUM_CRC32C_POLY (0x82f63b78U)
+
+/************************************/
+/* Local Type and Struct Definition */
+/************************************/
+
+typedef uint32_t (*hg_checksum_crc32c_func_t)(
+    uint32_t crc, const void *buf, size_t len);
+
+/********************/
+/* Local Prototypes */
+/********************/
+
+/* Select implementation */
+static void
+hg_checksum_init(void) HG_ATTR_CONSTRUCTOR;
+
+/* Select implementation on first use if constructor has not run yet */
+static uint32_t
+hg_checksum_crc32c_resolve(uint32_t crc, const void *buf, size_t len);
+
+/* Table-driven implementation (slicing-by-8) */
+static uint32_t
+hg_checksum_crc32c_sw(uint32_t crc, const void *buf, size_t len);
+
+/* Multiply a and b modulo CRC32C polynomial (reflected) */
+static uint32_t
+hg_checksum_crc32c_multmodp(uint32_t a, uint32_t b);
+
+#if defined(HG_UTIL_HAS_CRC32C_SSE42)
+/* SSE4.2 implementation */
+static uint32_t
+hg_checksum_crc32c_sse42(uint32_t crc, const void *buf, size_t len)
+    __attribute__((target("sse4.2")));
+#elif defined(HG_UTIL_HAS_CRC32C_ARMV8)
+/* ARMv8 implementation */
+static uint32_t
+hg_checksum_crc32c_armv8(uint32_t crc, const void *buf, size_t len)
+    __attribute__((target("+crc")));
+#endif
+
+/*******************/
+/* Local Variables */
+/*******************/
+
+/* Lookup tables used by table-driven implementation */
+static uint32_t hg_checksum_crc32c_table_g[8][256];
+
+/* Selected implementation */
+static hg_checksum_crc32c_func_t hg_checksum_crc32c_g =
+    hg_checksum_crc32c_resolve;
+
+/*---------------------------------------------------------------------------*/
+static void
+hg_checksum_init(void)
+{
+    hg_checksum_crc32c_func_t func = hg_checksum_crc32c_sw;
+    uint32_t i, j;
+
+    for (i = 0; i < 256; i++) {
+        uint32_t crc = i;
+
+        for (j = 0; j < 8; j++)
+            crc = (crc & 1) ? (crc >> 1) ^ HG_CHECKSUM_CRC32C_POLY : crc >> 1;
+        hg_checksum_crc32c_table_g[0][i] = crc;
+    }
+    for (i = 0; i < 256; i++) {
+        for (j = 1; j < 8; j++) {
+            uint32_t crc = hg_checksum_crc32c_table_g[j - 1][i];
+
+            hg_checksum_crc32c_table_g[j][i] =
+                (crc >> 8) ^ hg_checksum_crc32c_table_g[0][crc & 0xff];
+        }
+    }
+
+#if defined(HG_UTIL_HAS_CRC32C_SSE42)
+    if (__builtin_cpu_supports("sse4.2"))
+        func = hg_checksum_crc32c_sse42;
+#elif defined(HG_UTIL_HAS_CRC32C_ARMV8)
+    if (getauxval(AT_HWCAP) & HWCAP_CRC32)
+        func = hg_checksum_crc32c_armv8;
+#endif
+
+    __atomic_store_n(&hg_checksum_crc32c_g, func, __ATOMIC_RELEASE);
+}
+
+/*---------------------------------------------------------------------------*/
+static uint32_t
+hg_checksum_crc32c_resolve(uint32_t crc, const void *buf, size_t len)
+{
+    hg_checksum_init();
+
+    return hg_checksum_crc32c_g(crc, buf, len);
+}
+
+/*---------------------------------------------------------------------------*/
+static uint32_t
+hg_checksum_crc32c_sw(uint32_t crc, const void *buf, size_t len)
+{
+    const unsigned char *p = (const unsigned char *) buf;
+
+    /* Process 8 bytes at a time, words are read as little-endian */
+    for (; len >= 8; len -= 8, p += 8) {
+        uint32_t lo = crc ^ ((uint32_t) p[0] | (uint32_t) p[1] << 8 |
+                                (uint32_t) p[2] << 16 | (uint32_t) p[3] << 24);
+        uint32_t hi = (uint32_t) p[4] | (uint32_t) p[5] << 8 |
+                      (uint32_t) p[6] << 16 | (uint32_t) p[7] << 24;
+
+        crc = hg_checksum_crc32c_table_g[7][lo & 0xff] ^
+              hg_checksum_crc32c_table_g[6][(lo >> 8) & 0xff] ^
+              hg_checksum_crc32c_table_g[5][(lo >> 16) & 0xff] ^
+              hg_checksum_crc32c_table_g[4][lo >> 24] ^
+              hg_checksum_crc32c_table_g[3][hi & 0xff] ^
+              hg_checksum_crc32c_table_g[2][(hi >> 8) & 0xff] ^
+              hg_checksum_crc32c_table_g[1][(hi >> 16) & 0xff] ^
+              hg_checksum_crc32c_table_g[0][hi >> 24];
+    }
+    for (; len > 0; len--, p++)
+        crc = hg_checksum_crc32c_table_g[0][(crc ^ *p) & 0xff] ^ (crc >> 8);
+
+    return crc;
+}
+
+/*---------------------------------------------------------------------------*/
+#if defined(HG_UTIL_HAS_CRC32C_SSE42)
+static uint32_t
+hg_checksum_crc32c_sse42(uint32_t crc, const void *buf, size_t len)
+{
+    const unsigned char *p = (const unsigned char *) buf;
+
+#    if defined(__x86_64__)
+    uint64_t crc64 = crc;
+
+    for (; len >= sizeof(uint64_t); len -= sizeof(uint64_t)) {
+        uint64_t val;
+
+        memcpy(&val, p, sizeof(val));
+        crc64 = _mm_crc32_u64(crc64, val);
+        p += sizeof(val);
+    }
+    crc = (uint32_t) crc64;
+#    endif
+    for (; len >= sizeof(uint32_t); len -= sizeof(uint32_t)) {
+        uint32_t val;
+
+        memcpy(&val, p, sizeof(val));
+        crc = _mm_crc32_u32(crc, val);
+        p += sizeof(val);
+    }
+    for (; len > 0; len--)
+        crc = _mm_crc32_u8(crc, *p++);
+
+    return crc;
+}
+
+/*---------------------------------------------------------------------------*/
+#elif defined(HG_UTIL_HAS_CRC32C_ARMV8)
+static uint32_t
+hg_checksum_crc32c_armv8(uint32_t crc, const void *buf, size_t len)
+{
+    const unsigned char *p = (const unsigned char *) buf;
+
+    for (; len >= sizeof(uint64_t); len -= sizeof(uint64_t)) {
+        uint64_t val;
+
+        memcpy(&val, p, sizeof(val));
+        crc = __crc32cd(crc, val);
+        p += sizeof(val);
+    }
+    for (; len > 0; len--)
+        crc = __crc32cb(crc, *p++);
+
+    return crc;
+}
+#endif
+
+/*---------------------------------------------------------------------------*/
+static uint32_t
+hg_checksum_crc32c_multmodp(uint32_t a, uint32_t b)
+{
+    uint32_t m = 1U << 31, p = 0;
+
+    /* a must not be 0 */
+    for (;;) {
+        if (a & m) {
+            p ^= b;
+            if ((a & (m - 1)) == 0)
+                break;
+        }
+        m >>= 1;
+        b = (b & 1) ? (b >> 1) ^ HG_CHECKSUM_CRC32C_POLY : b >> 1;
+    }
+
+    return p;
+}
+
+/*---------------------------------------------------------------------------*/
+uint32_t
+hg_checksum_crc32c_buf(uint32_t crc, const void *buf, size_t len)
+{
+    hg_checksum_crc32c_func_t func =
+        __atomic_load_n(&hg_checksum_crc32c_g, __ATOMIC_ACQUIRE);
+
+    return func(crc, buf, len);
+}
+
+/*---------------------------------------------------------------------------*/
+uint32_t
+hg_checksum_crc32c_combine(uint32_t crc1, uint32_t crc2, size_t len2)
+{
+    uint32_t xpow = 1U << 31;      /* x^0 */
+    uint32_t xsq = 1U << (31 - 8); /* x^8 */
+
+    /* Compute x^(8 * len2) by squaring, then shift crc1 by len2 bytes */
+    for (; len2 > 0; len2 >>= 1) {
+        if (len2 & 1)
+            xpow = hg_checksum_crc32c_multmodp(xsq, xpow);
+        xsq = hg_checksum_crc32c_multmodp(xsq, xsq);
+    }
+
+    return hg_checksum_crc32c_multmodp(xpow, crc1) ^ crc2;
+}
@@ -0,0 +1,155 @@
+/**
+ * Copyright (c) 2013-2022 UChicago Argonne, LLC and The HDF Group.
+ * Copyright (c) 2022 Intel Corporation.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef MERCURY_CHECKSUM_H
+#define MERCURY_CHECKSUM_H
+
+#include "mercury_util_config.h"
+
+#include <string.h>
+
+#if defined(__SSE4_2__)
+#    include <nmmintrin.h>
+#elif defined(__ARM_FEATURE_CRC32)
+#    include <arm_acle.h>
+#endif
+
+/*************************************/
+/* Public Type and Struct Definition */
+/*************************************/
+
+/*****************/
+/* Public Macros */
+/*****************/
+
+/* Initial CRC32C value, hash is obtained with hg_checksum_crc32c_final() */
+#define HG_CHECKSUM_CRC32C_INIT (0xffffffffU)
+
+/*********************/
+/* Public Prototypes */
+/*********************/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Update CRC32C (Castagnoli) with buf. Uses SSE4.2 or ARMv8 CRC instructions
+ * when supported by the CPU, a table-driven implementation otherwise.
+ *
+ * \param crc [IN]              current CRC value
+ * \param buf [IN]              pointer to data
+ * \param len [IN]              size of data
+ *
+ * \return updated CRC value
+ */
+HG_UTIL_PUBLIC uint32_t
+hg_checksum_crc32c_buf(uint32_t crc, const void *buf, size_t len);
+
+/**
+ * Combine the CRC32C hash crc1 of a first block of data with the CRC32C hash
+ * crc2 of a second block of len2 bytes. Both hashes must be finalized.
+ *
+ * \param crc1 [IN]             CRC32C hash of first block
+ * \param crc2 [IN]             CRC32C hash of second block
+ * \param len2 [IN]             size of second block
+ *
+ * \return CRC32C hash of the concatenation of both blocks
+ */
+HG_UTIL_PUBLIC uint32_t
+hg_checksum_crc32c_combine(uint32_t crc1, uint32_t crc2, size_t len2);
+
+/**
+ * Update CRC32C with buf. Small fixed-size updates are inlined when the
+ * target architecture provides CRC instructions.
+ *
+ * \param crc [IN]              current CRC value
+ * \param buf [IN]              pointer to data
+ * \param len [IN]              size of data
+ *
+ * \return updated CRC value
+ */
+static HG_UTIL_INLINE uint32_t
+hg_checksum_crc32c_update(uint32_t crc, const void *buf, size_t len);
+
+/**
+ * Finalize CRC32C.
+ *
+ * \param crc [IN]              current CRC value
+ *
+ * \return CRC32C hash
+ */
+static HG_UTIL_INLINE uint32_t
+hg_checksum_crc32c_final(uint32_t crc);
+
+/*---------------------------------------------------------------------------*/
+static HG_UTIL_INLINE uint32_t
+hg_checksum_crc32c_update(uint32_t crc, const void *buf, size_t len)
+{
+#if defined(__SSE4_2__)
+    switch (len) {
+        case sizeof(uint8_t):
+            return _mm_crc32_u8(crc, *(const uint8_t *) buf);
+        case sizeof(uint16_t): {
+            uint16_t val;
+            memcpy(&val, buf, sizeof(val));
+            return _mm_crc32_u16(crc, val);
+        }
+        case sizeof(uint32_t): {
+            uint32_t val;
+            memcpy(&val, buf, sizeof(val));
+            return _mm_crc32_u32(crc, val);
+        }
+#    if defined(__x86_64__)
+        case sizeof(uint64_t): {
+            uint64_t val;
+            memcpy(&val, buf, sizeof(val));
+            return (uint32_t) _mm_crc32_u64(crc, val);
+        }
+#    endif
+        default:
+            break;
+    }
+#elif defined(__ARM_FEATURE_CRC32)
+    switch (len) {
+        case sizeof(uint8_t):
+            return __crc32cb(crc, *(const uint8_t *) buf);
+        case sizeof(uint16_t): {
+            uint16_t val;
+            memcpy(&val, buf, sizeof(val));
+            return __crc32ch(crc, val);
+        }
+        case sizeof(uint32_t): {
+            uint32_t val;
+            memcpy(&val, buf, sizeof(val));
+            return __crc32cw(crc, val);
+        }
+        case sizeof(uint64_t): {
+            uint64_t val;
+            memcpy(&val, buf, sizeof(val));
+            return __crc32cd(crc, val);
+        }
+        default:
+            break;
+    }
+#endif
+
+    return hg_checksum_crc32c_buf(crc, buf, len);
+}
+
+/*---------------------------------------------------------------------------*/
+static HG_UTIL_INLINE uint32_t
+hg_checksum_crc32c_final(uint32_t crc)
+{
+    return ~crc;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MERCURY_CHECKSUM_H */
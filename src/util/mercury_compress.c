@@ -0,0 +1,277 @@
+/**
+ * Copyright (c) 2013-2022 UChicago Argonne, LLC and The HDF Group.
+ * Copyright (c) 2022 Intel Corporation.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "mercury_compress.h"
+
+#include <stdint.h>
+#include <string.h>
+
+/****************/
+/* Local Macros */
+/****************/
+
+/* Number of hash table entries (log2) */
+#define HG_LZ_HASH_LOG (12)
+
+/* Minimum match length */
+#define HG_LZ_MIN_MATCH (4)
+
+/* Maximum back-reference distance */
+#define HG_LZ_MAX_OFFSET (65535)
+
+/* Lengths that do not fit into a token nibble are extended with bytes */
+#define HG_LZ_NIBBLE_MAX (15)
+
+/* Number of misses after which the search step is increased */
+#define HG_LZ_SKIP_TRIGGER (6)
+
+/************************************/
+/* Local Type and Struct Definition */
+/************************************/
+
+/********************/
+/* Local Prototypes */
+/********************/
+
+/* Read 32-bit value from unaligned pointer */
+static HG_UTIL_INLINE uint32_t
+hg_lz_read32(const uint8_t *ptr);
+
+/* Hash 4 bytes */
+static HG_UTIL_INLINE uint32_t
+hg_lz_hash(uint32_t seq);
+
+/* Write extended length */
+static HG_UTIL_INLINE int
+hg_lz_put_len(uint8_t **op_p, const uint8_t *oend, size_t len);
+
+/* Read extended length */
+static HG_UTIL_INLINE int
+hg_lz_get_len(const uint8_t **ip_p, const uint8_t *iend, size_t *len_p);
+
+/* Write a sequence (literals followed by an optional match) */
+static int
+hg_lz_put_seq(uint8_t **op_p, const uint8_t *oend, const uint8_t *lit,
+    size_t lit_len, size_t offset, size_t match_len);
+
+/*******************/
+/* Local Variables */
+/*******************/
+
+/*---------------------------------------------------------------------------*/
+static HG_UTIL_INLINE uint32_t
+hg_lz_read32(const uint8_t *ptr)
+{
+    uint32_t val;
+
+    memcpy(&val, ptr, sizeof(val));
+
+    return val;
+}
+
+/*---------------------------------------------------------------------------*/
+static HG_UTIL_INLINE uint32_t
+hg_lz_hash(uint32_t seq)
+{
+    return (seq * 2654435761U) >> (32 - HG_LZ_HASH_LOG);
+}
+
+/*---------------------------------------------------------------------------*/
+static HG_UTIL_INLINE int
+hg_lz_put_len(uint8_t **op_p, const uint8_t *oend, size_t len)
+{
+    uint8_t *op = *op_p;
+
+    for (; len >= 255; len -= 255) {
+        if (op >= oend)
+            return 0;
+        *op++ = 255;
+    }
+    if (op >= oend)
+        return 0;
+    *op++ = (uint8_t) len;
+    *op_p = op;
+
+    return 1;
+}
+
+/*---------------------------------------------------------------------------*/
+static HG_UTIL_INLINE int
+hg_lz_get_len(const uint8_t **ip_p, const uint8_t *iend, size_t *len_p)
+{
+    const uint8_t *ip = *ip_p;
+    size_t len = *len_p;
+    uint8_t byte;
+
+    do {
+        if (ip >= iend || len > (SIZE_MAX >> 1))
+            return 0;
+        byte = *ip++;
+        len += byte;
+    } while (byte == 255);
+    *ip_p = ip;
+    *len_p = len;
+
+    return 1;
+}
+
+/*---------------------------------------------------------------------------*/
+static int
+hg_lz_put_seq(uint8_t **op_p, const uint8_t *oend, const uint8_t *lit,
+    size_t lit_len, size_t offset, size_t match_len)
+{
+    uint8_t *op = *op_p;
+    size_t ml = (match_len > 0) ? match_len - HG_LZ_MIN_MATCH : 0;
+    uint8_t *token;
+
+    if (op >= oend)
+        return 0;
+    token = op++;
+    *token = (uint8_t) (((lit_len < HG_LZ_NIBBLE_MAX) ? lit_len
+                                                      : HG_LZ_NIBBLE_MAX)
+                        << 4);
+    *token |= (uint8_t) ((ml < HG_LZ_NIBBLE_MAX) ? ml : HG_LZ_NIBBLE_MAX);
+
+    if (lit_len >= HG_LZ_NIBBLE_MAX &&
+        !hg_lz_put_len(&op, oend, lit_len - HG_LZ_NIBBLE_MAX))
+        return 0;
+    if ((size_t) (oend - op) < lit_len)
+        return 0;
+    memcpy(op, lit, lit_len);
+    op += lit_len;
+
+    if (match_len > 0) {
+        if (oend - op < 2)
+            return 0;
+        *op++ = (uint8_t) (offset & 0xff);
+        *op++ = (uint8_t) (offset >> 8);
+        if (ml >= HG_LZ_NIBBLE_MAX &&
+            !hg_lz_put_len(&op, oend, ml - HG_LZ_NIBBLE_MAX))
+            return 0;
+    }
+    *op_p = op;
+
+    return 1;
+}
+
+/*---------------------------------------------------------------------------*/
+size_t
+hg_compress_lz(const void *src, size_t src_size, void *dst, size_t dst_size)
+{
+    uint32_t table[1 << HG_LZ_HASH_LOG];
+    const uint8_t *base = (const uint8_t *) src;
+    const uint8_t *ip = base, *anchor = base, *iend = base + src_size;
+    const uint8_t *mflimit =
+        (src_size >= HG_LZ_MIN_MATCH) ? iend - HG_LZ_MIN_MATCH + 1 : base;
+    uint8_t *op = (uint8_t *) dst;
+    const uint8_t *oend = op + dst_size;
+    unsigned int misses = 0;
+
+    /* Positions are stored as 32-bit offsets */
+    if (src_size > UINT32_MAX)
+        return 0;
+
+    memset(table, 0, sizeof(table));
+
+    while (ip < mflimit) {
+        uint32_t seq = hg_lz_read32(ip);
+        uint32_t h = hg_lz_hash(seq);
+        const uint8_t *ref = base + table[h];
+        const uint8_t *mp, *rp;
+
+        table[h] = (uint32_t) (ip - base);
+        if (ref >= ip || ip - ref > HG_LZ_MAX_OFFSET ||
+            hg_lz_read32(ref) != seq) {
+            /* Skip faster through data that does not compress */
+            size_t step = 1 + (misses++ >> HG_LZ_SKIP_TRIGGER);
+
+            if ((size_t) (mflimit - ip) <= step)
+                break;
+            ip += step;
+            continue;
+        }
+        misses = 0;
+
+        /* Extend match */
+        for (mp = ip + HG_LZ_MIN_MATCH, rp = ref + HG_LZ_MIN_MATCH;
+             mp < iend && *mp == *rp; mp++, rp++)
+            continue;
+
+        if (!hg_lz_put_seq(&op, oend, anchor, (size_t) (ip - anchor),
+                (size_t) (ip - ref), (size_t) (mp - ip)))
+            return 0;
+        ip = anchor = mp;
+    }
+
+    /* Last sequence only has literals */
+    if (!hg_lz_put_seq(&op, oend, anchor, (size_t) (iend - anchor), 0, 0))
+        return 0;
+
+    return (size_t) (op - (uint8_t *) dst);
+}
+
+/*---------------------------------------------------------------------------*/
+size_t
+hg_decompress_lz(const void *src, size_t src_size, void *dst, size_t dst_size)
+{
+    const uint8_t *ip = (const uint8_t *) src, *iend = ip + src_size;
+    uint8_t *base = (uint8_t *) dst;
+    uint8_t *op = base, *oend = base + dst_size;
+
+    for (;;) {
+        size_t lit_len, match_len, offset;
+        const uint8_t *ref;
+        uint8_t token;
+
+        if (ip >= iend)
+            return 0;
+        token = *ip++;
+
+        /* Copy literals */
+        lit_len = (size_t) (token >> 4);
+        if (lit_len == HG_LZ_NIBBLE_MAX && !hg_lz_get_len(&ip, iend, &lit_len))
+            return 0;
+        if ((size_t) (iend - ip) < lit_len || (size_t) (oend - op) < lit_len)
+            return 0;
+        memcpy(op, ip, lit_len);
+        ip += lit_len;
+        op += lit_len;
+
+        /* Output is complete after the last literals */
+        if (op == oend)
+            break;
+
+        /* Copy match */
+        if (iend - ip < 2)
+            return 0;
+        offset = (size_t) ip[0] | ((size_t) ip[1] << 8);
+        ip += 2;
+        if (offset == 0 || offset > (size_t) (op - base))
+            return 0;
+        match_len = (size_t) (token & HG_LZ_NIBBLE_MAX);
+        if (match_len == HG_LZ_NIBBLE_MAX &&
+            !hg_lz_get_len(&ip, iend, &match_len))
+            return 0;
+        match_len += HG_LZ_MIN_MATCH;
+        if ((size_t) (oend - op) < match_len)
+            return 0;
+
+        ref = op - offset;
+        if (offset >= match_len)
+            memcpy(op, ref, match_len);
+        else {
+            /* Overlapping copy repeats the last offset bytes */
+            size_t i;
+
+            for (i = 0; i < match_len; i++)
+                op[i] = ref[i];
+        }
+        op += match_len;
+    }
+
+    return (size_t) (op - base);
+}
@@ -0,0 +1,64 @@
+/**
+ * Copyright (c) 2013-2022 UChicago Argonne, LLC and The HDF Group.
+ * Copyright (c) 2022 Intel Corporation.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef MERCURY_COMPRESS_H
+#define MERCURY_COMPRESS_H
+
+#include "mercury_util_config.h"
+
+#include <stddef.h>
+
+/*************************************/
+/* Public Type and Struct Definition */
+/*************************************/
+
+/*****************/
+/* Public Macros */
+/*****************/
+
+/*********************/
+/* Public Prototypes */
+/*********************/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Compress buffer using a fast LZ77 codec (LZ4-style block format: literal
+ * runs and back-references of at least 4 bytes within a 64 KiB window).
+ *
+ * \param src [IN]              pointer to data to compress
+ * \param src_size [IN]         size of data to compress
+ * \param dst [OUT]             pointer to destination buffer
+ * \param dst_size [IN]         size of destination buffer
+ *
+ * \return size of compressed data or 0 if it does not fit into dst_size
+ */
+HG_UTIL_PUBLIC size_t
+hg_compress_lz(const void *src, size_t src_size, void *dst, size_t dst_size);
+
+/**
+ * Decompress buffer produced by hg_compress_lz(). Decoding stops once dst_size
+ * bytes have been produced, src_size may therefore exceed the size of the
+ * compressed data.
+ *
+ * \param src [IN]              pointer to compressed data
+ * \param src_size [IN]         size of source buffer
+ * \param dst [OUT]             pointer to destination buffer
+ * \param dst_size [IN]         size of decompressed data
+ *
+ * \return size of decompressed data or 0 if data is malformed
+ */
+HG_UTIL_PUBLIC size_t
+hg_decompress_lz(const void *src, size_t src_size, void *dst, size_t dst_size);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MERCURY_COMPRESS_H */
@@ -25,10 +25,45 @@
 /* Local Type and Struct Definition */
 /************************************/
 
+/* entry copied out of a ring for trace dump */
+struct hg_dlog_trace_entry {
+    struct hg_dlog_entry le; /* copy of entry */
+    unsigned int tid;        /* index of ring (thread) that recorded it */
+};
+
 /********************/
 /* Local Prototypes */
 /********************/
 
+/* Get ring of calling thread, create it if needed */
+static struct hg_dlog_ring *
+hg_dlog_get_ring(struct hg_dlog *d);
+
+/* Create ring of calling thread */
+static struct hg_dlog_ring *
+hg_dlog_ring_create(struct hg_dlog *d);
+
+/* Retire ring of exiting thread to the free list */
+static void
+hg_dlog_ring_retire(void *arg);
+
+/* Copy entry at ring position, fail if it was overwritten */
+static int
+hg_dlog_ring_read(const struct hg_dlog *d, struct hg_dlog_ring *ring,
+    uint32_t pos, struct hg_dlog_entry *le);
+
+/* Merge entries of all rings in time order (must hold dlock) */
+static struct hg_dlog_entry *
+hg_dlog_merge(struct hg_dlog *d, unsigned int *count_p);
+
+/* Compare entry times */
+static int
+hg_dlog_entry_cmp(const void *a, const void *b);
+
+/* Compare trace entries by op_id, then time */
+static int
+hg_dlog_trace_entry_cmp(const void *a, const void *b);
+
 /*******************/
 /* Local Variables */
 /*******************/
@@ -56,6 +91,9 @@ hg_dlog_alloc(char *name, unsigned int lesize, int leloop)
     hg_thread_mutex_init(&d->dlock);
     HG_LIST_INIT(&d->cnts32);
     HG_LIST_INIT(&d->cnts64);
+    HG_LIST_INIT(&d->rings);
+    HG_LIST_INIT(&d->free_rings);
+    hg_atomic_init32(&d->ring_key_init, 0);
     d->le = le;
     d->lesize = lesize;
     d->leloop = leloop;
@@ -70,6 +108,7 @@ hg_dlog_free(struct hg_dlog *d)
 {
     struct hg_dlog_dcount32 *cp32 = HG_LIST_FIRST(&d->cnts32);
     struct hg_dlog_dcount64 *cp64 = HG_LIST_FIRST(&d->cnts64);
+    struct hg_dlog_ring *ring = HG_LIST_FIRST(&d->rings);
 
     while (cp32) {
         struct hg_dlog_dcount32 *cp = cp32;
@@ -85,6 +124,22 @@ hg_dlog_free(struct hg_dlog *d)
     }
     HG_LIST_INIT(&d->cnts64);
 
+    /* delete key first so that exiting threads no longer retire rings */
+    if (hg_atomic_get32(&d->ring_key_init)) {
+        hg_thread_key_delete(d->ring_key);
+        hg_atomic_set32(&d->ring_key_init, 0);
+    }
+
+    while (ring) {
+        struct hg_dlog_ring *r = ring;
+        ring = HG_LIST_NEXT(r, l);
+        if (r->le != d->le)
+            free(r->le);
+        free(r);
+    }
+    HG_LIST_INIT(&d->rings);
+    HG_LIST_INIT(&d->free_rings);
+
     if (d->mallocd) {
         free(d->le);
         free(d);
@@ -138,34 +193,170 @@ hg_dlog_mkcount64(struct hg_dlog *d, hg_atomic_int64_t **cptr, const char *name,
 }
 
 /*---------------------------------------------------------------------------*/
-unsigned int
-hg_dlog_addlog(struct hg_dlog *d, const char *file, unsigned int line,
-    const char *func, const char *msg, const void *data)
+static struct hg_dlog_ring *
+hg_dlog_get_ring(struct hg_dlog *d)
 {
-    unsigned int rv = 0;
-    unsigned int idx;
+    struct hg_dlog_ring *ring;
+
+    if (!hg_atomic_get32(&d->ring_key_init))
+        return hg_dlog_ring_create(d);
+
+    ring = (struct hg_dlog_ring *) hg_thread_getspecific(d->ring_key);
+    if (!ring)
+        ring = hg_dlog_ring_create(d);
+
+    return ring;
+}
+
+/*---------------------------------------------------------------------------*/
+static struct hg_dlog_ring *
+hg_dlog_ring_create(struct hg_dlog *d)
+{
+    struct hg_dlog_ring *ring = NULL;
 
     hg_thread_mutex_lock(&d->dlock);
-    if (d->lestop)
+
+    /* static dlogs create their key on first use */
+    if (!hg_atomic_get32(&d->ring_key_init)) {
+        if (hg_thread_key_create_destructor(
+                &d->ring_key, hg_dlog_ring_retire) != HG_UTIL_SUCCESS)
+            goto done;
+        hg_atomic_set32(&d->ring_key_init, 1);
+    }
+
+    /* reuse ring of an exited thread, its entries are kept */
+    ring = HG_LIST_FIRST(&d->free_rings);
+    if (ring) {
+        if (hg_thread_setspecific(d->ring_key, ring) != HG_UTIL_SUCCESS) {
+            ring = NULL;
+            goto done;
+        }
+        HG_LIST_REMOVE(ring, fl);
         goto done;
-    if (d->leloop == 0 && d->leadds >= d->lesize)
+    }
+
+    ring = malloc(sizeof(*ring));
+    if (!ring)
+        goto done;
+
+    /* first ring uses the dlog's le[] array */
+    if (HG_LIST_IS_EMPTY(&d->rings))
+        ring->le = d->le;
+    else {
+        ring->le = malloc(sizeof(*ring->le) * d->lesize);
+        if (!ring->le) {
+            free(ring);
+            ring = NULL;
+            goto done;
+        }
+    }
+    ring->dlog = d;
+    hg_atomic_init32(&ring->head, 0);
+    hg_atomic_init32(&ring->tail, 0);
+
+    if (hg_thread_setspecific(d->ring_key, ring) != HG_UTIL_SUCCESS) {
+        if (ring->le != d->le)
+            free(ring->le);
+        free(ring);
+        ring = NULL;
         goto done;
-    idx = d->lefree;
-    d->lefree = (d->lefree + 1) % d->lesize;
-    if (d->leadds < d->lesize)
-        d->leadds++;
-    d->le[idx] = (struct hg_dlog_entry){.file = file,
-        .line = line,
-        .func = func,
-        .msg = msg,
-        .data = data,
-        .time = hg_time_from_ms(0)};
-    hg_time_get_current(&d->le[idx].time);
-    rv = 1;
+    }
+    HG_LIST_INSERT_HEAD(&d->rings, ring, l);
 
 done:
     hg_thread_mutex_unlock(&d->dlock);
-    return rv;
+    return ring;
+}
+
+/*---------------------------------------------------------------------------*/
+static void
+hg_dlog_ring_retire(void *arg)
+{
+    struct hg_dlog_ring *ring = (struct hg_dlog_ring *) arg;
+    struct hg_dlog *d = ring->dlog;
+
+    hg_thread_mutex_lock(&d->dlock);
+    HG_LIST_INSERT_HEAD(&d->free_rings, ring, fl);
+    hg_thread_mutex_unlock(&d->dlock);
+}
+
+/*---------------------------------------------------------------------------*/
+static int
+hg_dlog_ring_read(const struct hg_dlog *d, struct hg_dlog_ring *ring,
+    uint32_t pos, struct hg_dlog_entry *le)
+{
+    struct hg_dlog_entry *src = &ring->le[pos % d->lesize];
+    int32_t seq = hg_atomic_get32(&src->seq);
+
+    if (seq != (int32_t) (pos + 1))
+        return 0;
+
+    le->file = src->file;
+    le->line = src->line;
+    le->func = src->func;
+    le->msg = src->msg;
+    le->data = src->data;
+    le->op_id = src->op_id;
+    le->size = src->size;
+    le->time = src->time;
+    hg_atomic_init32(&le->seq, seq);
+
+    /* entry is torn if the owner thread started overwriting it */
+    hg_atomic_fence();
+
+    return hg_atomic_get32(&src->seq) == seq;
+}
+
+/*---------------------------------------------------------------------------*/
+unsigned int
+hg_dlog_addlog(struct hg_dlog *d, const char *file, unsigned int line,
+    const char *func, const char *msg, const void *data)
+{
+    return hg_dlog_addevent(d, file, line, func, msg, data, 0, 0);
+}
+
+/*---------------------------------------------------------------------------*/
+unsigned int
+hg_dlog_addevent(struct hg_dlog *d, const char *file, unsigned int line,
+    const char *func, const char *event, const void *handle, uint64_t op_id,
+    size_t size)
+{
+    struct hg_dlog_ring *ring;
+    struct hg_dlog_entry *le;
+    uint32_t head;
+
+    if (d->lestop)
+        return 0;
+
+    ring = hg_dlog_get_ring(d);
+    if (!ring)
+        return 0;
+
+    head = (uint32_t) hg_atomic_get32(&ring->head);
+    if (d->leloop == 0 &&
+        head - (uint32_t) hg_atomic_get32(&ring->tail) >= d->lesize)
+        return 0;
+
+    le = &ring->le[head % d->lesize];
+
+    /* invalidate slot while it is written so that dumps can skip it */
+    hg_atomic_set32(&le->seq, 0);
+    hg_atomic_fence();
+
+    le->file = file;
+    le->line = line;
+    le->func = func;
+    le->msg = event;
+    le->data = handle;
+    le->op_id = op_id;
+    le->size = size;
+    hg_time_get_current(&le->time);
+
+    /* publish entry */
+    hg_atomic_set32(&le->seq, (int32_t) (head + 1));
+    hg_atomic_set32(&ring->head, (int32_t) (head + 1));
+
+    return 1;
 }
 
 /*---------------------------------------------------------------------------*/
@@ -179,18 +370,68 @@ hg_dlog_setlogstop(struct hg_dlog *d, int stop)
 void
 hg_dlog_resetlog(struct hg_dlog *d)
 {
+    struct hg_dlog_ring *ring;
+
+    /* only move tails, heads belong to owner threads */
     hg_thread_mutex_lock(&d->dlock);
-    d->lefree = 0;
-    d->leadds = 0;
+    HG_LIST_FOREACH (ring, &d->rings, l)
+        hg_atomic_set32(&ring->tail, hg_atomic_get32(&ring->head));
     hg_thread_mutex_unlock(&d->dlock);
 }
 
+/*---------------------------------------------------------------------------*/
+static struct hg_dlog_entry *
+hg_dlog_merge(struct hg_dlog *d, unsigned int *count_p)
+{
+    struct hg_dlog_entry *entries;
+    struct hg_dlog_ring *ring;
+    unsigned int count = 0, n = 0;
+
+    HG_LIST_FOREACH (ring, &d->rings, l)
+        count += d->lesize;
+    *count_p = 0;
+    if (count == 0)
+        return NULL;
+
+    entries = malloc(sizeof(*entries) * count);
+    if (!entries)
+        return NULL;
+
+    HG_LIST_FOREACH (ring, &d->rings, l) {
+        uint32_t head = (uint32_t) hg_atomic_get32(&ring->head);
+        uint32_t left = head - (uint32_t) hg_atomic_get32(&ring->tail);
+
+        if (left > d->lesize)
+            left = d->lesize;
+        while (left > 0)
+            n += (unsigned int) hg_dlog_ring_read(
+                d, ring, head - left--, &entries[n]);
+    }
+    qsort(entries, n, sizeof(*entries), hg_dlog_entry_cmp);
+    *count_p = n;
+
+    return entries;
+}
+
+/*---------------------------------------------------------------------------*/
+static int
+hg_dlog_entry_cmp(const void *a, const void *b)
+{
+    const struct hg_dlog_entry *le1 = (const struct hg_dlog_entry *) a;
+    const struct hg_dlog_entry *le2 = (const struct hg_dlog_entry *) b;
+
+    if (hg_time_less(le1->time, le2->time))
+        return -1;
+    return hg_time_less(le2->time, le1->time) ? 1 : 0;
+}
+
 /*---------------------------------------------------------------------------*/
 void
 hg_dlog_dump(struct hg_dlog *d, int (*log_func)(FILE *, const char *, ...),
     FILE *stream, int trylock)
 {
-    unsigned int left, idx;
+    struct hg_dlog_entry *entries;
+    unsigned int count, i;
     struct hg_dlog_dcount32 *dc32;
     struct hg_dlog_dcount64 *dc64;
 
@@ -203,7 +444,8 @@ hg_dlog_dump(struct hg_dlog *d, int (*log_func)(FILE *, const char *, ...),
     } else
         hg_thread_mutex_lock(&d->dlock);
 
-    if (d->leadds > 0) {
+    entries = hg_dlog_merge(d, &count);
+    if (count > 0) {
         log_func(stream,
             "### ----------------------\n"
             "### (%s) debug log summary\n"
@@ -222,18 +464,19 @@ hg_dlog_dump(struct hg_dlog *d, int (*log_func)(FILE *, const char *, ...),
             log_func(stream, "# -\n");
         }
 
-        log_func(stream, "# Number of log entries: %d\n", d->leadds);
+        log_func(stream, "# Number of log entries: %u\n", count);
 
-        idx = (d->lefree < d->leadds) ? d->lesize + d->lefree - d->leadds
-                                      : d->lefree - d->leadds;
-        left = d->leadds;
-        while (left--) {
+        for (i = 0; i < count; i++) {
             log_func(stream, "# [%lf] %s:%d\n## %s()\n",
-                hg_time_to_double(d->le[idx].time), d->le[idx].file,
-                d->le[idx].line, d->le[idx].func);
-            idx = (idx + 1) % d->lesize;
+                hg_time_to_double(entries[i].time), entries[i].file,
+                entries[i].line, entries[i].func);
+            if (entries[i].op_id || entries[i].size)
+                log_func(stream, "## %s %p op=%" PRIu64 " size=%zu\n",
+                    entries[i].msg, entries[i].data, entries[i].op_id,
+                    entries[i].size);
         }
     }
+    free(entries);
 
     hg_thread_mutex_unlock(&d->dlock);
 }
@@ -284,7 +527,8 @@ hg_dlog_dump_file(struct hg_dlog *d, const char *base, int addpid, int trylock)
     char buf[BUFSIZ];
     int pid;
     FILE *fp = NULL;
-    unsigned int left, idx;
+    struct hg_dlog_entry *entries;
+    unsigned int count, i;
     struct hg_dlog_dcount32 *dc32;
     struct hg_dlog_dcount64 *dc64;
 
@@ -326,18 +570,135 @@ hg_dlog_dump_file(struct hg_dlog *d, const char *base, int addpid, int trylock)
     }
     fprintf(fp, "# END COUNTERS\n\n");
 
-    fprintf(fp, "# NLOGS %d FOR %d\n", d->leadds, pid);
+    entries = hg_dlog_merge(d, &count);
+    fprintf(fp, "# NLOGS %u FOR %d\n", count, pid);
+
+    for (i = 0; i < count; i++)
+        fprintf(fp, "%lf %d %s %u %s %s %p %" PRIu64 " %zu\n",
+            hg_time_to_double(entries[i].time), pid, entries[i].file,
+            entries[i].line, entries[i].func,
+            entries[i].msg ? entries[i].msg : "(null)", entries[i].data,
+            entries[i].op_id, entries[i].size);
+    free(entries);
+
+    hg_thread_mutex_unlock(&d->dlock);
+    fclose(fp);
+}
+
+/*---------------------------------------------------------------------------*/
+static int
+hg_dlog_trace_entry_cmp(const void *a, const void *b)
+{
+    const struct hg_dlog_trace_entry *te1 =
+        (const struct hg_dlog_trace_entry *) a;
+    const struct hg_dlog_trace_entry *te2 =
+        (const struct hg_dlog_trace_entry *) b;
+
+    if (te1->le.op_id != te2->le.op_id)
+        return (te1->le.op_id < te2->le.op_id) ? -1 : 1;
 
-    idx = (d->lefree < d->leadds) ? d->lesize + d->lefree - d->leadds
-                                  : d->lefree - d->leadds;
-    left = d->leadds;
-    while (left--) {
-        fprintf(fp, "%lf %d %s %u %s %s %p\n",
-            hg_time_to_double(d->le[idx].time), pid, d->le[idx].file,
-            d->le[idx].line, d->le[idx].func, d->le[idx].msg, d->le[idx].data);
-        idx = (idx + 1) % d->lesize;
+    return hg_dlog_entry_cmp(&te1->le, &te2->le);
+}
+
+/*---------------------------------------------------------------------------*/
+int
+hg_dlog_dump_trace(struct hg_dlog *d, const char *base, int addpid)
+{
+    char buf[BUFSIZ];
+    int pid;
+    FILE *fp = NULL;
+    struct hg_dlog_trace_entry *entries = NULL;
+    struct hg_dlog_ring *ring;
+    unsigned int count = 0, n = 0, tid = 0, i;
+    const char *dname = d->dlog_magic + strlen(HG_DLOG_STDMAGIC);
+    const char *sep = "";
+
+#ifdef _WIN32
+    pid = _getpid();
+#else
+    pid = getpid();
+#endif
+
+    if (addpid)
+        snprintf(buf, sizeof(buf), "%s-%d.json", base, pid);
+    else
+        snprintf(buf, sizeof(buf), "%s.json", base);
+
+    fp = fopen(buf, "w");
+    if (!fp) {
+        perror("fopen");
+        return HG_UTIL_FAIL;
     }
 
+    /* copy entries out of the rings so that the lock is not held while
+     * writing */
+    hg_thread_mutex_lock(&d->dlock);
+    HG_LIST_FOREACH (ring, &d->rings, l)
+        count += d->lesize;
+    if (count > 0)
+        entries = malloc(sizeof(*entries) * count);
+    if (entries) {
+        HG_LIST_FOREACH (ring, &d->rings, l) {
+            uint32_t head = (uint32_t) hg_atomic_get32(&ring->head);
+            uint32_t left = head - (uint32_t) hg_atomic_get32(&ring->tail);
+
+            if (left > d->lesize)
+                left = d->lesize;
+            while (left > 0) {
+                if (!hg_dlog_ring_read(d, ring, head - left--, &entries[n].le))
+                    continue;
+                entries[n++].tid = tid;
+            }
+            tid++;
+        }
+    }
     hg_thread_mutex_unlock(&d->dlock);
+    if (count > 0 && !entries) {
+        fclose(fp);
+        return HG_UTIL_FAIL;
+    }
+
+    /* group entries of the same op together, in time order */
+    qsort(entries, n, sizeof(*entries), hg_dlog_trace_entry_cmp);
+
+    fprintf(fp, "{\"displayTimeUnit\": \"ns\", \"traceEvents\": [\n");
+    for (i = 0; i < n; i++) {
+        const struct hg_dlog_entry *le = &entries[i].le;
+        const char *name = le->msg ? le->msg : le->func;
+
+        fprintf(fp,
+            "%s{\"name\": \"%s\", \"cat\": \"%s\", \"ph\": \"i\", "
+            "\"s\": \"t\", \"ts\": %.3f, \"pid\": %d, \"tid\": %u, "
+            "\"args\": {\"func\": \"%s\", \"handle\": \"%p\", "
+            "\"op_id\": %" PRIu64 ", \"size\": %zu}}",
+            sep, name, dname, hg_time_to_double(le->time) * 1e6, pid,
+            entries[i].tid, le->func, le->data, le->op_id, le->size);
+        sep = ",\n";
+
+        /* span from this stage to the next stage of the same op */
+        if (le->op_id != 0 && i + 1 < n &&
+            entries[i + 1].le.op_id == le->op_id) {
+            const struct hg_dlog_entry *next = &entries[i + 1].le;
+            const char *next_name = next->msg ? next->msg : next->func;
+
+            fprintf(fp,
+                ",\n{\"name\": \"%s -> %s\", \"cat\": \"%s\", "
+                "\"ph\": \"b\", \"id\": %" PRIu64 ", \"ts\": %.3f, "
+                "\"pid\": %d, \"tid\": %u}",
+                name, next_name, dname, le->op_id,
+                hg_time_to_double(le->time) * 1e6, pid, entries[i].tid);
+            fprintf(fp,
+                ",\n{\"name\": \"%s -> %s\", \"cat\": \"%s\", "
+                "\"ph\": \"e\", \"id\": %" PRIu64 ", \"ts\": %.3f, "
+                "\"pid\": %d, \"tid\": %u}",
+                name, next_name, dname, le->op_id,
+                hg_time_to_double(next->time) * 1e6, pid, entries[i + 1].tid);
+        }
+    }
+    fprintf(fp, "\n]}\n");
+
+    free(entries);
     fclose(fp);
+
+    return HG_UTIL_SUCCESS;
 }
@@ -12,6 +12,7 @@
 
 #include "mercury_atomic.h"
 #include "mercury_list.h"
+#include "mercury_thread.h"
 #include "mercury_thread_mutex.h"
 #include "mercury_time.h"
 
@@ -30,7 +31,10 @@
 
 /*
  * HG_DLOG_INITIALIZER: initializer for a dlog in a global variable.
- * LESIZE is the number of entries in the LE array.  use it like this:
+ * LESIZE is the number of entries in the LE array.  the LE array is
+ * used as the log ring of the first thread that adds a log record,
+ * other threads get their own malloc'd ring of LESIZE entries.  rings of
+ * exited threads are reused by new threads.  use it like this:
  *
  * #define FOO_NENTS 128
  * struct hg_dlog_entry foo_le[FOO_NENTS];
@@ -40,7 +44,10 @@
     {                                                                          \
         HG_DLOG_STDMAGIC NAME, HG_THREAD_MUTEX_INITIALIZER,                    \
             HG_LIST_HEAD_INITIALIZER(cnts32),                                  \
-            HG_LIST_HEAD_INITIALIZER(cnts64), LE, LESIZE, LELOOP, 0, 0, 0, 0   \
+            HG_LIST_HEAD_INITIALIZER(cnts64),                                  \
+            HG_LIST_HEAD_INITIALIZER(rings),                                   \
+            HG_LIST_HEAD_INITIALIZER(free_rings), 0, HG_ATOMIC_VAR_INIT(0),    \
+            LE, LESIZE, LELOOP, 0, 0                                           \
     }
 
 /*************************************/
@@ -51,12 +58,30 @@
  * hg_dlog_entry: an entry in the dlog
  */
 struct hg_dlog_entry {
-    const char *file;  /* file name */
-    unsigned int line; /* line number */
-    const char *func;  /* function name */
-    const char *msg;   /* entry message (optional) */
-    const void *data;  /* user data (optional) */
-    hg_time_t time;    /* time added to log */
+    const char *file;      /* file name */
+    unsigned int line;     /* line number */
+    const char *func;      /* function name */
+    const char *msg;       /* entry message or event name (optional) */
+    const void *data;      /* user data or handle (optional) */
+    uint64_t op_id;        /* operation ID (optional) */
+    size_t size;           /* operation size (optional) */
+    hg_time_t time;        /* time added to log */
+    hg_atomic_int32_t seq; /* ring position + 1 (0 while being written) */
+};
+
+/*
+ * hg_dlog_ring: per-thread ring of log entries.  only the owner thread
+ * writes entries and advances head, so adding a log record takes no lock.
+ * when the owner thread exits, the ring is retired to the free list of
+ * the dlog and handed to the next thread that needs a ring.
+ */
+struct hg_dlog_ring {
+    struct hg_dlog_entry *le;       /* array of log entries */
+    struct hg_dlog *dlog;           /* dlog that owns the ring */
+    hg_atomic_int32_t head;         /* #adds done by owner thread */
+    hg_atomic_int32_t tail;         /* value of head at last reset */
+    HG_LIST_ENTRY(hg_dlog_ring) l;  /* linkage */
+    HG_LIST_ENTRY(hg_dlog_ring) fl; /* free list linkage */
 };
 
 /*
@@ -90,12 +115,16 @@ struct hg_dlog {
     HG_LIST_HEAD(hg_dlog_dcount32) cnts32; /* counter list */
     HG_LIST_HEAD(hg_dlog_dcount64) cnts64; /* counter list */
 
+    /* per-thread log rings */
+    HG_LIST_HEAD(hg_dlog_ring) rings;      /* ring list */
+    HG_LIST_HEAD(hg_dlog_ring) free_rings; /* rings of exited threads */
+    hg_thread_key_t ring_key;              /* key to calling thread's ring */
+    hg_atomic_int32_t ring_key_init;       /* ring_key was created */
+
     /* log */
-    struct hg_dlog_entry *le; /* array of log entries */
-    unsigned int lesize;      /* size of le[] array */
+    struct hg_dlog_entry *le; /* log entries of first ring */
+    unsigned int lesize;      /* size of le[] array of each ring */
     int leloop;               /* circular buffer? */
-    unsigned int lefree;      /* next free entry in le[] */
-    unsigned int leadds;      /* #adds done if < lesize */
     int lestop;               /* stop taking new logs */
 
     int mallocd; /* allocated with malloc? */
@@ -181,7 +210,8 @@ hg_dlog_mkcount64(struct hg_dlog *d, hg_atomic_int64_t **cptr, const char *name,
 /**
  * attempt to add a log record to a dlog.  the id and msg should point
  * to static strings that are valid throughout the life of the program
- * (not something that is is on the stack).
+ * (not something that is is on the stack).  records are added to the
+ * calling thread's ring without taking the dlog lock.
  *
  * \param d [IN]                the dlog to add the log record to
  * \param file [IN]             file entry
@@ -196,6 +226,26 @@ HG_UTIL_PUBLIC unsigned int
 hg_dlog_addlog(struct hg_dlog *d, const char *file, unsigned int line,
     const char *func, const char *msg, const void *data);
 
+/**
+ * attempt to add a binary trace event to a dlog.  same as
+ * hg_dlog_addlog() with an operation ID and size attached to the record.
+ *
+ * \param d [IN]                the dlog to add the event to
+ * \param file [IN]             file entry
+ * \param line [IN]             line entry
+ * \param func [IN]             func entry
+ * \param event [IN]            static event name
+ * \param handle [IN]           handle pointer (optional, NULL ok)
+ * \param op_id [IN]            operation ID
+ * \param size [IN]             operation size
+ *
+ * \return 1 if added, 0 otherwise
+ */
+HG_UTIL_PUBLIC unsigned int
+hg_dlog_addevent(struct hg_dlog *d, const char *file, unsigned int line,
+    const char *func, const char *event, const void *handle, uint64_t op_id,
+    size_t size);
+
 /**
  * set the value of stop for a dlog (to enable/disable logging)
  *
@@ -218,7 +268,9 @@ hg_dlog_resetlog(struct hg_dlog *d);
 /**
  * dump dlog info to a stream. set trylock if you want to dump even
  * if it is locked (e.g. you are crashing and you don't care about
- * locking).
+ * locking).  entries of all thread rings are merged in time order.
+ * threads that keep logging while the dump is in progress may overwrite
+ * the oldest entries of a circular log, overwritten entries are skipped.
  *
  * \param d [IN]                dlog to dump
  * \param log_func [IN]         log function to use (default printf)
@@ -257,6 +309,24 @@ hg_dlog_dump_counters(struct hg_dlog *d,
 HG_UTIL_PUBLIC void
 hg_dlog_dump_file(struct hg_dlog *d, const char *base, int addpid, int trylock);
 
+/**
+ * dump dlog entries to a file in chrome trace-event JSON format (loadable
+ * in chrome://tracing or perfetto).  each entry becomes an instant event
+ * on the track of the thread that recorded it, and consecutive entries
+ * that share a non-zero op_id are joined by async spans named after the
+ * two events, so that the time spent between two stages of an operation
+ * shows up directly.  the output file is "base.json" or "base-pid.json"
+ * depending on the value of addpid.
+ *
+ * \param d [IN]                dlog to dump
+ * \param base [IN]             output file basename
+ * \param addpid [IN]           add pid to output filename
+ *
+ * \return HG_UTIL_SUCCESS or HG_UTIL_FAIL
+ */
+HG_UTIL_PUBLIC int
+hg_dlog_dump_trace(struct hg_dlog *d, const char *base, int addpid);
+
 #ifdef __cplusplus
 }
 #endif
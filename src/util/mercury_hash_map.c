@@ -0,0 +1,493 @@
+/**
+ * Copyright (c) 2013-2022 UChicago Argonne, LLC and The HDF Group.
+ * Copyright (c) 2022 Intel Corporation.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "mercury_hash_map.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__SSE2__) || defined(_M_X64) ||                                    \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#    include <emmintrin.h>
+#    define HG_HASH_MAP_HAS_SSE2
+#endif
+
+/****************/
+/* Local Macros */
+/****************/
+
+/* Number of slots probed at once */
+#define HG_HASH_MAP_GROUP_WIDTH (16)
+
+/* Control bytes, full slots store the lower 7 bits of the hash */
+#define HG_HASH_MAP_CTRL_EMPTY   ((int8_t) -128) /* 0b10000000 */
+#define HG_HASH_MAP_CTRL_DELETED ((int8_t) -2)   /* 0b11111110 */
+
+/* Maximum load factor of 7/8 */
+#define HG_HASH_MAP_MAX_LOAD(capacity) ((capacity) - (capacity) / 8)
+
+/* Hash split into group position (H1) and control byte (H2) */
+#define HG_HASH_MAP_H1(hash) ((size_t) ((hash) >> 7))
+#define HG_HASH_MAP_H2(hash) ((int8_t) ((hash) &0x7f))
+
+/* Slot accessors */
+#define HG_HASH_MAP_SLOT(hash_map, index)                                      \
+    ((hash_map)->slots + (index) * (hash_map)->slot_size)
+#define HG_HASH_MAP_VALUE(hash_map, slot)                                      \
+    (*((void **) ((slot) + (hash_map)->value_offset)))
+
+/************************************/
+/* Local Type and Struct Definition */
+/************************************/
+
+/* Hash map */
+struct hg_hash_map {
+    hg_hash_map_value_free_func_t value_free_func; /* Value free function */
+    int8_t *ctrl;        /* Control bytes (one per slot) */
+    char *slots;         /* Slots (key followed by value) */
+    size_t key_size;     /* Key size */
+    size_t value_offset; /* Offset of value within slot */
+    size_t slot_size;    /* Slot size */
+    size_t capacity;     /* Number of slots */
+    size_t growth_left;  /* Number of insertions left before rehash */
+    unsigned int size;   /* Number of entries */
+};
+
+/********************/
+/* Local Prototypes */
+/********************/
+
+/* Mix hash bits */
+static HG_UTIL_INLINE uint64_t
+hg_hash_map_mix(uint64_t h);
+
+/* Hash key */
+static HG_UTIL_INLINE uint64_t
+hg_hash_map_hash(const void *key, size_t key_size);
+
+/* Compare keys */
+static HG_UTIL_INLINE int
+hg_hash_map_key_equal(const void *key1, const void *key2, size_t key_size);
+
+/* Return bitmask of slots in group whose control byte is h2 */
+static HG_UTIL_INLINE unsigned int
+hg_hash_map_group_match(const int8_t *group, int8_t h2);
+
+/* Return bitmask of slots in group that are empty or deleted */
+static HG_UTIL_INLINE unsigned int
+hg_hash_map_group_match_free(const int8_t *group);
+
+/* Count trailing zeros */
+static HG_UTIL_INLINE unsigned int
+hg_hash_map_ctz(unsigned int mask);
+
+/* Find slot index of key, return capacity if not found */
+static HG_UTIL_INLINE size_t
+hg_hash_map_find(const hg_hash_map_t *hash_map, const void *key, uint64_t hash);
+
+/* Find first free slot index for hash */
+static HG_UTIL_INLINE size_t
+hg_hash_map_find_free(const hg_hash_map_t *hash_map, uint64_t hash);
+
+/* Allocate slots */
+static int
+hg_hash_map_alloc(hg_hash_map_t *hash_map, size_t capacity);
+
+/* Rehash into new capacity */
+static int
+hg_hash_map_rehash(hg_hash_map_t *hash_map, size_t capacity);
+
+/*---------------------------------------------------------------------------*/
+static HG_UTIL_INLINE uint64_t
+hg_hash_map_mix(uint64_t h)
+{
+    /* 64-bit finalizer from MurmurHash3 */
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ULL;
+    h ^= h >> 33;
+
+    return h;
+}
+
+/*---------------------------------------------------------------------------*/
+static HG_UTIL_INLINE uint64_t
+hg_hash_map_hash(const void *key, size_t key_size)
+{
+    const unsigned char *p = (const unsigned char *) key;
+    uint64_t h = 0x9e3779b97f4a7c15ULL ^ (uint64_t) key_size, k;
+
+    /* Fast path for 64-bit keys */
+    if (key_size == sizeof(k)) {
+        memcpy(&k, p, sizeof(k));
+        return hg_hash_map_mix(h ^ k);
+    }
+
+    for (; key_size >= sizeof(k); key_size -= sizeof(k), p += sizeof(k)) {
+        memcpy(&k, p, sizeof(k));
+        h = hg_hash_map_mix(h ^ k);
+    }
+    if (key_size > 0) {
+        k = 0;
+        memcpy(&k, p, key_size);
+        h = hg_hash_map_mix(h ^ k);
+    }
+
+    return h;
+}
+
+/*---------------------------------------------------------------------------*/
+static HG_UTIL_INLINE int
+hg_hash_map_key_equal(const void *key1, const void *key2, size_t key_size)
+{
+    /* Fast path for 64-bit keys */
+    if (key_size == sizeof(uint64_t)) {
+        uint64_t k1, k2;
+
+        memcpy(&k1, key1, sizeof(k1));
+        memcpy(&k2, key2, sizeof(k2));
+
+        return k1 == k2;
+    }
+
+    return memcmp(key1, key2, key_size) == 0;
+}
+
+/*---------------------------------------------------------------------------*/
+static HG_UTIL_INLINE unsigned int
+hg_hash_map_group_match(const int8_t *group, int8_t h2)
+{
+#ifdef HG_HASH_MAP_HAS_SSE2
+    __m128i ctrl = _mm_loadu_si128((const __m128i *) group);
+
+    return (unsigned int) _mm_movemask_epi8(
+        _mm_cmpeq_epi8(_mm_set1_epi8((char) h2), ctrl));
+#else
+    unsigned int i, mask = 0;
+
+    for (i = 0; i < HG_HASH_MAP_GROUP_WIDTH; i++)
+        mask |= (unsigned int) (group[i] == h2) << i;
+
+    return mask;
+#endif
+}
+
+/*---------------------------------------------------------------------------*/
+static HG_UTIL_INLINE unsigned int
+hg_hash_map_group_match_free(const int8_t *group)
+{
+#ifdef HG_HASH_MAP_HAS_SSE2
+    /* Empty and deleted control bytes have their sign bit set */
+    return (unsigned int) _mm_movemask_epi8(
+        _mm_loadu_si128((const __m128i *) group));
+#else
+    unsigned int i, mask = 0;
+
+    for (i = 0; i < HG_HASH_MAP_GROUP_WIDTH; i++)
+        mask |= (unsigned int) (group[i] < 0) << i;
+
+    return mask;
+#endif
+}
+
+/*---------------------------------------------------------------------------*/
+static HG_UTIL_INLINE unsigned int
+hg_hash_map_ctz(unsigned int mask)
+{
+#if defined(__GNUC__)
+    return (unsigned int) __builtin_ctz(mask);
+#else
+    unsigned int n = 0;
+
+    while (!(mask & 1)) {
+        mask >>= 1;
+        n++;
+    }
+
+    return n;
+#endif
+}
+
+/*---------------------------------------------------------------------------*/
+static HG_UTIL_INLINE size_t
+hg_hash_map_find(const hg_hash_map_t *hash_map, const void *key, uint64_t hash)
+{
+    size_t group_mask = hash_map->capacity / HG_HASH_MAP_GROUP_WIDTH - 1;
+    size_t group = HG_HASH_MAP_H1(hash) & group_mask, stride = 0;
+    int8_t h2 = HG_HASH_MAP_H2(hash);
+
+    /* Triangular probing visits every group once, the load factor guarantees
+     * that an empty slot is eventually found */
+    for (;;) {
+        const int8_t *ctrl = hash_map->ctrl + group * HG_HASH_MAP_GROUP_WIDTH;
+        unsigned int match = hg_hash_map_group_match(ctrl, h2);
+
+        while (match != 0) {
+            size_t index =
+                group * HG_HASH_MAP_GROUP_WIDTH + hg_hash_map_ctz(match);
+
+            if (hg_hash_map_key_equal(HG_HASH_MAP_SLOT(hash_map, index), key,
+                    hash_map->key_size))
+                return index;
+            match &= match - 1;
+        }
+        if (hg_hash_map_group_match(ctrl, HG_HASH_MAP_CTRL_EMPTY) != 0)
+            return hash_map->capacity;
+
+        group = (group + ++stride) & group_mask;
+    }
+}
+
+/*---------------------------------------------------------------------------*/
+static HG_UTIL_INLINE size_t
+hg_hash_map_find_free(const hg_hash_map_t *hash_map, uint64_t hash)
+{
+    size_t group_mask = hash_map->capacity / HG_HASH_MAP_GROUP_WIDTH - 1;
+    size_t group = HG_HASH_MAP_H1(hash) & group_mask, stride = 0;
+
+    for (;;) {
+        unsigned int match = hg_hash_map_group_match_free(
+            hash_map->ctrl + group * HG_HASH_MAP_GROUP_WIDTH);
+
+        if (match != 0)
+            return group * HG_HASH_MAP_GROUP_WIDTH + hg_hash_map_ctz(match);
+
+        group = (group + ++stride) & group_mask;
+    }
+}
+
+/*---------------------------------------------------------------------------*/
+static int
+hg_hash_map_alloc(hg_hash_map_t *hash_map, size_t capacity)
+{
+    /* Control bytes and slots share the same allocation, capacity is a
+     * multiple of the group width so that slots remain aligned */
+    hash_map->ctrl =
+        (int8_t *) malloc(capacity + capacity * hash_map->slot_size);
+    if (hash_map->ctrl == NULL)
+        return 0;
+
+    memset(hash_map->ctrl, HG_HASH_MAP_CTRL_EMPTY, capacity);
+    hash_map->slots = (char *) hash_map->ctrl + capacity;
+    hash_map->capacity = capacity;
+    hash_map->growth_left = HG_HASH_MAP_MAX_LOAD(capacity) - hash_map->size;
+
+    return 1;
+}
+
+/*---------------------------------------------------------------------------*/
+static int
+hg_hash_map_rehash(hg_hash_map_t *hash_map, size_t capacity)
+{
+    int8_t *old_ctrl = hash_map->ctrl;
+    char *old_slots = hash_map->slots;
+    size_t old_capacity = hash_map->capacity, i;
+
+    if (!hg_hash_map_alloc(hash_map, capacity)) {
+        hash_map->ctrl = old_ctrl;
+        hash_map->slots = old_slots;
+        hash_map->capacity = old_capacity;
+        return 0;
+    }
+
+    /* Move full slots, no tombstone is carried over */
+    for (i = 0; i < old_capacity; i++) {
+        const char *old_slot;
+        uint64_t hash;
+        size_t index;
+
+        if (old_ctrl[i] < 0)
+            continue;
+
+        old_slot = old_slots + i * hash_map->slot_size;
+        hash = hg_hash_map_hash(old_slot, hash_map->key_size);
+        index = hg_hash_map_find_free(hash_map, hash);
+        hash_map->ctrl[index] = HG_HASH_MAP_H2(hash);
+        memcpy(HG_HASH_MAP_SLOT(hash_map, index), old_slot,
+            hash_map->slot_size);
+    }
+    free(old_ctrl);
+
+    return 1;
+}
+
+/*---------------------------------------------------------------------------*/
+hg_hash_map_t *
+hg_hash_map_new(size_t key_size)
+{
+    hg_hash_map_t *hash_map;
+
+    if (key_size == 0)
+        return NULL;
+
+    hash_map = (hg_hash_map_t *) malloc(sizeof(*hash_map));
+    if (hash_map == NULL)
+        return NULL;
+
+    hash_map->value_free_func = NULL;
+    hash_map->key_size = key_size;
+    hash_map->value_offset =
+        (key_size + sizeof(void *) - 1) & ~(sizeof(void *) - 1);
+    hash_map->slot_size = hash_map->value_offset + sizeof(void *);
+    hash_map->size = 0;
+
+    if (!hg_hash_map_alloc(hash_map, HG_HASH_MAP_GROUP_WIDTH)) {
+        free(hash_map);
+        return NULL;
+    }
+
+    return hash_map;
+}
+
+/*---------------------------------------------------------------------------*/
+void
+hg_hash_map_free(hg_hash_map_t *hash_map)
+{
+    if (hash_map == NULL)
+        return;
+
+    if (hash_map->value_free_func != NULL) {
+        size_t i;
+
+        for (i = 0; i < hash_map->capacity; i++)
+            if (hash_map->ctrl[i] >= 0)
+                hash_map->value_free_func(HG_HASH_MAP_VALUE(
+                    hash_map, HG_HASH_MAP_SLOT(hash_map, i)));
+    }
+    free(hash_map->ctrl);
+    free(hash_map);
+}
+
+/*---------------------------------------------------------------------------*/
+void
+hg_hash_map_register_free_function(
+    hg_hash_map_t *hash_map, hg_hash_map_value_free_func_t value_free_func)
+{
+    hash_map->value_free_func = value_free_func;
+}
+
+/*---------------------------------------------------------------------------*/
+int
+hg_hash_map_insert(hg_hash_map_t *hash_map, const void *key, void *value)
+{
+    uint64_t hash = hg_hash_map_hash(key, hash_map->key_size);
+    size_t index = hg_hash_map_find(hash_map, key, hash);
+    char *slot;
+
+    if (index < hash_map->capacity) {
+        /* Overwrite existing entry */
+        slot = HG_HASH_MAP_SLOT(hash_map, index);
+        if (hash_map->value_free_func != NULL)
+            hash_map->value_free_func(HG_HASH_MAP_VALUE(hash_map, slot));
+        HG_HASH_MAP_VALUE(hash_map, slot) = value;
+
+        return 1;
+    }
+
+    if (hash_map->growth_left == 0) {
+        /* Only purge tombstones if less than half of the slots are used */
+        size_t capacity = (hash_map->size < hash_map->capacity / 2)
+                              ? hash_map->capacity
+                              : hash_map->capacity * 2;
+
+        if (!hg_hash_map_rehash(hash_map, capacity))
+            return 0;
+    }
+
+    index = hg_hash_map_find_free(hash_map, hash);
+    if (hash_map->ctrl[index] == HG_HASH_MAP_CTRL_EMPTY)
+        hash_map->growth_left--;
+    hash_map->ctrl[index] = HG_HASH_MAP_H2(hash);
+
+    slot = HG_HASH_MAP_SLOT(hash_map, index);
+    memcpy(slot, key, hash_map->key_size);
+    HG_HASH_MAP_VALUE(hash_map, slot) = value;
+    hash_map->size++;
+
+    return 1;
+}
+
+/*---------------------------------------------------------------------------*/
+void *
+hg_hash_map_lookup(hg_hash_map_t *hash_map, const void *key)
+{
+    size_t index = hg_hash_map_find(
+        hash_map, key, hg_hash_map_hash(key, hash_map->key_size));
+
+    return (index < hash_map->capacity)
+               ? HG_HASH_MAP_VALUE(hash_map, HG_HASH_MAP_SLOT(hash_map, index))
+               : NULL;
+}
+
+/*---------------------------------------------------------------------------*/
+int
+hg_hash_map_remove(hg_hash_map_t *hash_map, const void *key)
+{
+    size_t index = hg_hash_map_find(
+        hash_map, key, hg_hash_map_hash(key, hash_map->key_size));
+    const int8_t *group;
+
+    if (index == hash_map->capacity)
+        return 0;
+
+    if (hash_map->value_free_func != NULL)
+        hash_map->value_free_func(
+            HG_HASH_MAP_VALUE(hash_map, HG_HASH_MAP_SLOT(hash_map, index)));
+
+    /* If the group still has an empty slot, no probe sequence can have gone
+     * past it and the slot can be marked as empty rather than deleted */
+    group = hash_map->ctrl + (index & ~((size_t) HG_HASH_MAP_GROUP_WIDTH - 1));
+    if (hg_hash_map_group_match(group, HG_HASH_MAP_CTRL_EMPTY) != 0) {
+        hash_map->ctrl[index] = HG_HASH_MAP_CTRL_EMPTY;
+        hash_map->growth_left++;
+    } else
+        hash_map->ctrl[index] = HG_HASH_MAP_CTRL_DELETED;
+    hash_map->size--;
+
+    return 1;
+}
+
+/*---------------------------------------------------------------------------*/
+unsigned int
+hg_hash_map_num_entries(hg_hash_map_t *hash_map)
+{
+    return hash_map->size;
+}
+
+/*---------------------------------------------------------------------------*/
+void
+hg_hash_map_iterate(hg_hash_map_t *hash_map, hg_hash_map_iter_t *iter)
+{
+    iter->hash_map = hash_map;
+    iter->index = 0;
+}
+
+/*---------------------------------------------------------------------------*/
+int
+hg_hash_map_iter_has_more(hg_hash_map_iter_t *iter)
+{
+    const hg_hash_map_t *hash_map = iter->hash_map;
+
+    while (iter->index < hash_map->capacity && hash_map->ctrl[iter->index] < 0)
+        iter->index++;
+
+    return iter->index < hash_map->capacity;
+}
+
+/*---------------------------------------------------------------------------*/
+void *
+hg_hash_map_iter_next(hg_hash_map_iter_t *iter)
+{
+    hg_hash_map_t *hash_map = iter->hash_map;
+
+    if (!hg_hash_map_iter_has_more(iter))
+        return NULL;
+
+    return HG_HASH_MAP_VALUE(
+        hash_map, HG_HASH_MAP_SLOT(hash_map, iter->index++));
+}
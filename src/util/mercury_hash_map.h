@@ -0,0 +1,159 @@
+/**
+ * Copyright (c) 2013-2022 UChicago Argonne, LLC and The HDF Group.
+ * Copyright (c) 2022 Intel Corporation.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef MERCURY_HASH_MAP_H
+#define MERCURY_HASH_MAP_H
+
+#include "mercury_util_config.h"
+
+/*************************************/
+/* Public Type and Struct Definition */
+/*************************************/
+
+/**
+ * Open-addressing hash map with fixed-size keys. Keys are copied inline into
+ * the map's slots and compared bytewise, they must therefore not contain
+ * uninitialized padding. Slots are grouped by 16 and each slot is associated
+ * to a one-byte control word holding 7 bits of the key's hash, so that a
+ * whole group can be probed at once (using SSE2 when available). Entries are
+ * stored in a single array, inserting an entry never allocates unless the map
+ * needs to grow.
+ */
+typedef struct hg_hash_map hg_hash_map_t;
+
+/* Iterator */
+typedef struct hg_hash_map_iter {
+    hg_hash_map_t *hash_map; /* Hash map */
+    size_t index;            /* Next slot index */
+} hg_hash_map_iter_t;
+
+/* Value free function */
+typedef void (*hg_hash_map_value_free_func_t)(void *value);
+
+/*****************/
+/* Public Macros */
+/*****************/
+
+/*********************/
+/* Public Prototypes */
+/*********************/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Create a new hash map.
+ *
+ * \param key_size [IN]         size of keys (in bytes)
+ *
+ * \return pointer to hash map or NULL on failure
+ */
+HG_UTIL_PUBLIC hg_hash_map_t *
+hg_hash_map_new(size_t key_size);
+
+/**
+ * Destroy a hash map. If a value free function was registered, it is called
+ * on each remaining value.
+ *
+ * \param hash_map [IN/OUT]     pointer to hash map
+ */
+HG_UTIL_PUBLIC void
+hg_hash_map_free(hg_hash_map_t *hash_map);
+
+/**
+ * Register function used to free values when entries are removed, replaced
+ * or when the hash map is destroyed.
+ *
+ * \param hash_map [IN/OUT]     pointer to hash map
+ * \param value_free_func [IN]  value free function
+ */
+HG_UTIL_PUBLIC void
+hg_hash_map_register_free_function(
+    hg_hash_map_t *hash_map, hg_hash_map_value_free_func_t value_free_func);
+
+/**
+ * Insert a value into a hash map, overwriting any existing entry using the
+ * same key. Values cannot be NULL.
+ *
+ * \param hash_map [IN/OUT]     pointer to hash map
+ * \param key [IN]              pointer to key (key_size bytes are copied)
+ * \param value [IN]            value
+ *
+ * \return Non-zero if the value was added successfully, or zero if it was not
+ * possible to allocate memory for the new entry
+ */
+HG_UTIL_PUBLIC int
+hg_hash_map_insert(hg_hash_map_t *hash_map, const void *key, void *value);
+
+/**
+ * Look up a value in a hash map by key.
+ *
+ * \param hash_map [IN]         pointer to hash map
+ * \param key [IN]              pointer to key
+ *
+ * \return value or NULL if there is no value with that key
+ */
+HG_UTIL_PUBLIC void *
+hg_hash_map_lookup(hg_hash_map_t *hash_map, const void *key);
+
+/**
+ * Remove a value from a hash map.
+ *
+ * \param hash_map [IN/OUT]     pointer to hash map
+ * \param key [IN]              pointer to key
+ *
+ * \return Non-zero if a key was removed, or zero if the key was not found
+ */
+HG_UTIL_PUBLIC int
+hg_hash_map_remove(hg_hash_map_t *hash_map, const void *key);
+
+/**
+ * Retrieve the number of entries in a hash map.
+ *
+ * \param hash_map [IN]         pointer to hash map
+ *
+ * \return number of entries
+ */
+HG_UTIL_PUBLIC unsigned int
+hg_hash_map_num_entries(hg_hash_map_t *hash_map);
+
+/**
+ * Initialize iterator to iterate over the values of a hash map. The hash map
+ * must not be modified while it is being iterated over.
+ *
+ * \param hash_map [IN]         pointer to hash map
+ * \param iter [OUT]            pointer to iterator
+ */
+HG_UTIL_PUBLIC void
+hg_hash_map_iterate(hg_hash_map_t *hash_map, hg_hash_map_iter_t *iter);
+
+/**
+ * Determine if there are more values to iterate over.
+ *
+ * \param iter [IN/OUT]         pointer to iterator
+ *
+ * \return Non-zero if there are more values, zero otherwise
+ */
+HG_UTIL_PUBLIC int
+hg_hash_map_iter_has_more(hg_hash_map_iter_t *iter);
+
+/**
+ * Retrieve the next value.
+ *
+ * \param iter [IN/OUT]         pointer to iterator
+ *
+ * \return next value or NULL if there are no more values
+ */
+HG_UTIL_PUBLIC void *
+hg_hash_map_iter_next(hg_hash_map_iter_t *iter);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MERCURY_HASH_MAP_H */
@@ -133,6 +133,15 @@
         }                                                                      \
     } while (0)
 
+/* Record a trace event (handle, op id, size) in the debug log */
+#define HG_LOG_EVENT(name, event, handle, op_id, size)                         \
+    do {                                                                       \
+        if (HG_LOG_OUTLET(name).level >= HG_LOG_LEVEL_MIN_DEBUG &&             \
+            HG_LOG_OUTLET(name).debug_log)                                     \
+            hg_dlog_addevent(HG_LOG_OUTLET(name).debug_log, __FILE__,          \
+                __LINE__, __func__, event, handle, op_id, size);               \
+    } while (0)
+
 /**
  * Additional macros for debug log support.
  */
@@ -167,6 +176,13 @@
         HG_LOG_OUTLET_SUBSYS_DLOG_INITIALIZER(name, parent_name);              \
     HG_LOG_SUBSYS_REGISTER(name)
 
+/* HG_LOG_SUBSYS_DLOG_DECL_STATE_REGISTER: declare and register a log outlet
+ * with debug log and enforce an init state. */
+#define HG_LOG_SUBSYS_DLOG_DECL_STATE_REGISTER(name, parent_name, state)       \
+    struct hg_log_outlet HG_LOG_OUTLET(name) = HG_LOG_OUTLET_INITIALIZER(      \
+        name, state, &HG_LOG_OUTLET(parent_name), &HG_LOG_DEBUG_DLOG(name));   \
+    HG_LOG_SUBSYS_REGISTER(name)
+
 /* HG_LOG_ADD_COUNTER32: add 32-bit debug log counter */
 #define HG_LOG_ADD_COUNTER32(name, counter_ptr, counter_name, counter_desc)    \
     hg_dlog_mkcount32(HG_LOG_OUTLET(name).debug_log, counter_ptr,              \
@@ -7,9 +7,9 @@
 
 #include "mercury_mem_pool.h"
 
+#include "mercury_atomic.h"
 #include "mercury_mem.h"
-#include "mercury_queue.h"
-#include "mercury_thread_condition.h"
+#include "mercury_thread.h"
 #include "mercury_thread_mutex.h"
 #include "mercury_thread_spin.h"
 #include "mercury_util_error.h"
@@ -33,6 +33,12 @@
         ((type *) ((char *) ptr - offsetof(type, member)))
 #endif
 
+/* Number of chunks cached per thread */
+#define HG_MEM_POOL_MAG_SIZE (64)
+
+/* Number of chunks moved at once between a thread cache and the depot */
+#define HG_MEM_POOL_MAG_BATCH (HG_MEM_POOL_MAG_SIZE / 2)
+
 /************************************/
 /* Local Type and Struct Definition */
 /************************************/
@@ -41,56 +47,128 @@
  * Memory chunk (points to actual data).
  */
 struct hg_mem_pool_chunk {
-    HG_QUEUE_ENTRY(hg_mem_pool_chunk) entry; /* Entry in chunk_list */
-    char *chunk;                             /* Must be last        */
+    struct hg_mem_pool_chunk *next;  /* Next free chunk */
+    struct hg_mem_pool_block *block; /* Parent block    */
+    char *chunk;                     /* Must be last    */
 };
 
 /**
  * Memory block. Each block has a fixed chunk size, the underlying memory
- * buffer is registered.
+ * buffer is registered. Blocks are never released before the pool is
+ * destroyed.
  */
 struct hg_mem_pool_block {
-    HG_QUEUE_HEAD(hg_mem_pool_chunk) chunks; /* Chunk list           */
-    HG_QUEUE_ENTRY(hg_mem_pool_block) entry; /* Entry in block list  */
-    void *mr_handle;                         /* Pointer to MR handle */
-    hg_thread_spin_t chunk_lock;             /* Chunk list lock      */
+    struct hg_mem_pool_block *next; /* Next block in pool   */
+    void *mr_handle;                /* Pointer to MR handle */
+    size_t size;                    /* Allocated size       */
+    size_t chunk_count;             /* Number of chunks     */
+    bool huge;                      /* Uses huge pages      */
 };
 
 /**
- * Memory pool. A pool is composed of multiple blocks.
+ * Per-thread cache of free chunks (magazine). The magazines of a thread are
+ * chained under a thread key shared by all pools. Only the owning thread
+ * accesses the chunk array, counters are atomic so that they can be read by
+ * others.
+ */
+struct hg_mem_pool_magazine {
+    struct hg_mem_pool_chunk *chunks[HG_MEM_POOL_MAG_SIZE]; /* Cached chunks */
+    struct hg_mem_pool_magazine *next;        /* Next magazine in pool   */
+    struct hg_mem_pool_magazine *thread_next; /* Next magazine of thread */
+    hg_atomic_int64_t pool;        /* Pool (0 once pool is destroyed) */
+    unsigned int count;            /* Number of cached chunks */
+    hg_atomic_int64_t alloc_count; /* Number of allocations   */
+    hg_atomic_int64_t free_count;  /* Number of frees         */
+    hg_atomic_int64_t miss_count;  /* Number of cache misses  */
+};
+
+/**
+ * Memory pool. A pool is composed of multiple blocks whose free chunks are
+ * either cached by threads or kept in a shared depot.
  */
 struct hg_mem_pool {
-    hg_thread_mutex_t extend_mutex;                /* Extend mutex    */
-    hg_thread_cond_t extend_cond;                  /* Extend cond     */
-    HG_QUEUE_HEAD(hg_mem_pool_block) blocks;       /* Block list      */
+    hg_atomic_int64_t blocks;                      /* Block list      */
+    hg_atomic_int64_t block_count;                 /* Number of blocks */
+    hg_atomic_int64_t chunk_count;                 /* Total chunks    */
+    hg_atomic_int64_t alloc_count;                 /* Uncached allocs */
+    hg_atomic_int64_t free_count;                  /* Uncached frees  */
+    hg_atomic_int32_t extending;                   /* Extending pool  */
+    struct hg_mem_pool_chunk *depot;               /* Free chunks     */
+    struct hg_mem_pool_magazine *magazines;        /* Thread caches   */
     hg_mem_pool_register_func_t register_func;     /* Register func   */
     hg_mem_pool_deregister_func_t deregister_func; /* Deregister func */
-    unsigned long flags;                           /* Optional flags */
+    unsigned long flags;                           /* Optional flags  */
     void *arg;                                     /* Func args       */
     size_t chunk_size;                             /* Chunk size      */
-    size_t chunk_count;                            /* Chunk count     */
-    int extending;                                 /* Extending pool  */
-    hg_thread_spin_t block_lock;                   /* Block list lock */
+    size_t chunk_count_min;                        /* Chunks / block  */
+    size_t retired_alloc_count;                    /* Exited threads  */
+    size_t retired_free_count;                     /* Exited threads  */
+    size_t retired_miss_count;                     /* Exited threads  */
+    hg_thread_spin_t depot_lock;                   /* Depot lock      */
+    hg_thread_spin_t magazine_lock;                /* Cache list lock */
 };
 
 /********************/
 /* Local Prototypes */
 /********************/
 
-/* Allocate new pool block */
+/* Allocate new pool block and chain its chunks */
 static struct hg_mem_pool_block *
 hg_mem_pool_block_alloc(size_t chunk_size, size_t chunk_count,
-    hg_mem_pool_register_func_t register_func, unsigned long flags, void *arg);
+    hg_mem_pool_register_func_t register_func, unsigned long flags, void *arg,
+    struct hg_mem_pool_chunk **first_p, struct hg_mem_pool_chunk **last_p);
 
 /* Free pool block */
 static void
 hg_mem_pool_block_free(struct hg_mem_pool_block *hg_mem_pool_block,
     hg_mem_pool_deregister_func_t deregister_func, void *arg);
 
+/* Allocate a new block and make its chunks available */
+static int
+hg_mem_pool_extend(struct hg_mem_pool *hg_mem_pool);
+
+/* Push chain of chunks to depot */
+static HG_UTIL_INLINE void
+hg_mem_pool_depot_push(struct hg_mem_pool *hg_mem_pool,
+    struct hg_mem_pool_chunk *first, struct hg_mem_pool_chunk *last);
+
+/* Pop up to count chunks from depot */
+static HG_UTIL_INLINE struct hg_mem_pool_chunk *
+hg_mem_pool_depot_pop(struct hg_mem_pool *hg_mem_pool, unsigned int count);
+
+/* Return the last count chunks of thread cache to depot */
+static void
+hg_mem_pool_magazine_release(struct hg_mem_pool *hg_mem_pool,
+    struct hg_mem_pool_magazine *magazine, unsigned int count);
+
+/* Get thread cache, create it if needed */
+static HG_UTIL_INLINE struct hg_mem_pool_magazine *
+hg_mem_pool_get_magazine(struct hg_mem_pool *hg_mem_pool);
+
+/* Create thread cache */
+static struct hg_mem_pool_magazine *
+hg_mem_pool_magazine_create(struct hg_mem_pool *hg_mem_pool);
+
+/* Return thread caches of exiting thread to their pools */
+static void
+hg_mem_pool_magazine_retire(void *arg);
+
+/* Delete thread cache key */
+static void
+hg_mem_pool_finalize(void) HG_ATTR_DESTRUCTOR;
+
 /*******************/
 /* Local Variables */
 /*******************/
 
+/* Key to the thread caches of the calling thread, shared by all pools */
+static hg_thread_key_t hg_mem_pool_magazine_key_g;
+static bool hg_mem_pool_magazine_key_init_g = false;
+
+/* Serializes pool destruction with thread caches of exiting threads */
+static hg_thread_mutex_t hg_mem_pool_magazine_mutex_g =
+    HG_THREAD_MUTEX_INITIALIZER;
+
 /*---------------------------------------------------------------------------*/
 
 struct hg_mem_pool *
@@ -100,29 +178,53 @@ hg_mem_pool_create(size_t chunk_size, size_t chunk_count, size_t block_count,
 {
     struct hg_mem_pool *hg_mem_pool = NULL;
     size_t i;
+    int rc;
 
     hg_mem_pool = (struct hg_mem_pool *) malloc(sizeof(struct hg_mem_pool));
     HG_UTIL_CHECK_ERROR_NORET(
         hg_mem_pool == NULL, done, "Could not allocate memory pool");
-    HG_QUEUE_INIT(&hg_mem_pool->blocks);
+    hg_atomic_init64(&hg_mem_pool->blocks, 0);
+    hg_atomic_init64(&hg_mem_pool->block_count, 0);
+    hg_atomic_init64(&hg_mem_pool->chunk_count, 0);
+    hg_atomic_init64(&hg_mem_pool->alloc_count, 0);
+    hg_atomic_init64(&hg_mem_pool->free_count, 0);
+    hg_atomic_init32(&hg_mem_pool->extending, 0);
+    hg_mem_pool->depot = NULL;
+    hg_mem_pool->magazines = NULL;
     hg_mem_pool->register_func = register_func;
     hg_mem_pool->deregister_func = deregister_func;
     hg_mem_pool->flags = flags;
     hg_mem_pool->arg = arg;
     hg_mem_pool->chunk_size = chunk_size;
-    hg_mem_pool->chunk_count = chunk_count;
-    hg_thread_mutex_init(&hg_mem_pool->extend_mutex);
-    hg_thread_cond_init(&hg_mem_pool->extend_cond);
-    hg_thread_spin_init(&hg_mem_pool->block_lock);
-    hg_mem_pool->extending = 0;
+    hg_mem_pool->chunk_count_min = chunk_count;
+    hg_mem_pool->retired_alloc_count = 0;
+    hg_mem_pool->retired_free_count = 0;
+    hg_mem_pool->retired_miss_count = 0;
+    hg_thread_spin_init(&hg_mem_pool->depot_lock);
+    hg_thread_spin_init(&hg_mem_pool->magazine_lock);
+
+    /* Thread cache key is created by the first pool */
+    hg_thread_mutex_lock(&hg_mem_pool_magazine_mutex_g);
+    rc = HG_UTIL_SUCCESS;
+    if (!hg_mem_pool_magazine_key_init_g) {
+        rc = hg_thread_key_create_destructor(
+            &hg_mem_pool_magazine_key_g, hg_mem_pool_magazine_retire);
+        hg_mem_pool_magazine_key_init_g = (rc == HG_UTIL_SUCCESS);
+    }
+    hg_thread_mutex_unlock(&hg_mem_pool_magazine_mutex_g);
+    if (unlikely(rc != HG_UTIL_SUCCESS)) {
+        hg_thread_spin_destroy(&hg_mem_pool->depot_lock);
+        hg_thread_spin_destroy(&hg_mem_pool->magazine_lock);
+        free(hg_mem_pool);
+        HG_UTIL_GOTO_ERROR(done, hg_mem_pool, NULL,
+            "Could not create thread cache key");
+    }
 
-    /* Allocate single block */
+    /* Allocate initial blocks */
     for (i = 0; i < block_count; i++) {
-        struct hg_mem_pool_block *hg_mem_pool_block = hg_mem_pool_block_alloc(
-            chunk_size, chunk_count, register_func, flags, arg);
-        HG_UTIL_CHECK_ERROR_NORET(hg_mem_pool_block == NULL, error,
+        rc = hg_mem_pool_extend(hg_mem_pool);
+        HG_UTIL_CHECK_ERROR_NORET(rc != HG_UTIL_SUCCESS, error,
             "Could not allocate block of %zu bytes", chunk_size * chunk_count);
-        HG_QUEUE_PUSH_TAIL(&hg_mem_pool->blocks, hg_mem_pool_block, entry);
     }
 
 done:
@@ -137,48 +239,92 @@ error:
 void
 hg_mem_pool_destroy(struct hg_mem_pool *hg_mem_pool)
 {
+    struct hg_mem_pool_block *hg_mem_pool_block;
+    struct hg_mem_pool_magazine *magazine;
+
     if (!hg_mem_pool)
         return;
 
-    while (!HG_QUEUE_IS_EMPTY(&hg_mem_pool->blocks)) {
-        struct hg_mem_pool_block *hg_mem_pool_block =
-            HG_QUEUE_FIRST(&hg_mem_pool->blocks);
-        HG_QUEUE_POP_HEAD(&hg_mem_pool->blocks, entry);
+    /* Chunks cached by threads belong to blocks, caches are detached from the
+     * pool and freed by their thread */
+    hg_thread_mutex_lock(&hg_mem_pool_magazine_mutex_g);
+    hg_thread_spin_lock(&hg_mem_pool->magazine_lock);
+    magazine = hg_mem_pool->magazines;
+    while (magazine) {
+        struct hg_mem_pool_magazine *next = magazine->next;
+        hg_atomic_set64(&magazine->pool, 0);
+        magazine = next;
+    }
+    hg_mem_pool->magazines = NULL;
+    hg_thread_spin_unlock(&hg_mem_pool->magazine_lock);
+    hg_thread_mutex_unlock(&hg_mem_pool_magazine_mutex_g);
+
+    hg_mem_pool_block =
+        (struct hg_mem_pool_block *) hg_atomic_get64(&hg_mem_pool->blocks);
+    while (hg_mem_pool_block) {
+        struct hg_mem_pool_block *next = hg_mem_pool_block->next;
         hg_mem_pool_block_free(
             hg_mem_pool_block, hg_mem_pool->deregister_func, hg_mem_pool->arg);
+        hg_mem_pool_block = next;
     }
-    hg_thread_mutex_destroy(&hg_mem_pool->extend_mutex);
-    hg_thread_cond_destroy(&hg_mem_pool->extend_cond);
-    hg_thread_spin_destroy(&hg_mem_pool->block_lock);
+    hg_thread_spin_destroy(&hg_mem_pool->depot_lock);
+    hg_thread_spin_destroy(&hg_mem_pool->magazine_lock);
     free(hg_mem_pool);
 }
 
 /*---------------------------------------------------------------------------*/
 static struct hg_mem_pool_block *
 hg_mem_pool_block_alloc(size_t chunk_size, size_t chunk_count,
-    hg_mem_pool_register_func_t register_func, unsigned long flags, void *arg)
+    hg_mem_pool_register_func_t register_func, unsigned long flags, void *arg,
+    struct hg_mem_pool_chunk **first_p, struct hg_mem_pool_chunk **last_p)
 {
     struct hg_mem_pool_block *hg_mem_pool_block = NULL;
+    struct hg_mem_pool_chunk *prev = NULL;
     size_t page_size = (size_t) hg_mem_get_page_size();
     void *mem_ptr = NULL, *mr_handle = NULL;
     size_t block_size, i;
     size_t block_header = sizeof(struct hg_mem_pool_block);
     size_t chunk_header = offsetof(struct hg_mem_pool_chunk, chunk);
+    bool huge = false;
 
     /* Size of block struct + number of chunks x (chunk_size + size of entry) */
     block_size = block_header + chunk_count * (chunk_header + chunk_size);
 
     /* Allocate backend buffer */
-    mem_ptr = hg_mem_aligned_alloc(page_size, block_size);
-    HG_UTIL_CHECK_ERROR_NORET(
-        mem_ptr == NULL, done, "Could not allocate %zu bytes", block_size);
+    if (flags & HG_MEM_POOL_HUGE_PAGES) {
+        size_t huge_page_size = (size_t) hg_mem_get_hugepage_size();
+
+        flags &= ~HG_MEM_POOL_HUGE_PAGES;
+        if (huge_page_size > 0) {
+            size_t huge_size =
+                ((block_size + huge_page_size - 1) / huge_page_size) *
+                huge_page_size;
+
+            mem_ptr = hg_mem_huge_alloc(huge_size);
+            if (mem_ptr != NULL) {
+                /* Use the rounded up space for extra chunks */
+                chunk_count =
+                    (huge_size - block_header) / (chunk_header + chunk_size);
+                block_size = huge_size;
+                huge = true;
+            }
+        }
+    }
+    if (mem_ptr == NULL) {
+        mem_ptr = hg_mem_aligned_alloc(page_size, block_size);
+        HG_UTIL_CHECK_ERROR_NORET(
+            mem_ptr == NULL, done, "Could not allocate %zu bytes", block_size);
+    }
     memset(mem_ptr, 0, block_size);
 
     /* Register memory if registration function is provided */
     if (register_func) {
         int rc = register_func(mem_ptr, block_size, flags, &mr_handle, arg);
         if (unlikely(rc != HG_UTIL_SUCCESS)) {
-            hg_mem_aligned_free(mem_ptr);
+            if (huge)
+                (void) hg_mem_huge_free(mem_ptr, block_size);
+            else
+                hg_mem_aligned_free(mem_ptr);
             HG_UTIL_GOTO_ERROR(done, mem_ptr, NULL, "register_func() failed");
         }
     }
@@ -186,19 +332,27 @@ hg_mem_pool_block_alloc(size_t chunk_size, size_t chunk_count,
     /* Map allocated memory to block */
     hg_mem_pool_block = (struct hg_mem_pool_block *) mem_ptr;
 
-    HG_QUEUE_INIT(&hg_mem_pool_block->chunks);
-    hg_thread_spin_init(&hg_mem_pool_block->chunk_lock);
+    hg_mem_pool_block->next = NULL;
     hg_mem_pool_block->mr_handle = mr_handle;
+    hg_mem_pool_block->size = block_size;
+    hg_mem_pool_block->chunk_count = chunk_count;
+    hg_mem_pool_block->huge = huge;
 
-    /* Assign chunks and insert them to free list */
+    /* Assign chunks and chain them */
     for (i = 0; i < chunk_count; i++) {
         struct hg_mem_pool_chunk *hg_mem_pool_chunk =
             (struct hg_mem_pool_chunk *) ((char *) hg_mem_pool_block +
                                           block_header +
                                           i * (chunk_header + chunk_size));
-        HG_QUEUE_PUSH_TAIL(
-            &hg_mem_pool_block->chunks, hg_mem_pool_chunk, entry);
+        hg_mem_pool_chunk->block = hg_mem_pool_block;
+        hg_mem_pool_chunk->next = NULL;
+        if (prev)
+            prev->next = hg_mem_pool_chunk;
+        else
+            *first_p = hg_mem_pool_chunk;
+        prev = hg_mem_pool_chunk;
     }
+    *last_p = prev;
 
 done:
     return hg_mem_pool_block;
@@ -220,17 +374,212 @@ hg_mem_pool_block_free(struct hg_mem_pool_block *hg_mem_pool_block,
     }
 
 done:
-    hg_thread_spin_destroy(&hg_mem_pool_block->chunk_lock);
-    hg_mem_aligned_free((void *) hg_mem_pool_block);
+    if (hg_mem_pool_block->huge)
+        (void) hg_mem_huge_free(
+            (void *) hg_mem_pool_block, hg_mem_pool_block->size);
+    else
+        hg_mem_aligned_free((void *) hg_mem_pool_block);
     return;
 }
 
+/*---------------------------------------------------------------------------*/
+static int
+hg_mem_pool_extend(struct hg_mem_pool *hg_mem_pool)
+{
+    struct hg_mem_pool_block *hg_mem_pool_block;
+    struct hg_mem_pool_chunk *first = NULL, *last = NULL;
+    int64_t head;
+
+    hg_mem_pool_block = hg_mem_pool_block_alloc(hg_mem_pool->chunk_size,
+        hg_mem_pool->chunk_count_min, hg_mem_pool->register_func,
+        hg_mem_pool->flags, hg_mem_pool->arg, &first, &last);
+    if (hg_mem_pool_block == NULL || first == NULL) {
+        hg_mem_pool_block_free(hg_mem_pool_block, hg_mem_pool->deregister_func,
+            hg_mem_pool->arg);
+        return HG_UTIL_FAIL;
+    }
+
+    /* Blocks are only ever added, push without locking */
+    do {
+        head = hg_atomic_get64(&hg_mem_pool->blocks);
+        hg_mem_pool_block->next = (struct hg_mem_pool_block *) head;
+    } while (!hg_atomic_cas64(
+        &hg_mem_pool->blocks, head, (int64_t) hg_mem_pool_block));
+    hg_atomic_incr64(&hg_mem_pool->block_count);
+    hg_atomic_set64(&hg_mem_pool->chunk_count,
+        hg_atomic_get64(&hg_mem_pool->chunk_count) +
+            (int64_t) hg_mem_pool_block->chunk_count);
+
+    hg_mem_pool_depot_push(hg_mem_pool, first, last);
+
+    return HG_UTIL_SUCCESS;
+}
+
+/*---------------------------------------------------------------------------*/
+static HG_UTIL_INLINE void
+hg_mem_pool_depot_push(struct hg_mem_pool *hg_mem_pool,
+    struct hg_mem_pool_chunk *first, struct hg_mem_pool_chunk *last)
+{
+    hg_thread_spin_lock(&hg_mem_pool->depot_lock);
+    last->next = hg_mem_pool->depot;
+    hg_mem_pool->depot = first;
+    hg_thread_spin_unlock(&hg_mem_pool->depot_lock);
+}
+
+/*---------------------------------------------------------------------------*/
+static HG_UTIL_INLINE struct hg_mem_pool_chunk *
+hg_mem_pool_depot_pop(struct hg_mem_pool *hg_mem_pool, unsigned int count)
+{
+    struct hg_mem_pool_chunk *first, *last;
+    unsigned int i;
+
+    hg_thread_spin_lock(&hg_mem_pool->depot_lock);
+    first = last = hg_mem_pool->depot;
+    if (first) {
+        for (i = 1; i < count && last->next; i++)
+            last = last->next;
+        hg_mem_pool->depot = last->next;
+        last->next = NULL;
+    }
+    hg_thread_spin_unlock(&hg_mem_pool->depot_lock);
+
+    return first;
+}
+
+/*---------------------------------------------------------------------------*/
+static void
+hg_mem_pool_magazine_release(struct hg_mem_pool *hg_mem_pool,
+    struct hg_mem_pool_magazine *magazine, unsigned int count)
+{
+    unsigned int i;
+
+    for (i = magazine->count - count; i < magazine->count - 1; i++)
+        magazine->chunks[i]->next = magazine->chunks[i + 1];
+    magazine->chunks[magazine->count - 1]->next = NULL;
+    hg_mem_pool_depot_push(hg_mem_pool,
+        magazine->chunks[magazine->count - count],
+        magazine->chunks[magazine->count - 1]);
+    magazine->count -= count;
+}
+
+/*---------------------------------------------------------------------------*/
+static HG_UTIL_INLINE struct hg_mem_pool_magazine *
+hg_mem_pool_get_magazine(struct hg_mem_pool *hg_mem_pool)
+{
+    struct hg_mem_pool_magazine *magazine =
+        (struct hg_mem_pool_magazine *) hg_thread_getspecific(
+            hg_mem_pool_magazine_key_g);
+
+    while (magazine && (struct hg_mem_pool *) hg_atomic_get64(
+                           &magazine->pool) != hg_mem_pool)
+        magazine = magazine->thread_next;
+
+    return (magazine) ? magazine : hg_mem_pool_magazine_create(hg_mem_pool);
+}
+
+/*---------------------------------------------------------------------------*/
+static struct hg_mem_pool_magazine *
+hg_mem_pool_magazine_create(struct hg_mem_pool *hg_mem_pool)
+{
+    struct hg_mem_pool_magazine *magazine, **prev_p;
+
+    magazine = (struct hg_mem_pool_magazine *) malloc(sizeof(*magazine));
+    HG_UTIL_CHECK_ERROR_NORET(
+        magazine == NULL, error, "Could not allocate thread cache");
+    hg_atomic_init64(&magazine->pool, (int64_t) hg_mem_pool);
+    magazine->count = 0;
+    hg_atomic_init64(&magazine->alloc_count, 0);
+    hg_atomic_init64(&magazine->free_count, 0);
+    hg_atomic_init64(&magazine->miss_count, 0);
+
+    magazine->thread_next =
+        (struct hg_mem_pool_magazine *) hg_thread_getspecific(
+            hg_mem_pool_magazine_key_g);
+    if (hg_thread_setspecific(hg_mem_pool_magazine_key_g, magazine) !=
+        HG_UTIL_SUCCESS) {
+        free(magazine);
+        HG_UTIL_GOTO_ERROR(error, magazine, NULL, "Could not set thread cache");
+    }
+
+    /* Free caches of this thread whose pool was destroyed */
+    prev_p = &magazine->thread_next;
+    while (*prev_p) {
+        struct hg_mem_pool_magazine *tmp = *prev_p;
+
+        if (hg_atomic_get64(&tmp->pool) == 0) {
+            *prev_p = tmp->thread_next;
+            free(tmp);
+        } else
+            prev_p = &tmp->thread_next;
+    }
+
+    hg_thread_spin_lock(&hg_mem_pool->magazine_lock);
+    magazine->next = hg_mem_pool->magazines;
+    hg_mem_pool->magazines = magazine;
+    hg_thread_spin_unlock(&hg_mem_pool->magazine_lock);
+
+    return magazine;
+
+error:
+    return NULL;
+}
+
+/*---------------------------------------------------------------------------*/
+static void
+hg_mem_pool_magazine_retire(void *arg)
+{
+    struct hg_mem_pool_magazine *magazine = (struct hg_mem_pool_magazine *) arg;
+
+    hg_thread_mutex_lock(&hg_mem_pool_magazine_mutex_g);
+    while (magazine) {
+        struct hg_mem_pool_magazine *next = magazine->thread_next;
+        struct hg_mem_pool *hg_mem_pool =
+            (struct hg_mem_pool *) hg_atomic_get64(&magazine->pool);
+
+        if (hg_mem_pool) {
+            struct hg_mem_pool_magazine **prev_p;
+
+            /* Return cached chunks to the depot */
+            if (magazine->count > 0)
+                hg_mem_pool_magazine_release(
+                    hg_mem_pool, magazine, magazine->count);
+
+            /* Keep counters and remove cache from pool */
+            hg_thread_spin_lock(&hg_mem_pool->magazine_lock);
+            hg_mem_pool->retired_alloc_count +=
+                (size_t) hg_atomic_get64(&magazine->alloc_count);
+            hg_mem_pool->retired_free_count +=
+                (size_t) hg_atomic_get64(&magazine->free_count);
+            hg_mem_pool->retired_miss_count +=
+                (size_t) hg_atomic_get64(&magazine->miss_count);
+            for (prev_p = &hg_mem_pool->magazines; *prev_p != magazine;
+                 prev_p = &(*prev_p)->next)
+                continue;
+            *prev_p = magazine->next;
+            hg_thread_spin_unlock(&hg_mem_pool->magazine_lock);
+        }
+        free(magazine);
+        magazine = next;
+    }
+    hg_thread_mutex_unlock(&hg_mem_pool_magazine_mutex_g);
+}
+
+/*---------------------------------------------------------------------------*/
+static void
+hg_mem_pool_finalize(void)
+{
+    if (hg_mem_pool_magazine_key_init_g) {
+        (void) hg_thread_key_delete(hg_mem_pool_magazine_key_g);
+        hg_mem_pool_magazine_key_init_g = false;
+    }
+}
+
 /*---------------------------------------------------------------------------*/
 void *
 hg_mem_pool_alloc(
     struct hg_mem_pool *hg_mem_pool, size_t size, void **mr_handle)
 {
-    struct hg_mem_pool_block *hg_mem_pool_block;
+    struct hg_mem_pool_magazine *magazine;
     struct hg_mem_pool_chunk *hg_mem_pool_chunk = NULL;
     void *mem_ptr = NULL;
 
@@ -239,62 +588,44 @@ hg_mem_pool_alloc(
     HG_UTIL_CHECK_ERROR(!mr_handle && hg_mem_pool->register_func, done, mem_ptr,
         NULL, "MR handle is NULL");
 
-    do {
-        int found = 0;
-
-        /* Check whether we can get a block from one of the pools */
-        hg_thread_spin_lock(&hg_mem_pool->block_lock);
-        HG_QUEUE_FOREACH (hg_mem_pool_block, &hg_mem_pool->blocks, entry) {
-            hg_thread_spin_lock(&hg_mem_pool_block->chunk_lock);
-            found = !HG_QUEUE_IS_EMPTY(&hg_mem_pool_block->chunks);
-            hg_thread_spin_unlock(&hg_mem_pool_block->chunk_lock);
-            if (found)
-                break;
-        }
-        hg_thread_spin_unlock(&hg_mem_pool->block_lock);
-
-        /* If not, allocate and register a new pool */
-        if (!found) {
-            /* Let other threads sleep while the pool is being extended */
-            hg_thread_mutex_lock(&hg_mem_pool->extend_mutex);
-            if (hg_mem_pool->extending) {
-                hg_thread_cond_wait(
-                    &hg_mem_pool->extend_cond, &hg_mem_pool->extend_mutex);
-                hg_thread_mutex_unlock(&hg_mem_pool->extend_mutex);
-                continue;
-            }
-            hg_mem_pool->extending = 1;
-            hg_thread_mutex_unlock(&hg_mem_pool->extend_mutex);
-
-            hg_mem_pool_block = hg_mem_pool_block_alloc(hg_mem_pool->chunk_size,
-                hg_mem_pool->chunk_count, hg_mem_pool->register_func,
-                hg_mem_pool->flags, hg_mem_pool->arg);
-            HG_UTIL_CHECK_ERROR(hg_mem_pool_block == NULL, done, mem_ptr, NULL,
-                "Could not allocate block of %zu bytes",
-                hg_mem_pool->chunk_size * hg_mem_pool->chunk_count);
-
-            hg_thread_spin_lock(&hg_mem_pool->block_lock);
-            HG_QUEUE_PUSH_TAIL(&hg_mem_pool->blocks, hg_mem_pool_block, entry);
-            hg_thread_spin_unlock(&hg_mem_pool->block_lock);
-
-            hg_thread_mutex_lock(&hg_mem_pool->extend_mutex);
-            hg_mem_pool->extending = 0;
-            hg_thread_cond_broadcast(&hg_mem_pool->extend_cond);
-            hg_thread_mutex_unlock(&hg_mem_pool->extend_mutex);
+    /* Fast path, take chunk from thread cache */
+    magazine = hg_mem_pool_get_magazine(hg_mem_pool);
+    if (likely(magazine && magazine->count > 0))
+        hg_mem_pool_chunk = magazine->chunks[--magazine->count];
+    else {
+        unsigned int count = (magazine) ? HG_MEM_POOL_MAG_BATCH + 1 : 1;
+
+        /* Refill thread cache from depot, extend pool if depot is empty */
+        while ((hg_mem_pool_chunk = hg_mem_pool_depot_pop(
+                    hg_mem_pool, count)) == NULL) {
+            /* Let only one thread extend the pool at a time */
+            if (hg_atomic_cas32(&hg_mem_pool->extending, 0, 1)) {
+                int rc = hg_mem_pool_extend(hg_mem_pool);
+                hg_atomic_set32(&hg_mem_pool->extending, 0);
+                HG_UTIL_CHECK_ERROR(rc != HG_UTIL_SUCCESS, done, mem_ptr, NULL,
+                    "Could not allocate block of %zu bytes",
+                    hg_mem_pool->chunk_size * hg_mem_pool->chunk_count_min);
+            } else
+                hg_thread_yield();
         }
+        if (magazine) {
+            struct hg_mem_pool_chunk *next;
 
-        /* Try to pick a node from one of the available pools */
-        hg_thread_spin_lock(&hg_mem_pool_block->chunk_lock);
-        if (!HG_QUEUE_IS_EMPTY(&hg_mem_pool_block->chunks)) {
-            hg_mem_pool_chunk = HG_QUEUE_FIRST(&hg_mem_pool_block->chunks);
-            HG_QUEUE_POP_HEAD(&hg_mem_pool_block->chunks, entry);
+            for (next = hg_mem_pool_chunk->next; next != NULL;
+                 next = next->next)
+                magazine->chunks[magazine->count++] = next;
+            hg_atomic_incr64(&magazine->miss_count);
         }
-        hg_thread_spin_unlock(&hg_mem_pool_block->chunk_lock);
-    } while (!hg_mem_pool_chunk);
+    }
+
+    if (magazine)
+        hg_atomic_incr64(&magazine->alloc_count);
+    else
+        hg_atomic_incr64(&hg_mem_pool->alloc_count);
 
     mem_ptr = &hg_mem_pool_chunk->chunk;
-    if (mr_handle && hg_mem_pool_block)
-        *mr_handle = hg_mem_pool_block->mr_handle;
+    if (mr_handle)
+        *mr_handle = hg_mem_pool_chunk->block->mr_handle;
 
 done:
     return mem_ptr;
@@ -305,32 +636,32 @@ void
 hg_mem_pool_free(
     struct hg_mem_pool *hg_mem_pool, void *mem_ptr, void *mr_handle)
 {
-    struct hg_mem_pool_block *hg_mem_pool_block;
-    int found = 0;
+    struct hg_mem_pool_magazine *magazine;
+    struct hg_mem_pool_chunk *hg_mem_pool_chunk;
 
     if (!mem_ptr)
         return;
 
-    /* Put the node back to the pool */
-    hg_thread_spin_lock(&hg_mem_pool->block_lock);
-    HG_QUEUE_FOREACH (hg_mem_pool_block, &hg_mem_pool->blocks, entry) {
-        /* If MR handle is NULL, it does not really matter which pool we push
-         * the node back to.
-         */
-        if (hg_mem_pool_block->mr_handle == mr_handle) {
-            struct hg_mem_pool_chunk *hg_mem_pool_chunk =
-                container_of(mem_ptr, struct hg_mem_pool_chunk, chunk);
-            hg_thread_spin_lock(&hg_mem_pool_block->chunk_lock);
-            HG_QUEUE_PUSH_TAIL(
-                &hg_mem_pool_block->chunks, hg_mem_pool_chunk, entry);
-            hg_thread_spin_unlock(&hg_mem_pool_block->chunk_lock);
-            found = 1;
-            break;
-        }
+    hg_mem_pool_chunk = container_of(mem_ptr, struct hg_mem_pool_chunk, chunk);
+    HG_UTIL_CHECK_WARNING(hg_mem_pool_chunk->block->mr_handle != mr_handle,
+        "MR handle does not match memory block");
+
+    /* Put the chunk back to the thread cache */
+    magazine = hg_mem_pool_get_magazine(hg_mem_pool);
+    if (unlikely(magazine == NULL)) {
+        hg_mem_pool_chunk->next = NULL;
+        hg_mem_pool_depot_push(
+            hg_mem_pool, hg_mem_pool_chunk, hg_mem_pool_chunk);
+        hg_atomic_incr64(&hg_mem_pool->free_count);
+        return;
     }
-    hg_thread_spin_unlock(&hg_mem_pool->block_lock);
 
-    HG_UTIL_CHECK_WARNING(found != 1, "Memory block was not found");
+    /* Return half of the cache to the depot when it is full */
+    if (magazine->count == HG_MEM_POOL_MAG_SIZE)
+        hg_mem_pool_magazine_release(
+            hg_mem_pool, magazine, HG_MEM_POOL_MAG_BATCH);
+    magazine->chunks[magazine->count++] = hg_mem_pool_chunk;
+    hg_atomic_incr64(&magazine->free_count);
 }
 
 /*---------------------------------------------------------------------------*/
@@ -338,13 +669,37 @@ size_t
 hg_mem_pool_chunk_offset(
     struct hg_mem_pool *hg_mem_pool, void *mem_ptr, void *mr_handle)
 {
-    struct hg_mem_pool_block *hg_mem_pool_block;
+    struct hg_mem_pool_chunk *hg_mem_pool_chunk =
+        container_of(mem_ptr, struct hg_mem_pool_chunk, chunk);
 
-    hg_thread_spin_lock(&hg_mem_pool->block_lock);
-    HG_QUEUE_FOREACH (hg_mem_pool_block, &hg_mem_pool->blocks, entry)
-        if (hg_mem_pool_block->mr_handle == mr_handle)
-            break;
-    hg_thread_spin_unlock(&hg_mem_pool->block_lock);
+    (void) hg_mem_pool;
+    (void) mr_handle;
 
-    return (size_t) ((char *) mem_ptr - (char *) hg_mem_pool_block);
+    return (size_t) ((char *) mem_ptr - (char *) hg_mem_pool_chunk->block);
+}
+
+/*---------------------------------------------------------------------------*/
+void
+hg_mem_pool_get_stats(
+    struct hg_mem_pool *hg_mem_pool, struct hg_mem_pool_stats *stats)
+{
+    struct hg_mem_pool_magazine *magazine;
+
+    stats->alloc_count = (size_t) hg_atomic_get64(&hg_mem_pool->alloc_count);
+    stats->free_count = (size_t) hg_atomic_get64(&hg_mem_pool->free_count);
+    stats->miss_count = stats->alloc_count;
+    stats->block_count = (size_t) hg_atomic_get64(&hg_mem_pool->block_count);
+    stats->chunk_count = (size_t) hg_atomic_get64(&hg_mem_pool->chunk_count);
+
+    hg_thread_spin_lock(&hg_mem_pool->magazine_lock);
+    stats->alloc_count += hg_mem_pool->retired_alloc_count;
+    stats->free_count += hg_mem_pool->retired_free_count;
+    stats->miss_count += hg_mem_pool->retired_miss_count;
+    for (magazine = hg_mem_pool->magazines; magazine != NULL;
+         magazine = magazine->next) {
+        stats->alloc_count += (size_t) hg_atomic_get64(&magazine->alloc_count);
+        stats->free_count += (size_t) hg_atomic_get64(&magazine->free_count);
+        stats->miss_count += (size_t) hg_atomic_get64(&magazine->miss_count);
+    }
+    hg_thread_spin_unlock(&hg_mem_pool->magazine_lock);
 }
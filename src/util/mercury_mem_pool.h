@@ -38,10 +38,25 @@ typedef int (*hg_mem_pool_register_func_t)(const void *buf, size_t size,
  */
 typedef int (*hg_mem_pool_deregister_func_t)(void *handle, void *arg);
 
+/**
+ * Memory pool statistics.
+ */
+struct hg_mem_pool_stats {
+    size_t alloc_count; /* Number of allocations */
+    size_t free_count;  /* Number of frees */
+    size_t miss_count;  /* Allocations not served from thread caches */
+    size_t block_count; /* Number of blocks */
+    size_t chunk_count; /* Total number of chunks */
+};
+
 /*****************/
 /* Public Macros */
 /*****************/
 
+/* Back blocks with huge pages when available. This flag is reserved and is
+ * never passed to register_func. */
+#define HG_MEM_POOL_HUGE_PAGES (1UL << (sizeof(unsigned long) * 8 - 1))
+
 /*********************/
 /* Public Prototypes */
 /*********************/
@@ -53,7 +68,16 @@ extern "C" {
 /**
  * Create a memory pool with \block_count of size \chunk_count x \chunk_size
  * bytes. Optionally register and deregister memory for each block using
- * \register_func and \deregister_func respectively.
+ * \register_func and \deregister_func respectively. If HG_MEM_POOL_HUGE_PAGES
+ * is set in \flags, each block is rounded up to a multiple of the huge page
+ * size and the extra space is used for additional chunks, so that a single
+ * registration covers all of them; regular pages are used if huge pages cannot
+ * be allocated.
+ *
+ * Each thread caches a small number of free chunks so that most allocations
+ * and frees do not synchronize with other threads. Cached chunks of threads
+ * that exit are returned to the pool (on Windows, they are only reclaimed
+ * when the pool is destroyed).
  *
  * \param chunk_size [IN]       size of chunks
  * \param chunk_count [IN]      number of chunks
@@ -119,6 +143,17 @@ HG_UTIL_PUBLIC size_t
 hg_mem_pool_chunk_offset(
     struct hg_mem_pool *hg_mem_pool, void *mem_ptr, void *mr_handle);
 
+/**
+ * Retrieve pool statistics. Counters are updated concurrently and may
+ * therefore not be exactly consistent with each other.
+ *
+ * \param hg_mem_pool [IN/OUT]  pointer to memory pool
+ * \param stats [OUT]           pointer to statistics
+ */
+HG_UTIL_PUBLIC void
+hg_mem_pool_get_stats(
+    struct hg_mem_pool *hg_mem_pool, struct hg_mem_pool_stats *stats);
+
 #ifdef __cplusplus
 }
 #endif
@@ -21,6 +21,12 @@
 #    include <unistd.h>
 #    if defined(HG_UTIL_HAS_SYSEPOLL_H)
 #        include <sys/epoll.h>
+#        ifdef HG_UTIL_HAS_IO_URING
+#            include <linux/io_uring.h>
+#            include <poll.h>
+#            include <sys/mman.h>
+#            include <sys/syscall.h>
+#        endif
 #    elif defined(HG_UTIL_HAS_SYSEVENT_H)
 #        include <sys/event.h>
 #        include <sys/time.h>
@@ -36,10 +42,51 @@
 #define HG_POLL_INIT_NEVENTS 32
 #define HG_POLL_MAX_EVENTS   4096
 
+#ifdef HG_UTIL_HAS_IO_URING
+/* Number of submission queue entries */
+#    define HG_POLL_URING_ENTRIES (256)
+
+/* user_data of completions that do not map to a registered fd */
+#    define HG_POLL_URING_IGNORE (UINT64_MAX)
+
+/* user_data encodes the entry index and its generation */
+#    define HG_POLL_URING_DATA(index, gen)                                     \
+        (((uint64_t) (gen) << 32) | (uint64_t) (index))
+#endif
+
 /************************************/
 /* Local Type and Struct Definition */
 /************************************/
 
+#ifdef HG_UTIL_HAS_IO_URING
+/* Registered fd */
+struct hg_poll_uring_entry {
+    hg_poll_data_t data; /* User data */
+    uint32_t poll_mask;  /* Requested poll events */
+    uint32_t gen;        /* Generation, filters stale completions */
+    int fd;              /* File descriptor (-1 if entry is unused) */
+    bool armed;          /* Multishot poll is armed */
+};
+
+/* io_uring instance */
+struct hg_poll_uring {
+    struct hg_poll_uring_entry *entries; /* Registered fds */
+    struct io_uring_sqe *sqes;           /* Submission queue entries */
+    struct io_uring_cqe *cqes;           /* Completion queue entries */
+    void *ring;                          /* Mapped SQ and CQ rings */
+    size_t ring_size;                    /* Size of mapped rings */
+    size_t sqes_size;                    /* Size of mapped SQEs */
+    unsigned int *sq_head;               /* SQ head (kernel) */
+    unsigned int *sq_tail;               /* SQ tail (user) */
+    unsigned int *cq_head;               /* CQ head (user) */
+    unsigned int *cq_tail;               /* CQ tail (kernel) */
+    unsigned int sq_mask;                /* SQ ring mask */
+    unsigned int sq_entries;             /* Number of SQEs */
+    unsigned int cq_mask;                /* CQ ring mask */
+    unsigned int nentries;               /* Size of entries array */
+};
+#endif
+
 struct hg_poll_set {
     hg_thread_mutex_t lock;
 #if defined(_WIN32)
@@ -47,6 +94,9 @@ struct hg_poll_set {
     HANDLE *events; /* placeholder */
 #elif defined(HG_UTIL_HAS_SYSEPOLL_H)
     struct epoll_event *events;
+#    ifdef HG_UTIL_HAS_IO_URING
+    struct hg_poll_uring *uring; /* io_uring backend (NULL if using epoll) */
+#    endif
 #elif defined(HG_UTIL_HAS_SYSEVENT_H)
     struct kevent *events;
 #else
@@ -62,6 +112,78 @@ struct hg_poll_set {
 /* Local Prototypes */
 /********************/
 
+#ifdef HG_UTIL_HAS_IO_URING
+/**
+ * Create io_uring instance if requested through HG_POLL_BACKEND.
+ */
+static struct hg_poll_uring *
+hg_poll_uring_create(int *fd_p);
+
+/**
+ * Destroy io_uring instance.
+ */
+static void
+hg_poll_uring_destroy(struct hg_poll_uring *uring);
+
+/**
+ * Enter io_uring.
+ */
+static HG_UTIL_INLINE int
+hg_poll_uring_enter(int fd, unsigned int to_submit, unsigned int min_complete,
+    unsigned int flags, void *arg, size_t arg_size);
+
+/**
+ * Number of SQEs not yet consumed by the kernel.
+ */
+static HG_UTIL_INLINE unsigned int
+hg_poll_uring_pending(struct hg_poll_uring *uring);
+
+/**
+ * Get next free SQE, submitting pending SQEs if the SQ is full.
+ */
+static struct io_uring_sqe *
+hg_poll_uring_get_sqe(int fd, struct hg_poll_uring *uring);
+
+/**
+ * Make SQE previously returned by hg_poll_uring_get_sqe() visible.
+ */
+static HG_UTIL_INLINE void
+hg_poll_uring_push_sqe(struct hg_poll_uring *uring);
+
+/**
+ * Queue multishot poll for entry.
+ */
+static int
+hg_poll_uring_arm(int fd, struct hg_poll_uring *uring, unsigned int index);
+
+/**
+ * Add fd to io_uring poll set.
+ */
+static int
+hg_poll_uring_add(hg_poll_set_t *poll_set, int fd, struct hg_poll_event *event);
+
+/**
+ * Remove fd from io_uring poll set.
+ */
+static int
+hg_poll_uring_remove(hg_poll_set_t *poll_set, int fd);
+
+/**
+ * Reap completions and convert them to poll events.
+ */
+static unsigned int
+hg_poll_uring_reap(struct hg_poll_uring *uring, unsigned int max_events,
+    struct hg_poll_event *events);
+
+/**
+ * Wait on io_uring poll set.
+ */
+static int
+hg_poll_uring_wait(hg_poll_set_t *poll_set, unsigned int timeout,
+    unsigned int max_events, struct hg_poll_event *events,
+    unsigned int *actual_events);
+#endif
+
 /*******************/
 /* Local Variables */
 /*******************/
@@ -89,7 +211,12 @@ hg_poll_create(void)
 #if defined(_WIN32)
     /* TODO */
 #elif defined(HG_UTIL_HAS_SYSEPOLL_H)
-    hg_poll_set->fd = epoll_create1(0);
+#    ifdef HG_UTIL_HAS_IO_URING
+    /* Fall back to epoll if io_uring was not requested or is not supported */
+    hg_poll_set->uring = hg_poll_uring_create(&hg_poll_set->fd);
+    if (hg_poll_set->uring == NULL)
+#    endif
+        hg_poll_set->fd = epoll_create1(0);
     HG_UTIL_CHECK_ERROR_NORET(hg_poll_set->fd == -1, error,
         "epoll_create1() failed (%s)", strerror(errno));
 #elif defined(HG_UTIL_HAS_SYSEVENT_H)
@@ -107,7 +234,8 @@ hg_poll_create(void)
     HG_UTIL_CHECK_ERROR_NORET(
         !hg_poll_set->events, error, "malloc() failed (%s)", strerror(errno));
 #endif
-    HG_UTIL_LOG_DEBUG("Created new poll set, fd=%d", hg_poll_set->fd);
+    HG_UTIL_LOG_DEBUG("Created new poll set (%s), fd=%d",
+        hg_poll_get_backend(hg_poll_set), hg_poll_set->fd);
 
     return hg_poll_set;
 
@@ -138,6 +266,11 @@ hg_poll_destroy(hg_poll_set_t *poll_set)
 #if defined(_WIN32)
     /* TODO */
 #elif defined(HG_UTIL_HAS_SYSEPOLL_H) || defined(HG_UTIL_HAS_SYSEVENT_H)
+#    ifdef HG_UTIL_HAS_IO_URING
+    if (poll_set->uring)
+        hg_poll_uring_destroy(poll_set->uring);
+#    endif
+
     /* Close poll descriptor */
     rc = close(poll_set->fd);
     HG_UTIL_CHECK_ERROR(rc == -1, done, ret, HG_UTIL_FAIL,
@@ -172,6 +305,31 @@ hg_poll_get_fd(hg_poll_set_t *poll_set)
 #endif
 }
 
+/*---------------------------------------------------------------------------*/
+const char *
+hg_poll_get_backend(hg_poll_set_t *poll_set)
+{
+#if defined(_WIN32)
+    /* TODO */
+    (void) poll_set;
+    return "none";
+#elif defined(HG_UTIL_HAS_SYSEPOLL_H)
+#    ifdef HG_UTIL_HAS_IO_URING
+    if (poll_set->uring != NULL)
+        return "io_uring";
+#    else
+    (void) poll_set;
+#    endif
+    return "epoll";
+#elif defined(HG_UTIL_HAS_SYSEVENT_H)
+    (void) poll_set;
+    return "kqueue";
+#else
+    (void) poll_set;
+    return "poll";
+#endif
+}
+
 /*---------------------------------------------------------------------------*/
 int
 hg_poll_add(hg_poll_set_t *poll_set, int fd, struct hg_poll_event *event)
@@ -198,6 +356,11 @@ hg_poll_add(hg_poll_set_t *poll_set, int fd, struct hg_poll_event *event)
 #if defined(_WIN32)
     /* TODO */
 #elif defined(HG_UTIL_HAS_SYSEPOLL_H)
+#    ifdef HG_UTIL_HAS_IO_URING
+    if (poll_set->uring)
+        return hg_poll_uring_add(poll_set, fd, event);
+#    endif
+
     /* Translate flags */
     if (event->events & HG_POLLIN)
         poll_flags |= EPOLLIN;
@@ -294,6 +457,11 @@ hg_poll_remove(hg_poll_set_t *poll_set, int fd)
 #if defined(_WIN32)
     /* TODO */
 #elif defined(HG_UTIL_HAS_SYSEPOLL_H)
+#    ifdef HG_UTIL_HAS_IO_URING
+    if (poll_set->uring)
+        return hg_poll_uring_remove(poll_set, fd);
+#    endif
+
     rc = epoll_ctl(poll_set->fd, EPOLL_CTL_DEL, fd, NULL);
     HG_UTIL_CHECK_ERROR(rc != 0, done, ret, HG_UTIL_FAIL,
         "epoll_ctl() failed (%s)", strerror(errno));
@@ -350,6 +518,12 @@ hg_poll_wait(hg_poll_set_t *poll_set, unsigned int timeout,
 #if defined(_WIN32)
 
 #elif defined(HG_UTIL_HAS_SYSEPOLL_H)
+#    ifdef HG_UTIL_HAS_IO_URING
+    if (poll_set->uring)
+        return hg_poll_uring_wait(
+            poll_set, timeout, max_events, events, actual_events);
+#    endif
+
     nfds = epoll_wait(
         poll_set->fd, poll_set->events, max_poll_events, (int) timeout);
     HG_UTIL_CHECK_ERROR(nfds == -1 && errno != EINTR, done, ret, HG_UTIL_FAIL,
@@ -518,3 +692,437 @@ unlock:
     return ret;
 #endif
 }
+
+#ifdef HG_UTIL_HAS_IO_URING
+/*---------------------------------------------------------------------------*/
+static struct hg_poll_uring *
+hg_poll_uring_create(int *fd_p)
+{
+    struct io_uring_params params;
+    struct hg_poll_uring *uring = NULL;
+    const char *backend = getenv("HG_POLL_BACKEND");
+    size_t cq_ring_size;
+    unsigned int *sq_array, i;
+    char *ring;
+    int fd = -1;
+
+    if (backend == NULL || strcmp(backend, "io_uring") != 0)
+        return NULL;
+
+    memset(&params, 0, sizeof(params));
+    fd = (int) syscall(__NR_io_uring_setup, HG_POLL_URING_ENTRIES, &params);
+    if (fd == -1) {
+        HG_UTIL_LOG_WARNING("io_uring_setup() failed (%s), using epoll",
+            strerror(errno));
+        goto error;
+    }
+
+    /* EXT_ARG (5.11) is needed for timed waits and multishot poll came in
+     * the same release as RSRC_TAGS (5.13) */
+    if ((params.features & IORING_FEAT_SINGLE_MMAP) == 0 ||
+        (params.features & IORING_FEAT_NODROP) == 0 ||
+        (params.features & IORING_FEAT_EXT_ARG) == 0 ||
+        (params.features & IORING_FEAT_RSRC_TAGS) == 0) {
+        HG_UTIL_LOG_WARNING(
+            "io_uring features not supported (%#x), using epoll",
+            params.features);
+        goto error;
+    }
+
+    uring = calloc(1, sizeof(*uring));
+    HG_UTIL_CHECK_ERROR_NORET(
+        uring == NULL, error, "calloc() failed (%s)", strerror(errno));
+    uring->ring = MAP_FAILED;
+    uring->sqes = MAP_FAILED;
+
+    /* SQ and CQ rings share a single mapping */
+    uring->ring_size =
+        params.sq_off.array + params.sq_entries * sizeof(unsigned int);
+    cq_ring_size = params.cq_off.cqes +
+                   params.cq_entries * sizeof(struct io_uring_cqe);
+    if (cq_ring_size > uring->ring_size)
+        uring->ring_size = cq_ring_size;
+
+    uring->ring = mmap(NULL, uring->ring_size, PROT_READ | PROT_WRITE,
+        MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQ_RING);
+    HG_UTIL_CHECK_ERROR_NORET(uring->ring == MAP_FAILED, error,
+        "mmap() failed (%s)", strerror(errno));
+
+    uring->sqes_size = params.sq_entries * sizeof(struct io_uring_sqe);
+    uring->sqes = mmap(NULL, uring->sqes_size, PROT_READ | PROT_WRITE,
+        MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQES);
+    HG_UTIL_CHECK_ERROR_NORET(uring->sqes == MAP_FAILED, error,
+        "mmap() failed (%s)", strerror(errno));
+
+    ring = (char *) uring->ring;
+    uring->sq_head = (unsigned int *) (ring + params.sq_off.head);
+    uring->sq_tail = (unsigned int *) (ring + params.sq_off.tail);
+    uring->sq_mask = *(unsigned int *) (ring + params.sq_off.ring_mask);
+    uring->sq_entries = params.sq_entries;
+    uring->cq_head = (unsigned int *) (ring + params.cq_off.head);
+    uring->cq_tail = (unsigned int *) (ring + params.cq_off.tail);
+    uring->cq_mask = *(unsigned int *) (ring + params.cq_off.ring_mask);
+    uring->cqes = (struct io_uring_cqe *) (ring + params.cq_off.cqes);
+
+    /* SQ index array is a fixed identity mapping */
+    sq_array = (unsigned int *) (ring + params.sq_off.array);
+    for (i = 0; i < params.sq_entries; i++)
+        sq_array[i] = i;
+
+    /* Preallocate entries, size will grow as needed */
+    uring->nentries = HG_POLL_INIT_NEVENTS;
+    uring->entries = malloc(sizeof(*uring->entries) * uring->nentries);
+    HG_UTIL_CHECK_ERROR_NORET(uring->entries == NULL, error,
+        "malloc() failed (%s)", strerror(errno));
+    for (i = 0; i < uring->nentries; i++) {
+        uring->entries[i].fd = -1;
+        uring->entries[i].gen = 0;
+        uring->entries[i].armed = false;
+    }
+
+    HG_UTIL_LOG_DEBUG("Using io_uring poll backend, fd=%d", fd);
+    *fd_p = fd;
+
+    return uring;
+
+error:
+    if (uring)
+        hg_poll_uring_destroy(uring);
+    if (fd != -1)
+        close(fd);
+
+    return NULL;
+}
+
+/*---------------------------------------------------------------------------*/
+static void
+hg_poll_uring_destroy(struct hg_poll_uring *uring)
+{
+    if (uring->sqes != MAP_FAILED)
+        munmap(uring->sqes, uring->sqes_size);
+    if (uring->ring != MAP_FAILED)
+        munmap(uring->ring, uring->ring_size);
+    free(uring->entries);
+    free(uring);
+}
+
+/*---------------------------------------------------------------------------*/
+static HG_UTIL_INLINE int
+hg_poll_uring_enter(int fd, unsigned int to_submit, unsigned int min_complete,
+    unsigned int flags, void *arg, size_t arg_size)
+{
+    return (int) syscall(__NR_io_uring_enter, fd, to_submit, min_complete,
+        flags, arg, arg_size);
+}
+
+/*---------------------------------------------------------------------------*/
+static HG_UTIL_INLINE unsigned int
+hg_poll_uring_pending(struct hg_poll_uring *uring)
+{
+    return *uring->sq_tail - __atomic_load_n(uring->sq_head, __ATOMIC_ACQUIRE);
+}
+
+/*---------------------------------------------------------------------------*/
+static struct io_uring_sqe *
+hg_poll_uring_get_sqe(int fd, struct hg_poll_uring *uring)
+{
+    struct io_uring_sqe *sqe;
+
+    if (hg_poll_uring_pending(uring) == uring->sq_entries) {
+        int rc = hg_poll_uring_enter(fd, uring->sq_entries, 0, 0, NULL, 0);
+        HG_UTIL_CHECK_ERROR_NORET(rc == -1, error,
+            "io_uring_enter() failed (%s)", strerror(errno));
+    }
+
+    sqe = &uring->sqes[*uring->sq_tail & uring->sq_mask];
+    memset(sqe, 0, sizeof(*sqe));
+
+    return sqe;
+
+error:
+    return NULL;
+}
+
+/*---------------------------------------------------------------------------*/
+static HG_UTIL_INLINE void
+hg_poll_uring_push_sqe(struct hg_poll_uring *uring)
+{
+    __atomic_store_n(uring->sq_tail, *uring->sq_tail + 1, __ATOMIC_RELEASE);
+}
+
+/*---------------------------------------------------------------------------*/
+static int
+hg_poll_uring_arm(int fd, struct hg_poll_uring *uring, unsigned int index)
+{
+    struct hg_poll_uring_entry *entry = &uring->entries[index];
+    struct io_uring_sqe *sqe;
+    int ret = HG_UTIL_SUCCESS;
+
+    sqe = hg_poll_uring_get_sqe(fd, uring);
+    HG_UTIL_CHECK_ERROR(
+        sqe == NULL, done, ret, HG_UTIL_FAIL, "Could not get SQE");
+
+    /* 16-bit poll_events is converted by the kernel on big-endian */
+    sqe->opcode = IORING_OP_POLL_ADD;
+    sqe->fd = entry->fd;
+    sqe->poll_events = (uint16_t) entry->poll_mask;
+    sqe->len = IORING_POLL_ADD_MULTI;
+    sqe->user_data = HG_POLL_URING_DATA(index, entry->gen);
+    hg_poll_uring_push_sqe(uring);
+
+    entry->armed = true;
+
+done:
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static int
+hg_poll_uring_add(hg_poll_set_t *poll_set, int fd, struct hg_poll_event *event)
+{
+    struct hg_poll_uring *uring = poll_set->uring;
+    struct hg_poll_uring_entry *entry;
+    unsigned int index;
+    int ret = HG_UTIL_SUCCESS, rc;
+
+    hg_thread_mutex_lock(&poll_set->lock);
+
+    for (index = 0; index < uring->nentries; index++)
+        if (uring->entries[index].fd == -1)
+            break;
+
+    /* Grow array if reached max number */
+    if (index == uring->nentries) {
+        struct hg_poll_uring_entry *entries;
+        unsigned int i;
+
+        HG_UTIL_CHECK_ERROR(uring->nentries * 2 > HG_POLL_MAX_EVENTS, unlock,
+            ret, HG_UTIL_FAIL,
+            "reached max number of events for this poll set (%u)",
+            uring->nentries);
+
+        entries = realloc(
+            uring->entries, sizeof(*uring->entries) * uring->nentries * 2);
+        HG_UTIL_CHECK_ERROR(entries == NULL, unlock, ret, HG_UTIL_FAIL,
+            "realloc() failed (%s)", strerror(errno));
+
+        for (i = uring->nentries; i < uring->nentries * 2; i++) {
+            entries[i].fd = -1;
+            entries[i].gen = 0;
+            entries[i].armed = false;
+        }
+        uring->entries = entries;
+        uring->nentries *= 2;
+    }
+
+    entry = &uring->entries[index];
+    entry->fd = fd;
+    entry->data = event->data;
+    entry->poll_mask = 0;
+    if (event->events & HG_POLLIN)
+        entry->poll_mask |= POLLIN;
+    if (event->events & HG_POLLOUT)
+        entry->poll_mask |= POLLOUT;
+
+    rc = hg_poll_uring_arm(poll_set->fd, uring, index);
+    HG_UTIL_CHECK_ERROR(rc != HG_UTIL_SUCCESS, release, ret, HG_UTIL_FAIL,
+        "Could not arm poll for fd=%d", fd);
+
+    /* Submit now, the poll set fd may be waited on by another poll set */
+    rc = hg_poll_uring_enter(
+        poll_set->fd, hg_poll_uring_pending(uring), 0, 0, NULL, 0);
+    HG_UTIL_CHECK_ERROR(rc == -1, release, ret, HG_UTIL_FAIL,
+        "io_uring_enter() failed (%s)", strerror(errno));
+
+    poll_set->nfds++;
+
+    hg_thread_mutex_unlock(&poll_set->lock);
+
+    return ret;
+
+release:
+    /* Drop completions of a poll that may have been queued */
+    entry->fd = -1;
+    entry->gen++;
+    entry->armed = false;
+unlock:
+    hg_thread_mutex_unlock(&poll_set->lock);
+
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static int
+hg_poll_uring_remove(hg_poll_set_t *poll_set, int fd)
+{
+    struct hg_poll_uring *uring = poll_set->uring;
+    struct hg_poll_uring_entry *entry;
+    struct io_uring_sqe *sqe;
+    unsigned int index;
+    int ret = HG_UTIL_SUCCESS, rc;
+
+    hg_thread_mutex_lock(&poll_set->lock);
+
+    for (index = 0; index < uring->nentries; index++)
+        if (uring->entries[index].fd == fd)
+            break;
+    HG_UTIL_CHECK_ERROR(index == uring->nentries, unlock, ret, HG_UTIL_FAIL,
+        "Could not find fd in poll_set");
+    entry = &uring->entries[index];
+
+    if (entry->armed) {
+        sqe = hg_poll_uring_get_sqe(poll_set->fd, uring);
+        HG_UTIL_CHECK_ERROR(
+            sqe == NULL, unlock, ret, HG_UTIL_FAIL, "Could not get SQE");
+
+        sqe->opcode = IORING_OP_POLL_REMOVE;
+        sqe->fd = -1;
+        sqe->addr = HG_POLL_URING_DATA(index, entry->gen);
+        sqe->user_data = HG_POLL_URING_IGNORE;
+        hg_poll_uring_push_sqe(uring);
+
+        rc = hg_poll_uring_enter(
+            poll_set->fd, hg_poll_uring_pending(uring), 0, 0, NULL, 0);
+        HG_UTIL_CHECK_ERROR(rc == -1, unlock, ret, HG_UTIL_FAIL,
+            "io_uring_enter() failed (%s)", strerror(errno));
+    }
+
+    /* Completions still queued for that fd are dropped when reaped */
+    entry->fd = -1;
+    entry->gen++;
+    entry->armed = false;
+    poll_set->nfds--;
+
+unlock:
+    hg_thread_mutex_unlock(&poll_set->lock);
+
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static unsigned int
+hg_poll_uring_reap(struct hg_poll_uring *uring, unsigned int max_events,
+    struct hg_poll_event *events)
+{
+    unsigned int head = *uring->cq_head;
+    unsigned int tail = __atomic_load_n(uring->cq_tail, __ATOMIC_ACQUIRE);
+    unsigned int nevents = 0;
+
+    for (; head != tail && nevents < max_events; head++) {
+        const struct io_uring_cqe *cqe = &uring->cqes[head & uring->cq_mask];
+        struct hg_poll_uring_entry *entry;
+        uint32_t index = (uint32_t) cqe->user_data;
+
+        if (cqe->user_data == HG_POLL_URING_IGNORE || index >= uring->nentries)
+            continue;
+
+        entry = &uring->entries[index];
+        if (entry->fd == -1 || entry->gen != (uint32_t) (cqe->user_data >> 32))
+            continue;
+
+        /* Kernel terminated the multishot poll, re-arm on next wait */
+        if (!(cqe->flags & IORING_CQE_F_MORE))
+            entry->armed = false;
+        if (cqe->res == -ECANCELED)
+            continue;
+
+        events[nevents].events = 0;
+        events[nevents].data = entry->data;
+
+        if (cqe->res < 0) {
+            events[nevents].events |= HG_POLLERR;
+            nevents++;
+            continue;
+        }
+
+        if (cqe->res & POLLIN)
+            events[nevents].events |= HG_POLLIN;
+
+        if (cqe->res & POLLOUT)
+            events[nevents].events |= HG_POLLOUT;
+
+        /* Don't change the if/else order */
+        if (cqe->res & POLLERR)
+            events[nevents].events |= HG_POLLERR;
+        else if (cqe->res & POLLHUP)
+            events[nevents].events |= HG_POLLHUP;
+
+        nevents++;
+    }
+
+    __atomic_store_n(uring->cq_head, head, __ATOMIC_RELEASE);
+
+    return nevents;
+}
+
+/*---------------------------------------------------------------------------*/
+static int
+hg_poll_uring_wait(hg_poll_set_t *poll_set, unsigned int timeout,
+    unsigned int max_events, struct hg_poll_event *events,
+    unsigned int *actual_events)
+{
+    struct hg_poll_uring *uring = poll_set->uring;
+    unsigned int nevents, to_submit, i;
+    int ret = HG_UTIL_SUCCESS, rc;
+
+    hg_thread_mutex_lock(&poll_set->lock);
+
+    /* Polls terminated by the kernel are re-armed in the same submission */
+    for (i = 0; i < uring->nentries; i++) {
+        if (uring->entries[i].fd != -1 && !uring->entries[i].armed) {
+            rc = hg_poll_uring_arm(poll_set->fd, uring, i);
+            HG_UTIL_CHECK_ERROR(rc != HG_UTIL_SUCCESS, unlock, ret,
+                HG_UTIL_FAIL, "Could not arm poll for fd=%d",
+                uring->entries[i].fd);
+        }
+    }
+    to_submit = hg_poll_uring_pending(uring);
+
+    /* Completions already posted do not need a syscall */
+    nevents = hg_poll_uring_reap(uring, max_events, events);
+
+    hg_thread_mutex_unlock(&poll_set->lock);
+
+    if (to_submit > 0 || (nevents == 0 && timeout > 0)) {
+        struct __kernel_timespec timeout_spec = {
+            .tv_sec = timeout / 1000, .tv_nsec = (timeout % 1000) * 1000000L};
+        struct io_uring_getevents_arg arg = {
+            .ts = (uint64_t) (uintptr_t) &timeout_spec};
+        bool wait = (nevents == 0 && timeout > 0);
+
+        rc = hg_poll_uring_enter(poll_set->fd, to_submit, wait ? 1 : 0,
+            wait ? (IORING_ENTER_GETEVENTS | IORING_ENTER_EXT_ARG) : 0,
+            wait ? &arg : NULL, wait ? sizeof(arg) : 0);
+        HG_UTIL_CHECK_ERROR(rc == -1 && errno != ETIME && errno != EINTR,
+            done, ret, HG_UTIL_FAIL, "io_uring_enter() failed (%s)",
+            strerror(errno));
+
+        /* Handle signal interrupts */
+        if (unlikely(rc == -1 && errno == EINTR)) {
+            events[0].events |= HG_POLLINTR;
+            *actual_events = 1;
+
+            /* Reset errno */
+            errno = 0;
+
+            return HG_UTIL_SUCCESS;
+        }
+
+        if (nevents == 0) {
+            hg_thread_mutex_lock(&poll_set->lock);
+            nevents = hg_poll_uring_reap(uring, max_events, events);
+            hg_thread_mutex_unlock(&poll_set->lock);
+        }
+    }
+
+    *actual_events = nevents;
+
+done:
+    return ret;
+
+unlock:
+    hg_thread_mutex_unlock(&poll_set->lock);
+
+    return ret;
+}
+#endif
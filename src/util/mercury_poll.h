@@ -51,6 +51,11 @@ extern "C" {
 
 /**
  * Create a new poll set.
+ * On Linux, an io_uring backend can be selected by setting the
+ * HG_POLL_BACKEND environment variable to "io_uring", epoll is used if
+ * io_uring is not supported. io_uring polls are multishot and report an event
+ * each time a file descriptor becomes ready, file descriptors must therefore be
+ * drained when an event is returned.
  *
  * \return Pointer to poll set or NULL in case of failure
  */
@@ -77,6 +82,17 @@ hg_poll_destroy(hg_poll_set_t *poll_set);
 HG_UTIL_PUBLIC int
 hg_poll_get_fd(hg_poll_set_t *poll_set);
 
+/**
+ * Get the name of the backend used by a poll set ("epoll", "io_uring",
+ * "kqueue" or "poll").
+ *
+ * \param poll_set [IN]         pointer to poll set
+ *
+ * \return Backend name
+ */
+HG_UTIL_PUBLIC const char *
+hg_poll_get_backend(hg_poll_set_t *poll_set);
+
 /**
  * Add file descriptor to poll set.
  *
@@ -97,15 +97,24 @@ hg_thread_yield(void)
 /*---------------------------------------------------------------------------*/
 int
 hg_thread_key_create(hg_thread_key_t *key)
+{
+    return hg_thread_key_create_destructor(key, NULL);
+}
+
+/*---------------------------------------------------------------------------*/
+int
+hg_thread_key_create_destructor(
+    hg_thread_key_t *key, void (*destructor)(void *))
 {
     if (!key)
         return HG_UTIL_FAIL;
 
 #ifdef _WIN32
+    (void) destructor;
     if ((*key = TlsAlloc()) == TLS_OUT_OF_INDEXES)
         return HG_UTIL_FAIL;
 #else
-    if (pthread_key_create(key, NULL))
+    if (pthread_key_create(key, destructor))
         return HG_UTIL_FAIL;
 #endif
 
@@ -131,6 +131,20 @@ hg_thread_equal(hg_thread_t t1, hg_thread_t t2);
 HG_UTIL_PUBLIC int
 hg_thread_key_create(hg_thread_key_t *key);
 
+/**
+ * Create a thread-specific data key visible to all threads in the process,
+ * with a destructor that is called with the non-NULL value of the key when
+ * a thread exits. The destructor is not called on Windows.
+ *
+ * \param key [OUT]             pointer to thread key object
+ * \param destructor [IN]       destructor function
+ *
+ * \return Non-negative on success or negative on failure
+ */
+HG_UTIL_PUBLIC int
+hg_thread_key_create_destructor(
+    hg_thread_key_t *key, void (*destructor)(void *));
+
 /**
  * Delete a thread-specific data key previously returned by
  * hg_thread_key_create().
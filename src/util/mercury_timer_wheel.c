@@ -0,0 +1,412 @@
+/**
+ * Copyright (c) 2013-2022 UChicago Argonne, LLC and The HDF Group.
+ * Copyright (c) 2022 Intel Corporation.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "mercury_timer_wheel.h"
+
+#include "mercury_atomic.h"
+#include "mercury_thread_spin.h"
+#include "mercury_time.h"
+#include "mercury_util_error.h"
+
+#include <limits.h>
+#include <stdlib.h>
+
+/****************/
+/* Local Macros */
+/****************/
+
+/* Wheel geometry: 4 levels of 64 slots with a 1 ms tick cover about 4.4
+ * hours, timers beyond that range are clamped to the last slot that cannot
+ * alias with the current top level slot */
+#define HG_TIMER_WHEEL_LEVELS    (4)
+#define HG_TIMER_WHEEL_SLOT_BITS (6)
+#define HG_TIMER_WHEEL_SLOTS     (1 << HG_TIMER_WHEEL_SLOT_BITS)
+#define HG_TIMER_WHEEL_SLOT_MASK (HG_TIMER_WHEEL_SLOTS - 1)
+#define HG_TIMER_WHEEL_MAX_TICKS                                               \
+    (((uint64_t) 1 << (HG_TIMER_WHEEL_LEVELS * HG_TIMER_WHEEL_SLOT_BITS)) -    \
+        ((uint64_t) 1                                                          \
+            << ((HG_TIMER_WHEEL_LEVELS - 1) * HG_TIMER_WHEEL_SLOT_BITS)))
+
+/* Slot index of a tick at a given level */
+#define HG_TIMER_WHEEL_INDEX(tick, level)                                      \
+    (((tick) >> ((level) *HG_TIMER_WHEEL_SLOT_BITS)) & HG_TIMER_WHEEL_SLOT_MASK)
+
+/* Max number of expired timers collected per lock acquisition */
+#define HG_TIMER_WHEEL_EXPIRE_BATCH (32)
+
+/************************************/
+/* Local Type and Struct Definition */
+/************************************/
+
+/* List of timers */
+HG_LIST_HEAD_DECL(hg_timer_list, hg_timer);
+
+/* Expired timer */
+struct hg_timer_expired {
+    struct hg_timer *timer;  /* Timer */
+    unsigned int generation; /* Generation that expired */
+};
+
+/* Timer wheel */
+struct hg_timer_wheel {
+    struct hg_timer_list slots[HG_TIMER_WHEEL_LEVELS]
+                              [HG_TIMER_WHEEL_SLOTS]; /* Wheel slots */
+    hg_time_t start;                                  /* Time of tick 0 */
+    uint64_t now;                                     /* Current tick */
+    hg_atomic_int32_t count;                          /* Armed timers */
+    hg_thread_spin_t lock;                            /* Wheel lock */
+};
+
+/********************/
+/* Local Prototypes */
+/********************/
+
+/* Get current tick */
+static HG_UTIL_INLINE uint64_t
+hg_timer_wheel_get_tick(const struct hg_timer_wheel *hg_timer_wheel);
+
+/* Insert timer into its slot (lock must be held) */
+static void
+hg_timer_wheel_insert(
+    struct hg_timer_wheel *hg_timer_wheel, struct hg_timer *hg_timer);
+
+/* Re-insert timers of a higher level slot into lower levels */
+static void
+hg_timer_wheel_cascade(
+    struct hg_timer_wheel *hg_timer_wheel, unsigned int level);
+
+/* Get next tick at which a slot must be processed, up to limit */
+static uint64_t
+hg_timer_wheel_next_tick(
+    const struct hg_timer_wheel *hg_timer_wheel, uint64_t limit);
+
+/* Advance wheel to next tick that must be processed (lock must be held) */
+static void
+hg_timer_wheel_advance(struct hg_timer_wheel *hg_timer_wheel, uint64_t tick);
+
+/*******************/
+/* Local Variables */
+/*******************/
+
+/*---------------------------------------------------------------------------*/
+static HG_UTIL_INLINE uint64_t
+hg_timer_wheel_get_tick(const struct hg_timer_wheel *hg_timer_wheel)
+{
+    hg_time_t now;
+
+    hg_time_get_current_ms(&now);
+
+    return (uint64_t) (hg_time_to_double(
+                           hg_time_subtract(now, hg_timer_wheel->start)) *
+                       1000.0);
+}
+
+/*---------------------------------------------------------------------------*/
+static void
+hg_timer_wheel_insert(
+    struct hg_timer_wheel *hg_timer_wheel, struct hg_timer *hg_timer)
+{
+    uint64_t delta;
+    unsigned int level;
+
+    /* Timers that are due are expired with the current tick */
+    if (hg_timer->expire < hg_timer_wheel->now)
+        hg_timer->expire = hg_timer_wheel->now;
+
+    delta = hg_timer->expire - hg_timer_wheel->now;
+    if (delta >= HG_TIMER_WHEEL_MAX_TICKS) {
+        hg_timer->expire = hg_timer_wheel->now + HG_TIMER_WHEEL_MAX_TICKS - 1;
+        delta = HG_TIMER_WHEEL_MAX_TICKS - 1;
+    }
+
+    for (level = 0; level < HG_TIMER_WHEEL_LEVELS - 1; level++)
+        if (delta < ((uint64_t) 1 << ((level + 1) * HG_TIMER_WHEEL_SLOT_BITS)))
+            break;
+
+    HG_LIST_INSERT_HEAD(
+        &hg_timer_wheel
+             ->slots[level][HG_TIMER_WHEEL_INDEX(hg_timer->expire, level)],
+        hg_timer, entry);
+}
+
+/*---------------------------------------------------------------------------*/
+static void
+hg_timer_wheel_cascade(
+    struct hg_timer_wheel *hg_timer_wheel, unsigned int level)
+{
+    struct hg_timer_list *slot =
+        &hg_timer_wheel
+             ->slots[level][HG_TIMER_WHEEL_INDEX(hg_timer_wheel->now, level)];
+    struct hg_timer *hg_timer;
+
+    while ((hg_timer = HG_LIST_FIRST(slot)) != NULL) {
+        HG_LIST_REMOVE(hg_timer, entry);
+        hg_timer_wheel_insert(hg_timer_wheel, hg_timer);
+    }
+}
+
+/*---------------------------------------------------------------------------*/
+static uint64_t
+hg_timer_wheel_next_tick(
+    const struct hg_timer_wheel *hg_timer_wheel, uint64_t limit)
+{
+    uint64_t next = limit;
+    unsigned int level;
+
+    /* Slots of a level are processed every 64^level ticks, look for the first
+     * non-empty one at each level */
+    for (level = 0; level < HG_TIMER_WHEEL_LEVELS; level++) {
+        unsigned int shift = level * HG_TIMER_WHEEL_SLOT_BITS;
+        uint64_t tick = ((hg_timer_wheel->now >> shift) + 1) << shift;
+        unsigned int i;
+
+        for (i = 0; i < HG_TIMER_WHEEL_SLOTS && tick < next;
+             i++, tick += (uint64_t) 1 << shift) {
+            if (!HG_LIST_IS_EMPTY(&hg_timer_wheel->slots[level][
+                    HG_TIMER_WHEEL_INDEX(tick, level)])) {
+                next = tick;
+                break;
+            }
+        }
+    }
+
+    return next;
+}
+
+/*---------------------------------------------------------------------------*/
+static void
+hg_timer_wheel_advance(struct hg_timer_wheel *hg_timer_wheel, uint64_t tick)
+{
+    unsigned int level;
+
+    /* Jump ahead if no timer is left */
+    if (hg_atomic_get32(&hg_timer_wheel->count) == 0) {
+        hg_timer_wheel->now = tick;
+        return;
+    }
+
+    /* Skip empty slots */
+    hg_timer_wheel->now = hg_timer_wheel_next_tick(hg_timer_wheel, tick);
+
+    /* Cascade higher levels when lower level wraps around */
+    for (level = 1; level < HG_TIMER_WHEEL_LEVELS; level++) {
+        if (HG_TIMER_WHEEL_INDEX(hg_timer_wheel->now, level - 1) != 0)
+            break;
+        hg_timer_wheel_cascade(hg_timer_wheel, level);
+    }
+}
+
+/*---------------------------------------------------------------------------*/
+struct hg_timer_wheel *
+hg_timer_wheel_create(void)
+{
+    struct hg_timer_wheel *hg_timer_wheel = NULL;
+    unsigned int i, j;
+
+    hg_timer_wheel =
+        (struct hg_timer_wheel *) malloc(sizeof(struct hg_timer_wheel));
+    HG_UTIL_CHECK_ERROR_NORET(
+        hg_timer_wheel == NULL, done, "Could not allocate timer wheel");
+
+    for (i = 0; i < HG_TIMER_WHEEL_LEVELS; i++)
+        for (j = 0; j < HG_TIMER_WHEEL_SLOTS; j++)
+            HG_LIST_INIT(&hg_timer_wheel->slots[i][j]);
+    hg_time_get_current_ms(&hg_timer_wheel->start);
+    hg_timer_wheel->now = 0;
+    hg_atomic_init32(&hg_timer_wheel->count, 0);
+    hg_thread_spin_init(&hg_timer_wheel->lock);
+
+done:
+    return hg_timer_wheel;
+}
+
+/*---------------------------------------------------------------------------*/
+void
+hg_timer_wheel_destroy(struct hg_timer_wheel *hg_timer_wheel)
+{
+    if (!hg_timer_wheel)
+        return;
+
+    HG_UTIL_CHECK_WARNING(hg_atomic_get32(&hg_timer_wheel->count) > 0,
+        "Destroying timer wheel with %d timers still armed",
+        hg_atomic_get32(&hg_timer_wheel->count));
+
+    hg_thread_spin_destroy(&hg_timer_wheel->lock);
+    free(hg_timer_wheel);
+}
+
+/*---------------------------------------------------------------------------*/
+void
+hg_timer_init(struct hg_timer *hg_timer, void (*callback)(void *), void *arg)
+{
+    hg_timer->entry.next = NULL;
+    hg_timer->entry.prev = NULL;
+    hg_timer->callback = callback;
+    hg_timer->arg = arg;
+    hg_timer->expire = 0;
+    hg_timer->generation = 0;
+    hg_timer->pending = 0;
+    hg_timer->armed = false;
+}
+
+/*---------------------------------------------------------------------------*/
+int
+hg_timer_wheel_add(struct hg_timer_wheel *hg_timer_wheel,
+    struct hg_timer *hg_timer, unsigned int timeout_ms)
+{
+    uint64_t tick = hg_timer_wheel_get_tick(hg_timer_wheel);
+    int ret = HG_UTIL_SUCCESS;
+
+    hg_thread_spin_lock(&hg_timer_wheel->lock);
+    HG_UTIL_CHECK_ERROR(
+        hg_timer->armed, unlock, ret, HG_UTIL_FAIL, "Timer is already armed");
+
+    /* Deadline is relative to current time, not to the last wheel update,
+     * make sure that it is never inserted into the slot being processed */
+    hg_timer->expire =
+        ((tick > hg_timer_wheel->now) ? tick : hg_timer_wheel->now) +
+        timeout_ms;
+    if (hg_timer->expire <= hg_timer_wheel->now)
+        hg_timer->expire = hg_timer_wheel->now + 1;
+    hg_timer->generation++;
+    hg_timer->armed = true;
+    hg_timer_wheel_insert(hg_timer_wheel, hg_timer);
+    hg_atomic_incr32(&hg_timer_wheel->count);
+
+unlock:
+    hg_thread_spin_unlock(&hg_timer_wheel->lock);
+
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+bool
+hg_timer_wheel_del(
+    struct hg_timer_wheel *hg_timer_wheel, struct hg_timer *hg_timer)
+{
+    bool armed;
+
+    hg_thread_spin_lock(&hg_timer_wheel->lock);
+    armed = hg_timer->armed;
+    if (armed) {
+        HG_LIST_REMOVE(hg_timer, entry);
+        hg_timer->armed = false;
+        hg_atomic_decr32(&hg_timer_wheel->count);
+    }
+
+    /* Wait for callback of a previous expiration to return */
+    while (hg_timer->pending > 0 &&
+           !hg_thread_equal(hg_timer->expire_thread, hg_thread_self())) {
+        hg_thread_spin_unlock(&hg_timer_wheel->lock);
+        hg_thread_yield();
+        hg_thread_spin_lock(&hg_timer_wheel->lock);
+    }
+    hg_thread_spin_unlock(&hg_timer_wheel->lock);
+
+    return armed;
+}
+
+/*---------------------------------------------------------------------------*/
+unsigned int
+hg_timer_wheel_expire(struct hg_timer_wheel *hg_timer_wheel)
+{
+    struct hg_timer_expired expired[HG_TIMER_WHEEL_EXPIRE_BATCH];
+    hg_thread_t self = hg_thread_self();
+    unsigned int count = 0, n, i;
+    uint64_t tick;
+
+    /* Nothing armed, skip clock read */
+    if (hg_atomic_get32(&hg_timer_wheel->count) == 0)
+        return 0;
+
+    tick = hg_timer_wheel_get_tick(hg_timer_wheel);
+
+    do {
+        n = 0;
+
+        hg_thread_spin_lock(&hg_timer_wheel->lock);
+        for (;;) {
+            struct hg_timer_list *slot = &hg_timer_wheel->slots[0][
+                HG_TIMER_WHEEL_INDEX(hg_timer_wheel->now, 0)];
+            struct hg_timer *hg_timer;
+
+            /* Move expired timers out of the wheel, timers left in the
+             * current slot are picked up by the next batch */
+            while (n < HG_TIMER_WHEEL_EXPIRE_BATCH &&
+                   (hg_timer = HG_LIST_FIRST(slot)) != NULL) {
+                HG_LIST_REMOVE(hg_timer, entry);
+                hg_timer->armed = false;
+                hg_timer->pending++;
+                hg_timer->expire_thread = self;
+                hg_atomic_decr32(&hg_timer_wheel->count);
+                expired[n].timer = hg_timer;
+                expired[n].generation = hg_timer->generation;
+                n++;
+            }
+            if (n == HG_TIMER_WHEEL_EXPIRE_BATCH ||
+                hg_timer_wheel->now >= tick)
+                break;
+
+            hg_timer_wheel_advance(hg_timer_wheel, tick);
+        }
+        hg_thread_spin_unlock(&hg_timer_wheel->lock);
+
+        /* Execute callbacks outside of the lock. Entries are no longer used
+         * so timers may be re-armed concurrently, a re-armed timer has a new
+         * generation and its previous expiration is dropped. */
+        for (i = 0; i < n; i++) {
+            struct hg_timer *hg_timer = expired[i].timer;
+            bool rearmed;
+
+            hg_thread_spin_lock(&hg_timer_wheel->lock);
+            rearmed = (hg_timer->generation != expired[i].generation);
+            hg_thread_spin_unlock(&hg_timer_wheel->lock);
+
+            if (!rearmed) {
+                hg_timer->callback(hg_timer->arg);
+                count++;
+            }
+
+            hg_thread_spin_lock(&hg_timer_wheel->lock);
+            hg_timer->pending--;
+            hg_thread_spin_unlock(&hg_timer_wheel->lock);
+        }
+    } while (n == HG_TIMER_WHEEL_EXPIRE_BATCH);
+
+    return count;
+}
+
+/*---------------------------------------------------------------------------*/
+unsigned int
+hg_timer_wheel_next_timeout(struct hg_timer_wheel *hg_timer_wheel)
+{
+    uint64_t tick, next;
+    unsigned int timeout = UINT_MAX;
+
+    if (hg_atomic_get32(&hg_timer_wheel->count) == 0)
+        return timeout;
+
+    tick = hg_timer_wheel_get_tick(hg_timer_wheel);
+
+    hg_thread_spin_lock(&hg_timer_wheel->lock);
+    /* Next slot to process, timers of higher levels may then move down to the
+     * first level so this is only an upper bound */
+    next = hg_timer_wheel_next_tick(
+        hg_timer_wheel, hg_timer_wheel->now + HG_TIMER_WHEEL_MAX_TICKS);
+    hg_thread_spin_unlock(&hg_timer_wheel->lock);
+
+    timeout = (next > tick) ? (unsigned int) (next - tick) : 0;
+
+    return timeout;
+}
+
+/*---------------------------------------------------------------------------*/
+bool
+hg_timer_wheel_is_empty(struct hg_timer_wheel *hg_timer_wheel)
+{
+    return hg_atomic_get32(&hg_timer_wheel->count) == 0;
+}
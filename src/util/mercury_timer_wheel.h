@@ -0,0 +1,144 @@
+/**
+ * Copyright (c) 2013-2022 UChicago Argonne, LLC and The HDF Group.
+ * Copyright (c) 2022 Intel Corporation.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef MERCURY_TIMER_WHEEL_H
+#define MERCURY_TIMER_WHEEL_H
+
+#include "mercury_util_config.h"
+
+#include "mercury_list.h"
+#include "mercury_thread.h"
+
+/*************************************/
+/* Public Type and Struct Definition */
+/*************************************/
+
+/**
+ * Timer entry. Timers are intrusive and must be embedded by the caller into
+ * its own objects, arming and disarming a timer therefore never allocates.
+ */
+struct hg_timer {
+    HG_LIST_ENTRY(hg_timer) entry; /* Entry in wheel slot */
+    void (*callback)(void *arg);   /* Expiration callback */
+    void *arg;                     /* Callback arg */
+    uint64_t expire;               /* Expiration tick */
+    hg_thread_t expire_thread;     /* Thread executing callback */
+    unsigned int generation;       /* Incremented each time timer is armed */
+    unsigned int pending;          /* Expired, callback not yet returned */
+    bool armed;                    /* Timer is armed */
+};
+
+/* Opaque timer wheel */
+struct hg_timer_wheel;
+
+/*****************/
+/* Public Macros */
+/*****************/
+
+/*********************/
+/* Public Prototypes */
+/*********************/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Create a new hierarchical timer wheel with a resolution of 1 ms.
+ *
+ * \return pointer to timer wheel or NULL on failure
+ */
+HG_UTIL_PUBLIC struct hg_timer_wheel *
+hg_timer_wheel_create(void);
+
+/**
+ * Destroy a timer wheel. Timers that are still armed are not triggered.
+ *
+ * \param hg_timer_wheel [IN/OUT]   pointer to timer wheel
+ */
+HG_UTIL_PUBLIC void
+hg_timer_wheel_destroy(struct hg_timer_wheel *hg_timer_wheel);
+
+/**
+ * Initialize timer with \callback that gets called with \arg on expiration.
+ *
+ * \param hg_timer [IN/OUT]         pointer to timer
+ * \param callback [IN]             pointer to callback function
+ * \param arg [IN]                  pointer to callback arg
+ */
+HG_UTIL_PUBLIC void
+hg_timer_init(struct hg_timer *hg_timer, void (*callback)(void *), void *arg);
+
+/**
+ * Arm timer so that it expires in \timeout_ms ms. This operation is O(1).
+ * Re-arming a timer that has expired but whose callback has not started yet
+ * supersedes that expiration, the callback is then not executed.
+ *
+ * \param hg_timer_wheel [IN/OUT]   pointer to timer wheel
+ * \param hg_timer [IN/OUT]         pointer to timer
+ * \param timeout_ms [IN]           timeout (in milliseconds)
+ *
+ * \return Non-negative on success or negative on failure
+ */
+HG_UTIL_PUBLIC int
+hg_timer_wheel_add(struct hg_timer_wheel *hg_timer_wheel,
+    struct hg_timer *hg_timer, unsigned int timeout_ms);
+
+/**
+ * Disarm timer. This operation is O(1). If the timer has already expired, wait
+ * for its callback to return unless called from that callback, the timer can
+ * therefore no longer fire once this call returns.
+ *
+ * \param hg_timer_wheel [IN/OUT]   pointer to timer wheel
+ * \param hg_timer [IN/OUT]         pointer to timer
+ *
+ * \return true if the timer was armed and has been removed, false if it had
+ * already expired (or was never armed)
+ */
+HG_UTIL_PUBLIC bool
+hg_timer_wheel_del(
+    struct hg_timer_wheel *hg_timer_wheel, struct hg_timer *hg_timer);
+
+/**
+ * Advance timer wheel to current time and execute callbacks of timers that
+ * have expired. Callbacks are executed without any lock held and must not
+ * release the memory of their timer. Empty slots are skipped so that the cost
+ * does not depend on the time elapsed since the last call.
+ *
+ * \param hg_timer_wheel [IN/OUT]   pointer to timer wheel
+ *
+ * \return number of timers that expired
+ */
+HG_UTIL_PUBLIC unsigned int
+hg_timer_wheel_expire(struct hg_timer_wheel *hg_timer_wheel);
+
+/**
+ * Return an upper bound on the time remaining before the next timer may expire
+ * (i.e., the time after which hg_timer_wheel_expire() should be called).
+ *
+ * \param hg_timer_wheel [IN]       pointer to timer wheel
+ *
+ * \return timeout in milliseconds or UINT_MAX if no timer is armed
+ */
+HG_UTIL_PUBLIC unsigned int
+hg_timer_wheel_next_timeout(struct hg_timer_wheel *hg_timer_wheel);
+
+/**
+ * Determine whether timer wheel has armed timers.
+ *
+ * \param hg_timer_wheel [IN]       pointer to timer wheel
+ *
+ * \return true if empty, false otherwise
+ */
+HG_UTIL_PUBLIC bool
+hg_timer_wheel_is_empty(struct hg_timer_wheel *hg_timer_wheel);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MERCURY_TIMER_WHEEL_H */